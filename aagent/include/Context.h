@@ -17,15 +17,19 @@
 #ifndef CONTEXT_H_
 #define CONTEXT_H_
 
-#include "global.h"
 #include "application.h"
 #include "rts.h"
+#include <functional>
 /**
  * @class Context
  * @ingroup AnalysisAgent
  *
  * @brief Execution environment of the current property
  *
+ * A context is a small value: the region or call-tree node, the rank and the thread. It can be
+ * copied, compared and hashed, so it is kept by value wherever it does not have to outlive the
+ * caller, and serves as a key of maps. Two contexts are equal if they refer to the same region
+ * (or the same call-tree node) in the same rank and thread.
  */
 class Context {
     friend class boost::serialization::access;
@@ -55,7 +59,24 @@ public:
              int rfl,
              int rank     = 0,
              int thread_p = 0 );
-    virtual ~Context();
+    ~Context();
+
+    bool operator==( const Context& other ) const {
+        return rtsBased == other.rtsBased && rank == other.rank && thread == other.thread
+               && ( rtsBased ? rts == other.rts : reg == other.reg );
+    }
+
+    bool operator!=( const Context& other ) const {
+        return !( *this == other );
+    }
+
+    /// Orders by rank, thread, file and first line of the region and call-tree node, the same in every run
+    bool operator<( const Context& other ) const;
+
+    size_t hash() const {
+        size_t location = rtsBased ? std::hash<Rts*>()( rts ) : std::hash<Region*>()( reg );
+        return location * 0x9E3779B97F4A7C15ULL ^ ( ( size_t )( unsigned )rank << 20 ) ^ ( unsigned )thread;
+    }
 
     /**
      * RegionId getter.
@@ -64,6 +85,13 @@ public:
      */
     std::string getRegionId();
 
+    /**
+     * Region handle getter.
+     *
+     * @return the handle of the region in the registry of the application, NO_HANDLE if it is not registered
+     */
+    RegionRegistry::Handle getRegionHandle();
+
     Rts* getRts();
 
     /**
@@ -133,4 +161,13 @@ public:
     std::string getCallpath();
 };
 
+namespace std {
+template<>
+struct hash<Context> {
+    size_t operator()( const Context& ct ) const {
+        return ct.hash();
+    }
+};
+}
+
 #endif /*CONTEXT_H_*/
@@ -0,0 +1,60 @@
+/**
+   @file    DataEntryKey.h
+   @ingroup AnalysisAgent
+   @brief   Key of the entries of the performance data base
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope performance measurement tool.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef DATAENTRYKEY_H_
+#define DATAENTRYKEY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Metric.h"
+#include "RegionRegistry.h"
+
+/**
+ * @brief Identifies the measurements of one metric in one region, process, thread and call-tree node
+ *
+ * A measured region is identified by its handle in the region registry. Measurements that are
+ * looked up by a region of another name, as the implicit barriers of OpenMP regions are, carry the
+ * interned name, the file ID and the line instead; the region handle is NO_HANDLE then.
+ */
+struct DataEntryKey {
+    RegionRegistry::Handle region;
+    RegionRegistry::Handle name;
+    int                    file_id;
+    int                    line;
+    int                    rank;
+    int                    thread;
+    int                    rts_id; ///< -1 for region contexts, call-tree nodes may have the ID 0
+    Metric                 metric;
+
+    bool operator==( const DataEntryKey& other ) const {
+        return region == other.region && name == other.name && file_id == other.file_id && line == other.line
+               && rank == other.rank && thread == other.thread && rts_id == other.rts_id && metric == other.metric;
+    }
+};
+
+struct DataEntryKeyHash {
+    size_t operator()( const DataEntryKey& key ) const {
+        uint64_t h = ( ( uint64_t )key.region << 32 | key.name ) * 0x9E3779B97F4A7C15ULL;
+        h ^= ( ( uint64_t )( uint32_t )key.file_id << 32 | ( uint32_t )key.line ) * 0xC2B2AE3D27D4EB4FULL;
+        h ^= ( ( uint64_t )( uint32_t )key.rank << 32 | ( uint32_t )key.thread ) * 0x165667B19E3779F9ULL;
+        h ^= ( ( uint64_t )( uint32_t )key.rts_id << 32 | ( uint32_t )key.metric ) * 0x27D4EB2F165667C5ULL;
+        return h ^ ( h >> 29 );
+    }
+};
+
+#endif /* DATAENTRYKEY_H_ */
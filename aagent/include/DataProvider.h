@@ -41,8 +41,16 @@ class TuningSpecification;
  * context where it was measured
  */
 struct MetricNotification {
-    Context* ct;
-    Metric   m_id;
+    Context ct;
+    Metric  m_id;
+
+    bool operator==( const MetricNotification& other ) const {
+        return m_id == other.m_id && ct == other.ct;
+    }
+
+    bool operator<( const MetricNotification& other ) const {
+        return m_id != other.m_id ? m_id < other.m_id : ct < other.ct;
+    }
 };
 
 
@@ -201,8 +209,8 @@ class DataProvider {
     std::map< RegionType, std::list<Strategy*> > region_type_subscribers_map;
     /** Region definitions to be notified about */
     std::map<uint64_t, bool> regions_to_notify;
-    /** A map of global metric and their notification data structures */
-    std::map<std::string, MetricNotification> global_metrics_to_notify;
+    /** The global metrics to notify about, with repetitions until they are notified */
+    std::vector<MetricNotification> global_metrics_to_notify;
 
     /** The number of the last completed phase iteration */
     int current_iteration;
@@ -21,9 +21,11 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Context.h"
+#include "DataEntryKey.h"
 #include "Metric.h"
 #include "DataProvider.h"
 
@@ -52,7 +54,7 @@ typedef enum DataBaseInterpolationType {
 }DataBaseInterpolationType;
 
 class PerformanceDataBase {
-    std::map<std::string, std::map<int, INT64> > data;
+    std::unordered_map<DataEntryKey, std::map<int, INT64>, DataEntryKeyHash> data;
     DataProvider*                                provider;
 
     int                        timeWindowLeft;
@@ -61,6 +63,10 @@ class PerformanceDataBase {
     DataBaseInterpolationType  interp_type;
     int                        last_written_iteration;
 
+    DataEntryKey ct_2_key( Context* ct,
+                           Metric   m );
+
+    /// Readable form of the key, for messages
     std::string ct_2_string( Context* ct,
                              Metric   m );
 
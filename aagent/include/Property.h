@@ -85,6 +85,13 @@ public:
      */
     virtual std::string name() = 0;
 
+    /**
+     * Internal properties carry measurements for the frontend analyses and are not reported
+     */
+    virtual bool internal() {
+        return false;
+    }
+
     /**
      * Get the property's context
      */
@@ -0,0 +1,134 @@
+/**
+   @file    PropertyBatch.h
+   @ingroup AnalysisAgent
+   @brief   Batch evaluation of candidate properties
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef PROPERTYBATCH_H_
+#define PROPERTYBATCH_H_
+
+#include "Property.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * A metric read by a property, in the context it is read
+ */
+struct PropertyInput {
+    Context* context;
+    Metric   metric;
+};
+
+typedef std::vector<INT64> MetricColumn;
+
+/**
+ * @class BatchProperty
+ * @ingroup Properties
+ *
+ * @brief Property type that can be evaluated for many contexts at once
+ *
+ * The properties of a type that read the same metrics form a batch. Their inputs are fetched into
+ * one column per metric, and the type evaluates the whole batch from the columns, without a virtual
+ * call and a database lookup per property and metric.
+ */
+class BatchProperty {
+public:
+    virtual ~BatchProperty() {
+    }
+
+    /**
+     * Metrics read by evaluate(), in the order of the columns. False if the property has to be
+     * evaluated by evaluate() this time, e.g. because a debug level makes it read more.
+     */
+    virtual bool batchInputs( std::vector<PropertyInput>& inputs ) = 0;
+
+    /**
+     * Evaluates a batch of properties of this type: columns[ i ][ k ] is input i of batch[ k ].
+     * Leaves every property as evaluate() does and sets found[ k ] to its condition(). Called on
+     * one of the properties for the whole batch.
+     */
+    virtual void evaluateBatch( const std::vector<Property*>&    batch,
+                                const std::vector<MetricColumn>& columns,
+                                std::vector<char>&               found ) = 0;
+};
+
+/**
+ * @class PropertyBatchEvaluator
+ * @ingroup AnalysisAgent
+ *
+ * @brief Evaluates the candidate properties of a strategy step
+ *
+ * Properties implementing BatchProperty are evaluated in batches; every distinct context and metric
+ * is looked up in the performance database once per step, however many properties read it. Other
+ * properties are evaluated one by one with evaluate() and condition().
+ *
+ * PSC_BATCH_EVALUATION=off evaluates all properties one by one. PSC_BATCH_EVALUATION=verify also
+ * evaluates the batched properties one by one afterwards and reports every property whose
+ * condition or severity differs.
+ */
+class PropertyBatchEvaluator {
+public:
+    PropertyBatchEvaluator( PerformanceDataBase* db );
+
+    /**
+     * Evaluates the candidates and appends those whose condition holds to found, in candidate order
+     */
+    void evaluate( const Prop_List& candidates,
+                   Prop_List&       found );
+
+    /// Statistics of the last evaluate()
+    size_t batched() const {
+        return batchedCount;
+    }
+
+    size_t lookups() const {
+        return lookupCount;
+    }
+
+    size_t mismatches() const {
+        return mismatchCount;
+    }
+
+private:
+    struct Batch {
+        BatchProperty*                          kernel;
+        std::vector<Property*>                  properties;
+        std::vector<size_t>                     positions; ///< Of the properties among the candidates
+        std::vector< std::vector<PropertyInput> > inputs;
+    };
+
+    /// Identifies a database entry by the region or RTS, rank and thread of the context and the metric
+    struct EntryKey {
+        const void* location;
+        int         rank;
+        int         thread;
+        Metric      metric;
+
+        bool operator<( const EntryKey& other ) const;
+    };
+
+    INT64 fetch( const PropertyInput& input );
+
+    PerformanceDataBase*     db;
+    std::map<EntryKey, INT64> entries; ///< Values fetched in the current step
+    bool                     enabled;
+    bool                     verify;
+    size_t                   batchedCount;
+    size_t                   lookupCount;
+    size_t                   mismatchCount;
+};
+
+#endif /* PROPERTYBATCH_H_ */
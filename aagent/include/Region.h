@@ -257,7 +257,7 @@ public:
 
     bool get_is_significant( ) const;
 
-    RegionIdent get_ident() const;
+    const RegionIdent& get_ident() const;
 
     Region* get_parent() const;
 
@@ -0,0 +1,173 @@
+/**
+   @file    RegionRegistry.h
+   @ingroup AnalysisAgent
+   @brief   Interned strings, regions and call-paths with dense handles
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope performance measurement tool.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+#ifndef REGIONREGISTRY_H_
+#define REGIONREGISTRY_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Region;
+class Rts;
+
+/**
+ * @class RegionRegistry
+ * @ingroup AnalysisAgent
+ *
+ * @brief Interns the strings, regions and call-paths of the application
+ *
+ * Every string, region and call-path is given a dense handle at its first registration, starting at
+ * 1 so that 0 (NO_HANDLE) can mean "unknown". The handles index vectors, and hash tables lead from
+ * the names back to them, so both directions are constant time. Nothing is ever unregistered: when
+ * the agents are reinitialized and the application processes announce their regions and call-tree
+ * again, the same descriptors and call-paths yield the same handles, only the Rts nodes they are
+ * bound to may change. The registry does not own and never dereferences the Region and Rts objects.
+ * Regions are also kept ordered by their region ID, the order the agent lists them in.
+ */
+class RegionRegistry {
+public:
+    typedef uint32_t Handle;
+
+    static const Handle NO_HANDLE = 0;
+
+    struct StringLess {
+        bool operator()( const std::string* a, const std::string* b ) const {
+            return *a < *b;
+        }
+    };
+
+    /// Region handles by region ID, in the order of the IDs
+    typedef std::map<const std::string*, Handle, StringLess> RegionOrder;
+
+    RegionRegistry();
+
+    /// Handle of the string, registering it if it is new
+    Handle internString( const std::string& str );
+
+    /// Handle of the string, NO_HANDLE if it was never registered
+    Handle findString( const std::string& str ) const;
+
+    /// String of a handle, the empty string for an unknown handle
+    const std::string& stringOf( Handle handle ) const;
+
+    /**
+     * Registers a region under its region ID, if the file is given under its file and first line and,
+     * if name and file are given, under its Score-P descriptor. A region ID or descriptor that is
+     * already registered keeps its region; the handle of that region is returned.
+     */
+    Handle addRegion( Region*            region,
+                      const std::string& region_id,
+                      Handle             name = NO_HANDLE,
+                      Handle             file = NO_HANDLE,
+                      int                rfl = 0 );
+
+    Handle findRegion( const std::string& region_id ) const;
+
+    Handle findRegion( Handle name,
+                       Handle file,
+                       int    rfl ) const;
+
+    Handle findRegion( const Region* region ) const;
+
+    /// Region of a file starting at a line; of several, the one with the lowest region ID
+    Handle findRegionAt( Handle file,
+                         int    rfl ) const;
+
+    /// All regions ordered by their region ID
+    const RegionOrder& regionsById() const {
+        return region_order_;
+    }
+
+    /// Region of a handle, NULL for an unknown handle
+    Region* region( Handle handle ) const;
+
+    /// Region ID of a handle, the empty string for an unknown handle
+    const std::string& regionId( Handle handle ) const;
+
+    /// Number of registered regions, the handles are 1 to regions()
+    size_t regions() const {
+        return regions_.size() - 1;
+    }
+
+    /// Handle of the call-path, registering it if it is new
+    Handle internCallpath( const std::string& callpath );
+
+    Handle findCallpath( const std::string& callpath ) const;
+
+    const std::string& callpath( Handle handle ) const;
+
+    /// Binds a call-path to the call-tree node it currently belongs to, replacing an earlier node
+    Handle bindCallpath( const std::string& callpath,
+                         Rts*               rts );
+
+    /// Call-tree node of a call-path, NULL if it is unknown or not bound
+    Rts* rts( Handle callpath ) const;
+
+    /// Call-path handle of a call-tree node, NO_HANDLE if the node is not bound
+    Handle callpathOf( const Rts* rts ) const;
+
+    size_t callpaths() const {
+        return callpaths_.size() - 1;
+    }
+
+private:
+    /// Score-P region descriptor: name, file and first line
+    struct Descriptor {
+        Handle name;
+        Handle file;
+        int    rfl;
+
+        bool operator==( const Descriptor& other ) const {
+            return name == other.name && file == other.file && rfl == other.rfl;
+        }
+    };
+
+    struct DescriptorHash {
+        size_t operator()( const Descriptor& d ) const {
+            uint64_t key = ( ( uint64_t )d.name << 32 | d.file ) * 0x9E3779B97F4A7C15ULL;
+            return key ^ ( ( uint64_t )( uint32_t )d.rfl * 0xC2B2AE3D27D4EB4FULL );
+        }
+    };
+
+    struct RegionEntry {
+        Region* region;
+        Handle  id; ///< Interned region ID
+    };
+
+    struct CallpathEntry {
+        Handle path; ///< Interned call-path string
+        Rts*   rts;
+    };
+
+    std::vector<const std::string*>                     strings_;
+    std::unordered_map<std::string, Handle>             string_handles_;
+
+    std::vector<RegionEntry>                            regions_;
+    std::unordered_map<Handle, Handle>                  region_by_id_;
+    std::unordered_map<Descriptor, Handle, DescriptorHash> region_by_descriptor_;
+    std::unordered_map<const Region*, Handle>           region_by_object_;
+    std::unordered_map<uint64_t, Handle>                region_by_line_; ///< By file and first line
+    RegionOrder                                         region_order_;
+
+    std::vector<CallpathEntry>                          callpaths_;
+    std::unordered_map<Handle, Handle>                  callpath_by_path_;
+    std::unordered_map<const Rts*, Handle>              callpath_by_rts_;
+};
+
+#endif /* REGIONREGISTRY_H_ */
@@ -76,6 +76,8 @@ enum command_t {
 #define DISMISS_HEARTBEAT       2
 #define FORWARDED_HEARTBEAT     1
 #define OWN_HEARTBEAT           0
+// Periodic summary of the sender's subtree, see HeartbeatMonitor
+#define SUBTREE_HEARTBEAT       3
 
 typedef struct serialized_strategy_request_container_t {
     ACE_CDR::ULong  size;
@@ -216,10 +218,11 @@ protected:
         int         port;           ///< Port
         int         heartbeat_type; ///< BGP Port V1 specific. true if it is a forwarded heartbeat, which is counted in FE
         int         num_procs;      ///< number of recently connected application procs
+        std::string subtree;        ///< Encoded SubtreeHeartbeat of a SUBTREE_HEARTBEAT, empty otherwise
 
         size_t size() {
             //return (hostname.length() + tag.length() + 3 * sizeof(int));
-            return sizeof( char ) * ( hostname.length() + tag.length() + 2 ) + 3 * ( sizeof( ACE_CDR::Long ) );
+            return sizeof( char ) * ( hostname.length() + tag.length() + subtree.length() + 3 ) + 3 * ( sizeof( ACE_CDR::Long ) );
         }
     };
 
@@ -475,7 +478,8 @@ public:
                            int         port,
                            std::string tag,
                            int         heartbeat_type,
-                           int         num_procs );
+                           int         num_procs,
+                           std::string subtree = "" );
 
     virtual int on_setparent( setparent_req_t&   req,
                               setparent_reply_t& reply );
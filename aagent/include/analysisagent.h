@@ -59,6 +59,7 @@ struct cmdline_opts {
     bool has_inst;
     bool has_srcrev;        ///< Source revision is specified
     bool has_configurationfile; // configuration xml file
+    bool has_heartbeat;
 
 
 
@@ -89,6 +90,7 @@ struct cmdline_opts {
     char inst[ 100 ];
     char configfile_string[ 2000 ]; // name of the configuration xml file
     char plugin[ 2000 ];
+    char heartbeat_string[ 2000 ];
 
     cmdline_opts() {
         has_showhelp       = false;
@@ -123,6 +125,7 @@ struct cmdline_opts {
         has_inst   = false;
         has_srcrev = false;
         has_configurationfile=false; // configuration xml file
+        has_heartbeat      = false;
 
     }
 };
@@ -296,6 +299,9 @@ public:
                          int       run );
 
     int handle_step();
+
+    /// Periodic heartbeat with the number of processes this agent is attached to
+    void liveness_tick();
 };
 
 /**
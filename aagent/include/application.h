@@ -19,6 +19,7 @@
 #define APPLICATION_H_
 
 #include "Region.h"
+#include "RegionRegistry.h"
 #include "readex_configuration.h"
 #include <boost/noncopyable.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -27,6 +28,7 @@
 #include <unordered_map>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 class Rts;
 
@@ -43,13 +45,9 @@ public:
 private:
     std::string                    app_name;         ///< Name of the monitored application
     std::string                    app_param;        ///< Application's parameters
-    std::map<std::string, Region*> code_regions;     ///< Instrumented regions
     std::map<int, std::string>     file_names;       ///< Mapping between File names and File IDs (old map)
 
-    std::map<int, std::string>  strings_by_id;       ///< Mapping between strings and their IDs
-    std::map<std::string, int>  ids_by_string;       ///< Mapping between string IDs and strings
-    int                         last_string_id;      ///<unique file id, incremented by one and assigned to the newly added file
-    std::map<uint64_t, Region*> region_by_regionKey; ///< Mapping between region key and Region objects
+    RegionRegistry registry;                         ///< Interned strings, instrumented regions and call-paths
 
     std::list<Region*> sig_regions;                  ///< List of significant regions
 
@@ -57,13 +55,9 @@ private:
     Region* main_region;
     int     mpiprocs, ompthreads;
 
-    uint64_t hash_region_ident( int name_id,
-                                int file_id,
-                                int rfl );
-
     Rts* calltree_root;
 
-    std::map<Rts*,std::string> appl_rtscallpath_mapping; ///< Mapping of the call-tree node to its call-path string
+    std::map<Rts*,std::string> appl_rtscallpath_mapping; ///< Copy of the call-path bindings of the registry, see getRtsCallpathMapping()
 
     Readex_Metrics energy_metrics;
 
@@ -78,6 +72,11 @@ public:
 
     std::map<std::string, std::map<std::string, double> > getDefaultEnergyMapping() { return default_energy_mapping; }
 
+    /** The registry behind the region and string lookups, for callers that keep handles instead of names. */
+    RegionRegistry& getRegistry() {
+        return registry;
+    }
+
     int getIDbyString( std::string str );
 
     std::string getStringByID( int string_id );
@@ -98,7 +97,7 @@ public:
     /** Retrieves the region given by the specified region id. */
     Region* getRegionByID( const std::string& id );
 
-    /** Retrieves the rts given by the specified callpathid. */
+    /** Retrieves the rts given by the specified callpath, NULL if the call-tree has no such node. */
     Rts* getRtsByCallpath( const std::string& call_path );
 
     /** Retrieves the region given by the specified region id. This method can also be used to test if a region is known at all. */
@@ -175,6 +174,7 @@ public:
 
     void construct_frontend_calltree( Rts* node );
 
+    /** Call-tree nodes bound to their call-paths in the registry, the map is rebuilt on every call. */
     std::map<Rts*,std::string>& getRtsCallpathMapping();
 
     void set_energy_metrics( Readex_Metrics energy_metrics );
@@ -20,12 +20,15 @@
 #define PSC_AGENT_H_
 
 
+#include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "regxx.h"
 #include "peer_acceptor.h"
 #include "timing.h"
+#include "HeartbeatMonitor.h"
 
 struct PropertyInfo {
     std::string name;
@@ -50,10 +53,12 @@ struct PropertyInfo {
     long double exec_regions[ 30 ];
     long double devia_regions[ 30 ];
     bool        done;
+    bool        internal;
     int         numthreads;
 
     PropertyInfo() {
         done       = false;
+        internal   = false;
         numthreads = 1;
     }
 };
@@ -103,6 +108,52 @@ struct AgentInfo {
     }
 };
 
+/// @brief A relaunched child that did not accept the connection yet
+struct PendingReattach {
+    std::string      tag;        ///< Tag of the child
+    int              attempts;   ///< Connection attempts so far
+    std::vector<int> idmap_from; ///< Process mapping the child is reinitialized with
+    std::vector<int> idmap_to;
+};
+
+class PeriscopeAgent;
+
+/**
+ * @class LivenessTimer
+ * @ingroup Communication
+ *
+ * @brief Periodic heartbeat of an agent
+ *
+ * A handler of its own, so the agents can keep scheduling and cancelling their other timers.
+ */
+class LivenessTimer : public ACE_Event_Handler {
+private:
+    PeriscopeAgent* agent_;
+public:
+    LivenessTimer( PeriscopeAgent* agent ) : agent_( agent ) {
+    }
+
+    int handle_timeout( const ACE_Time_Value& time,
+                        const void*           arg );
+};
+
+/**
+ * @class ReattachTimer
+ * @ingroup Communication
+ *
+ * @brief Retries the connections to relaunched children once per second
+ */
+class ReattachTimer : public ACE_Event_Handler {
+private:
+    PeriscopeAgent* agent_;
+public:
+    ReattachTimer( PeriscopeAgent* agent ) : agent_( agent ) {
+    }
+
+    int handle_timeout( const ACE_Time_Value& time,
+                        const void*           arg );
+};
+
 /**
  * @class PeriscopeAgent
  * @ingroup AnalysisAgent
@@ -116,6 +167,7 @@ protected:
     int            parent_port;
     char           parent_host[ 1000 ];
     bool           fastmode;
+    bool           startup_mode_; ///< Whether heartbeats still count towards the startup of the hierarchy
     int            timeout_delta_;
     ACE_Time_Value timeout_;
     int            global_timeout_; //Gerndt added to support global timeout via psc_wall_time()
@@ -159,6 +211,15 @@ protected:
 
     ACE_SOCK_Stream* parent_stream_;
 
+    /// Latest heartbeats of the child agents and the summary of this agent's subtree
+    HeartbeatMonitor heartbeats_;
+    LivenessTimer*   liveness_;
+
+    /// Relaunched children still waited for, retried by the reattach timer
+    std::list< PendingReattach > reattach_pending_;
+    ReattachTimer*               reattach_;
+    long                         reattach_timer_;
+
 public:
     // TODO make these protected again and make getters
     AgentInfo     own_info_; ///< information about the current agent
@@ -181,11 +242,24 @@ public:
 
         threads_.clear();
 
-        timeout_delta_ = 20;
-        fastmode       = false;
+        timeout_delta_  = 20;
+        fastmode        = false;
+        startup_mode_   = false;
+        liveness_       = 0;
+        reattach_       = 0;
+        reattach_timer_ = -1;
     }
 
     virtual ~PeriscopeAgent() {
+        if( liveness_ ) {
+            reactor_->cancel_timer( liveness_ );
+            delete liveness_;
+        }
+        if( reattach_ ) {
+            reactor_->cancel_timer( reattach_ );
+            delete reattach_;
+        }
+
         // TODO: unload shared libraries holding properties
 
         if( regid_ != -1 ) {
@@ -209,6 +283,15 @@ public:
     void set_fastmode( bool fast ) {
         fastmode = fast;
     }
+    bool get_startup_mode() {
+        return startup_mode_;
+    }
+    void startup_mode_on() {
+        startup_mode_ = true;
+    }
+    void startup_mode_off() {
+        startup_mode_ = false;
+    }
 
     void reset_childagentlist() {
         child_agents_.clear();
@@ -307,6 +390,22 @@ public:
      */
     int connect_to_child( AgentInfo* ag );
 
+    /**
+     * Connects again to a child after an application restart and reinitializes it with the
+     * process mapping. A relaunched child drops the connection of its exited predecessor; if it
+     * does not listen yet, the connection is retried from the reactor until the timeout.
+     */
+    int reattach_child( AgentInfo* ag,
+                        bool       relaunched,
+                        int        map_len,
+                        int*       map_from,
+                        int*       map_to );
+
+    /**
+     * Called by the reattach timer, retries the connections to the pending children
+     */
+    void retry_reattach();
+
     /**
      * Adds a child agent with its tag
      */
@@ -466,6 +565,32 @@ public:
     AgentInfo get_own_info() {
         return own_info_;
     }
+
+    HeartbeatMonitor& heartbeats() {
+        return heartbeats_;
+    }
+
+    /**
+     * @brief Call liveness_tick() every interval seconds
+     *
+     * The deadline of the children is set separately on heartbeats(); without one the ticks only
+     * send changed summaries upstream.
+     */
+    void start_liveness( double interval );
+
+    /**
+     * @brief Report the children that missed their deadline and send the subtree summary upstream
+     *
+     * The summary is sent whenever it changed, and on every tick while a deadline is set so that
+     * the parent sees this agent alive.
+     */
+    virtual void liveness_tick();
+
+    /**
+     * Record the subtree summary a child sent with a SUBTREE_HEARTBEAT; false if it is malformed
+     */
+    bool subtree_heartbeat( const std::string& tag,
+                            const std::string& subtree );
 };
 
 #endif // PSC_AGENT_H_
@@ -51,6 +51,7 @@
 #define XML_PSC_PROP_CONFIDENCE_TAG          "confidence"
 
 #define XML_PSC_PROP_PURPOSE_TAG             "purpose"
+#define XML_PSC_PROP_INTERNAL_TAG            "internal"
 
 #define XML_PSC_PROP_ADDINFO_TAG             "addInfo"
 
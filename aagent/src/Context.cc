@@ -16,10 +16,12 @@
  */
 
 #include "Context.h"
+#include "global.h"
 #include "psc_errmsg.h"
 
 Context::Context ( Region* reg_p, int rank_p, int thread_p ): aa_rts_id( 0 ) {
     reg       = reg_p;
+    rts       = NULL;
     rank      = rank_p;
     thread    = thread_p;
     rtsBased  = false;
@@ -37,6 +39,7 @@ Context::Context( Rts* rts_node, int rank_p, int thread_p ) {
 
 Context::Context( int fileId_p, int rlf_p, int rank_p, int thread_p ): aa_rts_id( 0 ) {
     reg = appl->searchRegion( fileId_p, rlf_p );
+    rts = NULL;
     if( !reg ) {
         psc_errmsg( "Region not found in context creation (%d,%d)!\n", fileId_p, rlf_p );
     }
@@ -48,6 +51,33 @@ Context::Context( int fileId_p, int rlf_p, int rank_p, int thread_p ): aa_rts_id
 Context::~Context() {
 }
 
+bool Context::operator<( const Context& other ) const {
+    if( rank != other.rank ) {
+        return rank < other.rank;
+    }
+    if( thread != other.thread ) {
+        return thread < other.thread;
+    }
+    // the region of a call-tree node is kept in reg as well
+    if( reg && other.reg ) {
+        const RegionIdent& ident       = reg->get_ident();
+        const RegionIdent& other_ident = other.reg->get_ident();
+        if( ident.file_id != other_ident.file_id ) {
+            return ident.file_id < other_ident.file_id;
+        }
+        if( ident.rfl != other_ident.rfl ) {
+            return ident.rfl < other_ident.rfl;
+        }
+    }
+    if( rtsBased != other.rtsBased ) {
+        return rtsBased < other.rtsBased;
+    }
+    if( rtsBased && aa_rts_id != other.aa_rts_id ) {
+        return aa_rts_id < other.aa_rts_id;
+    }
+    return rtsBased ? std::less<Rts*>()( rts, other.rts ) : std::less<Region*>()( reg, other.reg );
+}
+
 std::string Context::getCallpath() {
     if ( rtsBased ) {
         return rts->getCallPath();
@@ -115,9 +145,16 @@ bool Context::isRtsBased() {
 }
 
 std::string Context::getRegionId() {
-    Region* region = rtsBased ? rts->getRegion() : reg;
+    Region*                region   = rtsBased ? rts->getRegion() : reg;
+    const RegionRegistry&  registry = Application::instance().getRegistry();
+    RegionRegistry::Handle handle   = registry.findRegion( region );
+
+    // registered regions have their ID interned, no need to format it again
+    return handle == RegionRegistry::NO_HANDLE ? region->getRegionID() : registry.regionId( handle );
+}
 
-    return region->getRegionID();
+RegionRegistry::Handle Context::getRegionHandle() {
+    return Application::instance().getRegistry().findRegion( rtsBased ? rts->getRegion() : reg );
 }
 
 Rts* Context::getRts() {
@@ -25,6 +25,7 @@
 #include <sys/time.h>
 #include <boost/foreach.hpp>
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <inttypes.h>
@@ -846,7 +847,7 @@ void DataProvider::transfer_tuning_requests_to_processes() {
                 for( reg_it = regions->begin(); reg_it != regions->end(); reg_it++ ) {
                	 Region*    r;
                	 if ((*ts_it)->getTypeOfVariantContext() == variant_context_type(RTS_LIST)){
-               		 r=appl->getCalltreeRoot()->getRtsByCallpath(*reg_it)->getRegion();
+               		 r=appl->getRtsByCallpath(*reg_it)->getRegion();
                	 } else {
                       r= Application::instance().getRegionByID( *reg_it );
                	 }
@@ -1696,6 +1697,33 @@ void DataProvider::initialize_metric2papiset() {
 
 int countTrials=0;
 
+/**
+ * @brief Appends a received buffer to <PSC_OA_RECORD>.<rank> in the format it arrived in
+ *
+ * Recording is off unless the environment variable PSC_OA_RECORD names a file prefix when the
+ * agent receives its first buffer.
+ */
+static void record_buffer( int                rank,
+                           const std::string& header,
+                           int                number_of_elements,
+                           const void*        buffer,
+                           int                size ) {
+    static const char* prefix = getenv( "PSC_OA_RECORD" );
+    if( !prefix || !*prefix ) {
+        return;
+    }
+
+    std::stringstream file;
+    file << prefix << "." << rank;
+    std::ofstream out( file.str().c_str(), std::ios::binary | std::ios::app );
+    out << header << "\n";
+    out.write( ( const char* )&number_of_elements, sizeof( int ) );
+    out.write( ( const char* )buffer, size );
+    if( !out ) {
+        psc_errmsg( "Unable to record %s of process %d in %s\n", header.c_str(), rank, file.str().c_str() );
+    }
+}
+
 char DataProvider::blockingBufferReceive(       void**                       buffer_out,
                                                 int*                         buffer_size_out,
                                                 ApplProcess*                 process,
@@ -1794,6 +1822,9 @@ char DataProvider::blockingBufferReceive(       void**                       buf
     *buffer_out      = buffer;
     *buffer_size_out = number_of_elements;
 
+    /* Keep a copy of the traffic for replaying it offline with the fake Score-P online-access endpoint */
+    record_buffer( process->rank, buffer_type_name, number_of_elements, buffer, number_of_elements * buffer_type_size );
+
     /* Print out the received buffer */
     if( active_dbgLevel(AgentApplComm) ) {
         psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AgentApplComm ), "Got %s from process %d\n",
@@ -1907,24 +1938,27 @@ void DataProvider::print_buffer( void*                        buffer,
 void DataProvider::notify_for_global_metrics() {
     psc_dbgmsg( 5, "Notifying subscribers of the global metrics\n" );
 
+    // a metric measured in a context is notified once
+    std::sort( global_metrics_to_notify.begin(), global_metrics_to_notify.end() );
+    global_metrics_to_notify.erase( std::unique( global_metrics_to_notify.begin(), global_metrics_to_notify.end() ),
+                                    global_metrics_to_notify.end() );
+
     // iterate over metrics to notify about
-    typedef std::map<std::string, MetricNotification>::iterator Iterator;
+    typedef std::vector<MetricNotification>::iterator Iterator;
     for( Iterator it = global_metrics_to_notify.begin();
          it != global_metrics_to_notify.end(); ++it ) {
         // notify subscribers
-        const std::list<Strategy*>& subscribers = metric_subscribers_map[ it->second.m_id ];
+        const std::list<Strategy*>& subscribers = metric_subscribers_map[ it->m_id ];
         BOOST_FOREACH( Strategy * subscriber, subscribers )
-        subscriber->metric_found_callback( it->second.m_id, *it->second.ct );
+        subscriber->metric_found_callback( it->m_id, it->ct );
 
         // notify group subscribers
-//        const std::list<Strategy*>& group_subscribers = metric_group_subscribers_map[ EventList[ it->second.m_id ].EventGroup ];
+//        const std::list<Strategy*>& group_subscribers = metric_group_subscribers_map[ EventList[ it->m_id ].EventGroup ];
 //        BOOST_FOREACH( Strategy * subscriber, group_subscribers )
-//        subscriber->metric_found_callback( it->second.m_id, *it->second.ct );
-
-        // delete the context object which was created in the add_metric_to_notification_list and used only here
-        delete it->second.ct;
+//        subscriber->metric_found_callback( it->m_id, it->ct );
     }
 
+    // the vector keeps its capacity for the next experiment
     global_metrics_to_notify.clear();
 }
 
@@ -2555,19 +2589,6 @@ void DataProvider::setIterationBurstLength( int length ) {
 
 void DataProvider::add_metric_to_notification_list( Metric  m,
                                                     Context ct ) {
-    Context*           ct_to_store = new Context( ct );
-    MetricNotification mn;
-    mn.ct   = ct_to_store;
-    mn.m_id = m;
-    std::stringstream key;
-    if( ct.isRtsBased() ) {
-        key << EventList[ m ].EventName << ct.getRegion()->get_name()
-            << ct.getFileId() << ct.getRfl() << ct.getRank() << ct.getThread() << ct.getRtsID();
-
-    }
-    else {
-        key << EventList[ m ].EventName << ct.getRegion()->get_name()
-            << ct.getFileId() << ct.getRfl() << ct.getRank() << ct.getThread();
-    }
-    global_metrics_to_notify[ key.str() ] = mn;
+    MetricNotification mn = { ct, m };
+    global_metrics_to_notify.push_back( mn );
 }
@@ -44,9 +44,13 @@ PerformanceDataBase::~PerformanceDataBase() {
 
 void PerformanceDataBase::print_db() {
     printf( "==============PERFORMANCE DATA BASE CONTENT==============\n" );
-    std::map<std::string, std::map<int, INT64> >::iterator iter1;
+    const RegionRegistry& registry = Application::instance().getRegistry();
+    std::unordered_map<DataEntryKey, std::map<int, INT64>, DataEntryKeyHash>::iterator iter1;
     for( iter1 = data.begin(); iter1 != data.end(); iter1++ ) {
-        printf( "Entry: %s:\n", iter1->first.c_str() );
+        const DataEntryKey& key = iter1->first;
+        printf( "Entry: :%d:%d:%s:%d:%d:%s:%d:\n", key.file_id, key.line,
+                key.region != RegionRegistry::NO_HANDLE ? registry.regionId( key.region ).c_str() : registry.stringOf( key.name ).c_str(),
+                key.rank, key.thread, EventList[ key.metric ].EventName, key.rts_id );
         std::map<int, INT64>::iterator iter2;
         int                            iterations_till_now = provider->getCurrentIterationNumber();
 
@@ -332,6 +336,41 @@ DataBaseQueryResult PerformanceDataBase::getAllIterationsValues( Context*
     return PDB_SCOREP_SUCCESS;
 }
 
+DataEntryKey PerformanceDataBase::ct_2_key( Context* ct,
+                                            Metric   m ) {
+    RegionRegistry& registry = Application::instance().getRegistry();
+    Region*         region   = ct->getRegion();
+    DataEntryKey    key;
+
+    key.region  = RegionRegistry::NO_HANDLE;
+    key.name    = RegionRegistry::NO_HANDLE;
+    key.file_id = ct->getFileId();
+    key.line    = ct->getRfl();
+    key.rank    = ct->getRank();
+    key.thread  = ct->getThread();
+    key.rts_id  = ct->isRtsBased() ? ct->getRtsID() : -1;
+    key.metric  = m;
+
+    if( m == PSC_IMPLICIT_BARRIER_TIME ) {
+        // the implicit barrier is a region of its own, named after the end line, see ct_2_string()
+        std::stringstream name;
+        key.line = region->get_ident().end_position;
+        name << "!$omp implicit barrier @" << region->get_ident().file_name << ":" << key.line;
+        key.name = registry.internString( name.str() );
+    }
+    else {
+        key.region = registry.findRegion( region );
+        if( key.region == RegionRegistry::NO_HANDLE ) {
+            // a copy of a registered region stands for it
+            key.region = registry.findRegion( region->getRegionID() );
+        }
+        if( key.region == RegionRegistry::NO_HANDLE ) {
+            key.name = registry.internString( region->get_name() );
+        }
+    }
+    return key;
+}
+
 std::string PerformanceDataBase::ct_2_string( Context* ct,
                                               Metric   m ) {
     std::stringstream key;
@@ -369,23 +408,21 @@ std::string PerformanceDataBase::ct_2_string( Context* ct,
 DataBaseQueryResult PerformanceDataBase::find_data_entry( Context* ct,
                                                           Metric m,
                                                           std::map<int, INT64>& result ) {
-    std::map<int, INT64> out;
-    result = out;
+    result.clear();
 
-    std::string key = ct_2_string( ct, m );
+    std::unordered_map<DataEntryKey, std::map<int, INT64>, DataEntryKeyHash>::const_iterator entry = data.find( ct_2_key( ct, m ) );
 
-    if( data.find( key ) == data.end() ) {
-        psc_dbgmsg( 5, "Data entry %s not found\n", key.c_str() );
+    if( entry == data.end() ) {
+        psc_dbgmsg( 5, "Data entry %s not found\n", ct_2_string( ct, m ).c_str() );
         return PDB_SCOREP_NOT_FOUND;
     }
 
-    std::map<int, INT64> dataEntry = data[ key ];
-    if( dataEntry.empty() ) {
+    if( entry->second.empty() ) {
         psc_dbgmsg( 5, "Data entry %s found, but it is empty\n", ct_2_string( ct, m ).c_str() );
         return PDB_SCOREP_NOT_FOUND;
     }
 
-    result = dataEntry;
+    result = entry->second;
     return PDB_SCOREP_SUCCESS;
 }
 
@@ -396,8 +433,8 @@ void PerformanceDataBase::clean() {
 void PerformanceDataBase::store( Context* ct,
                                  Metric   m,
                                  INT64    value ) {
-    std::string key               = ct_2_string( ct, m );
-    int         current_iteration = provider->getCurrentIterationNumber();
+    DataEntryKey key               = ct_2_key( ct, m );
+    int          current_iteration = provider->getCurrentIterationNumber();
 
     //printf("STORE() in PDF (KEY,VALUE) = (%s,%d)\n",key.c_str(), value);//fflush(stdout);
     if( current_iteration >= last_written_iteration ) {
@@ -408,11 +445,6 @@ void PerformanceDataBase::store( Context* ct,
         setTimeWindow( last_written_iteration, last_written_iteration + 1 );
     }
 
-    if( data.find( key ) == data.end() ) {
-        std::map<int, INT64> new_map;
-        data[ key ] = new_map;
-    }
-
     data[ key ][ current_iteration ] = value;
 }
 
@@ -143,6 +143,11 @@ std::string Property::toXMLSerialize() {
     xmlData << "\t<" << XML_PSC_PROP_PURPOSE_TAG << ">" << get_Purpose()
             << "</" << XML_PSC_PROP_PURPOSE_TAG << ">" << std::endl;
 
+    // Internal properties only: <internal>1</internal>
+    if( internal() ) {
+        xmlData << "\t<" << XML_PSC_PROP_INTERNAL_TAG << ">1</" << XML_PSC_PROP_INTERNAL_TAG << ">" << std::endl;
+    }
+
     // Extra information (property specific!)
     xmlData << "\t<" << XML_PSC_PROP_ADDINFO_TAG << ">" << std::endl;
     xmlData << toXMLExtra();
@@ -0,0 +1,143 @@
+/**
+   @file    PropertyBatch.cc
+   @ingroup AnalysisAgent
+   @brief   Batch evaluation of candidate properties
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "PropertyBatch.h"
+#include "psc_errmsg.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <typeinfo>
+
+bool PropertyBatchEvaluator::EntryKey::operator<( const EntryKey& other ) const {
+    if( location != other.location ) {
+        return location < other.location;
+    }
+    if( rank != other.rank ) {
+        return rank < other.rank;
+    }
+    if( thread != other.thread ) {
+        return thread < other.thread;
+    }
+    return metric < other.metric;
+}
+
+PropertyBatchEvaluator::PropertyBatchEvaluator( PerformanceDataBase* db ) :
+    db( db ), enabled( true ), verify( false ), batchedCount( 0 ), lookupCount( 0 ), mismatchCount( 0 ) {
+    const char* mode = getenv( "PSC_BATCH_EVALUATION" );
+    if( mode != NULL ) {
+        enabled = strcmp( mode, "off" ) != 0;
+        verify  = strcmp( mode, "verify" ) == 0;
+    }
+}
+
+INT64 PropertyBatchEvaluator::fetch( const PropertyInput& input ) {
+    Context* ct  = input.context;
+    EntryKey key = { ct->isRtsBased() ? ( const void* )ct->getRts() : ( const void* )ct->getRegion(),
+                     ct->getRank(), ct->getThread(), input.metric };
+
+    std::map<EntryKey, INT64>::iterator it = entries.find( key );
+    if( it == entries.end() ) {
+        lookupCount++;
+        it = entries.insert( std::make_pair( key, db->get( ct, input.metric ) ) ).first;
+    }
+    return it->second;
+}
+
+void PropertyBatchEvaluator::evaluate( const Prop_List& candidates,
+                                       Prop_List&       found ) {
+    // Group the batch properties by type and the metrics they read, evaluate the others right away
+    std::vector<char>                candidateFound( candidates.size(), 0 );
+    std::vector<Property*>           ordered( candidates.begin(), candidates.end() );
+    std::vector<Batch>               batches;
+    std::map<std::string, size_t>    batchOf;
+    std::vector<PropertyInput>       inputs;
+
+    batchedCount  = 0;
+    lookupCount   = 0;
+    mismatchCount = 0;
+    for( size_t position = 0; position < ordered.size(); position++ ) {
+        Property*      property = ordered[ position ];
+        BatchProperty* kernel   = enabled ? dynamic_cast<BatchProperty*>( property ) : NULL;
+
+        inputs.clear();
+        if( kernel == NULL || !kernel->batchInputs( inputs ) ) {
+            property->evaluate();
+            candidateFound[ position ] = property->condition();
+            continue;
+        }
+
+        std::string signature = typeid( *property ).name();
+        for( size_t i = 0; i < inputs.size(); i++ ) {
+            signature += "/" + std::to_string( ( int )inputs[ i ].metric );
+        }
+        std::map<std::string, size_t>::iterator it = batchOf.find( signature );
+        if( it == batchOf.end() ) {
+            it = batchOf.insert( std::make_pair( signature, batches.size() ) ).first;
+            batches.push_back( Batch() );
+            batches.back().kernel = kernel;
+        }
+        Batch& batch = batches[ it->second ];
+        batch.properties.push_back( property );
+        batch.positions.push_back( position );
+        batch.inputs.push_back( inputs );
+    }
+
+    // Fill the columns of every batch and let its type evaluate it
+    entries.clear();
+    for( size_t b = 0; b < batches.size(); b++ ) {
+        Batch&                    batch = batches[ b ];
+        size_t                    count = batch.properties.size();
+        std::vector<MetricColumn> columns( batch.inputs.front().size(), MetricColumn( count ) );
+        for( size_t k = 0; k < count; k++ ) {
+            for( size_t i = 0; i < columns.size(); i++ ) {
+                columns[ i ][ k ] = fetch( batch.inputs[ k ][ i ] );
+            }
+        }
+
+        std::vector<char> batchFound( count, 0 );
+        batch.kernel->evaluateBatch( batch.properties, columns, batchFound );
+        batchedCount += count;
+
+        for( size_t k = 0; k < count; k++ ) {
+            candidateFound[ batch.positions[ k ] ] = batchFound[ k ];
+            if( !verify ) {
+                continue;
+            }
+            Property* property = batch.properties[ k ];
+            double    severity = property->severity();
+            property->evaluate();
+            bool      same = property->severity() == severity || ( std::isnan( severity ) && std::isnan( property->severity() ) );
+            if( property->condition() != ( bool )batchFound[ k ] || !same ) {
+                mismatchCount++;
+                psc_errmsg( "Batch evaluation of %s (rank %d, thread %d) differs: condition %d severity %f, evaluate() gives %d %f\n",
+                            property->name().c_str(), property->get_rank(), property->get_thread(), ( int )batchFound[ k ],
+                            severity, ( int )property->condition(), property->severity() );
+                candidateFound[ batch.positions[ k ] ] = property->condition();
+            }
+        }
+    }
+    entries.clear();
+
+    for( size_t position = 0; position < ordered.size(); position++ ) {
+        if( candidateFound[ position ] ) {
+            found.push_back( ordered[ position ] );
+        }
+    }
+    psc_dbgmsg( 5, "Evaluated %d properties, %d in %d batches with %d database lookups\n",
+                ( int )ordered.size(), ( int )batchedCount, ( int )batches.size(), ( int )lookupCount );
+}
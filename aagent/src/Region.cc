@@ -123,7 +123,7 @@ void Region::set_rra_recursive_to_RUNS_AS_THREADED( RegionRunsAs rra ) {
 }
 
 
-RegionIdent Region::get_ident() const {
+const RegionIdent& Region::get_ident() const {
     return region_ident;
 }
 
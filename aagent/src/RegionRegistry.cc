@@ -0,0 +1,205 @@
+/**
+   @file    RegionRegistry.cc
+   @ingroup AnalysisAgent
+   @brief   Interned strings, regions and call-paths with dense handles
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope performance measurement tool.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "RegionRegistry.h"
+
+static const std::string no_string;
+
+
+static uint64_t line_key( RegionRegistry::Handle file,
+                          int                    rfl ) {
+    return ( uint64_t )file << 32 | ( uint32_t )rfl;
+}
+
+const RegionRegistry::Handle RegionRegistry::NO_HANDLE;
+
+
+RegionRegistry::RegionRegistry() {
+    // slot 0 of every table stands for NO_HANDLE
+    strings_.push_back( &no_string );
+    RegionEntry no_region = { NULL, NO_HANDLE };
+    regions_.push_back( no_region );
+    CallpathEntry no_callpath = { NO_HANDLE, NULL };
+    callpaths_.push_back( no_callpath );
+}
+
+
+RegionRegistry::Handle RegionRegistry::internString( const std::string& str ) {
+    std::pair<std::unordered_map<std::string, Handle>::iterator, bool> inserted =
+        string_handles_.insert( std::make_pair( str, ( Handle )strings_.size() ) );
+    if( inserted.second ) {
+        // the keys of the node-based map do not move, the vector can point at them
+        strings_.push_back( &inserted.first->first );
+    }
+    return inserted.first->second;
+}
+
+
+RegionRegistry::Handle RegionRegistry::findString( const std::string& str ) const {
+    std::unordered_map<std::string, Handle>::const_iterator it = string_handles_.find( str );
+    return it == string_handles_.end() ? NO_HANDLE : it->second;
+}
+
+
+const std::string& RegionRegistry::stringOf( Handle handle ) const {
+    return handle < strings_.size() ? *strings_[ handle ] : no_string;
+}
+
+
+RegionRegistry::Handle RegionRegistry::addRegion( Region*            region,
+                                                  const std::string& region_id,
+                                                  Handle             name,
+                                                  Handle             file,
+                                                  int                rfl ) {
+    Descriptor descriptor = { name, file, rfl };
+    bool       described  = name != NO_HANDLE && file != NO_HANDLE;
+    if( described ) {
+        Handle existing = findRegion( name, file, rfl );
+        if( existing != NO_HANDLE ) {
+            return existing;
+        }
+    }
+
+    Handle id       = internString( region_id );
+    Handle existing = findRegion( region_id );
+    if( existing != NO_HANDLE ) {
+        if( described ) {
+            region_by_descriptor_[ descriptor ] = existing;
+        }
+        return existing;
+    }
+
+    Handle      handle = regions_.size();
+    RegionEntry entry  = { region, id };
+    regions_.push_back( entry );
+    region_by_id_[ id ]             = handle;
+    region_by_object_[ region ]     = handle;
+    region_order_[ strings_[ id ] ] = handle;
+    if( described ) {
+        region_by_descriptor_[ descriptor ] = handle;
+    }
+    if( file != NO_HANDLE ) {
+        Handle& first = region_by_line_[ line_key( file, rfl ) ];
+        if( first == NO_HANDLE || region_id < regionId( first ) ) {
+            first = handle;
+        }
+    }
+    return handle;
+}
+
+
+RegionRegistry::Handle RegionRegistry::findRegion( const std::string& region_id ) const {
+    Handle id = findString( region_id );
+    if( id == NO_HANDLE ) {
+        return NO_HANDLE;
+    }
+    std::unordered_map<Handle, Handle>::const_iterator it = region_by_id_.find( id );
+    return it == region_by_id_.end() ? NO_HANDLE : it->second;
+}
+
+
+RegionRegistry::Handle RegionRegistry::findRegion( Handle name,
+                                                   Handle file,
+                                                   int    rfl ) const {
+    Descriptor descriptor = { name, file, rfl };
+    std::unordered_map<Descriptor, Handle, DescriptorHash>::const_iterator it = region_by_descriptor_.find( descriptor );
+    return it == region_by_descriptor_.end() ? NO_HANDLE : it->second;
+}
+
+
+RegionRegistry::Handle RegionRegistry::findRegion( const Region* region ) const {
+    std::unordered_map<const Region*, Handle>::const_iterator it = region_by_object_.find( region );
+    return it == region_by_object_.end() ? NO_HANDLE : it->second;
+}
+
+
+RegionRegistry::Handle RegionRegistry::findRegionAt( Handle file,
+                                                     int    rfl ) const {
+    std::unordered_map<uint64_t, Handle>::const_iterator it = region_by_line_.find( line_key( file, rfl ) );
+    return it == region_by_line_.end() ? NO_HANDLE : it->second;
+}
+
+
+Region* RegionRegistry::region( Handle handle ) const {
+    return handle < regions_.size() ? regions_[ handle ].region : NULL;
+}
+
+
+const std::string& RegionRegistry::regionId( Handle handle ) const {
+    return handle < regions_.size() ? stringOf( regions_[ handle ].id ) : no_string;
+}
+
+
+RegionRegistry::Handle RegionRegistry::internCallpath( const std::string& callpath ) {
+    Handle path = internString( callpath );
+    std::pair<std::unordered_map<Handle, Handle>::iterator, bool> inserted =
+        callpath_by_path_.insert( std::make_pair( path, ( Handle )callpaths_.size() ) );
+    if( inserted.second ) {
+        CallpathEntry entry = { path, NULL };
+        callpaths_.push_back( entry );
+    }
+    return inserted.first->second;
+}
+
+
+RegionRegistry::Handle RegionRegistry::findCallpath( const std::string& callpath ) const {
+    Handle path = findString( callpath );
+    if( path == NO_HANDLE ) {
+        return NO_HANDLE;
+    }
+    std::unordered_map<Handle, Handle>::const_iterator it = callpath_by_path_.find( path );
+    return it == callpath_by_path_.end() ? NO_HANDLE : it->second;
+}
+
+
+const std::string& RegionRegistry::callpath( Handle handle ) const {
+    return handle < callpaths_.size() ? stringOf( callpaths_[ handle ].path ) : no_string;
+}
+
+
+RegionRegistry::Handle RegionRegistry::bindCallpath( const std::string& callpath,
+                                                     Rts*               rts ) {
+    Handle handle = internCallpath( callpath );
+
+    // a node that is renamed, e.g. by clustering, leaves its old call-path unbound
+    std::unordered_map<const Rts*, Handle>::iterator previous = callpath_by_rts_.find( rts );
+    if( previous != callpath_by_rts_.end() && previous->second != handle
+        && callpaths_[ previous->second ].rts == rts ) {
+        callpaths_[ previous->second ].rts = NULL;
+    }
+
+    // a call-path that is bound to a new node, e.g. after reinitialization, forgets the old one
+    Rts* bound = callpaths_[ handle ].rts;
+    if( bound != NULL && bound != rts ) {
+        callpath_by_rts_.erase( bound );
+    }
+
+    callpaths_[ handle ].rts = rts;
+    callpath_by_rts_[ rts ]  = handle;
+    return handle;
+}
+
+
+Rts* RegionRegistry::rts( Handle callpath ) const {
+    return callpath < callpaths_.size() ? callpaths_[ callpath ].rts : NULL;
+}
+
+
+RegionRegistry::Handle RegionRegistry::callpathOf( const Rts* rts ) const {
+    std::unordered_map<const Rts*, Handle>::const_iterator it = callpath_by_rts_.find( rts );
+    return it == callpath_by_rts_.end() ? NO_HANDLE : it->second;
+}
@@ -454,7 +454,7 @@ int ACCL_Handler::on_heartbeat( heartbeat_req_t& req, heartbeat_reply_t& reply )
 /**
  * @brief Send a message with a heartbeat request
  */
-int ACCL_Handler::heartbeat( std::string hostname, int port, std::string tag, int heartbeat_type, int num_procs ) {
+int ACCL_Handler::heartbeat( std::string hostname, int port, std::string tag, int heartbeat_type, int num_procs, std::string subtree ) {
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ACECommunication ), "Send heartbeat() \n" );
     heartbeat_t hp;
 
@@ -463,6 +463,7 @@ int ACCL_Handler::heartbeat( std::string hostname, int port, std::string tag, in
     hp.tag            = tag;
     hp.heartbeat_type = heartbeat_type;
     hp.num_procs      = num_procs;
+    hp.subtree        = subtree;
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ACECommunication ), "Sending ACCL_Handler::heartbeat: hostname=%s,"
                 "port=%d, tag=%s, forwarded=%d, num_procs=%d\n", hostname.c_str(), port, tag.c_str(), heartbeat_type, num_procs );
     heartbeat_handler.send_req( hp );
@@ -904,6 +905,7 @@ int operator<<( ACE_OutputCDR& cdr, const ACCL_Handler::heartbeat_t& hp ) {
     cdr << h_type;
     procs = ( ACE_CDR::Long )hp.num_procs;
     cdr << procs;
+    cdr << hp.subtree;
     return cdr.good_bit();
 }
 
@@ -917,6 +919,7 @@ int operator>>( ACE_InputCDR& cdr, ACCL_Handler::heartbeat_t& hp ) {
     hp.heartbeat_type = ( int )h_type;
     cdr >> procs;
     hp.num_procs = ( int )procs;
+    cdr >> hp.subtree;
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ACECommunication ), "ACCL_Handler:: heartbeat >> %s %s %d %d %d\n",
                 hp.hostname.c_str(), hp.tag.c_str(), hp.port, hp.heartbeat_type, hp.num_procs );
     return cdr.good_bit();
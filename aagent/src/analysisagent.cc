@@ -315,6 +315,11 @@ void AnalysisAgent::run() {
         psc_errmsg( " Parent handler not set at AnalysisAgent::run()\n" );
     }
 
+    // periodic heartbeats only matter to a parent that checks a deadline
+    if( heartbeats_.getDeadline() > 0 ) {
+        start_liveness( heartbeats_.interval() );
+    }
+
     if( get_fastmode() ) {  // fast timer-less ACE comm.
         psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ACECommunication ), "Timer-less ACE comm. in the AA \n" );
         search_done = false;
@@ -368,6 +373,11 @@ int AnalysisAgent::handle_step() {
     return 0;
 }
 
+void AnalysisAgent::liveness_tick() {
+    heartbeats_.setOwnProcesses( dp->get_total_num_processes() );
+    PeriscopeAgent::liveness_tick();
+}
+
 void AnalysisAgent::reinit_providers( int maplen,
                                       int idmap_from[ 8192 ],
                                       int idmap_to[ 8192 ] ) {
@@ -34,7 +34,7 @@ Application::Application() :
     ompthreads( 0 ),
     phase_region( NULL ),
     main_region( NULL ),
-    last_string_id( 1 ) {
+    calltree_root( NULL ) {
 }
 
 
@@ -54,12 +54,9 @@ void Application::set_app_name( const std::string name ) {
 
 std::list<Region*> Application::get_regions() const {
     std::list<Region*> regions;
-
-    typedef std::map<std::string, Region*>::const_iterator Iterator;
-    for( Iterator i = code_regions.begin(); i != code_regions.end(); ++i ) {
-        regions.push_back( i->second );
+    for( RegionRegistry::RegionOrder::const_iterator it = registry.regionsById().begin(); it != registry.regionsById().end(); ++it ) {
+        regions.push_back( registry.region( it->second ) );
     }
-
     return regions;
 }
 
@@ -67,10 +64,10 @@ std::list<Region*> Application::get_significant_regions() const{
     //NOT USED
     std::list<Region*> regions;
 
-    typedef std::map<std::string, Region*>::const_iterator Iterator;
-    for( Iterator i = code_regions.begin(); i != code_regions.end(); ++i ) {
-        if( i->second->is_significant )
-            regions.push_back( i->second );
+    for( RegionRegistry::RegionOrder::const_iterator it = registry.regionsById().begin(); it != registry.regionsById().end(); ++it ) {
+        Region* region = registry.region( it->second );
+        if( region->is_significant )
+            regions.push_back( region );
     }
 
     return regions;
@@ -90,33 +87,28 @@ void Application::set_app_param( const std::string param ) {
 
 Region* Application::searchRegion( int fileId, int rfl ) {
     // TODO: THIS FUNCTION IS DEPRECATED; LOOK UP REGIONS BY THEIR ID
-    typedef std::map<std::string, Region*>::iterator Iterator;
-
-    for( Iterator reg = code_regions.begin(); reg != code_regions.end(); ++reg ) {
-        if( reg->second->get_ident().file_id == fileId   &&   reg->second->get_ident().rfl == rfl ) {
-            return reg->second;
-        }
+    if( fileId <= 0 ) {
+        return NULL;
     }
-
-    return NULL;
+    return registry.region( registry.findRegionAt( fileId, rfl ) );
 }
 
 
 Region* Application::searchRegion( const std::string& regionId ) {
-    std::map<std::string, Region*>::iterator i = code_regions.find( regionId );
-    return i == code_regions.end()  ?  NULL : i->second;
+    return registry.region( registry.findRegion( regionId ) );
 }
 
 
 void Application::markSignificantRegions( const std::list<std::string>& names ) {
-    std::map<std::string, Region*>::iterator it;
+    const RegionRegistry::RegionOrder& regions = registry.regionsById();
     sig_regions.clear();
     for( std::list<std::string>:: const_iterator i =  names.begin(); i != names.end(); ++i)
     {
-        for( it = code_regions.begin(); it != code_regions.end(); ++it ) {
-            if( strcasecmp(  it->second->get_name().c_str(), i->c_str() ) == 0 ) {
-                it->second->is_significant = true;
-                sig_regions.push_back( it->second );
+        for( RegionRegistry::RegionOrder::const_iterator r = regions.begin(); r != regions.end(); ++r ) {
+            Region* region = registry.region( r->second );
+            if( strcasecmp(  region->get_name().c_str(), i->c_str() ) == 0 ) {
+                region->is_significant = true;
+                sig_regions.push_back( region );
             }
         }
     }
@@ -150,12 +142,12 @@ Region* Application::get_main_region() {
 
 
 void Application::print_region_list() {
-    typedef std::map<std::string, Region*>::iterator Iterator;
+    const RegionRegistry::RegionOrder& regions = registry.regionsById();
 
     std::cerr << '\n' << "The Complete list of regions:\n\n";
-    for( Iterator it = code_regions.begin(); it != code_regions.end(); ++it ) {
+    for( RegionRegistry::RegionOrder::const_iterator it = regions.begin(); it != regions.end(); ++it ) {
         std::cerr << std::endl;
-        it->second->print( true );
+        registry.region( it->second )->print( true );
     }
     std::cerr << std::endl;
 }
@@ -166,9 +158,11 @@ void Application::print_application_tree() {
     std::cerr << std::endl;
 
     //print the subroutines
-    for( std::map<std::string, Region*>::iterator it = code_regions.begin(); it != code_regions.end(); ++it ) {
-        if( it->second->get_ident().type == SUB_REGION ) {
-            it->second->print_subregions( " ", file_names );
+    const RegionRegistry::RegionOrder& regions = registry.regionsById();
+    for( RegionRegistry::RegionOrder::const_iterator it = regions.begin(); it != regions.end(); ++it ) {
+        Region* region = registry.region( it->second );
+        if( region->get_ident().type == SUB_REGION ) {
+            region->print_subregions( " ", file_names );
         }
     }
 
@@ -176,13 +170,14 @@ void Application::print_application_tree() {
 }
 
 std::list<Region*> Application::get_subroutines() {
-    std::list<Region*>                       subprograms;
-    std::map<std::string, Region*>::iterator it;
+    std::list<Region*>                 subprograms;
+    const RegionRegistry::RegionOrder& regions = registry.regionsById();
 
     subprograms.push_back( main_region );
-    for( it = code_regions.begin(); it != code_regions.end(); ++it ) {
-        if( it->second->get_ident().type == SUB_REGION ) {
-            subprograms.push_back( it->second );
+    for( RegionRegistry::RegionOrder::const_iterator it = regions.begin(); it != regions.end(); ++it ) {
+        Region* region = registry.region( it->second );
+        if( region->get_ident().type == SUB_REGION ) {
+            subprograms.push_back( region );
         }
     }
 
@@ -201,11 +196,12 @@ void Application::mark_all_potential_parallel_regions() {
 }
 
 Region* Application::get_subroutine( std::string sub_nm ) {
-    typedef std::map<std::string, Region*>::iterator Iterator;
+    const RegionRegistry::RegionOrder& regions = registry.regionsById();
 
-    for( Iterator it = code_regions.begin(); it != code_regions.end(); ++it ) {
-        if( it->second->get_name() == sub_nm && it->second->get_ident().type == SUB_REGION ) {
-            return it->second;
+    for( RegionRegistry::RegionOrder::const_iterator it = regions.begin(); it != regions.end(); ++it ) {
+        Region* region = registry.region( it->second );
+        if( region->get_name() == sub_nm && region->get_ident().type == SUB_REGION ) {
+            return region;
         }
     }
 
@@ -250,31 +246,21 @@ int Application::getMpiProcs() {
  * Returns the unique ID of the string
  *
  * @param str string
- * @return	unique ID of the string
+ * @return	unique ID of the string, -1 if the string is not registered
  */
 int Application::getIDbyString( std::string str ) {
-    if( ids_by_string.count( str ) > 0 ) {
-        return ids_by_string[ str ];
-    }
-    else {
-        return -1;
-    }
+    RegionRegistry::Handle string_id = registry.findString( str );
+    return string_id == RegionRegistry::NO_HANDLE ? -1 : ( int )string_id;
 }
 
 /**
  * Returns the string registered under the provided ID
  *
  * @param string_id id of the string
- * @return string
+ * @return string, empty if the ID is unknown
  */
 std::string Application::getStringByID( int string_id ) {
-    std::string result_val = "";
-    if( strings_by_id.count( string_id ) > 0 ) {
-        return strings_by_id[ string_id ];
-    }
-    else {
-        return result_val;
-    }
+    return string_id < 0 ? "" : registry.stringOf( string_id );
 }
 
 /**
@@ -284,66 +270,32 @@ std::string Application::getStringByID( int string_id ) {
  * @return unique ID of the string
  */
 int Application::addString( std::string str ) {
-    int string_id = getIDbyString( str );
-
-    if( string_id != -1 ) {
-        return string_id;
-    }
-
-    last_string_id++;
-
-    while( strcmp( getStringByID( last_string_id ).c_str(), "" ) != 0 ) {
-        ;
-    }
-
-    last_string_id++;
-    strings_by_id[ last_string_id ] = str;
-    ids_by_string[ str ]            = last_string_id;
-
-    return last_string_id;
-}
-
-/**
- * Generates 64 bit integer id of the region specified by name id, file id and region first line
- *
- * @param name_id name id
- * @param file_id file id
- * @param rfl region first line
- * @return 64bit integer region id
- */
-uint64_t Application::hash_region_ident( int name_id,
-                                         int file_id,
-                                         int rfl ) {
-    //return ( ( uint64_t )file_id << 48 ) | ( ( uint64_t )name_id << 32) | ( uint64_t )rfl;
-    uint64_t key = ( uint64_t )file_id * 10000000 + ( uint64_t )name_id * 10000 + ( uint64_t )rfl;
-    //printf("key generated:%d,%d,%d -> %" PRIu64 "\n", name_id, file_id, rfl, key );
-    return key;
-
-    // key description: xxxx|yyy|zzzz : x-file_id, y-name_id, z-rfl
+    return registry.internString( str );
 }
 
 /**
- * Returns a pointer to the region object specified by its id
+ * Returns a pointer to the region object specified by its key
  *
- * @param region_id region id
- * @return pointer to the region object
+ * @param region_id region key, as returned by Region::getLocalRegionID()
+ * @return pointer to the region object, NULL for an unknown key
  */
 Region* Application::getRegionByKey( uint64_t region_id ) {
-    if( region_by_regionKey.count( region_id ) > 0 ) {
-        return region_by_regionKey[ region_id ];
-    }
-    else {
+    if( region_id > registry.regions() ) {
         return NULL;
     }
+    return registry.region( region_id );
 }
 
 /**
- * Returns an id of the region specified by its name, file name and region first line
+ * Returns the key of the region specified by its name, file name and region first line
+ *
+ * The key of a Score-P region is its handle in the registry, so it stays the same for as long as
+ * the agent runs, including reinitializations.
  *
  * @param region_name region name
  * @param file_name file name
  * @param rfl region first line
- * @return id of the region
+ * @return key of the region, 0 if the region is not registered
  */
 uint64_t Application::getRegionKeyByDescr( std::string region_name,
                                            std::string file_name,
@@ -354,15 +306,12 @@ uint64_t Application::getRegionKeyByDescr( std::string region_name,
     if( region_name.empty() ) {
         region_name = DEFAULT_REGION_NAME;
     }
-    int file_id = getIDbyString( file_name );
-    if( file_id == -1 ) {
-        return 0;
-    }
-    int name_id = getIDbyString( region_name );
-    if( name_id == -1 ) {
+    RegionRegistry::Handle file_id = registry.findString( file_name );
+    RegionRegistry::Handle name_id = registry.findString( region_name );
+    if( file_id == RegionRegistry::NO_HANDLE || name_id == RegionRegistry::NO_HANDLE ) {
         return 0;
     }
-    return hash_region_ident( name_id, file_id, rfl );
+    return registry.findRegion( name_id, file_id, rfl );
 }
 
 /**
@@ -394,15 +343,13 @@ Region* Application::getRegionByID( const std::string& id ) {
 
 Region* Application::getRegionByID( const std::string& id,
                                     bool               allowNull ) {
-    typedef std::map<std::string, Region*>::iterator Iterator;
-
-    Iterator i      = code_regions.find( id );
-    Region*  result = ( i == code_regions.end() )  ?  NULL : i->second;
+    Region* result = registry.region( registry.findRegion( id ) );
 
     if( result == NULL   &&   !allowNull ) {
-        psc_errmsg( "Required code region not found: %s.  %d regions are known:\n", id.c_str(), code_regions.size() );
-        for( Iterator i = code_regions.begin(); i != code_regions.end(); ++i ) {
-            psc_errmsg( "    %s\n", i->first.c_str() );
+        const RegionRegistry::RegionOrder& regions = registry.regionsById();
+        psc_errmsg( "Required code region not found: %s.  %d regions are known:\n", id.c_str(), ( int )regions.size() );
+        for( RegionRegistry::RegionOrder::const_iterator it = regions.begin(); it != regions.end(); ++it ) {
+            psc_errmsg( "    %s\n", registry.region( it->second )->getRegionID().c_str() );
         }
 
         abort();
@@ -444,13 +391,10 @@ Region* Application::addSCOREPRegion( int         rfl,
 
     int      name_id        = addString( reg_name );
     int      file_id        = addString( file_name );
-    uint64_t new_region_key = hash_region_ident( name_id, file_id, rfl );
+    uint64_t new_region_key = registry.regions() + 1;
     Region*  new_region     = new Region( new_region_key, region_type, file_id, rfl, start_position, end_position, file_name, reg_name );
-    code_regions.insert( std::make_pair( new_region->getRegionID(), new_region ) );
-    region_by_regionKey[ new_region_key ] = new_region;
 
-    Region* test = getRegionByID( new_region->getRegionID(), true );
-    if( test != new_region ) {
+    if( registry.addRegion( new_region, new_region->getRegionID(), name_id, file_id, rfl ) != new_region_key ) {
         psc_errmsg( "Region with region_id %s was not stored correctly!\n", new_region->getRegionID().c_str() );
         abort();
     }
@@ -470,7 +414,12 @@ void Application::addRegion( const std::string& region_name,
 
     int     file_id = addString( fileName );
     Region* region  = new Region( type, file_id, rfl, start, end, fileName, regionName );
-    code_regions.insert( std::make_pair( region->getRegionID(), region ) );
+    Region* known   = registry.region( registry.addRegion( region, region->getRegionID(), RegionRegistry::NO_HANDLE, file_id, rfl ) );
+    if( known != region ) {
+        // the region ID was known already, the registered region stays
+        delete region;
+        region = known;
+    }
 
     if( type == USER_REGION   &&   !phase_region ) {
         psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL(CallTree) , "Setting phase region automatically: %s\n", region->getRegionID().c_str() );
@@ -541,7 +490,27 @@ void Application::printDefaultEnergy() {
         }
 }
 
+Rts* Application::getRtsByCallpath( const std::string& call_path ) {
+    // call-tree nodes are never freed, but their call-paths change when the tree is clustered
+    Rts* rts = registry.rts( registry.findCallpath( call_path ) );
+    if( rts && rts->getCallPath() == call_path ) {
+        return rts;
+    }
+
+    rts = calltree_root ? calltree_root->getRtsByCallpath( call_path ) : NULL;
+    if( rts ) {
+        registry.bindCallpath( call_path, rts );
+    }
+    return rts;
+}
+
 std::map<Rts*,std::string>& Application::getRtsCallpathMapping() {
+    appl_rtscallpath_mapping.clear();
+    for( RegionRegistry::Handle h = 1; h <= registry.callpaths(); h++ ) {
+        if( registry.rts( h ) ) {
+            appl_rtscallpath_mapping[ registry.rts( h ) ] = registry.callpath( h );
+        }
+    }
     return appl_rtscallpath_mapping;
 }
 
@@ -106,6 +106,7 @@ int parse_opts( int                  argc,
         { "inst",                   required_argument, 0,         'B' },
         { "srcrev",                 required_argument, 0,         'C' },
         { "config-file",            required_argument, 0,         'I' },
+        { "heartbeat-deadline",     required_argument, 0,         'J' },
         0
     };
 
@@ -348,6 +349,13 @@ int parse_opts( int                  argc,
             }
             break;
 
+        case 'J':
+            if( opt->has_arg == required_argument ) {
+                copts->has_heartbeat = true;
+                strcpy( copts->heartbeat_string, optarg );
+            }
+            break;
+
         default:
             // some unknown option
             return -1;
@@ -392,6 +400,7 @@ void usage( int   argc,
     fprintf( stderr, "  [--inst]                 (Name of the instrumentation strategy, e.g. overhead, analysis)\n" );
     fprintf( stderr, "  [--srcrev]               (Source code revision)\n" );
     fprintf( stderr, "  [--config-file=filename]  (Relative path to the configuration file)\n" );
+    fprintf( stderr, "  [--heartbeat-deadline=secs] (Deadline of the parent for the periodic heartbeats, 0 to disable)\n" );
 }
 
 /////////////////////////////////////////
@@ -718,6 +727,18 @@ int main( int   argc,
         }
     }
 
+    // ------------------------------------
+    // H E A R T B E A T   D E A D L I N E
+    // ------------------------------------
+    if( opts.has_heartbeat ) {
+        double deadline = atof( opts.heartbeat_string );
+        if( deadline < 0 ) {
+            psc_errmsg( "Bad value for heartbeat deadline: %s\n", opts.heartbeat_string );
+            exit( 1 );
+        }
+        agent->heartbeats().setDeadline( deadline );
+    }
+
     if( opts.has_mpinumprocs ) {
         appl->setMpiProcs( atoi( opts.mpinumprocs_string ) );
     }
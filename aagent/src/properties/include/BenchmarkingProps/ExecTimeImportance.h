@@ -24,11 +24,12 @@
 #define ExecTimeImportance_H_
 
 #include "Property.h"
+#include "PropertyBatch.h"
 #include "PropertyID.h"
 #include "global.h"
 #include <vector>
 
-class ExecTimeImportanceProp : public Property {
+class ExecTimeImportanceProp : public Property, public BatchProperty {
     friend class boost::serialization::access;
     template<class Archive>
     void serialize( Archive& ar, const unsigned int version ) {
@@ -71,6 +72,12 @@ public:
 
     void evaluate( void );
 
+    bool batchInputs( std::vector<PropertyInput>& inputs );
+
+    void evaluateBatch( const std::vector<Property*>&    batch,
+                        const std::vector<MetricColumn>& columns,
+                        std::vector<char>&               found );
+
     PropertyID id( void );
 
     std::string name( void );
@@ -37,7 +37,7 @@ class StallCyclesProp : public Property {
     }
 private:
     double threshold;
-    INT64 phaseCycles
+    INT64    phaseCycles;
     INT64    stallCycles;
     Context* phaseContext;
     Metric   m;
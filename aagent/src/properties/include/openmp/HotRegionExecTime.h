@@ -83,6 +83,13 @@ public:
 
     std::string name( void );
 
+    /**
+     * @brief Execution times only feed the scalability analysis of the frontend
+     */
+    bool internal( void ) {
+        return true;
+    }
+
     void print( void );
 
     std::string info( void ) {
@@ -171,6 +171,40 @@ void ExecTimeImportanceProp::evaluate() {
 }
 
 
+bool ExecTimeImportanceProp::batchInputs( std::vector<PropertyInput>& inputs ) {
+    PropertyInput phaseTime = { phaseContext, PSC_EXECUTION_TIME };
+    PropertyInput time      = { context, PSC_EXECUTION_TIME };
+    inputs.push_back( phaseTime );
+    inputs.push_back( time );
+    if( withRtsSupport() ) {
+        PropertyInput nodeEnergy = { context, PSC_NODE_ENERGY };
+        PropertyInput cpu0Energy = { context, PSC_CPU0_ENERGY };
+        PropertyInput cpu1Energy = { context, PSC_CPU1_ENERGY };
+        inputs.push_back( nodeEnergy );
+        inputs.push_back( cpu0Energy );
+        inputs.push_back( cpu1Energy );
+    }
+    return true;
+}
+
+
+void ExecTimeImportanceProp::evaluateBatch( const std::vector<Property*>&    batch,
+                                            const std::vector<MetricColumn>& columns,
+                                            std::vector<char>&               found ) {
+    for( size_t k = 0; k < batch.size(); k++ ) {
+        ExecTimeImportanceProp* prop = static_cast<ExecTimeImportanceProp*>( batch[ k ] );
+        prop->phaseCycles  = columns[ 0 ][ k ];
+        prop->nestedCycles = 0;
+        prop->cycles       = columns[ 1 ][ k ] > ( INT64 )0 ? columns[ 1 ][ k ] : 0;
+        if( columns.size() > 2 ) {
+            prop->energyConsumption = columns[ 2 ][ k ];
+            prop->cpuEnergy         = columns[ 3 ][ k ] + columns[ 4 ][ k ];
+        }
+        found[ k ] = prop->condition();
+    }
+}
+
+
 std::string ExecTimeImportanceProp::toXMLExtra() {
     std::stringstream stream;
     stream << "\t\t<cycles>" << cycles << "</cycles>" << std::endl;
@@ -24,6 +24,7 @@
 #include "global.h"
 #include "psc_agent.h"
 #include "timing.h"
+#include "selective_debug.h"
 #include "psc_config.h"
 #include "config.h"
 //#include "analysisagent.h"
@@ -258,6 +259,92 @@ int PeriscopeAgent::connect_to_child( AgentInfo* ag ) {
 }
 
 
+int PeriscopeAgent::reattach_child( AgentInfo* ag,
+                                    bool       relaunched,
+                                    int        map_len,
+                                    int*       map_from,
+                                    int*       map_to ) {
+    if( relaunched ) {
+        if( ag->stream ) {
+            ag->stream->close();
+        }
+        ag->handler = 0;
+        ag->stream  = 0;
+        ag->status  = AgentInfo::STARTED;
+    }
+
+    if( connect_to_child( ag ) == 0 ) {
+        ag->handler->reinit( map_len, map_from, map_to );
+        return 0;
+    }
+    if( !relaunched ) {
+        return -1;
+    }
+
+    // the relaunched child may not listen yet, waiting for it here would block the reactor
+    std::list< PendingReattach >::iterator it;
+    for( it = reattach_pending_.begin(); it != reattach_pending_.end(); it++ ) {
+        if( it->tag == ag->tag ) {
+            break;
+        }
+    }
+    if( it == reattach_pending_.end() ) {
+        it = reattach_pending_.insert( reattach_pending_.end(), PendingReattach() );
+    }
+    it->tag      = ag->tag;
+    it->attempts = 0;
+    it->idmap_from.assign( map_from, map_from + map_len );
+    it->idmap_to.assign( map_to, map_to + map_len );
+
+    if( reattach_timer_ == -1 ) {
+        if( !reattach_ ) {
+            reattach_ = new ReattachTimer( this );
+        }
+        ACE_Time_Value period( 1 );
+        reattach_timer_ = reactor_->schedule_timer( reattach_, 0, period, period );
+    }
+    psc_dbgmsg( 6, "PeriscopeAgent::reattach_child: child %s not listening yet, retrying\n", ag->tag.c_str() );
+    return 0;
+}
+
+
+void PeriscopeAgent::retry_reattach() {
+    std::list< PendingReattach >::iterator it = reattach_pending_.begin();
+    while( it != reattach_pending_.end() ) {
+        std::map< std::string, AgentInfo >::iterator child = child_agents_.find( it->tag );
+        if( child == child_agents_.end() ) {
+            it = reattach_pending_.erase( it );
+            continue;
+        }
+
+        AgentInfo& ag = child->second;
+        if( connect_to_child( &ag ) == 0 ) {
+            ag.handler->reinit( it->idmap_from.size(), it->idmap_from.data(), it->idmap_to.data() );
+            it = reattach_pending_.erase( it );
+        }
+        else if( ++it->attempts >= timeout_delta_ ) {
+            psc_errmsg( "Error connecting to child at %s:%d\n", ag.hostname.c_str(), ag.port );
+            it = reattach_pending_.erase( it );
+        }
+        else {
+            it++;
+        }
+    }
+
+    if( reattach_pending_.empty() && reattach_timer_ != -1 ) {
+        reactor_->cancel_timer( reattach_timer_ );
+        reattach_timer_ = -1;
+    }
+}
+
+
+int ReattachTimer::handle_timeout( const ACE_Time_Value& time,
+                                   const void*           arg ) {
+    agent_->retry_reattach();
+    return 0;
+}
+
+
 void PeriscopeAgent::add_child_agent( std::string tag,
                                       std::string hostname, int port ) {
     AgentInfo info;
@@ -271,3 +358,53 @@ void PeriscopeAgent::add_child_agent( std::string tag,
 #endif
     child_agents_[ tag ] = info;
 }
+
+
+int LivenessTimer::handle_timeout( const ACE_Time_Value& time,
+                                   const void*           arg ) {
+    agent_->liveness_tick();
+    return 0;
+}
+
+
+void PeriscopeAgent::start_liveness( double interval ) {
+    if( liveness_ || interval <= 0 ) {
+        return;
+    }
+    ACE_Time_Value period;
+    period.set( interval );
+    liveness_ = new LivenessTimer( this );
+    reactor_->schedule_timer( liveness_, 0, period, period );
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( HierarchySetup ), "Heartbeat every %.1f seconds, deadline of the children %.1f seconds\n",
+                interval, heartbeats_.getDeadline() );
+}
+
+
+void PeriscopeAgent::liveness_tick() {
+    double                     now    = psc_wall_time();
+    std::vector< std::string > failed = heartbeats_.expire( now );
+    for( size_t i = 0; i < failed.size(); i++ ) {
+        const SubtreeHeartbeat* last = heartbeats_.latest( failed[ i ] );
+        psc_errmsg( "No heartbeat from agent %s for %.0f seconds, lost its subtree of %d agents and %d processes\n",
+                    failed[ i ].c_str(), heartbeats_.getDeadline(), last ? last->agents : 1, last ? last->processes : 0 );
+    }
+
+    bool             changed = heartbeats_.pending( now );
+    SubtreeHeartbeat summary = heartbeats_.flush( now );
+    if( parent_handler_ && ( changed || heartbeats_.getDeadline() > 0 ) ) {
+        parent_handler_->heartbeat( own_info_.hostname, own_info_.port, own_info_.tag,
+                                    SUBTREE_HEARTBEAT, summary.processes, summary.encode() );
+    }
+}
+
+
+bool PeriscopeAgent::subtree_heartbeat( const std::string& tag,
+                                        const std::string& subtree ) {
+    SubtreeHeartbeat summary;
+    if( !SubtreeHeartbeat::decode( subtree, summary ) ) {
+        psc_errmsg( "Malformed heartbeat summary from agent %s: '%s'\n", tag.c_str(), subtree.c_str() );
+        return false;
+    }
+    heartbeats_.beat( tag, summary, psc_wall_time() );
+    return true;
+}
@@ -684,6 +684,7 @@ void Rts::setCallPaths( Rts* node, std::vector<std::string>& callpath_strings, s
     node->callpathstring            = test_callpathstring;
 
     rtscallpath_mapping.insert( std::pair<Rts*, std::string>( node, test_callpathstring ) );
+    appl->getRegistry().bindCallpath( test_callpathstring, node );
 
     // If the node is a parameter node, insert the parameter information
     // Propagate the parameter list from the parameters above this node
@@ -227,7 +227,7 @@ void ConfigAnalysis::createProperty( int propId, int rank, std::string entityID
     Context*  rCt  = NULL;
 
     if( isRtsBased() ) {
-        Rts* rts = appl->getCalltreeRoot()->getRtsByCallpath(entityID);
+        Rts* rts = appl->getRtsByCallpath(entityID);
    	  //psc_dbgmsg(8, "ConfigAnalysis::createProperty: callpath of found rts <%s>\n",rts->getCallPath().c_str());
 
         if ( rts == NULL ) {
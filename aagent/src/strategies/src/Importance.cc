@@ -23,6 +23,7 @@
 #include "Metric.h"
 #include "strategy.h"
 #include "PropertyID.h"
+#include "PropertyBatch.h"
 #include "psc_errmsg.h"
 #include "EnergyConsumption.h"
 #include <iostream>
@@ -191,12 +192,8 @@ bool Importance::evaluateAndReqNextExperiment() {
 
 
     //Evaluate candidate properties
-    for( prop_it = candProperties.begin(); prop_it != candProperties.end(); prop_it++ ) {
-        ( *prop_it )->evaluate();
-        if( ( *prop_it )->condition() ) {
-            foundProperties.push_back( *prop_it );
-        }
-    }
+    PropertyBatchEvaluator evaluator( pdb );
+    evaluator.evaluate( candProperties, foundProperties );
 
     if( psc_get_debug_level() >= 8 ) {
         agent->print_property_set( foundProperties, "SET OF FOUND PROPERTIES", true, true );
@@ -339,7 +339,7 @@ void TuningStrategy::createCandidatePropertyList( std::string      entityID,
 
         if( rtsBased )
         {
-            Rts* rts = appl->getCalltreeRoot()->getRtsByCallpath( entityID );
+            Rts* rts = appl->getRtsByCallpath( entityID );
         //psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL( AutotuneAgentStrategy ), "Tuning Strategy::createCandidatePropertyList: callpath of found rts <%s>\n",rts->getCallPath().c_str());
 
             if ( rts == NULL ) {
@@ -0,0 +1,54 @@
+/**
+   @file    ObjectiveQuantities.h
+   @ingroup Autotune
+   @brief   Quantities of a scenario's results that the objective functions are computed from
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef OBJECTIVE_QUANTITIES_H_
+#define OBJECTIVE_QUANTITIES_H_
+
+/**
+ * @brief Everything the objective functions read from the properties of one scenario
+ *
+ * Filled in one pass over the properties by extract_objective_quantities() and memoised per
+ * scenario in the ScenarioResultsPool. Only ENERGY_CONSUMPTION, INTERPHASE_PROPS and
+ * EXECTIMEIMPORTANCE properties contribute to the energies and times; normalized values divide
+ * each property's contribution by the last TotalInstr seen so far, as the objectives always did.
+ */
+struct ObjectiveQuantities {
+    int    properties;            ///< Number of properties of the scenario
+    double minSeverity;           ///< Smallest severity over all properties
+    double maxSeverity;           ///< Largest severity over all properties
+    double energy;                ///< Severities, NodeEnergy for EXECTIMEIMPORTANCE
+    double cpuEnergy;             ///< Sum of the integral CPUEnergy values
+    double time;                  ///< Execution time as reported by the Time objective
+    double maxTime;               ///< Largest execution time in seconds, -1 if none was found
+    double normalizedEnergy;      ///< Energy per instruction
+    double normalizedCPUEnergy;   ///< CPU energy per instruction
+    double normalizedTime;        ///< Largest time per instruction where TotalInstr is known, 0 if none
+    double normalizedMaxTime;     ///< Largest time per instruction, -1 if none was found
+    int    missingNodeEnergy;     ///< EXECTIMEIMPORTANCE properties without NodeEnergy
+    int    missingCPUEnergy;      ///< Properties without CPUEnergy
+    int    missingTotalInstr;     ///< Properties without TotalInstr
+    int    missingExecTime;       ///< Properties without ExecTime, or cycles for EXECTIMEIMPORTANCE
+    int    missingNormalizedTime; ///< Properties skipped by normalizedTime, including TotalInstr of 0
+
+    ObjectiveQuantities() : properties( 0 ), minSeverity( 0.0 ), maxSeverity( 0.0 ), energy( 0.0 ),
+        cpuEnergy( 0.0 ), time( 0.0 ), maxTime( -1.0 ), normalizedEnergy( 0.0 ), normalizedCPUEnergy( 0.0 ),
+        normalizedTime( 0.0 ), normalizedMaxTime( -1.0 ), missingNodeEnergy( 0 ), missingCPUEnergy( 0 ),
+        missingTotalInstr( 0 ), missingExecTime( 0 ), missingNormalizedTime( 0 ) {
+    }
+};
+
+#endif /* OBJECTIVE_QUANTITIES_H_ */
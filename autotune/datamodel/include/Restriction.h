@@ -82,6 +82,10 @@ public:
         elements.push_back( element );
     }
 
+    void clearElements() {
+        elements.clear();
+    }
+
     bool operator==( const Restriction& in ) const;
 
     bool operator!=( const Restriction& in ) const;
@@ -5,6 +5,7 @@
 #include <map>
 #include <list>
 #include "MetaProperty.h"
+#include "ObjectiveQuantities.h"
 #include "selective_debug.h"
 using namespace std;
 
@@ -26,6 +27,7 @@ class ScenarioResultsPool {
 private:
     map<int, list<ScenarioResult> > results_per_search_step;
     map<int, ScenarioResult >       results_per_scenario_id;
+    map<int, ObjectiveQuantities >  quantities_per_scenario_id;
     pthread_mutex_t                 lock;
     static const pthread_mutex_t    lock_init;
 public:
@@ -44,6 +46,14 @@ public:
 
     list<MetaProperty>getScenarioResultsByID( int scenario_id );
 
+    /// Memoised objective quantities of a scenario; false if they have to be extracted
+    bool getObjectiveQuantities( int                  scenario_id,
+                                 ObjectiveQuantities& quantities );
+
+    /// Memoise the quantities extracted from the current results of a scenario
+    void setObjectiveQuantities( int                        scenario_id,
+                                 const ObjectiveQuantities& quantities );
+
     list<ScenarioResult>getScenarioResultsPerSearchStep( int search_step );
 
     map<int, list<MetaProperty> >getProperties( void );
@@ -229,7 +229,7 @@ ptree Advice::generate_scenario_result_ptree_entry( Scenario* scenario,
                         list<string>::iterator rts_iter;
                         for( rts_iter = ( *ts_iter )->getVariantContext().context_union.entity_list->begin();
                              rts_iter != ( *ts_iter )->getVariantContext().context_union.entity_list->end(); rts_iter++ ) {
-                            Rts*  r = Application::instance().getCalltreeRoot()->getRtsByCallpath( *rts_iter );
+                            Rts*  r = Application::instance().getRtsByCallpath( *rts_iter );
                             if( !r ) {
                                 continue;
                             }
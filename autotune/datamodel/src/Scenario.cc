@@ -106,7 +106,7 @@ Rts* Scenario::getRts()
         psc_abort( "Scenario is not rts based, but rts is requested. Scenario::getRts()\n" );
     }
 
-    return tuned_entity.empty() ? NULL : Application::instance().getCalltreeRoot()->getRtsByCallpath( tuned_entity );
+    return tuned_entity.empty() ? NULL : Application::instance().getRtsByCallpath( tuned_entity );
 }
 
 list<TuningSpecification*>* Scenario::getTuningSpecifications() {
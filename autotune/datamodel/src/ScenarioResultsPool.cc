@@ -48,6 +48,7 @@ void ScenarioResultsPool::push( MetaProperty property,
     try {
         int scenario_id = atoi( property.getExtraInfo().at( "ScenarioID" ).c_str() );
         results_per_scenario_id[ scenario_id ].push( property );
+        quantities_per_scenario_id.erase( scenario_id );
         results_per_search_step[ search_step ].push_back( results_per_scenario_id[ scenario_id ] );
     }
     catch( ... ) {
@@ -76,6 +77,30 @@ list<MetaProperty> ScenarioResultsPool::getScenarioResultsByID( int scenario_id
     }
 }
 
+bool ScenarioResultsPool::getObjectiveQuantities( int                  scenario_id,
+                                                  ObjectiveQuantities& quantities ) {
+    pthread_mutex_lock( &lock );
+    map<int, ObjectiveQuantities>::iterator cached = quantities_per_scenario_id.find( scenario_id );
+    bool                                    found  = cached != quantities_per_scenario_id.end();
+    if( found ) {
+        quantities = cached->second;
+    }
+    pthread_mutex_unlock( &lock );
+
+    return found;
+}
+
+void ScenarioResultsPool::setObjectiveQuantities( int                        scenario_id,
+                                                  const ObjectiveQuantities& quantities ) {
+    pthread_mutex_lock( &lock );
+    // results only grow, so a different count means a push raced with the extraction
+    map<int, ScenarioResult>::iterator results = results_per_scenario_id.find( scenario_id );
+    if( results != results_per_scenario_id.end() && results->second.size() == quantities.properties ) {
+        quantities_per_scenario_id[ scenario_id ] = quantities;
+    }
+    pthread_mutex_unlock( &lock );
+}
+
 list<ScenarioResult> ScenarioResultsPool::getScenarioResultsPerSearchStep( int search_step ) {
     try {
         results_per_search_step.at( search_step );
@@ -102,6 +127,7 @@ void ScenarioResult::push( MetaProperty property ) {
 void ScenarioResultsPool::clear() {
     results_per_search_step.clear();
     results_per_scenario_id.clear();
+    quantities_per_scenario_id.clear();
 }
 
 list<MetaProperty> ScenarioResult::getProperties() {
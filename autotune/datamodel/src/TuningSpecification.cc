@@ -180,7 +180,7 @@ string TuningSpecification::toString( int    indent,
         for( entity_it = context.context_union.entity_list->begin();
              entity_it != context.context_union.entity_list->end();
              entity_it++ ) {
-            temp << Application::instance().getCalltreeRoot()->getRtsByCallpath( *entity_it )->getCallPath(); // TO Do
+            temp << Application::instance().getRtsByCallpath( *entity_it )->getCallPath(); // TO Do
         }
     }
     else if( context.type == variant_context_type( REGION_LIST ) ) {
@@ -0,0 +1,131 @@
+/**
+   @file    ConfigFileTemplate.h
+   @ingroup readex_configuration_tuning
+   @brief   Parsed template of an application input file
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef CONFIG_FILE_TEMPLATE_H_
+#define CONFIG_FILE_TEMPLATE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @class ConfigFileTemplate
+ * @ingroup readex_configuration_tuning
+ *
+ * @brief Renders the input file of a scenario from its template without spawning processes
+ *
+ * The template is read once. Every parameter is then located once in the text, either
+ *
+ *  - as the value of a key: "name = value" or "name: value" lines, optionally inside INI sections
+ *    (parameter "section.name" only matches inside [section]), or the text of an XML element
+ *    <name>value</name> (parameter "parent/name" matches the path suffix, "element@attr" an
+ *    attribute), or
+ *  - as a placeholder: every literal occurrence of the parameter name, which is what the old
+ *    set_configuration_parameter.sh did with sed.
+ *
+ * Rendering concatenates the unchanged text with the values of the scenario and replaces the
+ * input file with a single rename, so an application never reads a partially written file.
+ * Values are inserted literally; in XML files they are escaped, inside quoted values the quote
+ * and backslash are escaped.
+ */
+class ConfigFileTemplate {
+public:
+    enum Format {
+        KEY_VALUE,  ///< "key = value" lines, including INI files with [section] headers
+        XML         ///< Elements and attributes
+    };
+
+    ConfigFileTemplate();
+
+    /// Read and scan the template; false if it cannot be read
+    bool load( const std::string& templatePath );
+
+    /// Use a template given as text, for instance one that is already in memory
+    void setText( const std::string& text,
+                  Format             format );
+
+    /// Locate a parameter in the template; false if the template does not contain it
+    bool addParameter( const std::string& name );
+
+    /// Text of the input file with the given values, unset parameters keep the template text
+    std::string render( const std::map< std::string, std::string >& values ) const;
+
+    /// Render into a temporary file next to path and rename it over path; false on failure
+    bool renderTo( const std::string&                         path,
+                   const std::map< std::string, std::string >& values ) const;
+
+    Format getFormat() const {
+        return format;
+    }
+
+    /// Template text of the first location of a parameter, empty if it is not located
+    std::string currentValue( const std::string& name ) const;
+
+    const std::string& getError() const {
+        return error;
+    }
+
+private:
+    enum Quoting {
+        RAW,           ///< Inserted as given
+        DOUBLE_QUOTED, ///< Inside "..." of a key-value file, quote and backslash are escaped
+        SINGLE_QUOTED, ///< Inside '...' of a key-value file, quote and backslash are escaped
+        XML_ESCAPED    ///< Element text or attribute value, markup characters are escaped
+    };
+
+    struct Location {
+        size_t      begin;
+        size_t      end;
+        Quoting     quoting;
+        bool        placeholder;
+        std::string parameter;
+
+        bool operator<( const Location& other ) const {
+            return begin < other.begin;
+        }
+    };
+
+    /// An entry the scanner found: the key path and the span of its value
+    struct Entry {
+        std::string key;
+        std::string section; ///< INI section or XML path of the parent elements, '/' separated
+        size_t      begin;
+        size_t      end;
+        Quoting     quoting;
+    };
+
+    void scan();
+
+    void scanKeyValue();
+
+    void scanXML();
+
+    bool matches( const Entry&       entry,
+                  const std::string& name ) const;
+
+    static std::string quote( const std::string& value,
+                              Quoting            quoting );
+
+    std::string             templatePath;
+    std::string             text;
+    Format                  format;
+    std::vector< Entry >    entries;
+    std::vector< Location > locations; ///< Sorted by position, never overlapping
+    mutable std::string     error;
+};
+
+#endif /* CONFIG_FILE_TEMPLATE_H_ */
@@ -26,6 +26,7 @@
 
 #include "AutotunePlugin.h"
 #include "AppConfigParameter.h"
+#include "ConfigFileTemplate.h"
 // uncomment the line below if your plugin will load search algorithms
 //#include "ISearchAlgorithm.h"
 
@@ -37,6 +38,7 @@ class readexConfigurationTuningPlugin : public IPlugin {
     string                          searchMode;
     int                             tpID;
     map< std::string, std::string > inputFile;
+    map< std::string, ConfigFileTemplate > inputTemplates; ///< Parsed templates by input file
     ObjectiveFunction*              objective;
 
 
@@ -81,7 +83,10 @@ public:
         inputFile[ templateStr ] = fileStr;
     }
 
-    void copyTemplateFilesToInputFiles();
+    void loadTemplates();
+
+    void writeInputFiles( const map< TuningParameter*, int >& values,
+                          std::ostream*                       settings );
 
 
     void setSearchAlgorithm( string str ) {
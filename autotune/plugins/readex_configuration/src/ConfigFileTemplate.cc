@@ -0,0 +1,477 @@
+/**
+   @file    ConfigFileTemplate.cc
+   @ingroup readex_configuration_tuning
+   @brief   Parsed template of an application input file
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "ConfigFileTemplate.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+static bool is_space( char c ) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+
+static bool ends_with( const std::string& str,
+                       const std::string& suffix ) {
+    return str.size() >= suffix.size() && str.compare( str.size() - suffix.size(), suffix.size(), suffix ) == 0;
+}
+
+
+ConfigFileTemplate::ConfigFileTemplate() : format( KEY_VALUE ) {
+}
+
+
+bool ConfigFileTemplate::load( const std::string& templatePath ) {
+    std::ifstream in( templatePath.c_str(), std::ios::binary );
+    if( in.fail() ) {
+        error = "Cannot read template " + templatePath;
+        return false;
+    }
+    std::stringstream contents;
+    contents << in.rdbuf();
+
+    this->templatePath = templatePath;
+    text               = contents.str();
+
+    size_t first = text.find_first_not_of( " \t\r\n" );
+    if( ends_with( templatePath, ".xml" ) || ( first != std::string::npos && text[ first ] == '<' ) ) {
+        format = XML;
+    }
+    else {
+        format = KEY_VALUE;
+    }
+    scan();
+    return true;
+}
+
+
+void ConfigFileTemplate::setText( const std::string& text,
+                                  Format             format ) {
+    this->text   = text;
+    this->format = format;
+    templatePath.clear();
+    scan();
+}
+
+
+void ConfigFileTemplate::scan() {
+    entries.clear();
+    locations.clear();
+    error.clear();
+    if( format == XML ) {
+        scanXML();
+    }
+    else {
+        scanKeyValue();
+    }
+}
+
+
+void ConfigFileTemplate::scanKeyValue() {
+    std::string section;
+    size_t      line = 0;
+    while( line < text.size() ) {
+        size_t eol = text.find( '\n', line );
+        if( eol == std::string::npos ) {
+            eol = text.size();
+        }
+        size_t pos = line;
+        line = eol + 1;
+
+        while( pos < eol && is_space( text[ pos ] ) ) {
+            pos++;
+        }
+        if( pos == eol || text[ pos ] == '#' || text[ pos ] == ';' || text[ pos ] == '!' ) {
+            continue;
+        }
+        if( text[ pos ] == '[' ) {
+            size_t close = text.find( ']', pos );
+            if( close != std::string::npos && close < eol ) {
+                section = text.substr( pos + 1, close - pos - 1 );
+                size_t from = section.find_first_not_of( " \t" );
+                size_t to   = section.find_last_not_of( " \t" );
+                section = from == std::string::npos ? "" : section.substr( from, to - from + 1 );
+            }
+            continue;
+        }
+
+        size_t separator = text.find_first_of( "=:", pos );
+        if( separator == std::string::npos || separator >= eol ) {
+            continue;
+        }
+        size_t keyEnd = separator;
+        while( keyEnd > pos && is_space( text[ keyEnd - 1 ] ) ) {
+            keyEnd--;
+        }
+        if( keyEnd == pos ) {
+            continue;
+        }
+
+        Entry entry;
+        entry.key     = text.substr( pos, keyEnd - pos );
+        entry.section = section;
+        entry.quoting = RAW;
+
+        size_t value = separator + 1;
+        while( value < eol && ( text[ value ] == ' ' || text[ value ] == '\t' ) ) {
+            value++;
+        }
+        if( value < eol && ( text[ value ] == '"' || text[ value ] == '\'' ) ) {
+            char   quote = text[ value ];
+            size_t close = value + 1;
+            while( close < eol && text[ close ] != quote ) {
+                close += text[ close ] == '\\' ? 2 : 1;
+            }
+            if( close < eol ) {
+                entry.begin   = value + 1;
+                entry.end     = close;
+                entry.quoting = quote == '"' ? DOUBLE_QUOTED : SINGLE_QUOTED;
+                entries.push_back( entry );
+                continue;
+            }
+        }
+
+        // an unquoted value ends at a comment that is separated by white space
+        size_t end = value;
+        while( end < eol && !( ( text[ end ] == '#' || text[ end ] == ';' ) && end > value && is_space( text[ end - 1 ] ) ) ) {
+            end++;
+        }
+        while( end > value && is_space( text[ end - 1 ] ) ) {
+            end--;
+        }
+        entry.begin = value;
+        entry.end   = end;
+        entries.push_back( entry );
+    }
+}
+
+
+void ConfigFileTemplate::scanXML() {
+    struct Element {
+        std::string name;
+        size_t      contentBegin;
+        bool        hasChildren;
+    };
+    std::vector< Element > open;
+
+    size_t pos = 0;
+    while( ( pos = text.find( '<', pos ) ) != std::string::npos ) {
+        if( text.compare( pos, 4, "<!--" ) == 0 ) {
+            size_t end = text.find( "-->", pos + 4 );
+            pos = end == std::string::npos ? text.size() : end + 3;
+            continue;
+        }
+        if( text.compare( pos, 9, "<![CDATA[" ) == 0 ) {
+            size_t end = text.find( "]]>", pos + 9 );
+            pos = end == std::string::npos ? text.size() : end + 3;
+            continue;
+        }
+        if( text.compare( pos, 2, "<?" ) == 0 || text.compare( pos, 2, "<!" ) == 0 ) {
+            size_t end = text.find( '>', pos );
+            pos = end == std::string::npos ? text.size() : end + 1;
+            continue;
+        }
+
+        std::string path;
+        for( size_t i = 0; i < open.size(); i++ ) {
+            path += ( i ? "/" : "" ) + open[ i ].name;
+        }
+
+        if( text.compare( pos, 2, "</" ) == 0 ) {
+            size_t end = text.find( '>', pos );
+            if( end == std::string::npos ) {
+                break;
+            }
+            if( !open.empty() ) {
+                Element element = open.back();
+                open.pop_back();
+                if( !element.hasChildren ) {
+                    size_t begin   = element.contentBegin;
+                    size_t content = pos;
+                    while( begin < content && is_space( text[ begin ] ) ) {
+                        begin++;
+                    }
+                    while( content > begin && is_space( text[ content - 1 ] ) ) {
+                        content--;
+                    }
+                    Entry entry;
+                    entry.key     = element.name;
+                    entry.section = path.substr( 0, path.size() - std::min( path.size(), element.name.size() + 1 ) );
+                    entry.begin   = begin;
+                    entry.end     = content;
+                    entry.quoting = XML_ESCAPED;
+                    entries.push_back( entry );
+                }
+            }
+            pos = end + 1;
+            continue;
+        }
+
+        size_t nameEnd = pos + 1;
+        while( nameEnd < text.size() && !is_space( text[ nameEnd ] ) && text[ nameEnd ] != '/' && text[ nameEnd ] != '>' ) {
+            nameEnd++;
+        }
+        std::string name = text.substr( pos + 1, nameEnd - pos - 1 );
+        if( !open.empty() ) {
+            open.back().hasChildren = true;
+        }
+
+        size_t attr = nameEnd;
+        while( attr < text.size() && text[ attr ] != '>' ) {
+            if( is_space( text[ attr ] ) || text[ attr ] == '/' ) {
+                attr++;
+                continue;
+            }
+            size_t equals = text.find_first_of( "=>", attr );
+            if( equals == std::string::npos || text[ equals ] == '>' ) {
+                attr = equals == std::string::npos ? text.size() : equals;
+                continue;
+            }
+            size_t attrEnd = equals;
+            while( attrEnd > attr && is_space( text[ attrEnd - 1 ] ) ) {
+                attrEnd--;
+            }
+            size_t quote = equals + 1;
+            while( quote < text.size() && is_space( text[ quote ] ) ) {
+                quote++;
+            }
+            if( quote >= text.size() || ( text[ quote ] != '"' && text[ quote ] != '\'' ) ) {
+                attr = quote;
+                continue;
+            }
+            size_t close = text.find( text[ quote ], quote + 1 );
+            if( close == std::string::npos ) {
+                attr = text.size();
+                break;
+            }
+            Entry entry;
+            entry.key     = name + "@" + text.substr( attr, attrEnd - attr );
+            entry.section = path;
+            entry.begin   = quote + 1;
+            entry.end     = close;
+            entry.quoting = XML_ESCAPED;
+            entries.push_back( entry );
+            attr = close + 1;
+        }
+        if( attr >= text.size() ) {
+            break;
+        }
+        if( text[ attr - 1 ] != '/' ) {
+            Element element;
+            element.name         = name;
+            element.contentBegin = attr + 1;
+            element.hasChildren  = false;
+            open.push_back( element );
+        }
+        pos = attr + 1;
+    }
+}
+
+
+bool ConfigFileTemplate::matches( const Entry&       entry,
+                                  const std::string& name ) const {
+    if( entry.key == name ) {
+        return true;
+    }
+    if( format == XML ) {
+        std::string path = entry.section.empty() ? entry.key : entry.section + "/" + entry.key;
+        return path == name || ends_with( path, "/" + name );
+    }
+    return !entry.section.empty() && entry.section + "." + entry.key == name;
+}
+
+
+bool ConfigFileTemplate::addParameter( const std::string& name ) {
+    if( name.empty() ) {
+        error = "Empty parameter name";
+        return false;
+    }
+
+    std::vector< Location > found;
+    for( size_t i = 0; i < entries.size(); i++ ) {
+        if( matches( entries[ i ], name ) ) {
+            Location location = { entries[ i ].begin, entries[ i ].end, entries[ i ].quoting, false, name };
+            found.push_back( location );
+        }
+    }
+
+    bool placeholder = found.empty();
+    if( placeholder ) {
+        for( size_t pos = text.find( name ); pos != std::string::npos; pos = text.find( name, pos + name.size() ) ) {
+            Location location = { pos, pos + name.size(), RAW, true, name };
+            found.push_back( location );
+        }
+    }
+    if( found.empty() ) {
+        error = "Parameter " + name + " does not occur in the template " + templatePath;
+        return false;
+    }
+
+    // a placeholder inside a longer placeholder (P1 in P10) belongs to the longer one
+    std::vector< Location > merged;
+    for( size_t i = 0; i < found.size(); i++ ) {
+        bool keep = true;
+        for( std::vector< Location >::iterator it = locations.begin(); it != locations.end(); ) {
+            if( it->end <= found[ i ].begin || found[ i ].end <= it->begin ) {
+                ++it;
+                continue;
+            }
+            bool inside   = found[ i ].begin >= it->begin && found[ i ].end <= it->end;
+            bool contains = it->begin >= found[ i ].begin && it->end <= found[ i ].end;
+            if( placeholder && it->placeholder && inside ) {
+                keep = false;
+                ++it;
+            }
+            else if( placeholder && it->placeholder && contains && it->parameter != name ) {
+                it = locations.erase( it );
+            }
+            else {
+                error = "Parameter " + name + " overlaps with parameter " + it->parameter + " in the template " + templatePath;
+                return false;
+            }
+        }
+        if( keep ) {
+            merged.push_back( found[ i ] );
+        }
+    }
+
+    locations.insert( locations.end(), merged.begin(), merged.end() );
+    std::sort( locations.begin(), locations.end() );
+    return true;
+}
+
+
+std::string ConfigFileTemplate::quote( const std::string& value,
+                                       Quoting            quoting ) {
+    std::string quoted;
+    quoted.reserve( value.size() );
+    for( size_t i = 0; i < value.size(); i++ ) {
+        char c = value[ i ];
+        switch( quoting ) {
+        case DOUBLE_QUOTED:
+        case SINGLE_QUOTED:
+            if( c == '\\' || c == ( quoting == DOUBLE_QUOTED ? '"' : '\'' ) ) {
+                quoted += '\\';
+            }
+            else if( c == '\n' ) {
+                quoted += "\\n";
+                continue;
+            }
+            quoted += c;
+            break;
+        case XML_ESCAPED:
+            switch( c ) {
+            case '&':
+                quoted += "&amp;";
+                break;
+            case '<':
+                quoted += "&lt;";
+                break;
+            case '>':
+                quoted += "&gt;";
+                break;
+            case '"':
+                quoted += "&quot;";
+                break;
+            case '\'':
+                quoted += "&apos;";
+                break;
+            default:
+                quoted += c;
+            }
+            break;
+        default:
+            quoted += c;
+        }
+    }
+    return quoted;
+}
+
+
+std::string ConfigFileTemplate::render( const std::map< std::string, std::string >& values ) const {
+    std::string rendered;
+    rendered.reserve( text.size() + 64 * locations.size() );
+
+    size_t done = 0;
+    for( size_t i = 0; i < locations.size(); i++ ) {
+        const Location&                                      location = locations[ i ];
+        std::map< std::string, std::string >::const_iterator value    = values.find( location.parameter );
+        if( value == values.end() ) {
+            continue;
+        }
+        rendered.append( text, done, location.begin - done );
+        rendered += quote( value->second, location.quoting );
+        done = location.end;
+    }
+    rendered.append( text, done, std::string::npos );
+    return rendered;
+}
+
+
+bool ConfigFileTemplate::renderTo( const std::string&                          path,
+                                   const std::map< std::string, std::string >& values ) const {
+    std::string rendered = render( values );
+
+    std::vector< char > temporary( path.begin(), path.end() );
+    const char          suffix[] = ".XXXXXX";
+    temporary.insert( temporary.end(), suffix, suffix + sizeof( suffix ) );
+    int fd = mkstemp( &temporary[ 0 ] );
+    if( fd < 0 ) {
+        error = "Cannot create a temporary file for " + path + ": " + strerror( errno );
+        return false;
+    }
+
+    // keep the mode of the existing input file, mkstemp creates it private
+    struct stat existing;
+    fchmod( fd, stat( path.c_str(), &existing ) == 0 ? existing.st_mode & 07777 : 0644 );
+
+    size_t written = 0;
+    while( written < rendered.size() ) {
+        ssize_t n = write( fd, rendered.data() + written, rendered.size() - written );
+        if( n < 0 && errno == EINTR ) {
+            continue;
+        }
+        if( n <= 0 ) {
+            break;
+        }
+        written += n;
+    }
+    bool ok = written == rendered.size();
+    ok = close( fd ) == 0 && ok;
+    if( !ok || rename( &temporary[ 0 ], path.c_str() ) != 0 ) {
+        error = "Cannot write " + path + ": " + strerror( errno );
+        unlink( &temporary[ 0 ] );
+        return false;
+    }
+    return true;
+}
+
+
+std::string ConfigFileTemplate::currentValue( const std::string& name ) const {
+    for( size_t i = 0; i < locations.size(); i++ ) {
+        if( locations[ i ].parameter == name ) {
+            return text.substr( locations[ i ].begin, locations[ i ].end - locations[ i ].begin );
+        }
+    }
+    return "";
+}
@@ -75,28 +75,77 @@ void parse_opts( int   argc,
     }
 }
 
-void readexConfigurationTuningPlugin::copyTemplateFilesToInputFiles() {
+/**
+ * @brief Parses the templates once and locates the tuning parameters in them.
+ * @ingroup readexConfigurationTuningPlugin
+ **/
+void readexConfigurationTuningPlugin::loadTemplates() {
+    inputTemplates.clear();
     for( const auto& input : inputFile ) {
-        stringstream cmd;
-        int          retVal;
-
-        string templateFilename = input.first;
-        string inputFilename    = input.second;
-        cmd << "cp " << templateFilename << " " << inputFilename;
-        string cmdString = cmd.str();
-        psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ), "readexConfigurationTuningPlugin: command for copying template: %s\n", cmdString.c_str() );
-        retVal = system( cmdString.c_str() );
-        if ( retVal != 0 ) {
+        ConfigFileTemplate& config = inputTemplates[ input.second ];
+        if( !config.load( input.first ) ) {
             psc_errmsg( "-----------------------------------------------------------\n" );
-            psc_errmsg( "Fatal: The copying of template file FAILED! Analysis will be terminated.\n" );
+            psc_errmsg( "Fatal: %s! Analysis will be terminated.\n", config.getError().c_str() );
             fe->quit();
             abort();
         }
+        psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ), "readexConfigurationTuningPlugin: parsed template %s for %s as %s\n",
+                    input.first.c_str(), input.second.c_str(), config.getFormat() == ConfigFileTemplate::XML ? "XML" : "key-value" );
+    }
+
+    for( const auto& tp : tuningParameters ) {
+        ConfigFileTemplate& config = inputTemplates[ tp->getfilePath() ];
+        if( !config.addParameter( tp->getName() ) ) {
+            psc_errmsg( "readexConfigurationTuningPlugin: %s\n", config.getError().c_str() );
+            throw PTF_PLUGIN_ERROR( TUNING_PARAMETERS_NOT_FOUND );
+        }
     }
 }
 
+/**
+ * @brief Writes every input file for the given parameter values.
+ * @ingroup readexConfigurationTuningPlugin
+ *
+ * Parameters that are not part of the variant keep their first value. Each input file is
+ * rendered from its template in memory and replaced in a single step.
+ *
+ * @param values   Values of the variant, indices into the value list of each parameter
+ * @param settings Stream to print the chosen settings to, may be NULL
+ **/
+void readexConfigurationTuningPlugin::writeInputFiles( const map< TuningParameter*, int >& values,
+                                                       std::ostream*                       settings ) {
+    map< long, int > valueOfTP;
+    for( const auto& value : values ) {
+        if( AppConfigParameter* tp = dynamic_cast< AppConfigParameter* >( value.first ) ) {
+            valueOfTP[ tp->getId() ] = value.second;
+        }
+    }
+
+    map< std::string, map< std::string, std::string > > fileValues;
+    for( const auto& tp : tuningParameters ) {
+        map< long, int >::const_iterator value = valueOfTP.find( tp->getId() );
+        int                              i     = value == valueOfTP.end() ? tp->getRangeFrom() : value->second;
+        const std::string*               str   = tp->getValueString( i );
+        std::string                      v     = str ? *str : std::to_string( i );
 
+        fileValues[ tp->getfilePath() ][ tp->getName() ] = v;
+        if( settings ) {
+            *settings << "\t" << tp->getName() << ": " << v << "\n";
+        }
+        psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ), "readexConfigurationTuningPlugin: setting ACP %s to %s in %s\n",
+                    tp->getName().c_str(), v.c_str(), tp->getfilePath().c_str() );
+    }
 
+    for( const auto& config : inputTemplates ) {
+        if( !config.second.renderTo( config.first, fileValues[ config.first ] ) ) {
+            psc_errmsg( "-----------------------------------------------------------\n" );
+            psc_errmsg( "Fatal: The application configuration parameter setting has FAILED: %s! Analysis will be terminated.\n",
+                        config.second.getError().c_str() );
+            fe->quit();
+            abort();
+        }
+    }
+}
 
 
 /**
@@ -158,6 +207,7 @@ void readexConfigurationTuningPlugin::initialize( DriverContext*   context,
     }
 
     parseConfig( configFilename.c_str(), this );
+    loadTemplates();
 
 
      if( active_dbgLevel( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ) ) > 0 ) {
@@ -386,58 +436,13 @@ void readexConfigurationTuningPlugin::createScenarios( void ) {
  */
 void readexConfigurationTuningPlugin::prepareScenarios( void ) {
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ), "readexConfigurationTuningPlugin: call to prepareScenarios()\n" );
-    int  retVal = 0;
-
     if( pool_set->csp->empty() ) {
         return;
     }
 
-    Scenario* scenario = pool_set->csp->pop();
-    copyTemplateFilesToInputFiles();
-
-    vector< bool > doneTP;
-    for( size_t i = 0; i < tuningParameters.size(); i++ ) {
-        doneTP.push_back( false );
-    }
-
-    const Variant* v = scenario->getTuningSpecifications()->front()->getVariant();
-    map< TuningParameter*, int > values = v->getValue();
-    for( const auto& value : values ) {
-        int i = value.second;
-        if( AppConfigParameter* tp = dynamic_cast< AppConfigParameter* >( value.first ) ) {
-            doneTP[ tp->getId() ] = true;
-            stringstream cmd;
-            cmd << PERISCOPE_PLUGINS_DIRECTORY << "/readex_configuration/set_configuration_parameter.sh " << tp->getfilePath() << " \"" << tp->getName() << "\" \"" << *(tp->getValueString(i)) << "\"";
-            string cmdString = cmd.str();
-            psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ), "readexConfigurationTuningPlugin: command for setting ACP: %s\n", cmdString.c_str() );
-            retVal = system( cmdString.c_str() );
-            if ( retVal != 0 ) {
-                psc_errmsg( "-----------------------------------------------------------\n" );
-                psc_errmsg( "Fatal: The application configuration parameter setting has FAILED! Analysis will be terminated.\n" );
-                fe->quit();
-                abort();
-            }
-        }
-    }
-
-
-    for( size_t i = 0; i < tuningParameters.size(); i++ ) {
-        if ( !doneTP[ i ] ) {
-            AppConfigParameter* tp = dynamic_cast< AppConfigParameter* >( tuningParameters[ i ] );
-
-            stringstream cmd;
-            cmd << PERISCOPE_PLUGINS_DIRECTORY << "/readex_configuration/set_configuration_parameter.sh " << tp->getfilePath() << " \"" << tp->getName() << "\" \"" << *(tp->getValueString(1)) << "\"";
-            string cmdString = cmd.str();
-            psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ), "readexConfigurationTuningPlugin: command for setting ACP: %s\n", cmdString.c_str() );
-            retVal = system( cmdString.c_str() );
-            if ( retVal != 0 ) {
-                psc_errmsg( "-----------------------------------------------------------\n" );
-                psc_errmsg( "Fatal: The application configuration parameter setting has FAILED! Analysis will be terminated.\n" );
-                fe->quit();
-                abort();
-            }
-        }
-    }
+    Scenario*      scenario = pool_set->csp->pop();
+    const Variant* v        = scenario->getTuningSpecifications()->front()->getVariant();
+    writeInputFiles( v->getValue(), NULL );
 
     pool_set->psp->push( scenario );
     //flags_oss << "Scenario " << scenario->getID() << " flags: " << getAFLAGS( v->getValue(), true, false, false ) << endl;
@@ -573,63 +578,13 @@ Advice* readexConfigurationTuningPlugin::getAdvice( void ) {
     std::ostringstream result_oss;
     map< int, double > timeForScenario = searchAlgorithm->getSearchPath();
 
-    copyTemplateFilesToInputFiles();
-
-    vector< bool > doneTP;
-    for( size_t i = 0; i < tuningParameters.size(); i++ ) {
-        doneTP.push_back( false );
-    }
-
     int optimum = searchAlgorithm->getOptimum();
     result_oss << "Optimum Scenario: " << optimum << endl << endl;
     const list<TuningSpecification*>* tuningSpecifications = pool_set->fsp->getTuningSpecificationByScenarioID( optimum );
     const Variant*                    v                    = tuningSpecifications->front()->getVariant();
-    map< TuningParameter*, int >      values               = v->getValue();
 
     result_oss << "\nConfiguration Parameter settings:\n";
-    for( const auto& value : values ) {
-        int i = value.second;
-        if( AppConfigParameter* tp = dynamic_cast< AppConfigParameter* >( value.first ) ) {
-            const std::string *v = tp->getValueString( i );
-            doneTP[ tp->getId() ] = true;
-
-            result_oss << "\t" << tp->getName() << ": " << *v << "\n";
-
-            stringstream cmd;
-            cmd << PERISCOPE_PLUGINS_DIRECTORY << "/readex_configuration/set_configuration_parameter.sh " << tp->getfilePath() << " \"" << tp->getName() << "\" \"" << *v << "\"";
-            string cmdString = cmd.str();
-            psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ), "readexConfigurationTuningPlugin: command for setting ACP: %s\n", cmdString.c_str() );
-            const int retVal = system( cmdString.c_str() );
-            if ( retVal != 0 ) {
-                psc_errmsg( "-----------------------------------------------------------\n" );
-                psc_errmsg( "Fatal: The application configuration parameter setting has FAILED! Analysis will be terminated.\n" );
-                fe->quit();
-                abort();
-            }
-        }
-    }
-
-
-    for( size_t i = 0; i < tuningParameters.size(); i++ ) {
-        if ( !doneTP[ i ] ) {
-            const std::string*  v  = tuningParameters[ i ]->getValueString( i );
-            AppConfigParameter* tp = dynamic_cast< AppConfigParameter* >( tuningParameters[ i ] );
-
-            result_oss << "\t" << tp->getName() << ": " << *v << "\n";
-
-            stringstream cmd;
-            cmd << PERISCOPE_PLUGINS_DIRECTORY << "/readex_configuration/set_configuration_parameter.sh " << tp->getfilePath() << " \"" << tp->getName() << "\" \"" << *(tp->getValueString(1)) << "\"";
-            string cmdString = cmd.str();
-            psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ), "readexConfigurationTuningPlugin: command for setting ACP: %s\n", cmdString.c_str() );
-            int retVal = system( cmdString.c_str() );
-            if ( retVal != 0 ) {
-                psc_errmsg( "-----------------------------------------------------------\n" );
-                psc_errmsg( "Fatal: The application configuration parameter setting has FAILED! Analysis will be terminated.\n" );
-                fe->quit();
-                abort();
-            }
-        }
-    }
+    writeInputFiles( v->getValue(), &result_oss );
 
     result_oss << "\n------------------------" << endl << endl;
     cout << result_oss.str();
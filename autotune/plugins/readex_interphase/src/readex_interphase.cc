@@ -649,9 +649,9 @@ bool ReadexInterphasePlugin::tuningFinished(void) {
         psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexInterphasePlugin: Inserting phase data in Tuning Step 1\n");
         for (int scenario_id = 0; scenario_id < pool_set->fsp->size(); scenario_id++) {
             Scenario* scenario = pool_set->fsp->getScenarioByScenarioID(scenario_id);
+            std::vector<double> objValues = evaluate_objectives(scenario_id, pool_set->srp, objectives);
             for (int i = 0; i < objectives.size(); i++) {
-                double objValue = objectives[i]->objective(scenario_id, pool_set->srp);
-                scenario->addResult(objectives[i]->getName(), objValue);
+                scenario->addResult(objectives[i]->getName(), objValues[i]);
             }
             insertPhaseData(scenario_id, pool_set);
         }
@@ -668,9 +668,9 @@ bool ReadexInterphasePlugin::tuningFinished(void) {
     {//Insert the default values
         psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexInterphasePlugin: Inserting default phase data in Tuning Step 2\n");
         for (auto& scenario_map : (*pool_set->fsp->getScenarios())) {
+            std::vector<double> objValues = evaluate_objectives(scenario_map.first, pool_set->srp, objectives);
             for (int i = 0; i < objectives.size(); i++) {
-                double objValue = objectives[i]->objective(scenario_map.first, pool_set->srp);
-                scenario_map.second->addResult(objectives[i]->getName(), objValue);
+                scenario_map.second->addResult(objectives[i]->getName(), objValues[i]);
             }
             insertPhaseData(scenario_map.first, pool_set);
         }
@@ -687,9 +687,9 @@ bool ReadexInterphasePlugin::tuningFinished(void) {
         rtstree::displaySavings();
 
         for (auto& scenario_map : (*pool_set->fsp->getScenarios())) {
+            std::vector<double> objValues = evaluate_objectives(scenario_map.first, pool_set->srp, objectives);
             for (int i = 0; i < objectives.size(); i++) {
-                double objValue = objectives[i]->objective(scenario_map.first, pool_set->srp);
-                scenario_map.second->addResult(objectives[i]->getName(), objValue);
+                scenario_map.second->addResult(objectives[i]->getName(), objValues[i]);
             }
             insertPhaseData(scenario_map.first, pool_set);
         }
@@ -811,9 +811,9 @@ void ReadexInterphasePlugin::insertPhaseData( int scenario_id, ScenarioPoolSet*
         }
 
         phaseInf->scenarioID = scenario_id;
-        for(auto obj : objectives) {
-            double objValue = obj->objective(scenario_id, pool_set->srp);
-            phaseInf->objValues.insert(std::make_pair(obj->getName(),objValue));
+        std::vector<double> objValues = evaluate_objectives(scenario_id, pool_set->srp, objectives);
+        for (int i = 0; i < objectives.size(); i++) {
+            phaseInf->objValues.insert(std::make_pair(objectives[i]->getName(),objValues[i]));
         }
 
         phaseInf->scenarioConfig = getTuningParameters(scenario_id);
@@ -859,9 +859,9 @@ void ReadexInterphasePlugin::insertPhaseData( int scenario_id, ScenarioPoolSet*
             for(int phase_id_p = 0; phase_id_p < phase_ident.size(); phase_id_p++) {
                 phase_pos->second->defaultPhaseIdentifiers[tags[phase_id_p]] += phase_ident[phase_id_p];
             }
-            for(auto obj : objectives) {
-                double objValue = obj->objective(scenario_id, pool_set->srp);
-                phase_pos->second->defaultObjValues.insert(std::make_pair(obj->getName(),objValue));
+            std::vector<double> objValues = evaluate_objectives(scenario_id, pool_set->srp, objectives);
+            for (int i = 0; i < objectives.size(); i++) {
+                phase_pos->second->defaultObjValues.insert(std::make_pair(objectives[i]->getName(),objValues[i]));
             }
 
             insertRtsData(scenario_id, pool_set, phase_pos, code_significant_regions, objectives, tags, phase_iter, tuningStep);
@@ -876,9 +876,9 @@ void ReadexInterphasePlugin::insertPhaseData( int scenario_id, ScenarioPoolSet*
             for(int phase_id_p = 0; phase_id_p < phase_ident.size(); phase_id_p++) {
                 phase_pos->second->phaseIdentifiers[tags[phase_id_p]] = phase_ident[phase_id_p];
             }
-            for(auto obj : objectives) {
-                double objValue = obj->objective(scenario_id, pool_set->srp);
-                phase_pos->second->objValues[obj->getName()] = objValue;
+            std::vector<double> objValues = evaluate_objectives(scenario_id, pool_set->srp, objectives);
+            for (int i = 0; i < objectives.size(); i++) {
+                phase_pos->second->objValues[objectives[i]->getName()] = objValues[i];
             }
 
             insertRtsData(scenario_id, pool_set, phase_pos, code_significant_regions, objectives, tags, phase_iter, tuningStep);
@@ -1314,13 +1314,13 @@ void interph::insertTuningResultForNode(std::vector<ObjectiveFunction*> objectiv
         }
 
         //Insert STATIC_BEST tuning results for the current cluster
-        appl->getCalltreeRoot()->getRtsByCallpath(modified_callpath)->insertPluginResult("readex_interphase",
+        appl->getRtsByCallpath(modified_callpath)->insertPluginResult("readex_interphase",
                 dtaPhases.find(cluster_i.second.first)->second->objValues.find(objectives[0]->getName())->second,
                 dtaPhases.find(cluster_i.second.first)->second->scenarioConfig, dtaPhases.find(cluster_i.second.first)->second->objValues,
                 phase_extra_info, STATIC_BEST, phase_identifier_range, cluster_i.second.second );
 
         //Insert DEFAULT objective values for the current cluster
-        appl->getCalltreeRoot()->getRtsByCallpath(modified_callpath)->insertDefaultObjValue(objectives[0]->getName(),ph_default_obj);
+        appl->getRtsByCallpath(modified_callpath)->insertDefaultObjValue(objectives[0]->getName(),ph_default_obj);
 
         //Export phase results to ostream
         result_oss << "\nCluster: " << cluster_i.first << "\n";
@@ -1349,7 +1349,7 @@ void interph::insertTuningResultForNode(std::vector<ObjectiveFunction*> objectiv
             rts_modified_callpath = rts_modified_callpath.insert(pos + appl->getCalltreeRoot()->getCallPath().length(),add_str);
 
             //Insert RTS_BEST configuration for current rts
-            appl->getCalltreeRoot()->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
+            appl->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
                     (*rts_p)->objValues.find(objectives[0]->getName())->second, best_phase->second->scenarioConfig, (*rts_p)->objValues,
                     (*rts_p)->phaseIdentifiers, RTS_BEST );
 
@@ -1363,7 +1363,7 @@ void interph::insertTuningResultForNode(std::vector<ObjectiveFunction*> objectiv
             result_oss << "\t  " << objectives[0]->getName() << " = " << (*rts_p)->objValues.find(objectives[0]->getName())->second << "\n\n\n";
 
             //Insert DEFAULT objective values for current rts
-            appl->getCalltreeRoot()->getRtsByCallpath(rts_modified_callpath)->insertDefaultObjValue(objectives[0]->getName(),
+            appl->getRtsByCallpath(rts_modified_callpath)->insertDefaultObjValue(objectives[0]->getName(),
                     (*rts_p)->defaultObjValues.find(objectives[0]->getName())->second);
 
             //            //Get the static best phase for each rts
@@ -1376,13 +1376,13 @@ void interph::insertTuningResultForNode(std::vector<ObjectiveFunction*> objectiv
             //Check whether we find the current rts for the static best phase
             if( static_rts_p != static_best_phase->second->rtsInfo.end() ) {
                 //Insert STATIC_BEST configuration for current rts
-                appl->getCalltreeRoot()->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
+                appl->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
                         (*static_rts_p)->objValues.find(objectives[0]->getName())->second, static_best_phase->second->scenarioConfig,
                         (*static_rts_p)->objValues, (*static_rts_p)->phaseIdentifiers, STATIC_BEST );
             }
             else {
                 //Insert 0.0 as the objective value for current rts
-                appl->getCalltreeRoot()->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
+                appl->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
                         0.0, static_best_phase->second->scenarioConfig, (*rts_p)->objValues, (*rts_p)->phaseIdentifiers, STATIC_BEST );
             }
         }
@@ -1407,7 +1407,7 @@ void interph::insertResultForNode(std::vector<ObjectiveFunction*> objectives) {
         phase_extra_info.insert(dtaPhases.find(cluster_i.second.first)->second->phaseIdentifiers.begin(),dtaPhases.find(cluster_i.second.first)->second->phaseIdentifiers.end());
 
         //Insert TUNING_RESULT_STATIC tuning results for the current cluster
-        appl->getCalltreeRoot()->getRtsByCallpath(modified_callpath)->insertPluginResult("readex_interphase",
+        appl->getRtsByCallpath(modified_callpath)->insertPluginResult("readex_interphase",
                 dtaPhases.find(cluster_i.second.first)->second->objValues.find(objectives[0]->getName())->second,
                 dtaPhases.find(cluster_i.second.first)->second->scenarioConfig, dtaPhases.find(cluster_i.second.first)->second->objValues,
                 phase_extra_info, TUNING_RESULT_STATIC );
@@ -1426,7 +1426,7 @@ void interph::insertResultForNode(std::vector<ObjectiveFunction*> objectives) {
             rts_modified_callpath = rts_modified_callpath.insert(pos + appl->getCalltreeRoot()->getCallPath().length(),add_str);
 
             //Insert TUNING_RESULT_RTS configuration for current rts
-            appl->getCalltreeRoot()->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
+            appl->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
                     (*rts_p)->objValues.find(objectives[0]->getName())->second, best_phase->second->scenarioConfig, (*rts_p)->objValues,
                     (*rts_p)->phaseIdentifiers, TUNING_RESULT_RTS );
 
@@ -1439,13 +1439,13 @@ void interph::insertResultForNode(std::vector<ObjectiveFunction*> objectives) {
             //Check whether we find the current rts for the static best phase
             if( static_rts_p != static_best_phase->second->rtsInfo.end() ) {
                 //Insert TUNING_RESULT_STATIC configuration for current rts
-                appl->getCalltreeRoot()->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
+                appl->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
                         (*static_rts_p)->objValues.find(objectives[0]->getName())->second, static_best_phase->second->scenarioConfig,
                         (*static_rts_p)->objValues, (*static_rts_p)->phaseIdentifiers, TUNING_RESULT_STATIC );
             }
             else {
                 //Insert 0.0 as the objective value for current rts
-                appl->getCalltreeRoot()->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
+                appl->getRtsByCallpath(rts_modified_callpath)->insertPluginResult("readex_interphase",
                         0.0, static_best_phase->second->scenarioConfig, (*rts_p)->objValues, (*rts_p)->phaseIdentifiers, TUNING_RESULT_STATIC );
             }
         }
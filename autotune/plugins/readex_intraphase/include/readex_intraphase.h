@@ -78,6 +78,9 @@ class ReadexIntraphasePlugin : public IPlugin {
         int                                    freq_step;
         int                                    scenario_no_atp;
         std::unordered_map< std::string, int > optimum_atp_map;
+        int                                    cache_neighbours; ///< Warm start neighbourhood, -1 without a tuning result cache
+        std::string                            cache_callpath;
+        std::string                            cache_input;
 
         static double objectiveFunction_Energy( int scenario_id,
                                                 ScenarioResultsPool* );
@@ -37,6 +37,7 @@
 #include "ExhaustiveATPSearch.h"
 #include "IndividualATPSearch.h"
 #include "ATPService.h"
+#include "TuningResultCache.h"
 #include "regxx.h"
 #include "timing.h"
 
@@ -71,6 +72,7 @@ void ReadexIntraphasePlugin::initialize(DriverContext* context, ScenarioPoolSet*
     psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexIntraphasePlugin: call to initialize()\n");
     tuningStep      = 0;
     scenario_no_atp = 0;
+    cache_neighbours = -1;
     this->context   = context;
     this->pool_set  = pool_set;
     min_freq        = 1200;
@@ -525,6 +527,25 @@ void ReadexIntraphasePlugin::startTuningStep(void) {
         for (rts_it = rtsList.begin(); rts_it != rtsList.end(); rts_it++) {
             searchSpace->addRts(*rts_it);
         }
+
+        // Start from the best configurations of earlier runs on the same phase and input
+        try {
+            cache_neighbours = atoi(configTree.get < std::string > ("Configuration.periscope.tuningResultCache.neighbours").c_str());
+        } catch (exception &e) {
+            cache_neighbours = -1;
+        }
+        if (cache_neighbours >= 0) {
+            std::unordered_map<std::string, std::string> inputIdentifiers;
+            appl->fillBestInputIdentifiers(inputIdentifiers);
+            cache_callpath = (*(rtsList.begin()))->getCallPath();
+            cache_input    = TuningResultCache::inputKey(inputIdentifiers);
+
+            TuningResultCache cache(TuningResultCache::fileFor(appl->get_app_name()));
+            if (cache.load() && cache.warmStart(cache_callpath, cache_input, tuningParameters, cache_neighbours)) {
+                psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexIntraphasePlugin: warm start from %s\n",
+                           TuningResultCache::fileFor(appl->get_app_name()).c_str());
+            }
+        }
         searchAlgorithm->addSearchSpace(searchSpace);
 
         std::string timeUnit;
@@ -848,8 +869,9 @@ bool ReadexIntraphasePlugin::tuningFinished(void) {
                         atp_result_oss << "\t\t\t|  ";
                     }
                 }
+                std::vector<double> objValues = evaluate_objectives(scenario_id, pool_set->srp, objectives);
                 for (int i = 0; i < objectives.size(); i++) {
-                    atp_result_oss << objectives[i]->objective(scenario_id, pool_set->srp) << "\t  ";
+                    atp_result_oss << objValues[i] << "\t  ";
                 }
                 atp_result_oss << endl;
             }
@@ -875,9 +897,27 @@ bool ReadexIntraphasePlugin::tuningFinished(void) {
         //for (int scenario_id = 0; scenario_id < pool_set->fsp->size(); scenario_id++) {
         for (int scenario_id = scenario_no_atp; scenario_id < (scenario_no_atp+pool_set->fsp->size()); scenario_id++) {
             Scenario* scenario = pool_set->fsp->getScenarioByScenarioID(scenario_id);
+            std::vector<double> objValues = evaluate_objectives(scenario_id, pool_set->srp, objectives);
             for (int i = 0; i < objectives.size(); i++) {
-                double objValue = objectives[i]->objective(scenario_id, pool_set->srp);
-                scenario->addResult(objectives[i]->getName(), objValue);
+                scenario->addResult(objectives[i]->getName(), objValues[i]);
+            }
+        }
+
+        if (cache_neighbours >= 0 && !objectives.empty()) {
+            TuningResultCache cache(TuningResultCache::fileFor(appl->get_app_name()));
+            cache.load();
+            for (int scenario_id = scenario_no_atp; scenario_id < (scenario_no_atp+pool_set->fsp->size()); scenario_id++) {
+                std::map<std::string, int> values;
+                for (int i = 0; i < tuningParameters.size(); i++) {
+                    if (getTuningValue(scenario_id, i) != -1) {
+                        values[tuningParameters[i]->getName()] = getTuningValue(scenario_id, i);
+                    }
+                }
+                cache.record(cache_callpath, cache_input, values, objectives[0]->objective(scenario_id, pool_set->srp));
+            }
+            if (!cache.save()) {
+                psc_errmsg("ReadexIntraphasePlugin: cannot write the tuning result cache %s\n",
+                           TuningResultCache::fileFor(appl->get_app_name()).c_str());
             }
         }
 
@@ -959,6 +999,7 @@ bool ReadexIntraphasePlugin::tuningFinished(void) {
 
         //for (int scenario_id = 0; scenario_id < pool_set->fsp->size(); scenario_id++) {
         for (int scenario_id = scenario_no_atp; scenario_id < (scenario_no_atp+pool_set->fsp->size()); scenario_id++) {
+            std::vector<double> objValues = evaluate_objectives(scenario_id, pool_set->srp, objectives);
             result_oss << scenario_id << "\t\t|  ";
             for (int i = 0; i < tuningParameters.size(); i++) {
                 if (getTuningValue(scenario_id, i) != -1) {
@@ -968,35 +1009,35 @@ bool ReadexIntraphasePlugin::tuningFinished(void) {
                 }
             }
             for (int i = 0; i < objectives.size(); i++) {
-                result_oss << objectives[i]->objective(scenario_id, pool_set->srp) << "\t|  ";
+                result_oss << objValues[i] << "\t|  ";
                 // get best static phase time
                 if( bestScenario->getID() == scenario_id && (objectives[i]->getName() == "Time") )
                 {
-                    bestPhaseTime = objectives[i]->objective(scenario_id, pool_set->srp);
+                    bestPhaseTime = objValues[i];
                 }
             }
 
             //Add objectives for best phase scenario
             if( scenario_id == optimumSc ) {
                 for (int obj = 0; obj < objectives.size(); obj++) {
-                    staticBestPhaseObj = objectives[0]->objective(scenario_id, pool_set->srp);
-                    phaseObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objectives[obj]->objective(scenario_id, pool_set->srp)));
+                    staticBestPhaseObj = objValues[0];
+                    phaseObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objValues[obj]));
                 }
             }
             if( scenario_id == worstSc ) {
                 for (int obj = 0; obj < objectives.size(); obj++) {
-                    staticWorstPhaseObj = objectives[0]->objective(scenario_id, pool_set->srp);
-                    worstPhaseObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objectives[obj]->objective(scenario_id, pool_set->srp)));
+                    staticWorstPhaseObj = objValues[0];
+                    worstPhaseObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objValues[obj]));
                 }
             }
             if( scenario_id == optimumNormSc ) {
                 for (int obj = 0; obj < objectives.size(); obj++) {
-                    bestPhaseNormObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objectives[obj]->objective(scenario_id, pool_set->srp)));
+                    bestPhaseNormObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objValues[obj]));
                 }
             }
             if( scenario_id == worstNormSc ) {
                 for (int obj = 0; obj < objectives.size(); obj++) {
-                    worstPhaseNormObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objectives[obj]->objective(scenario_id, pool_set->srp)));
+                    worstPhaseNormObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objValues[obj]));
                 }
             }
             result_oss << endl;
@@ -1286,20 +1327,23 @@ bool ReadexIntraphasePlugin::tuningFinished(void) {
         result_oss << "===============" << endl;
         result_oss << "Scenario: " << readexScenario << endl;
 
-        double readex_energy = objectives[0]->objective(readexScenario, pool_set->srp);
+        std::vector<double> readexValues  = evaluate_objectives(readexScenario, pool_set->srp, objectives);
+        std::vector<double> staticValues  = evaluate_objectives(readexScenario - 1, pool_set->srp, objectives);
+        std::vector<double> defaultValues = evaluate_objectives(readexScenario - 2, pool_set->srp, objectives);
+        double readex_energy = readexValues[0];
 
         for (int i = 0; i < objectives.size(); i++) {
-            result_oss << "\t " << objectives[i]->getName() << ": \t" << objectives[i]->objective(readexScenario, pool_set->srp) << endl;
+            result_oss << "\t " << objectives[i]->getName() << ": \t" << readexValues[i] << endl;
         }
 
         result_oss << endl;
         for (int i = 0; i < objectives.size(); i++) {
-            result_oss << "\t " << objectives[i]->getName() << ": \t" << objectives[i]->objective(readexScenario - 1, pool_set->srp) << endl;
+            result_oss << "\t " << objectives[i]->getName() << ": \t" << staticValues[i] << endl;
         }
 
         result_oss << endl;
         for (int i = 0; i < objectives.size(); i++) {
-            result_oss << "\t " << objectives[i]->getName() << ": \t" << objectives[i]->objective(readexScenario - 2, pool_set->srp) << endl;
+            result_oss << "\t " << objectives[i]->getName() << ": \t" << defaultValues[i] << endl;
         }
 
         cout << result_oss.str();
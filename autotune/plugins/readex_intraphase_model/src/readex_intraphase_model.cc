@@ -34,9 +34,11 @@
 #include "IndividualSearch.h"
 #include "RandomSearch.h"
 #include "GDE3Search.h"
+#include "BayesianSearch.h"
 #include "ExhaustiveATPSearch.h"
 #include "IndividualATPSearch.h"
 #include "ATPService.h"
+#include "TuningResultCache.h"
 #include "regxx.h"
 #include "timing.h"
 
@@ -70,6 +72,7 @@ void ReadexIntraphaseModelPlugin::initialize(DriverContext* context, ScenarioPoo
     psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexIntraphasePlugin: call to initialize()\n");
     tuningStep      = 0;
     scenario_no_atp = 0;
+    cache_neighbours = -1;
     this->context   = context;
     this->pool_set  = pool_set;
 
@@ -155,6 +158,18 @@ void ReadexIntraphaseModelPlugin::startTuningStep(void) {
                     throw PTF_PLUGIN_ERROR(NULL_REFERENCE);
                 }
 
+                try {
+                    std::string samplesString;
+                    samplesString = configTree.get < std::string > ("Configuration.periscope.atp.searchAlgorithm.samples");
+                    int samples = atoi(samplesString.c_str());
+                    if (searchAlgorithmName == "individual_atp" )
+                        ((IndividualATPSearch*) searchAlgorithm)->setSampleCount(samples);
+                    else
+                        ((ExhaustiveATPSearch*) searchAlgorithm)->setSampleCount(samples);
+                    psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexIntraphasePlugin: ATP search - requested samples per domain %d\n", samples);
+                } catch (exception &e) {
+                }
+
                 if (searchAlgorithm) {
                     print_loaded_search(major_atp, minor_atp, name_atp, description_atp);
 
@@ -489,6 +504,33 @@ void ReadexIntraphaseModelPlugin::startTuningStep(void) {
 
         }
 
+        if (searchAlgorithmName == "bayesian") {
+            try {
+                std::string confString;
+                confString = configTree.get < std::string > ("Configuration.periscope.searchAlgorithm.batchSize");
+                int value = atoi(confString.c_str());
+                ((BayesianSearch*) searchAlgorithm)->setBatchSize(value);
+                psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexIntraphasePlugin: Bayesian search - requested batch size %d\n", value);
+            } catch (exception &e) {
+            }
+            try {
+                std::string confString;
+                confString = configTree.get < std::string > ("Configuration.periscope.searchAlgorithm.maxEvaluations");
+                int value = atoi(confString.c_str());
+                ((BayesianSearch*) searchAlgorithm)->setMaxEvaluations(value);
+                psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexIntraphasePlugin: Bayesian search - requested maximal number of evaluations %d\n", value);
+            } catch (exception &e) {
+            }
+            try {
+                std::string confString;
+                confString = configTree.get < std::string > ("Configuration.periscope.searchAlgorithm.initialSamples");
+                int value = atoi(confString.c_str());
+                ((BayesianSearch*) searchAlgorithm)->setInitialSamples(value);
+                psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexIntraphasePlugin: Bayesian search - requested initial samples %d\n", value);
+            } catch (exception &e) {
+            }
+        }
+
         VariantSpace* variantSpace = new VariantSpace();
         SearchSpace* searchSpace = new SearchSpace();
         for (auto& tuningParameter : tuningParameters) {
@@ -503,6 +545,25 @@ void ReadexIntraphaseModelPlugin::startTuningStep(void) {
         for (rts_it = rtsList.begin(); rts_it != rtsList.end(); rts_it++) {
             searchSpace->addRts(*rts_it);
         }
+
+        // Start from the best configurations of earlier runs on the same phase and input
+        try {
+            cache_neighbours = atoi(configTree.get < std::string > ("Configuration.periscope.tuningResultCache.neighbours").c_str());
+        } catch (exception &e) {
+            cache_neighbours = -1;
+        }
+        if (cache_neighbours >= 0) {
+            std::unordered_map<std::string, std::string> inputIdentifiers;
+            appl->fillBestInputIdentifiers(inputIdentifiers);
+            cache_callpath = (*(rtsList.begin()))->getCallPath();
+            cache_input    = TuningResultCache::inputKey(inputIdentifiers);
+
+            TuningResultCache cache(TuningResultCache::fileFor(appl->get_app_name()));
+            if (cache.load() && cache.warmStart(cache_callpath, cache_input, tuningParameters, cache_neighbours)) {
+                psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexIntraphasePlugin: warm start from %s\n",
+                           TuningResultCache::fileFor(appl->get_app_name()).c_str());
+            }
+        }
         searchAlgorithm->addSearchSpace(searchSpace);
 
         std::string timeUnit;
@@ -826,8 +887,9 @@ bool ReadexIntraphaseModelPlugin::tuningFinished(void) {
                         atp_result_oss << "\t\t\t|  ";
                     }
                 }
+                std::vector<double> objValues = evaluate_objectives(scenario_id, pool_set->srp, objectives);
                 for (int i = 0; i < objectives.size(); i++) {
-                    atp_result_oss << objectives[i]->objective(scenario_id, pool_set->srp) << "\t  ";
+                    atp_result_oss << objValues[i] << "\t  ";
                 }
                 atp_result_oss << endl;
             }
@@ -853,10 +915,28 @@ bool ReadexIntraphaseModelPlugin::tuningFinished(void) {
         //for (int scenario_id = 0; scenario_id < pool_set->fsp->size(); scenario_id++) {
         for (int scenario_id = scenario_no_atp; scenario_id < (scenario_no_atp+pool_set->fsp->size()); scenario_id++) {
             Scenario* scenario = pool_set->fsp->getScenarioByScenarioID(scenario_id);
+            std::vector<double> objValues = evaluate_objectives(scenario_id, pool_set->srp, objectives);
             for (int i = 0; i < objectives.size(); i++) {
-                double objValue = objectives[i]->objective(scenario_id, pool_set->srp);
-                scenario->addResult(objectives[i]->getName(), objValue);
+                scenario->addResult(objectives[i]->getName(), objValues[i]);
+            }
+        }
+
+        if (cache_neighbours >= 0 && !objectives.empty()) {
+            TuningResultCache cache(TuningResultCache::fileFor(appl->get_app_name()));
+            cache.load();
+            for (int scenario_id = scenario_no_atp; scenario_id < (scenario_no_atp+pool_set->fsp->size()); scenario_id++) {
+                std::map<std::string, int> values;
+                for (int i = 0; i < tuningParameters.size(); i++) {
+                    if (getTuningValue(scenario_id, i) != -1) {
+                        values[tuningParameters[i]->getName()] = getTuningValue(scenario_id, i);
+                    }
                 }
+                cache.record(cache_callpath, cache_input, values, objectives[0]->objective(scenario_id, pool_set->srp));
+            }
+            if (!cache.save()) {
+                psc_errmsg("ReadexIntraphasePlugin: cannot write the tuning result cache %s\n",
+                           TuningResultCache::fileFor(appl->get_app_name()).c_str());
+            }
         }
 
         std::map<TuningParameter*, int> configurationForVariant, worstConfigurationForVariant;
@@ -937,6 +1017,7 @@ bool ReadexIntraphaseModelPlugin::tuningFinished(void) {
 
         //for (int scenario_id = 0; scenario_id < pool_set->fsp->size(); scenario_id++) {
         for (int scenario_id = scenario_no_atp; scenario_id < (scenario_no_atp+pool_set->fsp->size()); scenario_id++) {
+            std::vector<double> objValues = evaluate_objectives(scenario_id, pool_set->srp, objectives);
             result_oss << scenario_id << "\t\t|  ";
             for (int i = 0; i < tuningParameters.size(); i++) {
                 if (getTuningValue(scenario_id, i) != -1) {
@@ -946,35 +1027,35 @@ bool ReadexIntraphaseModelPlugin::tuningFinished(void) {
                 }
             }
             for (int i = 0; i < objectives.size(); i++) {
-                result_oss << objectives[i]->objective(scenario_id, pool_set->srp) << "\t|  ";
+                result_oss << objValues[i] << "\t|  ";
                 // get best static phase time
                 if( bestScenario->getID() == scenario_id && (objectives[i]->getName() == "Time") )
                 {
-                    bestPhaseTime = objectives[i]->objective(scenario_id, pool_set->srp);
+                    bestPhaseTime = objValues[i];
                 }
             }
 
             //Add objectives for best phase scenario
             if( scenario_id == optimumSc ) {
                 for (int obj = 0; obj < objectives.size(); obj++) {
-                    staticBestPhaseObj = objectives[0]->objective(scenario_id, pool_set->srp);
-                    phaseObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objectives[obj]->objective(scenario_id, pool_set->srp)));
+                    staticBestPhaseObj = objValues[0];
+                    phaseObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objValues[obj]));
                 }
             }
             if( scenario_id == worstSc ) {
                 for (int obj = 0; obj < objectives.size(); obj++) {
-                    staticWorstPhaseObj = objectives[0]->objective(scenario_id, pool_set->srp);
-                    worstPhaseObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objectives[obj]->objective(scenario_id, pool_set->srp)));
+                    staticWorstPhaseObj = objValues[0];
+                    worstPhaseObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objValues[obj]));
                 }
             }
             if( scenario_id == optimumNormSc ) {
                 for (int obj = 0; obj < objectives.size(); obj++) {
-                    bestPhaseNormObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objectives[obj]->objective(scenario_id, pool_set->srp)));
+                    bestPhaseNormObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objValues[obj]));
                 }
             }
             if( scenario_id == worstNormSc ) {
                 for (int obj = 0; obj < objectives.size(); obj++) {
-                    worstPhaseNormObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objectives[obj]->objective(scenario_id, pool_set->srp)));
+                    worstPhaseNormObj.insert(std::pair<std::string, double>(objectives[obj]->getName(), objValues[obj]));
                 }
             }
             result_oss << endl;
@@ -1258,20 +1339,23 @@ bool ReadexIntraphaseModelPlugin::tuningFinished(void) {
         result_oss << "===============" << endl;
         result_oss << "Scenario: " << readexScenario << endl;
 
-        double readex_energy = objectives[0]->objective(readexScenario, pool_set->srp);
+        std::vector<double> readexValues  = evaluate_objectives(readexScenario, pool_set->srp, objectives);
+        std::vector<double> staticValues  = evaluate_objectives(readexScenario - 1, pool_set->srp, objectives);
+        std::vector<double> defaultValues = evaluate_objectives(readexScenario - 2, pool_set->srp, objectives);
+        double readex_energy = readexValues[0];
 
         for (int i = 0; i < objectives.size(); i++) {
-            result_oss << "\t " << objectives[i]->getName() << ": \t" << objectives[i]->objective(readexScenario, pool_set->srp) << endl;
+            result_oss << "\t " << objectives[i]->getName() << ": \t" << readexValues[i] << endl;
         }
 
         result_oss << endl;
         for (int i = 0; i < objectives.size(); i++) {
-            result_oss << "\t " << objectives[i]->getName() << ": \t" << objectives[i]->objective(readexScenario - 1, pool_set->srp) << endl;
+            result_oss << "\t " << objectives[i]->getName() << ": \t" << staticValues[i] << endl;
         }
 
         result_oss << endl;
         for (int i = 0; i < objectives.size(); i++) {
-            result_oss << "\t " << objectives[i]->getName() << ": \t" << objectives[i]->objective(readexScenario - 2, pool_set->srp) << endl;
+            result_oss << "\t " << objectives[i]->getName() << ": \t" << defaultValues[i] << endl;
         }
 
         cout << result_oss.str();
@@ -154,6 +154,18 @@ void ReadexTuningPlugin::startTuningStep(void) {
                     throw PTF_PLUGIN_ERROR(NULL_REFERENCE);
                 }
 
+                try {
+                    std::string samplesString;
+                    samplesString = configTree.get < std::string > ("Configuration.periscope.atp.searchAlgorithm.samples");
+                    int samples = atoi(samplesString.c_str());
+                    if (searchAlgorithmName == "individual_atp" )
+                        ((IndividualATPSearch*) searchAlgorithm)->setSampleCount(samples);
+                    else
+                        ((ExhaustiveATPSearch*) searchAlgorithm)->setSampleCount(samples);
+                    psc_dbgmsg(PSC_SELECTIVE_DEBUG_LEVEL(AutotunePlugins), "ReadexTuningPlugin: ATP search - requested samples per domain %d\n", samples);
+                } catch (exception &e) {
+                }
+
                 if (searchAlgorithm) {
                     print_loaded_search(major_atp, minor_atp, name_atp, description_atp);
                     searchAlgorithm->initialize(context, pool_set);
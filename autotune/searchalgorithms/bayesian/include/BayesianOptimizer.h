@@ -0,0 +1,139 @@
+/**
+   @file    BayesianOptimizer.h
+   @ingroup BayesianSearch
+   @brief   Gaussian process surrogate and batch acquisition of the Bayesian search
+   @author  Periscope Tuning Framework team
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2014, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef BAYESIANOPTIMIZER_H_
+#define BAYESIANOPTIMIZER_H_
+
+#include <cstddef>
+#include <random>
+#include <set>
+#include <vector>
+
+/**
+ * @brief One dimension of the search space.
+ * @ingroup BayesianSearch
+ *
+ * The values of an ordinal dimension are compared by their distance, the
+ * values of a categorical dimension only by equality.
+ */
+struct BayesianDimension {
+    std::vector<int> values;
+    bool             categorical;
+};
+
+/**
+ * @brief Minimizes an objective over a discrete mixed space in batches.
+ * @ingroup BayesianSearch
+ *
+ * A point is the vector of value indices of all dimensions. The first batch
+ * is a Latin hypercube design. Every later batch maximizes the expected
+ * improvement under a Gaussian process with a Matern 5/2 kernel, fitted to
+ * all observations. Within a batch, each chosen point is assumed to attain
+ * the best value observed so far (constant liar), so the following choices
+ * move away from it. The optimizer never proposes a point twice.
+ */
+class BayesianOptimizer {
+public:
+    typedef std::vector<std::size_t> Point;
+
+    BayesianOptimizer( const std::vector<BayesianDimension>& dimensions,
+                       unsigned int                          seed = 0 );
+
+    void setInitialSamples( int samples ) {
+        initialSamples = samples;
+    }
+
+    void setBatchSize( int size ) {
+        batchSize = size;
+    }
+
+    void setMaxEvaluations( int evaluations ) {
+        maxEvaluations = evaluations;
+    }
+
+    /* the next batch, empty once the budget or the space is exhausted */
+    std::vector<Point> propose();
+
+    void observe( const Point& point,
+                  double       value );
+
+    /* whether all proposals are observed and no further batch follows */
+    bool finished() const;
+
+    std::size_t evaluations() const {
+        return points.size();
+    }
+
+    /* the point with the lowest observed value */
+    const Point& best() const;
+
+    double bestValue() const;
+
+    /* the number of points of the space, saturated for huge spaces */
+    double spaceSize() const;
+
+    std::vector<int> values( const Point& point ) const;
+
+private:
+    struct Model {
+        std::vector<std::vector<double> > inputs;
+        std::vector<double>               cholesky;
+        std::vector<double>               alpha;
+        double                            mean;
+        double                            scale;
+        double                            lengthScale;
+    };
+
+    std::vector<double> encode( const Point& point ) const;
+
+    double kernel( const std::vector<double>& a,
+                   const std::vector<double>& b,
+                   double                     lengthScale ) const;
+
+    bool fit( const std::vector<std::vector<double> >& inputs,
+              const std::vector<double>&               outputs,
+              double                                   lengthScale,
+              Model&                                   model,
+              double*                                  likelihood ) const;
+
+    void predict( const Model&               model,
+                  const std::vector<double>& input,
+                  double*                    mean,
+                  double*                    deviation ) const;
+
+    std::vector<Point> initialDesign( std::size_t count );
+
+    std::vector<Point> candidates( const std::set<Point>& excluded );
+
+    Point randomPoint();
+
+    std::size_t budget() const;
+
+    std::vector<BayesianDimension> dimensions;
+    std::mt19937                   random;
+    int                            initialSamples;
+    int                            batchSize;
+    int                            maxEvaluations;
+
+    std::vector<Point>  points;
+    std::vector<double> observations;
+    std::set<Point>     evaluated;
+    std::set<Point>     pending;
+};
+
+#endif /* BAYESIANOPTIMIZER_H_ */
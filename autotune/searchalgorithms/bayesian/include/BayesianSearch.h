@@ -0,0 +1,108 @@
+/**
+   @file    BayesianSearch.h
+   @ingroup BayesianSearch
+   @brief   Bayesian optimisation search algorithm
+   @author  Periscope Tuning Framework team
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2014, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+/**
+ * @defgroup BayesianSearch Bayesian Optimisation Search
+ * @ingroup SearchAlgorithms
+ */
+
+#ifndef BAYESIANSEARCH_H_
+#define BAYESIANSEARCH_H_
+
+#include <boost/scoped_ptr.hpp>
+
+// Autotune includes
+#include "AutotuneSearchAlgorithm.h"
+#include "search_common.h"
+#include "BayesianOptimizer.h"
+
+
+/**
+ * @brief Searches the combined tuning parameters of all search spaces with a surrogate model.
+ * @ingroup BayesianSearch
+ *
+ * Every tuning parameter is one dimension of the optimizer: parameters with string values are
+ * categorical, all others are ordinal over their range or vector restriction. Each round of the
+ * search runs a batch of scenarios in one experiment; searchFinished() returns false until the
+ * experiment budget is spent, so the plugin creates the scenarios of the next batch.
+ */
+class BayesianSearch : public ISearchAlgorithm {
+private:
+    ScenarioPoolSet*     pool_set;
+    vector<SearchSpace*> searchSpaces;
+
+    /* the dimensions of the optimizer in the order of the search spaces and their parameters */
+    vector<TuningParameter*>              parameters;
+    vector<int>                           parameterSpace;
+    boost::scoped_ptr<BayesianOptimizer>  optimizer;
+    map<int, BayesianOptimizer::Point>    scenarioPoints;
+
+    int    batchSize;
+    int    maxEvaluations;
+    int    initialSamples;
+    int    optimum;
+    double optimumValue;
+    int    worst;
+    double worstValue;
+
+    void createOptimizer();
+
+    list<TuningSpecification*>* createTuningSpecifications( const BayesianOptimizer::Point& );
+
+public:
+    BayesianSearch();
+
+    virtual ~BayesianSearch();
+
+    void initialize( DriverContext*,
+                     ScenarioPoolSet* );
+
+    void clear();
+
+    void addObjectiveFunction( ObjectiveFunction* obj );
+
+    void addSearchSpace( SearchSpace* );
+
+    void createScenarios();
+
+    int getOptimum();
+
+    int getWorst();
+
+    map<int, double >getSearchPath();
+
+    bool searchFinished();
+
+    void terminate();
+
+    void finalize();
+
+    void setBatchSize( int size ) {
+        batchSize = size;
+    }
+
+    void setMaxEvaluations( int evaluations ) {
+        maxEvaluations = evaluations;
+    }
+
+    void setInitialSamples( int samples ) {
+        initialSamples = samples;
+    }
+};
+
+#endif /* BAYESIANSEARCH_H_ */
@@ -0,0 +1,411 @@
+/**
+   @file    BayesianOptimizer.cc
+   @ingroup BayesianSearch
+   @brief   Gaussian process surrogate and batch acquisition of the Bayesian search
+   @author  Periscope Tuning Framework team
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2014, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "BayesianOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+/* candidate set of the acquisition, enumerated completely in smaller spaces */
+const std::size_t candidateCount = 2048;
+
+/* length scales tried when fitting the model, in units of a normalized dimension */
+const double lengthScales[] = { 0.05, 0.1, 0.2, 0.35, 0.5, 0.75, 1.0, 1.5 };
+
+/* observation noise relative to the standardized objective */
+const double noise = 1e-4;
+
+/* exploration margin of the expected improvement */
+const double exploration = 0.01;
+
+double expectedImprovement( double best,
+                            double mean,
+                            double deviation ) {
+    if( deviation <= 0.0 ) {
+        return std::max( best - mean - exploration, 0.0 );
+    }
+    double z   = ( best - mean - exploration ) / deviation;
+    double cdf = 0.5 * std::erfc( -z / std::sqrt( 2.0 ) );
+    double pdf = std::exp( -0.5 * z * z ) / std::sqrt( 2.0 * M_PI );
+    return ( best - mean - exploration ) * cdf + deviation * pdf;
+}
+
+/* solves L x = b in place for the lower triangular row-major n x n matrix L */
+void forwardSubstitute( const std::vector<double>& l,
+                        std::size_t                n,
+                        std::vector<double>&       b ) {
+    for( std::size_t i = 0; i < n; i++ ) {
+        double sum = b[ i ];
+        for( std::size_t k = 0; k < i; k++ ) {
+            sum -= l[ i * n + k ] * b[ k ];
+        }
+        b[ i ] = sum / l[ i * n + i ];
+    }
+}
+
+/* solves L^T x = b in place */
+void backSubstitute( const std::vector<double>& l,
+                     std::size_t                n,
+                     std::vector<double>&       b ) {
+    for( std::size_t i = n; i-- > 0; ) {
+        double sum = b[ i ];
+        for( std::size_t k = i + 1; k < n; k++ ) {
+            sum -= l[ k * n + i ] * b[ k ];
+        }
+        b[ i ] = sum / l[ i * n + i ];
+    }
+}
+} /* unnamed namespace */
+
+
+BayesianOptimizer::BayesianOptimizer( const std::vector<BayesianDimension>& dimensions,
+                                      unsigned int                          seed ) :
+    dimensions( dimensions ), random( seed ), initialSamples( 8 ), batchSize( 4 ), maxEvaluations( 64 ) {
+    for( std::size_t d = 0; d < dimensions.size(); d++ ) {
+        if( dimensions[ d ].values.empty() ) {
+            throw std::invalid_argument( "BayesianOptimizer: dimension without values" );
+        }
+    }
+}
+
+double BayesianOptimizer::spaceSize() const {
+    double size = 1.0;
+    for( std::size_t d = 0; d < dimensions.size(); d++ ) {
+        size *= dimensions[ d ].values.size();
+    }
+    return size;
+}
+
+std::vector<int> BayesianOptimizer::values( const Point& point ) const {
+    std::vector<int> result( point.size() );
+    for( std::size_t d = 0; d < point.size(); d++ ) {
+        result[ d ] = dimensions[ d ].values[ point[ d ] ];
+    }
+    return result;
+}
+
+const BayesianOptimizer::Point& BayesianOptimizer::best() const {
+    if( points.empty() ) {
+        throw std::logic_error( "BayesianOptimizer: no observations" );
+    }
+    return points[ std::min_element( observations.begin(), observations.end() ) - observations.begin() ];
+}
+
+double BayesianOptimizer::bestValue() const {
+    if( observations.empty() ) {
+        throw std::logic_error( "BayesianOptimizer: no observations" );
+    }
+    return *std::min_element( observations.begin(), observations.end() );
+}
+
+std::size_t BayesianOptimizer::budget() const {
+    double remaining = spaceSize() - evaluated.size() - pending.size();
+    double allowed   = ( double )maxEvaluations - points.size() - pending.size();
+    return ( std::size_t )std::max( 0.0, std::min( std::min( remaining, allowed ), ( double )batchSize ) );
+}
+
+bool BayesianOptimizer::finished() const {
+    return pending.empty() && budget() == 0;
+}
+
+void BayesianOptimizer::observe( const Point& point,
+                                 double       value ) {
+    pending.erase( point );
+    if( !evaluated.insert( point ).second ) {
+        return;
+    }
+    points.push_back( point );
+    observations.push_back( value );
+}
+
+BayesianOptimizer::Point BayesianOptimizer::randomPoint() {
+    Point point( dimensions.size() );
+    for( std::size_t d = 0; d < dimensions.size(); d++ ) {
+        point[ d ] = std::uniform_int_distribution<std::size_t>( 0, dimensions[ d ].values.size() - 1 )( random );
+    }
+    return point;
+}
+
+/* numeric dimensions are scaled to [0, 1] by value, categorical ones keep their index */
+std::vector<double> BayesianOptimizer::encode( const Point& point ) const {
+    std::vector<double> input( point.size() );
+    for( std::size_t d = 0; d < point.size(); d++ ) {
+        const BayesianDimension& dimension = dimensions[ d ];
+        if( dimension.categorical ) {
+            input[ d ] = point[ d ];
+            continue;
+        }
+        int low  = *std::min_element( dimension.values.begin(), dimension.values.end() );
+        int high = *std::max_element( dimension.values.begin(), dimension.values.end() );
+        input[ d ] = high == low ? 0.0 : ( double )( dimension.values[ point[ d ] ] - low ) / ( high - low );
+    }
+    return input;
+}
+
+/* Matern 5/2 over the scaled distance, a differing category counts as a full range apart */
+double BayesianOptimizer::kernel( const std::vector<double>& a,
+                                  const std::vector<double>& b,
+                                  double                     lengthScale ) const {
+    double squared = 0.0;
+    for( std::size_t d = 0; d < a.size(); d++ ) {
+        double difference = dimensions[ d ].categorical ? ( a[ d ] != b[ d ] ) : a[ d ] - b[ d ];
+        squared += difference * difference;
+    }
+    double r = std::sqrt( 5.0 * squared ) / lengthScale;
+    return ( 1.0 + r + r * r / 3.0 ) * std::exp( -r );
+}
+
+bool BayesianOptimizer::fit( const std::vector<std::vector<double> >& inputs,
+                             const std::vector<double>&               outputs,
+                             double                                   lengthScale,
+                             Model&                                   model,
+                             double*                                  likelihood ) const {
+    std::size_t n = inputs.size();
+
+    double mean = 0.0;
+    for( std::size_t i = 0; i < n; i++ ) {
+        mean += outputs[ i ];
+    }
+    mean /= n;
+    double variance = 0.0;
+    for( std::size_t i = 0; i < n; i++ ) {
+        variance += ( outputs[ i ] - mean ) * ( outputs[ i ] - mean );
+    }
+    double scale = variance > 0.0 ? std::sqrt( variance / n ) : 1.0;
+
+    std::vector<double> l( n * n, 0.0 );
+    for( std::size_t i = 0; i < n; i++ ) {
+        for( std::size_t j = 0; j <= i; j++ ) {
+            double sum = kernel( inputs[ i ], inputs[ j ], lengthScale ) + ( i == j ? noise : 0.0 );
+            for( std::size_t k = 0; k < j; k++ ) {
+                sum -= l[ i * n + k ] * l[ j * n + k ];
+            }
+            if( i == j ) {
+                if( sum <= 0.0 ) {
+                    return false;
+                }
+                l[ i * n + i ] = std::sqrt( sum );
+            }
+            else {
+                l[ i * n + j ] = sum / l[ j * n + j ];
+            }
+        }
+    }
+
+    std::vector<double> alpha( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        alpha[ i ] = ( outputs[ i ] - mean ) / scale;
+    }
+    std::vector<double> standardized = alpha;
+    forwardSubstitute( l, n, alpha );
+    backSubstitute( l, n, alpha );
+
+    if( likelihood ) {
+        double value = 0.0;
+        for( std::size_t i = 0; i < n; i++ ) {
+            value -= 0.5 * standardized[ i ] * alpha[ i ] + std::log( l[ i * n + i ] );
+        }
+        *likelihood = value;
+    }
+
+    model.inputs      = inputs;
+    model.cholesky    = l;
+    model.alpha       = alpha;
+    model.mean        = mean;
+    model.scale       = scale;
+    model.lengthScale = lengthScale;
+    return true;
+}
+
+/* the standardized posterior mean and deviation at an input */
+void BayesianOptimizer::predict( const Model&               model,
+                                 const std::vector<double>& input,
+                                 double*                    mean,
+                                 double*                    deviation ) const {
+    std::size_t         n = model.inputs.size();
+    std::vector<double> k( n );
+    double              m = 0.0;
+    for( std::size_t i = 0; i < n; i++ ) {
+        k[ i ] = kernel( model.inputs[ i ], input, model.lengthScale );
+        m     += k[ i ] * model.alpha[ i ];
+    }
+    forwardSubstitute( model.cholesky, n, k );
+    double variance = 1.0 + noise;
+    for( std::size_t i = 0; i < n; i++ ) {
+        variance -= k[ i ] * k[ i ];
+    }
+    *mean      = m;
+    *deviation = std::sqrt( std::max( variance, 0.0 ) );
+}
+
+/* a Latin hypercube over the value indices, completed randomly where it repeats points */
+std::vector<BayesianOptimizer::Point> BayesianOptimizer::initialDesign( std::size_t count ) {
+    std::vector<std::vector<std::size_t> > strata( dimensions.size() );
+    for( std::size_t d = 0; d < dimensions.size(); d++ ) {
+        std::size_t size = dimensions[ d ].values.size();
+        for( std::size_t i = 0; i < count; i++ ) {
+            double low = ( double )i / count, high = ( double )( i + 1 ) / count;
+            double u   = std::uniform_real_distribution<double>( low, high )( random );
+            strata[ d ].push_back( std::min( ( std::size_t )( u * size ), size - 1 ) );
+        }
+        std::shuffle( strata[ d ].begin(), strata[ d ].end(), random );
+    }
+
+    std::vector<Point> design;
+    for( std::size_t i = 0; i < count; i++ ) {
+        Point point( dimensions.size() );
+        for( std::size_t d = 0; d < dimensions.size(); d++ ) {
+            point[ d ] = strata[ d ][ i ];
+        }
+        for( int attempt = 0; ( evaluated.count( point ) || pending.count( point ) ) && attempt < 100; attempt++ ) {
+            point = randomPoint();
+        }
+        if( evaluated.count( point ) || pending.count( point ) ) {
+            break;
+        }
+        pending.insert( point );
+        design.push_back( point );
+    }
+    return design;
+}
+
+/* all remaining points of a small space, otherwise random points and the neighbourhood of the best ones */
+std::vector<BayesianOptimizer::Point> BayesianOptimizer::candidates( const std::set<Point>& excluded ) {
+    std::set<Point> result;
+
+    if( spaceSize() <= candidateCount ) {
+        Point point( dimensions.size(), 0 );
+        for( ;; ) {
+            if( !excluded.count( point ) ) {
+                result.insert( point );
+            }
+            std::size_t d = 0;
+            while( d < dimensions.size() && ++point[ d ] == dimensions[ d ].values.size() ) {
+                point[ d++ ] = 0;
+            }
+            if( d == dimensions.size() ) {
+                break;
+            }
+        }
+        return std::vector<Point>( result.begin(), result.end() );
+    }
+
+    std::vector<std::size_t> order( observations.size() );
+    for( std::size_t i = 0; i < order.size(); i++ ) {
+        order[ i ] = i;
+    }
+    std::sort( order.begin(), order.end(), [ this ]( std::size_t a, std::size_t b ) {
+        return observations[ a ] < observations[ b ];
+    } );
+    for( std::size_t i = 0; i < order.size() && i < 4; i++ ) {
+        const Point& center = points[ order[ i ] ];
+        for( std::size_t d = 0; d < dimensions.size(); d++ ) {
+            for( std::size_t v = 0; v < dimensions[ d ].values.size(); v++ ) {
+                Point neighbour = center;
+                neighbour[ d ] = v;
+                if( !excluded.count( neighbour ) ) {
+                    result.insert( neighbour );
+                }
+            }
+        }
+    }
+    for( std::size_t attempt = 0; result.size() < candidateCount && attempt < 4 * candidateCount; attempt++ ) {
+        Point point = randomPoint();
+        if( !excluded.count( point ) ) {
+            result.insert( point );
+        }
+    }
+    return std::vector<Point>( result.begin(), result.end() );
+}
+
+std::vector<BayesianOptimizer::Point> BayesianOptimizer::propose() {
+    std::size_t count = budget();
+    if( count == 0 ) {
+        return std::vector<Point>();
+    }
+    if( points.size() + pending.size() < ( std::size_t )initialSamples || points.size() < 2 ) {
+        return initialDesign( count );
+    }
+
+    // execution times and energies span orders of magnitude, their logarithm is smoother
+    bool logarithmic = *std::min_element( observations.begin(), observations.end() ) > 0.0;
+
+    std::vector<std::vector<double> > inputs;
+    std::vector<double>               outputs;
+    for( std::size_t i = 0; i < points.size(); i++ ) {
+        inputs.push_back( encode( points[ i ] ) );
+        outputs.push_back( logarithmic ? std::log( observations[ i ] ) : observations[ i ] );
+    }
+
+    Model  model;
+    double bestLikelihood = -std::numeric_limits<double>::infinity();
+    double lengthScale    = lengthScales[ 0 ];
+    for( std::size_t s = 0; s < sizeof( lengthScales ) / sizeof( lengthScales[ 0 ] ); s++ ) {
+        double likelihood;
+        if( fit( inputs, outputs, lengthScales[ s ], model, &likelihood ) && likelihood > bestLikelihood ) {
+            bestLikelihood = likelihood;
+            lengthScale    = lengthScales[ s ];
+        }
+    }
+
+    std::set<Point> excluded = evaluated;
+    excluded.insert( pending.begin(), pending.end() );
+    std::vector<Point> pool = candidates( excluded );
+    double             lie  = logarithmic ? std::log( bestValue() ) : bestValue();
+
+    std::vector<std::vector<double> > encoded;
+    for( std::size_t c = 0; c < pool.size(); c++ ) {
+        encoded.push_back( encode( pool[ c ] ) );
+    }
+
+    std::vector<Point> batch;
+    while( batch.size() < count ) {
+        if( !fit( inputs, outputs, lengthScale, model, NULL ) ) {
+            break;
+        }
+        double      incumbent   = ( lie - model.mean ) / model.scale;
+        double      bestGain    = -1.0;
+        std::size_t bestIndex   = pool.size();
+        for( std::size_t c = 0; c < pool.size(); c++ ) {
+            if( excluded.count( pool[ c ] ) ) {
+                continue;
+            }
+            double mean, deviation;
+            predict( model, encoded[ c ], &mean, &deviation );
+            double gain = expectedImprovement( incumbent, mean, deviation );
+            if( gain > bestGain ) {
+                bestGain  = gain;
+                bestIndex = c;
+            }
+        }
+        if( bestIndex == pool.size() ) {
+            break;
+        }
+
+        const Point& chosen = pool[ bestIndex ];
+        excluded.insert( chosen );
+        pending.insert( chosen );
+        batch.push_back( chosen );
+        inputs.push_back( encoded[ bestIndex ] );
+        outputs.push_back( lie );
+    }
+    return batch;
+}
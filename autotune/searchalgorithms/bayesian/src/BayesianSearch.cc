@@ -0,0 +1,323 @@
+/**
+   @file    BayesianSearch.cc
+   @ingroup BayesianSearch
+   @brief   Bayesian optimisation search algorithm
+   @author  Periscope Tuning Framework team
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2014, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "BayesianSearch.h"
+#include "search_common.h"
+
+#include <ctime>
+#include <limits>
+
+
+/**
+ * @brief Constructor
+ * @ingroup BayesianSearch
+ */
+BayesianSearch::BayesianSearch() : ISearchAlgorithm(),
+    pool_set( NULL ), batchSize( 4 ), maxEvaluations( 64 ), initialSamples( 8 ),
+    optimum( -1 ), optimumValue( std::numeric_limits<double>::max() ),
+    worst( -1 ), worstValue( -std::numeric_limits<double>::max() ) {
+}
+
+/**
+ * @brief Destructor
+ * @ingroup BayesianSearch
+ */
+BayesianSearch::~BayesianSearch() {
+}
+
+/**
+ * @brief Stores the scenario pool set for the scenarios of the search.
+ * @ingroup BayesianSearch
+ */
+void BayesianSearch::initialize( DriverContext*   context,
+                                 ScenarioPoolSet* poolSet ) {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to initialize()\n" );
+
+    this->pool_set = poolSet;
+}
+
+/**
+ * @brief Forgets the search spaces, the model and the results of a previous search.
+ * @ingroup BayesianSearch
+ */
+void BayesianSearch::clear() {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to clear()\n" );
+
+    searchSpaces.clear();
+    parameters.clear();
+    parameterSpace.clear();
+    scenarioPoints.clear();
+    optimizer.reset();
+    path.clear();
+    scenarioIds  = std::queue<int>();
+    optimum      = -1;
+    optimumValue = std::numeric_limits<double>::max();
+    worst        = -1;
+    worstValue   = -std::numeric_limits<double>::max();
+    objectiveFunctions.clear();
+}
+
+void BayesianSearch::addObjectiveFunction( ObjectiveFunction* obj ) {
+    objectiveFunctions.push_back( obj );
+}
+
+/**
+ * @brief Adds a search space, its tuning parameters become dimensions of the model.
+ * @ingroup BayesianSearch
+ */
+void BayesianSearch::addSearchSpace( SearchSpace* searchSpace ) {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to addSearchSpace()\n" );
+
+    searchSpaces.push_back( searchSpace );
+}
+
+/**
+ * @brief Builds the optimizer over the tuning parameters of all search spaces.
+ * @ingroup BayesianSearch
+ *
+ * The values of a parameter are taken the way the exhaustive search enumerates them.
+ */
+void BayesianSearch::createOptimizer() {
+    vector<BayesianDimension> dimensions;
+    for( size_t i = 0; i < searchSpaces.size(); i++ ) {
+        vector<TuningParameter*> tuningParameters = searchSpaces[ i ]->getVariantSpace()->getTuningParameters();
+        for( size_t j = 0; j < tuningParameters.size(); j++ ) {
+            TuningParameter*  tp = tuningParameters[ j ];
+            BayesianDimension dimension;
+
+            Restriction* r = tp->getRestriction();
+            if( r == NULL || r->getType() != 2 ) {
+                for( int v = tp->getRangeFrom(); v <= tp->getRangeTo(); v += tp->getRangeStep() ) {
+                    dimension.values.push_back( v );
+                }
+            }
+            else {
+                dimension.values = r->getElements();
+            }
+            dimension.categorical = !tp->getStringValues()->empty();
+
+            if( dimension.values.empty() ) {
+                psc_errmsg( "BayesianSearch: Tuning parameter %s has no values.\n", tp->getName().c_str() );
+                abort();
+            }
+            dimensions.push_back( dimension );
+            parameters.push_back( tp );
+            parameterSpace.push_back( i );
+        }
+    }
+
+    optimizer.reset( new BayesianOptimizer( dimensions, static_cast<unsigned int>( std::time( 0 ) ) ) );
+    optimizer->setBatchSize( batchSize );
+    optimizer->setMaxEvaluations( maxEvaluations );
+    optimizer->setInitialSamples( initialSamples );
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ),
+                "BayesianSearch: %d parameters, %.0f scenarios, at most %d evaluations in batches of %d\n",
+                ( int )dimensions.size(), optimizer->spaceSize(), maxEvaluations, batchSize );
+}
+
+/**
+ * @brief One tuning specification per search space, for the values of a point.
+ * @ingroup BayesianSearch
+ */
+list<TuningSpecification*>* BayesianSearch::createTuningSpecifications( const BayesianOptimizer::Point& point ) {
+    vector<int>                 values = optimizer->values( point );
+    list<TuningSpecification*>* ts     = new list<TuningSpecification*>();
+
+    for( size_t i = 0; i < searchSpaces.size(); i++ ) {
+        map<TuningParameter*, int> value;
+        for( size_t j = 0; j < parameters.size(); j++ ) {
+            if( parameterSpace[ j ] == ( int )i ) {
+                value[ parameters[ j ] ] = values[ j ];
+            }
+        }
+        Variant* variant = new Variant( value );
+
+        if( withRtsSupport() ) {
+            list<Rts*>*  rtsList   = new list<Rts*>;
+            vector<Rts*> rtsVector = searchSpaces[ i ]->getRts();
+            if( rtsVector.size() > 0 ) {
+                rtsList->push_back( rtsVector[ 0 ] );
+            }
+            ts->push_back( new TuningSpecification( variant, rtsList ) );
+        }
+        else {
+            list<Region*>* regions = new list<Region*>;
+            regions->push_back( searchSpaces[ i ]->getRegions()[ 0 ] );
+            ts->push_back( new TuningSpecification( variant, regions ) );
+        }
+    }
+    return ts;
+}
+
+/**
+ * @brief Creates the scenarios of the next batch.
+ * @ingroup BayesianSearch
+ */
+void BayesianSearch::createScenarios() {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to createScenarios()\n" );
+
+    if( objectiveFunctions.size() == 0 ) {
+        addObjectiveFunction( new PTF_minObjective( "" ) );
+    }
+
+    if( searchSpaces.size() == 0 ) {
+        psc_errmsg( "Fatal: No search space passed to Bayesian search.\n" );
+        abort();
+    }
+
+    if( !optimizer ) {
+        createOptimizer();
+    }
+
+    vector<BayesianOptimizer::Point> batch = optimizer->propose();
+    for( size_t i = 0; i < batch.size(); i++ ) {
+        Scenario* scenario = new Scenario( createTuningSpecifications( batch[ i ] ) );
+        pool_set->csp->push( scenario );
+        scenarioIds.push( scenario->getID() );
+        scenarioPoints[ scenario->getID() ] = batch[ i ];
+    }
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneAll ), "BayesianSearch: %d scenarios in batch, %d evaluated\n",
+                ( int )batch.size(), ( int )optimizer->evaluations() );
+}
+
+/**
+ * @brief Feeds the results of the batch to the model.
+ * @ingroup BayesianSearch
+ *
+ * Returns false while the model proposes further scenarios.
+ */
+bool BayesianSearch::searchFinished() {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to searchFinished()\n" );
+
+    while( !scenarioIds.empty() ) {
+        int scenario_id = scenarioIds.front();
+        scenarioIds.pop();
+
+        double objValue = objectiveFunctions[ 0 ]->objective( scenario_id, pool_set->srp );
+        path[ scenario_id ] = objValue;
+        optimizer->observe( scenarioPoints[ scenario_id ], objValue );
+
+        if( optimum == -1 || objValue < optimumValue ) {
+            optimum      = scenario_id;
+            optimumValue = objValue;
+        }
+        if( worst == -1 || objValue > worstValue ) {
+            worst      = scenario_id;
+            worstValue = objValue;
+        }
+    }
+
+    if( !optimizer->finished() ) {
+        return false;
+    }
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneAll ), "BayesianSearch: finished after %d evaluations, optimum %f in scenario %d\n",
+                ( int )optimizer->evaluations(), optimumValue, optimum );
+    return true;
+}
+
+/**
+ * @brief Returns the scenario with the lowest objective value.
+ * @ingroup BayesianSearch
+ */
+int BayesianSearch::getOptimum() {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to getOptimum()\n" );
+
+    return optimum;
+}
+
+/**
+ * @brief Returns the scenario with the highest objective value.
+ * @ingroup BayesianSearch
+ */
+int BayesianSearch::getWorst() {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to getWorst()\n" );
+
+    if( worst == -1 ) {
+        psc_abort( "Error: No worst scenario has been determined yet." );
+    }
+    return worst;
+}
+
+/**
+ * @brief Returns the objective values of all evaluated scenarios.
+ * @ingroup BayesianSearch
+ */
+map<int, double> BayesianSearch::getSearchPath() {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to getSearchPath()\n" );
+
+    return path;
+}
+
+void BayesianSearch::terminate() {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to terminate()\n" );
+}
+
+void BayesianSearch::finalize() {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to finalize()\n" );
+    terminate();
+}
+
+/**
+ * @brief Returns a new instance of the search algorithm.
+ * @ingroup BayesianSearch
+ */
+ISearchAlgorithm* getSearchAlgorithmInstance( void ) {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to getSearchAlgorithmInstance()\n" );
+
+    return new BayesianSearch();
+}
+
+/**
+ * @brief Return the current major version number.
+ * @ingroup BayesianSearch
+ **/
+int getVersionMajor( void ) {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to getVersionMajor()\n" );
+
+    return 1;
+}
+
+/**
+ * @brief Return the current minor version number.
+ * @ingroup BayesianSearch
+ **/
+int getVersionMinor( void ) {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to getVersionMinor()\n" );
+
+    return 0;
+}
+
+/**
+ * @brief Return the name of the search algorithm.
+ * @ingroup BayesianSearch
+ **/
+string getName( void ) {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to getName()\n" );
+
+    return "Bayesian Search";
+}
+
+/**
+ * @brief Return a short description.
+ * @ingroup BayesianSearch
+ **/
+string getShortSummary( void ) {
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "BayesianSearch: call to getShortSummary()\n" );
+
+    return "Bayesian optimisation with a Gaussian process surrogate and batch expected improvement";
+}
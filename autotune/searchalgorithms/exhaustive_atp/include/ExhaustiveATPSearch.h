@@ -42,6 +42,10 @@ private:
     double               worstValue;
     atpService*          atpServc;
 
+    // draw this many configurations of a constraint space instead of enumerating it, 0 for all
+    int                  sampleCount;
+    std::mt19937         random;
+
 public:
     ExhaustiveATPSearch();
 
@@ -58,6 +62,13 @@ public:
                      int,
                      list<TuningSpecification*>* );
 
+    bool iterate_constraint_space( const std::string&,
+                                   vector<TuningParameter*>*,
+                                   map<TuningParameter*, int>*,
+                                   list<TuningSpecification*>*,
+                                   int,
+                                   int );
+
     void iterate_valid_combination(  int,
                                      int,
                                      std::unordered_map<int, std::vector<int32_t>>& ,
@@ -87,6 +98,10 @@ public:
         atpServc = atp_srvc;
     }
 
+    void setSampleCount( int sc ) {
+        sampleCount = sc;
+    }
+
 };
 
 #endif /* EXHAUSTIVEATPSEARCH_H_ */
@@ -1,13 +1,15 @@
 #include "ExhaustiveATPSearch.h"
 #include "search_common.h"
 #include <cassert>
+#include <set>
 #include <vector>
 
 
 
 
 ExhaustiveATPSearch::ExhaustiveATPSearch() : ISearchAlgorithm(), pool_set( NULL ), optimum( -1 ), optimumValue( std::numeric_limits<double>::max() ),
-                                       worst( -1 ), worstValue( std::numeric_limits<double>::max() ), atpServc(NULL){ }
+                                       worst( -1 ), worstValue( std::numeric_limits<double>::max() ), atpServc(NULL),
+                                       sampleCount( 0 ), random( 1 ){ }
 
 
 void ExhaustiveATPSearch::initialize( DriverContext*   context,
@@ -117,13 +119,76 @@ void ExhaustiveATPSearch::iterate_SS( int                         SS_index,
     vector<TuningParameter*> tuningParameters;
     /* Query for valid configurations with default domain. Currently the first domain is the default domain */
     std::string domain_name = searchSpaces[ SS_index ]->getDomain();
-    if(!domain_name.empty())
-        validCombinations = atpServc->getValidConfigurations(domain_name.c_str());
     tuningParameters = searchSpaces[ SS_index ]->getVariantSpace()->getTuningParameters();
     map<TuningParameter*, int>* variant_SS = new map<TuningParameter*, int>;
+    if( !domain_name.empty() && iterate_constraint_space( domain_name, &tuningParameters, variant_SS, ts, SS_index, n_SS ) ) {
+        return;
+    }
+    if(!domain_name.empty())
+        validCombinations = atpServc->getValidConfigurations(domain_name.c_str());
     iterate_valid_combination( 0, tuningParameters.size(), validCombinations, &tuningParameters,  variant_SS, ts, SS_index, n_SS ); //0,6,..,..,..,0,1
 }
 
+/* Enumerate the valid configurations of the domain from its constraint expressions, one at a time,
+   instead of receiving all of them from the ATP server. With a sample count, draw that many distinct
+   valid configurations at random instead. False if the server sent no usable constraint space or a
+   tuning parameter is not part of it. */
+bool ExhaustiveATPSearch::iterate_constraint_space( const std::string&          domain_name,
+                                                    vector<TuningParameter*>*   tuningParameters,
+                                                    map<TuningParameter*, int>* VariantSS,
+                                                    list<TuningSpecification*>* ts,
+                                                    int                         SS_index,
+                                                    int                         n_SS ) {
+    const ATPConstraintSpace* space = atpServc->getConstraintSpace( domain_name.c_str() );
+    if( space == NULL ) {
+        return false;
+    }
+
+    vector<int> index;
+    for( const auto& tp : *tuningParameters ) {
+        index.push_back( space->index( tp->getName() ) );
+        if( index.back() < 0 ) {
+            psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "ExhaustiveATP Search: %s is not in the constraint space of domain %s\n",
+                        tp->getName().c_str(), domain_name.c_str() );
+            return false;
+        }
+    }
+
+    std::unordered_map<int, std::vector<int32_t>> noCombinations;
+    std::vector<int32_t>                           values;
+    int                                            n_TP = tuningParameters->size();
+    int                                            valid = 0;
+    if( sampleCount > 0 ) {
+        // as in the random search, give up on distinct draws after three times the requested count
+        std::set<std::vector<int32_t>> drawn;
+        for( int i = 0; valid < sampleCount && i < 3 * sampleCount && space->sample( random, values ); i++ ) {
+            if( !drawn.insert( values ).second ) {
+                continue;
+            }
+            for( int j = 0; j < n_TP; ++j ) {
+                ( *VariantSS )[ ( *tuningParameters )[ j ] ] = values[ index[ j ] ];
+            }
+            iterate_valid_combination( n_TP, n_TP, noCombinations, tuningParameters, VariantSS, ts, SS_index, n_SS );
+            valid++;
+        }
+        psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "ExhaustiveATP Search: %d valid configurations drawn for domain %s\n",
+                    valid, domain_name.c_str() );
+        return true;
+    }
+
+    ATPConstraintSpace::Enumerator walk = space->enumerate();
+    while( walk.next( values ) ) {
+        for( int j = 0; j < n_TP; ++j ) {
+            ( *VariantSS )[ ( *tuningParameters )[ j ] ] = values[ index[ j ] ];
+        }
+        iterate_valid_combination( n_TP, n_TP, noCombinations, tuningParameters, VariantSS, ts, SS_index, n_SS );
+        valid++;
+    }
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotuneSearch ), "ExhaustiveATP Search: %d valid configurations enumerated for domain %s\n",
+                valid, domain_name.c_str() );
+    return true;
+}
+
 void ExhaustiveATPSearch::iterate_valid_combination(  int TP_index,
                                                       int n_TP,
                                                       std::unordered_map<int, std::vector<int32_t>>& validCombinations,
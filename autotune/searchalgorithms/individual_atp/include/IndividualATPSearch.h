@@ -51,6 +51,7 @@ private:
     int                      worstScenario; // Currently worst scenario
     double                   worstEnergy;     // Currently worst Energy
     atpService*              atpServc;
+    int                      sampleCount; // configurations drawn per domain, 0 for all
 
 public:
     IndividualATPSearch();
@@ -91,6 +92,14 @@ public:
     void setATPService( atpService* atp_srvc ){
         atpServc = atp_srvc;
     };
+
+    /**
+     * @brief Draws this many valid configurations of each domain at random instead of exploring all of them.
+     * @ingroup IndividualATPSearch
+     */
+    void setSampleCount( int sc ) {
+        sampleCount = sc;
+    };
 };
 int getTPIndex( string , vector<TuningParameter*> );
 #endif
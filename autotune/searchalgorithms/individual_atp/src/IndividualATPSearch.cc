@@ -25,7 +25,7 @@
  * @ingroup IndividualATPSearch
  *
  **/
-IndividualATPSearch::IndividualATPSearch() : ISearchAlgorithm() {
+IndividualATPSearch::IndividualATPSearch() : ISearchAlgorithm(), atpServc( NULL ), sampleCount( 0 ) {
 }
 
 /**
@@ -68,9 +68,10 @@ void IndividualATPSearch::initialize( DriverContext*   context,
     search_algorithm = "exhaustive_atp";
     context->loadSearchAlgorithm( search_algorithm, &major, &minor, &name, &description );
     searchAlgorithm = context->getSearchAlgorithmInstance( search_algorithm );
-    ((ExhaustiveATPSearch*)searchAlgorithm)->setATPService (atpServc);
 
     if( searchAlgorithm != NULL ) {
+        ((ExhaustiveATPSearch*)searchAlgorithm)->setATPService (atpServc);
+        ((ExhaustiveATPSearch*)searchAlgorithm)->setSampleCount( sampleCount );
         print_loaded_search( major, minor, name, description );
         searchAlgorithm->initialize( context, pool_set );
     }
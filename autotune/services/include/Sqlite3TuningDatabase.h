@@ -7,6 +7,8 @@
 #ifdef PSC_SQLITE3_ENABLED
 
 #include <sqlite3.h>
+#include <utility>
+#include <vector>
 
 class sqlite3_error : public std::runtime_error {
 public:
@@ -15,8 +17,23 @@ public:
 };
 
 
+/**
+ * Tuning database in an SQLite3 file that several tuning jobs may write at the same time.
+ *
+ * The database keeps the rollback journal, which is safe on network file systems. Setting
+ * $PSC_TUNING_DB_WAL switches a database on a local file system to write-ahead logging, so readers
+ * never block and writers only wait for each other while a transaction commits. saveSignature()
+ * and saveTuningCase() only buffer the data. commit() writes it in short transactions of at most
+ * batchSize tuning cases, each recorded under the run identifier and a batch number, and retries
+ * a batch with backoff while another job holds the lock. A job that crashed can be run again with
+ * the same identifier: batches committed before are skipped.
+ */
 class Sqlite3TuningDatabase : public TuningDatabase {
 public:
+    static const size_t batchSize   = 256;  ///< Tuning cases per transaction
+    static const int    maxRetries  = 10;   ///< Attempts of a batch that finds the database busy
+    static const int    busyTimeout = 5000; ///< Milliseconds SQLite waits for a lock before an attempt fails
+
     explicit Sqlite3TuningDatabase( std::string filename );
 
     ~Sqlite3TuningDatabase();
@@ -35,10 +52,40 @@ public:
 
     void commit();
 
+    /**
+     * Identifier of the run the saved data belongs to. Defaults to $PSC_TUNING_RUN_ID, or to an
+     * identifier unique to this process if that is not set.
+     */
+    void setRunId( std::string const& run ) {
+        runId = run;
+    }
+
+    std::string const& getRunId() const {
+        return runId;
+    }
+
 private:
-    sqlite3* db; ///< SQLite3 database connection
+    sqlite3*                                             db;                ///< SQLite3 database connection
+    std::string                                          runId;             ///< Run of the buffered data
+    int                                                  nextBatch;         ///< Number of the next batch of the run
+    std::vector<std::pair<ProgramID, ProgramSignature> > pendingSignatures; ///< Saved, not yet committed
+    std::vector<std::pair<ProgramID, TuningCase> >       pendingCases;      ///< Saved, not yet committed
+
+    void execute( const char* sql );
+
+    bool isBusy() const;
+
+    static void backoff( int attempt );
+
+    void commitBatch( int    batch,
+                      bool   signatures,
+                      size_t first,
+                      size_t last );
 
-    void disableAutocommit();
+    bool writeBatch( int    batch,
+                     bool   signatures,
+                     size_t first,
+                     size_t last );
 
     int queryIdByText( ProgramID const& text );
 
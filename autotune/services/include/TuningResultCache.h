@@ -0,0 +1,117 @@
+#ifndef TUNINGRESULTCACHE_H_
+#define TUNINGRESULTCACHE_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class TuningParameter;
+
+/**
+ * A configuration measured in an earlier tuning run: tuning parameter values by parameter name
+ * and the objective value, lower is better.
+ */
+struct CachedConfiguration {
+    std::map<std::string, int> values;
+    double                     objective;
+};
+
+/**
+ * Persistent per-application cache of tuning results, keyed by RTS call path and input identifier.
+ *
+ * For every key the cache keeps the best configuration and those within a tolerance of it, at most
+ * capacity of them. A later tuning run of the same application and input starts from them:
+ * warmStart() restricts the tuning parameters to the cached values and their neighbours, best
+ * value first, so that the search only explores the neighbourhood of the known optima.
+ */
+class TuningResultCache {
+public:
+    static const double defaultTolerance; ///< Relative distance to the best objective of near-best entries
+    static const size_t defaultCapacity = 8;
+
+    explicit TuningResultCache( std::string filename_,
+                                double      tolerance_ = defaultTolerance,
+                                size_t      capacity_ = defaultCapacity );
+
+    /**
+     * Cache file of an application: <application>.tuning_cache.json in $PSC_TUNING_CACHE_DIR,
+     * or in the working directory if that is not set.
+     */
+    static std::string fileFor( std::string const& application );
+
+    /**
+     * Key of an input: the identifiers as name=value pairs sorted by name, separated by ';'.
+     */
+    static std::string inputKey( std::unordered_map<std::string, std::string> const& identifiers );
+
+    /** Read the cache file; false if there is none or it cannot be parsed, leaving the cache empty */
+    bool load();
+
+    /**
+     * Write the cache file, replacing it atomically; false on an I/O error. Under an exclusive lock
+     * on <file>.lock, what other runs saved since load() is read again and merged in first, so that
+     * concurrent runs of the application keep each other's results.
+     */
+    bool save();
+
+    /** Record a measured configuration; a configuration measured again takes the new objective */
+    void record( std::string const&                callpath,
+                 std::string const&                input,
+                 std::map<std::string, int> const& values,
+                 double                            objective );
+
+    /** Best and near-best configurations, best first; NULL if the key was never tuned */
+    std::vector<CachedConfiguration> const* lookup( std::string const& callpath,
+                                                    std::string const& input ) const;
+
+    /**
+     * Values of a parameter to explore on the range from:to:step: the values of the cached
+     * configurations in their order, then up to "neighbours" steps around each of them.
+     * Empty if no cached configuration has a value of the parameter on the range.
+     */
+    std::vector<int> candidates( std::string const& callpath,
+                                 std::string const& input,
+                                 std::string const& name,
+                                 int                from,
+                                 int                to,
+                                 int                step,
+                                 int                neighbours ) const;
+
+    /**
+     * Prune the tuning parameters to their candidates: a vector restriction with the candidates,
+     * honoured by exhaustive and individual search, and the range narrowed to enclose them, for
+     * the search algorithms that sample the range. Parameters without candidates are left as
+     * they are. Returns false, changing nothing, if the key was never tuned.
+     */
+    bool warmStart( std::string const&                   callpath,
+                    std::string const&                   input,
+                    std::vector<TuningParameter*> const& parameters,
+                    int                                  neighbours = 1 ) const;
+
+    size_t size() const {
+        return entries.size();
+    }
+
+private:
+    typedef std::pair<std::string, std::string> Key; ///< Call path and input key
+    typedef std::map<Key, std::vector<CachedConfiguration> > Entries;
+
+    /** Parse a cache file into entries; false if there is none or it cannot be parsed */
+    static bool read( std::string const& filename,
+                      Entries&           entries );
+
+    /** Write the entries to a temporary file and rename it over the cache file */
+    bool write() const;
+
+    /** Sort by objective and keep the best and near-best configurations */
+    void prune( std::vector<CachedConfiguration>& list ) const;
+
+    std::string                                   filename;
+    double                                        tolerance;
+    size_t                                        capacity;
+    Entries                                       entries; ///< Sorted by objective
+};
+
+#endif /* TUNINGRESULTCACHE_H_ */
@@ -20,6 +20,7 @@
 #define SEARCH_COMMON_H_
 
 #include <list>
+#include <vector>
 //#include "ISearchAlgorithm.h"
 #include "ScenarioResultsPool.h"
 #include "ScenarioPoolSet.h"
@@ -35,121 +36,140 @@ public:
     virtual std::string getName()=0;
     std::string getUnit(){return unit;}
     ObjectiveFunction(std::string unitName){unit=unitName;}
-    ~ObjectiveFunction(){};
+    virtual ~ObjectiveFunction(){};
 };
 
-class EnergyObjective:public ObjectiveFunction{
+/// Extract the quantities of all objectives in a single pass over the properties
+ObjectiveQuantities extract_objective_quantities(std::list<MetaProperty>& props);
+
+/// Quantities of a scenario, memoised in the pool until new results of the scenario arrive
+ObjectiveQuantities objective_quantities(int scenario_id, ScenarioResultsPool* properties);
+
+/// Values of several objectives for a scenario, extracting its quantities at most once
+std::vector<double> evaluate_objectives(int scenario_id, ScenarioResultsPool* properties,
+                                        const std::vector<ObjectiveFunction*>& objectives);
+
+/// Objective that is a function of the ObjectiveQuantities of a scenario
+class QuantityObjective:public ObjectiveFunction{
 public:
     double objective(int scenario_id, ScenarioResultsPool* properties);
     double objective(std::list<MetaProperty>& props);
+    virtual double objective(const ObjectiveQuantities& quantities)=0;
+    QuantityObjective(std::string unitName):ObjectiveFunction(unitName){};
+};
+
+class EnergyObjective:public QuantityObjective{
+public:
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    EnergyObjective(std::string unitN):ObjectiveFunction(unitN){};
+    EnergyObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class NormalizedEnergyObjective:public ObjectiveFunction{
+class NormalizedEnergyObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    NormalizedEnergyObjective(std::string unitN):ObjectiveFunction(unitN){};
+    NormalizedEnergyObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class EDPObjective:public ObjectiveFunction{
+class EDPObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    EDPObjective(std::string unitN):ObjectiveFunction(unitN){};
+    EDPObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class NormalizedEDPObjective:public ObjectiveFunction{
+class NormalizedEDPObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    NormalizedEDPObjective(std::string unitN):ObjectiveFunction(unitN){};
+    NormalizedEDPObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class CPUEnergyObjective:public ObjectiveFunction{
+class CPUEnergyObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    CPUEnergyObjective(std::string unitN):ObjectiveFunction(unitN){};
+    CPUEnergyObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class NormalizedCPUEnergyObjective:public ObjectiveFunction{
+class NormalizedCPUEnergyObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    NormalizedCPUEnergyObjective(std::string unitN):ObjectiveFunction(unitN){};
+    NormalizedCPUEnergyObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class TimeObjective:public ObjectiveFunction{
+class TimeObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    TimeObjective(std::string unitN):ObjectiveFunction(unitN){};
+    TimeObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class NormalizedTimeObjective:public ObjectiveFunction{
+class NormalizedTimeObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    NormalizedTimeObjective(std::string unitN):ObjectiveFunction(unitN){};
+    NormalizedTimeObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class TCOObjective:public ObjectiveFunction{
+class TCOObjective:public QuantityObjective{
     double costJoule, costCoreHour;
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
     TCOObjective(std::string unitN);
 };
 
-class NormalizedTCOObjective:public ObjectiveFunction{
+class NormalizedTCOObjective:public QuantityObjective{
     double costJoule, costCoreHour;
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
     NormalizedTCOObjective(std::string unitN);
 };
 
-class ED2PObjective:public ObjectiveFunction{
+class ED2PObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    ED2PObjective(std::string unitN):ObjectiveFunction(unitN){};
+    ED2PObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class NormalizedED2PObjective:public ObjectiveFunction{
+class NormalizedED2PObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    NormalizedED2PObjective(std::string unitN):ObjectiveFunction(unitN){};
+    NormalizedED2PObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class PTF_minObjective:public ObjectiveFunction{
+class PTF_minObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    PTF_minObjective(std::string unitN):ObjectiveFunction(unitN){};
+    PTF_minObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
-class PTF_maxObjective:public ObjectiveFunction{
+class PTF_maxObjective:public QuantityObjective{
 public:
-    double objective(int scenario_id, ScenarioResultsPool* properties);
-    double objective(std::list<MetaProperty>& props);
+    using QuantityObjective::objective;
+    double objective(const ObjectiveQuantities& quantities);
     std::string getName();
-    PTF_maxObjective(std::string unitN):ObjectiveFunction(unitN){};
+    PTF_maxObjective(std::string unitN):QuantityObjective(unitN){};
 };
 
 class Inverse_speedupObjective:public ObjectiveFunction{
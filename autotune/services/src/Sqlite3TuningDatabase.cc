@@ -1,7 +1,13 @@
 #include "Sqlite3TuningDatabase.h"
 
 #include "psc_errmsg.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <set>
+#include <sstream>
+#include <unistd.h>
 
 #ifdef PSC_SQLITE3_ENABLED
 
@@ -67,13 +73,30 @@ private:
  *
  * @param filename Location of the database file.
  */
-Sqlite3TuningDatabase::Sqlite3TuningDatabase( std::string filename ) : db( NULL ) {
-    if( sqlite3_open( "tuning.db", &db ) != SQLITE_OK ) {
+Sqlite3TuningDatabase::Sqlite3TuningDatabase( std::string filename ) : db( NULL ), nextBatch( 0 ) {
+    if( sqlite3_open( filename.c_str(), &db ) != SQLITE_OK ) {
         psc_errmsg( "cannot open database: %s\n", sqlite3_errmsg( db ) );
         throw sqlite3_error( "cannot open database" );
     }
+    sqlite3_busy_timeout( db, busyTimeout );
 
-    static const char schema[] =
+    const char* run = getenv( "PSC_TUNING_RUN_ID" );
+    if( run != NULL && *run != '\0' ) {
+        runId = run;
+    }
+    else {
+        char host[ 256 ] = "";
+        gethostname( host, sizeof( host ) - 1 );
+        std::ostringstream unique;
+        unique << host << ":" << getpid() << ":" << time( NULL );
+        runId = unique.str();
+    }
+
+    static const char journal[] =
+        "PRAGMA journal_mode = WAL;\n"
+        "PRAGMA synchronous = NORMAL;\n";
+
+    static const char tables[] =
         "CREATE TABLE IF NOT EXISTS benchmarks (\n"
         "    id INTEGER PRIMARY KEY,\n"
         "    text TEXT UNIQUE\n"
@@ -101,13 +124,34 @@ Sqlite3TuningDatabase::Sqlite3TuningDatabase( std::string filename ) : db( NULL
         "    FOREIGN KEY(mid) REFERENCES measurements(id),\n"
         "    UNIQUE(mid, plugintype, name)\n"
         ");\n"
+
+        "CREATE TABLE IF NOT EXISTS runs (\n"
+        "    run TEXT NOT NULL,\n"
+        "    batch INTEGER NOT NULL,\n"
+        "    PRIMARY KEY(run, batch)\n"
+        ");\n"
     ;
 
-    char* errmsg;
-    if( sqlite3_exec( db, schema, NULL, NULL, &errmsg ) != SQLITE_OK ) {
-        psc_errmsg( "fail to create schema: %s\n", errmsg );
+    // the rollback journal is safe on network file systems, write-ahead logging is not
+    std::string schema = tables;
+    const char* wal    = getenv( "PSC_TUNING_DB_WAL" );
+    if( wal != NULL && *wal != '\0' && strcmp( wal, "0" ) != 0 ) {
+        schema = journal + schema;
+    }
+
+    // every job opening a new database races to create the schema
+    for( int attempt = 0;; attempt++ ) {
+        char* errmsg;
+        if( sqlite3_exec( db, schema.c_str(), NULL, NULL, &errmsg ) == SQLITE_OK ) {
+            break;
+        }
+        if( !isBusy() || attempt + 1 >= maxRetries ) {
+            psc_errmsg( "fail to create schema: %s\n", errmsg );
+            sqlite3_free( errmsg );
+            throw sqlite3_error( "fail to create schema" );
+        }
         sqlite3_free( errmsg );
-        throw sqlite3_error( "fail to create schema" );
+        backoff( attempt );
     }
 }
 
@@ -190,54 +234,148 @@ Iterator<TuningCase>* Sqlite3TuningDatabase::queryCases( int id ) {
 
 void Sqlite3TuningDatabase::saveSignature( ProgramID const&        id,
                                            ProgramSignature const& signature ) {
-    disableAutocommit();
-
-    int bid = queryIdByText( id );
-    for( ProgramSignature::const_iterator it = signature.begin(); it != signature.end(); ++it ) {
-        std::string key   = *it;
-        INT64       value = signature.rawAt( key );
-        insertCountersEntry( bid, key, value );
-    }
+    pendingSignatures.push_back( std::make_pair( id, signature ) );
 }
 
 void Sqlite3TuningDatabase::saveTuningCase( ProgramID const&  id,
                                             TuningCase const& tc ) {
-    disableAutocommit();
-
-    TuningConfiguration const& configuration = tc.first;
-    double                     execTime      = tc.second;
-
-    int bid = queryIdByText( id );
-    int mid = insertMeasurementEntry( bid, execTime );
+    pendingCases.push_back( std::make_pair( id, tc ) );
+}
 
-    for( TuningConfiguration::const_iterator it = configuration.begin(); it != configuration.end(); ++it ) {
-        insertTuningValueEntry( mid, *it );
+/**
+ * Writes the data saved since the last commit: the signatures in one batch, then the tuning cases
+ * in batches of batchSize. The batches are numbered in the order they are written by this run.
+ */
+void Sqlite3TuningDatabase::commit() {
+    if( !pendingSignatures.empty() ) {
+        commitBatch( nextBatch++, true, 0, 0 );
     }
+    for( size_t first = 0; first < pendingCases.size(); first += batchSize ) {
+        commitBatch( nextBatch++, false, first, std::min( first + batchSize, pendingCases.size() ) );
+    }
+    pendingSignatures.clear();
+    pendingCases.clear();
 }
 
-void Sqlite3TuningDatabase::commit() {
-    char* errmsg;
-    if( !sqlite3_get_autocommit( db ) ) {
-        if( sqlite3_exec( db, "COMMIT;", NULL, NULL, &errmsg ) != SQLITE_OK ) {
-            throw sqlite3_error( errmsg );
+
+/**
+ * Writes one batch, retrying with backoff while other jobs keep the database busy.
+ */
+void Sqlite3TuningDatabase::commitBatch( int    batch,
+                                         bool   signatures,
+                                         size_t first,
+                                         size_t last ) {
+    for( int attempt = 0;; attempt++ ) {
+        try {
+            if( !writeBatch( batch, signatures, first, last ) ) {
+                psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ),
+                            "Sqlite3TuningDatabase: batch %d of run %s was committed before\n", batch, runId.c_str() );
+            }
+            return;
         }
+        catch( sqlite3_error& ) {
+            bool busy = isBusy();
+            if( !sqlite3_get_autocommit( db ) ) {
+                sqlite3_exec( db, "ROLLBACK;", NULL, NULL, NULL );
+            }
+            if( !busy || attempt + 1 >= maxRetries ) {
+                throw;
+            }
+        }
+        backoff( attempt );
     }
 }
 
-
 /**
- * Starts a transaction, unless one has already been started.
+ * Writes one batch in its own transaction, unless the run has committed it before.
  *
- * This is used by saveSignature() and saveTuningCase() to make sure
- * that all gathered training data is saved atomically, when calling commit().
+ * @return false if the batch was already stored
  */
-void Sqlite3TuningDatabase::disableAutocommit() {
-    char* errmsg;
-    if( sqlite3_get_autocommit( db ) ) {
-        if( sqlite3_exec( db, "BEGIN;", NULL, NULL, &errmsg ) != SQLITE_OK ) {
-            throw sqlite3_error( errmsg );
+bool Sqlite3TuningDatabase::writeBatch( int    batch,
+                                        bool   signatures,
+                                        size_t first,
+                                        size_t last ) {
+    // take the write lock up front, so that the transaction cannot fail halfway on a busy database
+    execute( "BEGIN IMMEDIATE;" );
+
+    static const char zSql[] =
+        "INSERT OR IGNORE INTO runs(run, batch) "
+        "VALUES (?, ?);";
+
+    sqlite3_stmt* pStmt = NULL;
+    int           rc    = sqlite3_prepare_v2( db, zSql, -1, &pStmt, NULL );
+
+    boost::shared_ptr<sqlite3_stmt> statement( pStmt, &sqlite3_finalize );
+    if( rc != SQLITE_OK ) {
+        throw sqlite3_error( sqlite3_errmsg( db ) );
+    }
+    if( sqlite3_bind_text( statement.get(), 1, runId.c_str(), runId.length(), SQLITE_TRANSIENT ) != SQLITE_OK ) {
+        throw sqlite3_error( sqlite3_errmsg( db ) );
+    }
+    if( sqlite3_bind_int( statement.get(), 2, batch ) != SQLITE_OK ) {
+        throw sqlite3_error( sqlite3_errmsg( db ) );
+    }
+    if( sqlite3_step( statement.get() ) != SQLITE_DONE ) {
+        throw sqlite3_error( sqlite3_errmsg( db ) );
+    }
+    if( sqlite3_changes( db ) == 0 ) {
+        execute( "ROLLBACK;" );
+        return false;
+    }
+
+    if( signatures ) {
+        for( size_t i = 0; i < pendingSignatures.size(); i++ ) {
+            ProgramSignature const& signature = pendingSignatures[ i ].second;
+
+            int bid = queryIdByText( pendingSignatures[ i ].first );
+            for( ProgramSignature::const_iterator it = signature.begin(); it != signature.end(); ++it ) {
+                std::string key   = *it;
+                INT64       value = signature.rawAt( key );
+                insertCountersEntry( bid, key, value );
+            }
+        }
+    }
+    for( size_t i = first; i < last; i++ ) {
+        TuningConfiguration const& configuration = pendingCases[ i ].second.first;
+        double                     execTime      = pendingCases[ i ].second.second;
+
+        int bid = queryIdByText( pendingCases[ i ].first );
+        int mid = insertMeasurementEntry( bid, execTime );
+
+        for( TuningConfiguration::const_iterator it = configuration.begin(); it != configuration.end(); ++it ) {
+            insertTuningValueEntry( mid, *it );
         }
     }
+
+    execute( "COMMIT;" );
+    return true;
+}
+
+void Sqlite3TuningDatabase::execute( const char* sql ) {
+    char* errmsg;
+    if( sqlite3_exec( db, sql, NULL, NULL, &errmsg ) != SQLITE_OK ) {
+        std::string message( errmsg );
+        sqlite3_free( errmsg );
+        throw sqlite3_error( message );
+    }
+}
+
+/**
+ * Whether the last error was another connection holding the lock, as opposed to a real failure.
+ */
+bool Sqlite3TuningDatabase::isBusy() const {
+    int rc = sqlite3_extended_errcode( db ) & 0xff;
+    return rc == SQLITE_BUSY || rc == SQLITE_LOCKED;
+}
+
+/**
+ * Sleeps before the next attempt: exponentially longer up to about a second, randomized so that
+ * the jobs that collided do not collide again.
+ */
+void Sqlite3TuningDatabase::backoff( int attempt ) {
+    static unsigned int seed = getpid();
+    useconds_t          base = 10000 << std::min( attempt, 7 );
+    usleep( base + rand_r( &seed ) % base );
 }
 
 /**
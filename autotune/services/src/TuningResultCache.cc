@@ -0,0 +1,272 @@
+#include "TuningResultCache.h"
+#include "TuningParameter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#include <boost/property_tree/json_parser.hpp>
+
+using boost::property_tree::ptree;
+
+
+const double TuningResultCache::defaultTolerance = 0.05;
+
+
+static bool lessObjective( CachedConfiguration const& c1,
+                           CachedConfiguration const& c2 ) {
+    return c1.objective < c2.objective;
+}
+
+
+TuningResultCache::TuningResultCache( std::string filename_,
+                                      double      tolerance_,
+                                      size_t      capacity_ )
+    : filename( filename_ ), tolerance( tolerance_ ), capacity( capacity_ ) {
+}
+
+std::string TuningResultCache::fileFor( std::string const& application ) {
+    const char* dir = getenv( "PSC_TUNING_CACHE_DIR" );
+
+    std::string name = application;
+    std::replace( name.begin(), name.end(), '/', '_' );
+
+    std::string path = dir != NULL && *dir != '\0' ? std::string( dir ) + "/" : std::string();
+    return path + name + ".tuning_cache.json";
+}
+
+std::string TuningResultCache::inputKey( std::unordered_map<std::string, std::string> const& identifiers ) {
+    std::map<std::string, std::string> sorted( identifiers.begin(), identifiers.end() );
+    std::ostringstream                 key;
+    for( std::map<std::string, std::string>::const_iterator it = sorted.begin(); it != sorted.end(); ++it ) {
+        key << ( it == sorted.begin() ? "" : ";" ) << it->first << "=" << it->second;
+    }
+    return key.str();
+}
+
+
+bool TuningResultCache::read( std::string const& filename,
+                              Entries&           entries ) {
+    std::ifstream in( filename.c_str() );
+    if( !in ) {
+        return false;
+    }
+
+    try {
+        ptree root;
+        boost::property_tree::read_json( in, root );
+        for( ptree::const_iterator it = root.get_child( "entries" ).begin(); it != root.get_child( "entries" ).end(); ++it ) {
+            ptree const&                      entry = it->second;
+            std::vector<CachedConfiguration>& list  = entries[ Key( entry.get<std::string>( "callpath" ),
+                                                                    entry.get<std::string>( "input" ) ) ];
+            for( ptree::const_iterator c = entry.get_child( "configurations" ).begin(); c != entry.get_child( "configurations" ).end(); ++c ) {
+                CachedConfiguration configuration;
+                configuration.objective = c->second.get<double>( "objective" );
+                for( ptree::const_iterator v = c->second.get_child( "values" ).begin(); v != c->second.get_child( "values" ).end(); ++v ) {
+                    configuration.values[ v->first ] = v->second.get_value<int>();
+                }
+                list.push_back( configuration );
+            }
+            std::sort( list.begin(), list.end(), lessObjective );
+        }
+    }
+    catch( std::exception& ) {
+        entries.clear();
+        return false;
+    }
+    return true;
+}
+
+bool TuningResultCache::load() {
+    entries.clear();
+    return read( filename, entries );
+}
+
+bool TuningResultCache::save() {
+    // the lock file outlives the cache file, which rename() replaces
+    std::string lockname = filename + ".lock";
+    int         lock     = open( lockname.c_str(), O_RDWR | O_CREAT, 0644 );
+    if( lock < 0 || flock( lock, LOCK_EX ) != 0 ) {
+        if( lock >= 0 ) {
+            close( lock );
+        }
+        return false;
+    }
+
+    // configurations another run saved since load(); those measured by this run keep their objective
+    Entries saved;
+    read( filename, saved );
+    for( Entries::const_iterator it = saved.begin(); it != saved.end(); ++it ) {
+        std::vector<CachedConfiguration>& list = entries[ it->first ];
+        size_t                            own  = list.size();
+        for( size_t i = 0; i < it->second.size(); i++ ) {
+            size_t k = 0;
+            while( k < own && list[ k ].values != it->second[ i ].values ) {
+                k++;
+            }
+            if( k == own ) {
+                list.push_back( it->second[ i ] );
+            }
+        }
+        prune( list );
+    }
+
+    bool written = write();
+    close( lock );
+    return written;
+}
+
+bool TuningResultCache::write() const {
+    ptree list;
+    for( Entries::const_iterator it = entries.begin(); it != entries.end(); ++it ) {
+        ptree entry, configurations;
+        entry.put( "callpath", it->first.first );
+        entry.put( "input", it->first.second );
+        for( size_t i = 0; i < it->second.size(); i++ ) {
+            ptree configuration, values;
+            configuration.put( "objective", it->second[ i ].objective );
+            for( std::map<std::string, int>::const_iterator v = it->second[ i ].values.begin(); v != it->second[ i ].values.end(); ++v ) {
+                values.put( ptree::path_type( v->first, '\0' ), v->second );
+            }
+            configuration.add_child( "values", values );
+            configurations.push_back( std::make_pair( "", configuration ) );
+        }
+        entry.add_child( "configurations", configurations );
+        list.push_back( std::make_pair( "", entry ) );
+    }
+    ptree root;
+    root.put( "version", 1 );
+    root.add_child( "entries", list );
+
+    // concurrent runs of the application must never read a partially written file
+    std::ostringstream temporary;
+    temporary << filename << ".tmp." << getpid();
+    try {
+        std::ofstream out( temporary.str().c_str() );
+        boost::property_tree::write_json( out, root );
+        out.close();
+        if( !out ) {
+            remove( temporary.str().c_str() );
+            return false;
+        }
+    }
+    catch( std::exception& ) {
+        remove( temporary.str().c_str() );
+        return false;
+    }
+    return rename( temporary.str().c_str(), filename.c_str() ) == 0;
+}
+
+
+void TuningResultCache::record( std::string const&                callpath,
+                                std::string const&                input,
+                                std::map<std::string, int> const& values,
+                                double                            objective ) {
+    std::vector<CachedConfiguration>& list = entries[ Key( callpath, input ) ];
+
+    std::vector<CachedConfiguration>::iterator it = list.begin();
+    while( it != list.end() && it->values != values ) {
+        ++it;
+    }
+    if( it == list.end() ) {
+        CachedConfiguration configuration;
+        configuration.values = values;
+        list.push_back( configuration );
+        it = list.end() - 1;
+    }
+    it->objective = objective;
+    prune( list );
+}
+
+void TuningResultCache::prune( std::vector<CachedConfiguration>& list ) const {
+    std::sort( list.begin(), list.end(), lessObjective );
+
+    // keep the best and those within the tolerance, which also holds for negative objectives
+    double limit = list.front().objective + tolerance * std::fabs( list.front().objective );
+    size_t keep  = 1;
+    while( keep < list.size() && keep < capacity && list[ keep ].objective <= limit ) {
+        keep++;
+    }
+    list.resize( keep );
+}
+
+std::vector<CachedConfiguration> const* TuningResultCache::lookup( std::string const& callpath,
+                                                                   std::string const& input ) const {
+    Entries::const_iterator it = entries.find( Key( callpath, input ) );
+    return it == entries.end() ? NULL : &it->second;
+}
+
+std::vector<int> TuningResultCache::candidates( std::string const& callpath,
+                                                std::string const& input,
+                                                std::string const& name,
+                                                int                from,
+                                                int                to,
+                                                int                step,
+                                                int                neighbours ) const {
+    std::vector<int>                        result;
+    std::vector<CachedConfiguration> const* list = lookup( callpath, input );
+    if( list == NULL || step <= 0 ) {
+        return result;
+    }
+
+    std::vector<int> cached;
+    for( size_t i = 0; i < list->size(); i++ ) {
+        std::map<std::string, int>::const_iterator v = ( *list )[ i ].values.find( name );
+        // a value off the current range was tuned on another range and says nothing about this one
+        if( v != ( *list )[ i ].values.end() && v->second >= from && v->second <= to && ( v->second - from ) % step == 0 &&
+            std::find( cached.begin(), cached.end(), v->second ) == cached.end() ) {
+            cached.push_back( v->second );
+        }
+    }
+
+    result = cached;
+    for( int distance = 1; distance <= neighbours; distance++ ) {
+        for( size_t i = 0; i < cached.size(); i++ ) {
+            int around[] = { cached[ i ] - distance * step, cached[ i ] + distance * step };
+            for( int k = 0; k < 2; k++ ) {
+                if( around[ k ] >= from && around[ k ] <= to && std::find( result.begin(), result.end(), around[ k ] ) == result.end() ) {
+                    result.push_back( around[ k ] );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+bool TuningResultCache::warmStart( std::string const&                   callpath,
+                                   std::string const&                   input,
+                                   std::vector<TuningParameter*> const& parameters,
+                                   int                                  neighbours ) const {
+    if( lookup( callpath, input ) == NULL ) {
+        return false;
+    }
+
+    for( size_t i = 0; i < parameters.size(); i++ ) {
+        TuningParameter* tp     = parameters[ i ];
+        std::vector<int> values = candidates( callpath, input, tp->getName(), tp->getRangeFrom(), tp->getRangeTo(),
+                                              tp->getRangeStep(), neighbours );
+        if( values.empty() ) {
+            continue;
+        }
+
+        // the parameter does not own its restriction, an existing one is refilled instead of replaced
+        Restriction* r = tp->getRestriction();
+        if( r == NULL ) {
+            r = new Restriction();
+            tp->setRestriction( r );
+        }
+        r->clearElements();
+        r->setType( 2 );
+        for( size_t k = 0; k < values.size(); k++ ) {
+            r->addElement( values[ k ] );
+        }
+        tp->setRange( *std::min_element( values.begin(), values.end() ), *std::max_element( values.begin(), values.end() ),
+                      tp->getRangeStep() );
+    }
+    return true;
+}
@@ -20,6 +20,8 @@
 #include "search_common.h"
 #include "ISearchAlgorithm.h"
 
+#include <algorithm>
+
 #include <boost/foreach.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
@@ -28,455 +30,241 @@
 
 
 
-//****Energy****
-
-std::string EnergyObjective::getName() {
-    return "Energy";
-}
+//****Objective quantities****
 
-double EnergyObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
+static void report_missing(int count, const char* quantity) {
+    if (count > 0) {
+        psc_errmsg("%s not found\n", quantity);
+    }
 }
 
 
-double EnergyObjective::objective(std::list<MetaProperty>& properties) {
-    double energy = 0;
+ObjectiveQuantities extract_objective_quantities(std::list<MetaProperty>& properties) {
+    ObjectiveQuantities quantities;
+    double totInstr = 0.0;
 
-    fflush (stdout);
-    for( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS) {
-            energy += property.getSeverity();
+    for( auto& property : properties ) {
+        double severity = property.getSeverity();
+        if (quantities.properties == 0 || severity < quantities.minSeverity) {
+            quantities.minSeverity = severity;
         }
-        if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType addInfo = property.getExtraInfo();
-            addInfoType::iterator iter = addInfo.find("NodeEnergy");
-            if (iter != property.getExtraInfo().end()) {
-                energy += std::stod(iter->second);
-            } else {
-                psc_errmsg("NodeEnergy not found\n");
-            }
+        if (quantities.properties == 0 || severity > quantities.maxSeverity) {
+            quantities.maxSeverity = severity;
         }
-    }
-
-    //psc_dbgmsg(6, "Energy: %f;\n", energy);
-
-    return energy;
-}
-
+        quantities.properties++;
 
-//****NormalizedEnergy****
-
-std::string NormalizedEnergyObjective::getName() {
-    return "NormalizedEnergy";
-}
+        int id = std::stoi(property.getId());
+        if (id != ENERGY_CONSUMPTION && id != INTERPHASE_PROPS && id != EXECTIMEIMPORTANCE) {
+            continue;
+        }
+        addInfoType addInfo = property.getExtraInfo();
 
-double NormalizedEnergyObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
-}
+        addInfoType::iterator it = addInfo.find("TotalInstr");
+        if (it != addInfo.end()) {
+            totInstr = std::stod(it->second);
+        } else {
+            quantities.missingTotalInstr++;
+        }
 
+        // node energy is the severity, except for EXECTIMEIMPORTANCE which carries it as NodeEnergy
+        if (id == EXECTIMEIMPORTANCE) {
+            it = addInfo.find("NodeEnergy");
+            if (it != addInfo.end()) {
+                double energy = std::stod(it->second);
+                quantities.energy           += energy;
+                quantities.normalizedEnergy += energy/totInstr;
+            } else {
+                quantities.missingNodeEnergy++;
+            }
+        } else {
+            quantities.energy           += severity;
+            quantities.normalizedEnergy += severity/totInstr;
+        }
 
-double NormalizedEnergyObjective::objective(std::list<MetaProperty>& properties) {
-    double energy =0, totInstr = 0.0;
+        it = addInfo.find("CPUEnergy");
+        if (it != addInfo.end()) {
+            double cpuEnergy = std::stod(it->second);
+            quantities.cpuEnergy           += (INT64)cpuEnergy;
+            quantities.normalizedCPUEnergy += cpuEnergy/totInstr;
+        } else {
+            quantities.missingCPUEnergy++;
+        }
 
-    fflush (stdout);
-    for( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
-            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType::iterator iter;
-            addInfoType addInfo = property.getExtraInfo();
-            iter = addInfo.find("TotalInstr");
-            if (iter != property.getExtraInfo().end()) {
-                 totInstr = std::stod(iter->second);
+        // EXECTIMEIMPORTANCE reports the time in nanoseconds as cycles
+        it = addInfo.find(id == EXECTIMEIMPORTANCE ? "cycles" : "ExecTime");
+        if (it != addInfo.end()) {
+            double raw     = std::stod(it->second);
+            double seconds = id == EXECTIMEIMPORTANCE ? raw/NANOSEC_PER_SEC_DOUBLE : raw;
+            // the Time objective compares the unconverted value
+            if (quantities.time < raw) {
+                quantities.time = seconds;
             }
-            else {
-                psc_errmsg("TotalInstr not found\n");
+            if (quantities.maxTime < seconds) {
+                quantities.maxTime = seconds;
             }
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                addInfoType::iterator iter = addInfo.find("NodeEnergy");
-                if (iter != property.getExtraInfo().end()) {
-                    energy += std::stod(iter->second)/totInstr;
-                } else {
-                    psc_errmsg("NodeEnergy not found\n");
-                }
+            double normalized = id == EXECTIMEIMPORTANCE ? raw/totInstr/NANOSEC_PER_SEC_DOUBLE : raw/totInstr;
+            if (quantities.normalizedMaxTime < normalized) {
+                quantities.normalizedMaxTime = normalized;
             }
-            else {
-                energy += property.getSeverity()/totInstr;
+            if (totInstr != 0.0 && quantities.normalizedTime < normalized) {
+                quantities.normalizedTime = normalized;
             }
+        } else {
+            quantities.missingExecTime++;
+        }
+        if (it == addInfo.end() || totInstr == 0.0) {
+            quantities.missingNormalizedTime++;
         }
     }
 
-//    psc_dbgmsg(6, "NormalizedEnergy: %f;\n", energy);
-    return energy;
+    return quantities;
 }
 
 
-
-
-
-//****CPUEnergy****
-
-std::string CPUEnergyObjective::getName() {
-    return "CPUEnergy";
-}
-
-double CPUEnergyObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
+ObjectiveQuantities objective_quantities(int scenario_id, ScenarioResultsPool* srp) {
+    ObjectiveQuantities quantities;
+    if (!srp->getObjectiveQuantities(scenario_id, quantities)) {
+        std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
+        quantities = extract_objective_quantities(properties);
+        srp->setObjectiveQuantities(scenario_id, quantities);
+    }
+    return quantities;
 }
 
 
-double CPUEnergyObjective::objective(std::list<MetaProperty>& properties) {
-    double energy = 0.0;
+std::vector<double> evaluate_objectives(int scenario_id, ScenarioResultsPool* srp,
+                                        const std::vector<ObjectiveFunction*>& objectives) {
+    std::vector<double> values;
+    ObjectiveQuantities quantities;
+    bool                extracted = false;
 
-    for( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
-            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType addInfo = property.getExtraInfo();
-            //for (const auto& info : addInfo ) {
-            //  printf("Iterator->first %s  ->second %s\n",info.first.c_str(), info.second.c_str());fflush(stdout);
-            //}
-            addInfoType::iterator it = addInfo.find("CPUEnergy");
-            if (it != property.getExtraInfo().end()) {
-                std::string cpuString = it->second;
-                INT64 cpuEnergy = std::stod(cpuString);
-                energy += cpuEnergy;
-            } else {
-                psc_errmsg("CPUEnergy not found\n");
+    for( auto objective : objectives ) {
+        QuantityObjective* quantityObjective = dynamic_cast<QuantityObjective*>(objective);
+        if (quantityObjective) {
+            if (!extracted) {
+                quantities = objective_quantities(scenario_id, srp);
+                extracted  = true;
             }
+            values.push_back(quantityObjective->objective(quantities));
+        } else {
+            values.push_back(objective->objective(scenario_id, srp));
         }
     }
+    return values;
+}
 
-    //psc_dbgmsg(6, "CPU Energy: %f;\n", energy);
 
-    return energy;
+double QuantityObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
+    return objective(objective_quantities(scenario_id, srp));
 }
 
 
-//****NormalizedCPUEnergy****
-
-std::string NormalizedCPUEnergyObjective::getName() {
-    return "NormalizedCPUEnergy";
+double QuantityObjective::objective(std::list<MetaProperty>& properties) {
+    return objective(extract_objective_quantities(properties));
 }
 
-double NormalizedCPUEnergyObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
+
+//****Energy****
+
+std::string EnergyObjective::getName() {
+    return "Energy";
 }
 
+double EnergyObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingNodeEnergy, "NodeEnergy");
+    return quantities.energy;
+}
 
-double NormalizedCPUEnergyObjective::objective(std::list<MetaProperty>& properties) {
-    double energy =0, totInstr = 0.0;
 
-    fflush (stdout);
-    for( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
-            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType::iterator it;
-            addInfoType addInfo = property.getExtraInfo();
-            it = addInfo.find("TotalInstr");
-            if (it != property.getExtraInfo().end()) {
-                totInstr = std::stod(it->second);
-            }
-            else {
-                psc_errmsg("TotalInstr not found\n");
-            }
-            it = addInfo.find("CPUEnergy");
-            if (it != property.getExtraInfo().end()) {
-                energy += std::stod(it->second)/totInstr;
-            } else {
-                psc_errmsg("CPUEnergy not found\n");
-            }
+//****NormalizedEnergy****
 
-        }
-//      if (std::stoi(property.getId()) == INTERPHASE_PROPS) {
-//            totInstr += property.getSeverity();
-//        }
-    }
-//    psc_dbgmsg(6, "NormalizedCPUEnergy: %f;\n", energy);
-    return energy;
+std::string NormalizedEnergyObjective::getName() {
+    return "NormalizedEnergy";
 }
 
+double NormalizedEnergyObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingTotalInstr, "TotalInstr");
+    report_missing(quantities.missingNodeEnergy, "NodeEnergy");
+    return quantities.normalizedEnergy;
+}
 
 
-//****EDP****
-
+//****CPUEnergy****
 
-std::string EDPObjective::getName() {
-    return "EDP";
+std::string CPUEnergyObjective::getName() {
+    return "CPUEnergy";
 }
 
-double EDPObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
+double CPUEnergyObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingCPUEnergy, "CPUEnergy");
+    return quantities.cpuEnergy;
 }
 
 
-double EDPObjective::objective(std::list<MetaProperty>& properties) {
-    double energy = 0;
-    double time = -1.0;
+//****NormalizedCPUEnergy****
 
-    for( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
-            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType::iterator it;
-            addInfoType addInfo = property.getExtraInfo();
+std::string NormalizedCPUEnergyObjective::getName() {
+    return "NormalizedCPUEnergy";
+}
 
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                addInfoType::iterator iter = addInfo.find("NodeEnergy");
-                if (iter != property.getExtraInfo().end()) {
-                    energy += std::stod(iter->second);
-                } else {
-                    psc_errmsg("NodeEnergy not found\n");
-                }
-            }
-            else {
-                energy += property.getSeverity();
-            }
+double NormalizedCPUEnergyObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingTotalInstr, "TotalInstr");
+    report_missing(quantities.missingCPUEnergy, "CPUEnergy");
+    return quantities.normalizedCPUEnergy;
+}
 
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                it = addInfo.find("cycles");
-            } else {
-                it = addInfo.find("ExecTime");
-            }
 
-            if (it != property.getExtraInfo().end()) {
-                double time1(0.0);
-                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                    time1 = std::stod(it->second)/NANOSEC_PER_SEC_DOUBLE;
-                } else {
-                    time1 = std::stod(it->second);
-                }
-                if (time < time1) {
-                    time = time1;
-                }
-            } else {
-                psc_errmsg("ExecTime not found\n");
-            }
-        }
-    }
+//****EDP****
 
-    //psc_dbgmsg(6, "EDP: %f;\n", energy * time);
+std::string EDPObjective::getName() {
+    return "EDP";
+}
 
-    return energy * time;
+double EDPObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingNodeEnergy, "NodeEnergy");
+    report_missing(quantities.missingExecTime, "ExecTime");
+    return quantities.energy * quantities.maxTime;
 }
 
 
 //****NormalizedEDP****
 
-
 std::string NormalizedEDPObjective::getName() {
     return "NormalizedEDP";
 }
 
-double NormalizedEDPObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
-}
-
-
-double NormalizedEDPObjective::objective(std::list<MetaProperty>& properties) {
-    double energy = 0;
-    double time = -1.0;
-    double totInstr = 0.0;
-
-    for( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
-            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType::iterator it;
-            addInfoType addInfo = property.getExtraInfo();
-            it = addInfo.find("TotalInstr");
-            if (it != property.getExtraInfo().end()) {
-                totInstr = std::stod(it->second);
-            }
-            else {
-                psc_errmsg("TotalInstr not found\n");
-            }
-
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                it = addInfo.find("cycles");
-            } else {
-                it = addInfo.find("ExecTime");
-            }
-
-            if (it != property.getExtraInfo().end()) {
-                double time1(0.0);
-                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                    time1 = std::stod(it->second)/totInstr/NANOSEC_PER_SEC_DOUBLE;
-                } else {
-                    time1 = std::stod(it->second)/totInstr;
-                }
-                if (time < time1) {
-                    time = time1;
-                }
-            } else {
-                psc_errmsg("ExecTime not found\n");
-            }
-
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                addInfoType::iterator iter = addInfo.find("NodeEnergy");
-                if (iter != property.getExtraInfo().end()) {
-                    energy += std::stod(iter->second)/totInstr;
-                } else {
-                    psc_errmsg("NodeEnergy not found\n");
-                }
-            }
-            else {
-                energy += property.getSeverity()/totInstr;
-            }
-        }
-//        if (std::stoi(property.getId()) == INTERPHASE_PROPS) {
-//            totInstr += property.getSeverity();
-//        }
-    }
-
-    //psc_dbgmsg(6, "Normalized EDP: %1.13f;\n", energy * time);
-
-    return energy * time;
+double NormalizedEDPObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingTotalInstr, "TotalInstr");
+    report_missing(quantities.missingExecTime, "ExecTime");
+    report_missing(quantities.missingNodeEnergy, "NodeEnergy");
+    return quantities.normalizedEnergy * quantities.normalizedMaxTime;
 }
 
 
 //****ED2P****
 
-
 std::string ED2PObjective::getName() {
     return "ED2P";
 }
 
-double ED2PObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
-}
-
-
-double ED2PObjective::objective(std::list<MetaProperty>& properties) {
-    double energy = 0;
-    double time = -1.0;
-
-    for ( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
-            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType::iterator it;
-            addInfoType addInfo = property.getExtraInfo();
-
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                addInfoType::iterator iter = addInfo.find("NodeEnergy");
-                if (iter != property.getExtraInfo().end()) {
-                    energy += std::stod(iter->second);
-                } else {
-                    psc_errmsg("NodeEnergy not found\n");
-                }
-            }
-            else {
-                energy += property.getSeverity();
-            }
-
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                it = addInfo.find("cycles");
-            } else {
-                it = addInfo.find("ExecTime");
-            }
-
-            if (it != property.getExtraInfo().end()) {
-                double time1(0.0);
-                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                    time1 = std::stod(it->second)/NANOSEC_PER_SEC_DOUBLE;
-                } else {
-                    time1 = std::stod(it->second);
-                }
-                if (time < time1) {
-                    time = time1;
-                }
-            } else {
-                psc_errmsg("ExecTime not found\n");
-            }
-        }
-    }
-
-    //psc_dbgmsg(6, "ED2P: %f;\n", energy * time * time);
-
-    return energy * time * time;
+double ED2PObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingNodeEnergy, "NodeEnergy");
+    report_missing(quantities.missingExecTime, "ExecTime");
+    return quantities.energy * quantities.maxTime * quantities.maxTime;
 }
 
 
 //****NormalizedED2P****
 
-
 std::string NormalizedED2PObjective::getName() {
     return "NormalizedED2P";
 }
 
-double NormalizedED2PObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
-}
-
-
-double NormalizedED2PObjective::objective(std::list<MetaProperty>& properties) {
-    double energy = 0;
-    double time = -1.0;
-    double totInstr = 0.0;
-
-    for ( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
-            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType::iterator it;
-            addInfoType addInfo = property.getExtraInfo();
-            it = addInfo.find("TotalInstr");
-            if (it != property.getExtraInfo().end()) {
-                totInstr = std::stod(it->second);
-            }  else {
-                psc_errmsg("TotalInstr not found\n");
-            }
-
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                it = addInfo.find("cycles");
-            } else {
-                it = addInfo.find("ExecTime");
-            }
-
-            if (it != property.getExtraInfo().end()) {
-                double time1(0.0);
-                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                    time1 = std::stod(it->second)/totInstr/NANOSEC_PER_SEC_DOUBLE;
-                } else {
-                    time1 = std::stod(it->second)/totInstr;
-                }
-                if (time < time1) {
-                    time = time1;
-                }
-            } else {
-                psc_errmsg("ExecTime not found\n");
-            }
-
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                addInfoType::iterator iter = addInfo.find("NodeEnergy");
-                if (iter != property.getExtraInfo().end()) {
-                    energy += std::stod(iter->second)/totInstr;
-                } else {
-                    psc_errmsg("NodeEnergy not found\n");
-                }
-            } else {
-                energy += property.getSeverity()/totInstr;
-            }
-        }
-//        if (std::stoi(property.getId()) == INTERPHASE_PROPS) {
-//            totInstr += property.getSeverity();
-//        }
-    }
-
-    //psc_dbgmsg(6, "Normalized ED2P: %1.13f;\n", energy * time * time);
-
-    return energy * time * time;
+double NormalizedED2PObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingTotalInstr, "TotalInstr");
+    report_missing(quantities.missingExecTime, "ExecTime");
+    report_missing(quantities.missingNodeEnergy, "NodeEnergy");
+    return quantities.normalizedEnergy * quantities.normalizedMaxTime * quantities.normalizedMaxTime;
 }
 
 
@@ -486,45 +274,9 @@ std::string TimeObjective::getName() {
     return "Time";
 }
 
-double TimeObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
-}
-
-
-double TimeObjective::objective(std::list<MetaProperty>& properties) {
-    double time = 0;
-
-    for ( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
-            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType::iterator it;
-            addInfoType addInfo = property.getExtraInfo();
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                it = addInfo.find("cycles");
-            }
-            else {
-                it = addInfo.find("ExecTime");
-            }
-            if (it != property.getExtraInfo().end()) {
-                std::string timeString = it->second;
-                if (time < std::stod(timeString)) {
-                    if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                        time = std::stod(timeString) / NANOSEC_PER_SEC_DOUBLE;
-                    }
-                    else
-                        time = std::stod(timeString);
-                }
-            } else {
-                psc_errmsg("ExecTime not found\n");
-            }
-        }
-    }
-
-    //psc_dbgmsg(6, "Time: %f;\n", time);
-
-    return time;
+double TimeObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingExecTime, "ExecTime");
+    return quantities.time;
 }
 
 
@@ -534,65 +286,18 @@ std::string NormalizedTimeObjective::getName() {
     return "NormalizedTime";
 }
 
-double NormalizedTimeObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
-}
-
-
-double NormalizedTimeObjective::objective(std::list<MetaProperty>& properties) {
-    double time = 0.0;
-    double totInstr = 0.0;
-
-    for ( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
-            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType::iterator it;
-            addInfoType addInfo = property.getExtraInfo();
-            it = addInfo.find("TotalInstr");
-            if (it != property.getExtraInfo().end()) {
-                totInstr = std::stod(it->second);
-            }
-            else {
-                psc_errmsg("TotalInstr not found\n");
-            }
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                it = addInfo.find("cycles");
-            }
-            else {
-                it = addInfo.find("ExecTime");
-            }
-            if (it != property.getExtraInfo().end() && totInstr != 0.0) {
-                double time1(0.0);
-                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                    time1 = std::stod(it->second)/totInstr/ NANOSEC_PER_SEC_DOUBLE;
-                }
-                else {
-                    time1 = std::stod(it->second)/totInstr;
-                }
-                if (time < time1) {
-                    time = time1;
-                }
-            } else {
-                psc_errmsg("ExecTime not found\n");
-            }
-        }
-//        if (std::stoi(property.getId()) == INTERPHASE_PROPS) {
-//            totInstr += property.getSeverity();
-//        }
-
-    }
-
-//    psc_dbgmsg(6, "Normalized Time: %1.13f;\n", time);
-
-    return time;
+double NormalizedTimeObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingTotalInstr, "TotalInstr");
+    report_missing(quantities.missingNormalizedTime, "ExecTime");
+    return quantities.normalizedTime;
 }
 
 
 //****TCO****
-TCOObjective::TCOObjective(std::string unitN):ObjectiveFunction(unitN) {
+TCOObjective::TCOObjective(std::string unitN):QuantityObjective(unitN) {
     unit = unitN;
+    costJoule    = 1.0;
+    costCoreHour = 1.0;
     try {
         if (opts.has_configurationfile) {
             // extract the significant regions from configuration file provided by readex-dyn-detect tool
@@ -613,67 +318,20 @@ std::string TCOObjective::getName() {
     return "TCO";
 }
 
-double TCOObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
-}
-
-
-double TCOObjective::objective(std::list<MetaProperty>& properties) {
-    double time = 0;
-    double energy = 0;
-
-    for ( auto property : properties ) {
-       if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-           std::stoi(property.getId()) == INTERPHASE_PROPS ||
-           std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType::iterator it;
-            addInfoType addInfo = property.getExtraInfo();
-
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                addInfoType::iterator iter = addInfo.find("NodeEnergy");
-                if (iter != property.getExtraInfo().end()) {
-                    energy += std::stod(iter->second);
-                } else {
-                    psc_errmsg("NodeEnergy not found\n");
-                }
-            }
-            else {
-                energy += property.getSeverity();
-            }
-
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                it = addInfo.find("cycles");
-            } else {
-                it = addInfo.find("ExecTime");
-            }
-
-            if (it != property.getExtraInfo().end()) {
-                double time1(0.0);
-                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                    time1 = std::stod(it->second)/NANOSEC_PER_SEC_DOUBLE;
-                } else {
-                    time1 = std::stod(it->second);
-                }
-                if (time < time1) {
-                    time = time1;
-                }
-            } else {
-                psc_errmsg("ExecTime not found\n");
-            }
-        }
-    }
-
-    //psc_dbgmsg(6, "Time: %f;\n", time);
-    return time*fe->get_ompnumthreads()*fe->get_mpinumprocs()*costCoreHour/3600+energy*costJoule;
-    //return time;
+double TCOObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingNodeEnergy, "NodeEnergy");
+    report_missing(quantities.missingExecTime, "ExecTime");
+    double time = std::max(quantities.maxTime, 0.0);
+    return time*fe->get_ompnumthreads()*fe->get_mpinumprocs()*costCoreHour/3600+quantities.energy*costJoule;
 }
 
 
 //****normalized TCO****
 
-NormalizedTCOObjective::NormalizedTCOObjective(std::string unitN):ObjectiveFunction(unitN) {
+NormalizedTCOObjective::NormalizedTCOObjective(std::string unitN):QuantityObjective(unitN) {
     unit = unitN;
+    costJoule    = 1.0;
+    costCoreHour = 1.0;
     try {
         if (opts.has_configurationfile) {
             // extract the significant regions from configuration file provided by readex-dyn-detect tool
@@ -695,64 +353,12 @@ std::string NormalizedTCOObjective::getName() {
     return "NormalizedTCO";
 }
 
-double NormalizedTCOObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
-}
-
-
-double NormalizedTCOObjective::objective(std::list<MetaProperty>& properties) {
-    double time = 0;
-    double energy = 0;
-    double totInstr = 0.0;
-
-    for ( auto property : properties ) {
-        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
-            std::stoi(property.getId()) == INTERPHASE_PROPS ||
-            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-            addInfoType::iterator it;
-            addInfoType addInfo = property.getExtraInfo();
-            it = addInfo.find("TotalInstr");
-            if (it != property.getExtraInfo().end()) {
-                totInstr = std::stod(it->second);
-            }  else {
-                psc_errmsg("TotalInstr not found\n");
-            }
-
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                it = addInfo.find("cycles");
-            } else {
-                it = addInfo.find("ExecTime");
-            }
-
-            if (it != property.getExtraInfo().end()) {
-                double time1(0.0);
-                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                    time1 = std::stod(it->second)/totInstr/NANOSEC_PER_SEC_DOUBLE;
-                } else {
-                    time1 = std::stod(it->second)/totInstr;
-                }
-                if (time < time1) {
-                    time = time1;
-                }
-            } else {
-                psc_errmsg("ExecTime not found\n");
-            }
-
-            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
-                addInfoType::iterator iter = addInfo.find("NodeEnergy");
-                if (iter != property.getExtraInfo().end()) {
-                    energy += std::stod(iter->second)/totInstr;
-                } else {
-                    psc_errmsg("NodeEnergy not found\n");
-                }
-            } else {
-                energy += property.getSeverity()/totInstr;
-            }
-        }
-    }
-
-    return (time*fe->get_ompnumthreads()*fe->get_mpinumprocs()*costCoreHour/3600+energy*costJoule);
+double NormalizedTCOObjective::objective(const ObjectiveQuantities& quantities) {
+    report_missing(quantities.missingTotalInstr, "TotalInstr");
+    report_missing(quantities.missingExecTime, "ExecTime");
+    report_missing(quantities.missingNodeEnergy, "NodeEnergy");
+    double time = std::max(quantities.normalizedMaxTime, 0.0);
+    return (time*fe->get_ompnumthreads()*fe->get_mpinumprocs()*costCoreHour/3600+quantities.normalizedEnergy*costJoule);
 }
 
 
@@ -762,31 +368,11 @@ std::string PTF_minObjective::getName() {
     return "ptf_min";
 }
 
-double PTF_minObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
-}
-
-
-double PTF_minObjective::objective(std::list<MetaProperty>& properties) {
-    double minimum = 0.0;
-
-    try {
-        minimum = properties.front().getSeverity();
-
-        for( auto property : properties ) {
-            double current = property.getSeverity();
-            if( minimum > current ) {
-                minimum = current;
-            }
-        }
-    }
-    catch( const std::out_of_range& oor ) {
+double PTF_minObjective::objective(const ObjectiveQuantities& quantities) {
+    if (quantities.properties == 0) {
         psc_errmsg("ptf_min: no properties\n" );
     }
-    //psc_dbgmsg(6, "ptf_min: %f;\n", minimum);
-
-    return minimum;
+    return quantities.minSeverity;
 }
 
 
@@ -797,31 +383,11 @@ std::string PTF_maxObjective::getName() {
     return "ptf_max";
 }
 
-double PTF_maxObjective::objective(int scenario_id, ScenarioResultsPool* srp) {
-    std::list<MetaProperty> properties = srp->getScenarioResultsByID(scenario_id);
-    return objective(properties);
-}
-
-
-double PTF_maxObjective::objective(std::list<MetaProperty>& properties) {
-    double maximum = 0.0;
-
-   try {
-       maximum = properties.front().getSeverity();
-
-       for( auto property : properties ) {
-           double current = property.getSeverity();
-           if( maximum < current ) {
-               maximum = current;
-           }
-       }
-   }
-   catch( const std::out_of_range& oor ) {
-       psc_errmsg("ptf_max: no properties\n" );
-   }
-    //psc_dbgmsg(6, "ptf_max: %f;\n", maximum);
-
-    return maximum;
+double PTF_maxObjective::objective(const ObjectiveQuantities& quantities) {
+    if (quantities.properties == 0) {
+        psc_errmsg("ptf_max: no properties\n" );
+    }
+    return quantities.maxSeverity;
 }
 
 
@@ -0,0 +1,130 @@
+/**
+   @file    AgentHierarchyPlanner.h
+   @ingroup Frontend
+   @brief   Cost model driven layout of the agent hierarchy
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef AGENT_HIERARCHY_PLANNER_H_
+#define AGENT_HIERARCHY_PLANNER_H_
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Throughput model of the agents; all times in seconds per collection round
+ *
+ * An analysis agent needs aaStartup plus aaPerUnit for every unit of measurement volume of its
+ * processes. A high-level agent starts when its last child finished and needs hlStartup, hlPerChild
+ * for every child message and hlPerUnit for every unit it receives; it forwards the received volume
+ * scaled by reduction, which is below one when properties are clustered. The frontend consumes the
+ * root's output like a high-level agent with a single child.
+ */
+struct AgentCostModel {
+    double aaStartup;
+    double aaPerUnit;
+    double hlStartup;
+    double hlPerChild;
+    double hlPerUnit;
+    double reduction;
+
+    AgentCostModel() : aaStartup( 0.05 ), aaPerUnit( 0.002 ), hlStartup( 0.01 ), hlPerChild( 0.005 ),
+        hlPerUnit( 0.0002 ), reduction( 1.0 ) {
+    }
+};
+
+/**
+ * @brief One level of a planned hierarchy, analysis agents first
+ */
+struct AgentLevelPlan {
+    size_t agents;      ///< Number of agents on the level
+    size_t maxChildren; ///< Largest number of processes (analysis agents) or child agents of an agent
+    double finish;      ///< Predicted time the last agent of the level is done
+    double volume;      ///< Volume the level forwards to its parents
+};
+
+/**
+ * @brief Layout chosen by the planner together with its predicted costs
+ */
+struct AgentHierarchyPlan {
+    size_t                        clusterSize; ///< Processes per analysis agent before balancing on a node
+    size_t                        fanout;      ///< Children per high-level agent
+    std::vector< AgentLevelPlan > levels;      ///< Analysis agents first, the top-level agent last
+    double                        latency;     ///< Predicted collection latency at the frontend
+
+    size_t agents() const;
+};
+
+/**
+ * @class AgentHierarchyPlanner
+ * @ingroup Frontend
+ *
+ * @brief Chooses the processes per analysis agent and the fan-out of the high-level agents
+ *
+ * The planner builds the hierarchy exactly as ApplicationStarter::computeAgentHierarchy does:
+ * the processes of every node are split into balanced analysis agents that never span nodes, and
+ * consecutive agents are grouped under high-level agents until a single agent is left. It then
+ * evaluates the critical path through the throughput model for every candidate layout and keeps the
+ * one with the smallest predicted latency, preferring fewer agents on ties.
+ */
+class AgentHierarchyPlanner {
+public:
+    AgentHierarchyPlanner( const AgentCostModel& model = AgentCostModel() );
+
+    /// Add a process running on the given node with its expected measurement volume
+    void addProcess( const std::string& node,
+                     double             volume = 1.0 );
+
+    size_t processes() const {
+        return processCount;
+    }
+
+    /// Best plan; a non-zero cluster size or fan-out is kept fixed instead of searched
+    AgentHierarchyPlan plan( size_t fixedCluster = 0,
+                             size_t fixedFanout = 0 ) const;
+
+    /// Predicted plan of one layout; a fan-out of 1 puts all analysis agents under one high-level agent
+    AgentHierarchyPlan predict( size_t clusterSize,
+                                size_t fanout ) const;
+
+    void print( std::ostream&             out,
+                const AgentHierarchyPlan& plan ) const;
+
+    /// Processes per agent when a node's processes are split evenly into agents of at most clusterSize
+    static size_t balancedCluster( size_t processes,
+                                   size_t clusterSize );
+
+private:
+    struct Leaf {
+        double finish;
+        double volume;
+    };
+
+    std::vector< Leaf > leaves( size_t clusterSize,
+                                size_t& maxProcesses ) const;
+
+    AgentLevelPlan summarize( const std::vector< Leaf >& level,
+                              size_t                     maxProcesses ) const;
+
+    void group( AgentHierarchyPlan& plan,
+                std::vector< Leaf > level ) const;
+
+    AgentCostModel                        model;
+    std::vector< std::vector< double > > nodes;     ///< process volumes by node, in the order nodes were first seen
+    std::map< std::string, size_t >       nodeIndex; ///< position of every node in nodes
+    size_t                                processCount;
+};
+
+#endif /* AGENT_HIERARCHY_PLANNER_H_ */
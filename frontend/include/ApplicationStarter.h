@@ -2,8 +2,14 @@
 #define APPLICATION_STARTER_H_
 
 #include "regxx.h"
+#include "AgentLauncher.h"
 #include <list>
 #include <string>
+#include <vector>
+#include <sys/types.h>
+
+class EnsembleScheduler;
+struct EnsembleSlot;
 
 
 
@@ -22,6 +28,18 @@ public:
     void runApplication();
     void rerunApplication();
 
+    /// Runs one application instance and agent subtree per slot of the ensemble instead of one
+    void setEnsemble( EnsembleScheduler* ensemble );
+
+    /// Slot of the instance currently being started, NULL without an ensemble
+    const EnsembleSlot* launching() const;
+
+    /// Waits for the termination of all application instances
+    void waitForApplication();
+
+    /// Called on the heartbeat of an agent launched by the frontend
+    void agentReady( const std::string& tag );
+
 private:
     struct AgentDetails {
         char          tag[ 100 ];
@@ -40,23 +58,37 @@ private:
         LevelInfo*           prevLevel;
     };
 
+    /// One running copy of the application and the master agent of its subtree
+    struct Instance {
+        std::string            appname;
+        std::string            tag;
+        std::list< EntryData > processList;
+        std::vector< int >     idmap_f;
+        std::vector< int >     idmap_t;
+        pid_t                  pid;
+    };
+
     typedef std::string (*StarterPluginFunction)(char*);
 
     StarterPluginFunction loadPluginFunction( const char* );
+    void prepareInstances();
     void startApplication( bool isFirstStart );
-    LevelInfo* computeAgentHierarchy();
-    void runHlAgent( AgentDetails* agent );
-    void runAnalysisAgent( AgentDetails* agent );
+    void forkInstance( size_t index, const std::string& appstart_cmd );
+    void collectProcesses( Instance& instance, bool isFirstStart );
+    LevelInfo* computeAgentHierarchy( const Instance& instance );
+    AgentLaunch describeHlAgent( AgentDetails* agent, const Instance& instance );
+    AgentLaunch describeAnalysisAgent( AgentDetails* agent, const Instance& instance );
     void printAgentHierarchy( LevelInfo* levels ) const;
     void instrumentRequiredRegions();
 
-    int                    processes;
-    int                    idmap_f[ 8192 ];
-    int                    idmap_t[ 8192 ];
-    int                    idmap_h_num[ 19 ];
-    int                    idmap_h[ 19 ][ 8192 ];
-    std::list< EntryData > processList;
-    void*                  pluginHandle;
+    int                     processes; ///< Processes per instance
+    std::vector< Instance > instances;
+    EnsembleScheduler*      ensemble;
+    int                     launchingSlot;
+    int                     nextPort;   ///< Next free agent port, shared by the subtrees of all instances
+    void*                   pluginHandle;
+    AgentLauncher           launcher;
+    std::string             launchPlan; ///< Plan file read by the high-level agents, empty without them
 };
 
 #endif /* APPLICATION_STARTER_H_ */
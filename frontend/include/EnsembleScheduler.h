@@ -0,0 +1,116 @@
+/**
+   @file    EnsembleScheduler.h
+   @ingroup Frontend
+   @brief   Distribution of the scenarios of an experiment over concurrent application instances
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef ENSEMBLE_SCHEDULER_H_
+#define ENSEMBLE_SCHEDULER_H_
+
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One independent application instance of an ensemble and its agent subtree
+ */
+struct EnsembleSlot {
+    int                      index;
+    std::string              appname;     ///< Name the processes of the instance register under
+    std::string              tag;         ///< Tag of the master agent of the instance
+    std::vector<std::string> hosts;       ///< Share of the allocation
+    int                      share;       ///< Position among the slots sharing the same hosts
+    int                      shares;      ///< Number of slots sharing the same hosts, 1 on exclusive hosts
+    std::string              environment; ///< Environment the instance runs with
+    std::string              command;     ///< Command line arguments the instance runs with
+    std::vector<int>         scenarios;   ///< Scenarios of the current round
+    std::set<int>            merged;      ///< Scenarios of the current round whose results were merged
+    bool                     assigned;    ///< An experiment was defined for the slot in the current round
+    bool                     restart;     ///< The instance restarts before the current round
+};
+
+/**
+ * @class EnsembleScheduler
+ * @ingroup Frontend
+ *
+ * @brief Evaluates the scenarios of consecutive experiments concurrently on independent slots
+ *
+ * The allocation is partitioned into slots, each runs its own instance of the application under
+ * its own agent subtree. Every round, the experiments defined by the search are assigned to the
+ * idle slots, a slot whose experiment needs another environment or command line restarts, and the
+ * slots run their phases together. A scenario is sent to exactly one slot, so its results can be
+ * merged into the shared pool by the ID of the scenario, regardless of the instance that evaluated it.
+ */
+class EnsembleScheduler {
+public:
+    /// Slots named after the application, the master agents are tagged after the frontend
+    EnsembleScheduler( int                slots,
+                       const std::string& appname,
+                       int                frontend_id );
+
+    int size() const {
+        return slots_.size();
+    }
+
+    const EnsembleSlot& slot( int index ) const {
+        return slots_.at( index );
+    }
+
+    /// Divides the hosts into contiguous balanced shares, slots share hosts if there are fewer hosts than slots
+    void partition( const std::vector<std::string>& hosts );
+
+    /// Records the configuration an instance was started with
+    void started( int                slot,
+                  const std::string& environment,
+                  const std::string& command );
+
+    /// Slot of the master agent with the given tag, -1 for other agents
+    int slotOfAgent( const std::string& tag ) const;
+
+    /// Slot the scenario is assigned to in the current round, -1 if it is not
+    int slotOfScenario( int scenario_id ) const;
+
+    /// First slot without an experiment in the current round, -1 if all are busy
+    int idleSlot() const;
+
+    /// Assigns the scenarios of an experiment, the slot restarts if required or if its configuration changes
+    void assign( int                     slot,
+                 const std::vector<int>& scenarios,
+                 const std::string&      environment,
+                 const std::string&      command,
+                 bool                    restart );
+
+    /// Assigns scenarios outside of any experiment to the least loaded assigned slots, or to slot 0
+    void distribute( const std::vector<int>& scenarios );
+
+    /// Accepts the results of a scenario into the shared pool, false if it is not part of the current round
+    bool merge( int scenario_id );
+
+    /// Every scenario of the current round has results
+    bool complete() const;
+
+    /// Some slot restarts before the round runs
+    bool needsRestart() const;
+
+    /// No slot has scenarios in the current round
+    bool roundEmpty() const;
+
+    /// Clears the assignments, the slots keep their configuration for the next round
+    void finishRound();
+
+private:
+    std::vector<EnsembleSlot> slots_;
+};
+
+#endif /* ENSEMBLE_SCHEDULER_H_ */
@@ -0,0 +1,103 @@
+/**
+   @file    PropertyStore.h
+   @ingroup Frontend
+   @brief   Bounded store of the properties received by the frontend
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef PROPERTY_STORE_H_
+#define PROPERTY_STORE_H_
+
+#include "MetaProperty.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class PropertyStore
+ * @ingroup Frontend
+ *
+ * @brief Keeps the most severe properties for reporting and streams all of them to the output file
+ *
+ * Every reported property is written to the spill file as it arrives, so the export no longer needs
+ * the full set in memory. Only the reportLimit most severe properties are kept, in a min-heap on
+ * severity, for printing the summary. Internal properties (MetaProperty::isInternal) are counted but
+ * neither spilled nor reported.
+ */
+class PropertyStore {
+public:
+    PropertyStore();
+
+    ~PropertyStore();
+
+    /// Number of properties kept for the report
+    void setReportLimit( size_t limit );
+
+    size_t getReportLimit() const {
+        return limit_;
+    }
+
+    /// Stream the reported properties to file, after header; false if it cannot be opened
+    bool spillTo( const std::string& file,
+                  const std::string& header );
+
+    bool spilling() const {
+        return spill_.is_open();
+    }
+
+    /// Take a received property
+    void add( MetaProperty& property );
+
+    /// The kept properties by decreasing severity, ties in arrival order
+    std::vector<MetaProperty> top() const;
+
+    /// Write footer and close the spill file; false if writing failed
+    bool finish( const std::string& footer );
+
+    /// Forget the kept properties and counters and close the spill file without footer
+    void clear();
+
+    size_t received() const {
+        return received_;
+    }
+
+    size_t internal() const {
+        return internal_;
+    }
+
+    size_t spilled() const {
+        return spilled_;
+    }
+
+private:
+    struct Entry {
+        double       severity;
+        size_t       sequence;
+        MetaProperty property;
+    };
+
+    struct MoreSevere {
+        bool operator()( const Entry& a,
+                         const Entry& b ) const;
+    };
+
+    size_t             limit_;
+    std::vector<Entry> heap_;     ///< Min-heap: the least severe kept property is in front
+    std::ofstream      spill_;
+    size_t             received_;
+    size_t             internal_;
+    size_t             spilled_;
+};
+
+#endif /* PROPERTY_STORE_H_ */
@@ -0,0 +1,115 @@
+/**
+   @file    ScalabilityIndex.h
+   @ingroup Frontend
+   @brief   Hashed lookup of the properties of an OpenMP scalability analysis
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef SCALABILITY_INDEX_H_
+#define SCALABILITY_INDEX_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Identity of a property across the runs with different thread counts
+ */
+struct ScalabilityKey {
+    std::string name;
+    double      process;
+    double      RFL;
+    int         fileid;
+
+    ScalabilityKey( const std::string& name,
+                    double             process,
+                    double             RFL,
+                    int                fileid ) : name( name ), process( process ), RFL( RFL ), fileid( fileid ) {
+    }
+
+    bool operator==( const ScalabilityKey& other ) const {
+        return process == other.process && RFL == other.RFL && fileid == other.fileid && name == other.name;
+    }
+};
+
+struct ScalabilityKeyHash {
+    size_t operator()( const ScalabilityKey& key ) const;
+};
+
+/**
+ * @brief Scaling of one region measured with a given number of threads
+ */
+struct ScalabilityPoint {
+    int         threads;
+    double      speedup;        ///< Sequential time over the time with threads
+    int         roundedSpeedup; ///< Speedup rounded to the nearest integer, halves rounded down
+    double      efficiency;     ///< Speedup per thread
+    long double deviation;      ///< Time above the ideal sequential time / threads, 0 if below
+};
+
+/// Speedup, efficiency and deviation of a region taking execTime with threads against seqTime
+ScalabilityPoint scalability_point( long double seqTime,
+                                    long double execTime,
+                                    int         threads );
+
+/**
+ * @class ScalabilityIndex
+ * @ingroup Frontend
+ *
+ * @brief Positions of the properties of a list grouped by identity and thread count
+ *
+ * The scalability analysis compares every property with its counterparts of the runs with more
+ * threads. The index numbers the properties in the order they are added and keeps, for every
+ * identity, the ascending positions per thread count, so that "the first matching property from
+ * here on" is a hash lookup and a binary search instead of a scan of the whole list.
+ */
+class ScalabilityIndex {
+public:
+    static const size_t npos;
+
+    ScalabilityIndex();
+
+    void clear();
+
+    /// Index the next property and return its position
+    size_t add( const ScalabilityKey& key,
+                int                   threads );
+
+    size_t size() const {
+        return size_;
+    }
+
+    /// Ascending positions of the properties with the identity, for any thread count
+    const std::vector<size_t>& positions( const ScalabilityKey& key ) const;
+
+    /// Ascending positions of the properties with the identity measured with threads
+    const std::vector<size_t>& positions( const ScalabilityKey& key,
+                                          int                   threads ) const;
+
+    /// First position not before from of the identity measured with threads, npos if none
+    size_t find( const ScalabilityKey& key,
+                 int                   threads,
+                 size_t                from = 0 ) const;
+
+private:
+    struct Series {
+        std::vector<size_t>                all;
+        std::map<int, std::vector<size_t> > byThreads;
+    };
+
+    std::unordered_map<ScalabilityKey, Series, ScalabilityKeyHash> series_;
+    size_t                                                         size_;
+};
+
+#endif /* SCALABILITY_INDEX_H_ */
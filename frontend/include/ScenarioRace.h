@@ -0,0 +1,121 @@
+/**
+   @file    ScenarioRace.h
+   @ingroup Frontend
+   @brief   Statistical early stopping of the evaluation of scenarios
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef SCENARIO_RACE_H_
+#define SCENARIO_RACE_H_
+
+#include <map>
+#include <vector>
+
+/**
+ * @brief Parameters of a race
+ */
+struct ScenarioRaceOptions {
+    double confidence;    ///< Two-sided confidence level of the intervals of the means
+    int    minIterations; ///< Samples of every scenario before it can be eliminated
+    int    maxIterations; ///< Samples after which a scenario stops, decided or not
+    double indifference;  ///< Relative half width below which a scenario needs no further samples
+
+    ScenarioRaceOptions() : confidence( 0.95 ), minIterations( 3 ), maxIterations( 10 ), indifference( 0.01 ) {
+    }
+};
+
+/**
+ * @brief Mean and confidence interval of the samples of a scenario
+ */
+struct ScenarioStatistics {
+    int    samples;
+    double mean;
+    double deviation; ///< Sample standard deviation, 0 with less than two samples
+    double halfWidth; ///< Half width of the confidence interval, infinite with less than two samples
+
+    double lower() const {
+        return mean - halfWidth;
+    }
+
+    double upper() const {
+        return mean + halfWidth;
+    }
+};
+
+/// Quantile of the Student t distribution with the given degrees of freedom
+double student_t_quantile( double probability,
+                           double degrees );
+
+/**
+ * @class ScenarioRace
+ * @ingroup Frontend
+ *
+ * @brief Decides which scenarios of an experiment need another phase iteration
+ *
+ * Every iteration of an experiment yields one objective sample per scenario, lower is better.
+ * After minIterations samples, a scenario whose interval lies entirely above the interval of the
+ * best scenario is dominated and not evaluated any further. The remaining scenarios are evaluated
+ * while their intervals overlap with the best one, that is while they are within noise of each
+ * other, until their intervals are narrower than the indifference or maxIterations is reached.
+ */
+class ScenarioRace {
+public:
+    explicit ScenarioRace( const ScenarioRaceOptions& options = ScenarioRaceOptions() );
+
+    void enter( int scenario_id );
+
+    /// Adds a sample and re-evaluates the eliminations
+    void add_sample( int    scenario_id,
+                     double value );
+
+    /// Scenarios to run in the next iteration, empty once the race is decided
+    std::vector<int> scenarios_to_run() const;
+
+    bool finished() const {
+        return scenarios_to_run().empty();
+    }
+
+    bool eliminated( int scenario_id ) const;
+
+    ScenarioStatistics statistics( int scenario_id ) const;
+
+    /// Scenario with the lowest mean, -1 if there are no samples
+    int leader() const;
+
+    /// Index of the sample closest to the median of a scenario
+    int median_sample( int scenario_id ) const;
+
+    /// Total number of samples taken
+    int samples() const;
+
+    const std::vector<double>& sample_values( int scenario_id ) const;
+
+private:
+    struct Entry {
+        std::vector<double> samples;
+        bool                eliminated;
+    };
+
+    const Entry& entry( int scenario_id ) const;
+
+    bool needs_samples( int          scenario_id,
+                        const Entry& entry ) const;
+
+    void eliminate_dominated();
+
+    ScenarioRaceOptions            options_;
+    std::map<int, Entry>           entries_;
+    mutable std::map<int, double>  quantiles_; ///< t quantiles of the confidence by degrees of freedom
+};
+
+#endif /* SCENARIO_RACE_H_ */
@@ -24,6 +24,9 @@
 #include "MetaProperty.h"
 #include "selective_debug.h"
 #include "ApplicationStarter.h"
+#include "EnsembleScheduler.h"
+#include "PropertyStore.h"
+#include "ScalabilityIndex.h"
 #include "Scenario.h"
 #include "StrategyRequest.h"
 #include "ScenarioPoolSet.h"
@@ -83,8 +86,10 @@ struct cmdline_opts {
     int has_maxfan;
     int has_maxcluster;
     int has_maxthreads;
+    int has_plan_agents;
 
     int has_timeout;
+    int has_heartbeat;
     int has_delay;
     int has_iterations;
     int has_duration;
@@ -131,6 +136,7 @@ struct cmdline_opts {
     char maxcluster_string[ 2000 ];
     char maxthreads_string[ 2000 ];
     char timeout_string[ 2000 ];
+    char heartbeat_string[ 2000 ];
     char delay_string[ 2000 ];
     char iterations_string[ 2000 ];
     char duration_string[ 2000 ];
@@ -178,8 +184,10 @@ struct cmdline_opts {
         has_maxfan            = 0;
         has_maxcluster        = 0;
         has_maxthreads        = 0;
+        has_plan_agents       = 0;
 
         has_timeout           = 0;
+        has_heartbeat         = 0;
         has_delay             = 0;
         has_iterations        = 0;
         has_masterhost        = 0;
@@ -268,6 +276,8 @@ private:
     int         maxcluster_val;
     int         maxfan;
     bool        quit_fe;
+
+    EnsembleScheduler* ensemble; ///< Concurrent application instances, NULL with a single one
     double      startup_time;
     bool        badRegionsRemoved;
     bool        allRegionsCommented;
@@ -291,16 +301,18 @@ private:
     // RM: Serialization
     serialized_strategy_request_container_t strategyRequestContainer;
     std::vector<char>                       strategyRequestBuffer;
+    std::map<std::string, std::vector<char> > childStrategyRequestBuffers; ///< Requests of single children, by tag
 
 public:
     // list of discovered properties
     std::list<PropertyInfo> properties_;
     std::list<PropertyInfo> property_threads;
-    std::list<PropertyInfo> p_threads;
     std::list<PropertyInfo> existing_properties;
     std::list<PropertyInfo> property;
 
-    std::vector<MetaProperty> metaproperties_;
+    std::vector<MetaProperty> metaproperties_;  ///< Full property list, kept only for tuning and scalability runs
+    PropertyStore             property_store;   ///< Most severe properties and the streamed export
+    bool                      keep_properties;  ///< Whether received properties are also kept in metaproperties_
     std::vector<Rts*>         rts_list_;
 
     std::list<PropertyInfo> severity_based_properties;
@@ -310,6 +322,12 @@ public:
     std::list<PropertyInfo> DeviationProperties;
     std::list<long double>  PhaseTime_user;
 
+    // scalability analysis lookups into properties_ and property_threads
+    ScalabilityIndex                  properties_index;
+    std::vector<const PropertyInfo*>  indexed_properties;
+    ScalabilityIndex                  threads_index;
+    std::vector<const PropertyInfo*>  indexed_threads;
+
 public:
     PeriscopeFrontend( ACE_Reactor* r );
 
@@ -390,6 +408,20 @@ public:
         serializedStrategyRequestStream.flush();
     }
 
+    /// Serializes a request for one child only, the other children get the common request
+    void serializeStrategyRequests( StrategyRequest*   strategyRequest,
+                                    const std::string& child_tag ) {
+        namespace io = boost::iostreams;
+
+        std::vector<char>& buffer = childStrategyRequestBuffers[ child_tag ];
+        buffer.clear();
+        io::stream<io::back_insert_device<std::vector<char> > > serializedStrategyRequestStream( buffer );
+        boost::archive::binary_oarchive                         oaStrategyRequest( serializedStrategyRequestStream );
+
+        oaStrategyRequest << strategyRequest;
+        serializedStrategyRequestStream.flush();
+    }
+
     std::vector<char> get_SerializedStrategyRequestBuffer() {
         return strategyRequestBuffer;
     }
@@ -567,6 +599,14 @@ public:
         return need_restart;
     }
 
+    void set_ensemble( EnsembleScheduler* e ) {
+        ensemble = e;
+    }
+
+    EnsembleScheduler* get_ensemble() {
+        return ensemble;
+    }
+
     void set_shutdown_allowed( bool sdallowed ) {
         shutdown_allowed = sdallowed;
     }
@@ -624,6 +664,8 @@ public:
 
     void add_started_agent( int num_procs ); // increases the number of connected appl procs and if it equals to the total amount issues start command
 
+    void update_started_processes();         // takes the number of connected appl procs from the heartbeat summaries and issues start once all are connected
+
     void remove_started_agent();             // decrease the number of started agents
 
     int get_agents_number() {   // returns the expected amount of agents in hierarchy
@@ -692,6 +734,9 @@ public:
 
     int handle_step( TimerAction );
 
+    /// Terminates the experiment when a subtree of the hierarchy missed its heartbeat deadline
+    void liveness_tick();
+
     void set_timer( int         initial,
                     int         interval,
                     int         max,
@@ -721,6 +766,8 @@ public:
 
     void export_properties();                ///< Write the results to a file
 
+    bool open_property_file();               ///< Start streaming the results to the output file
+
     void export_scalability_properties();
 
     void get_prop_info( MetaProperty& prop );
@@ -21,10 +21,18 @@ namespace msm = boost::msm;
 
 namespace frontend_statemachine {
 // forward declarations within the namespace
-StrategyRequest* createStrategyRequest( PeriscopeFrontend* fe );
+/// Request for the scenarios of the experiment scenario pool, only those of the given slot of an ensemble if not -1
+StrategyRequest* createStrategyRequest( PeriscopeFrontend* fe,
+                                        int                slot = -1 );
 
 void pushStrategyRequest( StrategyRequest* strategy_request );
 
+/// Whether the scenarios of the current experiment are still being raced over phase iterations
+bool scenario_race_running();
+
+/// Whether a slot of the ensemble can take the next experiment before the round runs
+bool ensemble_slot_idle();
+
 // top level events and commands
 struct basic_event {
     PSC_SM_TRACE_EVENT_DECLARATION( "Basic event" );
@@ -246,6 +254,8 @@ public:
             a_row < PreparingScenarios,            define_experiment,     DefiningExperiments,           & at_msm::define_experiment_action     >,
             a_row < DefiningExperiments,           consider_restart,      ConsideringApplicationRestart, & at_msm::consider_restart_action      >,
             a_row < ConsideringApplicationRestart, run_phase_experiments, RunningPhaseExperiments,       & at_msm::run_phase_experiments_action >,
+            // define the experiments of the idle slots of an ensemble before the round runs
+            a_row < ConsideringApplicationRestart, define_experiment,     DefiningExperiments,           & at_msm::define_experiment_action     >,
             // if there was a restart in the run_phase_experiments_action, then we need to re-run this step
             a_row < RunningPhaseExperiments,       run_phase_experiments, RunningPhaseExperiments,       & at_msm::run_phase_experiments_action >,
             // jump to DefiningExperiments if prepared scenario pool not empty
@@ -0,0 +1,223 @@
+/**
+   @file    AgentHierarchyPlanner.cc
+   @ingroup Frontend
+   @brief   Cost model driven layout of the agent hierarchy
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "AgentHierarchyPlanner.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <set>
+
+// candidate fan-outs above this are not searched; they only lengthen the critical path of an agent
+static const size_t maxSearchedFanout = 128;
+
+
+size_t AgentHierarchyPlan::agents() const {
+    size_t count = 0;
+    for( size_t l = 0; l < levels.size(); l++ ) {
+        count += levels[ l ].agents;
+    }
+    return count;
+}
+
+
+AgentHierarchyPlanner::AgentHierarchyPlanner( const AgentCostModel& model ) : model( model ), processCount( 0 ) {
+}
+
+
+void AgentHierarchyPlanner::addProcess( const std::string& node,
+                                        double             volume ) {
+    std::map< std::string, size_t >::const_iterator it = nodeIndex.find( node );
+    if( it == nodeIndex.end() ) {
+        it = nodeIndex.insert( std::make_pair( node, nodes.size() ) ).first;
+        nodes.push_back( std::vector< double >() );
+    }
+    nodes[ it->second ].push_back( volume );
+    processCount++;
+}
+
+
+size_t AgentHierarchyPlanner::balancedCluster( size_t processes,
+                                               size_t clusterSize ) {
+    if( clusterSize == 0 || processes == 0 ) {
+        return clusterSize;
+    }
+    size_t agents = ( processes + clusterSize - 1 ) / clusterSize;
+    return ( processes + agents - 1 ) / agents;
+}
+
+
+std::vector< AgentHierarchyPlanner::Leaf > AgentHierarchyPlanner::leaves( size_t  clusterSize,
+                                                                          size_t& maxProcesses ) const {
+    std::vector< Leaf > level;
+    maxProcesses = 0;
+
+    for( size_t node = 0; node < nodes.size(); node++ ) {
+        const std::vector< double >& volumes = nodes[ node ];
+        size_t                       chunk   = balancedCluster( volumes.size(), clusterSize );
+        for( size_t first = 0; first < volumes.size(); first += chunk ) {
+            size_t last = std::min( first + chunk, volumes.size() );
+            Leaf   leaf;
+            leaf.volume = 0;
+            for( size_t p = first; p < last; p++ ) {
+                leaf.volume += volumes[ p ];
+            }
+            leaf.finish  = model.aaStartup + model.aaPerUnit * leaf.volume;
+            maxProcesses = std::max( maxProcesses, last - first );
+            level.push_back( leaf );
+        }
+    }
+    return level;
+}
+
+
+void AgentHierarchyPlanner::group( AgentHierarchyPlan& plan,
+                                   std::vector< Leaf > level ) const {
+    size_t fanout = plan.fanout;
+
+    // high-level agents take consecutive children like computeAgentHierarchy assigns the tags
+    while( level.size() > 1 ) {
+        size_t              width = fanout == 1 ? level.size() : fanout;
+        std::vector< Leaf > parents;
+        AgentLevelPlan      info;
+        info.maxChildren = 0;
+        info.finish      = 0;
+        info.volume      = 0;
+
+        for( size_t first = 0; first < level.size(); first += width ) {
+            size_t last   = std::min( first + width, level.size() );
+            double ready  = 0;
+            double volume = 0;
+            for( size_t c = first; c < last; c++ ) {
+                ready   = std::max( ready, level[ c ].finish );
+                volume += level[ c ].volume;
+            }
+
+            Leaf parent;
+            parent.finish = ready + model.hlStartup + model.hlPerChild * ( last - first ) + model.hlPerUnit * volume;
+            parent.volume = model.reduction * volume;
+            parents.push_back( parent );
+
+            info.maxChildren = std::max( info.maxChildren, last - first );
+            info.finish      = std::max( info.finish, parent.finish );
+            info.volume     += parent.volume;
+        }
+        info.agents = parents.size();
+        plan.levels.push_back( info );
+        level.swap( parents );
+    }
+
+    plan.latency = level.empty() ? 0 : level[ 0 ].finish + model.hlPerChild + model.hlPerUnit * level[ 0 ].volume;
+}
+
+
+AgentLevelPlan AgentHierarchyPlanner::summarize( const std::vector< Leaf >& level,
+                                                size_t                     maxProcesses ) const {
+    AgentLevelPlan info;
+    info.agents      = level.size();
+    info.maxChildren = maxProcesses;
+    info.finish      = 0;
+    info.volume      = 0;
+    for( size_t l = 0; l < level.size(); l++ ) {
+        info.finish  = std::max( info.finish, level[ l ].finish );
+        info.volume += level[ l ].volume;
+    }
+    return info;
+}
+
+
+AgentHierarchyPlan AgentHierarchyPlanner::predict( size_t clusterSize,
+                                                   size_t fanout ) const {
+    AgentHierarchyPlan plan;
+    plan.clusterSize = std::max< size_t >( clusterSize, 1 );
+    plan.fanout      = std::max< size_t >( fanout, 1 );
+
+    size_t              maxProcesses;
+    std::vector< Leaf > level = leaves( plan.clusterSize, maxProcesses );
+    plan.levels.push_back( summarize( level, maxProcesses ) );
+    group( plan, level );
+    return plan;
+}
+
+
+AgentHierarchyPlan AgentHierarchyPlanner::plan( size_t fixedCluster,
+                                                size_t fixedFanout ) const {
+    // a node of n processes only changes its number of agents at the cluster sizes ceil( n / k ),
+    // so these are the only candidates that lead to different layouts
+    std::set< size_t > clusters;
+    if( fixedCluster > 0 ) {
+        clusters.insert( fixedCluster );
+    }
+    else {
+        std::set< size_t > sizes;
+        for( size_t node = 0; node < nodes.size(); node++ ) {
+            sizes.insert( nodes[ node ].size() );
+        }
+        for( std::set< size_t >::const_iterator n = sizes.begin(); n != sizes.end(); n++ ) {
+            for( size_t agents = 1; agents * agents <= *n; agents++ ) {
+                clusters.insert( ( *n + agents - 1 ) / agents );
+                clusters.insert( agents );
+            }
+            clusters.insert( 1 );
+        }
+        if( clusters.empty() ) {
+            clusters.insert( 1 );
+        }
+    }
+
+    AgentHierarchyPlan best;
+    bool               found = false;
+    std::set< size_t >::const_reverse_iterator cluster;
+    for( cluster = clusters.rbegin(); cluster != clusters.rend(); cluster++ ) {
+        size_t              maxProcesses;
+        std::vector< Leaf > level = leaves( *cluster, maxProcesses );
+        AgentLevelPlan      base  = summarize( level, maxProcesses );
+        size_t              first = fixedFanout > 0 ? fixedFanout : 2;
+        size_t              last  = fixedFanout > 0 ? fixedFanout : std::max< size_t >( 2, std::min( level.size(), maxSearchedFanout ) );
+
+        for( size_t fanout = first; fanout <= last; fanout++ ) {
+            AgentHierarchyPlan candidate;
+            candidate.clusterSize = *cluster;
+            candidate.fanout      = fanout;
+            candidate.levels.push_back( base );
+            group( candidate, level );
+
+            if( !found || candidate.latency < best.latency - 1e-12 ||
+                ( candidate.latency <= best.latency + 1e-12 && candidate.agents() < best.agents() ) ) {
+                best  = candidate;
+                found = true;
+            }
+        }
+    }
+    return best;
+}
+
+
+void AgentHierarchyPlanner::print( std::ostream&             out,
+                                   const AgentHierarchyPlan& plan ) const {
+    out << "Processes: " << processCount << " on " << nodes.size() << " node(s)\n";
+    out << "Cluster size: " << plan.clusterSize << "  Fan-out: " << plan.fanout
+        << "  Agents: " << plan.agents() << "  Levels: " << plan.levels.size() << "\n";
+    out << std::fixed << std::setprecision( 4 );
+    for( size_t l = 0; l < plan.levels.size(); l++ ) {
+        const AgentLevelPlan& level = plan.levels[ l ];
+        out << "  " << ( l == 0 ? "AA " : "HLA" ) << " level " << l + 1 << ": " << std::setw( 7 ) << level.agents
+            << " agent(s), up to " << std::setw( 5 ) << level.maxChildren << ( l == 0 ? " processes" : " children " )
+            << ", done after " << level.finish << " s, forwarding " << level.volume << " units\n";
+    }
+    out << "Predicted collection latency: " << plan.latency << " s\n";
+    out.unsetf( std::ios::floatfield );
+}
@@ -1,5 +1,9 @@
 #include "ApplicationStarter.h"
+#include "AgentHierarchyPlanner.h"
+#include "EnsembleScheduler.h"
 #include "frontend.h"
+#include <algorithm>
+#include <vector>
 
 extern int  application_pid;
 extern char user_specified_environment[ 5000 ];
@@ -24,6 +28,37 @@ static std::string get_filename_from_region( const std::string& region ) {
 }
 
 
+static std::string working_directory() {
+    const char* cwd = getenv( "PWD" );
+    if( cwd ) {
+        return cwd;
+    }
+
+    char buffer[ 4096 ];
+    return getcwd( buffer, sizeof( buffer ) ) ? buffer : ".";
+}
+
+
+/// The cost model plans the hierarchy on --plan-agents or with a Configuration.periscope.agentHierarchy section
+static bool agent_planner_configured( AgentCostModel& model,
+                                      double&         volume ) {
+    bool configured = opts.has_configurationfile && configTree.get_child_optional( "Configuration.periscope.agentHierarchy" );
+    if( !opts.has_plan_agents && !configured ) {
+        return false;
+    }
+    if( configured ) {
+        model.aaStartup  = configTree.get( "Configuration.periscope.agentHierarchy.aaStartup", model.aaStartup );
+        model.aaPerUnit  = configTree.get( "Configuration.periscope.agentHierarchy.aaPerUnit", model.aaPerUnit );
+        model.hlStartup  = configTree.get( "Configuration.periscope.agentHierarchy.hlStartup", model.hlStartup );
+        model.hlPerChild = configTree.get( "Configuration.periscope.agentHierarchy.hlPerChild", model.hlPerChild );
+        model.hlPerUnit  = configTree.get( "Configuration.periscope.agentHierarchy.hlPerUnit", model.hlPerUnit );
+        model.reduction  = configTree.get( "Configuration.periscope.agentHierarchy.reduction", model.reduction );
+        volume           = configTree.get( "Configuration.periscope.agentHierarchy.volume", volume );
+    }
+    return true;
+}
+
+
 static std::string get_rfl_from_region( const std::string& region ) {
     size_t      start, stop;
     std::string rfl;
@@ -36,12 +71,14 @@ static std::string get_rfl_from_region( const std::string& region ) {
 }
 
 
-ApplicationStarter::ApplicationStarter(): pluginHandle(NULL), processes(0) { }
+ApplicationStarter::ApplicationStarter(): pluginHandle(NULL), processes(0), ensemble(NULL), launchingSlot(-1), nextPort(0) { }
 
 
 ApplicationStarter::~ApplicationStarter() {
     if( pluginHandle )
         dlclose(pluginHandle);
+    if( !launchPlan.empty() )
+        unlink( launchPlan.c_str() );
 }
 
 
@@ -63,147 +100,270 @@ ApplicationStarter::StarterPluginFunction ApplicationStarter::loadPluginFunction
 }
 
 
-void ApplicationStarter::startApplication( bool isFirstStart ) {
-    StarterPluginFunction cmdfn = loadPluginFunction("StarterPlugin_appStartCmd");
-    if( !cmdfn )
-        psc_abort("Could not load function StarterPlugin_appStartCmd.\n");
+void ApplicationStarter::setEnsemble( EnsembleScheduler* ensemble_p ) {
+    ensemble = ensemble_p;
+    if( !ensemble ) {
+        return;
+    }
 
-    string appstart_cmd = cmdfn(user_specified_environment);
+    // the starter plugin may know the hosts of the allocation, otherwise all slots share this one
+    std::vector< std::string > hosts;
+    StarterPluginFunction      hostfn = loadPluginFunction( "StarterPlugin_allocationHosts" );
+    if( hostfn ) {
+        std::stringstream list( hostfn( NULL ) );
+        std::string       host;
+        while( list >> host ) {
+            hosts.push_back( host );
+        }
+    }
+    if( hosts.empty() ) {
+        char hostname[ 100 ];
+        gethostname( hostname, 100 );
+        hosts.push_back( hostname );
+    }
+    ensemble->partition( hosts );
+}
 
-    if (applUninstrumented()) {
+
+const EnsembleSlot* ApplicationStarter::launching() const {
+    return launchingSlot >= 0 ? &ensemble->slot( launchingSlot ) : NULL;
+}
+
+
+void ApplicationStarter::waitForApplication() {
+    int status;
+    for( size_t i = 0; i < instances.size(); i++ ) {
+        if( instances[ i ].pid > 0 ) {
+            waitpid( instances[ i ].pid, &status, 0 );
+        }
+    }
+}
+
+
+void ApplicationStarter::forkInstance( size_t             index,
+                                       const std::string& appstart_cmd ) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Child process starts application
         psc_dbgmsg( 1,
-                    "Starting non-instrumented application in interactive partition: >%s<\n",
+                    "Starting application in interactive partition: >%s<\n",
                     appstart_cmd.c_str());
-        system(appstart_cmd.c_str());
+        int retVal = system(appstart_cmd.c_str());
+        exit( retVal );
     }
-    else {
-        RegistryService* regsrv = fe->get_registry();
+    else if (pid < 0) {
+        psc_errmsg("Error forking child process!\n");
+        abort();
+    }
+    instances[ index ].pid = pid;
+}
 
-        if (!isFirstStart) {
-            // Set time-out to the maximum value and call re-instrumentation procedure on restart
-            fe->set_global_timeout( 429496729 );
-            instrumentRequiredRegions();
-        }
 
-        application_pid = fork();
-        if (application_pid == 0) {
-            // Child process starts application
-            psc_dbgmsg( 1,
-                        "Starting application in interactive partition: >%s<\n",
-                        appstart_cmd.c_str());
-            int retVal = system(appstart_cmd.c_str());
-            exit( retVal );
-        }
-        else if (application_pid < 0) {
-            psc_errmsg("Error forking child process!\n");
-            abort();
-        }
+void ApplicationStarter::collectProcesses( Instance& instance,
+                                           bool      isFirstStart ) {
+    RegistryService* regsrv = fe->get_registry();
+
+    for( int rank = 0; rank < processes; rank++ ) {
+        instance.idmap_f[ rank ] = isFirstStart ? - 1 : instance.idmap_t[ rank ];
+        instance.idmap_t[ rank ] = -1;
+    }
+
+    EntryData query;
+
+    bool startup_finished       = false;
+    int  num_startup_components = processes;
+
+    if (isFirstStart && num_startup_components == 0) {
+        num_startup_components = 1;
+    }
 
-        for( int rank = 0; rank < processes; rank++ ) {
-            idmap_f[ rank ] = isFirstStart ? - 1 : idmap_t[ rank ];
-            idmap_t[ rank ] = -1;
+    psc_dbgmsg(5, "waiting for startup of %d components of %s...\n", num_startup_components, instance.appname.c_str());
+    while( !startup_finished ) {
+        query.app = instance.appname;
+        query.tag = "none";
+
+        instance.processList.clear();
+
+        if( regsrv->query_entries( instance.processList, query, false ) == -1 ) {
+            psc_errmsg( "Error querying registry for application\n" );
+            abort();
         }
 
-        EntryData query;
+        psc_dbgmsg( 1, "components started up: %d (of %d)\n",
+                    instance.processList.size(), num_startup_components );
+        startup_finished = ( instance.processList.size() >= num_startup_components );
 
-        bool startup_finished       = false;
-        int  num_startup_components = processes;
+        int child_status;
 
-        if (isFirstStart && num_startup_components == 0) {
-            num_startup_components = 1;
+        // Child finished but components not started -> process was terminated or error occurred
+        if (waitpid(instance.pid, &child_status, WNOHANG) == instance.pid && !startup_finished) {
+            abort();
         }
 
-        psc_dbgmsg(5, "waiting for startup of %d components...\n", num_startup_components);
-        while( !startup_finished ) {
-            query.app = fe->get_appname();
-            query.tag = "none";
+        if (!startup_finished) {
+            sleep(1);
+        }
+    }
 
-            processList.clear();
+    std::list<EntryData>::iterator entryit;
+    for (entryit = instance.processList.begin(); entryit != instance.processList.end(); entryit++) {
+        if( entryit->pid > ( int )instance.idmap_t.size() ) {
+            instance.idmap_f.resize( entryit->pid, -1 );
+            instance.idmap_t.resize( entryit->pid, -1 );
+        }
+        instance.idmap_t[entryit->pid - 1] = entryit->id;
+    }
 
-            if( regsrv->query_entries( processList, query, false ) == -1 ) {
-                psc_errmsg( "Error querying registry for application\n" );
-                abort();
-            }
+    for( int i = 0; i < processes; i++ ) {
+        if( instance.idmap_t[ i ] == -1 ) {
+            psc_errmsg( "Error in collecting ids of processes. Registry entry for rank %d not found.\n",
+                        i );
+            abort();
+        }
+    }
+}
 
-            psc_dbgmsg( 1, "components started up: %d (of %d)\n",
-                        processList.size(), num_startup_components );
-            startup_finished = ( processList.size() >= num_startup_components );
 
-            int child_status;
+void ApplicationStarter::startApplication( bool isFirstStart ) {
+    // an instance of an ensemble runs with the environment and the hosts of its slot, which the
+    // starter plugin takes from launching()
+    const char* cmdname = "StarterPlugin_appStartCmd";
+    if( ensemble && !applUninstrumented() )
+        cmdname = "StarterPlugin_instanceAppStartCmd";
 
-            // Child finished but components not started -> process was terminated or error occurred
-            if (waitpid(application_pid, &child_status, WNOHANG) == application_pid && !startup_finished) {
-                abort();
-            }
+    StarterPluginFunction cmdfn = loadPluginFunction( cmdname );
+    if( !cmdfn )
+        psc_abort("Could not load function %s.\n", cmdname);
 
-            if (!startup_finished) {
-                sleep(1);
-            }
+    if (applUninstrumented()) {
+        string appstart_cmd = cmdfn(user_specified_environment);
+        psc_dbgmsg( 1,
+                    "Starting non-instrumented application in interactive partition: >%s<\n",
+                    appstart_cmd.c_str());
+        system(appstart_cmd.c_str());
+    }
+    else {
+        if (!isFirstStart) {
+            // Set time-out to the maximum value and call re-instrumentation procedure on restart
+            fe->set_global_timeout( 429496729 );
+            instrumentRequiredRegions();
         }
 
-        std::list<EntryData>::iterator entryit;
-        for (entryit = processList.begin(); entryit != processList.end(); entryit++) {
-            idmap_t[entryit->pid - 1] = entryit->id;
+        // all instances start up concurrently
+        for( size_t i = 0; i < instances.size(); i++ ) {
+            if( !ensemble ) {
+                forkInstance( i, cmdfn(user_specified_environment) );
+                continue;
+            }
+            if( isFirstStart ) {
+                ensemble->started( i, user_specified_environment, opts.app_run_string );
+            }
+            std::vector< char > environment( ensemble->slot( i ).environment.begin(), ensemble->slot( i ).environment.end() );
+            environment.push_back( 0 );
+            launchingSlot = i;
+            forkInstance( i, cmdfn( &environment[ 0 ] ) );
+            launchingSlot = -1;
         }
+        application_pid = instances[ 0 ].pid;
 
-        for( int i = 0; i < processes; i++ ) {
-            if( idmap_t[ i ] == -1 ) {
-                psc_errmsg( "Error in collecting ids of processes. Registry entry for rank %d not found.\n",
-                            i );
-                abort();
+        for( size_t i = 0; i < instances.size(); i++ ) {
+            collectProcesses( instances[ i ], isFirstStart );
+            if( ensemble ) {
+                ensemble->started( i, ensemble->slot( i ).environment, ensemble->slot( i ).command );
             }
         }
     }
 }
 
 
-void ApplicationStarter::runApplication() {
+void ApplicationStarter::prepareInstances() {
     processes = fe->get_mpinumprocs();
+
+    instances.clear();
+    instances.resize( ensemble ? ensemble->size() : 1 );
+    for( size_t i = 0; i < instances.size(); i++ ) {
+        Instance& instance = instances[ i ];
+        char      tag[ 200 ];
+        snprintf( tag, sizeof( tag ), "fe[%d]:%d", fe->own_id(), ( int )i );
+        instance.appname = ensemble ? ensemble->slot( i ).appname : std::string( fe->get_appname() );
+        instance.tag     = ensemble ? ensemble->slot( i ).tag : std::string( tag );
+        instance.idmap_f.assign( std::max( processes, 1 ), -1 );
+        instance.idmap_t.assign( std::max( processes, 1 ), -1 );
+        instance.pid = -1;
+    }
+}
+
+
+void ApplicationStarter::runApplication() {
+    prepareInstances();
     if( opts.has_apprun )
         ApplicationStarter::startApplication(true);
 }
 
 
 void ApplicationStarter::rerunApplication() {
+    // Agents stay alive across application restarts; only those whose process exited are launched
+    // again, before the application so that both start up concurrently
+    std::vector< std::string > relaunched = launcher.relaunchDead();
+
     startApplication(false);
 
-    //send mapping info to child agents
+    //send mapping info to child agents, the master agent of each instance gets the processes of its instance
     std::map< std::string, AgentInfo >* child_agents = fe->get_child_agents();
     std::map< std::string, AgentInfo >::iterator it;
     for( it = ( *child_agents ).begin(); it != ( *child_agents ).end(); it++ ) {
-        AgentInfo& ai = it->second;
-        if( ai.status != AgentInfo::CONNECTED ) {
-            if( fe->connect_to_child( &ai ) == -1 ) {
+        AgentInfo& ai    = it->second;
+        bool       fresh = std::find( relaunched.begin(), relaunched.end(), it->first ) != relaunched.end();
+        Instance*  instance = NULL;
+        for( size_t i = 0; i < instances.size(); i++ ) {
+            if( instances[ i ].tag == it->first ) {
+                instance = &instances[ i ];
+            }
+        }
+        if( instance == NULL ) {
+            psc_errmsg( "No application instance for child agent %s\n", it->first.c_str() );
+        }
+        else if( ai.status != AgentInfo::CONNECTED || fresh ) {
+            if( fe->reattach_child( &ai, fresh, processes, &instance->idmap_f[ 0 ], &instance->idmap_t[ 0 ] ) == -1 ) {
                 psc_errmsg( "Error connecting to child at %s:%d\n",
                             ai.hostname.c_str(), ai.port );
             }
-            else {
-                ai.handler->reinit( processes, idmap_f, idmap_t );
-            }
         }
     }
 }
 
 
-void ApplicationStarter::runAnalysisAgent( AgentDetails* agent ) {
+void ApplicationStarter::agentReady( const std::string& tag ) {
+    launcher.ready( tag );
+}
+
+
+AgentLaunch ApplicationStarter::describeAnalysisAgent( AgentDetails*   agent,
+                                                       const Instance& instance ) {
     if( !opts.has_phase ) {
         psc_abort( "The name of the phase region was not provided!\n" );
     }
 
+    AgentLaunch       launch;
     std::stringstream common_command;
 
+    launch.tag    = agent->tag;
+    launch.parent = agent->parent;
+    launch.host   = agent->host;
+
     StarterPluginFunction cmdfn = loadPluginFunction("StarterPlugin_agentStartPrefix");
 
     // Test whether we have a plugin which gives us the prefix.
     // The prefix has to respect the agent host. Additionally, the plugin may
     // add a debug tool like gdb to obtain stack traces.
     if (cmdfn == NULL) {
-        const char*       cwd = getenv( "PWD" );
-
         if( opts.has_force_localhost ) {
-            common_command <<  "cd "  <<  cwd  <<  ";";
+            // local-only mode: the launcher forks in the working directory and the shell
+            // is replaced by the agent, so the launched process is the agent itself
+            launch.workdir = working_directory();
+            common_command <<  "exec ";
         } else {
-            common_command <<  "ssh "  <<  agent->host  <<  " \"cd "  <<  cwd  <<  "\";";
+            common_command <<  "ssh "  <<  agent->host  <<  " \"cd "  <<  working_directory()  <<  "\";";
         }
     } else {
         common_command << cmdfn(agent->host);
@@ -215,7 +375,7 @@ void ApplicationStarter::runAnalysisAgent( AgentDetails* agent ) {
                    << " --parent=" << agent->parent
                    << " --phase=\"" << opts.phase_string << "\""
                    << " --port=" << agent->port
-                   << " --appname=" << fe->get_appname()
+                   << " --appname=" << instance.appname
                    << " --id=" << agent->applIds
                    << " --mpinumprocs=" << fe->get_mpinumprocs()
                    << " --ompnumthreads=" << fe->get_ompnumthreads();
@@ -244,6 +404,10 @@ void ApplicationStarter::runAnalysisAgent( AgentDetails* agent ) {
         common_command << " --timeout=" << opts.timeout_string;
     }
 
+    if( opts.has_heartbeat ) {
+        common_command << " --heartbeat-deadline=" << opts.heartbeat_string;
+    }
+
     common_command << " --debug=" << psc_dbg_level;
 
     if( opts.has_inst ) {
@@ -257,26 +421,31 @@ void ApplicationStarter::runAnalysisAgent( AgentDetails* agent ) {
     if( opts.has_plugin ) {
         common_command << " --tune=" << opts.plugin;
     }
-    const std::string command_str = common_command.str();
+    launch.command = common_command.str();
 
-    // START analysis agent..
-    psc_dbgmsg( 1, "Starting AAgent (%s): %s\n", agent->tag, command_str.c_str() );
-    if( fork() == 0 ) {
-        int retVal = system( command_str.c_str() );
-        _exit( retVal );
-    }
+    psc_dbgmsg( 1, "AAgent (%s): %s\n", agent->tag, launch.command.c_str() );
+    return launch;
 }
 
 
-void ApplicationStarter::runHlAgent( AgentDetails* agent ) {
+AgentLaunch ApplicationStarter::describeHlAgent( AgentDetails*   agent,
+                                                 const Instance& instance ) {
+    AgentLaunch       launch;
     std::stringstream command_string;
 
+    launch.tag    = agent->tag;
+    launch.parent = agent->parent;
+    launch.host   = agent->host;
+
     StarterPluginFunction cmdfn = loadPluginFunction("StarterPlugin_agentStartPrefix");
 
     // Test whether we have a plugin which gives us the prefix.
     if (cmdfn == NULL) {
         if (!opts.has_force_localhost) {
             command_string <<  "ssh "  <<  agent->host  <<  " ";
+        } else {
+            launch.workdir = working_directory();
+            command_string <<  "exec ";
         }
     } else {
         command_string << cmdfn(agent->host);
@@ -285,27 +454,27 @@ void ApplicationStarter::runHlAgent( AgentDetails* agent ) {
     command_string <<  xstr( _HLAGENT_EXEC );
     command_string <<  " --tag="  <<  agent->tag;
     command_string <<  " --parent="  <<  agent->parent;
-    command_string <<  " --appname="  <<  fe->get_appname();
+    command_string <<  " --appname="  <<  instance.appname;
     command_string <<  " --port="  <<  agent->port;
     command_string <<  " --child="  <<  agent->children;
+    if( !launchPlan.empty() )
+        command_string <<  " --launch-plan="  <<  launchPlan;
     if( opts.has_registry )
         command_string <<  " --registry="  <<  opts.reg_string;
     if( opts.has_dontcluster )
         command_string <<  " --dontcluster";
     if( opts.has_timeout )
         command_string <<  " --timeout="  <<  atoi(opts.timeout_string);
+    if( opts.has_heartbeat )
+        command_string <<  " --heartbeat-deadline="  <<  opts.heartbeat_string;
     command_string <<  " --debug="  <<  psc_dbg_level;
     if( opts.has_selectivedebug )
         command_string <<  " --selective-debug="  <<  opts.selectivedebug_string;
 
-    // START high-level agent..
-    const std::string command = command_string.str();
-    psc_dbgmsg( 1, "Starting HLAgent (%s): %s\n", agent->tag, command.c_str() );
+    launch.command = command_string.str();
 
-    if( fork() == 0 ) {
-        int retVal = system( command.c_str() );
-        exit( retVal );
-    }
+    psc_dbgmsg( 1, "HLAgent (%s): %s\n", agent->tag, launch.command.c_str() );
+    return launch;
 }
 
 
@@ -329,22 +498,28 @@ void ApplicationStarter::printAgentHierarchy( LevelInfo* levels ) const {
 }
 
 
-ApplicationStarter::LevelInfo* ApplicationStarter::computeAgentHierarchy() {
-    std::list<EntryData>::iterator                      entryit;
+ApplicationStarter::LevelInfo* ApplicationStarter::computeAgentHierarchy( const Instance& instance ) {
+    std::list<EntryData>::const_iterator                entryit;
     std::list<int>::iterator                            idit;
-    std::map< std::string, std::list< int > >           apphosts;
-    std::map< std::string, std::list< int > >::iterator apphostit;
+    std::vector< std::pair< std::string, std::list< int > > >           apphosts;
+    std::vector< std::pair< std::string, std::list< int > > >::iterator apphostit;
+    std::map< std::string, size_t >                                     apphostIndex;
     char                                                hostname[ 100 ];
     gethostname( hostname, 100 );
     LevelInfo*    levels, * level, * masterLevel;
     AgentDetails* agent;
-    int           nextPort = fe->get_local_port() + 1;
+    const std::list<EntryData>& processList = instance.processList;
 
-    psc_dbgmsg( 3, "Identified %d matching entries\n", processList.size() );
+    psc_dbgmsg( 3, "Identified %d matching entries of %s\n", processList.size(), instance.appname.c_str() );
 
+    // nodes in the order of the process list, so consecutive agents run on neighbouring nodes
     for( entryit = processList.begin(); entryit != processList.end();
          entryit++ ) {
-        apphosts[ entryit->node ].push_back( entryit->id );
+        if( apphostIndex.find( entryit->node ) == apphostIndex.end() ) {
+            apphostIndex[ entryit->node ] = apphosts.size();
+            apphosts.push_back( std::make_pair( entryit->node, std::list< int >() ) );
+        }
+        apphosts[ apphostIndex[ entryit->node ] ].second.push_back( entryit->id );
     }
 
     int clusterSize = 128;
@@ -353,6 +528,31 @@ ApplicationStarter::LevelInfo* ApplicationStarter::computeAgentHierarchy() {
                     opts.maxcluster_string );
         clusterSize = atoi( opts.maxcluster_string );
     }
+    int maxfan = fe->get_maxfan();
+
+    // Processes per analysis agent and fan-out come from the cost model when it is enabled, unless given explicitly
+    AgentCostModel model;
+    double         volume  = 1.0;
+    bool           planned = agent_planner_configured( model, volume );
+    if( planned ) {
+        AgentHierarchyPlanner planner( model );
+        for( entryit = processList.begin(); entryit != processList.end();
+             entryit++ ) {
+            planner.addProcess( opts.has_force_localhost ? std::string( hostname ) : entryit->node, volume );
+        }
+
+        AgentHierarchyPlan layout = planner.plan( opts.has_maxcluster ? clusterSize : 0, opts.has_maxfan ? maxfan : 0 );
+        std::stringstream  layout_text;
+        planner.print( layout_text, layout );
+        psc_dbgmsg( 2, "Agent hierarchy plan:\n%s", layout_text.str().c_str() );
+
+        clusterSize = layout.clusterSize;
+        maxfan      = layout.fanout;
+    }
+    else {
+        // the fixed layout keeps the nodes sorted by name
+        std::sort( apphosts.begin(), apphosts.end() );
+    }
 
     levels = ( LevelInfo* )calloc( 1, sizeof( LevelInfo ) );
     level  = levels;
@@ -370,11 +570,13 @@ ApplicationStarter::LevelInfo* ApplicationStarter::computeAgentHierarchy() {
     level->numberOfAgents = 1;
 
     if( opts.has_force_localhost ) {
+        // A planned layout splits evenly: as many agents as clusters of the given size, but of balanced size
+        int nodeCluster = planned ? AgentHierarchyPlanner::balancedCluster( processList.size(), clusterSize ) : clusterSize;
         for( entryit = processList.begin(); entryit != processList.end();
              entryit++ ) {
             entryCount++;
             //Split list of application entries into clusters of give size
-            if( entryCount > clusterSize ) {
+            if( entryCount > nodeCluster ) {
                 //new analysis agent
                 agent->nextAgent = ( AgentDetails* )calloc( 1, sizeof( AgentDetails ) );
                 agent            = agent->nextAgent;
@@ -420,11 +622,12 @@ ApplicationStarter::LevelInfo* ApplicationStarter::computeAgentHierarchy() {
             }
 
             // Loop over all process entries for the current node!
+            int nodeCluster = planned ? AgentHierarchyPlanner::balancedCluster( apphostit->second.size(), clusterSize ) : clusterSize;
             for( idit = ( *apphostit ).second.begin();
                  idit != ( *apphostit ).second.end(); idit++ ) {
                 entryCount++;
                 //Split list of application entries into clusters of give size
-                if( entryCount > clusterSize ) {
+                if( entryCount > nodeCluster ) {
                     //new analysis agent
                     agent->nextAgent = ( AgentDetails* )calloc( 1, sizeof( AgentDetails ) );
                     agent            = agent->nextAgent;
@@ -451,7 +654,6 @@ ApplicationStarter::LevelInfo* ApplicationStarter::computeAgentHierarchy() {
         }
     }
 
-    int maxfan = fe->get_maxfan();
     //Create levels of high level agents
 
     while( level->numberOfAgents > 1 ) {
@@ -487,8 +689,7 @@ ApplicationStarter::LevelInfo* ApplicationStarter::computeAgentHierarchy() {
     masterLevel = level;
     char tagStr[ 100 ], parentStr[ 100 ], childrenTags[ 4000 ];
 
-    sprintf( tagStr, "fe[%d]:0", fe->own_id() );
-    strcat( level->agents->tag, tagStr );
+    strcat( level->agents->tag, instance.tag.c_str() );
     *childrenTags = 0;
     sprintf( parentStr, "%s[%d]", fe->get_local_tag().c_str(), fe->own_id() );
     strcat( level->agents->parent, parentStr );
@@ -532,35 +733,58 @@ ApplicationStarter::LevelInfo* ApplicationStarter::computeAgentHierarchy() {
 
 
 void ApplicationStarter::runAgents() {
-    // child tag
-    char child_tag[200];
-
-    snprintf(child_tag, sizeof(child_tag), "fe[%d]:0", fe->own_id());
+    if( instances.empty() ) {
+        prepareInstances();
+    }
 
     char hostname[100];
     gethostname(hostname, 100);
-    fe->add_child_agent( child_tag, hostname, -1 );
 
-    LevelInfo* masterLevel = computeAgentHierarchy();
+    // one subtree per application instance, each with its own master agent below the frontend
+    std::vector< LevelInfo* > masterLevels;
+    nextPort = fe->get_local_port() + 1;
+    for( size_t i = 0; i < instances.size(); i++ ) {
+        fe->add_child_agent( instances[ i ].tag, hostname, -1 );
+        masterLevels.push_back( computeAgentHierarchy( instances[ i ] ) );
+        printAgentHierarchy( masterLevels.back() );
+
+        // Every agent of the hierarchy goes into the launch plan. The frontend starts the top level
+        // and each high-level agent starts its own children from the plan, so launches fan out
+        // along the tree instead of all leaving the frontend node.
+        if( masterLevels.back()->prevLevel != NULL && launchPlan.empty() ) {
+            std::stringstream plan_file;
+            plan_file << working_directory() << "/.psc_launch_plan." << getpid();
+            launchPlan = plan_file.str();
+        }
+    }
 
-    printAgentHierarchy( masterLevel );
+    std::vector< AgentLaunch > plan;
+    for( size_t i = 0; i < instances.size(); i++ ) {
+        LevelInfo* level = masterLevels[ i ];
+        while( level != NULL && level->prevLevel != NULL ) {
+            for( AgentDetails* agent = level->agents; agent != NULL; agent = agent->nextAgent ) {
+                plan.push_back( describeHlAgent( agent, instances[ i ] ) );
+            }
+            level = level->prevLevel;
+        }
 
-    LevelInfo* level = masterLevel;
-    // for (LevelInfo* level = masterLevel; level != NULL && level->prevLevel != NULL; level = level->prevLevel)
-    while( level != NULL && level->prevLevel != NULL ) {
-        // for (AgentDetails* agent = level->agents; agent != NULL; agent = agent->nextAgent)
-        AgentDetails* agent = level->agents;
-        while( agent != NULL ) {
-            runHlAgent( agent );
-            agent = agent->nextAgent;
+        // No need for an if clause here, as we have at least one level.
+        for( AgentDetails* agent = level->agents; agent != NULL; agent = agent->nextAgent ) {
+            plan.push_back( describeAnalysisAgent( agent, instances[ i ] ) );
         }
-        level = level->prevLevel;
     }
 
-    // No need for an if clause here, as we have at least one level.
-    for( AgentDetails* agent = level->agents; agent != NULL; agent = agent->nextAgent ) {
-        runAnalysisAgent(agent);
+    if( !launchPlan.empty() && !AgentLauncher::writePlan( launchPlan, plan ) ) {
+        psc_abort( "Could not write the agent launch plan.\n" );
+    }
+
+    // the master agents of all instances are children of the frontend
+    for( size_t i = 0; i < plan.size(); i++ ) {
+        if( plan[ i ].parent == masterLevels[ 0 ]->agents->parent ) {
+            launcher.add( plan[ i ] );
+        }
     }
+    launcher.dispatch();
 }
 
 
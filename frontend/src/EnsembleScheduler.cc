@@ -0,0 +1,187 @@
+/**
+   @file    EnsembleScheduler.cc
+   @ingroup Frontend
+   @brief   Distribution of the scenarios of an experiment over concurrent application instances
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "EnsembleScheduler.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+EnsembleScheduler::EnsembleScheduler( int                slots,
+                                      const std::string& appname,
+                                      int                frontend_id ) {
+    if( slots < 1 ) {
+        throw std::invalid_argument( "EnsembleScheduler: at least one slot is required" );
+    }
+    slots_.resize( slots );
+    for( int k = 0; k < slots; k++ ) {
+        EnsembleSlot&     slot = slots_[ k ];
+        std::stringstream appname_k, tag;
+        // a single slot is the application as it runs without an ensemble
+        if( slots == 1 ) {
+            appname_k << appname;
+        }
+        else {
+            appname_k << appname << ".slot" << k;
+        }
+        tag << "fe[" << frontend_id << "]:" << k;
+        slot.index    = k;
+        slot.appname  = appname_k.str();
+        slot.tag      = tag.str();
+        slot.share    = 0;
+        slot.shares   = 1;
+        slot.assigned = false;
+        slot.restart  = false;
+    }
+}
+
+void EnsembleScheduler::partition( const std::vector<std::string>& hosts ) {
+    int n = slots_.size();
+    int h = hosts.size();
+    for( int k = 0; k < n; k++ ) {
+        EnsembleSlot& slot = slots_[ k ];
+        slot.hosts.clear();
+        slot.share  = 0;
+        slot.shares = 1;
+        if( h >= n ) {
+            slot.hosts.assign( hosts.begin() + ( long )k * h / n, hosts.begin() + ( long )( k + 1 ) * h / n );
+        }
+        else if( h > 0 ) {
+            // consecutive slots share a host, host j runs the slots k with k * h / n == j
+            int host  = ( long )k * h / n;
+            int first = ( ( long )host * n + h - 1 ) / h;
+            int last  = ( ( long )( host + 1 ) * n + h - 1 ) / h;
+            slot.hosts.push_back( hosts[ host ] );
+            slot.share  = k - first;
+            slot.shares = last - first;
+        }
+    }
+}
+
+void EnsembleScheduler::started( int                slot,
+                                 const std::string& environment,
+                                 const std::string& command ) {
+    EnsembleSlot& s = slots_.at( slot );
+    s.environment = environment;
+    s.command     = command;
+    s.restart     = false;
+}
+
+int EnsembleScheduler::slotOfAgent( const std::string& tag ) const {
+    for( size_t k = 0; k < slots_.size(); k++ ) {
+        if( slots_[ k ].tag == tag ) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+int EnsembleScheduler::slotOfScenario( int scenario_id ) const {
+    for( size_t k = 0; k < slots_.size(); k++ ) {
+        const std::vector<int>& scenarios = slots_[ k ].scenarios;
+        if( std::find( scenarios.begin(), scenarios.end(), scenario_id ) != scenarios.end() ) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+int EnsembleScheduler::idleSlot() const {
+    for( size_t k = 0; k < slots_.size(); k++ ) {
+        if( !slots_[ k ].assigned ) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+void EnsembleScheduler::assign( int                     slot,
+                                const std::vector<int>& scenarios,
+                                const std::string&      environment,
+                                const std::string&      command,
+                                bool                    restart ) {
+    EnsembleSlot& s = slots_.at( slot );
+    if( s.assigned ) {
+        throw std::logic_error( "EnsembleScheduler: slot already runs an experiment in this round" );
+    }
+    s.assigned = true;
+    s.scenarios.insert( s.scenarios.end(), scenarios.begin(), scenarios.end() );
+    s.restart     = restart || environment != s.environment || command != s.command;
+    s.environment = environment;
+    s.command     = command;
+}
+
+void EnsembleScheduler::distribute( const std::vector<int>& scenarios ) {
+    for( size_t i = 0; i < scenarios.size(); i++ ) {
+        if( slotOfScenario( scenarios[ i ] ) >= 0 ) {
+            continue;
+        }
+        // the environment of an idle slot is not defined for the round, its instance may be stale
+        int best = -1;
+        for( size_t k = 0; k < slots_.size(); k++ ) {
+            if( slots_[ k ].assigned && ( best < 0 || slots_[ k ].scenarios.size() < slots_[ best ].scenarios.size() ) ) {
+                best = k;
+            }
+        }
+        slots_[ best < 0 ? 0 : best ].scenarios.push_back( scenarios[ i ] );
+    }
+}
+
+bool EnsembleScheduler::merge( int scenario_id ) {
+    int k = slotOfScenario( scenario_id );
+    if( k < 0 ) {
+        return false;
+    }
+    slots_[ k ].merged.insert( scenario_id );
+    return true;
+}
+
+bool EnsembleScheduler::complete() const {
+    for( size_t k = 0; k < slots_.size(); k++ ) {
+        if( slots_[ k ].merged.size() != slots_[ k ].scenarios.size() ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EnsembleScheduler::needsRestart() const {
+    for( size_t k = 0; k < slots_.size(); k++ ) {
+        if( slots_[ k ].restart ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EnsembleScheduler::roundEmpty() const {
+    for( size_t k = 0; k < slots_.size(); k++ ) {
+        if( !slots_[ k ].scenarios.empty() ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void EnsembleScheduler::finishRound() {
+    for( size_t k = 0; k < slots_.size(); k++ ) {
+        slots_[ k ].scenarios.clear();
+        slots_[ k ].merged.clear();
+        slots_[ k ].assigned = false;
+        slots_[ k ].restart  = false;
+    }
+}
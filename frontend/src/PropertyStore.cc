@@ -0,0 +1,131 @@
+/**
+   @file    PropertyStore.cc
+   @ingroup Frontend
+   @brief   Bounded store of the properties received by the frontend
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "PropertyStore.h"
+
+#include <algorithm>
+
+// a is reported before b: higher severity, or the same severity and received earlier
+bool PropertyStore::MoreSevere::operator()( const Entry& a,
+                                            const Entry& b ) const {
+    if( a.severity != b.severity ) {
+        return a.severity > b.severity;
+    }
+    return a.sequence < b.sequence;
+}
+
+
+PropertyStore::PropertyStore() : limit_( 50 ), received_( 0 ), internal_( 0 ), spilled_( 0 ) {
+}
+
+
+PropertyStore::~PropertyStore() {
+    if( spill_.is_open() ) {
+        spill_.close();
+    }
+}
+
+
+void PropertyStore::setReportLimit( size_t limit ) {
+    limit_ = limit;
+    // the heap front is the least severe, drop from there
+    while( heap_.size() > limit_ ) {
+        std::pop_heap( heap_.begin(), heap_.end(), MoreSevere() );
+        heap_.pop_back();
+    }
+}
+
+
+bool PropertyStore::spillTo( const std::string& file,
+                             const std::string& header ) {
+    if( spill_.is_open() ) {
+        spill_.close();
+    }
+    spill_.clear();
+    spill_.open( file.c_str() );
+    if( !spill_ ) {
+        return false;
+    }
+    spill_ << header;
+    return spill_.good();
+}
+
+
+void PropertyStore::add( MetaProperty& property ) {
+    received_++;
+    if( property.isInternal() ) {
+        internal_++;
+        return;
+    }
+
+    if( spill_.is_open() ) {
+        spill_ << property.toXML();
+        spilled_++;
+    }
+
+    if( limit_ == 0 ) {
+        return;
+    }
+    Entry entry;
+    entry.severity = property.getSeverity();
+    entry.sequence = received_;
+    if( heap_.size() < limit_ ) {
+        entry.property = property;
+        heap_.push_back( entry );
+        std::push_heap( heap_.begin(), heap_.end(), MoreSevere() );
+    }
+    else if( MoreSevere()( entry, heap_.front() ) ) {
+        std::pop_heap( heap_.begin(), heap_.end(), MoreSevere() );
+        entry.property = property;
+        heap_.back()   = entry;
+        std::push_heap( heap_.begin(), heap_.end(), MoreSevere() );
+    }
+}
+
+
+std::vector<MetaProperty> PropertyStore::top() const {
+    std::vector<Entry> sorted( heap_ );
+    std::sort( sorted.begin(), sorted.end(), MoreSevere() );
+
+    std::vector<MetaProperty> result;
+    result.reserve( sorted.size() );
+    for( size_t i = 0; i < sorted.size(); i++ ) {
+        result.push_back( sorted[ i ].property );
+    }
+    return result;
+}
+
+
+bool PropertyStore::finish( const std::string& footer ) {
+    if( !spill_.is_open() ) {
+        return false;
+    }
+    spill_ << footer;
+    spill_.close();
+    return !spill_.fail();
+}
+
+
+void PropertyStore::clear() {
+    heap_.clear();
+    received_ = 0;
+    internal_ = 0;
+    spilled_  = 0;
+    if( spill_.is_open() ) {
+        spill_.close();
+    }
+}
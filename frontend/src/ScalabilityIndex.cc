@@ -0,0 +1,102 @@
+/**
+   @file    ScalabilityIndex.cc
+   @ingroup Frontend
+   @brief   Hashed lookup of the properties of an OpenMP scalability analysis
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "ScalabilityIndex.h"
+
+#include <algorithm>
+#include <functional>
+
+const size_t ScalabilityIndex::npos = ( size_t )-1;
+
+static const std::vector<size_t> no_positions;
+
+static inline void hash_combine( size_t& seed,
+                                 size_t  value ) {
+    seed ^= value + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+}
+
+
+size_t ScalabilityKeyHash::operator()( const ScalabilityKey& key ) const {
+    // 0.0 and -0.0 compare equal, so they must hash alike
+    size_t seed = std::hash<std::string>()( key.name );
+    hash_combine( seed, std::hash<double>()( key.process == 0.0 ? 0.0 : key.process ) );
+    hash_combine( seed, std::hash<double>()( key.RFL == 0.0 ? 0.0 : key.RFL ) );
+    hash_combine( seed, std::hash<int>()( key.fileid ) );
+    return seed;
+}
+
+
+ScalabilityPoint scalability_point( long double seqTime,
+                                    long double execTime,
+                                    int         threads ) {
+    ScalabilityPoint point;
+    point.threads = threads;
+    // same conversions as the original analysis so that the reported values do not change
+    point.speedup        = ( long double )seqTime / ( double )execTime;
+    point.roundedSpeedup = point.speedup;
+    if( point.speedup - point.roundedSpeedup > 0.5 ) {
+        point.roundedSpeedup++;
+    }
+    point.efficiency = point.speedup / threads;
+    point.deviation  = execTime - ( seqTime / threads ) > 0 ? execTime - ( seqTime / threads ) : 0.0;
+    return point;
+}
+
+
+ScalabilityIndex::ScalabilityIndex() : size_( 0 ) {
+}
+
+
+void ScalabilityIndex::clear() {
+    series_.clear();
+    size_ = 0;
+}
+
+
+size_t ScalabilityIndex::add( const ScalabilityKey& key,
+                              int                   threads ) {
+    Series& series = series_[ key ];
+    series.all.push_back( size_ );
+    series.byThreads[ threads ].push_back( size_ );
+    return size_++;
+}
+
+
+const std::vector<size_t>& ScalabilityIndex::positions( const ScalabilityKey& key ) const {
+    std::unordered_map<ScalabilityKey, Series, ScalabilityKeyHash>::const_iterator it = series_.find( key );
+    return it == series_.end() ? no_positions : it->second.all;
+}
+
+
+const std::vector<size_t>& ScalabilityIndex::positions( const ScalabilityKey& key,
+                                                        int                   threads ) const {
+    std::unordered_map<ScalabilityKey, Series, ScalabilityKeyHash>::const_iterator it = series_.find( key );
+    if( it == series_.end() ) {
+        return no_positions;
+    }
+    std::map<int, std::vector<size_t> >::const_iterator th = it->second.byThreads.find( threads );
+    return th == it->second.byThreads.end() ? no_positions : th->second;
+}
+
+
+size_t ScalabilityIndex::find( const ScalabilityKey& key,
+                               int                   threads,
+                               size_t                from ) const {
+    const std::vector<size_t>&          series = positions( key, threads );
+    std::vector<size_t>::const_iterator it     = std::lower_bound( series.begin(), series.end(), from );
+    return it == series.end() ? npos : *it;
+}
@@ -0,0 +1,269 @@
+/**
+   @file    ScenarioRace.cc
+   @ingroup Frontend
+   @brief   Statistical early stopping of the evaluation of scenarios
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "ScenarioRace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// continued fraction of the regularized incomplete beta function, converges for x < (a + 1) / (a + b + 2)
+static double beta_fraction( double a,
+                             double b,
+                             double x ) {
+    const double tiny = 1e-300;
+    double       c    = 1.0;
+    double       d    = 1.0 - ( a + b ) * x / ( a + 1.0 );
+    d = 1.0 / ( std::fabs( d ) < tiny ? tiny : d );
+    double h = d;
+    for( int m = 1; m <= 300; m++ ) {
+        double aa = m * ( b - m ) * x / ( ( a + 2 * m - 1 ) * ( a + 2 * m ) );
+        d = 1.0 + aa * d;
+        c = 1.0 + aa / c;
+        d = 1.0 / ( std::fabs( d ) < tiny ? tiny : d );
+        c = std::fabs( c ) < tiny ? tiny : c;
+        h *= d * c;
+
+        aa = -( a + m ) * ( a + b + m ) * x / ( ( a + 2 * m ) * ( a + 2 * m + 1 ) );
+        d  = 1.0 + aa * d;
+        c  = 1.0 + aa / c;
+        d  = 1.0 / ( std::fabs( d ) < tiny ? tiny : d );
+        c  = std::fabs( c ) < tiny ? tiny : c;
+        double delta = d * c;
+        h *= delta;
+        if( std::fabs( delta - 1.0 ) < 1e-14 ) {
+            break;
+        }
+    }
+    return h;
+}
+
+static double incomplete_beta( double a,
+                               double b,
+                               double x ) {
+    if( x <= 0.0 ) {
+        return 0.0;
+    }
+    if( x >= 1.0 ) {
+        return 1.0;
+    }
+    double front = std::exp( std::lgamma( a + b ) - std::lgamma( a ) - std::lgamma( b ) + a * std::log( x ) + b * std::log( 1.0 - x ) );
+    if( x < ( a + 1.0 ) / ( a + b + 2.0 ) ) {
+        return front * beta_fraction( a, b, x ) / a;
+    }
+    return 1.0 - front * beta_fraction( b, a, 1.0 - x ) / b;
+}
+
+static double student_t_cdf( double t,
+                             double degrees ) {
+    double tail = 0.5 * incomplete_beta( degrees / 2.0, 0.5, degrees / ( degrees + t * t ) );
+    return t >= 0.0 ? 1.0 - tail : tail;
+}
+
+
+double student_t_quantile( double probability,
+                           double degrees ) {
+    if( probability <= 0.0 || probability >= 1.0 || degrees <= 0.0 ) {
+        throw std::invalid_argument( "student_t_quantile: probability must be in (0, 1), degrees positive" );
+    }
+    if( probability < 0.5 ) {
+        return -student_t_quantile( 1.0 - probability, degrees );
+    }
+
+    double low = 0.0, high = 1.0;
+    while( student_t_cdf( high, degrees ) < probability ) {
+        high *= 2.0;
+    }
+    for( int i = 0; i < 200 && high - low > 1e-12 * high; i++ ) {
+        double middle = 0.5 * ( low + high );
+        ( student_t_cdf( middle, degrees ) < probability ? low : high ) = middle;
+    }
+    return 0.5 * ( low + high );
+}
+
+
+ScenarioRace::ScenarioRace( const ScenarioRaceOptions& options ) : options_( options ) {
+    if( options_.confidence <= 0.0 || options_.confidence >= 1.0 ) {
+        throw std::invalid_argument( "ScenarioRace: confidence must be in (0, 1)" );
+    }
+    options_.minIterations = std::max( options_.minIterations, 2 );
+    options_.maxIterations = std::max( options_.maxIterations, options_.minIterations );
+}
+
+
+void ScenarioRace::enter( int scenario_id ) {
+    Entry& e = entries_[ scenario_id ];
+    e.eliminated = false;
+}
+
+
+const ScenarioRace::Entry& ScenarioRace::entry( int scenario_id ) const {
+    std::map<int, Entry>::const_iterator it = entries_.find( scenario_id );
+    if( it == entries_.end() ) {
+        throw std::out_of_range( "ScenarioRace: scenario not in the race" );
+    }
+    return it->second;
+}
+
+
+void ScenarioRace::add_sample( int    scenario_id,
+                               double value ) {
+    std::map<int, Entry>::iterator it = entries_.find( scenario_id );
+    if( it == entries_.end() ) {
+        throw std::out_of_range( "ScenarioRace: scenario not in the race" );
+    }
+    it->second.samples.push_back( value );
+    eliminate_dominated();
+}
+
+
+ScenarioStatistics ScenarioRace::statistics( int scenario_id ) const {
+    const std::vector<double>& samples = entry( scenario_id ).samples;
+    ScenarioStatistics         s;
+    s.samples   = samples.size();
+    s.mean      = 0.0;
+    s.deviation = 0.0;
+    s.halfWidth = std::numeric_limits<double>::infinity();
+    if( samples.empty() ) {
+        return s;
+    }
+
+    // Welford's update, stable for samples with a large common offset
+    double m2 = 0.0;
+    for( size_t i = 0; i < samples.size(); i++ ) {
+        double delta = samples[ i ] - s.mean;
+        s.mean += delta / ( i + 1 );
+        m2     += delta * ( samples[ i ] - s.mean );
+    }
+    if( samples.size() >= 2 ) {
+        s.deviation = std::sqrt( m2 / ( samples.size() - 1 ) );
+        double& t = quantiles_[ samples.size() - 1 ];
+        if( t == 0.0 ) {
+            t = student_t_quantile( 0.5 + options_.confidence / 2.0, samples.size() - 1 );
+        }
+        s.halfWidth = t * s.deviation / std::sqrt( ( double )samples.size() );
+    }
+    return s;
+}
+
+
+void ScenarioRace::eliminate_dominated() {
+    // the best scenario is the one whose mean is certainly the lowest, by its upper bound
+    double best_upper = std::numeric_limits<double>::infinity();
+    for( std::map<int, Entry>::const_iterator it = entries_.begin(); it != entries_.end(); ++it ) {
+        if( !it->second.eliminated && ( int )it->second.samples.size() >= options_.minIterations ) {
+            best_upper = std::min( best_upper, statistics( it->first ).upper() );
+        }
+    }
+
+    for( std::map<int, Entry>::iterator it = entries_.begin(); it != entries_.end(); ++it ) {
+        if( !it->second.eliminated && ( int )it->second.samples.size() >= options_.minIterations
+            && statistics( it->first ).lower() > best_upper ) {
+            it->second.eliminated = true;
+        }
+    }
+}
+
+
+bool ScenarioRace::needs_samples( int          scenario_id,
+                                  const Entry& e ) const {
+    if( e.eliminated ) {
+        return false;
+    }
+    if( ( int )e.samples.size() < options_.minIterations ) {
+        return true;
+    }
+    if( ( int )e.samples.size() >= options_.maxIterations ) {
+        return false;
+    }
+
+    // a scenario that is alone in the race has won it
+    int contenders = 0;
+    for( std::map<int, Entry>::const_iterator it = entries_.begin(); it != entries_.end(); ++it ) {
+        contenders += !it->second.eliminated;
+    }
+    if( contenders < 2 ) {
+        return false;
+    }
+
+    // the remaining scenarios overlap with the best one, resolve them up to the indifference
+    ScenarioStatistics s = statistics( scenario_id );
+    return s.halfWidth > options_.indifference * std::fabs( s.mean );
+}
+
+
+std::vector<int> ScenarioRace::scenarios_to_run() const {
+    std::vector<int> ids;
+    for( std::map<int, Entry>::const_iterator it = entries_.begin(); it != entries_.end(); ++it ) {
+        if( needs_samples( it->first, it->second ) ) {
+            ids.push_back( it->first );
+        }
+    }
+    return ids;
+}
+
+
+bool ScenarioRace::eliminated( int scenario_id ) const {
+    return entry( scenario_id ).eliminated;
+}
+
+
+int ScenarioRace::leader() const {
+    int    leader = -1;
+    double mean   = std::numeric_limits<double>::infinity();
+    for( std::map<int, Entry>::const_iterator it = entries_.begin(); it != entries_.end(); ++it ) {
+        if( !it->second.samples.empty() && statistics( it->first ).mean < mean ) {
+            leader = it->first;
+            mean   = statistics( it->first ).mean;
+        }
+    }
+    return leader;
+}
+
+
+int ScenarioRace::median_sample( int scenario_id ) const {
+    const std::vector<double>& samples = entry( scenario_id ).samples;
+    if( samples.empty() ) {
+        return -1;
+    }
+    std::vector<double> sorted( samples );
+    std::nth_element( sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end() );
+    double median = sorted[ sorted.size() / 2 ];
+
+    int closest = 0;
+    for( size_t i = 1; i < samples.size(); i++ ) {
+        if( std::fabs( samples[ i ] - median ) < std::fabs( samples[ closest ] - median ) ) {
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+
+int ScenarioRace::samples() const {
+    int total = 0;
+    for( std::map<int, Entry>::const_iterator it = entries_.begin(); it != entries_.end(); ++it ) {
+        total += it->second.samples.size();
+    }
+    return total;
+}
+
+
+const std::vector<double>& ScenarioRace::sample_values( int scenario_id ) const {
+    return entry( scenario_id ).samples;
+}
@@ -0,0 +1,165 @@
+/**
+   @file    agent_layout_main.cc
+   @ingroup Frontend
+   @brief   Offline planner of the agent hierarchy for a given job geometry
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "AgentHierarchyPlanner.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static void usage( const char* app ) {
+    AgentCostModel model;
+    fprintf( stderr, "Usage: %s <options>\n", app );
+    fprintf( stderr, "  [--nodes=n]              (Number of nodes, default=1)\n" );
+    fprintf( stderr, "  [--ppn=n]                (Processes per node, default=1)\n" );
+    fprintf( stderr, "  [--mapping=file]         (One line per process: node [volume]; replaces --nodes/--ppn)\n" );
+    fprintf( stderr, "  [--volume=units]         (Measurement volume per process, default=1)\n" );
+    fprintf( stderr, "  [--maxcluster=n]         (Fix the processes per analysis agent)\n" );
+    fprintf( stderr, "  [--maxfan=n]             (Fix the children per high-level agent)\n" );
+    fprintf( stderr, "  [--aa-startup=s]         (Analysis agent fixed cost, default=%g)\n", model.aaStartup );
+    fprintf( stderr, "  [--aa-per-unit=s]        (Analysis agent cost per volume unit, default=%g)\n", model.aaPerUnit );
+    fprintf( stderr, "  [--hl-startup=s]         (High-level agent fixed cost, default=%g)\n", model.hlStartup );
+    fprintf( stderr, "  [--hl-per-child=s]       (High-level agent cost per child, default=%g)\n", model.hlPerChild );
+    fprintf( stderr, "  [--hl-per-unit=s]        (High-level agent cost per volume unit, default=%g)\n", model.hlPerUnit );
+    fprintf( stderr, "  [--reduction=f]          (Volume fraction forwarded by a high-level agent, default=%g)\n", model.reduction );
+}
+
+
+int main( int   argc,
+          char* argv[] ) {
+    static const struct option long_opts[] =
+    {
+        { "help",         no_argument,       0, 'a' },
+        { "nodes",        required_argument, 0, 'b' },
+        { "ppn",          required_argument, 0, 'c' },
+        { "mapping",      required_argument, 0, 'd' },
+        { "volume",       required_argument, 0, 'e' },
+        { "maxcluster",   required_argument, 0, 'f' },
+        { "maxfan",       required_argument, 0, 'g' },
+        { "aa-startup",   required_argument, 0, 'h' },
+        { "aa-per-unit",  required_argument, 0, 'i' },
+        { "hl-startup",   required_argument, 0, 'j' },
+        { "hl-per-child", required_argument, 0, 'k' },
+        { "hl-per-unit",  required_argument, 0, 'l' },
+        { "reduction",    required_argument, 0, 'm' },
+        { 0,              0,                 0, 0   }
+    };
+
+    AgentCostModel model;
+    long           nodes      = 1;
+    long           ppn        = 1;
+    double         volume     = 1.0;
+    long           maxcluster = 0;
+    long           maxfan     = 0;
+    std::string    mapping;
+
+    int result;
+    while( ( result = getopt_long( argc, argv, "", long_opts, NULL ) ) != -1 ) {
+        switch( result ) {
+        case 'b':
+            nodes = atol( optarg );
+            break;
+        case 'c':
+            ppn = atol( optarg );
+            break;
+        case 'd':
+            mapping = optarg;
+            break;
+        case 'e':
+            volume = atof( optarg );
+            break;
+        case 'f':
+            maxcluster = atol( optarg );
+            break;
+        case 'g':
+            maxfan = atol( optarg );
+            break;
+        case 'h':
+            model.aaStartup = atof( optarg );
+            break;
+        case 'i':
+            model.aaPerUnit = atof( optarg );
+            break;
+        case 'j':
+            model.hlStartup = atof( optarg );
+            break;
+        case 'k':
+            model.hlPerChild = atof( optarg );
+            break;
+        case 'l':
+            model.hlPerUnit = atof( optarg );
+            break;
+        case 'm':
+            model.reduction = atof( optarg );
+            break;
+        default:
+            usage( argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    if( nodes <= 0 || ppn <= 0 || maxcluster < 0 || maxfan < 0 ) {
+        usage( argv[ 0 ] );
+        return 1;
+    }
+
+    AgentHierarchyPlanner planner( model );
+    if( !mapping.empty() ) {
+        std::ifstream in( mapping.c_str() );
+        if( in.fail() ) {
+            std::cerr << "Cannot open process mapping " << mapping << "\n";
+            return 1;
+        }
+        std::string line;
+        while( std::getline( in, line ) ) {
+            std::istringstream fields( line );
+            std::string        node;
+            double             units;
+            if( fields >> node ) {
+                planner.addProcess( node, fields >> units ? units : volume );
+            }
+        }
+    }
+    else {
+        for( long n = 0; n < nodes; n++ ) {
+            std::stringstream node;
+            node << "node" << n;
+            for( long p = 0; p < ppn; p++ ) {
+                planner.addProcess( node.str(), volume );
+            }
+        }
+    }
+
+    if( planner.processes() == 0 ) {
+        std::cerr << "No processes given\n";
+        return 1;
+    }
+
+    AgentHierarchyPlan plan = planner.plan( maxcluster, maxfan );
+    std::cout << "Planned hierarchy\n";
+    planner.print( std::cout, plan );
+
+    // the defaults the frontend used before the planner, for comparison
+    AgentHierarchyPlan fixed = planner.predict( maxcluster > 0 ? maxcluster : 128, maxfan > 0 ? maxfan : 4 );
+    std::cout << "\nDefault hierarchy\n";
+    planner.print( std::cout, fixed );
+
+    return 0;
+}
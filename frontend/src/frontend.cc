@@ -36,6 +36,7 @@
 #include "frontend_accl_handler.h"
 #include "frontend_statemachine.h"
 
+#include <algorithm>
 #include <ctime>
 #include <cmath>
 #include <map>
@@ -99,6 +100,8 @@ PeriscopeFrontend::PeriscopeFrontend( ACE_Reactor* r ) :
     started_agents_count    = 0;
     agent_hierarchy_started = false;
     tuning_plugin_executed  = false;
+    keep_properties         = true;
+    ensemble                = NULL;
 }
 
 void PeriscopeFrontend::terminate_autotune() {
@@ -227,11 +230,17 @@ void PeriscopeFrontend::run() {
         exit( 0 );
     }
 
+    // the report prints at most --nrprops properties, keep no more than that
+    property_store.setReportLimit( opts.has_nrprops ? std::max( opts.nrprops, 0 ) : 50 );
+
     // We branch here to start the autotune state machine
     if( opts.has_strategy && !strcmp( opts.strategy, "tune" ) ) {
+        keep_properties = true;
         run_tuning_plugin( reactor );
     }
     else {
+        // a plain analysis only reports and exports, which the property store does on the fly
+        keep_properties = opts.has_scalability_OMP;
         run_analysis( reactor );
     }
 }
@@ -277,6 +286,13 @@ void PeriscopeFrontend::run_tuning_plugin( ACE_Reactor* reactor ) {
                         atmsm.process_event( define_experiment() );
                         atmsm.process_event( consider_restart( this, reactor, starter,
                                                                this->plugin_context->search_step ) );
+                        // an ensemble evaluates the experiments of all its slots in one round
+                        while( ensemble_slot_idle() && !frontend_pool_set->psp->empty() ) {
+                            this->plugin_context->experiment_count++;
+                            atmsm.process_event( define_experiment() );
+                            atmsm.process_event( consider_restart( this, reactor, starter,
+                                                                   this->plugin_context->search_step ) );
+                        }
                         do {
                             atmsm.process_event( run_phase_experiments( this, reactor, starter,
                                                                         this->plugin_context->search_step,
@@ -292,7 +308,7 @@ void PeriscopeFrontend::run_tuning_plugin( ACE_Reactor* reactor ) {
                                             "Scenarios NOT executed\n" );
                             }
                         }
-                        while( !scenarios_executed );
+                        while( !scenarios_executed || scenario_race_running() );
 
                         psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ),
                                     "Prepared scenario pool empty = %d\n",
@@ -365,7 +381,13 @@ void PeriscopeFrontend::run_analysis( ACE_Reactor* reactor ) {
 
 #ifndef _BGP_PORT_HEARTBEAT_V1
     set_timer( 2, 1, timeout_delta(), PeriscopeFrontend::STARTUP );
+#else
+    // the heartbeats count the started processes until the search starts
+    startup_mode_on();
 #endif
+    if( heartbeats_.getDeadline() > 0 ) {
+        start_liveness( heartbeats_.interval() );
+    }
     reactor->run_event_loop();
     int max_runs = 40;
 
@@ -409,6 +431,7 @@ void PeriscopeFrontend::run_analysis( ACE_Reactor* reactor ) {
         reactor->register_handler( 0, this, ACE_Event_Handler::READ_MASK );
         reactor->register_handler( SIGINT, this );
         //psc_dbgmsg(1, "REINIT: run reactor\n");
+        heartbeats_.restart( psc_wall_time() );
         set_timer( 2, 1, timeout_delta(), PeriscopeFrontend::STARTUP_REINIT );
 
         reactor->run_event_loop();
@@ -521,22 +544,31 @@ void PeriscopeFrontend::add_started_agent() {
 }
 
 // increases the number of started agents and if it equals to the total amount issues start command
-// this version is used in the BGP style launchers
+// this version is used in the BGP style launchers; the processes were recorded in the heartbeat monitor by the caller
 void PeriscopeFrontend::add_started_agent( int num_procs ) {
     started_agents_count++;
-    ranks_started += num_procs;
-    if( num_procs != 0 ) {
-        psc_dbgmsg( 0, "Heartbeat received: (%d mpi processes out of %d ready for analysis)\n", ranks_started, get_mpinumprocs() );
+    update_started_processes();
+}
+
+// the connected processes are those of the latest heartbeat summaries of the children, which the
+// high-level agents send for their whole subtree instead of forwarding every single heartbeat
+void PeriscopeFrontend::update_started_processes() {
+    int processes = heartbeats_.summary( psc_wall_time() ).processes;
+    if( processes == ranks_started ) {
+        return;
     }
+    ranks_started = processes;
+    // every instance of an ensemble runs the same number of processes
+    int expected = get_mpinumprocs() * ( get_ensemble() ? get_ensemble()->size() : 1 );
+    psc_dbgmsg( 0, "Heartbeat received: (%d mpi processes out of %d ready for analysis)\n", ranks_started, expected );
 
-    if( ranks_started == get_mpinumprocs() ) {
+    if( ranks_started == expected && !agent_hierarchy_started ) {
         psc_dbgmsg( 6, "Agent network UP and RUNNING. Starting search.\n\n" );
         psc_dbgmsg( 6, "Agent network started in %5.1f seconds\n", psc_wall_time() );
 
-        if( !agent_hierarchy_started ) {
-            agent_hierarchy_started = true;
-            fe->set_startup_time( psc_wall_time() );
-        }
+        agent_hierarchy_started = true;
+        fe->set_startup_time( psc_wall_time() );
+        startup_mode_off();
 
         if( automatic_mode ) {
             start();
@@ -553,6 +585,31 @@ void PeriscopeFrontend::remove_started_agent() { // increases the number of star
     psc_dbgmsg( FRONTEND_HIGH_DEBUG_LEVEL, "One agent was dismissed\n" );
 }
 
+void PeriscopeFrontend::liveness_tick() {
+    double now = psc_wall_time();
+    // the direct children that failed cannot be told to quit
+    std::vector< std::string > failed = heartbeats_.overdue( now );
+    PeriscopeAgent::liveness_tick();
+
+    SubtreeHeartbeat summary = heartbeats_.summary( now );
+    if( quit_fe || summary.missing.empty() ) {
+        return;
+    }
+
+    std::string missing;
+    for( size_t i = 0; i < summary.missing.size(); i++ ) {
+        missing += ( i ? ", " : "" ) + summary.missing[ i ];
+    }
+    psc_errmsg( "No heartbeat within %.0f seconds from the agent subtrees of %s; %d of %d agents with %d processes are left, terminating\n",
+                heartbeats_.getDeadline(), missing.c_str(), summary.agents, summary.expected, summary.processes );
+
+    for( size_t i = 0; i < failed.size(); i++ ) {
+        child_agents_.erase( failed[ i ] );
+        heartbeats_.forget( failed[ i ] );
+    }
+    quit();
+}
+
 int PeriscopeFrontend::handle_timeout( const ACE_Time_Value& time,
                                        const void*           arg ) {
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ACECommunication ),
@@ -1008,7 +1065,7 @@ void PeriscopeFrontend::start() {
     serializedStrategyRequest = get_SerializedStrategyRequestBuffer();
 
 //RM: Should be cleaned up here and moved into run handle for both analysis and tuning.
-    if( serializedStrategyRequest.size() == 0 ) {
+    if( serializedStrategyRequest.size() == 0 && childStrategyRequestBuffers.empty() ) {
         fe->stop();
         return;
     }
@@ -1021,13 +1078,21 @@ void PeriscopeFrontend::start() {
     for( it = child_agents_.begin(); it != child_agents_.end(); it++ ) {
         AgentInfo& ag = it->second;
 
+        // the master agent of an instance of an ensemble gets the request of its slot
+        std::map<std::string, std::vector<char> >::iterator own     = childStrategyRequestBuffers.find( it->first );
+        std::vector<char>&                                  request = own != childStrategyRequestBuffers.end() ? own->second : serializedStrategyRequest;
+        if( request.empty() ) {
+            psc_errmsg( "No strategy request for child %s\n", it->first.c_str() );
+            continue;
+        }
+
         if( ag.status != AgentInfo::CONNECTED ) {
             if( connect_to_child( &ag ) == -1 ) {
                 psc_errmsg( "Error connecting to child\n" );
                 abort();
             }
             else {
-                ag.handler->start( serializedStrategyRequest.size(), ( unsigned char* )&serializedStrategyRequest[ 0 ] );
+                ag.handler->start( request.size(), ( unsigned char* )&request[ 0 ] );
             }
 
             ag.properties_sent = false;
@@ -1035,6 +1100,7 @@ void PeriscopeFrontend::start() {
     }
 
     strategyRequestBuffer.clear();
+    childStrategyRequestBuffers.clear();
 }
 
 void PeriscopeFrontend::stop_agents_for_calltree() {
@@ -1220,6 +1286,11 @@ void PeriscopeFrontend::terminate_agent_hierarchy() {
     fe->set_agent_hierarchy_started( false );
 }
 
+//Identity under which a property is matched across the runs with different thread counts
+static ScalabilityKey scalability_key( const PropertyInfo& info ) {
+    return ScalabilityKey( info.name, info.process, info.RFL, info.fileid );
+}
+
 /**
  * @brief Pre-analysis for scalability tests in OpenMP codes
  *
@@ -1231,7 +1302,6 @@ void PeriscopeFrontend::do_pre_analysis() {
     properties_.clear();
     property.clear();
     property_threads.clear();
-    p_threads.clear();
     PhaseTime_user.clear();
     std::list<PropertyInfo>::iterator prop_it;
 
@@ -1395,8 +1465,7 @@ void PeriscopeFrontend::export_scalability_properties() {
 //        std::cout << std::endl;
         //Export all properties other than exectime::::: properties to .psc file
         for( p_it = properties_.begin(); p_it != properties_.end(); ++p_it ) {
-            string::size_type p_loc = ( ( *p_it ).name ).find( ":::::", 0 );
-            if( false && p_loc != string::npos ) {
+            if( false && ( *p_it ).internal ) {
                 ;
             }
             else {
@@ -1418,9 +1487,8 @@ void PeriscopeFrontend::export_scalability_properties() {
                             << "\t<confidence>" << double( ( *p_it ).confidence )
                             << "</confidence>\n  \t<addInfo>\n  " << "\t\t";
                     xmlfile << ( *p_it ).addInfo;
-                    string::size_type p_loc = ( ( *p_it ).name ).find( ":::::", 0 );
 
-                    if( p_loc != string::npos ) {
+                    if( ( *p_it ).internal ) {
                         xmlfile << "\t<exectime>" << ( p_it->execTime / NANOSEC_PER_SEC_DOUBLE ) << "s </exectime> ";
                     }
 
@@ -1477,8 +1545,7 @@ void PeriscopeFrontend::export_scalability_properties() {
         //Export PropertyInfo from existing property list to properties.psc file
         //Different approach for printing properties
         for( prop_it = existing_properties.begin(); prop_it != existing_properties.end(); ++prop_it ) {
-            string::size_type e_loc = ( ( *prop_it ).name ).find( ":::::", 0 );
-            if( e_loc != string::npos ) {
+            if( ( *prop_it ).internal ) {
                 ;
             }
             else {
@@ -1844,40 +1911,36 @@ void PeriscopeFrontend::Check_severity_among_parallel_regions( int config ) {
 
 //This function find the sequential time for the forwarded existing property
 long double PeriscopeFrontend::find_sequential_time( PropertyInfo prop_info ) {
-    std::list<PropertyInfo>::iterator seq_it;
+    const std::vector<size_t>& positions = properties_index.positions( scalability_key( prop_info ) );
 
-    string region_t  = prop_info.region;
-    string ID_t      = prop_info.ID;
-    string name_t    = prop_info.name;
-    double process_t = prop_info.process;
-    double RFL_t     = prop_info.RFL;
-    int    fileid_t  = prop_info.fileid;
-
-
-    //Check all the properties and if it identifies the same property, return its execution time.
-    for( seq_it = properties_.begin(); seq_it != properties_.end(); ++seq_it ) {
-        if( region_t == ( *seq_it ).region && process_t == ( *seq_it ).process
-            && RFL_t == ( *seq_it ).RFL && fileid_t == ( *seq_it ).fileid
-            && ID_t == ( *seq_it ).ID && name_t == ( *seq_it ).name ) {
-            return ( *seq_it ).execTime;
-        }
-        else {
-            ;
+    //Check the properties with the same identity and if it identifies the same property, return its execution time.
+    for( size_t i = 0; i < positions.size(); i++ ) {
+        const PropertyInfo* seq_it = indexed_properties[ positions[ i ] ];
+        if( prop_info.region == seq_it->region && prop_info.ID == seq_it->ID ) {
+            return seq_it->execTime;
         }
     }
     return 0.0;
 }
 
-//This function copies properties from thread 2
+//This function copies properties from thread 2 and indexes them for the analysis
 void PeriscopeFrontend::copy_properties_for_analysis() {
     std::list<PropertyInfo>::iterator copy_it;
 
+    properties_index.clear();
+    indexed_properties.clear();
+    threads_index.clear();
+    indexed_threads.clear();
+
     //Check all the properties and add in the list if the threads are above 2
     //Required because the OpenMP properties show up only after thread no. 2
     for( copy_it = properties_.begin(); copy_it != properties_.end(); ++copy_it ) {
+        properties_index.add( scalability_key( *copy_it ), ( *copy_it ).maxThreads );
+        indexed_properties.push_back( &( *copy_it ) );
         if( ( *copy_it ).maxThreads > 1 ) {
             property_threads.push_back( *copy_it );
-            p_threads.push_back( *copy_it );
+            threads_index.add( scalability_key( property_threads.back() ), ( *copy_it ).maxThreads );
+            indexed_threads.push_back( &property_threads.back() );
         }
         else {
             ;
@@ -1887,50 +1950,32 @@ void PeriscopeFrontend::copy_properties_for_analysis() {
 
 //This function identifies the existing_properties among threads
 void PeriscopeFrontend::find_existing_properties() {
-    std::list<PropertyInfo>::iterator prop_it, prop_itr;
+    std::list<PropertyInfo>::iterator prop_it;
     existing_properties.clear();
     int initial_thread = 2;
 
     std::cout << std::endl;
-    long int count = 0;
-    for( prop_it = property_threads.begin(); prop_it != property_threads.end(); ++prop_it ) {
+    size_t position = 0;
+    for( prop_it = property_threads.begin(); prop_it != property_threads.end(); ++prop_it, position++ ) {
         //surf within property infos...
         //fixing on one propertyInfo, check if we have to include in the list of properties or not.
-        count++;
         if( ( *prop_it ).maxThreads == initial_thread ) {
-            string temp_region     = ( *prop_it ).region;
-            string temp_name       = ( *prop_it ).name;
-            double temp_severity   = double( ( *prop_it ).severity );
-            double temp_process    = ( *prop_it ).process;
-            int    temp_maxThreads = ( *prop_it ).maxThreads;
-            double temp_RFL        = ( *prop_it ).RFL;
-            int    temp_fileid     = ( *prop_it ).fileid;
+            ScalabilityKey key = scalability_key( *prop_it );
 
             long int count_scaled = 0;
             for( int th_number = initial_thread; th_number <= fe->get_ompfinalthreads(); th_number += th_number ) {
-                long int count_in = 0;
-                for( prop_itr = p_threads.begin(); prop_itr != p_threads.end(); ++prop_itr ) {
-                    //after storing details, go through all the properties from the point of comparison to compare
-                    //and determine whether that property should be in the list of scalable properties
-                    count_in++;                                 //
-                    if( temp_name == ( *prop_itr ).name && temp_process == ( *prop_itr ).process
-                        && temp_RFL == ( *prop_itr ).RFL && count_in >= count && temp_fileid == ( *prop_itr ).fileid &&
-                        ( *prop_itr ).maxThreads == th_number && ( *prop_itr ).maxThreads != 1 ) {
-                        //For existing_properties checks process here
-                        count_scaled++;
-                        if( ( count_scaled + 1 ) >= fe->get_maxiterations() ) {
-                            string::size_type loc = ( ( *prop_it ).name ).find( ":::::", 0 );
-                            if( loc != string::npos ) {
-                                ;
-                            }
-                            else {
-                                existing_properties.push_back( *prop_it );
-                            }
+                //determine whether the property shows up again from the point of comparison on
+                //with this thread number, which makes it a candidate for the list of scalable properties
+                if( threads_index.find( key, th_number, position ) != ScalabilityIndex::npos ) {
+                    //For existing_properties checks process here
+                    count_scaled++;
+                    if( ( count_scaled + 1 ) >= fe->get_maxiterations() ) {
+                        if( ( *prop_it ).internal ) {
+                            ;
+                        }
+                        else {
+                            existing_properties.push_back( *prop_it );
                         }
-                        break;                         //need not check for other properties in that thread number
-                    }
-                    else {
-                        ;
                     }
                 }
             }
@@ -1970,21 +2015,13 @@ std::string PeriscopeFrontend::convertInt( int number ) {
 void PeriscopeFrontend::do_speedup_analysis( PropertyInfo       prop,
                                              long double        seq_time,
                                              const std::string& phase_region ) {
-    std::list<PropertyInfo>::iterator prop_itr;
     std::list<long double>::iterator  rt_it;
     std::list<long double>            temp_PhaseTime;
     temp_PhaseTime.clear();
 
-    string      temp_region                = prop.region;
-    string      temp_name                  = prop.name;
-    double      temp_severity              = double( prop.severity );
-    double      temp_process               = prop.process;
-    int         temp_maxThreads            = prop.maxThreads;
-    double      temp_RFL                   = prop.RFL;
-    double      severity_for_initialthread = 0.0;
-    long double PhaseTime                  = 0.0;
-    int         temp_fileid                = prop.fileid;
-    string      temp_ID                    = prop.ID;
+    ScalabilityKey key                        = scalability_key( prop );
+    double         severity_for_initialthread = 0.0;
+    long double    PhaseTime                  = 0.0;
 
     int count_scaled   = 0;
     int count_execTime = 0;
@@ -2037,16 +2074,14 @@ void PeriscopeFrontend::do_speedup_analysis( PropertyInfo       prop,
             ;
         }
 
-        for( prop_itr = property_threads.begin(); prop_itr != property_threads.end(); ++prop_itr ) {
+        //the first property of this thread number with the same identity and ID
+        const std::vector<size_t>& positions = threads_index.positions( key, th_number );
+        for( size_t i = 0; i < positions.size(); i++ ) {
+            const PropertyInfo* prop_itr = indexed_threads[ positions[ i ] ];
             need_not_list = false;
-            if( temp_process == ( *prop_itr ).process && temp_fileid == ( *prop_itr ).fileid
-                && temp_RFL == ( *prop_itr ).RFL && ( *prop_itr ).maxThreads == th_number
-                && ( *prop_itr ).maxThreads != 1 && temp_name == ( *prop_itr ).name
-                && ( *prop_itr ).ID == temp_ID ) {
+            if( prop_itr->ID == prop.ID ) {
                 //We don't need to add the property relating to execTime
-                string            p_name = ( *prop_itr ).name;
-                string::size_type loc    = p_name.find( ":::::", 0 );
-                if( loc != string::npos ) {
+                if( ( *prop_itr ).internal ) {
                     need_not_list = true;
                 }
                 else {
@@ -2109,17 +2144,12 @@ void PeriscopeFrontend::do_speedup_analysis( PropertyInfo       prop,
 
 
                 //Speedup property requirements
-                speedup_prop = ( long double )initial_execTime / ( double )( *prop_itr ).execTime;
-
-                int    rounded_speedup = speedup_prop;
-                double decimal_val     = ( double )speedup_prop - rounded_speedup;
-
-                if( decimal_val > 0.5 ) {
-                    rounded_speedup++;
-                }
-                else {
-                    ;
-                }
+                ScalabilityPoint point = scalability_point( initial_execTime, ( *prop_itr ).execTime, th_number );
+                speedup_prop = point.speedup;
+                int rounded_speedup = point.roundedSpeedup;
+                psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AnalysisProperty ),
+                            "Scalability of %s at %d:%g with %d threads: speedup %g, efficiency %g\n",
+                            prop.region.c_str(), prop.fileid, prop.RFL, th_number, point.speedup, point.efficiency );
 
                 //Store the execution time & deviation time for regions
                 execTime_regions[ th_number ] = ( *prop_itr ).execTime;
@@ -2129,12 +2159,7 @@ void PeriscopeFrontend::do_speedup_analysis( PropertyInfo       prop,
                 else {
                     ;
                 }
-                if( ( ( *prop_itr ).execTime ) - ( initial_execTime / th_number ) > 0 ) {
-                    deviationTime[ th_number ] = ( ( *prop_itr ).execTime ) - ( initial_execTime / th_number );
-                }
-                else {
-                    deviationTime[ th_number ] = 0.0;
-                }
+                deviationTime[ th_number ] = point.deviation;
 
                 //Converting double to string
                 std::ostringstream sstream;
@@ -2404,6 +2429,7 @@ void PeriscopeFrontend::get_prop_info( MetaProperty& prop ) {
     info.maxThreads = prop.getMaxThreads();
     info.maxProcs   = prop.getMaxProcs();
     info.purpose    = prop.getPurpose();
+    info.internal   = prop.isInternal();
 
     //To find info.execTime
     addInfoType                 addInfo          = prop.getExtraInfo();
@@ -2466,11 +2492,6 @@ std::ostream& operator<<( std::ostream&       os,
     return os;
 }
 
-bool sevComparator( MetaProperty p1,
-                    MetaProperty p2 ) {
-    return p1.getSeverity() > p2.getSeverity();
-}
-
 /**
  * @brief Prints all found properties
  *
@@ -2492,90 +2513,85 @@ void PeriscopeFrontend::properties() {
                   << "Severity\t" << "Description" << std::endl;
         std::cout << "-------------------------------------------------------------------------------\n";
 
-        //metaproperties_.sort(sevComparator);
-        std::sort( metaproperties_.begin(), metaproperties_.end(), sevComparator );
-
-        //for(std::list<MetaProperty>::iterator it = metaproperties_.begin(); ( it != metaproperties_.end() && limitProps > 0) ; it++, limitProps-- ){
-        for( int i = 0; i < metaproperties_.size() && limitProps > 0; i++, limitProps-- ) {
-            string            prop_string = ( metaproperties_[ i ] ).toString();
-            string::size_type p_loc       = prop_string.find( ":::::", 0 );
-            // Exclude internal properties used to calculate the execution time for the scalability analysis
-            if( p_loc != string::npos ) {
-                ;
-            }
-            else {
-                std::cout << prop_string << std::endl;
-            }
+        // the store keeps the most severe properties only, internal ones are never among them
+        std::vector<MetaProperty> top = property_store.top();
+        for( int i = 0; i < top.size() && limitProps > 0; i++, limitProps-- ) {
+            std::cout << top[ i ].toString() << std::endl;
         }
         //prompt();
     }
 }
 
+/**
+ * @brief Start streaming the found properties to the output file
+ *
+ * Writes the experiment header to the output file and hands it to the property store, which
+ * appends every property as it arrives.
+ */
+bool PeriscopeFrontend::open_property_file() {
+    std::stringstream header;
+
+    time_t rawtime;
+    tm*    timeinfo;
+    time( &rawtime );
+    timeinfo = localtime( &rawtime );
+
+    header << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+    header << "<Experiment xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
+        "xmlns=\"http://www.lrr.in.tum.de/Periscope\" "
+        "xsi:schemaLocation=\"http://www.lrr.in.tum.de/Periscope psc_properties.xsd \">"
+           << std::endl << std::endl;
+
+    header << std::setfill( '0' );
+    header << "  <date>" << std::setw( 4 ) << ( timeinfo->tm_year + 1900 )
+           << "-" << std::setw( 2 ) << timeinfo->tm_mon + 1 << "-" << std::setw( 2 )
+           << timeinfo->tm_mday << "</date>" << std::endl;
+    header << "  <time>" << std::setw( 2 ) << timeinfo->tm_hour << ":"
+           << std::setw( 2 ) << timeinfo->tm_min << ":" << std::setw( 2 )
+           << timeinfo->tm_sec << "</time>" << std::endl;
+
+    header << "  <numProcs>" << opts.mpinumprocs_string << "</numProcs>" << std::endl;
+    header << "  <numThreads>" << opts.ompnumthreads_string << "</numThreads>" << std::endl;
+
+    // Wording directory for the experiment: can be used to find the data file(s)
+    char* cwd = getenv( "PWD" );
+    header << "  <dir>" << cwd << "</dir>" << std::endl;
+    // Source revision
+    if( opts.has_srcrev ) {
+        // Source revision
+        header << "  <rev>" << opts.srcrev << "</rev>" << std::endl;
+    }
+    // Empty line before the properties
+    header << std::endl;
+
+    return property_store.spillTo( fe->get_outfilename(), header.str() );
+}
+
 /**
  * @brief Export all found properties to a file
  *
  * Exports all found properties to a file in XML format.
  * The filename can be specified using the --propfile command argument.
+ * The properties were already streamed to the file while they arrived,
+ * only the end of the document is missing.
  */
 void PeriscopeFrontend::export_properties() {
-    std::string   propfilename = fe->get_outfilename();
-    std::ofstream xmlfile( propfilename.c_str() );
-
-    if( !xmlfile && opts.has_propfile ) {
-        std::cout << "Cannot open xmlfile. \n";
-        exit( 1 );
-    }
-
-    if( xmlfile ) {
-        psc_infomsg( "Exporting results to %s\n", propfilename.c_str() );
-
-        time_t rawtime;
-        tm*    timeinfo;
-        time( &rawtime );
-        timeinfo = localtime( &rawtime );
-
-        xmlfile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
-        xmlfile << "<Experiment xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
-            "xmlns=\"http://www.lrr.in.tum.de/Periscope\" "
-            "xsi:schemaLocation=\"http://www.lrr.in.tum.de/Periscope psc_properties.xsd \">"
-                << std::endl << std::endl;
-
-        xmlfile << std::setfill( '0' );
-        xmlfile << "  <date>" << std::setw( 4 ) << ( timeinfo->tm_year + 1900 )
-                << "-" << std::setw( 2 ) << timeinfo->tm_mon + 1 << "-" << std::setw( 2 )
-                << timeinfo->tm_mday << "</date>" << std::endl;
-        xmlfile << "  <time>" << std::setw( 2 ) << timeinfo->tm_hour << ":"
-                << std::setw( 2 ) << timeinfo->tm_min << ":" << std::setw( 2 )
-                << timeinfo->tm_sec << "</time>" << std::endl;
-
-        xmlfile << "  <numProcs>" << opts.mpinumprocs_string << "</numProcs>" << std::endl;
-        xmlfile << "  <numThreads>" << opts.ompnumthreads_string << "</numThreads>" << std::endl;
+    std::string propfilename = fe->get_outfilename();
 
-        // Wording directory for the experiment: can be used to find the data file(s)
-        char* cwd = getenv( "PWD" );
-        xmlfile << "  <dir>" << cwd << "</dir>" << std::endl;
-        // Source revision
-        if( opts.has_srcrev ) {
-            // Source revision
-            xmlfile << "  <rev>" << opts.srcrev << "</rev>" << std::endl;
+    if( !property_store.spilling() && !open_property_file() ) {
+        if( opts.has_propfile ) {
+            std::cout << "Cannot open xmlfile. \n";
+            exit( 1 );
         }
-        // Empty line before the properties
-        xmlfile << std::endl;
+        return;
+    }
 
-        for( int i = 0; i < metaproperties_.size(); i++ ) {
-            string            prop_string = ( metaproperties_[ i ] ).toString();
-            string::size_type p_loc       = prop_string.find( ":::::", 0 );
-            // Exclude internal properties used to calculate the execution time for the scalability analysis
-            if( p_loc != string::npos ) {
-                ;
-            }
-            else {
-                xmlfile << ( metaproperties_[ i ] ).toXML();
-            }
-        }
-        xmlfile << "</Experiment>" << std::endl;
+    psc_infomsg( "Exporting results to %s\n", propfilename.c_str() );
+    psc_dbgmsg( 1, "%lu properties received, %lu exported, %lu internal\n", property_store.received(),
+                property_store.spilled(), property_store.internal() );
+    if( !property_store.finish( "</Experiment>\n" ) ) {
+        psc_errmsg( "Error writing %s\n", propfilename.c_str() );
     }
-    xmlfile.close();
 }
 
 /**
@@ -2652,12 +2668,22 @@ void PeriscopeFrontend::found_property( PropertyInfo& prop ) {
  * @brief Processes the found performance property
  *
  * This method is called whenever a new performance property is found.
- * This new property is added to a list containing all properties.
+ * The property goes to the property store, which streams it to the output
+ * file, and to the full property list if a tuning or scalability run needs it.
  *
  * @param propData    performance property (as string)
  */
 void PeriscopeFrontend::found_property( const std::string& propData ) {
-    metaproperties_.push_back( MetaProperty::fromXMLDeserialize( propData ) );
+    MetaProperty property = MetaProperty::fromXMLDeserialize( propData );
+
+    // the scalability analysis writes its own file
+    if( property_store.received() == 0 && !opts.has_scalability_OMP && !open_property_file() ) {
+        psc_dbgmsg( 1, "Cannot stream the properties to %s yet\n", fe->get_outfilename().c_str() );
+    }
+    property_store.add( property );
+    if( keep_properties ) {
+        metaproperties_.push_back( property );
+    }
 }
 
 /**
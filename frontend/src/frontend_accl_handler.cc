@@ -24,12 +24,25 @@ extern bool restart_requested_for_no_tuning;
 
 int ACCL_Frontend_Handler::on_heartbeat( heartbeat_req_t&   req,
                                          heartbeat_reply_t& reply ) {
+    // periodic summaries of the children's subtrees are no startup events
+    if( req.heartbeat_type == SUBTREE_HEARTBEAT ) {
+        if( fe->subtree_heartbeat( req.tag, req.subtree ) ) {
+#ifdef _BGP_PORT_HEARTBEAT_V1
+            fe->update_started_processes();
+#endif
+        }
+        return 0;
+    }
+
 #ifdef PSC_FRONTEND_ACCL_STATEMACHINE
     statemachine_.process_event( heartbeat_event() );
 #endif
 
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ACECommunication ), "on_heartbeat from host=%s, port=%d, tag=%s, forwarded=%d, num_procs=%d\n", req.hostname.c_str(), req.port, req.tag.c_str(), req.heartbeat_type, req.num_procs );
 
+    // launch latency of the agents started by the frontend; forwarded tags are ignored
+    starter->agentReady( req.tag );
+
     // currently assumed that the child agent is connected only once
 #ifdef _BGP_PORT_HEARTBEAT_V1
     std::map< std::string, AgentInfo >* ca;
@@ -48,9 +61,14 @@ int ACCL_Frontend_Handler::on_heartbeat( heartbeat_req_t&   req,
         if( req.heartbeat_type == OWN_HEARTBEAT ) {
             //if it is not a forwarded heartbeat accept this agent as a direct child agent
             fe->add_child_agent( req.tag, req.hostname, req.port );
+            fe->heartbeats().beat( req.tag, req.num_procs, psc_wall_time() );
+            fe->add_started_agent( req.num_procs );
+        }
+        else {
+            // processes an analysis agent connected to since its own heartbeat
+            fe->heartbeats().addProcesses( req.tag, req.num_procs, psc_wall_time() );
+            fe->update_started_processes();
         }
-
-        fe->add_started_agent( req.num_procs );
 
         break;
     case DISMISS_HEARTBEAT:
@@ -62,6 +80,7 @@ int ACCL_Frontend_Handler::on_heartbeat( heartbeat_req_t&   req,
         if( it != ca->end() ) {
             ca->erase( it );
         }
+        fe->heartbeats().forget( req.tag );
 
         if( ca->size() == 0 ) {
             psc_dbgmsg( FRONTEND_GENERAL_DEBUG_LEVEL, "Ooops, no children are left, no sense to live then, terminating...\n" );
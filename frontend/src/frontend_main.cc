@@ -98,6 +98,8 @@ int parse_opts( int                  argc,
         { "iterations",             required_argument, 0,         'H' },
         { "config-file",            required_argument, 0,         'I' },
         { "input-desc",             required_argument, 0,         'J' },
+        { "heartbeat-deadline",     required_argument, 0,         'K' },
+        { "plan-agents",            no_argument,       0,         'L' },
         0
     };
 
@@ -379,6 +381,17 @@ int parse_opts( int                  argc,
                  psc_dbgmsg( 1, "Parsing input description identifiers: %s\n", opts.input_desc_string );
             }
             break;
+
+        case 'K':
+            if( opt->has_arg == required_argument ) {
+                copts->has_heartbeat = 1;
+                strcpy( copts->heartbeat_string, optarg );
+            }
+            break;
+
+        case 'L':                 // plan the agent hierarchy from the cost model
+            copts->has_plan_agents = 1;
+            break;
 //        case 'I':
 //            if( opt->has_arg == required_argument ) {
 //                copts->has_threads = 1;
@@ -519,8 +532,10 @@ void usage( int   argc,
     fprintf( stderr, "  [--port=n]               (Local port number, optional)\n" );
     fprintf( stderr, "  [--maxfan=n]             (Max. number of child agents, default=%d)\n", maxfan_default );
     fprintf( stderr, "  [--maxcluster=n]         (Max. number of processes controlled by an agent, default=%d)\n", 4 );
+    fprintf( stderr, "  [--plan-agents]          (Plan processes per agent and fan-out from a cost model, see agentHierarchy in the configuration file)\n" );
     fprintf( stderr, "  [--maxthreads=n]         (Max. number of threads assigned to a node agent)\n");
     fprintf( stderr, "  [--timeout=n]            (Timeout for startup of agent hierarchy)\n" );
+    fprintf( stderr, "  [--heartbeat-deadline=n] (Seconds without heartbeat after which an agent subtree is considered dead, off by default)\n" );
     fprintf( stderr, "  [--delay=n]              (Search delay in phase executions)\n" );
     fprintf( stderr, "  [--iterations=n]         (Number of phase executions per experiment)\n" );
     fprintf( stderr, "  [--duration=n]           (Search delay in seconds of phase)\n" );
@@ -308,6 +308,16 @@ void frontend_main_msm::Initializing_::setup_timeouts( setup_timeouts_event cons
     psc_dbgmsg( FRONTEND_HIGH_DEBUG_LEVEL, "Using %d seconds timeout\n", timeout );
     fe->set_global_timeout( timeout );
     fe->set_timeout_delta( timeout );
+
+    if( opts.has_heartbeat ) {
+        double deadline = atof( opts.heartbeat_string );
+        if( deadline < 0 ) {
+            psc_errmsg( "Bad value for heartbeat deadline: %s\n", opts.heartbeat_string );
+            exit( 1 );
+        }
+        psc_dbgmsg( FRONTEND_HIGH_DEBUG_LEVEL, "Using %.0f seconds heartbeat deadline\n", deadline );
+        fe->heartbeats().setDeadline( deadline );
+    }
 }
 
 void frontend_main_msm::Initializing_::setup_application_data( setup_application_data_event const& evt ) {
@@ -1,6 +1,7 @@
 #include "frontend_statemachine.h"
 #include "frontend_main_statemachine.h"
 #include "readex_configuration.h"
+#include "ScenarioRace.h"
 #include <boost/foreach.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
@@ -23,6 +24,16 @@ static StrategyRequest* analysis_strategy_request        = NULL;
 static int              new_properties_index             = 0;
 static bool             analysis_per_experiment_required = false;
 
+// racing of the scenarios of an experiment over several phase iterations
+static ScenarioRace*                                         scenario_race   = NULL;
+static ObjectiveFunction*                                    race_objective  = NULL;
+static int                                                   race_iterations = 0;
+static ScenarioRaceOptions                                   race_options;
+static std::map<int, std::vector<std::list<MetaProperty> > > race_properties;
+
+// requests of the slots of an ensemble, sent to the master agents of their instances
+static std::vector<StrategyRequest*> prepared_slot_requests;
+
 extern int  application_pid;
 extern char user_specified_environment[ 5000 ]; // user-provided environment variables for the starter
 
@@ -69,11 +80,204 @@ void ace_communication_phase( PeriscopeFrontend*             fe,
 }
 
 
+/**
+ * Racing is enabled by a Configuration.periscope.racing section, which may set the confidence,
+ * minIterations, maxIterations and indifference of the race and the objective of the samples:
+ * Energy, Time, EDP or CPUEnergy, otherwise the smallest severity like the default objective of
+ * the search algorithms.
+ */
+static bool racing_configured() {
+    if( !opts.has_configurationfile || !configTree.get_child_optional( "Configuration.periscope.racing" ) ) {
+        return false;
+    }
+    if( race_objective ) {
+        return true;
+    }
+
+    race_options.confidence    = configTree.get( "Configuration.periscope.racing.confidence", race_options.confidence );
+    race_options.minIterations = configTree.get( "Configuration.periscope.racing.minIterations", race_options.minIterations );
+    race_options.maxIterations = configTree.get( "Configuration.periscope.racing.maxIterations", race_options.maxIterations );
+    race_options.indifference  = configTree.get( "Configuration.periscope.racing.indifference", race_options.indifference );
+    race_options.minIterations = std::max( race_options.minIterations, 2 );
+    race_options.maxIterations = std::max( race_options.maxIterations, race_options.minIterations );
+
+    std::string objective = configTree.get( "Configuration.periscope.racing.objective", std::string( "" ) );
+    if( objective == "Energy" ) {
+        race_objective = new EnergyObjective( "" );
+    }
+    else if( objective == "Time" ) {
+        race_objective = new TimeObjective( "" );
+    }
+    else if( objective == "EDP" ) {
+        race_objective = new EDPObjective( "" );
+    }
+    else if( objective == "CPUEnergy" ) {
+        race_objective = new CPUEnergyObjective( "" );
+    }
+    else {
+        race_objective = new PTF_minObjective( "" );
+    }
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ),
+                "Racing scenarios by %s: confidence %f, %d to %d iterations, indifference %f\n",
+                race_objective->getName().c_str(), race_options.confidence, race_options.minIterations,
+                race_options.maxIterations, race_options.indifference );
+    return true;
+}
+
+
+/// Enters the scenarios of a new experiment into a race
+static void start_race( PeriscopeFrontend* fe ) {
+    if( scenario_race || !racing_configured() ) {
+        return;
+    }
+
+    scenario_race   = new ScenarioRace( race_options );
+    race_iterations = 0;
+    race_properties.clear();
+    std::map<int, Scenario*>* scenarios = fe->frontend_pool_set->esp->getScenarios();
+    for( std::map<int, Scenario*>::iterator it = scenarios->begin(); it != scenarios->end(); ++it ) {
+        scenario_race->enter( it->first );
+    }
+}
+
+
+/// Publishes the properties of the median iteration of every scenario, so the objectives see one consistent iteration
+static void finish_race( PeriscopeFrontend* fe,
+                         int                search_step ) {
+    for( std::map<int, std::vector<std::list<MetaProperty> > >::iterator it = race_properties.begin(); it != race_properties.end(); ++it ) {
+        ScenarioStatistics statistics = scenario_race->statistics( it->first );
+        psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ),
+                    "Scenario %d: %d iterations, mean %f +- %f%s\n", it->first, statistics.samples, statistics.mean,
+                    statistics.halfWidth, scenario_race->eliminated( it->first ) ? ", dominated" : "" );
+
+        std::list<MetaProperty>& iteration = it->second[ scenario_race->median_sample( it->first ) ];
+        for( std::list<MetaProperty>::iterator property = iteration.begin(); property != iteration.end(); ++property ) {
+            fe->frontend_pool_set->srp->push( *property, search_step );
+        }
+    }
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ), "Race decided after %d iterations, %d samples\n",
+                race_iterations, scenario_race->samples() );
+
+    delete scenario_race;
+    scenario_race = NULL;
+    race_properties.clear();
+}
+
+
+/// Takes the samples of an iteration and queues the scenarios that need another one
+static void advance_race( PeriscopeFrontend*                       fe,
+                          std::map<int, std::list<MetaProperty> >& iteration,
+                          int                                      search_step ) {
+    race_iterations++;
+    for( std::map<int, std::list<MetaProperty> >::iterator it = iteration.begin(); it != iteration.end(); ++it ) {
+        race_properties[ it->first ].push_back( it->second );
+        scenario_race->add_sample( it->first, race_objective->objective( it->second ) );
+    }
+
+    // a scenario without results would never be decided
+    std::vector<int> next = scenario_race->scenarios_to_run();
+    if( next.empty() || race_iterations >= race_options.maxIterations ) {
+        finish_race( fe, search_step );
+        return;
+    }
+
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ), "Racing: %d scenarios need another iteration, leader %d\n",
+                ( int )next.size(), scenario_race->leader() );
+    for( size_t i = 0; i < next.size(); i++ ) {
+        Scenario* scenario = fe->frontend_pool_set->fsp->pop( next[ i ] );
+        if( scenario ) {
+            fe->frontend_pool_set->esp->push( scenario );
+        }
+    }
+}
+
+
+bool frontend_statemachine::scenario_race_running() {
+    return scenario_race != NULL;
+}
+
+
+/**
+ * An ensemble is enabled by a Configuration.periscope.ensemble section, whose slots give the
+ * number of application instances that run concurrently on shares of the allocation. Every
+ * instance has its own agent subtree and evaluates the scenarios of another experiment.
+ */
+static void configure_ensemble( PeriscopeFrontend* fe ) {
+    if( fe->get_ensemble() || !opts.has_configurationfile || !configTree.get_child_optional( "Configuration.periscope.ensemble" ) ) {
+        return;
+    }
+
+    int slots = configTree.get( "Configuration.periscope.ensemble.slots", 1 );
+    if( slots < 2 ) {
+        return;
+    }
+    if( fe->get_fastmode() ) {
+        psc_errmsg( "Ensembles are not supported with the fast starters, running a single instance.\n" );
+        return;
+    }
+
+    EnsembleScheduler* ensemble = new EnsembleScheduler( slots, fe->get_appname(), fe->own_id() );
+    starter->setEnsemble( ensemble );
+    fe->set_ensemble( ensemble );
+    for( int k = 0; k < slots; k++ ) {
+        const EnsembleSlot& slot = ensemble->slot( k );
+        psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ), "Ensemble slot %d: %s on %d hosts from %s, share %d of %d\n",
+                    k, slot.appname.c_str(), ( int )slot.hosts.size(), slot.hosts.empty() ? "-" : slot.hosts.front().c_str(),
+                    slot.share, slot.shares );
+    }
+}
+
+
+bool frontend_statemachine::ensemble_slot_idle() {
+    return fe->get_ensemble() && is_instrumented && fe->get_ensemble()->idleSlot() >= 0;
+}
+
+
+/// Assigns the scenarios of the experiment just defined to an idle slot of the ensemble
+static void assign_experiment( PeriscopeFrontend* fe,
+                               const std::string& env,
+                               const std::string& command,
+                               bool               restart_required ) {
+    EnsembleScheduler*        ensemble  = fe->get_ensemble();
+    std::map<int, Scenario*>* scenarios = fe->frontend_pool_set->esp->getScenarios();
+    std::vector<int>          ids;
+    for( std::map<int, Scenario*>::iterator it = scenarios->begin(); it != scenarios->end(); ++it ) {
+        if( ensemble->slotOfScenario( it->first ) < 0 ) {
+            ids.push_back( it->first );
+        }
+    }
+
+    int k = ensemble->idleSlot();
+    ensemble->assign( k, ids, env, command, restart_required );
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ), "Experiment of %d scenarios assigned to slot %d%s\n",
+                ( int )ids.size(), k, ensemble->slot( k ).restart ? ", restarting its instance" : "" );
+}
+
+
+/// Sends every master agent the request of its slot, slots without scenarios get an empty one
+static void push_slot_requests( PeriscopeFrontend* fe ) {
+    EnsembleScheduler* ensemble = fe->get_ensemble();
+    for( int k = 0; k < ensemble->size(); k++ ) {
+        if( psc_get_debug_level() >= 4 ) {
+            prepared_slot_requests[ k ]->printStrategyRequest();
+        }
+        fe->serializeStrategyRequests( prepared_slot_requests[ k ], ensemble->slot( k ).tag );
+    }
+}
+
+
+static void delete_slot_requests() {
+    for( size_t k = 0; k < prepared_slot_requests.size(); k++ ) {
+        delete prepared_slot_requests[ k ];
+    }
+    prepared_slot_requests.clear();
+}
+
+
 void restart_sequence( PeriscopeFrontend* fe,
                        string             location,
                        bool               push_request,
                        bool               reinit ) {
-    int                                        status;
     std::map<std::string, AgentInfo>::iterator it;
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ),
                 "%s: terminating application\n", location.c_str() );
@@ -97,7 +301,7 @@ void restart_sequence( PeriscopeFrontend* fe,
     ace_communication_phase( fe, PeriscopeFrontend::APPLICATION_TERMINATION, fe->get_fastmode() );
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ),
                 "%s: application terminated.\n", location.c_str() );
-    waitpid( application_pid, &status, 0 );
+    starter->waitForApplication();
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ),
                 "%s: waited for process id.\n", location.c_str() );
     fe->increment_global_timeout();
@@ -109,7 +313,12 @@ void restart_sequence( PeriscopeFrontend* fe,
     fe->set_need_restart( false );
     if( push_request ) {
         psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ACECommunication ), "pushing the request in restart_sequence\n" );
-        pushStrategyRequest( prepared_strategy_request );
+        if( fe->get_ensemble() ) {
+            push_slot_requests( fe );
+        }
+        else {
+            pushStrategyRequest( prepared_strategy_request );
+        }
     }
     fe->increment_global_timeout();
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ), "%s: Waiting for restart of application\n", location.c_str() );
@@ -133,6 +342,20 @@ void restart_sequence( PeriscopeFrontend* fe,
 }
 
 
+/// Restarts the instances of the ensemble, each with the environment of its slot
+static void restart_ensemble( PeriscopeFrontend* fe,
+                              ACE_Reactor*       reactor ) {
+    psc_infomsg( "Restarting the application instances of the ensemble...\n" );
+    fe->set_need_restart( true );
+    reactor->register_handler( 0, fe, ACE_Event_Handler::READ_MASK );
+    reactor->register_handler( SIGINT, fe );
+    if( !fe->get_fastmode() ) {
+        ace_communication_phase( fe, PeriscopeFrontend::AGENT_STARTUP, fe->get_fastmode() );
+    }
+    restart_sequence( fe, "Ensemble Restart", false, false );
+}
+
+
 void agents_then_application_start( PeriscopeFrontend*  fe,
                                     ApplicationStarter* starter ) {
     fe->set_shutdown_allowed( false );
@@ -327,6 +550,20 @@ void autotune_msm::consider_restart_action( consider_restart const& evt ) {
     bool restart_required = plugin->restartRequired( env, numprocs, command, is_instrumented );
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ), "Checking if a restart is necessary: %s\n", restart_required  ?  "yes" : "no" );
 
+    // the instances of an ensemble restart together once the experiments of the round are assigned
+    if( evt.fe->get_ensemble() && !just_started ) {
+        if( !is_instrumented || ( numprocs > 0 && numprocs != previous_process_count ) ) {
+            psc_errmsg( "The experiments of an ensemble must be instrumented and keep the number of processes. Aborting...\n" );
+            throw 0;
+        }
+        if( command == "" ) {
+            psc_errmsg( "Empty string received as command from the plugin. Aborting...\n" );
+            throw 0;
+        }
+        assign_experiment( evt.fe, env, command, restart_required );
+        return;
+    }
+
     if( numprocs != previous_process_count && numprocs > 0 ) {
         psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ),
                     "Changing mpinumprocs from %d to %d\n", previous_process_count, numprocs );
@@ -357,6 +594,9 @@ void autotune_msm::consider_restart_action( consider_restart const& evt ) {
     if( is_instrumented ) {
         if( just_started ) {  // if we just started, there is no need for a restart
             start_application_and_agent_network( *evt.reactor );
+            if( evt.fe->get_ensemble() ) {
+                assign_experiment( evt.fe, env, command, false );
+            }
         }
         else if( restart_required ) {    // a restart was requested with an already running application and hierarchy
             psc_infomsg( "Restarting application...\n" );
@@ -419,7 +659,31 @@ void autotune_msm::run_phase_experiments_action( run_phase_experiments const& ev
      if( is_instrumented ) {
          // only prepare a request if the scenarios are not executed
          // this can be due to the application terminating before we have explored the space -IC
-         if( scenarios_executed ) {
+         EnsembleScheduler* ensemble = evt.fe->get_ensemble();
+         if( scenarios_executed && ensemble ) {
+             if( ensemble->needsRestart() ) {
+                 restart_ensemble( evt.fe, evt.reactor );
+             }
+             start_race( evt.fe );
+
+             // scenarios outside of the experiments, like those repeated by a race, keep or get a slot
+             std::vector<int>          ids;
+             std::map<int, Scenario*>* scenarios = evt.fe->frontend_pool_set->esp->getScenarios();
+             for( std::map<int, Scenario*>::iterator it = scenarios->begin(); it != scenarios->end(); ++it ) {
+                 ids.push_back( it->first );
+             }
+             ensemble->distribute( ids );
+
+             for( int k = 0; k < ensemble->size(); k++ ) {
+                 prepared_slot_requests.push_back( createStrategyRequest( evt.fe, k ) );
+                 if( analysis_per_experiment_required && analysis_strategy_request ) {
+                     prepared_slot_requests.back()->setSubStrategyRequest( analysis_strategy_request );
+                 }
+             }
+             push_slot_requests( evt.fe );
+         }
+         else if( scenarios_executed ) {
+             start_race( evt.fe );
              prepared_strategy_request = createStrategyRequest( evt.fe );
              if( analysis_per_experiment_required && analysis_strategy_request ) {
                  psc_dbgmsg( 3, "Frontend, Configuration type: %d\n", analysis_strategy_request->getTypeOfConfiguration() );
@@ -444,9 +708,15 @@ void autotune_msm::run_phase_experiments_action( run_phase_experiments const& ev
          else {
              psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ), "No restart was necessary in run_phase_experiments_action...\n" );
              scenarios_executed = *evt.executed = true;     // the scenarios are executed if there is no restart
-             delete prepared_strategy_request;
+             if( ensemble ) {
+                 delete_slot_requests();
+             }
+             else {
+                 delete prepared_strategy_request;
+             }
          }
 
+         std::map<int, std::list<MetaProperty> > race_iteration;
          for(; new_properties_index < evt.fe->metaproperties_.size(); ++new_properties_index ) {
              MetaProperty& property = evt.fe->metaproperties_[ new_properties_index ];
              //psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ),
@@ -454,13 +724,38 @@ void autotune_msm::run_phase_experiments_action( run_phase_experiments const& ev
              //            property.getName().c_str(), property.getSeverity() );
 
              if( property.getPurpose() == PSC_PROPERTY_PURPOSE_TUNING ) {
-                 evt.fe->frontend_pool_set->srp->push( property, evt.search_step );
+                 // while racing, the properties of an iteration are held back until the race is decided
+                 addInfoType           extra    = property.getExtraInfo();
+                 addInfoType::iterator scenario = extra.find( "ScenarioID" );
+                 if( ensemble && scenario != extra.end() && !ensemble->merge( atoi( scenario->second.c_str() ) ) ) {
+                     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ),
+                                 "Dropping a result of scenario %s, which is not evaluated in this round\n", scenario->second.c_str() );
+                 }
+                 else if( scenario_race && scenario != extra.end() ) {
+                     race_iteration[ atoi( scenario->second.c_str() ) ].push_back( property );
+                 }
+                 else {
+                     evt.fe->frontend_pool_set->srp->push( property, evt.search_step );
+                 }
              }
              else {
                  evt.fe->frontend_pool_set->arp->pushExperimentProperty( property, evt.experiment_count );
              }
          }
 
+         // an interrupted iteration is repeated after the restart and gives no samples
+         if( scenario_race && scenarios_executed ) {
+             advance_race( evt.fe, race_iteration, evt.search_step );
+         }
+
+         // the round of the ensemble ends with its last iteration, the slots are free for the next experiments
+         if( ensemble && scenarios_executed && !scenario_race ) {
+             if( !ensemble->complete() ) {
+                 psc_errmsg( "Not all scenarios of the ensemble round returned results\n" );
+             }
+             ensemble->finishRound();
+         }
+
 
          if(withRtsSupport()) {
              evt.reactor->reset_reactor_event_loop();
@@ -625,6 +920,7 @@ void autotune_msm::start_application_and_agent_network( ACE_Reactor& reactor ) {
         psc_errmsg( "Application is already started, some state logic is broken!\n" );
         abort();
     }
+    configure_ensemble( fe );
 
 
     // startup the application the agent network
@@ -796,7 +1092,7 @@ void autotune_msm::start_application_and_agent_network( ACE_Reactor& reactor ) {
                     }
                     //Insert DEFAULT objective values for current rts
                     obj_val = objectives[0]->objective(rts_properties);
-                    appl->getCalltreeRoot()->getRtsByCallpath(rts->getCallPath())->insertDefaultObjValue(s,obj_val);
+                    appl->getRtsByCallpath(rts->getCallPath())->insertDefaultObjValue(s,obj_val);
                 }
             }
 
@@ -817,16 +1113,34 @@ void autotune_msm::start_application_and_agent_network( ACE_Reactor& reactor ) {
         psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ), "Get call-tree: communication phase done\n" );
     }
     fe->metaproperties_.clear();
+    fe->property_store.clear();
     new_properties_index = 0;
 }
 
 
-StrategyRequest* createStrategyRequest( PeriscopeFrontend* fe ) {
+StrategyRequest* createStrategyRequest( PeriscopeFrontend* fe,
+                                        int                slot ) {
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( FrontendStateMachines ), "Preparing strategy request...\n" );
     Scenario*             scenario;
     std::list<Scenario*>* scenariosList = new std::list<Scenario*>;
 
-    while( !fe->frontend_pool_set->esp->empty() ) {
+    if( slot >= 0 ) {
+        // only the scenarios assigned to the slot
+        std::vector<Scenario*>    selected;
+        std::map<int, Scenario*>* scenarios = fe->frontend_pool_set->esp->getScenarios();
+        for( std::map<int, Scenario*>::iterator it = scenarios->begin(); it != scenarios->end(); ++it ) {
+            if( fe->get_ensemble()->slotOfScenario( it->first ) == slot ) {
+                selected.push_back( it->second );
+            }
+        }
+        for( size_t i = 0; i < selected.size(); i++ ) {
+            scenario = fe->frontend_pool_set->esp->pop( selected[ i ]->getID() );
+            scenariosList->push_back( scenario );
+            fe->frontend_pool_set->fsp->push( scenario );
+        }
+    }
+
+    while( slot < 0 && !fe->frontend_pool_set->esp->empty() ) {
         scenario = fe->frontend_pool_set->esp->pop();
         // Pushes scenarios from the experiment scenario pool to a list which is serialized.
         scenariosList->push_back( scenario );
@@ -26,6 +26,8 @@
 #include "psc_errmsg.h"
 
 #ifdef HAVE_CEREAL
+#include "binary_model.h"
+#include "serialization.h"
 #include "tuning_model.h"
 #endif
 
@@ -71,11 +73,18 @@ void generate_tuning_model() {
         file_path += "/tuning_model.json";
     }
 
-    std::ofstream ofs( file_path.c_str() );
+    // "binary" writes the binary tuning model, which runtimes map and query in place
+    bool binary = false;
+    try {
+        binary = configTree.get < std::string > ( "Configuration.periscope.tuningModel.format" ) == "binary";
+    } catch (exception &e) {
+    }
+
+    std::ofstream ofs( file_path.c_str(), std::ios::binary );
     if ( ofs.is_open() ) {
         tmg::cluster::equality_clusterer c;
-        auto tm = tmg::generate_tuning_model( appl->getCalltreeRoot(), iids, c, tmg::random_selector );
-        ofs << tm;
+        auto document = tmg::generate_tuning_model_document( appl->getCalltreeRoot(), iids, c, tmg::random_selector );
+        ofs << ( binary ? tmg::encode_binary( document ) : tmg::serialize( document ) );
         ofs.close();
     }
     /* FIXME: print error message if file cannot be opened */
@@ -0,0 +1,323 @@
+/**
+   @file    binary_model.h
+   @ingroup Frontend
+   @brief   Binary tuning model header
+   @author  Nico Reissmann
+   @verbatim
+        Revision:       $Revision$
+        Revision date:  $Date$
+        Committed by:   $Author$
+
+        This file is part of the Periscope performance measurement tool.
+        See http://www.lrr.in.tum.de/periscope for details.
+
+        Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+        See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef BINARY_MODEL_H_INCLUDED
+#define BINARY_MODEL_H_INCLUDED
+
+#include "document.h"
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tmg {
+namespace binary {
+
+/*
+ * Binary tuning model format
+ *
+ * The file is a header, a table of sections and the sections. Every section is an array of fixed
+ * size records at an 8 byte aligned offset, so a model mapped into memory is queried in place.
+ * Integers are stored in the byte order of the writer, which the header records; a reader with
+ * another byte order rejects the file. The header carries a CRC-32 of the section table, the table
+ * one of every section.
+ *
+ * Strings are stored once, NUL terminated, and referred to by their index. Identifier lists, tuning
+ * parameters and callpath elements are stored once as well. A callpath is a node of a prefix tree
+ * of callpath elements, so RTSs below the same call site share the encoding of the path to it.
+ *
+ * The index sections hold the records of a section sorted by id, for lookups by binary search.
+ * Documents keep their order in the other sections, so converting to and from JSON is lossless.
+ *
+ * Version 2 added the input identifier classifiers; a version 1 model has none.
+ */
+
+const char magic[8] = {'P', 'T', 'F', 'T', 'M', 'B', 'I', 'N'};
+const uint32_t version = 2;
+const uint32_t byte_order = 0x01020304;
+const uint32_t none = 0xffffffff;
+
+typedef enum section_kind : uint32_t {
+    strings_index = 1,          /* uint32_t offset of every string into the data, and the data size */
+    strings_data,               /* the NUL terminated strings */
+    identifiers,
+    input_ids,
+    regions,
+    callpath_elements,
+    callpath_nodes,
+    rtss,
+    tuning_parameters,
+    tuning_values,
+    scenarios,
+    clusters,
+    cluster_phases,             /* uint32_t */
+    phase_ranges,
+    region_index,               /* uint32_t regions sorted by id */
+    scenario_index,             /* uint32_t scenarios sorted by id */
+    rts_index,                  /* uint32_t rtss sorted by region id */
+    classifiers,
+    decisions,
+    classifier_index,           /* uint32_t classifiers sorted by region id */
+    nsection_kinds = classifier_index,
+    nsection_kinds_v1 = rts_index
+} section_kind;
+
+typedef struct header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t size;              /* of the file */
+    uint32_t nsections;
+    uint32_t checksum;          /* of the section table */
+} header;
+
+typedef struct section {
+    uint32_t kind;
+    uint32_t element_size;
+    uint64_t offset;
+    uint64_t count;
+    uint32_t checksum;
+    uint32_t reserved;
+} section;
+
+/* A list of records of another section */
+typedef struct range {
+    uint32_t first;
+    uint32_t count;
+} range;
+
+typedef struct identifier {
+    uint32_t type;              /* strings */
+    uint32_t name;
+    uint32_t value;
+} identifier;
+
+typedef struct input_id {
+    uint64_t id;
+    range identifiers;
+} input_id;
+
+typedef struct region {
+    uint64_t id;
+    uint64_t line;
+    uint32_t file;
+    uint32_t name;
+} region;
+
+typedef struct callpath_element {
+    uint64_t line;
+    uint32_t file;
+    uint32_t name;
+    range identifiers;
+} callpath_element;
+
+typedef struct callpath_node {
+    uint32_t parent;            /* a node before this one, or none */
+    uint32_t element;
+} callpath_node;
+
+typedef struct rts {
+    uint64_t region;
+    uint64_t scenario;
+    uint64_t iid;
+    double exectime;
+    uint32_t callpath;          /* node of the last element, or none */
+    uint32_t depth;
+} rts;
+
+typedef struct tuning_parameter {
+    uint32_t name;
+    int32_t start;
+    int32_t step;
+    int32_t end;
+} tuning_parameter;
+
+typedef struct tuning_value {
+    uint32_t parameter;
+    int32_t value;
+} tuning_value;
+
+typedef struct scenario {
+    uint64_t id;
+    range configuration;
+} scenario;
+
+typedef struct cluster {
+    int64_t id;
+    range phases;
+    range ranges;
+} cluster;
+
+typedef struct phase_range {
+    double start;
+    double end;
+    uint32_t feature;
+    uint32_t reserved;
+} phase_range;
+
+typedef struct classifier {
+    uint64_t region;
+    range decisions;
+} classifier;
+
+/* A node of a decision tree; pass and fail are relative to the first decision of the tree */
+typedef struct decision {
+    double threshold;
+    uint64_t scenario;
+    uint32_t feature;           /* string, none for a leaf */
+    uint32_t category;          /* string, none for a numeric test */
+    uint32_t pass;
+    uint32_t fail;
+} decision;
+
+}
+
+/*
+ * A binary tuning model in memory or mapped from a file. The constructor validates the whole
+ * model: header, checksums, section bounds and every reference between records; it throws
+ * tmg::exception for an invalid model. The queries afterwards work on the records in place.
+ */
+class binary_model final {
+public:
+    binary_model(const void * data, size_t size);
+
+    ~binary_model();
+
+    binary_model(const binary_model & other) = delete;
+
+    binary_model &
+    operator=(const binary_model & other) = delete;
+
+    /* Maps the model file into memory */
+    static std::unique_ptr<binary_model>
+    open(const std::string & path);
+
+    inline const char *
+    string(uint32_t index) const noexcept
+    {
+        return strings_data_ + strings_index_[index];
+    }
+
+    inline size_t
+    nrtss() const noexcept
+    {
+        return count(binary::rtss);
+    }
+
+    inline const binary::rts &
+    rts(size_t index) const noexcept
+    {
+        return records<binary::rts>(binary::rtss)[index];
+    }
+
+    inline size_t
+    nregions() const noexcept
+    {
+        return count(binary::regions);
+    }
+
+    inline const binary::region &
+    region(size_t index) const noexcept
+    {
+        return records<binary::region>(binary::regions)[index];
+    }
+
+    inline size_t
+    nscenarios() const noexcept
+    {
+        return count(binary::scenarios);
+    }
+
+    inline const binary::scenario &
+    scenario(size_t index) const noexcept
+    {
+        return records<binary::scenario>(binary::scenarios)[index];
+    }
+
+    const binary::region *
+    find_region(uint64_t id) const noexcept;
+
+    const binary::scenario *
+    find_scenario(uint64_t id) const noexcept;
+
+    /* The RTSs of a region, by its id */
+    std::vector<const binary::rts *>
+    rtss_of_region(uint64_t id) const;
+
+    /* The elements of the callpath of an RTS, outermost first */
+    std::vector<const binary::callpath_element *>
+    callpath(const binary::rts & rts) const;
+
+    /* The tuning parameter names and values of a scenario */
+    std::vector<std::pair<const char *, int>>
+    configuration(const binary::scenario & scenario) const;
+
+    const binary::classifier *
+    find_classifier(uint64_t region) const noexcept;
+
+    /* The scenario id the classifier assigns to the input identifiers */
+    uint64_t
+    classify(
+        const binary::classifier & classifier,
+        const std::vector<document_identifier> & identifiers) const;
+
+    /* Decodes the whole model */
+    model_document
+    document() const;
+
+private:
+    void
+    validate();
+
+    /* sections newer than the version of the model are missing */
+    inline size_t
+    count(binary::section_kind kind) const noexcept
+    {
+        return sections_[kind] ? sections_[kind]->count : 0;
+    }
+
+    template <typename T> inline const T *
+    records(binary::section_kind kind) const noexcept
+    {
+        return sections_[kind] ? reinterpret_cast<const T *>(data_ + sections_[kind]->offset) : nullptr;
+    }
+
+    std::vector<document_identifier>
+    identifiers(const binary::range & range) const;
+
+    const char * data_;
+    size_t size_;
+    void * mapping_;
+    const binary::section * sections_[binary::nsection_kinds + 1];
+    const uint32_t * strings_index_;
+    const char * strings_data_;
+};
+
+std::string
+encode_binary(const model_document & document);
+
+/* Whether the stream starts with a binary tuning model; does not consume anything */
+bool
+is_binary_model(std::istream & is);
+
+}
+
+#endif /* BINARY_MODEL_H_INCLUDED */
@@ -0,0 +1,101 @@
+/**
+   @file    classifier.h
+   @ingroup Frontend
+   @brief   Input identifier classifier header
+   @author  Nico Reissmann
+   @verbatim
+        Revision:       $Revision$
+        Revision date:  $Date$
+        Committed by:   $Author$
+
+        This file is part of the Periscope performance measurement tool.
+        See http://www.lrr.in.tum.de/periscope for details.
+
+        Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+        See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef CLASSIFIER_H_INCLUDED
+#define CLASSIFIER_H_INCLUDED
+
+#include "document.h"
+
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tmg {
+
+/*
+ * Input identifier classification
+ *
+ * The scenarios of a tuning model only cover the input identifiers seen at design time. For every
+ * region, a decision tree learns the scenario from the input identifiers of its RTSs, so an unseen
+ * combination of inputs gets the scenario of similar ones. Identifiers whose values are all numbers
+ * are split by thresholds, all others by equality with a category. The depth of the trees is
+ * bounded, so a classification takes constant time.
+ */
+
+const size_t classifier_max_depth = 8;
+
+/* Whether the value is a number, as a whole */
+static inline bool
+parse_number(const char * value, double * number)
+{
+    char * end;
+    *number = strtod(value, &end);
+    return end != value && *end == '\0';
+}
+
+/* Whether an identifier value passes the test of an inner node */
+static inline bool
+decision_passes(bool numeric, double threshold, const char * category, const char * value)
+{
+    if (!numeric)
+        return std::string(category) == value;
+
+    double number;
+    return parse_number(value, &number) && number <= threshold;
+}
+
+/* Learns a decision tree for every region of the document that has RTSs */
+std::vector<document_classifier>
+train_classifiers(const model_document & document, size_t max_depth = classifier_max_depth);
+
+/* The scenario a decision tree assigns to the input identifiers */
+uint64_t
+classify(const document_classifier & classifier, const std::vector<document_identifier> & identifiers);
+
+class input_classifier final {
+public:
+    inline
+    input_classifier(const std::vector<document_classifier> & classifiers)
+    : classifiers_(classifiers)
+    {
+        for (const auto & classifier : classifiers_)
+            regions_[classifier.region] = &classifier;
+    }
+
+    input_classifier(const input_classifier & other) = delete;
+
+    input_classifier &
+    operator=(const input_classifier & other) = delete;
+
+    /* The scenario of the input identifiers in a region, or zero for a region without classifier */
+    inline uint64_t
+    classify(uint64_t region, const std::vector<document_identifier> & identifiers) const
+    {
+        auto it = regions_.find(region);
+        return it != regions_.end() ? tmg::classify(*it->second, identifiers) : 0;
+    }
+
+private:
+    std::vector<document_classifier> classifiers_;
+    std::unordered_map<uint64_t, const document_classifier*> regions_;
+};
+
+}
+
+#endif /* CLASSIFIER_H_INCLUDED */
@@ -0,0 +1,220 @@
+/**
+   @file    document.h
+   @ingroup Frontend
+   @brief   Tuning model document header
+   @author  Nico Reissmann
+   @verbatim
+        Revision:       $Revision$
+        Revision date:  $Date$
+        Committed by:   $Author$
+
+        This file is part of the Periscope performance measurement tool.
+        See http://www.lrr.in.tum.de/periscope for details.
+
+        Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+        See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef DOCUMENT_H_INCLUDED
+#define DOCUMENT_H_INCLUDED
+
+#include "phase.h"
+#include "scenario.h"
+
+#include <sys/types.h>
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace tmg {
+
+/*
+ * The content of a tuning model file, as it is stored. Entities refer to each other by the ids of
+ * the file. Both the JSON and the binary format read and write documents, so converting between
+ * them is lossless.
+ */
+
+typedef struct document_identifier {
+    std::string type;
+    std::string name;
+    std::string value;
+
+    bool
+    operator==(const document_identifier & other) const noexcept
+    {
+        return type == other.type && name == other.name && value == other.value;
+    }
+} document_identifier;
+
+typedef struct document_input_id {
+    uint64_t id;
+    std::vector<document_identifier> identifiers;
+
+    bool
+    operator==(const document_input_id & other) const noexcept
+    {
+        return id == other.id && identifiers == other.identifiers;
+    }
+} document_input_id;
+
+typedef struct document_region {
+    uint64_t id;
+    std::string file;
+    size_t line;
+    std::string name;
+
+    bool
+    operator==(const document_region & other) const noexcept
+    {
+        return id == other.id && file == other.file && line == other.line && name == other.name;
+    }
+} document_region;
+
+typedef struct document_callpath_element {
+    std::string file;
+    size_t line;
+    std::string name;
+    std::vector<document_identifier> identifiers;
+
+    bool
+    operator==(const document_callpath_element & other) const noexcept
+    {
+        return file == other.file && line == other.line && name == other.name
+            && identifiers == other.identifiers;
+    }
+} document_callpath_element;
+
+typedef struct document_rts {
+    uint64_t region;
+    uint64_t scenario;
+    double exectime;
+    uint64_t iid;
+    std::vector<document_callpath_element> callpath;
+
+    bool
+    operator==(const document_rts & other) const noexcept
+    {
+        return region == other.region && scenario == other.scenario && exectime == other.exectime
+            && iid == other.iid && callpath == other.callpath;
+    }
+} document_rts;
+
+typedef struct document_tuning_value {
+    std::string name;
+    int start;
+    int step;
+    int end;
+    int value;
+
+    bool
+    operator==(const document_tuning_value & other) const noexcept
+    {
+        return name == other.name && start == other.start && step == other.step
+            && end == other.end && value == other.value;
+    }
+} document_tuning_value;
+
+typedef struct document_scenario {
+    uint64_t id;
+    std::vector<document_tuning_value> configuration;
+
+    bool
+    operator==(const document_scenario & other) const noexcept
+    {
+        return id == other.id && configuration == other.configuration;
+    }
+} document_scenario;
+
+typedef struct document_range {
+    std::string feature;
+    double start;
+    double end;
+
+    bool
+    operator==(const document_range & other) const noexcept
+    {
+        return feature == other.feature && start == other.start && end == other.end;
+    }
+} document_range;
+
+typedef struct document_cluster {
+    ssize_t id;
+    std::vector<unsigned int> phases;
+    std::vector<document_range> ranges;
+
+    bool
+    operator==(const document_cluster & other) const noexcept
+    {
+        return id == other.id && phases == other.phases && ranges == other.ranges;
+    }
+} document_cluster;
+
+/*
+ * A node of a decision tree. An inner node tests an identifier: a numeric one for value <= threshold,
+ * any other for value == category, and continues with the pass or the fail node. A leaf has no
+ * feature. The scenario is the most frequent one of the training samples of the node.
+ */
+typedef struct document_decision {
+    std::string feature;
+    bool numeric;
+    double threshold;
+    std::string category;
+    uint32_t pass;
+    uint32_t fail;
+    uint64_t scenario;
+
+    bool
+    operator==(const document_decision & other) const noexcept
+    {
+        return feature == other.feature && numeric == other.numeric && threshold == other.threshold
+            && category == other.category && pass == other.pass && fail == other.fail
+            && scenario == other.scenario;
+    }
+} document_decision;
+
+/* The decision tree of a region, the root first */
+typedef struct document_classifier {
+    uint64_t region;
+    std::vector<document_decision> nodes;
+
+    bool
+    operator==(const document_classifier & other) const noexcept
+    {
+        return region == other.region && nodes == other.nodes;
+    }
+} document_classifier;
+
+typedef struct model_document {
+    std::vector<document_cluster> clusters;
+    std::vector<document_input_id> iids;
+    std::vector<document_region> regions;
+    std::vector<document_rts> rtss;
+    std::vector<document_scenario> scenarios;
+    std::vector<document_classifier> classifiers;
+
+    bool
+    operator==(const model_document & other) const noexcept
+    {
+        return clusters == other.clusters && iids == other.iids && regions == other.regions
+            && rtss == other.rtss && scenarios == other.scenarios && classifiers == other.classifiers;
+    }
+} model_document;
+
+model_document
+make_document(
+    const std::unordered_set<std::unique_ptr<scenario>> & scenarios,
+    const tmg::cluster_phases & cphases);
+
+/*
+ * Validates the references of the document and builds its scenarios. Throws tmg::exception for
+ * an invalid document.
+ */
+std::unordered_set<std::unique_ptr<scenario>>
+make_scenarios(const model_document & document, const configuration_selector_t & selector);
+
+}
+
+#endif /* DOCUMENT_H_INCLUDED */
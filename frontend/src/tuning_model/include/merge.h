@@ -20,8 +20,11 @@
 #define MERGE_H_INCLUDED
 
 #include "configuration.h"
+#include "document.h"
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -40,6 +43,148 @@ merge(
     const tmg::configuration_selector_t & selector,
     const tmg::cluster::clusterer & clusterer);
 
+/* Inputs that disagree on the configuration of the same RTS */
+typedef struct merge_conflict {
+    std::string rts;
+    /* the distinct configurations, the kept one first */
+    std::vector<std::vector<document_tuning_value>> configurations;
+
+    bool
+    operator==(const merge_conflict & other) const noexcept
+    {
+        return rts == other.rts && configurations == other.configurations;
+    }
+} merge_conflict;
+
+/*
+ * Merges tuning models one document at a time. Regions, input identifiers, callpaths and
+ * configurations are stored once, found by their content hash, so the memory needed grows with the
+ * distinct content of the inputs and not with their number.
+ *
+ * An RTS, a callpath of a region with an input identifier, that the inputs give different
+ * configurations is a conflict. The merger keeps the configuration with the lowest execution
+ * time, and the smallest one on a tie, so the result is the same for every order of the inputs.
+ */
+class model_merger final {
+public:
+    model_merger() = default;
+
+    model_merger(const model_merger & other) = delete;
+
+    model_merger(model_merger && other) = default;
+
+    model_merger &
+    operator=(const model_merger & other) = delete;
+
+    /* Throws tmg::exception for a document with dangling references */
+    void
+    add(const model_document & document);
+
+    void
+    add(const model_merger & other);
+
+    inline size_t
+    nrtss() const noexcept
+    {
+        return rtss_.size();
+    }
+
+    std::vector<merge_conflict>
+    conflicts() const;
+
+    /*
+     * The distinct RTSs with one scenario per configuration, ordered by content and numbered
+     * from one
+     */
+    model_document
+    document() const;
+
+    /* Clusters the distinct RTSs into scenarios */
+    scenario_set
+    merge(
+        const tmg::configuration_selector_t & selector,
+        const tmg::cluster::clusterer & clusterer) const;
+
+private:
+    typedef std::vector<document_identifier> identifiers_content;
+    typedef std::vector<document_callpath_element> callpath_content;
+    typedef std::vector<document_tuning_value> configuration_content;
+
+    template <typename T> class pool final {
+    public:
+        uint32_t
+        insert(const T & content);
+
+        inline const T &
+        operator[](uint32_t index) const noexcept
+        {
+            return *items_[index];
+        }
+
+        inline size_t
+        size() const noexcept
+        {
+            return items_.size();
+        }
+
+        /* The items sorted by content */
+        std::vector<uint32_t>
+        order() const;
+
+    private:
+        struct hash {
+            size_t
+            operator()(const T & content) const noexcept;
+        };
+
+        std::unordered_map<T, uint32_t, hash> index_;
+        std::vector<const T *> items_;
+    };
+
+    struct rts_key {
+        uint32_t callpath;
+        uint32_t region;
+        uint32_t iid;
+
+        inline bool
+        operator==(const rts_key & other) const noexcept
+        {
+            return callpath == other.callpath && region == other.region && iid == other.iid;
+        }
+    };
+
+    struct rts_key_hash {
+        size_t
+        operator()(const rts_key & key) const noexcept;
+    };
+
+    /* A configuration of an RTS and the lowest execution time it was measured with */
+    typedef std::pair<uint32_t, double> alternative;
+
+    void
+    add(const rts_key & key, uint32_t configuration, double exectime);
+
+    std::vector<alternative>
+    sorted_alternatives(const std::vector<alternative> & alternatives) const;
+
+    std::string
+    debug_string(const rts_key & key) const;
+
+    pool<document_region> regions_;
+    pool<identifiers_content> iids_;
+    pool<callpath_content> callpaths_;
+    pool<configuration_content> configurations_;
+    std::unordered_map<rts_key, std::vector<alternative>, rts_key_hash> rtss_;
+};
+
+/*
+ * Merges tuning model files, JSON or binary, with nthreads threads. Each thread reads one file at a
+ * time into its own merger; the mergers are combined in a fixed order. Throws tmg::exception for a
+ * file that cannot be read.
+ */
+model_merger
+merge_files(const std::vector<std::string> & paths, size_t nthreads);
+
 }
 
 #endif
@@ -17,21 +17,32 @@
  */
 
 #ifndef SERIALIZATION_H_INCLUDED
-#define SERILIAZATION_H_INCLUDED
+#define SERIALIZATION_H_INCLUDED
 
+#include <document.h>
 #include <phase.h>
 #include <scenario.h>
 
+#include <istream>
 #include <memory>
 #include <unordered_set>
 
 namespace tmg {
 
+std::string
+serialize(const model_document & document);
+
 std::string
 serialize(
     const std::unordered_set<std::unique_ptr<scenario>> & scenarios,
     const tmg::cluster_phases & cphases);
 
+/*
+ * Reads a JSON or binary tuning model; the format is detected from the content.
+ */
+model_document
+deserialize_document(std::istream & is);
+
 std::unordered_set<std::unique_ptr<scenario>>
 deserialize(std::istream & is, const configuration_selector_t & selector);
 
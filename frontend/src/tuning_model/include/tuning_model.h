@@ -21,6 +21,7 @@
 
 #include <clustering/clusterer.h>
 #include <configuration.h>
+#include <document.h>
 
 namespace tmg {
 namespace cluster {
@@ -29,6 +30,14 @@ class clusterer;
 
 }
 
+model_document
+generate_tuning_model_document(
+    const Rts * root,
+    const std::unordered_map<std::string, std::string> & input_ids,
+    const tmg::cluster::clusterer & clusterer,
+    const tmg::configuration_selector_t & selector);
+
+/* The tuning model as JSON */
 std::string
 generate_tuning_model(
     const Rts * root,
@@ -0,0 +1,782 @@
+/**
+   @file    binary_model.cc
+   @ingroup Frontend
+   @brief   Binary tuning model
+   @author  Nico Reissmann
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "binary_model.h"
+#include "classifier.h"
+
+#include <boost/crc.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace tmg {
+
+static_assert(sizeof(binary::header) == 32, "Unexpected binary model header size.");
+static_assert(sizeof(binary::section) == 32, "Unexpected binary model section size.");
+static_assert(sizeof(binary::rts) == 40, "Unexpected binary model RTS size.");
+static_assert(sizeof(binary::decision) == 32, "Unexpected binary model decision size.");
+
+static uint32_t
+checksum(const void * data, size_t size)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+}
+
+static size_t
+element_size(uint32_t kind)
+{
+    switch (kind) {
+        case binary::strings_index:
+        case binary::cluster_phases:
+        case binary::region_index:
+        case binary::scenario_index:
+        case binary::rts_index:
+        case binary::classifier_index:
+            return sizeof(uint32_t);
+        case binary::strings_data:
+            return sizeof(char);
+        case binary::identifiers:
+            return sizeof(binary::identifier);
+        case binary::input_ids:
+            return sizeof(binary::input_id);
+        case binary::regions:
+            return sizeof(binary::region);
+        case binary::callpath_elements:
+            return sizeof(binary::callpath_element);
+        case binary::callpath_nodes:
+            return sizeof(binary::callpath_node);
+        case binary::rtss:
+            return sizeof(binary::rts);
+        case binary::tuning_parameters:
+            return sizeof(binary::tuning_parameter);
+        case binary::tuning_values:
+            return sizeof(binary::tuning_value);
+        case binary::scenarios:
+            return sizeof(binary::scenario);
+        case binary::clusters:
+            return sizeof(binary::cluster);
+        case binary::phase_ranges:
+            return sizeof(binary::phase_range);
+        case binary::classifiers:
+            return sizeof(binary::classifier);
+        case binary::decisions:
+            return sizeof(binary::decision);
+        default:
+            return 0;
+    }
+}
+
+/* encoding */
+
+class encoder final {
+public:
+    std::string
+    encode(const model_document & document)
+    {
+        for (const auto & cluster : document.clusters) {
+            binary::cluster c = {cluster.id, {(uint32_t)phases_.size(), (uint32_t)cluster.phases.size()},
+                {(uint32_t)ranges_.size(), (uint32_t)cluster.ranges.size()}};
+            phases_.insert(phases_.end(), cluster.phases.begin(), cluster.phases.end());
+            for (const auto & range : cluster.ranges)
+                ranges_.push_back({range.start, range.end, intern(range.feature), 0});
+            clusters_.push_back(c);
+        }
+
+        for (const auto & iid : document.iids)
+            iids_.push_back({iid.id, identifier_list(iid.identifiers)});
+
+        for (const auto & region : document.regions)
+            regions_.push_back({region.id, region.line, intern(region.file), intern(region.name)});
+
+        for (const auto & rts : document.rtss) {
+            uint32_t node = binary::none;
+            for (const auto & cpe : rts.callpath)
+                node = callpath_node(node, callpath_element(cpe));
+            rtss_.push_back({rts.region, rts.scenario, rts.iid, rts.exectime, node, (uint32_t)rts.callpath.size()});
+        }
+
+        for (const auto & scnr : document.scenarios) {
+            binary::scenario s = {scnr.id, {(uint32_t)values_.size(), (uint32_t)scnr.configuration.size()}};
+            for (const auto & tv : scnr.configuration)
+                values_.push_back({tuning_parameter(tv), tv.value});
+            scenarios_.push_back(s);
+        }
+
+        for (const auto & classifier : document.classifiers) {
+            binary::classifier c = {classifier.region,
+                {(uint32_t)decisions_.size(), (uint32_t)classifier.nodes.size()}};
+            for (const auto & node : classifier.nodes) {
+                bool leaf = node.feature.empty();
+                decisions_.push_back({node.threshold, node.scenario, leaf ? binary::none : intern(node.feature),
+                    leaf || node.numeric ? binary::none : intern(node.category), node.pass, node.fail});
+            }
+            classifiers_.push_back(c);
+        }
+
+        std::vector<uint32_t> region_index = sorted_index(regions_,
+            [](const binary::region & r){return r.id;});
+        std::vector<uint32_t> scenario_index = sorted_index(scenarios_,
+            [](const binary::scenario & s){return s.id;});
+        std::vector<uint32_t> rts_index = sorted_index(rtss_,
+            [](const binary::rts & r){return r.region;});
+        std::vector<uint32_t> classifier_index = sorted_index(classifiers_,
+            [](const binary::classifier & c){return c.region;});
+
+        strings_index_.push_back(strings_data_.size());
+
+        add_section(binary::strings_index, strings_index_);
+        add_section(binary::strings_data, strings_data_.data(), strings_data_.size());
+        add_section(binary::identifiers, identifiers_);
+        add_section(binary::input_ids, iids_);
+        add_section(binary::regions, regions_);
+        add_section(binary::callpath_elements, elements_);
+        add_section(binary::callpath_nodes, nodes_);
+        add_section(binary::rtss, rtss_);
+        add_section(binary::tuning_parameters, parameters_);
+        add_section(binary::tuning_values, values_);
+        add_section(binary::scenarios, scenarios_);
+        add_section(binary::clusters, clusters_);
+        add_section(binary::cluster_phases, phases_);
+        add_section(binary::phase_ranges, ranges_);
+        add_section(binary::region_index, region_index);
+        add_section(binary::scenario_index, scenario_index);
+        add_section(binary::rts_index, rts_index);
+        add_section(binary::classifiers, classifiers_);
+        add_section(binary::decisions, decisions_);
+        add_section(binary::classifier_index, classifier_index);
+
+        return layout();
+    }
+
+private:
+    uint32_t
+    intern(const std::string & s)
+    {
+        auto it = strings_.find(s);
+        if (it != strings_.end())
+            return it->second;
+
+        uint32_t index = strings_index_.size();
+        strings_index_.push_back(strings_data_.size());
+        strings_data_.append(s.c_str(), s.size() + 1);
+        strings_.emplace(s, index);
+        return index;
+    }
+
+    binary::range
+    identifier_list(const std::vector<document_identifier> & ids)
+    {
+        std::vector<uint32_t> key;
+        for (const auto & id : ids) {
+            key.push_back(intern(id.type));
+            key.push_back(intern(id.name));
+            key.push_back(intern(id.value));
+        }
+
+        auto it = lists_.find(key);
+        if (it != lists_.end())
+            return it->second;
+
+        binary::range range = {(uint32_t)identifiers_.size(), (uint32_t)ids.size()};
+        for (size_t n = 0; n < key.size(); n += 3)
+            identifiers_.push_back({key[n], key[n + 1], key[n + 2]});
+        lists_.emplace(key, range);
+        return range;
+    }
+
+    uint32_t
+    callpath_element(const document_callpath_element & cpe)
+    {
+        binary::callpath_element element = {cpe.line, intern(cpe.file), intern(cpe.name),
+            identifier_list(cpe.identifiers)};
+        auto key = std::make_tuple(element.line, element.file, element.name,
+            element.identifiers.first, element.identifiers.count);
+
+        auto it = elements_map_.find(key);
+        if (it != elements_map_.end())
+            return it->second;
+
+        elements_.push_back(element);
+        elements_map_.emplace(key, elements_.size() - 1);
+        return elements_.size() - 1;
+    }
+
+    uint32_t
+    callpath_node(uint32_t parent, uint32_t element)
+    {
+        auto key = std::make_pair(parent, element);
+        auto it = nodes_map_.find(key);
+        if (it != nodes_map_.end())
+            return it->second;
+
+        nodes_.push_back({parent, element});
+        nodes_map_.emplace(key, nodes_.size() - 1);
+        return nodes_.size() - 1;
+    }
+
+    uint32_t
+    tuning_parameter(const document_tuning_value & tv)
+    {
+        auto key = std::make_tuple(intern(tv.name), tv.start, tv.step, tv.end);
+        auto it = parameters_map_.find(key);
+        if (it != parameters_map_.end())
+            return it->second;
+
+        parameters_.push_back({std::get<0>(key), tv.start, tv.step, tv.end});
+        parameters_map_.emplace(key, parameters_.size() - 1);
+        return parameters_.size() - 1;
+    }
+
+    template <typename T, typename K> static std::vector<uint32_t>
+    sorted_index(const std::vector<T> & records, K key)
+    {
+        std::vector<uint32_t> index(records.size());
+        for (size_t n = 0; n < index.size(); n++)
+            index[n] = n;
+        std::stable_sort(index.begin(), index.end(),
+            [&](uint32_t a, uint32_t b){return key(records[a]) < key(records[b]);});
+        return index;
+    }
+
+    template <typename T> void
+    add_section(binary::section_kind kind, const std::vector<T> & records)
+    {
+        add_section(kind, records.data(), records.size());
+    }
+
+    template <typename T> void
+    add_section(binary::section_kind kind, const T * records, size_t count)
+    {
+        binary::section s;
+        memset(&s, 0, sizeof(s));
+        s.kind = kind;
+        s.element_size = sizeof(T);
+        s.count = count;
+        s.checksum = checksum(records, count * sizeof(T));
+        sections_.push_back(s);
+        contents_.push_back(std::string(reinterpret_cast<const char *>(records), count * sizeof(T)));
+    }
+
+    std::string
+    layout()
+    {
+        size_t offset = sizeof(binary::header) + sections_.size() * sizeof(binary::section);
+        for (size_t n = 0; n < sections_.size(); n++) {
+            offset = (offset + 7) & ~(size_t)7;
+            sections_[n].offset = offset;
+            offset += contents_[n].size();
+        }
+
+        binary::header h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, binary::magic, sizeof(h.magic));
+        h.version = binary::version;
+        h.byte_order = binary::byte_order;
+        h.size = offset;
+        h.nsections = sections_.size();
+        h.checksum = checksum(sections_.data(), sections_.size() * sizeof(binary::section));
+
+        std::string file(offset, '\0');
+        memcpy(&file[0], &h, sizeof(h));
+        memcpy(&file[sizeof(h)], sections_.data(), sections_.size() * sizeof(binary::section));
+        for (size_t n = 0; n < sections_.size(); n++)
+            memcpy(&file[sections_[n].offset], contents_[n].data(), contents_[n].size());
+
+        return file;
+    }
+
+    std::unordered_map<std::string, uint32_t> strings_;
+    std::vector<uint32_t> strings_index_;
+    std::string strings_data_;
+
+    std::map<std::vector<uint32_t>, binary::range> lists_;
+    std::vector<binary::identifier> identifiers_;
+
+    std::map<std::tuple<uint64_t, uint32_t, uint32_t, uint32_t, uint32_t>, uint32_t> elements_map_;
+    std::vector<binary::callpath_element> elements_;
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> nodes_map_;
+    std::vector<binary::callpath_node> nodes_;
+
+    std::map<std::tuple<uint32_t, int, int, int>, uint32_t> parameters_map_;
+    std::vector<binary::tuning_parameter> parameters_;
+    std::vector<binary::tuning_value> values_;
+
+    std::vector<binary::input_id> iids_;
+    std::vector<binary::region> regions_;
+    std::vector<binary::rts> rtss_;
+    std::vector<binary::scenario> scenarios_;
+    std::vector<binary::cluster> clusters_;
+    std::vector<uint32_t> phases_;
+    std::vector<binary::phase_range> ranges_;
+    std::vector<binary::classifier> classifiers_;
+    std::vector<binary::decision> decisions_;
+
+    std::vector<binary::section> sections_;
+    std::vector<std::string> contents_;
+};
+
+std::string
+encode_binary(const model_document & document)
+{
+    encoder e;
+    return e.encode(document);
+}
+
+bool
+is_binary_model(std::istream & is)
+{
+    /* a JSON tuning model starts with '{' */
+    return is.peek() == binary::magic[0];
+}
+
+/* loading and validation */
+
+binary_model::binary_model(const void * data, size_t size)
+: data_(static_cast<const char *>(data))
+, size_(size)
+, mapping_(nullptr)
+{
+    validate();
+}
+
+binary_model::~binary_model()
+{
+    if (mapping_)
+        munmap(mapping_, size_);
+}
+
+std::unique_ptr<binary_model>
+binary_model::open(const std::string & path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw tmg::exception(strfmt("Cannot open tuning model ", path));
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        throw tmg::exception(strfmt("Cannot read tuning model ", path));
+    }
+
+    void * mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+        throw tmg::exception(strfmt("Cannot map tuning model ", path));
+
+    try {
+        std::unique_ptr<binary_model> model(new binary_model(mapping, st.st_size));
+        model->mapping_ = mapping;
+        return model;
+    } catch (...) {
+        munmap(mapping, st.st_size);
+        throw;
+    }
+}
+
+static void
+check(bool condition, const char * what)
+{
+    if (!condition)
+        throw tmg::exception(strfmt("Invalid binary tuning model: ", what));
+}
+
+static void
+check_range(const binary::range & range, size_t count, const char * what)
+{
+    check(range.first <= count && range.count <= count - range.first, what);
+}
+
+template <typename T, typename K> static void
+check_index(const uint32_t * index, size_t count, const T * records, size_t nrecords, K key,
+    const char * what)
+{
+    check(count == nrecords, what);
+    std::vector<bool> seen(nrecords, false);
+    for (size_t n = 0; n < count; n++) {
+        check(index[n] < nrecords && !seen[index[n]], what);
+        seen[index[n]] = true;
+        check(n == 0 || key(records[index[n - 1]]) <= key(records[index[n]]), what);
+    }
+}
+
+void
+binary_model::validate()
+{
+    /* header and section table */
+
+    check(size_ >= sizeof(binary::header), "file too short");
+    const auto & h = *reinterpret_cast<const binary::header *>(data_);
+    check(memcmp(h.magic, binary::magic, sizeof(h.magic)) == 0, "no binary tuning model");
+    if (h.version == 0 || h.version > binary::version)
+        throw tmg::exception(strfmt("Unsupported binary tuning model version ", h.version));
+    check(h.byte_order == binary::byte_order, "byte order differs from this machine");
+    check(h.size == size_, "file size differs from the header");
+    check(h.nsections <= (size_ - sizeof(binary::header)) / sizeof(binary::section), "section table");
+
+    auto table = reinterpret_cast<const binary::section *>(data_ + sizeof(binary::header));
+    size_t table_end = sizeof(binary::header) + h.nsections * sizeof(binary::section);
+    check(checksum(table, table_end - sizeof(binary::header)) == h.checksum, "section table checksum");
+
+    std::fill(sections_, sections_ + binary::nsection_kinds + 1, nullptr);
+    for (size_t n = 0; n < h.nsections; n++) {
+        const auto & s = table[n];
+        if (s.kind == 0 || s.kind > binary::nsection_kinds)
+            continue;
+
+        check(sections_[s.kind] == nullptr, "duplicate section");
+        check(s.element_size == element_size(s.kind), "section element size");
+        check(s.offset % 8 == 0 && s.offset >= table_end && s.offset <= size_, "section offset");
+        check(s.count <= (size_ - s.offset) / s.element_size, "section size");
+        check(checksum(data_ + s.offset, s.count * s.element_size) == s.checksum, "section checksum");
+        sections_[s.kind] = &s;
+    }
+    uint32_t nkinds = h.version == 1 ? binary::nsection_kinds_v1 : binary::nsection_kinds;
+    for (uint32_t kind = 1; kind <= nkinds; kind++)
+        check(sections_[kind] != nullptr, "missing section");
+
+    /* the checksums do not cover the padding between the sections, so it has to be zero */
+    std::vector<std::pair<uint64_t, uint64_t>> extents;
+    for (size_t n = 0; n < h.nsections; n++) {
+        if (table[n].kind != 0 && table[n].kind <= binary::nsection_kinds)
+            extents.push_back(std::make_pair(table[n].offset, table[n].offset + table[n].count * table[n].element_size));
+    }
+    extents.push_back(std::make_pair((uint64_t)size_, (uint64_t)size_));
+    std::sort(extents.begin(), extents.end());
+    uint64_t position = table_end;
+    for (const auto & extent : extents) {
+        check(extent.first >= position, "overlapping sections");
+        for (; position < extent.first; position++)
+            check(data_[position] == 0, "padding");
+        position = extent.second;
+    }
+
+    /* strings */
+
+    strings_index_ = records<uint32_t>(binary::strings_index);
+    strings_data_ = records<char>(binary::strings_data);
+    size_t nindex = count(binary::strings_index);
+    check(nindex > 0 && strings_index_[nindex - 1] == count(binary::strings_data), "string table");
+    for (size_t n = 0; n + 1 < nindex; n++) {
+        check(strings_index_[n] < strings_index_[n + 1], "string table");
+        check(strings_data_[strings_index_[n + 1] - 1] == '\0', "unterminated string");
+    }
+
+    size_t nstrings = nindex - 1;
+    auto check_string = [&](uint32_t index){check(index < nstrings, "string reference");};
+
+    /* records */
+
+    auto identifiers = records<binary::identifier>(binary::identifiers);
+    for (size_t n = 0; n < count(binary::identifiers); n++) {
+        check_string(identifiers[n].type);
+        check_string(identifiers[n].name);
+        check_string(identifiers[n].value);
+    }
+
+    auto iids = records<binary::input_id>(binary::input_ids);
+    for (size_t n = 0; n < count(binary::input_ids); n++)
+        check_range(iids[n].identifiers, count(binary::identifiers), "input identifier");
+
+    auto regions = records<binary::region>(binary::regions);
+    for (size_t n = 0; n < count(binary::regions); n++) {
+        check_string(regions[n].file);
+        check_string(regions[n].name);
+    }
+
+    auto elements = records<binary::callpath_element>(binary::callpath_elements);
+    for (size_t n = 0; n < count(binary::callpath_elements); n++) {
+        check_string(elements[n].file);
+        check_string(elements[n].name);
+        check_range(elements[n].identifiers, count(binary::identifiers), "callpath element");
+    }
+
+    /* parents precede their children, so the depth of every node is known when it is reached */
+    auto nodes = records<binary::callpath_node>(binary::callpath_nodes);
+    std::vector<uint32_t> depth(count(binary::callpath_nodes));
+    for (size_t n = 0; n < depth.size(); n++) {
+        check(nodes[n].parent == binary::none || nodes[n].parent < n, "callpath node");
+        check(nodes[n].element < count(binary::callpath_elements), "callpath node");
+        depth[n] = nodes[n].parent == binary::none ? 1 : depth[nodes[n].parent] + 1;
+    }
+
+    auto parameters = records<binary::tuning_parameter>(binary::tuning_parameters);
+    for (size_t n = 0; n < count(binary::tuning_parameters); n++)
+        check_string(parameters[n].name);
+
+    auto values = records<binary::tuning_value>(binary::tuning_values);
+    for (size_t n = 0; n < count(binary::tuning_values); n++)
+        check(values[n].parameter < count(binary::tuning_parameters), "tuning value");
+
+    auto scenarios = records<binary::scenario>(binary::scenarios);
+    for (size_t n = 0; n < count(binary::scenarios); n++)
+        check_range(scenarios[n].configuration, count(binary::tuning_values), "scenario");
+
+    auto clusters = records<binary::cluster>(binary::clusters);
+    for (size_t n = 0; n < count(binary::clusters); n++) {
+        check_range(clusters[n].phases, count(binary::cluster_phases), "cluster");
+        check_range(clusters[n].ranges, count(binary::phase_ranges), "cluster");
+    }
+
+    auto ranges = records<binary::phase_range>(binary::phase_ranges);
+    for (size_t n = 0; n < count(binary::phase_ranges); n++)
+        check_string(ranges[n].feature);
+
+    /* indices */
+
+    auto rtss = records<binary::rts>(binary::rtss);
+    check_index(records<uint32_t>(binary::region_index), count(binary::region_index), regions,
+        count(binary::regions), [](const binary::region & r){return r.id;}, "region index");
+    check_index(records<uint32_t>(binary::scenario_index), count(binary::scenario_index), scenarios,
+        count(binary::scenarios), [](const binary::scenario & s){return s.id;}, "scenario index");
+    check_index(records<uint32_t>(binary::rts_index), count(binary::rts_index), rtss,
+        count(binary::rtss), [](const binary::rts & r){return r.region;}, "RTS index");
+
+    for (size_t n = 0; n < count(binary::rtss); n++) {
+        if (rtss[n].callpath == binary::none)
+            check(rtss[n].depth == 0, "RTS callpath");
+        else
+            check(rtss[n].callpath < depth.size() && depth[rtss[n].callpath] == rtss[n].depth, "RTS callpath");
+        check(find_region(rtss[n].region) != nullptr, "RTS region");
+        check(find_scenario(rtss[n].scenario) != nullptr, "RTS scenario");
+    }
+
+    /* the children of a decision follow it in its tree, so every classification terminates */
+    auto classifiers = records<binary::classifier>(binary::classifiers);
+    auto decisions = records<binary::decision>(binary::decisions);
+    for (size_t n = 0; n < count(binary::classifiers); n++) {
+        const auto & range = classifiers[n].decisions;
+        check_range(range, count(binary::decisions), "classifier");
+        for (uint32_t d = 0; d < range.count; d++) {
+            const auto & decision = decisions[range.first + d];
+            check(find_scenario(decision.scenario) != nullptr, "decision scenario");
+            if (decision.feature == binary::none)
+                continue;
+            check_string(decision.feature);
+            if (decision.category != binary::none)
+                check_string(decision.category);
+            check(decision.pass > d && decision.pass < range.count, "decision");
+            check(decision.fail > d && decision.fail < range.count, "decision");
+        }
+    }
+    check_index(records<uint32_t>(binary::classifier_index), count(binary::classifier_index), classifiers,
+        count(binary::classifiers), [](const binary::classifier & c){return c.region;}, "classifier index");
+}
+
+/* queries */
+
+const binary::region *
+binary_model::find_region(uint64_t id) const noexcept
+{
+    auto index = records<uint32_t>(binary::region_index);
+    auto end = index + count(binary::region_index);
+    auto it = std::lower_bound(index, end, id,
+        [&](uint32_t n, uint64_t id){return region(n).id < id;});
+    return it != end && region(*it).id == id ? &region(*it) : nullptr;
+}
+
+const binary::scenario *
+binary_model::find_scenario(uint64_t id) const noexcept
+{
+    auto index = records<uint32_t>(binary::scenario_index);
+    auto end = index + count(binary::scenario_index);
+    auto it = std::lower_bound(index, end, id,
+        [&](uint32_t n, uint64_t id){return scenario(n).id < id;});
+    return it != end && scenario(*it).id == id ? &scenario(*it) : nullptr;
+}
+
+std::vector<const binary::rts *>
+binary_model::rtss_of_region(uint64_t id) const
+{
+    auto index = records<uint32_t>(binary::rts_index);
+    auto end = index + count(binary::rts_index);
+    auto it = std::lower_bound(index, end, id,
+        [&](uint32_t n, uint64_t id){return rts(n).region < id;});
+
+    std::vector<const binary::rts *> rtss;
+    for (; it != end && rts(*it).region == id; it++)
+        rtss.push_back(&rts(*it));
+    return rtss;
+}
+
+std::vector<const binary::callpath_element *>
+binary_model::callpath(const binary::rts & rts) const
+{
+    auto nodes = records<binary::callpath_node>(binary::callpath_nodes);
+    auto elements = records<binary::callpath_element>(binary::callpath_elements);
+
+    std::vector<const binary::callpath_element *> path(rts.depth);
+    uint32_t node = rts.callpath;
+    for (size_t n = rts.depth; n > 0; n--) {
+        path[n - 1] = &elements[nodes[node].element];
+        node = nodes[node].parent;
+    }
+    return path;
+}
+
+std::vector<std::pair<const char *, int>>
+binary_model::configuration(const binary::scenario & scenario) const
+{
+    auto values = records<binary::tuning_value>(binary::tuning_values);
+    auto parameters = records<binary::tuning_parameter>(binary::tuning_parameters);
+
+    std::vector<std::pair<const char *, int>> configuration;
+    for (size_t n = 0; n < scenario.configuration.count; n++) {
+        const auto & tv = values[scenario.configuration.first + n];
+        configuration.push_back(std::make_pair(string(parameters[tv.parameter].name), tv.value));
+    }
+    return configuration;
+}
+
+const binary::classifier *
+binary_model::find_classifier(uint64_t region) const noexcept
+{
+    auto classifiers = records<binary::classifier>(binary::classifiers);
+    auto index = records<uint32_t>(binary::classifier_index);
+    auto end = index + count(binary::classifier_index);
+    auto it = std::lower_bound(index, end, region,
+        [&](uint32_t n, uint64_t region){return classifiers[n].region < region;});
+    return it != end && classifiers[*it].region == region ? &classifiers[*it] : nullptr;
+}
+
+uint64_t
+binary_model::classify(
+    const binary::classifier & classifier,
+    const std::vector<document_identifier> & identifiers) const
+{
+    if (classifier.decisions.count == 0)
+        return 0;
+
+    auto decisions = records<binary::decision>(binary::decisions) + classifier.decisions.first;
+    const binary::decision * node = decisions;
+    while (node->feature != binary::none) {
+        const char * feature = string(node->feature);
+        auto id = std::find_if(identifiers.begin(), identifiers.end(),
+            [&](const document_identifier & id){return id.name == feature;});
+        if (id == identifiers.end())
+            break;
+
+        bool numeric = node->category == binary::none;
+        bool pass = decision_passes(numeric, node->threshold, numeric ? "" : string(node->category),
+            id->value.c_str());
+        node = &decisions[pass ? node->pass : node->fail];
+    }
+
+    return node->scenario;
+}
+
+/* decoding */
+
+std::vector<document_identifier>
+binary_model::identifiers(const binary::range & range) const
+{
+    auto ids = records<binary::identifier>(binary::identifiers);
+
+    std::vector<document_identifier> identifiers;
+    for (size_t n = 0; n < range.count; n++) {
+        const auto & id = ids[range.first + n];
+        identifiers.push_back({string(id.type), string(id.name), string(id.value)});
+    }
+    return identifiers;
+}
+
+model_document
+binary_model::document() const
+{
+    model_document document;
+
+    auto clusters = records<binary::cluster>(binary::clusters);
+    auto phases = records<uint32_t>(binary::cluster_phases);
+    auto ranges = records<binary::phase_range>(binary::phase_ranges);
+    for (size_t n = 0; n < count(binary::clusters); n++) {
+        const auto & c = clusters[n];
+        document_cluster cluster;
+        cluster.id = c.id;
+        cluster.phases.assign(phases + c.phases.first, phases + c.phases.first + c.phases.count);
+        for (size_t r = 0; r < c.ranges.count; r++) {
+            const auto & range = ranges[c.ranges.first + r];
+            cluster.ranges.push_back({string(range.feature), range.start, range.end});
+        }
+        document.clusters.push_back(cluster);
+    }
+
+    auto iids = records<binary::input_id>(binary::input_ids);
+    for (size_t n = 0; n < count(binary::input_ids); n++)
+        document.iids.push_back({iids[n].id, identifiers(iids[n].identifiers)});
+
+    for (size_t n = 0; n < nregions(); n++) {
+        const auto & r = region(n);
+        document.regions.push_back({r.id, string(r.file), (size_t)r.line, string(r.name)});
+    }
+
+    for (size_t n = 0; n < nrtss(); n++) {
+        const auto & r = rts(n);
+        document_rts drts;
+        drts.region = r.region;
+        drts.scenario = r.scenario;
+        drts.exectime = r.exectime;
+        drts.iid = r.iid;
+        for (const auto & cpe : callpath(r))
+            drts.callpath.push_back({string(cpe->file), (size_t)cpe->line, string(cpe->name),
+                identifiers(cpe->identifiers)});
+        document.rtss.push_back(drts);
+    }
+
+    auto values = records<binary::tuning_value>(binary::tuning_values);
+    auto parameters = records<binary::tuning_parameter>(binary::tuning_parameters);
+    for (size_t n = 0; n < nscenarios(); n++) {
+        const auto & s = scenario(n);
+        document_scenario dscnr;
+        dscnr.id = s.id;
+        for (size_t v = 0; v < s.configuration.count; v++) {
+            const auto & tv = values[s.configuration.first + v];
+            const auto & tp = parameters[tv.parameter];
+            dscnr.configuration.push_back({string(tp.name), tp.start, tp.step, tp.end, tv.value});
+        }
+        document.scenarios.push_back(dscnr);
+    }
+
+    auto classifiers = records<binary::classifier>(binary::classifiers);
+    auto decisions = records<binary::decision>(binary::decisions);
+    for (size_t n = 0; n < count(binary::classifiers); n++) {
+        document_classifier classifier;
+        classifier.region = classifiers[n].region;
+        for (size_t d = 0; d < classifiers[n].decisions.count; d++) {
+            const auto & decision = decisions[classifiers[n].decisions.first + d];
+            bool leaf = decision.feature == binary::none;
+            bool numeric = decision.category == binary::none;
+            classifier.nodes.push_back({leaf ? "" : string(decision.feature), !leaf && numeric,
+                decision.threshold, leaf || numeric ? "" : string(decision.category),
+                decision.pass, decision.fail, decision.scenario});
+        }
+        document.classifiers.push_back(classifier);
+    }
+
+    return document;
+}
+
+}
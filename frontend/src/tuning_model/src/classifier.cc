@@ -0,0 +1,284 @@
+/**
+   @file    classifier.cc
+   @ingroup Frontend
+   @brief   Input identifier classifier
+   @author  Nico Reissmann
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "classifier.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+namespace tmg {
+
+/* training */
+
+/* The value of one identifier of a sample */
+typedef struct feature_value {
+    bool present;
+    double number;
+    std::string category;
+} feature_value;
+
+typedef struct feature {
+    std::string name;
+    bool numeric;
+} feature;
+
+typedef struct split {
+    size_t feature;
+    double threshold;
+    std::string category;
+    double impurity;
+} split;
+
+class tree_builder final {
+public:
+    inline
+    tree_builder(
+        const std::vector<feature> & features,
+        const std::vector<std::vector<feature_value>> & values,
+        const std::vector<uint64_t> & labels,
+        size_t max_depth)
+    : features_(features)
+    , values_(values)
+    , labels_(labels)
+    , max_depth_(max_depth)
+    {}
+
+    std::vector<document_decision>
+    build()
+    {
+        std::vector<size_t> samples(labels_.size());
+        for (size_t n = 0; n < samples.size(); n++)
+            samples[n] = n;
+
+        build(samples, 0);
+        return nodes_;
+    }
+
+private:
+    std::map<uint64_t, size_t>
+    label_counts(const std::vector<size_t> & samples) const
+    {
+        std::map<uint64_t, size_t> counts;
+        for (const auto & sample : samples)
+            counts[labels_[sample]]++;
+        return counts;
+    }
+
+    static double
+    gini(const std::map<uint64_t, size_t> & counts, size_t total)
+    {
+        double sum = 0.0;
+        for (const auto & pair : counts)
+            sum += (double)pair.second * pair.second;
+        return 1.0 - sum / ((double)total * total);
+    }
+
+    bool
+    passes(size_t sample, const split & s) const
+    {
+        const auto & value = values_[sample][s.feature];
+        if (!value.present)
+            return false;
+
+        return features_[s.feature].numeric ? value.number <= s.threshold : value.category == s.category;
+    }
+
+    /* The weighted impurity of the two sides of a split, or none if a side is empty */
+    bool
+    evaluate(const std::vector<size_t> & samples, split & s) const
+    {
+        std::map<uint64_t, size_t> pass, fail;
+        size_t npass = 0;
+        for (const auto & sample : samples) {
+            if (passes(sample, s)) {
+                pass[labels_[sample]]++;
+                npass++;
+            } else {
+                fail[labels_[sample]]++;
+            }
+        }
+
+        size_t nfail = samples.size() - npass;
+        if (npass == 0 || nfail == 0)
+            return false;
+
+        s.impurity = (npass * gini(pass, npass) + nfail * gini(fail, nfail)) / samples.size();
+        return true;
+    }
+
+    bool
+    best_split(const std::vector<size_t> & samples, double impurity, split & best) const
+    {
+        bool found = false;
+        best.impurity = impurity - 1e-12;
+
+        for (size_t f = 0; f < features_.size(); f++) {
+            std::vector<split> candidates;
+            if (features_[f].numeric) {
+                std::set<double> numbers;
+                for (const auto & sample : samples) {
+                    if (values_[sample][f].present)
+                        numbers.insert(values_[sample][f].number);
+                }
+                for (auto it = numbers.begin(); it != numbers.end() && std::next(it) != numbers.end(); it++)
+                    candidates.push_back({f, (*it + *std::next(it)) / 2.0, "", 0.0});
+            } else {
+                std::set<std::string> categories;
+                for (const auto & sample : samples) {
+                    if (values_[sample][f].present)
+                        categories.insert(values_[sample][f].category);
+                }
+                for (const auto & category : categories)
+                    candidates.push_back({f, 0.0, category, 0.0});
+            }
+
+            for (auto & candidate : candidates) {
+                if (evaluate(samples, candidate) && candidate.impurity < best.impurity) {
+                    best = candidate;
+                    found = true;
+                }
+            }
+        }
+
+        return found;
+    }
+
+    uint32_t
+    build(const std::vector<size_t> & samples, size_t depth)
+    {
+        auto counts = label_counts(samples);
+        auto majority = std::max_element(counts.begin(), counts.end(),
+            [](const std::pair<uint64_t, size_t> & a, const std::pair<uint64_t, size_t> & b){
+                return a.second < b.second;
+            });
+
+        uint32_t index = nodes_.size();
+        nodes_.push_back({"", false, 0.0, "", 0, 0, majority->first});
+
+        split s;
+        if (counts.size() == 1 || depth == max_depth_ || !best_split(samples, gini(counts, samples.size()), s))
+            return index;
+
+        std::vector<size_t> pass, fail;
+        for (const auto & sample : samples)
+            (passes(sample, s) ? pass : fail).push_back(sample);
+
+        uint32_t pass_node = build(pass, depth + 1);
+        uint32_t fail_node = build(fail, depth + 1);
+
+        auto & node = nodes_[index];
+        node.feature = features_[s.feature].name;
+        node.numeric = features_[s.feature].numeric;
+        node.threshold = s.threshold;
+        node.category = s.category;
+        node.pass = pass_node;
+        node.fail = fail_node;
+        return index;
+    }
+
+    const std::vector<feature> & features_;
+    const std::vector<std::vector<feature_value>> & values_;
+    const std::vector<uint64_t> & labels_;
+    size_t max_depth_;
+    std::vector<document_decision> nodes_;
+};
+
+static document_classifier
+train_classifier(
+    uint64_t region,
+    const std::vector<const document_rts*> & rtss,
+    const std::unordered_map<uint64_t, const std::vector<document_identifier>*> & iids,
+    size_t max_depth)
+{
+    /* the identifiers of all samples, ordered by name */
+    std::map<std::string, size_t> columns;
+    for (const auto & rts : rtss) {
+        for (const auto & id : *iids.at(rts->iid))
+            columns.emplace(id.name, 0);
+    }
+
+    std::vector<feature> features;
+    for (auto & pair : columns) {
+        pair.second = features.size();
+        features.push_back({pair.first, true});
+    }
+
+    std::vector<std::vector<feature_value>> values;
+    std::vector<uint64_t> labels;
+    for (const auto & rts : rtss) {
+        std::vector<feature_value> sample(features.size(), {false, 0.0, ""});
+        for (const auto & id : *iids.at(rts->iid)) {
+            auto & value = sample[columns[id.name]];
+            value.present = true;
+            value.category = id.value;
+            if (!parse_number(id.value.c_str(), &value.number))
+                features[columns[id.name]].numeric = false;
+        }
+        values.push_back(sample);
+        labels.push_back(rts->scenario);
+    }
+
+    tree_builder builder(features, values, labels, max_depth);
+    return {region, builder.build()};
+}
+
+std::vector<document_classifier>
+train_classifiers(const model_document & document, size_t max_depth)
+{
+    std::unordered_map<uint64_t, const std::vector<document_identifier>*> iids;
+    for (const auto & iid : document.iids)
+        iids[iid.id] = &iid.identifiers;
+
+    std::map<uint64_t, std::vector<const document_rts*>> regions;
+    for (const auto & rts : document.rtss) {
+        if (iids.find(rts.iid) == iids.end())
+            throw tmg::exception(strfmt("No input identifier found for id ", rts.iid));
+        regions[rts.region].push_back(&rts);
+    }
+
+    std::vector<document_classifier> classifiers;
+    for (const auto & pair : regions)
+        classifiers.push_back(train_classifier(pair.first, pair.second, iids, max_depth));
+
+    return classifiers;
+}
+
+/* classification */
+
+uint64_t
+classify(const document_classifier & classifier, const std::vector<document_identifier> & identifiers)
+{
+    if (classifier.nodes.empty())
+        return 0;
+
+    const document_decision * node = &classifier.nodes[0];
+    while (!node->feature.empty()) {
+        auto id = std::find_if(identifiers.begin(), identifiers.end(),
+            [&](const document_identifier & id){return id.name == node->feature;});
+        if (id == identifiers.end())
+            break;
+
+        bool pass = decision_passes(node->numeric, node->threshold, node->category.c_str(), id->value.c_str());
+        node = &classifier.nodes[pass ? node->pass : node->fail];
+    }
+
+    return node->scenario;
+}
+
+}
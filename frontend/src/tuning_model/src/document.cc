@@ -0,0 +1,226 @@
+/**
+   @file    document.cc
+   @ingroup Frontend
+   @brief   Tuning model document
+   @author  Nico Reissmann
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "document.h"
+
+#include <unordered_map>
+
+namespace tmg {
+
+/* tuning model to document */
+
+static std::vector<document_identifier>
+make_identifiers(const tmg::identifiers & ids)
+{
+    std::vector<document_identifier> identifiers;
+    for (auto it = ids.begin_int(); it != ids.end_int(); it++) {
+        auto id = *it;
+        identifiers.push_back({"int", id.name(), strfmt(id.value())});
+    }
+    for (auto it = ids.begin_uint(); it != ids.end_uint(); it++) {
+        auto id = *it;
+        identifiers.push_back({"uint", id.name(), strfmt(id.value())});
+    }
+    for (auto it = ids.begin_string(); it != ids.end_string(); it++) {
+        auto id = *it;
+        identifiers.push_back({"string", id.name(), id.value()});
+    }
+
+    return identifiers;
+}
+
+model_document
+make_document(
+    const std::unordered_set<std::unique_ptr<scenario>> & scenarios,
+    const tmg::cluster_phases & cphases)
+{
+    std::unordered_set<const tmg::rts*> rtss;
+    std::unordered_set<const tmg::input_id*> iids;
+    std::unordered_set<const tmg::region*> regions;
+    for (const auto & scnr : scenarios) {
+        for (const auto & rts : scnr->rtss()) {
+            rtss.insert(rts);
+            regions.insert(rts->region());
+            iids.insert(rts->iid());
+        }
+    }
+
+    model_document document;
+    for (const auto & pair : cphases) {
+        const auto & pdata = *pair.second;
+        document_cluster cluster;
+        cluster.id = pair.first;
+        cluster.phases.assign(pdata.cluster_phases().begin(), pdata.cluster_phases().end());
+        for (const auto & range : pdata.phase_ranges())
+            cluster.ranges.push_back({range.first, range.second.first, range.second.second});
+        document.clusters.push_back(cluster);
+    }
+
+    for (const auto & iid : iids)
+        document.iids.push_back({(uint64_t)iid, make_identifiers(iid->ids())});
+
+    for (const auto & region : regions)
+        document.regions.push_back({(uint64_t)region, region->file(), region->line(), region->name()});
+
+    for (const auto & rts : rtss) {
+        document_rts drts;
+        drts.region = (uint64_t)rts->region();
+        drts.scenario = (uint64_t)rts->scenario();
+        drts.exectime = rts->exectime();
+        drts.iid = (uint64_t)rts->iid();
+        for (const auto & cpe : rts->callpath()) {
+            const auto & rid = cpe.region_id();
+            drts.callpath.push_back({rid.file(), rid.line(), rid.name(), make_identifiers(cpe.identifiers())});
+        }
+        document.rtss.push_back(drts);
+    }
+
+    for (const auto & scnr : scenarios) {
+        document_scenario dscnr;
+        dscnr.id = (uint64_t)scnr.get();
+        for (const auto & tv : scnr->configuration()) {
+            const auto & tp = *tv.parameter();
+            dscnr.configuration.push_back({tp.name(), tp.start(), tp.step(), tp.end(), tv.value()});
+        }
+        document.scenarios.push_back(dscnr);
+    }
+
+    return document;
+}
+
+/* document to tuning model */
+
+typedef std::unordered_map<std::string, std::shared_ptr<tmg::tuning_parameter>> tuning_parameters;
+
+static inline tuning_parameters
+create_tuning_parameters(const std::vector<document_scenario> & scenarios)
+{
+    tuning_parameters tps;
+    for (const auto & scnr : scenarios) {
+        for (const auto & tv : scnr.configuration) {
+            if (tps.find(tv.name) != tps.end()) {
+                const auto & tp = tps.find(tv.name)->second;
+                if (tp->start() != tv.start || tp->step() != tv.step || tp->end() != tv.end)
+                    tmg::exception("Invalid tuning parameter.");
+            }
+
+            tps[tv.name] = std::make_shared<tmg::tuning_parameter>(tv.name, tv.start, tv.step, tv.end);
+        }
+    }
+
+    return tps;
+}
+
+static inline tmg::configuration
+convert_configuration(const document_scenario & scnr, const tuning_parameters & tps)
+{
+    tmg::configuration config;
+    for (const auto & tv : scnr.configuration) {
+        auto tp = tps.find(tv.name);
+        TUNING_MODEL_DEBUG_ASSERT(tp != tps.end());
+        config.add_tuning_value(tmg::tuning_value(tp->second, tv.value));
+    }
+
+    return config;
+}
+
+static tmg::identifiers
+convert_identifiers(const std::vector<document_identifier> & identifiers)
+{
+    tmg::identifiers ids;
+    for (const auto & id : identifiers) {
+        if (id.type == "int")
+            ids.add_int(tmg::identifier<int64_t>(id.name, std::stoll(id.value)));
+        else if (id.type == "uint")
+            ids.add_uint(tmg::identifier<uint64_t>(id.name, std::stoull(id.value)));
+        else if (id.type == "string")
+            ids.add_string(tmg::identifier<std::string>(id.name, id.value));
+        else
+            throw tmg::exception("Unsupported identifier type.");
+    }
+
+    return ids;
+}
+
+std::unordered_set<std::unique_ptr<scenario>>
+make_scenarios(const model_document & document, const configuration_selector_t & selector)
+{
+    std::unordered_map<uint64_t, std::shared_ptr<input_id>> iids;
+    for (const auto & iid : document.iids) {
+        std::unique_ptr<tmg::identifiers> ids(new tmg::identifiers(convert_identifiers(iid.identifiers)));
+        iids.emplace(iid.id, std::make_shared<tmg::input_id>(std::move(ids)));
+    }
+
+    std::unordered_map<uint64_t, std::shared_ptr<region>> regions;
+    for (const auto & region : document.regions) {
+        tmg::region_id rid(region.file, region.line, region.name);
+        regions.emplace(region.id, std::make_shared<tmg::region>(rid));
+    }
+
+    std::unordered_map<uint64_t, const document_scenario*> scenarios;
+    for (const auto & scnr : document.scenarios)
+        scenarios.emplace(scnr.id, &scnr);
+
+    /* validate tuning model */
+
+    auto tps = create_tuning_parameters(document.scenarios);
+
+    for (const auto & rts : document.rtss) {
+        if (iids.find(rts.iid) == iids.end())
+            throw tmg::exception(strfmt("No input identifier found for id ", rts.iid));
+        if (scenarios.find(rts.scenario) == scenarios.end())
+            throw tmg::exception(strfmt("No scenario found for id ", rts.scenario));
+        if (regions.find(rts.region) == regions.end())
+            throw tmg::exception(strfmt("No region found for id ", rts.region));
+    }
+
+    /* convert to tuning model */
+
+    std::unordered_map<uint64_t, std::unordered_set<tmg::rts*>> rtsmap;
+    for (const auto & srcrts : document.rtss) {
+        tmg::callpath callpath;
+        for (const auto & cpe : srcrts.callpath) {
+            tmg::region_id rid(cpe.file, cpe.line, cpe.name);
+            callpath.add_element(tmg::callpath_element(rid, convert_identifiers(cpe.identifiers)));
+        }
+
+        auto scnrid = srcrts.scenario;
+        auto dstrts = new tmg::rts(callpath, regions[srcrts.region], iids[srcrts.iid],
+            convert_configuration(*scenarios[scnrid], tps), srcrts.exectime);
+
+        if (rtsmap.find(scnrid) == rtsmap.end())
+            rtsmap[scnrid] = {dstrts};
+        else
+            rtsmap[scnrid].insert(dstrts);
+    }
+
+    std::unordered_set<std::unique_ptr<scenario>> scnrs;
+    for (const auto & pair : rtsmap)
+        scnrs.insert(std::move(std::make_unique<tmg::scenario>(pair.second, selector)));
+
+    /* cleanup */
+
+    for (const auto & pair : rtsmap) {
+        for (const auto & rts : pair.second)
+            delete rts;
+    }
+
+    return scnrs;
+}
+
+}
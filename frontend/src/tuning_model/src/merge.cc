@@ -20,6 +20,15 @@
 #include "merge.h"
 #include "rts.h"
 #include "scenario.h"
+#include "serialization.h"
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <tuple>
 
 namespace tmg {
 
@@ -53,4 +62,348 @@ merge(
     return scenarios;
 }
 
+/* content hashing and ordering */
+
+static inline size_t
+content_hash(const document_identifier & id)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, id.type);
+    boost::hash_combine(seed, id.name);
+    boost::hash_combine(seed, id.value);
+    return seed;
+}
+
+static inline size_t
+content_hash(const document_region & region)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, region.file);
+    boost::hash_combine(seed, region.line);
+    boost::hash_combine(seed, region.name);
+    return seed;
+}
+
+static inline size_t
+content_hash(const document_callpath_element & cpe)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, cpe.file);
+    boost::hash_combine(seed, cpe.line);
+    boost::hash_combine(seed, cpe.name);
+    for (const auto & id : cpe.identifiers)
+        boost::hash_combine(seed, content_hash(id));
+    return seed;
+}
+
+static inline size_t
+content_hash(const document_tuning_value & tv)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, tv.name);
+    boost::hash_combine(seed, tv.start);
+    boost::hash_combine(seed, tv.step);
+    boost::hash_combine(seed, tv.end);
+    boost::hash_combine(seed, tv.value);
+    return seed;
+}
+
+template <typename T> static inline size_t
+content_hash(const std::vector<T> & v)
+{
+    size_t seed = v.size();
+    for (const auto & e : v)
+        boost::hash_combine(seed, content_hash(e));
+    return seed;
+}
+
+static inline bool
+content_less(const document_identifier & a, const document_identifier & b)
+{
+    return std::tie(a.type, a.name, a.value) < std::tie(b.type, b.name, b.value);
+}
+
+static inline bool
+content_less(const document_region & a, const document_region & b)
+{
+    return std::tie(a.file, a.line, a.name) < std::tie(b.file, b.line, b.name);
+}
+
+static inline bool
+content_less(const document_tuning_value & a, const document_tuning_value & b)
+{
+    return std::tie(a.name, a.value, a.start, a.step, a.end)
+         < std::tie(b.name, b.value, b.start, b.step, b.end);
+}
+
+template <typename T> static inline bool
+content_less(const std::vector<T> & a, const std::vector<T> & b)
+{
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+        [](const T & x, const T & y){ return content_less(x, y); });
+}
+
+static inline bool
+content_less(const document_callpath_element & a, const document_callpath_element & b)
+{
+    if (std::tie(a.file, a.line, a.name) != std::tie(b.file, b.line, b.name))
+        return std::tie(a.file, a.line, a.name) < std::tie(b.file, b.line, b.name);
+
+    return content_less(a.identifiers, b.identifiers);
+}
+
+/* model merger */
+
+template <typename T> size_t
+model_merger::pool<T>::hash::operator()(const T & content) const noexcept
+{
+    return content_hash(content);
+}
+
+template <typename T> uint32_t
+model_merger::pool<T>::insert(const T & content)
+{
+    auto it = index_.find(content);
+    if (it != index_.end())
+        return it->second;
+
+    it = index_.emplace(content, items_.size()).first;
+    items_.push_back(&it->first);
+    return it->second;
+}
+
+template <typename T> std::vector<uint32_t>
+model_merger::pool<T>::order() const
+{
+    std::vector<uint32_t> order(items_.size());
+    for (size_t n = 0; n < order.size(); n++)
+        order[n] = n;
+
+    std::sort(order.begin(), order.end(),
+        [&](uint32_t a, uint32_t b){ return content_less(*items_[a], *items_[b]); });
+    return order;
+}
+
+size_t
+model_merger::rts_key_hash::operator()(const rts_key & key) const noexcept
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, key.callpath);
+    boost::hash_combine(seed, key.region);
+    boost::hash_combine(seed, key.iid);
+    return seed;
+}
+
+void
+model_merger::add(const rts_key & key, uint32_t configuration, double exectime)
+{
+    auto & alternatives = rtss_[key];
+    for (auto & alt : alternatives) {
+        if (alt.first == configuration) {
+            alt.second = std::min(alt.second, exectime);
+            return;
+        }
+    }
+
+    alternatives.push_back({configuration, exectime});
+}
+
+void
+model_merger::add(const model_document & document)
+{
+    std::unordered_map<uint64_t, uint32_t> iids, regions, scenarios;
+    for (const auto & iid : document.iids)
+        iids[iid.id] = iids_.insert(iid.identifiers);
+
+    for (const auto & region : document.regions)
+        regions[region.id] = regions_.insert({0, region.file, region.line, region.name});
+
+    for (const auto & scnr : document.scenarios)
+        scenarios[scnr.id] = configurations_.insert(scnr.configuration);
+
+    for (const auto & rts : document.rtss) {
+        auto iid = iids.find(rts.iid);
+        if (iid == iids.end())
+            throw tmg::exception(strfmt("No input identifier found for id ", rts.iid));
+        auto scnr = scenarios.find(rts.scenario);
+        if (scnr == scenarios.end())
+            throw tmg::exception(strfmt("No scenario found for id ", rts.scenario));
+        auto region = regions.find(rts.region);
+        if (region == regions.end())
+            throw tmg::exception(strfmt("No region found for id ", rts.region));
+
+        add({callpaths_.insert(rts.callpath), region->second, iid->second}, scnr->second, rts.exectime);
+    }
+}
+
+void
+model_merger::add(const model_merger & other)
+{
+    for (const auto & pair : other.rtss_) {
+        rts_key key = {
+            callpaths_.insert(other.callpaths_[pair.first.callpath]),
+            regions_.insert(other.regions_[pair.first.region]),
+            iids_.insert(other.iids_[pair.first.iid])
+        };
+
+        for (const auto & alt : pair.second)
+            add(key, configurations_.insert(other.configurations_[alt.first]), alt.second);
+    }
+}
+
+std::vector<model_merger::alternative>
+model_merger::sorted_alternatives(const std::vector<alternative> & alternatives) const
+{
+    auto sorted = alternatives;
+    std::sort(sorted.begin(), sorted.end(), [&](const alternative & a, const alternative & b){
+        if (a.second != b.second)
+            return a.second < b.second;
+        return content_less(configurations_[a.first], configurations_[b.first]);
+    });
+
+    return sorted;
+}
+
+std::string
+model_merger::debug_string(const rts_key & key) const
+{
+    std::string s;
+    for (const auto & cpe : callpaths_[key.callpath])
+        s += strfmt(cpe.file, ":", cpe.line, ":", cpe.name, "/");
+
+    const auto & region = regions_[key.region];
+    s += strfmt(region.file, ":", region.line, ":", region.name);
+
+    for (const auto & id : iids_[key.iid])
+        s += strfmt(" ", id.name, "=", id.value);
+
+    return s;
+}
+
+std::vector<merge_conflict>
+model_merger::conflicts() const
+{
+    std::vector<merge_conflict> conflicts;
+    for (const auto & pair : rtss_) {
+        if (pair.second.size() < 2)
+            continue;
+
+        merge_conflict conflict;
+        conflict.rts = debug_string(pair.first);
+        for (const auto & alt : sorted_alternatives(pair.second))
+            conflict.configurations.push_back(configurations_[alt.first]);
+        conflicts.push_back(conflict);
+    }
+
+    std::sort(conflicts.begin(), conflicts.end(),
+        [](const merge_conflict & a, const merge_conflict & b){ return a.rts < b.rts; });
+    return conflicts;
+}
+
+model_document
+model_merger::document() const
+{
+    /* rank the pooled content, so the document does not depend on the order of insertion */
+    auto rank = [](const std::vector<uint32_t> & order) {
+        std::vector<uint32_t> ranks(order.size());
+        for (size_t n = 0; n < order.size(); n++)
+            ranks[order[n]] = n;
+        return ranks;
+    };
+
+    auto region_order = regions_.order();
+    auto iid_order = iids_.order();
+    auto callpath_ranks = rank(callpaths_.order());
+    auto region_ranks = rank(region_order);
+    auto iid_ranks = rank(iid_order);
+
+    model_document document;
+    for (size_t n = 0; n < region_order.size(); n++) {
+        auto region = regions_[region_order[n]];
+        region.id = n + 1;
+        document.regions.push_back(region);
+    }
+
+    for (size_t n = 0; n < iid_order.size(); n++)
+        document.iids.push_back({n + 1, iids_[iid_order[n]]});
+
+    std::vector<std::pair<rts_key, alternative>> rtss;
+    for (const auto & pair : rtss_)
+        rtss.push_back({pair.first, sorted_alternatives(pair.second).front()});
+
+    std::sort(rtss.begin(), rtss.end(), [&](const std::pair<rts_key, alternative> & a,
+                                            const std::pair<rts_key, alternative> & b){
+        return std::make_tuple(callpath_ranks[a.first.callpath], region_ranks[a.first.region], iid_ranks[a.first.iid])
+             < std::make_tuple(callpath_ranks[b.first.callpath], region_ranks[b.first.region], iid_ranks[b.first.iid]);
+    });
+
+    /* scenarios are numbered in the order of their first RTS */
+    std::unordered_map<uint32_t, uint64_t> scenarios;
+    for (const auto & pair : rtss) {
+        const auto & key = pair.first;
+        auto configuration = pair.second.first;
+        if (scenarios.find(configuration) == scenarios.end()) {
+            uint64_t id = document.scenarios.size() + 1;
+            scenarios[configuration] = id;
+            document.scenarios.push_back({id, configurations_[configuration]});
+        }
+
+        document.rtss.push_back({region_ranks[key.region] + 1, scenarios[configuration],
+            pair.second.second, iid_ranks[key.iid] + 1, callpaths_[key.callpath]});
+    }
+
+    return document;
+}
+
+scenario_set
+model_merger::merge(
+    const configuration_selector_t & selector,
+    const tmg::cluster::clusterer & clusterer) const
+{
+    /* every RTS of a scenario has the scenario's configuration, so any selector does */
+    std::vector<scenario_set> scnrvector;
+    scnrvector.push_back(make_scenarios(document(), random_selector));
+    return tmg::merge(scnrvector, selector, clusterer);
+}
+
+model_merger
+merge_files(const std::vector<std::string> & paths, size_t nthreads)
+{
+    nthreads = std::max<size_t>(1, std::min(nthreads, paths.size()));
+
+    std::vector<model_merger> mergers(nthreads);
+    std::vector<std::string> errors(paths.size());
+    std::atomic<size_t> next(0);
+
+    auto work = [&](model_merger & merger) {
+        for (size_t n = next++; n < paths.size(); n = next++) {
+            try {
+                std::ifstream is(paths[n], std::ios::binary);
+                if (is.fail())
+                    throw tmg::exception("Cannot open file.");
+                merger.add(deserialize_document(is));
+            } catch (const std::exception & e) {
+                errors[n] = e.what();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t n = 1; n < nthreads; n++)
+        threads.emplace_back(work, std::ref(mergers[n]));
+    work(mergers[0]);
+    for (auto & thread : threads)
+        thread.join();
+
+    for (size_t n = 0; n < paths.size(); n++) {
+        if (!errors[n].empty())
+            throw tmg::exception(strfmt(paths[n], ": ", errors[n]));
+    }
+
+    for (size_t n = 1; n < nthreads; n++)
+        mergers[0].add(mergers[n]);
+
+    return std::move(mergers[0]);
+}
+
 }
@@ -0,0 +1,76 @@
+/**
+   @file    tmconvert.cc
+   @ingroup Frontend
+   @brief   Tuning Model Converter
+   @author  Nico Reissmann
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "binary_model.h"
+#include "serialization.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static void
+print_usage(const std::string & app)
+{
+    std::cerr << "Tuning Model Converter\n";
+    std::cerr << "Usage: " << app << " [-b|-j] INPUT OUTPUT\n";
+    std::cerr << "Converts a JSON tuning model to the binary format and a binary one to JSON.\n";
+    std::cerr << "  -b  write the binary format\n";
+    std::cerr << "  -j  write JSON\n";
+}
+
+int
+main(int argc, char * argv[])
+{
+    int first = 1;
+    int format = 0;
+    if (argc > 1 && (!strcmp(argv[1], "-b") || !strcmp(argv[1], "-j"))) {
+        format = argv[1][1];
+        first++;
+    }
+
+    if (argc - first != 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::ifstream is(argv[first], std::ios::binary);
+    if (is.fail()) {
+        std::cerr << "Cannot open tuning model " << argv[first] << "\n";
+        return 1;
+    }
+
+    bool binary = tmg::is_binary_model(is);
+    if (format == 0)
+        format = binary ? 'j' : 'b';
+
+    try {
+        auto document = tmg::deserialize_document(is);
+
+        std::ofstream os(argv[first + 1], std::ios::binary);
+        if (os.fail()) {
+            std::cerr << "Cannot write " << argv[first + 1] << "\n";
+            return 1;
+        }
+        os << (format == 'b' ? tmg::encode_binary(document) : tmg::serialize(document));
+    } catch (const std::exception & e) {
+        std::cerr << argv[first] << ": " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -16,44 +16,74 @@
    @endverbatim
  */
 
+#include "binary_model.h"
+#include "classifier.h"
 #include "clustering/clusterer.h"
 #include "clustering/distance.h"
 #include "clustering/vector.h"
 #include "merge.h"
 #include "serialization.h"
 
-#include <fstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
 static void
 print_usage(const std::string & app)
 {
     std::cerr << "Tuning Model Merger\n";
-    std::cerr << "Usage: " << app << " FILE [FILE]\n";
+    std::cerr << "Usage: " << app << " [-b] [-j THREADS] FILE [FILE...]\n";
+    std::cerr << "Merges JSON or binary tuning models and writes the result to standard output.\n";
+    std::cerr << "  -b          write the binary format instead of JSON\n";
+    std::cerr << "  -j THREADS  read the inputs with THREADS threads (default: all cores)\n";
 }
 
 int
 main(int argc, char * argv[])
 {
-    if (argc < 2)
-        print_usage(argv[0]);
+    bool binary = false;
+    size_t nthreads = std::max(1u, std::thread::hardware_concurrency());
 
-    std::vector<tmg::scenario_set> scnrvector;
-    for (ssize_t n = 1; n < argc; n++) {
-        std::ifstream is(argv[n]);
-        if (is.fail()) {
-            std::cerr << "Cannot open tuning model " << argv[n];
-            exit(1);
+    int first = 1;
+    for (; first < argc && argv[first][0] == '-'; first++) {
+        if (!strcmp(argv[first], "-b")) {
+            binary = true;
+        } else if (!strcmp(argv[first], "-j") && first + 1 < argc && atoi(argv[first + 1]) > 0) {
+            nthreads = atoi(argv[++first]);
+        } else {
+            print_usage(argv[0]);
+            return 1;
         }
+    }
 
-        scnrvector.push_back(deserialize(is, tmg::random_selector));
+    if (first == argc) {
+        print_usage(argv[0]);
+        return 1;
     }
 
     using namespace tmg::cluster;
 
-    hierarchical_clusterer c(euclidean_distance, centroid);
-    auto scenarios = tmg::merge(scnrvector, tmg::average_selector, c);
-    std::cout << serialize(scenarios, {});
+    try {
+        auto merger = tmg::merge_files(std::vector<std::string>(argv + first, argv + argc), nthreads);
+
+        for (const auto & conflict : merger.conflicts()) {
+            std::cerr << "Conflict: " << conflict.configurations.size()
+                      << " configurations for " << conflict.rts << ", keeping";
+            for (const auto & tv : conflict.configurations.front())
+                std::cerr << " " << tv.name << "=" << tv.value;
+            std::cerr << "\n";
+        }
+
+        hierarchical_clusterer c(euclidean_distance, centroid);
+        auto document = tmg::make_document(merger.merge(tmg::average_selector, c), {});
+        document.classifiers = tmg::train_classifiers(document);
+        std::cout << (binary ? tmg::encode_binary(document) : tmg::serialize(document));
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
 
     return 0;
 }
@@ -16,6 +16,7 @@
    @endverbatim
  */
 
+#include "classifier.h"
 #include "clustering/clusterer.h"
 #include "common.h"
 #include "conversion.h"
@@ -67,11 +68,11 @@ create_scenarios( const std::vector< std::unordered_set< tmg::rts* > >& clusters
     return scenarios;
 }
 
-std::string
-generate_tuning_model( const Rts*                                            root,
-                       const std::unordered_map< std::string, std::string >& input_ids,
-                       const tmg::cluster::clusterer&                        clusterer,
-                       const tmg::configuration_selector_t&                  selector ) {
+model_document
+generate_tuning_model_document( const Rts*                                            root,
+                                const std::unordered_map< std::string, std::string >& input_ids,
+                                const tmg::cluster::clusterer&                        clusterer,
+                                const tmg::configuration_selector_t&                  selector ) {
     auto old_rtss  = filter_rtss( root );
     auto new_rtss  = convert_rtss( old_rtss, input_ids );
     auto clusters  = clusterer.cluster( new_rtss );
@@ -79,7 +80,17 @@ generate_tuning_model( const Rts*                                            roo
 
     auto cphases = extract_cluster_phases( root );
 
-    return serialize( scenarios, cphases );
+    auto document = make_document( scenarios, cphases );
+    document.classifiers = train_classifiers( document );
+    return document;
+}
+
+std::string
+generate_tuning_model( const Rts*                                            root,
+                       const std::unordered_map< std::string, std::string >& input_ids,
+                       const tmg::cluster::clusterer&                        clusterer,
+                       const tmg::configuration_selector_t&                  selector ) {
+    return serialize( generate_tuning_model_document( root, input_ids, clusterer, selector ) );
 }
 
 }
@@ -25,6 +25,7 @@
 #include "ace/Reactor.h"
 
 #include "MetaProperty.h"
+#include "AgentLauncher.h"
 #include "hagent_accl_statemachine.h"
 using namespace hagent_accl_msm_namespace;
 
@@ -61,6 +62,7 @@ private:
     std::list< MetaProperty > properties;
     std::list< MetaProperty > properties_hotregionprop;
     bool                      gatherproperties_val;
+    AgentLauncher             launcher_;
 
 public:
     PeriscopeHLAgent( ACE_Reactor* r );
@@ -107,6 +109,13 @@ public:
 
     void set_reinit_startup_timer();
 
+    // launch the children listed for this agent in the launch plan
+    int launch_children( const std::string& plan );
+
+    AgentLauncher& launcher() {
+        return launcher_;
+    }
+
     void dontcluster() {
         nocluster = true;
     }
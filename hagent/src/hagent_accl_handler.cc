@@ -17,6 +17,7 @@
  */
 #include "hagent_accl_handler.h"
 #include "selective_debug.h"
+#include <algorithm>
 
 int ACCL_HLAgent_Handler::on_start( start_req_t&   req,
                                     start_reply_t& reply ) {
@@ -165,28 +166,30 @@ int ACCL_HLAgent_Handler::on_reinit( reinit_req_t&   req,
 
     ca = agent_->get_child_agents();
 
-    for( it = ca->begin(); it != ca->end(); it++ ) {
-        AgentInfo& ai = it->second;
+    // children stay alive across application restarts; only those that exited are launched again
+    std::vector< std::string > relaunched = agent_->launcher().relaunchDead();
 
-        if( ai.status != AgentInfo::CONNECTED ) {
-            if( agent_->connect_to_child( &ai ) == -1 ) {
+    for( it = ca->begin(); it != ca->end(); it++ ) {
+        AgentInfo& ai    = it->second;
+        bool       fresh = std::find( relaunched.begin(), relaunched.end(), it->first ) != relaunched.end();
+
+        if( ai.status != AgentInfo::CONNECTED || fresh ) {
+            int mapfrom[ 8192 ];
+            int mapto[ 8192 ];
+            for( int i = 0; i < req.maplen; i++ ) {
+                mapfrom[ i ] = req.idmap[ i ].idf;
+                mapto[ i ]   = req.idmap[ i ].idt;
+            }
+            if( agent_->reattach_child( &ai, fresh, req.maplen, mapfrom, mapto ) == -1 ) {
                 psc_errmsg( "Error connecting to child at %s:%d\n",
                             ai.hostname.c_str(), ai.port );
             }
-            else {
-                int mapfrom[ 8192 ];
-                int mapto[ 8192 ];
-                for( int i = 0; i < req.maplen; i++ ) {
-                    mapfrom[ i ] = req.idmap[ i ].idf;
-                    mapto[ i ]   = req.idmap[ i ].idt;
-                }
-                ai.handler->reinit( req.maplen, mapfrom, mapto );
-            }
         }
         ai.status_reinit = AgentInfo::INITIAL;
         // psc_dbgmsg(1,"testing child appexit: %d\n",ai.appexit);
     }
     psc_init_start_time();
+    agent_->heartbeats().restart( psc_wall_time() );
     agent_->set_reinit_startup_timer();
 
     return 0;
@@ -197,6 +200,15 @@ int ACCL_HLAgent_Handler::on_heartbeat( heartbeat_req_t&   req,
     psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ACECommunication ), "on_heartbeat from host = %s, port = %d, tag = %s, forwarded = %d, num_procs = %d\n",
                 req.hostname.c_str(), req.port, req.tag.c_str(), req.heartbeat_type, req.num_procs );
 
+    // summaries of the children's subtrees are aggregated and sent upstream by the liveness timer
+    if( req.heartbeat_type == SUBTREE_HEARTBEAT ) {
+        agent_->subtree_heartbeat( req.tag, req.subtree );
+        return 0;
+    }
+
+    // launch latency of the children started by this agent; forwarded tags are ignored
+    agent_->launcher().ready( req.tag );
+
 #ifdef _BGP_PORT_HEARTBEAT_V1
     std::map<std::string, AgentInfo>* ca;
     ca = agent_->get_child_agents();
@@ -214,6 +226,7 @@ int ACCL_HLAgent_Handler::on_heartbeat( heartbeat_req_t&   req,
         if( req.heartbeat_type == OWN_HEARTBEAT ) {
             //if it is not a forwarded heartbeat accept this agent as a direct child agent
             agent_->add_child_agent( req.tag, req.hostname, req.port );
+            agent_->heartbeats().beat( req.tag, req.num_procs, psc_wall_time() );
 
             /*  if (it->second.status==AgentInfo::INITIAL) { TODO Handle reinit cases properly here. Before accepting the child check whether it is
                                                              already there and check the status according to this code block
@@ -225,15 +238,12 @@ int ACCL_HLAgent_Handler::on_heartbeat( heartbeat_req_t&   req,
                it->second.status_reinit=AgentInfo::STARTED;
                } */
         }
-
-        if( agent_->get_parent_handler() ) {
-            agent_->get_parent_handler()->heartbeat( req.hostname, req.port, req.tag,
-                                                     FORWARDED_HEARTBEAT, req.num_procs );
-        }
         else {
-            psc_errmsg( " parent_handler_ not set\n" );
-            agent_->stop();
+            // processes an analysis agent connected to since its own heartbeat
+            agent_->heartbeats().addProcesses( req.tag, req.num_procs, psc_wall_time() );
         }
+
+        // not forwarded one by one: the next liveness tick sends the summary of the whole subtree
         psc_dbgmsg( 3, "Agent %s status=STARTED\n", req.tag.c_str() );
         break;
     case DISMISS_HEARTBEAT:
@@ -252,6 +262,7 @@ int ACCL_HLAgent_Handler::on_heartbeat( heartbeat_req_t&   req,
         if( it != ca->end() ) {
             ca->erase( it );
         }
+        agent_->heartbeats().forget( req.tag );
 
         if( agent_->get_parent_handler() ) {
             agent_->get_parent_handler()->heartbeat( req.hostname, req.port, req.tag,
@@ -284,6 +295,13 @@ int ACCL_HLAgent_Handler::on_heartbeat( heartbeat_req_t&   req,
     std::map<std::string, AgentInfo>*          ca;
     std::map<std::string, AgentInfo>::iterator it;
 
+    if( req.heartbeat_type == FORWARDED_HEARTBEAT ) {
+        agent_->heartbeats().addProcesses( req.tag, req.num_procs, psc_wall_time() );
+    }
+    else {
+        agent_->heartbeats().beat( req.tag, req.num_procs, psc_wall_time() );
+    }
+
     ca = agent_->get_child_agents();
     for( it = ca->begin(); it != ca->end(); it++ ) {
         if( it->second.tag == req.tag ) {
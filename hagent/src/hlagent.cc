@@ -116,6 +116,9 @@ void PeriscopeHLAgent::run() {
         }
         startup_mode_on();
 #endif
+        // the heartbeats of the children reach the parent as one summary per tick
+        start_liveness( heartbeats_.interval() );
+
         //TODO add timerless logic in the hagent goes here (now a runtime flag, instead of a configure variable)
         reactor->run_event_loop();
     }
@@ -150,6 +153,16 @@ int PeriscopeHLAgent::handle_input( ACE_HANDLE hdle ) {
 }
 
 
+int PeriscopeHLAgent::launch_children( const std::string& plan ) {
+    int count = launcher_.readPlan( plan, get_local_tag() );
+    if( count >= 0 ) {
+        psc_dbgmsg( 2, "Launching %d child agents from %s\n", count, plan.c_str() );
+        launcher_.dispatch();
+    }
+    return count;
+}
+
+
 void PeriscopeHLAgent::set_reinit_startup_timer() {
     set_timer( 2, 1, timeout_delta(), PeriscopeHLAgent::STARTUP_REINIT );
 }
@@ -163,6 +176,8 @@ int PeriscopeHLAgent::handle_timeout( const ACE_Time_Value& time,
 
     switch( timer_action ) {
     case STARTUP:
+        // children that did not report within the stale interval free their launch slot
+        launcher_.dispatch();
 
         for( it = child_agents_.begin(); it != child_agents_.end(); it++ ) {
             if( it->second.status != AgentInfo::STARTED ) {
@@ -291,9 +306,7 @@ void PeriscopeHLAgent::found_property( std::string& propData ) {
         psc_dbgmsg( 11, "*** Should try to cluster: %s with sev %f on proc %d\n",
                     prop.getName().c_str(), prop.getSeverity(), prop.getProcess() );
 
-        std::string            prop_name = prop.getName().c_str();
-        std::string::size_type p_loc     = prop_name.find( ":::::", 0 );
-        if( p_loc != std::string::npos ) {
+        if( prop.isInternal() ) {
             properties_hotregionprop.push_back( prop );
         }
         else {
@@ -50,6 +50,8 @@ struct cmdline_opts {
     int has_gatherprop;
     int has_dontcluster;
     int has_tag;
+    int has_launchplan;
+    int has_heartbeat;
 
     char appname_string[ 2000 ];
     char debug_string[ 2000 ];
@@ -60,6 +62,8 @@ struct cmdline_opts {
     char children_string[ 2000 ];
     char timeout_string[ 2000 ];
     char tag_string[ 2000 ];
+    char launchplan_string[ 2000 ];
+    char heartbeat_string[ 2000 ];
 
     cmdline_opts() {
         has_registry       = 0;
@@ -73,6 +77,8 @@ struct cmdline_opts {
         has_dontcluster    = 0;
         has_gatherprop     = 0;
         has_selectivedebug = 0;
+        has_launchplan     = 0;
+        has_heartbeat      = 0;
     }
 };
 
@@ -107,6 +113,8 @@ int parse_opts( int                  argc,
         { "dontcluster",            no_argument,       0,         'l' },
 //TODO: Revise unused stuff. tag seems to be used only by HL and AA. -RM
         { "tag",                    required_argument, 0,         'm' },
+        { "launch-plan",            required_argument, 0,         'n' },
+        { "heartbeat-deadline",     required_argument, 0,         'o' },
         0
     };
 
@@ -205,6 +213,20 @@ int parse_opts( int                  argc,
             }
             break;
 
+        case 'n':
+            if( opt->has_arg == required_argument ) {
+                copts->has_launchplan = 1;
+                strcpy( copts->launchplan_string, optarg );
+            }
+            break;
+
+        case 'o':
+            if( opt->has_arg == required_argument ) {
+                copts->has_heartbeat = 1;
+                strcpy( copts->heartbeat_string, optarg );
+            }
+            break;
+
         default:
             // some other / unknown option specified
             return -1;
@@ -232,6 +254,8 @@ void usage( int   argc,
     fprintf( stderr, "  [--dontcluster]          (Don't cluster properties)\n" );
     fprintf( stderr, "  [--gatherprop]           (Gather properties)\n" );
     fprintf( stderr, "  [--children=childtag,childtab] \n" );
+    fprintf( stderr, "  [--launch-plan=file]     (Launch the children listed for this agent in the plan)\n" );
+    fprintf( stderr, "  [--heartbeat-deadline=secs] (Report child agents silent for longer, 0 to disable)\n" );
 }
 
 
@@ -432,6 +456,15 @@ int main( int   argc,
 
     psc_dbgmsg( 5, "Using %d seconds timeout\n", timeout );
 
+    if( opts.has_heartbeat ) {
+        double deadline = atof( opts.heartbeat_string );
+        if( deadline < 0 ) {
+            psc_errmsg( "Bad value for heartbeat deadline: %s\n", opts.heartbeat_string );
+            exit( 1 );
+        }
+        agent.heartbeats().setDeadline( deadline );
+    }
+
 
 
     // -----------------------
@@ -519,6 +552,10 @@ int main( int   argc,
     }
 #endif
 
+    if( opts.has_launchplan && agent.launch_children( opts.launchplan_string ) == -1 ) {
+        exit( 1 );
+    }
+
     agent.run();
     ACE_Reactor::instance()->close();
 }
@@ -1,7 +1,7 @@
 AC_DEFUN([AC_PSC_STARTER], [
   AC_MSG_NOTICE([Checking for starter...])
   AC_ARG_WITH([starter],
-              AS_HELP_STRING([--with-starter=(supermuc|slurm)],
+              AS_HELP_STRING([--with-starter=(supermuc|slurm|localfork)],
                              [Select the application starter.]),
               [enable_starter="${withval}"],
               [AC_MSG_ERROR([No starter selected. (use --with-starter)])])
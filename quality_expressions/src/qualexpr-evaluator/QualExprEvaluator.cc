@@ -444,7 +444,7 @@ void QualExprSemanticAggregatorDB::display( const std::string& indent,
 /* Constructor */ QualExprEvaluator::QualExprEvaluator( void ) :
     m_semanticRootNamespace( "" ), m_aggregatorRootNamespace( "" ),
     m_semanticAggregatorDB( m_semanticRootNamespace, m_aggregatorRootNamespace ),
-    m_computeNodeDB(), m_parser( *new QualExprEvaluatorParsingDriver( m_semanticAggregatorDB ) ) {
+    m_computeNodeDB(), m_programDB(), m_compiler(), m_parser( *new QualExprEvaluatorParsingDriver( m_semanticAggregatorDB ) ) {
     QualExprAggregatorImmediate::registerToAggregatorNS( m_aggregatorRootNamespace );
     QualExprAggregatorTime::registerToAggregatorNS( m_aggregatorRootNamespace );
     QualExprAggregatorSize::registerToAggregatorNS( m_aggregatorRootNamespace );
@@ -462,6 +462,10 @@ void QualExprEvaluator::clearMeasures( void ) {
         delete ite->second;
     }
     m_computeNodeDB.clear();
+    for( ProgramDB_t::iterator ite = m_programDB.begin(); ite != m_programDB.end(); ite++ ) {
+        delete ite->second;
+    }
+    m_programDB.clear();
 }
 
 /** @brief Parse a quality expresion and register the corresponding aggregators.
@@ -488,6 +492,14 @@ size_t QualExprEvaluator::pushMeasure( const QualityExpressionEntry& qualExprEnt
         }
 
         m_computeNodeDB[ entryID ] = newAggregNode;
+
+        QualExprComputeNodeOf<long64_t>* longNode = dynamic_cast<QualExprComputeNodeOf<long64_t>*>( newAggregNode );
+        if( longNode ) {
+            // replaces the program of an entry registered before
+            QualExprBytecode<long64_t>*& program = m_programDB[ entryID ];
+            delete program;
+            program = m_compiler.build( longNode->compile( m_compiler ) );
+        }
     }
     catch( QualExprEvaluatorParsingDriver::Exception e ) {
         std::stringstream s;
@@ -522,9 +534,21 @@ void QualExprEvaluator::display( const std::string& indent,
 }
 
 /** @brief Retreive the value of a semantic aggregator by its ID.
+    The compiled bytecode of the expression is used when available.
     Throw an exception if no aggregator is found with the given ID.
  */
 long64_t QualExprEvaluator::getLongCounter( QualityExpressionID_T id ) throw( QualExprEvaluator::Exception )          {
+    ProgramDB_t::iterator prog = m_programDB.find( id );
+    if( prog != m_programDB.end() ) {
+        return prog->second->eval();
+    }
+    return evalLongCounterTree( id );
+}
+
+/** @brief Retreive the value of a semantic aggregator by its ID by walking the compute node tree.
+    Throw an exception if no aggregator is found with the given ID.
+ */
+long64_t QualExprEvaluator::evalLongCounterTree( QualityExpressionID_T id ) throw( QualExprEvaluator::Exception )          {
     ComputeNodeDB_t::iterator ite = m_computeNodeDB.find( id );
     if( ite == m_computeNodeDB.end() ) {
         throw( Exception( "Quality expression not found" ) );
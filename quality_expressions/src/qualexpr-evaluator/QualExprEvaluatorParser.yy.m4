@@ -81,22 +81,8 @@ ifelse(BISON_VERSION, 23, %{, %code requires {)
     const std::string *	m_name;
   } aggregator_desc_t;
 
-  // Operator templates
-#define BIN_OPERATOR( name, computation, show )                                                                             \
-  template<typename kind> class name {                                                                                      \
-  public:	static inline kind compute(kind a, kind b)					{ return computation ; }    \
-  public:	static inline void display(const std::string &indent, std::stringstream &s)	{ show; }                   \
-  };
-
-BIN_OPERATOR( list,   a,  s << ';' );
-BIN_OPERATOR( lt,   a<b,  s << '<' );
-BIN_OPERATOR( gt,   a>b,  s << '>' );
-BIN_OPERATOR( le,   a<=b, s << "<=" );
-BIN_OPERATOR( ge,   a>=b, s << ">=" );
-BIN_OPERATOR( add,  a+b,  s << '+' );
-BIN_OPERATOR( sub,  a-b,  s << '-' );
-BIN_OPERATOR( mul,  a*b,  s << '*' );
-BIN_OPERATOR( divi, b!=0 ? a/b : 0,  s << '/' );
+  // Operator templates, shared with the bytecode compiler
+# include "qualexpr-evaluator/QualExprOperators.h"
 
 ifelse(BISON_VERSION, 23, %}, })
 
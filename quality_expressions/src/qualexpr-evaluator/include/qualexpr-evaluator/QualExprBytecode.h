@@ -0,0 +1,291 @@
+/**
+   @file    QualExprBytecode.h
+   @ingroup QualityExpressionEvaluation
+   @brief   Evaluation of quality expressions - Register based bytecode and its compiler
+   @author  Laurent Morin
+   @verbatim
+   Revision:       $Revision$
+   Revision date:  $Date$
+   Committed by:   $Author$
+
+   This file is part of the Periscope performance measurement tool.
+   See http://www.lrr.in.tum.de/periscope for details.
+
+   Copyright (c) 2005-2014, Technische Universitaet Muenchen, Germany
+   See the COPYING file in the base directory of the package for details.
+
+   @endverbatim
+ */
+
+#ifndef QUALEXP_BYTECODE_H_
+#define QUALEXP_BYTECODE_H_
+
+#include <iomanip>
+#include <map>
+#include <vector>
+#include <utility>
+
+#include "qualexpr-evaluator/QualExprOperators.h"
+
+namespace quality_expressions_core {
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+/**
+   @class QualExprBytecode
+   @brief Flat register based program equivalent to a compute node tree.
+   @param kind The numeric type used for the computation.
+   @ingroup QualityExpressionEvaluation
+
+   Constants are stored once in the register file when the program is built; instructions only write
+   the remaining registers. The evaluation is a single loop over the instruction array, without any
+   virtual call except the final read of the aggregator values.
+ */
+template<typename kind>
+class QualExprBytecode {
+public:
+    /** @brief One three address instruction: dst = lhs op rhs, or dst = source[lhs] for a load. */
+    typedef struct {
+        QualExprOpcode m_op;
+        unsigned int   m_dst;
+        unsigned int   m_lhs;
+        unsigned int   m_rhs;
+    } Instruction;
+
+public:
+    /* Constructor */ QualExprBytecode( void ) : m_constantCount( 0 ), m_result( 0 ) {
+    }
+
+    /* Destructor */ ~QualExprBytecode( void ) {
+    }
+
+public:   // -- Access API
+    void display( const std::string& indent, std::stringstream& s ) const {
+        for( size_t index = 0; index < m_constantCount; index++ ) {
+            s << indent << "r" << index << " = " << std::setprecision( 24 ) << m_registers[ index ];
+        }
+        for( size_t index = 0; index < m_code.size(); index++ ) {
+            const Instruction& i = m_code[ index ];
+            s << indent << "r" << i.m_dst << " = ";
+            if( i.m_op == QE_OP_LOAD ) {
+                s << "load " << m_sources[ i.m_lhs ]->getId();
+            }
+            else {
+                s << "op" << i.m_op << " r" << i.m_lhs << ", r" << i.m_rhs;
+            }
+        }
+        s << indent << "return r" << m_result;
+    }
+
+    size_t instructionCount( void ) const {
+        return m_code.size();
+    }                                                                   //!< Number of instructions executed per evaluation.
+
+    size_t registerCount( void ) const {
+        return m_registers.size();
+    }                                                                   //!< Size of the register file, constants included.
+
+public:   // -- Evaluation API
+    /** @brief Run the program and return the value of the result register. */
+    kind eval( void ) {
+        kind*                                 r      = &m_registers[ 0 ];
+        const QualExprAggregatorEval<kind>**  source = m_sources.empty() ? NULL : &m_sources[ 0 ];
+        const Instruction*                    i      = m_code.empty() ? NULL : &m_code[ 0 ];
+        const Instruction*                    end    = i + m_code.size();
+
+        for(; i != end; i++ ) {
+            switch( i->m_op ) {
+            case QE_OP_LOAD:
+                r[ i->m_dst ] = source[ i->m_lhs ]->evaluate();
+                break;
+            case QE_OP_LIST:
+                r[ i->m_dst ] = r[ i->m_lhs ];
+                break;
+            case QE_OP_LT:
+                r[ i->m_dst ] = r[ i->m_lhs ] < r[ i->m_rhs ];
+                break;
+            case QE_OP_GT:
+                r[ i->m_dst ] = r[ i->m_lhs ] > r[ i->m_rhs ];
+                break;
+            case QE_OP_LE:
+                r[ i->m_dst ] = r[ i->m_lhs ] <= r[ i->m_rhs ];
+                break;
+            case QE_OP_GE:
+                r[ i->m_dst ] = r[ i->m_lhs ] >= r[ i->m_rhs ];
+                break;
+            case QE_OP_ADD:
+                r[ i->m_dst ] = r[ i->m_lhs ] + r[ i->m_rhs ];
+                break;
+            case QE_OP_SUB:
+                r[ i->m_dst ] = r[ i->m_lhs ] - r[ i->m_rhs ];
+                break;
+            case QE_OP_MUL:
+                r[ i->m_dst ] = r[ i->m_lhs ] * r[ i->m_rhs ];
+                break;
+            case QE_OP_DIV:
+                r[ i->m_dst ] = r[ i->m_rhs ] != 0 ? r[ i->m_lhs ] / r[ i->m_rhs ] : 0;
+                break;
+            }
+        }
+        return r[ m_result ];
+    }
+
+private:
+    template<typename> friend class QualExprBytecodeCompiler;
+
+    std::vector<kind>                                m_registers;                //!< Register file, constants first.
+    std::vector<const QualExprAggregatorEval<kind>*> m_sources;                  //!< Aggregators read by the load instructions.
+    std::vector<Instruction>                         m_code;                     //!< Instructions in execution order.
+    size_t                                           m_constantCount;            //!< Number of constant registers.
+    unsigned int                                     m_result;                   //!< Register holding the final value.
+};
+
+/**
+   @class QualExprBytecodeCompiler
+   @brief Translate a compute node tree into a QualExprBytecode program.
+   @param kind The numeric type used for the computation.
+   @ingroup QualityExpressionEvaluation
+
+   Compute nodes emit themselves through QualExprComputeNodeOf::compile(). While doing so, the compiler:
+   - folds any operation whose operands are both constants,
+   - reuses the register of an identical load or operation (common subexpression elimination),
+   - never emits the right operand of an expression list, which does not contribute to the result.
+ */
+template<typename kind>
+class QualExprBytecodeCompiler {
+public:
+    /* Constructor */ QualExprBytecodeCompiler( void ) {
+    }
+
+    /* Destructor */ ~QualExprBytecodeCompiler( void ) {
+    }
+
+public:   // -- Emission API, used by the compute nodes
+    /** @brief Return the register holding the given constant. */
+    unsigned int constant( kind value ) {
+        typename ConstantDB_t::iterator ite = m_constants.find( value );
+        if( ite != m_constants.end() ) {
+            return ite->second;
+        }
+        unsigned int reg = newRegister( true, value );
+        m_constants[ value ] = reg;
+        return reg;
+    }
+
+    /** @brief Return the register holding the value of an aggregator.
+        An aggregator unable to provide the requested kind evaluates to the neutral value, as the tree does.
+     */
+    unsigned int load( const QualExprAggregatorEval<kind>* aggregator, kind neutralValue = 0 ) {
+        if( !aggregator ) {
+            return constant( neutralValue );
+        }
+        typename LoadDB_t::iterator ite = m_loads.find( aggregator );
+        if( ite != m_loads.end() ) {
+            return ite->second;
+        }
+        unsigned int source = m_program.m_sources.size();
+        m_program.m_sources.push_back( aggregator );
+        unsigned int reg = emit( QE_OP_LOAD, source, 0 );
+        m_loads[ aggregator ] = reg;
+        return reg;
+    }
+
+    /** @brief Return the register holding lhs op rhs. */
+    unsigned int binary( QualExprOpcode op, unsigned int lhs, unsigned int rhs ) {
+        if( isConstant( lhs ) && isConstant( rhs ) ) {
+            return constant( qualExprApply<kind>( op, m_registers[ lhs ].second, m_registers[ rhs ].second ) );
+        }
+        if( ( op == QE_OP_ADD || op == QE_OP_MUL ) && lhs > rhs ) {
+            std::swap( lhs, rhs );
+        }
+        typename OperationDB_t::key_type key( op, std::make_pair( lhs, rhs ) );
+        typename OperationDB_t::iterator ite = m_operations.find( key );
+        if( ite != m_operations.end() ) {
+            return ite->second;
+        }
+        unsigned int reg = emit( op, lhs, rhs );
+        m_operations[ key ] = reg;
+        return reg;
+    }
+
+    bool isConstant( unsigned int reg ) const {
+        return m_registers[ reg ].first;
+    }
+
+public:   // -- Program construction API
+    /** @brief Finalize the program; registers are renumbered so that constants come first.
+        @param result register returned by the compilation of the root node.
+        @return the program, owned by the caller.
+     */
+    QualExprBytecode<kind>* build( unsigned int result ) {
+        std::vector<unsigned int> renumber( m_registers.size() );
+        unsigned int              next = 0;
+
+        for( size_t index = 0; index < m_registers.size(); index++ ) {
+            if( m_registers[ index ].first ) {
+                renumber[ index ] = next++;
+                m_program.m_registers.push_back( m_registers[ index ].second );
+            }
+        }
+        m_program.m_constantCount = next;
+        for( size_t index = 0; index < m_registers.size(); index++ ) {
+            if( !m_registers[ index ].first ) {
+                renumber[ index ] = next++;
+                m_program.m_registers.push_back( 0 );
+            }
+        }
+        for( size_t index = 0; index < m_program.m_code.size(); index++ ) {
+            typename QualExprBytecode<kind>::Instruction& i = m_program.m_code[ index ];
+            i.m_dst = renumber[ i.m_dst ];
+            if( i.m_op != QE_OP_LOAD ) {
+                i.m_lhs = renumber[ i.m_lhs ];
+                i.m_rhs = renumber[ i.m_rhs ];
+            }
+        }
+        m_program.m_result = renumber[ result ];
+
+        QualExprBytecode<kind>* program = new QualExprBytecode<kind>( m_program );
+        clear();
+        return program;
+    }
+
+private:
+    typedef std::map<kind, unsigned int>                                                    ConstantDB_t;
+    typedef std::map<const QualExprAggregatorEval<kind>*, unsigned int>                     LoadDB_t;
+    typedef std::map<std::pair<int, std::pair<unsigned int, unsigned int> >, unsigned int> OperationDB_t;
+
+    unsigned int newRegister( bool isConstant, kind value ) {
+        m_registers.push_back( std::make_pair( isConstant, value ) );
+        return m_registers.size() - 1;
+    }
+
+    unsigned int emit( QualExprOpcode op, unsigned int lhs, unsigned int rhs ) {
+        typename QualExprBytecode<kind>::Instruction i;
+        i.m_op  = op;
+        i.m_dst = newRegister( false, 0 );
+        i.m_lhs = lhs;
+        i.m_rhs = rhs;
+        m_program.m_code.push_back( i );
+        return i.m_dst;
+    }
+
+    void clear( void ) {
+        m_program = QualExprBytecode<kind>();
+        m_registers.clear();
+        m_constants.clear();
+        m_loads.clear();
+        m_operations.clear();
+    }
+
+private:
+    QualExprBytecode<kind>              m_program;                      //!< Program under construction.
+    std::vector<std::pair<bool, kind> > m_registers;                    //!< Registers in creation order, with their constant value if any.
+    ConstantDB_t                        m_constants;                    //!< Constant pool.
+    LoadDB_t                            m_loads;                        //!< Loads already emitted.
+    OperationDB_t                       m_operations;                   //!< Operations already emitted.
+};
+}
+
+#endif
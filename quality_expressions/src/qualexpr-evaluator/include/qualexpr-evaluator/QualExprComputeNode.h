@@ -20,6 +20,8 @@
 #ifndef QUALEXP_COMPUTE_NODE_H_
 #define QUALEXP_COMPUTE_NODE_H_
 
+#include "qualexpr-evaluator/QualExprBytecode.h"
+
 namespace quality_expressions_core {
 /* ---------------------------------------------------------------------------------------------------------------- */
 /* ---------------------------------------------------------------------------------------------------------------- */
@@ -64,6 +66,8 @@ public:   // -- Access API
 
     virtual kind eval( void ) = 0;
 
+    virtual unsigned int compile( QualExprBytecodeCompiler<kind>& compiler ) const = 0;          //!< Emit the node into a bytecode program, return the result register.
+
 protected:
     /* Constructor */ QualExprComputeNodeOf( void ) {
     }
@@ -91,6 +95,10 @@ public:   // -- Access API
     virtual kind eval( void ) {
         return m_value;
     }
+
+    virtual unsigned int compile( QualExprBytecodeCompiler<kind>& compiler ) const {
+        return compiler.constant( m_value );
+    }
 private:
     kind m_value;
 };
@@ -118,6 +126,10 @@ public:   // -- Access API
         return m_semanticAggregator.evaluate<kind>();
     }
 
+    virtual unsigned int compile( QualExprBytecodeCompiler<kind>& compiler ) const {
+        return compiler.load( m_semanticAggregator.evaluator<kind>() );
+    }
+
 private:
     QualExprSemanticAggregator& m_semanticAggregator;                           //!< Semantic aggregators.
 };
@@ -148,6 +160,14 @@ public:   // -- Access API
         return arithmetic::compute( m_lhs.eval(), m_rhs.eval() );
     }
 
+    virtual unsigned int compile( QualExprBytecodeCompiler<kind>& compiler ) const {
+        unsigned int lhs = m_lhs.compile( compiler );
+        if( arithmetic::code == QE_OP_LIST ) {
+            return lhs;
+        }
+        return compiler.binary( arithmetic::code, lhs, m_rhs.compile( compiler ) );
+    }
+
 private:
     QualExprComputeNodeOf<kind>& m_lhs;
     QualExprComputeNodeOf<kind>& m_rhs;
@@ -121,6 +121,8 @@ public:
 
     long64_t getLongCounter( QualityExpressionID_T id ) throw( Exception );   //!< Return the current value of a quality expression by its ID.
 
+    long64_t evalLongCounterTree( QualityExpressionID_T id ) throw( Exception );  //!< Same as getLongCounter, but walks the compute node tree - reference path.
+
 public:                                                              // -- Namespace management API
     void registerSemanticNamespace( const QualExprSemanticNamespace& ns ) { //!< Append the given namespace to the root semantic namespace.
         m_semanticRootNamespace.registerNewNamespace( ns );
@@ -128,11 +130,14 @@ public:                                                              // -- Names
 
 private:
     typedef std::map<QualityExpressionID_T, QualExprComputeNode*> ComputeNodeDB_t; //!< Storage type choosen for the compute nodes.
+    typedef std::map<QualityExpressionID_T, QualExprBytecode<long64_t>*> ProgramDB_t; //!< Storage type choosen for the compiled expressions.
 
     QualExprSemanticNamespaceStem   m_semanticRootNamespace;                       //!< Container for the root namespace of semantics.
     QualExprAggregatorNamespace     m_aggregatorRootNamespace;                     //!< Container for the root namespace of aggregators.
     QualExprSemanticAggregatorDB    m_semanticAggregatorDB;                        //!< Database containing all semantic aggregators.
     ComputeNodeDB_t                 m_computeNodeDB;                               //!< Database containing all compute nodes by ID.
+    ProgramDB_t                     m_programDB;                                   //!< Database containing the bytecode of all compute nodes by ID.
+    QualExprBytecodeCompiler<long64_t> m_compiler;                                 //!< Compute node to bytecode compiler.
     QualExprEvaluatorParsingDriver& m_parser;                                      //!< Quality expression Parser and arithmetic builder.
 };
 }
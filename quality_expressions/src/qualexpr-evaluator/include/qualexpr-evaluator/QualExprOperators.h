@@ -0,0 +1,96 @@
+/**
+   @file    QualExprOperators.h
+   @ingroup QualityExpressionEvaluation
+   @brief   Evaluation of quality expressions - Arithmetic operators and their opcodes
+   @author  Laurent Morin
+   @verbatim
+   Revision:       $Revision$
+   Revision date:  $Date$
+   Committed by:   $Author$
+
+   This file is part of the Periscope performance measurement tool.
+   See http://www.lrr.in.tum.de/periscope for details.
+
+   Copyright (c) 2005-2014, Technische Universitaet Muenchen, Germany
+   See the COPYING file in the base directory of the package for details.
+
+   @endverbatim
+ */
+
+#ifndef QUALEXP_OPERATORS_H_
+#define QUALEXP_OPERATORS_H_
+
+#include <string>
+#include <sstream>
+
+namespace quality_expressions_core {
+/**
+   @brief Opcodes of the quality expression bytecode.
+   @ingroup QualityExpressionEvaluation
+
+   Every binary operator of the grammar owns one opcode, shared by the compute node tree and by
+   the bytecode interpreter so that both evaluation paths perform the exact same computation.
+ */
+typedef enum {
+    QE_OP_LOAD = 0,                                     //!< Load the value of a semantic aggregator.
+    QE_OP_LIST,                                         //!< Expression list, keeps the left operand.
+    QE_OP_LT,
+    QE_OP_GT,
+    QE_OP_LE,
+    QE_OP_GE,
+    QE_OP_ADD,
+    QE_OP_SUB,
+    QE_OP_MUL,
+    QE_OP_DIV
+} QualExprOpcode;
+
+/**
+   @brief Apply a binary opcode on two operands.
+   @ingroup QualityExpressionEvaluation
+ */
+template<typename kind>
+static inline kind qualExprApply( QualExprOpcode op, kind a, kind b ) {
+    switch( op ) {
+    case QE_OP_LIST:
+        return a;
+    case QE_OP_LT:
+        return a < b;
+    case QE_OP_GT:
+        return a > b;
+    case QE_OP_LE:
+        return a <= b;
+    case QE_OP_GE:
+        return a >= b;
+    case QE_OP_ADD:
+        return a + b;
+    case QE_OP_SUB:
+        return a - b;
+    case QE_OP_MUL:
+        return a * b;
+    case QE_OP_DIV:
+        return b != 0 ? a / b : 0;
+    default:
+        return 0;
+    }
+}
+
+// Operator templates
+#define BIN_OPERATOR( name, opcode, show )                                                                                  \
+    template<typename kind> class name {                                                                                    \
+public:    static const QualExprOpcode code = opcode;                                                                       \
+public:    static inline kind compute( kind a, kind b )                                  { return qualExprApply( opcode, a, b ); } \
+public:    static inline void display( const std::string&, std::stringstream& s )        { show; }                         \
+    };
+
+BIN_OPERATOR( list, QE_OP_LIST, s << ';' );
+BIN_OPERATOR( lt,   QE_OP_LT,   s << '<' );
+BIN_OPERATOR( gt,   QE_OP_GT,   s << '>' );
+BIN_OPERATOR( le,   QE_OP_LE,   s << "<=" );
+BIN_OPERATOR( ge,   QE_OP_GE,   s << ">=" );
+BIN_OPERATOR( add,  QE_OP_ADD,  s << '+' );
+BIN_OPERATOR( sub,  QE_OP_SUB,  s << '-' );
+BIN_OPERATOR( mul,  QE_OP_MUL,  s << '*' );
+BIN_OPERATOR( divi, QE_OP_DIV,  s << '/' );
+}
+
+#endif
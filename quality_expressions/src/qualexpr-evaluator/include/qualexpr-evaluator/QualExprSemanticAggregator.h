@@ -92,6 +92,14 @@ public:   // -- Semantic aggregation API
         return aggregator ? aggregator->evaluate() : neutralValue;
     }
 
+    /** @brief Aggregator evaluation interface for a numeric kind, NULL if the aggregator does not provide it.
+        Used by the bytecode compiler to resolve the aggregator type once instead of at every evaluation.
+     */
+    template <typename kind>
+    const QualExprAggregatorEval<kind>* evaluator( void ) const {
+        return dynamic_cast<const QualExprAggregatorEval<kind>*>( &m_aggregator );
+    }
+
 private:
     const QualExprSemantic& m_sem;                                                      //!< The semantic descriptor.
     QualExprAggregator&     m_aggregator;                                               //!< The event aggregator.
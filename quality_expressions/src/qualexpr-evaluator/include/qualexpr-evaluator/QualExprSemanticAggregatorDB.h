@@ -57,7 +57,7 @@ public:   // -- Access API
 
 public:                                                                     // -- Semantic aggregation API
     QualExprSemanticAggregator& pushAggregator( const QualityExpression& qualExpr ) throw( Exception ); //!< Parse and build a semantic aggregator. @return the aggregator ID
-    .
+
     QualExprSemanticAggregator&
     pushAggregator( const std::string& eventName,
                     const std::string aggregName ) throw( Exception );                                                                  //!< Build a semantic aggregator. @return the aggregator ID.
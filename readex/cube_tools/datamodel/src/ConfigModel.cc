@@ -184,6 +184,7 @@ ConfigModel::createTemplate()
     //Add tuning_model file path
     ptree tuning_model;
     tuning_model.put( "file_path", string() );
+    tuning_model.put( "format", "json" );
     XMLConfigTree.add_child( "Configuration.periscope.tuningModel", tuning_model );
 
     //Add tuning_model file path
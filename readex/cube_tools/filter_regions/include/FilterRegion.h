@@ -23,6 +23,8 @@
 #include <cubelib/Cube.h>
 #include <cubelib/CubeServices.h>
 
+#include "OverheadModel.h"
+
 using namespace std;
 using namespace cube;
 
@@ -36,11 +38,15 @@ using namespace cube;
 bool
 isAllowedforFilter( const Cnode* c_node );
 
+/*
+ * Adds the runtime, the region visits and the protected regions of a profile to the model
+ */
 void
-FilterCNodes( const vector< Cnode* >& call_nodes,
-              Cube*                   in_cube,
-              double                  threshold,
-              vector< Cnode* >&       filt_nodes );
+ModelCNodes( Cube*                  in_cube,
+             double                 threshold,
+             const string&          phase_name,
+             OverheadModel&         model,
+             map< string, string >& display_names );
 
 /**
  * Prints out the help how to use this tool.
@@ -49,9 +55,12 @@ FilterCNodes( const vector< Cnode* >& call_nodes,
 void
 usage( const char* filename )
 {
-    cout << "Usage: " << filename << " [-t threshold] [-f filter_file_name] [-h] <cubefile>\n";
+    cout << "Usage: " << filename << " [-t threshold] [-b budget] [-e overhead] [-p phase] [-f filter_file_name] [-h] <cubefile>...\n";
     cout << "  -h     Help; Output this help message\n";
-    cout << "  -t     Choose threshold for granularity in Seconds (defaults to 0.1s)\n";
+    cout << "  -t     Choose threshold for granularity in Seconds; coarser regions are never filtered (defaults to 0.1s)\n";
+    cout << "  -b     Target instrumentation overhead in percent of the runtime (defaults to 5); 0 filters all fine regions\n";
+    cout << "  -e     Overhead per enter or exit event in seconds (calibrated from several cube files, 3e-7 otherwise)\n";
+    cout << "  -p     Name of the phase region; it and its callers are never filtered\n";
     cout << "  -f     Name of the filter file without extension (default name scorep.filt)\n";
     cout << "  -i     Name of the intel compiler filter file without extension\n";
     exit( 0 );
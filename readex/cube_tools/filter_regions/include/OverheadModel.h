@@ -0,0 +1,131 @@
+/**
+   @file    OverheadModel.h
+   @ingroup READEX
+   @brief   Instrumentation overhead model of scorep-autofilter
+   @verbatim
+   Revision:       $Revision$
+   Revision date:  $Date$
+   Committed by:   $Author$
+
+   This file is part of READEX.
+
+   Copyright (c) 2016, Technische Universitaet Muenchen, Germany
+   See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef READEX_OVERHEAD_MODEL_H
+#define READEX_OVERHEAD_MODEL_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Predicts the instrumentation overhead of a filter from the visits of the regions.
+ *
+ * Every visit of an instrumented region costs two events, enter and exit, of eventOverhead()
+ * seconds each. The model collects the runtime and the region visits of one or more runs, for
+ * instance of the successive instrument and filter iterations of an application. A region costs
+ * what its largest number of visits in any run costs, so regions already filtered in a later run
+ * keep the cost they had before. The uninstrumented runtime is estimated as the smallest runtime
+ * minus instrumentation cost over the runs, and overheads are relative to it.
+ */
+class OverheadModel
+{
+public:
+    /** Seconds per event used until calibrate() or setEventOverhead() is called */
+    static const double defaultEventOverhead;
+
+    OverheadModel();
+
+    /** Add a run with its runtime in seconds; returns its index */
+    size_t
+    addRun( double runtime );
+
+    /** Record visits of a region in a run; visits of several call paths add up */
+    void
+    addVisits( size_t             run,
+               const std::string& region,
+               double             count );
+
+    /** Never exclude the region, e.g. a significant region, a phase ancestor or an MPI call */
+    void
+    protect( const std::string& region );
+
+    bool
+    isProtected( const std::string& region ) const
+    {
+        return protected_regions.count( region ) > 0;
+    }
+
+    void
+    setEventOverhead( double seconds )
+    {
+        event_overhead = seconds;
+    }
+
+    double
+    eventOverhead() const
+    {
+        return event_overhead;
+    }
+
+    /**
+     * Fit the event overhead to the runs by least squares of runtime over events. Needs at least
+     * two runs with different event counts and a positive slope; otherwise the overhead is kept.
+     */
+    bool
+    calibrate();
+
+    size_t
+    runs() const
+    {
+        return run_time.size();
+    }
+
+    /** Regions known from any run */
+    std::vector< std::string >
+    regions() const;
+
+    /** Instrumentation cost of a region in seconds */
+    double
+    cost( const std::string& region ) const;
+
+    /** Estimated runtime without instrumentation */
+    double
+    baseRuntime() const;
+
+    /** Predicted overhead relative to the uninstrumented runtime if the regions are excluded */
+    double
+    overhead( const std::set< std::string >& excluded ) const;
+
+    /**
+     * Fewest unprotected regions whose exclusion brings the overhead down to the budget, a fraction
+     * of the uninstrumented runtime, in decreasing order of cost. If the budget cannot be met all
+     * unprotected regions with visits are returned.
+     */
+    std::vector< std::string >
+    plan( double budget ) const;
+
+private:
+    double
+    events( size_t run ) const;
+
+    std::vector< double >                          run_time;          ///< runtime by run
+    std::vector< std::map< std::string, double > > run_visits;        ///< visits by region and run
+    std::map< std::string, double >                visits;            ///< largest visits by region
+    std::set< std::string >                        protected_regions; ///< regions never excluded
+    double                                         event_overhead;    ///< seconds per event
+};
+
+/** Score-P filter pattern of a mangled name: blanks become wildcards */
+std::string
+scorepFilterPattern( const std::string& name );
+
+/** Intel tcollect pattern of a mangled name: '*', '[' and ']' are escaped */
+std::string
+intelFilterPattern( const std::string& name );
+
+#endif
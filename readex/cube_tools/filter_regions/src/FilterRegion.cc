@@ -22,10 +22,12 @@
 #include <list>
 #include <map>
 #include <vector>
-#include <boost/regex.hpp>
+#include <set>
+#include <strings.h>
 
 
 #include "../include/FilterRegion.h"
+#include "../include/OverheadModel.h"
 #include "../../common_incl/helper.h"
 #include "../../common_incl/enums.h"
 
@@ -33,29 +35,20 @@ using namespace std;
 using namespace cube;
 using namespace services;
 
-bool
-predicateFunc( const string& a,
-               const string& b )
-{
-    return ( strcasecmp( a.c_str(), b.c_str() ) == 0 ) ? true : false;
-}
-
 int
 main( int argc, char* argv[] )
 {
-    string       cube_file_name( "undefined" );
-    string       filter_file_name( "scorep.filt" );
-    string       filter_file_name_i( "intel-tcollect.filt" );
-    double       threshold( 0.1 );
-    boost::regex reg( "\\s" );
-    string       format( "*" );
-    boost::regex reg_i{ "[\\*\\[\\]]" };
-    string       format_i{ "\\\\$&" };
-    int          argcount( 1 );
-    bool         has_intel_filt_file( false );
-    int          c;
-
-    while ( ( c = getopt( argc, argv, "t:f:i:h?" ) ) != -1 )
+    vector< string > cube_file_names;
+    string           filter_file_name( "scorep.filt" );
+    string           filter_file_name_i( "intel-tcollect.filt" );
+    string           phase_name;
+    double           threshold( 0.1 );
+    double           budget( 0.05 );
+    double           event_overhead( 0.0 );
+    bool             has_intel_filt_file( false );
+    int              c;
+
+    while ( ( c = getopt( argc, argv, "t:f:i:b:e:p:h?" ) ) != -1 )
     {
         switch ( c )
         {
@@ -66,16 +59,22 @@ main( int argc, char* argv[] )
                 break;
             case 't':
                 threshold  = stod( optarg );
-                argcount  += 2;
                 break;
             case 'f':
                 filter_file_name = string( optarg ) + ".filt";
-                argcount        += 2;
                 break;
             case 'i':
                 filter_file_name_i   = string( optarg ) + ".filt";
                 has_intel_filt_file  = true;
-                argcount            += 2;
+                break;
+            case 'b':
+                budget = stod( optarg ) / 100.0;
+                break;
+            case 'e':
+                event_overhead = stod( optarg );
+                break;
+            case 'p':
+                phase_name = optarg;
                 break;
             default:
                 usage( argv[ 0 ] );
@@ -84,110 +83,116 @@ main( int argc, char* argv[] )
         }
     }
 
-    if ( ( argc - argcount ) != 1 )
+    for ( int arg = optind; arg < argc; arg++ )
+    {
+        cube_file_names.push_back( argv[ arg ] );
+    }
+
+    if ( cube_file_names.empty() || budget < 0 || event_overhead < 0 )
     {
         usage( argv[ 0 ] );
         cout << "\nError: Wrong arguments.\n";
         exit( 0 );
     }
 
-    if ( argcount < argc )
+    OverheadModel         model;
+    map< string, string > display_names;
+    try
     {
-        Cube* in_cube = NULL;
-        try
+        // Successive runs of the instrument and filter iterations refine one model
+        for ( const auto& cube_file_name : cube_file_names )
         {
-            cube_file_name = string( argv[ argcount ] );
-            Cube* in_cube  = new Cube();
-            // Read input files
+            Cube in_cube;
             cerr << "Reading " << cube_file_name << "...";
-            in_cube->openCubeReport( cube_file_name.c_str() );
+            in_cube.openCubeReport( cube_file_name.c_str() );
             cerr << " Done." << endl;
 
-            //get all call tree nodes
-            const vector< Cnode* >& cnodes = in_cube->get_cnodev();
-            vector< Cnode* >        filtered_cnodes;
+            ModelCNodes( &in_cube, threshold, phase_name, model, display_names );
+        }
+    } catch ( const RuntimeError& err )
+    {
+        cerr << err.what() << endl;
+        exit( 1 );
+    }
 
-            //Traverse the phase node in order to compute granularity of each sub nodes
-            FilterCNodes( cnodes, in_cube, threshold, filtered_cnodes );
+    if ( event_overhead > 0 )
+    {
+        model.setEventOverhead( event_overhead );
+    }
+    else if ( model.calibrate() )
+    {
+        cout << "Calibrated overhead per event from " << model.runs() << " runs: " << model.eventOverhead() * 1e9 << " ns" << endl;
+    }
+    else
+    {
+        cout << "Assumed overhead per event: " << model.eventOverhead() * 1e9 << " ns (set it with -e or pass profiles of several runs)" << endl;
+    }
 
-            vector< string > filter_node_names;
-            cout << "--------------------------------------------------------------" << endl;
-            for ( const auto& cnode : filtered_cnodes )
-            {
-                if ( !isAllowedforFilter( cnode ) )
-                {
-                    continue;
-                }
-                cout  << "--Allowed filtered node name--" << cnode->get_callee()->get_name() << endl;
+    vector< string > excluded = model.plan( budget );
+    cout << "--------------------------------------------------------------" << endl;
+    for ( const auto& region : excluded )
+    {
+        cout << "--Allowed filtered node name--" << display_names[ region ]
+             << "    Predicted overhead: " << model.cost( region ) << " s" << endl;
+    }
 
-                filter_node_names.push_back( cnode->get_callee()->get_mangled_name() );
-            }
-            sort( filter_node_names.begin(), filter_node_names.end() );
-            vector< string >::iterator it = unique( filter_node_names.begin(), filter_node_names.end() );
+    vector< string > filter_node_names( excluded );
+    sort( filter_node_names.begin(), filter_node_names.end() );
 
-            filter_node_names.resize( distance( filter_node_names.begin(), it ) );
+    set< string > filtered( filter_node_names.begin(), filter_node_names.end() );
+    cout << setprecision( 3 ) << fixed;
+    cout << "Estimated runtime without instrumentation: " << model.baseRuntime() << " s" << endl;
+    cout << "Predicted instrumentation overhead: " << 100 * model.overhead( set< string >() ) << " % unfiltered, "
+         << 100 * model.overhead( filtered ) << " % with " << filtered.size() << " excluded regions (budget "
+         << 100 * budget << " %)" << endl;
+    if ( model.overhead( filtered ) > budget )
+    {
+        cout << "The budget cannot be met without excluding significant or protected regions" << endl;
+    }
 
-            //using predicate comparison
-            unique( filter_node_names.begin(), filter_node_names.end(), predicateFunc );
+    cout << "Writing into the filter file " << endl;
 
-            cout << "Writing into the filter file " << endl;
+    ofstream ofs( filter_file_name, ios_base::out );
+    if ( ofs.is_open() )
+    {
+        ofs << "SCOREP_REGION_NAMES_BEGIN\n";
+        ofs << "EXCLUDE MANGLED\n";
+        for ( const auto& node : filter_node_names )
+        {
+            ofs << scorepFilterPattern( node );
+            ofs << "\n";
+        }
+        ofs << "SCOREP_REGION_NAMES_END\n";
+        ofs.close();
+    }
 
-            ofstream ofs( filter_file_name, ios_base::out );
-            if ( ofs.is_open() )
+    if ( has_intel_filt_file )
+    {
+        cout << "Writing intel compiler filter file " << endl;
+        ofstream ofsi( filter_file_name_i, ios_base::out );
+        if ( ofsi.is_open() )
+        {
+            for ( const auto& node : filter_node_names )
             {
-                ofs << "SCOREP_REGION_NAMES_BEGIN\n";
-                ofs << "EXCLUDE MANGLED\n";
-                for ( const auto& node : filter_node_names )
+                if ( !node.empty() )
                 {
-                     string fn_name = boost::regex_replace( node, reg, format );
-		     if (fn_name.find("opari") == string::npos) {
-		       ofs << fn_name;
-		       ofs << "\n";
-		     }
+                    ofsi << ".*:";
+                    ofsi << intelFilterPattern( node );
+                    ofsi << " off\n";
                 }
-                ofs << "SCOREP_REGION_NAMES_END\n";
-                ofs.close();
             }
-
-            if ( has_intel_filt_file )
+            vector<string> ext_names = {".cpp", ".cc", ".c", ".CPP", ".CC", ".C", ".h", ".H"};
+            for (const auto& ext : ext_names)
             {
-                cout << "Writing intel compiler filter file " << endl;
-                ofstream ofsi( filter_file_name_i, ios_base::out );
-                if ( ofsi.is_open() )
-                {
-                    for ( const auto& node : filter_node_names )
-                    {
-                        string fn_name = boost::regex_replace( node, reg_i, format_i );
-			//dont filter opari regions
-                        if ( !fn_name.empty() && fn_name.find("opari") == string::npos)
-                        {
-                            ofsi << ".*:";
-                            ofsi << fn_name;
-                            ofsi << " off\n";
-                        }
-                    }
-		    vector<string> ext_names = {".cpp", ".cc", ".c", ".CPP", ".CC", ".C", ".h", ".H"};
-		    for (const auto& ext : ext_names) 
-		    {
-		        ofsi << "^.*\\";
-			ofsi << ext;
-			ofsi << ":$ off\n";
-		    }
-                    ofsi.close();
-                }
+                ofsi << "^.*\\";
+                ofsi << ext;
+                ofsi << ":$ off\n";
             }
-
-            //delete in_cube;
-            cout << "DONE" << endl;
-        } catch ( const RuntimeError& err )
-        {
-            cerr << err.what() << endl;
-        }
-        if ( in_cube != NULL )
-        {
-            delete in_cube;
+            ofsi.close();
         }
     }
+
+    cout << "DONE" << endl;
 }
 
 
@@ -214,29 +219,67 @@ isAllowedforFilter( const Cnode* c_node )
     return isUserNode( c_node );
 }
 
+/**
+ * Adds one profile to the overhead model: the runtime of the first thread, the visits of each
+ * region on it and the regions that must stay instrumented. Those are regions that are not user
+ * regions, regions with a granularity of at least the threshold, which are candidates for
+ * significant regions, and the phase region with all its callers.
+ */
 void
-FilterCNodes( const vector< Cnode* >& call_nodes,
-              Cube*                   in_cube,
-              double                  threshold,
-              vector< Cnode* >&       filt_nodes )
+ModelCNodes( Cube*                  in_cube,
+             double                 threshold,
+             const string&          phase_name,
+             OverheadModel&         model,
+             map< string, string >& display_names )
 {
-    for ( size_t i = 0; i < call_nodes.size(); i++ )
+    Metric* met_t     = in_cube->get_met( "time" );
+    Metric* met_visit = in_cube->get_met( "visits" );
+    Thread* thread    = in_cube->get_thrdv()[ 0 ];
+
+    double runtime = 0.0;
+    for ( const auto& root : in_cube->get_root_cnodev() )
+    {
+        runtime += in_cube->get_sev( met_t, CUBE_CALCULATE_INCLUSIVE, root, CUBE_CALCULATE_INCLUSIVE, thread, CUBE_CALCULATE_EXCLUSIVE );
+    }
+    size_t run = model.addRun( runtime );
+
+    set< Region* > checked;
+    for ( const auto& call_node : in_cube->get_cnodev() )
     {
-        Cnode*  call_node = call_nodes[ i ];
-        Region* p         = call_node->get_callee();
-        double gran_val   = computeGranularity( call_node, in_cube );
-        if ( gran_val < threshold )
+        Region*       region = call_node->get_callee();
+        const string& name   = region->get_mangled_name();
+        display_names[ name ] = region->get_name();
+
+        model.addVisits( run, name, in_cube->get_sev( met_visit, CUBE_CALCULATE_INCLUSIVE, call_node, CUBE_CALCULATE_EXCLUSIVE,
+                                                      thread, CUBE_CALCULATE_EXCLUSIVE ) );
+
+        if ( !phase_name.empty() && strcasecmp( phase_name.c_str(), region->get_name().c_str() ) == 0 )
+        {
+            for ( Cnode* ancestor = call_node; ancestor != NULL; ancestor = ancestor->get_parent() )
+            {
+                model.protect( ancestor->get_callee()->get_mangled_name() );
+            }
+        }
+
+        // granularity is a property of the region, compute it once
+        if ( !checked.insert( region ).second )
         {
-            filt_nodes.push_back( call_node );
-            cout  << "--Call node name--" << call_node->get_callee()->get_name() << "    Granularity Value: " << gran_val << endl;
+            continue;
+        }
+        //dont filter opari regions
+        if ( !isAllowedforFilter( call_node ) || name.find( "opari" ) != string::npos )
+        {
+            model.protect( name );
+            continue;
+        }
+        double gran_val = computeGranularity( call_node, in_cube );
+        if ( gran_val >= threshold )
+        {
+            model.protect( name );
         }
         else
         {
-            //cout  << "--Call node name not filtered--" << call_node->get_callee()->get_name() << "    Granularity Value: " << gran_val << endl;
+            cout  << "--Call node name--" << region->get_name() << "    Granularity Value: " << gran_val << endl;
         }
     }
 }
-
-
-
-
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cctype>
+
+#include "../include/OverheadModel.h"
+
+using namespace std;
+
+/* Enter or exit of a compiler instrumented region with profiling, typical of recent x86 systems */
+const double OverheadModel::defaultEventOverhead = 3e-7;
+
+OverheadModel::OverheadModel() : event_overhead( defaultEventOverhead )
+{
+}
+
+size_t
+OverheadModel::addRun( double runtime )
+{
+    run_time.push_back( runtime );
+    run_visits.push_back( map< string, double >() );
+    return run_time.size() - 1;
+}
+
+void
+OverheadModel::addVisits( size_t        run,
+                          const string& region,
+                          double        count )
+{
+    if( run >= run_visits.size() )
+        return;
+    double& in_run = run_visits[ run ][ region ];
+    in_run += count;
+    double& largest = visits[ region ];
+    largest = max( largest, in_run );
+}
+
+void
+OverheadModel::protect( const string& region )
+{
+    protected_regions.insert( region );
+}
+
+double
+OverheadModel::events( size_t run ) const
+{
+    double count = 0.0;
+    for( const auto& region : run_visits[ run ] )
+        count += 2 * region.second;
+    return count;
+}
+
+bool
+OverheadModel::calibrate()
+{
+    size_t n = run_time.size();
+    if( n < 2 )
+        return false;
+
+    double mean_events = 0.0, mean_time = 0.0;
+    for( size_t run = 0; run < n; run++ )
+    {
+        mean_events += events( run ) / n;
+        mean_time   += run_time[ run ] / n;
+    }
+
+    double covariance = 0.0, variance = 0.0;
+    for( size_t run = 0; run < n; run++ )
+    {
+        double dx = events( run ) - mean_events;
+        covariance += dx * ( run_time[ run ] - mean_time );
+        variance   += dx * dx;
+    }
+    if( variance <= 0.0 || covariance <= 0.0 )
+        return false;
+
+    event_overhead = covariance / variance;
+    return true;
+}
+
+vector< string >
+OverheadModel::regions() const
+{
+    vector< string > names;
+    for( const auto& region : visits )
+        names.push_back( region.first );
+    return names;
+}
+
+double
+OverheadModel::cost( const string& region ) const
+{
+    map< string, double >::const_iterator it = visits.find( region );
+    return it == visits.end() ? 0.0 : 2 * it->second * event_overhead;
+}
+
+double
+OverheadModel::baseRuntime() const
+{
+    double base = 0.0, shortest = 0.0;
+    for( size_t run = 0; run < run_time.size(); run++ )
+    {
+        double estimate = run_time[ run ] - events( run ) * event_overhead;
+        base     = run == 0 ? estimate : min( base, estimate );
+        shortest = run == 0 ? run_time[ run ] : min( shortest, run_time[ run ] );
+    }
+    // an overhead estimate larger than the runtime is a bad calibration, not a free program
+    return base > 0.0 ? base : shortest;
+}
+
+double
+OverheadModel::overhead( const set< string >& excluded ) const
+{
+    double base = baseRuntime();
+    if( base <= 0.0 )
+        return 0.0;
+
+    double remaining = 0.0;
+    for( const auto& region : visits )
+    {
+        if( !excluded.count( region.first ) )
+            remaining += cost( region.first );
+    }
+    return remaining / base;
+}
+
+vector< string >
+OverheadModel::plan( double budget ) const
+{
+    vector< pair< double, string > > candidates;
+    double                           remaining = 0.0;
+    for( const auto& region : visits )
+    {
+        double region_cost = cost( region.first );
+        remaining += region_cost;
+        if( region_cost > 0.0 && !isProtected( region.first ) )
+            candidates.push_back( make_pair( -region_cost, region.first ) );
+    }
+
+    // reaching a total with the fewest items takes the largest ones first
+    sort( candidates.begin(), candidates.end() );
+
+    vector< string > excluded;
+    double           allowed = budget * baseRuntime();
+    for( size_t i = 0; i < candidates.size() && remaining > allowed; i++ )
+    {
+        excluded.push_back( candidates[ i ].second );
+        remaining += candidates[ i ].first;
+    }
+    return excluded;
+}
+
+string
+scorepFilterPattern( const string& name )
+{
+    string pattern( name );
+    for( auto& c : pattern )
+    {
+        if( isspace( ( unsigned char )c ) )
+            c = '*';
+    }
+    return pattern;
+}
+
+string
+intelFilterPattern( const string& name )
+{
+    string pattern;
+    pattern.reserve( name.size() + 8 );
+    for( const auto& c : name )
+    {
+        if( c == '*' || c == '[' || c == ']' )
+            pattern += '\\';
+        pattern += c;
+    }
+    return pattern;
+}
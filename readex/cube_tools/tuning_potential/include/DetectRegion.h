@@ -16,6 +16,7 @@
 #include <cubelib/CubeServices.h>
 
 #include "../../datamodel/include/SignificantRegion.h"
+#include "Reachability.h"
 
 using namespace std;
 using namespace cube;
@@ -54,10 +55,9 @@ checkParallelEvents (Cnode* curr_node, Cnode* call_node, bool* has_p_event);
 /*
  * Create adjacency matrix from call tree
  */
-size_t**
-generateAdjacencyMatrix( size_t                 size,
-                         Cnode*                 phase_node,
-                         map< size_t, string >& sig_regions );
+Reachability*
+generateAdjacencyMatrix( Cnode*                       phase_node,
+                         const map< size_t, string >& sig_regions );
 
 //void getCandidateList( Cnode* phase_node, Cnode* find_node, vector<Cnode*>* nested_nodes );
 /*
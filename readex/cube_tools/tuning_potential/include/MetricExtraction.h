@@ -0,0 +1,39 @@
+/**
+   @file    MetricExtraction.h
+   @ingroup READEX
+   @brief   Loads the tau-tuple metrics of the significant call nodes from a cube
+   @verbatim
+   Revision:       $Revision$
+   Revision date:  $Date$
+   Committed by:   $Author$
+
+   This file is part of READEX.
+
+   Copyright (c) 2016, Technische Universitaet Muenchen, Germany
+   See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef READEX_METRIC_EXTRACTION_H
+#define READEX_METRIC_EXTRACTION_H
+
+#include <vector>
+
+#include <cubelib/Cube.h>
+
+#include "MetricTable.h"
+
+using namespace cube;
+
+/*
+ * Extract the metrics of the table for the call nodes and one process in a single pass: one
+ * get_sev_adv() per metric and node, inclusive in the metric, exclusive in the call node and
+ * inclusive in the process. Metrics the cube lacks or that are not tau tuples stay unavailable.
+ */
+void
+extractTauMetrics( Cube*                        in_cube,
+                   const std::vector< Cnode* >& cnodes,
+                   Process*                     proc,
+                   MetricTable&                 table );
+
+#endif
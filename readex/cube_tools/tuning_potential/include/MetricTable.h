@@ -0,0 +1,140 @@
+/**
+   @file    MetricTable.h
+   @ingroup READEX
+   @brief   Typed tau-tuple statistics of the significant call nodes
+   @verbatim
+   Revision:       $Revision$
+   Revision date:  $Date$
+   Committed by:   $Author$
+
+   This file is part of READEX.
+
+   Copyright (c) 2016, Technische Universitaet Muenchen, Germany
+   See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef READEX_METRIC_TABLE_H
+#define READEX_METRIC_TABLE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @brief Contents of a cube TauAtomicValue: number of samples, extrema, sum and sum of squares.
+ *
+ * mean() and deviation() are the average and the standard deviation TauAtomicValue::getString()
+ * prints, at full precision; both are 0 for a tuple without samples.
+ */
+struct TauStatistics
+{
+    double n;
+    double min;
+    double max;
+    double sum;
+    double sumSquares;
+
+    TauStatistics() : n( 0.0 ), min( 0.0 ), max( 0.0 ), sum( 0.0 ), sumSquares( 0.0 ) {}
+
+    double
+    mean() const
+    {
+        return n != 0.0 ? sum / n : 0.0;
+    }
+
+    double
+    deviation() const;
+};
+
+/**
+ * @brief Tau tuples of a fixed set of metrics for a set of call nodes, extracted once.
+ *
+ * Replaces the per-call get_sev_adv() lookups and the text round trip through ValueParser.
+ * Rows belong to call nodes, identified by their cube id, and columns to the metrics given at
+ * construction; a column is only available if the cube holds the metric in the tau-tuple format.
+ * extractTauMetrics() in MetricExtraction.h fills the table from a cube.
+ */
+class MetricTable
+{
+public:
+    static const size_t npos = ( size_t )-1;
+
+    explicit MetricTable( const std::vector< std::string >& metrics );
+
+    /** Column of a metric, npos if it was not requested */
+    size_t
+    metric( const std::string& name ) const;
+
+    /** Name of the metric of a column */
+    const std::string&
+    metricName( size_t column ) const
+    {
+        return names[ column ];
+    }
+
+    size_t
+    metrics() const
+    {
+        return names.size();
+    }
+
+    /** Mark a column as extracted from a tau-tuple metric */
+    void
+    setAvailable( size_t column )
+    {
+        available[ column ] = true;
+    }
+
+    /** Whether the metric of a column was found in tau-tuple format; false for npos */
+    bool
+    has( size_t column ) const
+    {
+        return column < names.size() && available[ column ];
+    }
+
+    /** Row of a call node, added if the node is new */
+    size_t
+    addNode( uint32_t id );
+
+    /** Row of a call node, npos if it was not added */
+    size_t
+    node( uint32_t id ) const;
+
+    size_t
+    nodes() const
+    {
+        return rows.size();
+    }
+
+    TauStatistics&
+    at( size_t row,
+        size_t column )
+    {
+        return values[ row * names.size() + column ];
+    }
+
+    const TauStatistics&
+    at( size_t row,
+        size_t column ) const
+    {
+        return values[ row * names.size() + column ];
+    }
+
+private:
+    std::vector< std::string >             names;     ///< metric name by column
+    std::vector< bool >                    available; ///< column holds tau tuples
+    std::unordered_map< uint32_t, size_t > rows;      ///< row by call node id
+    std::vector< TauStatistics >           values;    ///< rows x columns, row-major
+};
+
+/**
+ * Transfer intensity PAPI_TOT_INS/PAPI_L3_TCM of the average sample; a node without cache miss
+ * samples counts one miss per sample
+ */
+double
+transferIntensity( const TauStatistics& instructions,
+                   const TauStatistics& misses );
+
+#endif
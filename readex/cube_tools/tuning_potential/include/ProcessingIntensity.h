@@ -12,20 +12,20 @@
 #include <cubelib/Cube.h>
 
 #include "../../datamodel/include/SignificantRegion.h"
+#include "MetricTable.h"
 
 
 using namespace cube;
 
 /*
- * Compute Transfer Intensity for each significant region
+ * Compute Transfer Intensity for each significant region from the extracted metrics
  */
 double
-getProcessingIntensity( Cnode* sig_node,
-                        Cube*  in_cube );
+getProcessingIntensity( const MetricTable& table,
+                        size_t             row );
 
 double
-getPhaseNodeAvgProcIntnsty( Cnode*   pnode,
-                            Cube *   input,
-                            Process* proc );
+getPhaseNodeAvgProcIntnsty( const MetricTable& table,
+                            size_t             phase_row );
 
 #endif //end of detect region
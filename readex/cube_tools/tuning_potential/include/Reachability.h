@@ -0,0 +1,125 @@
+/**
+   @file    Reachability.h
+   @ingroup READEX
+   @brief   Reachability between candidate regions of the phase call tree
+   @verbatim
+   Revision:       $Revision$
+   Revision date:  $Date$
+   Committed by:   $Author$
+
+   This file is part of READEX.
+
+   Copyright (c) 2016, Technische Universitaet Muenchen, Germany
+   See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef READEX_REACHABILITY_H
+#define READEX_REACHABILITY_H
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @brief Transitive "calls" relation between candidate regions.
+ *
+ * Replaces the dense n x n size_t adjacency matrix closed with Floyd-Warshall. Regions are
+ * identified by the indices of the candidate mapping; names are resolved through a hash table.
+ * The direct edges are condensed into strongly connected components, and each component keeps
+ * one row with the components it reaches, filled in reverse topological order. A row is a sorted
+ * list of component numbers while that is smaller than a bitset over all components, so call trees,
+ * whose regions reach few others, close in memory linear in the closure instead of quadratic in
+ * the number of components.
+ *
+ * reaches( i, j ) gives exactly the value the closed adjacency matrix held in a_m[ i ][ j ].
+ */
+class Reachability
+{
+public:
+    static const size_t npos = ( size_t )-1;
+
+    explicit Reachability( const std::map< size_t, std::string >& regions );
+
+    /** Number of regions in the mapping */
+    size_t
+    size() const
+    {
+        return names.size();
+    }
+
+    /** Index of a region, npos if the region is not a candidate */
+    size_t
+    index( const std::string& name ) const;
+
+    /** Name of the region with the given index */
+    const std::string&
+    name( size_t idx ) const
+    {
+        return names[ idx ];
+    }
+
+    /** Record that region "to" is called within region "from"; ignored for unknown indices */
+    void
+    addEdge( size_t from,
+             size_t to );
+
+    /** Compute the transitive closure; must be called after the last addEdge() */
+    void
+    close();
+
+    /** Whether "to" is transitively called within "from" */
+    bool
+    reaches( size_t from,
+             size_t to ) const;
+
+    /** Whether "from" transitively calls any candidate region, itself included */
+    bool
+    hasSuccessor( size_t from ) const
+    {
+        return from < size() && successor[ component[ from ] ];
+    }
+
+    /** Regions that are mutually reachable with idx, in increasing index order, idx included */
+    const std::vector< size_t >&
+    componentMembers( size_t idx ) const
+    {
+        return members[ component[ idx ] ];
+    }
+
+    /** Regions belonging to a cycle of more than one region, in the order the matrix scan listed them */
+    std::vector< std::string >
+    cyclicRegions() const;
+
+    void
+    print( std::ostream& out ) const;
+
+    /** Bytes held by the rows of the closure */
+    size_t
+    closureBytes() const;
+
+private:
+    void
+    condense();
+
+    /** Store the union of the rows of the given components and the components themselves as row c */
+    void
+    closeRow( size_t                       c,
+              const std::vector< size_t >& direct );
+
+    std::vector< std::string >                names;      ///< region name by index
+    std::unordered_map< std::string, size_t > indices;    ///< region index by name
+    std::vector< std::vector< size_t > >      edges;      ///< direct successors by region
+    std::vector< size_t >                     component;  ///< strongly connected component of each region
+    std::vector< std::vector< size_t > >      members;    ///< regions of each component
+    std::vector< bool >                       successor;  ///< component reaches at least one component
+    std::vector< std::vector< uint32_t > >    sparse;     ///< sorted components reached, for sparse rows
+    std::vector< size_t >                     dense;      ///< offset of the bitset in words, npos for sparse rows
+    std::vector< uint64_t >                   bits;       ///< bitsets over components of the dense rows
+    size_t                                    words;      ///< number of 64 bit words per bitset
+};
+
+#endif
@@ -13,6 +13,7 @@
 #include <cubelib/CubeServices.h>
 
 #include "../../datamodel/include/SignificantRegion.h"
+#include "MetricTable.h"
 
 
 using namespace cube;
@@ -40,16 +41,14 @@ printPotentialResults( std::list< SignificantRegion* >& significantRegions );
 
 /* returns the average value of a phase node of a metric */
 double
-getPhaseNodeAvgValue( Cnode*   pnode,
-                      Cube*    input,
-                      Metric*  met_any,
-                      Process* proc ) ;
+getPhaseNodeAvgValue( const MetricTable& table,
+                      size_t             phase_row,
+                      size_t             met_any ) ;
 
 /* returns the absolute value of a phase node of time metric */
 double
-getPhaseNodeTime( Cnode*   pnode,
-                  Cube*    input,
-                  Metric*  met_any,
-                  Process* proc ) ;
+getPhaseNodeTime( const MetricTable& table,
+                  size_t             phase_row,
+                  size_t             met_any ) ;
 
 #endif /*end of detect region */
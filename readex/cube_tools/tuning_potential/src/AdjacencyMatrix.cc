@@ -10,114 +10,46 @@ using namespace std;
 #include "../../common_incl/helper.h"
  
 /**
- * @brief Create two dimensional adjacency matrix of call-tree
- * @param n
- * @return
+ * @brief Record the regions called within call_node as successors of its region
+ * @param call_node
+ * @param a_m
  */
-size_t**
-AdjacencyMatrix( size_t n )
-{
-    size_t** adjacent_matrix = new size_t*[ n ];
-    for( size_t i = 0; i < n; i++ )
-    {
-        adjacent_matrix[ i ] = new size_t[ n ];
-        for( size_t j = 0; j < n; j++ )
-        {
-            adjacent_matrix[ i ][ j ] = 0;
-        }
-    }
-    return adjacent_matrix;
-}
-
 void
-updateMatrix( Cnode*                       call_node,
-              size_t**                     adjMatrix,
-              const map< size_t, string >& can_sig_regions )
+updateMatrix( Cnode*        call_node,
+              Reachability& a_m )
 {
-    string node_name = call_node->get_callee()->get_name();
-    size_t from_idx  = getIndex( node_name, can_sig_regions );
-    if( from_idx == -1 )
+    if( call_node == NULL )
+        return;
+    size_t from_idx = a_m.index( call_node->get_callee()->get_name() );
+    if( from_idx == Reachability::npos )
         return;
-    size_t n                          = can_sig_regions.size();
     vector< Cnode* >& c_subtree_nodes = call_node->get_whole_subtree();
     for( const auto& cnode : c_subtree_nodes )
     {
-        const Region* region = cnode->get_callee();
-        size_t to_idx        = getIndex( region->get_name(), can_sig_regions );
-        if( to_idx == -1 )
+        size_t to_idx = a_m.index( cnode->get_callee()->get_name() );
+        if( to_idx == Reachability::npos )
             continue;
-        addEdge( from_idx, to_idx, n, adjMatrix );
+        a_m.addEdge( from_idx, to_idx );
     }
 }
 
-
-/**
- * @brief Construct transitive closure of adjMatrix[][] using Floyd Warshall algorithm
- * @param size
- * @param adjMatrix Two dimensional array of adjacency matrix
- */
-void
-transitiveClosure( size_t   size,
-                   size_t** adjMatrix )
-{
-    for( size_t k = 0; k < size; k++ )
-        for( size_t i = 0; i < size; i++ )
-            for( size_t j = 0; j < size; j++ )
-                adjMatrix[ i ][ j ] = adjMatrix[ i ][ j ] || ( adjMatrix[ i ][ k ] && adjMatrix[ k ][ j ] );
-}
-
-void
-addEdge( size_t   src,
-         size_t   to,
-         size_t   n,
-         size_t** adjMatrix )
-{
-    if( src < n && to < n )
-        *( *( adjMatrix + src ) + to ) = 1;
-    else
-        return;
-
-}
 /**
  * @brief Get non-nested candidate for significant regions
- * @param size  size of can_sig_regions
- * @param a_m Two dimensional array of adjacency matrix
+ * @param a_m reachability between the candidate regions, rebuilt if candidates are removed
  * @param can_sig_regions  maps of significant region with index
  * @param candidate_list candidate list
  * @return
  */
 void
 getCandidateRegions( Cnode*                 phase_node,
-                     size_t                 size,
-                     size_t**&              a_m,
+                     Reachability*&         a_m,
                      map< size_t, string >& can_sig_regions,
                      vector< string >&      candidate_list )
 {
-    vector< string > can_r_names;
     vector< string > parent_names;
 
     // Now check the strongly connected components with more than one region
-    for( size_t i = 0; i < size; i++ )
-    {
-        for( size_t j = 0; j < size; j++ )
-        {
-            if( i != j && a_m[ i ][ j ] && a_m[ j ][ i ] )
-            {
-                string name_i = getRegionName( i, can_sig_regions );
-                string name_j = getRegionName( j, can_sig_regions );
-
-                if( can_r_names.empty() )
-                {
-                    can_r_names.push_back( name_i );
-                    can_r_names.push_back( name_j );
-                }
-                if( !checkExistingName( name_i, can_r_names ) )
-                    can_r_names.push_back( name_i );
-                if( !checkExistingName( name_j, can_r_names ) )
-                    can_r_names.push_back( name_j );
-            }
-        }
-    }
+    vector< string > can_r_names = a_m->cyclicRegions();
 
     //delete strongly connected components with more than two nodes
     if( !can_r_names.empty() )
@@ -128,7 +60,7 @@ getCandidateRegions( Cnode*                 phase_node,
             cout << cnode << endl;
         getRestCandidates( can_r_names, parent_names, candidate_list );
         //reconstruct the whole matrix
-        reconstructMatrix( size, a_m, phase_node, candidate_list, can_sig_regions );
+        reconstructMatrix( a_m, phase_node, candidate_list, can_sig_regions );
     }
 }
 
@@ -197,7 +129,7 @@ Cnode* getCnode( string c_name, vector<Cnode*> s_nodes  )
 vector< string >
 getSignificantRegions( vector< string >&      candidate_list,
                        vector< Cnode* >&      can_cnodes,
-                       size_t**               a_m,
+                       Reachability*&         a_m,
                        map< size_t, string >& can_region_mapping,
                        Cnode*                 phase_node,
                        Cube*                  input_cube )
@@ -208,27 +140,15 @@ getSignificantRegions( vector< string >&      candidate_list,
     {
         vector< string > non_sig_list;
         vector< string > parent_names;
-        size_t size = can_region_mapping.size();
-        // for( size_t i = 0; i < size; i++ ){
-        //   string name  = getRegionName( i, can_region_mapping );
-        //   cout << i << "  " << name << endl;
-        // }
-        //printMatrix(size,a_m);
+        size_t size = a_m->size();
+        //a_m->print( cout );
         // Gets all the leaf nodes which are not nested
         for( size_t i = 0; i < size; i++ )
         {
-          string name  = getRegionName( i, can_region_mapping );
-          //cout << "current region: " << name << endl;
+            string name = a_m->name( i );
+            //cout << "current region: " << name << endl;
 
-            bool visited = false;
-            for( size_t j = 0; !visited && j < size; j++ )
-            {
-                if( a_m[ i ][ j ] == 1 ){
-                    visited = true;
-                    //cout << "Calls: "<< getRegionName( j, can_region_mapping ) << endl;
-                }
-            }
-            if( !visited )
+            if( !a_m->hasSuccessor( i ) )
             {
                 //cout << "current region is leaf! " << name << endl;
                 Cnode* cnode = getCnode( name, can_cnodes );
@@ -252,9 +172,9 @@ getSignificantRegions( vector< string >&      candidate_list,
                 {
                     non_sig_list.push_back( name );
                 }
-                size_t i_i = getIndex( modified_name, can_region_mapping );
+                size_t i_i = a_m->index( modified_name );
                 // get all the parents of the leaf node
-                vector< string > rem_r_names = getParentRegName( i_i, size, a_m, can_region_mapping, parent_names );
+                vector< string > rem_r_names = getParentRegName( i_i, *a_m, parent_names );
                 //cout << endl << "Parents of influenced region " <<modified_name <<": "<< endl;
                 //for( const auto& region : rem_r_names )
                 //    cout <<"   "<< region << ' '<< endl;
@@ -293,7 +213,7 @@ getSignificantRegions( vector< string >&      candidate_list,
         }
 
         getRestCandidates( sig_r_names, parent_names, candidate_list );
-        reconstructMatrix( size, a_m, phase_node, candidate_list, can_region_mapping );
+        reconstructMatrix( a_m, phase_node, candidate_list, can_region_mapping );
 
     }
     return sig_r_names;
@@ -418,25 +338,21 @@ checkAllParents( vector< string >& sig_nodes,
 /**
  * @brief Returns all the parents of visited node
  * @param to
- * @param size
  * @param a_m
- * @param regions
  * @param parent_names
  * @return
  */
 vector< string >
-getParentRegName( size_t                       to,
-                  size_t                       size,
-                  size_t**                     a_m,
-                  const map< size_t, string >& regions,
-                  const vector< string >&      parent_names )
+getParentRegName( size_t                  to,
+                  const Reachability&     a_m,
+                  const vector< string >& parent_names )
 {
     vector< string > p_names;
-    for( size_t from = 0; from < size; from++ )
+    for( size_t from = 0; from < a_m.size(); from++ )
     {
-        if( a_m[ from ][ to ] == 1 )
+        if( a_m.reaches( from, to ) )
         {
-            string name = getRegionName( from, regions );
+            const string& name = a_m.name( from );
             if( parent_names.empty() )
                 p_names.push_back( name );
             else if ( !checkExistingName( name, parent_names )  )
@@ -447,74 +363,15 @@ getParentRegName( size_t                       to,
     return p_names;
 }
 
-/**
- * Print the adjacency matrix
- * @param n
- * @param adjMatrix
- */
-void
-printMatrix( size_t   n,
-             size_t** adjMatrix )
-{
-    cout << '\n';
-    for( size_t i = 0; i < n; i++ )
-    {
-        for( size_t j = 0; j < n; j++ )
-            cout << adjMatrix[ i ][ j ] << " ";
-        cout << endl;
-    }
-}
-
-/**
- * Get the indices of significant region from map
- * @param node_name
- * @param regions
- * @return
- */
-size_t
-getIndex( const string&                node_name,
-          const map< size_t, string >& regions )
-{
-    for( const auto& region : regions )
-    {
-        string sig_r_name = region.second;
-        if( strcmp( node_name.c_str(), sig_r_name.c_str() ) == 0 )
-            return region.first;
-    }
-
-    return -1;
-}
-
-/**
- * Returns the region name of respected call sub tree
- * @param idx
- * @param regions
- * @return
- */
-string
-getRegionName( const size_t                 idx,
-               const map< size_t, string >& regions )
-{
-    for( const auto& region : regions )
-    {
-        if( idx == region.first )
-            return region.second;
-    }
-
-    return NULL;
-}
-
 /**
  * Reconstruct the adjacency matrix by removing arch from parent to child, which are already in the significant list
- * @param size
  * @param adjMatrix
  * @param phase_node
  * @param candidateNodes
  * @param list_cnames
  */
 void
-reconstructMatrix( size_t                 size,
-                   size_t**&              adjMatrix,
+reconstructMatrix( Reachability*&         adjMatrix,
                    Cnode*                 phase_node,
                    vector< string >&      candidateNodes,
                    map< size_t, string >& list_cnames )
@@ -522,33 +379,15 @@ reconstructMatrix( size_t                 size,
     if( candidateNodes.empty() )
         return;
 
-    freeMatrix( size, adjMatrix );
+    delete adjMatrix;
     list_cnames.clear();
 
     //create the mapping
-    size_t cname_cnt;
     for( const auto& node : candidateNodes )
     {
-        cname_cnt = list_cnames.size();
+        size_t cname_cnt = list_cnames.size();
         list_cnames.insert( make_pair( cname_cnt, node ) );
     }
-    cname_cnt += 1;
 
-    adjMatrix = generateAdjacencyMatrix( cname_cnt, phase_node, list_cnames );
-}
-
-/**
- * Deallocate the adjacency matrix
- * @param n
- * @param adjMatrix
- */
-void
-freeMatrix( size_t   n,
-            size_t** adjMatrix )
-{
-    for( size_t i = 0; i< n; ++i )
-    {
-        delete[] adjMatrix[ i ];
-    }
-    delete[] adjMatrix;
+    adjMatrix = generateAdjacencyMatrix( phase_node, list_cnames );
 }
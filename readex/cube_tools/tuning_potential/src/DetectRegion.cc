@@ -17,6 +17,7 @@
 #include <boost/utility.hpp>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <numeric>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/foreach.hpp>
@@ -254,9 +255,9 @@ main( int argc, char* argv[] )
                     }
                     else
                     {
-                        size_t** a_m = generateAdjacencyMatrix( l_cnames.size(),  phase_node, l_cnames );
+                        Reachability* a_m = generateAdjacencyMatrix( phase_node, l_cnames );
 
-                        getCandidateRegions( phase_node, l_cnames.size(), a_m, l_cnames, can_r_names );
+                        getCandidateRegions( phase_node, a_m, l_cnames, can_r_names );
 
                         cout << "\n\nCandidate regions are:" << endl;
                         for ( const auto& region : can_r_names )
@@ -271,7 +272,7 @@ main( int argc, char* argv[] )
                         }
 
                         vector< string > sig_region_names = getSignificantRegions( can_r_names, candidateNodes, a_m, l_cnames,  phase_node, input_cube );
-                      //  freeMatrix( l_cnames.size(), a_m );
+                        delete a_m;
 
                         if ( sig_region_names.empty() )
                         {
@@ -478,33 +479,42 @@ checkParallelEvents (Cnode* curr_node, Cnode* call_node, bool* has_p_event)
 
 
 /**
- * @brief Generate Adjacency matric of call node tree
- * @param matrix_size
+ * @brief Generate the closed reachability relation of the candidate regions in the call node tree
  * @param phase_node
  * @param sig_regions
  * @return
  */
-size_t**
-generateAdjacencyMatrix( size_t                 matrix_size,
-                         Cnode*                 phase_node,
-                         map< size_t, string >& sig_regions )
+Reachability*
+generateAdjacencyMatrix( Cnode*                       phase_node,
+                         const map< size_t, string >& sig_regions )
 {
-    //size_t cnt_candRegions = sig_regions->size();
-    //phase_node->get_children();
-    size_t**        adj_matrix      = AdjacencyMatrix( matrix_size );
+    Reachability*   adj_matrix      = new Reachability( sig_regions );
     vector<Cnode*>& p_subtree_nodes = phase_node->get_whole_subtree();
+    const string&   phase_name      = phase_node->get_callee()->get_name();
+
+    // first call node of every candidate region, as getCnode() would find it
+    unordered_map< string, Cnode* > first_cnodes;
+    first_cnodes.reserve( sig_regions.size() );
+    for ( const auto& cnode : p_subtree_nodes )
+    {
+        const string& name = cnode->get_callee()->get_name();
+        if ( adj_matrix->index( name ) != Reachability::npos )
+            first_cnodes.insert( make_pair( name, cnode ) );
+    }
+
     for ( const auto& name : sig_regions )
     {
-        if ( strcmp( name.second.c_str(), phase_node->get_callee()->get_name().c_str() ) == 0 )
-            updateMatrix( phase_node, adj_matrix, sig_regions );
+        if ( name.second == phase_name )
+            updateMatrix( phase_node, *adj_matrix );
         else
         {
-            Cnode* call_node = getCnode( name.second, p_subtree_nodes );
-            updateMatrix( call_node, adj_matrix, sig_regions );
+            unordered_map< string, Cnode* >::const_iterator it = first_cnodes.find( name.second );
+            if ( it != first_cnodes.end() )
+                updateMatrix( it->second, *adj_matrix );
         }
     }
-    transitiveClosure( matrix_size, adj_matrix );
-    //printMatrix( cnt_candRegions, adj_matrix );
+    adj_matrix->close();
+    //adj_matrix->print( cout );
     return adj_matrix;
 }
 
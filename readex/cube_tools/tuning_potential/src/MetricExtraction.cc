@@ -0,0 +1,60 @@
+/**
+ * MetricExtraction.cc
+ * Loads the tau tuples of the significant call nodes once, typed
+ */
+
+#include "../include/MetricExtraction.h"
+
+using namespace std;
+using namespace cube;
+
+void
+extractTauMetrics( Cube*                   in_cube,
+                   const vector< Cnode* >& cnodes,
+                   Process*                proc,
+                   MetricTable&            table )
+{
+    vector< size_t > rows;
+    rows.reserve( cnodes.size() );
+    for( const auto& cnode : cnodes )
+        rows.push_back( table.addNode( cnode->get_id() ) );
+
+    for( size_t column = 0; column < table.metrics(); column++ )
+    {
+        Metric* metric = in_cube->get_met( table.metricName( column ) );
+        if( metric == NULL )
+            continue;
+
+        bool tau_tuples = true;
+        for( size_t i = 0; i < cnodes.size() && tau_tuples; i++ )
+        {
+            Value* value = in_cube->get_sev_adv( metric,
+                                                 CUBE_CALCULATE_INCLUSIVE,
+                                                 cnodes[ i ],
+                                                 CUBE_CALCULATE_EXCLUSIVE,
+                                                 proc,
+                                                 CUBE_CALCULATE_INCLUSIVE );
+            if( value == NULL )
+                continue;
+
+            if( value->myDataType() == CUBE_DATA_TYPE_TAU_ATOMIC )
+            {
+                TauAtomicValue* tau_tuple  = ( TauAtomicValue* )value;
+                TauStatistics&  statistics = table.at( rows[ i ], column );
+                statistics.n          = tau_tuple->getN().getDouble();
+                statistics.min        = tau_tuple->getMinValue().getDouble();
+                statistics.max        = tau_tuple->getMaxValue().getDouble();
+                statistics.sum        = tau_tuple->getSum().getDouble();
+                statistics.sumSquares = tau_tuple->getSum2().getDouble();
+            }
+            else
+            {
+                tau_tuples = false;
+            }
+            delete value;
+        }
+
+        if( tau_tuples )
+            table.setAvailable( column );
+    }
+}
@@ -0,0 +1,65 @@
+#include <cmath>
+
+#include "../include/MetricTable.h"
+
+using namespace std;
+
+const size_t MetricTable::npos;
+
+/**
+ * @brief Standard deviation over the samples, as printed by TauAtomicValue
+ * @return 0 without samples or where rounding made the variance negative
+ */
+double
+TauStatistics::deviation() const
+{
+    if( n == 0.0 )
+        return 0.0;
+    double average  = sum / n;
+    double variance = sumSquares / n - average * average;
+    return variance > 0.0 ? sqrt( variance ) : 0.0;
+}
+
+MetricTable::MetricTable( const vector< string >& metrics ) : names( metrics ),
+                                                              available( metrics.size(), false )
+{
+}
+
+size_t
+MetricTable::metric( const string& name ) const
+{
+    for( size_t column = 0; column < names.size(); column++ )
+    {
+        if( names[ column ] == name )
+            return column;
+    }
+    return npos;
+}
+
+size_t
+MetricTable::addNode( uint32_t id )
+{
+    unordered_map< uint32_t, size_t >::const_iterator it = rows.find( id );
+    if( it != rows.end() )
+        return it->second;
+
+    size_t row = rows.size();
+    rows.insert( make_pair( id, row ) );
+    values.resize( values.size() + names.size() );
+    return row;
+}
+
+size_t
+MetricTable::node( uint32_t id ) const
+{
+    unordered_map< uint32_t, size_t >::const_iterator it = rows.find( id );
+    return it == rows.end() ? npos : it->second;
+}
+
+double
+transferIntensity( const TauStatistics& instructions,
+                   const TauStatistics& misses )
+{
+    double average_tcm = misses.n == 0.0 ? 1.0 : misses.mean();
+    return instructions.mean() / average_tcm;
+}
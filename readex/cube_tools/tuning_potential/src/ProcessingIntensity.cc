@@ -19,6 +19,7 @@
 
 #include"../include/TuningPotential.h"
 #include "../include/ProcessingIntensity.h"
+#include "../include/MetricTable.h"
 #include "../../common_incl/helper.h"
 
 
@@ -29,100 +30,28 @@ using namespace services;
 using namespace boost;
 
 
+/**
+ * @brief Transfer intensity of a significant node from the extracted tau tuples
+ * @param table metrics extracted by extractTauMetrics()
+ * @param row row of the node
+ * @return -1 if PAPI_TOT_INS or PAPI_L3_TCM is not available as tau tuple
+ */
 double
-getProcessingIntensity( Cnode* sig_node,
-                        Cube*  in_cube )
+getProcessingIntensity( const MetricTable& table,
+                        size_t             row )
 {
-    /* Get PAPI_TOT_INS and PAPI_L3_TCM metrices */
-    Metric* met_papi_ins = in_cube->get_met( "PAPI_TOT_INS" );
-    Metric* met_papi_tcm = in_cube->get_met( "PAPI_L3_TCM" );
-
-    if ( met_papi_ins  == NULL || met_papi_tcm  == NULL )
-        return -1;
-
-    const vector< Process* >& processes = in_cube->get_procv();
-
-    Region *region     = sig_node->get_callee();
-    Value *met_tau_ins = in_cube->get_sev_adv( met_papi_ins,
-                                               CUBE_CALCULATE_INCLUSIVE,
-                                               sig_node,
-                                               CUBE_CALCULATE_EXCLUSIVE,
-                                               processes[ 0 ],
-                                               CUBE_CALCULATE_INCLUSIVE );
-    Value *met_tau_tcm = in_cube->get_sev_adv( met_papi_tcm,
-                                               CUBE_CALCULATE_INCLUSIVE,
-                                               sig_node,
-                                               CUBE_CALCULATE_EXCLUSIVE,
-                                               processes[ 0 ],
-                                               CUBE_CALCULATE_INCLUSIVE );
+    size_t met_papi_ins = table.metric( "PAPI_TOT_INS" );
+    size_t met_papi_tcm = table.metric( "PAPI_L3_TCM" );
 
-    if( met_tau_ins->myDataType() != CUBE_DATA_TYPE_TAU_ATOMIC )
-    {
-        cout << "Please instrument the application with CUBE_TUPLE profiling format( Intra-phase )" << endl;
+    if ( !table.has( met_papi_ins ) || !table.has( met_papi_tcm ) || row == MetricTable::npos )
         return -1;
-    }
-
-    /* Casting from Value to TauAtomicValue */
-    TauAtomicValue* tau_tuple_ins = ( TauAtomicValue* ) met_tau_ins;
-    TauAtomicValue* tau_tuple_tcm = ( TauAtomicValue* ) met_tau_tcm;
-
-    vector< string > tau_val_ins = ValueParser( tau_tuple_ins->getString() );
-    vector< string > tau_val_tcm = ValueParser( tau_tuple_tcm->getString() );
-
-    double avg_ins = stod( tau_val_ins.at( 3 ) );
-    double avg_tcm = stod( tau_val_tcm.at( 3 ) );
-
-    double N_tcm = stod( tau_val_tcm.at( 0 ) );
-    if ( N_tcm == 0 )
-        avg_tcm = 1.0;
-
-    double avg_trans_intensity = avg_ins / avg_tcm ;
 
-    //cout << "Region Name:: " << region->get_name()  << "    Trans_intensity:: " << avg_trans_intensity << endl;
-
-    return avg_trans_intensity;
+    return transferIntensity( table.at( row, met_papi_ins ), table.at( row, met_papi_tcm ) );
 }
 
 double
-getPhaseNodeAvgProcIntnsty( Cnode*   pnode,
-                            Cube*    input,
-                            Process* proc )
+getPhaseNodeAvgProcIntnsty( const MetricTable& table,
+                            size_t             phase_row )
 {
-    /* Get PAPI_TOT_INS and PAPI_L3_TCM metrices */
-    Metric* met_papi_ins = input->get_met( "PAPI_TOT_INS" );
-    Metric* met_papi_tcm = input->get_met( "PAPI_L3_TCM" );
-
-    if ( met_papi_ins  == NULL || met_papi_tcm == NULL )
-        return -1;
-
-    Value* complex_value_ins = input->get_sev_adv( met_papi_ins,
-                                                   CUBE_CALCULATE_INCLUSIVE,
-                                                   pnode,
-                                                   CUBE_CALCULATE_EXCLUSIVE,
-                                                   proc,
-                                                   CUBE_CALCULATE_INCLUSIVE );
-    Value* complex_value_tcm = input->get_sev_adv( met_papi_tcm,
-                                                   CUBE_CALCULATE_INCLUSIVE,
-                                                   pnode,
-                                                   CUBE_CALCULATE_EXCLUSIVE,
-                                                   proc,
-                                                   CUBE_CALCULATE_INCLUSIVE );
-
-    /* Casting from Value to TauAtomicValue */
-    TauAtomicValue* tau_tuple_ins = ( TauAtomicValue* )complex_value_ins;
-    TauAtomicValue* tau_tuple_tcm = ( TauAtomicValue* )complex_value_tcm;
-
-    vector< string > tau_val_ins = ValueParser( tau_tuple_ins->getString() );
-    vector< string > tau_val_tcm = ValueParser( tau_tuple_tcm->getString() );
-
-    double average_ins = stod( tau_val_ins.at( 3 ) );
-    double average_tcm = stod( tau_val_tcm.at( 3 ) );
-
-    double N_tcm = stod( tau_val_tcm.at( 0 ) );
-    if( N_tcm == 0 )
-        average_tcm = 1;
-
-    double avg_trans_intensity = average_ins / average_tcm;
-
-    return avg_trans_intensity;
+    return getProcessingIntensity( table, phase_row );
 }
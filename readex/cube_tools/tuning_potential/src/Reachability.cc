@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <unordered_set>
+
+#include "../include/Reachability.h"
+
+using namespace std;
+
+const size_t Reachability::npos;
+
+/**
+ * @brief Build the region index; the mapping keys are the region indices
+ * @param regions
+ */
+Reachability::Reachability( const map< size_t, string >& regions ) : names( regions.size() ),
+                                                                     edges( regions.size() ),
+                                                                     words( 0 )
+{
+    indices.reserve( regions.size() );
+    for( const auto& region : regions )
+    {
+        if( region.first >= names.size() )
+            continue;
+        names[ region.first ] = region.second;
+        // the linear lookup this replaces returned the lowest index of a duplicated name
+        indices.insert( make_pair( region.second, region.first ) );
+    }
+    close();
+}
+
+size_t
+Reachability::index( const string& name ) const
+{
+    unordered_map< string, size_t >::const_iterator it = indices.find( name );
+    return it == indices.end() ? npos : it->second;
+}
+
+void
+Reachability::addEdge( size_t from,
+                       size_t to )
+{
+    if( from < size() && to < size() )
+        edges[ from ].push_back( to );
+}
+
+/**
+ * @brief Condense the direct edges into strongly connected components and close the component DAG
+ */
+void
+Reachability::close()
+{
+    for( auto& succ : edges )
+    {
+        sort( succ.begin(), succ.end() );
+        succ.erase( unique( succ.begin(), succ.end() ), succ.end() );
+    }
+    condense();
+
+    size_t n_comp = members.size();
+    words = ( n_comp + 63 ) / 64;
+    sparse.assign( n_comp, vector< uint32_t >() );
+    dense.assign( n_comp, npos );
+    bits.clear();
+    successor.assign( n_comp, false );
+
+    // Tarjan emits a component only after every component it reaches, so rows of successors are final
+    vector< size_t > direct;
+    for( size_t c = 0; c < n_comp; c++ )
+    {
+        direct.clear();
+        for( size_t from : members[ c ] )
+        {
+            for( size_t to : edges[ from ] )
+                direct.push_back( component[ to ] );
+        }
+        sort( direct.begin(), direct.end() );
+        direct.erase( unique( direct.begin(), direct.end() ), direct.end() );
+        closeRow( c, direct );
+        successor[ c ] = !direct.empty();
+    }
+}
+
+void
+Reachability::closeRow( size_t                  c,
+                        const vector< size_t >& direct )
+{
+    // a sorted row of more 32 bit entries than this takes more room than a bitset
+    size_t limit = max< size_t >( 2 * words, 1 );
+    size_t total = direct.size();
+    bool   wide  = false;
+    for( size_t d : direct )
+    {
+        if( d == c )
+            continue;
+        if( dense[ d ] != npos )
+            wide = true;
+        else
+            total += sparse[ d ].size();
+    }
+
+    if( !wide && total <= 4 * limit )
+    {
+        vector< uint32_t >& row = sparse[ c ];
+        row.assign( direct.begin(), direct.end() );
+        for( size_t d : direct )
+        {
+            if( d != c )
+                row.insert( row.end(), sparse[ d ].begin(), sparse[ d ].end() );
+        }
+        sort( row.begin(), row.end() );
+        row.erase( unique( row.begin(), row.end() ), row.end() );
+        if( row.size() <= limit )
+        {
+            row.shrink_to_fit();
+            return;
+        }
+        row = vector< uint32_t >();
+    }
+
+    size_t offset = bits.size();
+    bits.resize( offset + words, 0 );
+    uint64_t* row = &bits[ offset ];
+    for( size_t d : direct )
+    {
+        row[ d / 64 ] |= ( uint64_t )1 << ( d % 64 );
+        if( d == c )
+            continue;
+        if( dense[ d ] != npos )
+        {
+            const uint64_t* succ_row = &bits[ dense[ d ] ];
+            for( size_t w = 0; w < words; w++ )
+                row[ w ] |= succ_row[ w ];
+        }
+        else
+        {
+            for( uint32_t e : sparse[ d ] )
+                row[ e / 64 ] |= ( uint64_t )1 << ( e % 64 );
+        }
+    }
+    dense[ c ] = offset;
+}
+
+/**
+ * @brief Iterative Tarjan; components are numbered in reverse topological order
+ */
+void
+Reachability::condense()
+{
+    size_t n = size();
+    vector< size_t > order( n, npos );
+    vector< size_t > low( n, 0 );
+    vector< bool >   on_stack( n, false );
+    vector< size_t > stack;
+    vector< pair< size_t, size_t > > call;     // (region, next edge to visit)
+    size_t counter = 0;
+
+    component.assign( n, npos );
+    members.clear();
+
+    for( size_t root = 0; root < n; root++ )
+    {
+        if( order[ root ] != npos )
+            continue;
+        call.push_back( make_pair( root, 0 ) );
+        while( !call.empty() )
+        {
+            size_t v = call.back().first;
+            size_t e = call.back().second;
+            if( e == 0 )
+            {
+                order[ v ] = low[ v ] = counter++;
+                stack.push_back( v );
+                on_stack[ v ] = true;
+            }
+            if( e < edges[ v ].size() )
+            {
+                call.back().second++;
+                size_t w = edges[ v ][ e ];
+                if( order[ w ] == npos )
+                    call.push_back( make_pair( w, 0 ) );
+                else if( on_stack[ w ] )
+                    low[ v ] = min( low[ v ], order[ w ] );
+                continue;
+            }
+            if( low[ v ] == order[ v ] )
+            {
+                size_t c = members.size();
+                members.push_back( vector< size_t >() );
+                size_t w;
+                do
+                {
+                    w = stack.back();
+                    stack.pop_back();
+                    on_stack[ w ]  = false;
+                    component[ w ] = c;
+                    members[ c ].push_back( w );
+                }
+                while( w != v );
+                sort( members[ c ].begin(), members[ c ].end() );
+            }
+            call.pop_back();
+            if( !call.empty() )
+            {
+                size_t parent = call.back().first;
+                low[ parent ] = min( low[ parent ], low[ v ] );
+            }
+        }
+    }
+}
+
+bool
+Reachability::reaches( size_t from,
+                       size_t to ) const
+{
+    if( from >= size() || to >= size() )
+        return false;
+    size_t c = component[ from ];
+    size_t d = component[ to ];
+    if( dense[ c ] == npos )
+        return binary_search( sparse[ c ].begin(), sparse[ c ].end(), ( uint32_t )d );
+    return ( bits[ dense[ c ] + d / 64 ] >> ( d % 64 ) ) & 1;
+}
+
+size_t
+Reachability::closureBytes() const
+{
+    size_t bytes = bits.size() * sizeof( uint64_t );
+    for( const auto& row : sparse )
+        bytes += row.capacity() * sizeof( uint32_t );
+    return bytes;
+}
+
+/**
+ * @brief Names of the regions in strongly connected components with more than one region.
+ * Pairs ( i, j ) are visited in row-major order like the former matrix scan, so the order is unchanged.
+ * @return
+ */
+vector< string >
+Reachability::cyclicRegions() const
+{
+    vector< string >        cyclic;
+    unordered_set< string > listed;
+
+    for( size_t i = 0; i < size(); i++ )
+    {
+        for( size_t j : componentMembers( i ) )
+        {
+            if( i == j )
+                continue;
+            if( listed.insert( names[ i ] ).second )
+                cyclic.push_back( names[ i ] );
+            if( listed.insert( names[ j ] ).second )
+                cyclic.push_back( names[ j ] );
+        }
+    }
+    return cyclic;
+}
+
+/**
+ * Print the closed relation as the former adjacency matrix
+ * @param out
+ */
+void
+Reachability::print( ostream& out ) const
+{
+    out << '\n';
+    for( size_t i = 0; i < size(); i++ )
+    {
+        for( size_t j = 0; j < size(); j++ )
+            out << reaches( i, j ) << " ";
+        out << endl;
+    }
+}
@@ -21,6 +21,7 @@
 
 #include "../include/TuningPotential.h"
 #include "../include/ProcessingIntensity.h"
+#include "../include/MetricExtraction.h"
 #include "../../common_incl/helper.h"
 
 using namespace std;
@@ -46,7 +47,6 @@ ComputeIntraPhaseTP( Cnode*            phase_node,
     vector< Cnode* >           sig_nodes;
     list< SignificantRegion* > sig_region_list;
     const vector< Process* >&  processes = in_cube->get_procv();
-    Metric*                    met_any   = in_cube->get_met( "time" );
 
     for( const auto& cnode : cnodes )
     {
@@ -58,7 +58,24 @@ ComputeIntraPhaseTP( Cnode*            phase_node,
         }
     }
 
-    //double avg_phase_transfer_intnsty = getPhaseNodeAvgProcIntnsty( phase_node, in_cube, processes[0] );
+    /* All tuples of the phase and the significant nodes are read once, typed */
+    vector< Cnode* > extracted_nodes( 1, phase_node );
+    extracted_nodes.insert( extracted_nodes.end(), sig_nodes.begin(), sig_nodes.end() );
+    MetricTable table( { "time", "PAPI_TOT_INS", "PAPI_L3_TCM" } );
+    extractTauMetrics( in_cube, extracted_nodes, processes[ 0 ], table );
+
+    size_t met_any = table.metric( "time" );
+    if( !table.has( met_any ) )
+    {
+        std::cout << "Please instrument the application with CUBE_TUPLE profiling format( Intra-phase )" << endl;
+
+        return sig_region_list;
+    }
+
+    size_t phase_row                   = table.node( phase_node->get_id() );
+    double phasetime                   = getPhaseNodeTime( table, phase_row, met_any );
+    double phase_average               = getPhaseNodeAvgValue( table, phase_row, met_any );
+    double avg_phase_compute_intensity = getPhaseNodeAvgProcIntnsty( table, phase_row );
 
     vector< Cnode* > variant_nodes;
 
@@ -66,53 +83,35 @@ ComputeIntraPhaseTP( Cnode*            phase_node,
     {
         Region *region = sig_node->get_callee();
 
-        Value* met_tau_val = in_cube->get_sev_adv( met_any,
-                                                   CUBE_CALCULATE_INCLUSIVE,
-                                                   sig_node,
-                                                   CUBE_CALCULATE_EXCLUSIVE,
-                                                   processes[ 0 ],
-                                                   CUBE_CALCULATE_INCLUSIVE );
-
-        if( met_tau_val->myDataType() != CUBE_DATA_TYPE_TAU_ATOMIC )
-        {
-            std::cout << "Please instrument the application with CUBE_TUPLE profiling format( Intra-phase )" << endl;
-
-            return sig_region_list;
-        }
-
-        /* Casting from Value to TauAtomicValue */
-        TauAtomicValue* tau_atomic_tuple = ( TauAtomicValue* ) met_tau_val;
-        string stat_tuple                = tau_atomic_tuple->getString();
-        vector< string > tau_atomic_val  = ValueParser( stat_tuple );
-        double stand_deviation           = tau_atomic_val.at( 4 ) == "-nan" ? 0.0 : stod( tau_atomic_val.at( 4 ) );
-        uint64_t N                       = stod( tau_atomic_val.at( 0 ) );
-        double mean                      = stod( tau_atomic_val.at( 3 ) );
-        double minValue                  = tau_atomic_tuple->getMinValue().getDouble();
-        double maxValue                  = tau_atomic_tuple->getMaxValue().getDouble();
+        size_t               row             = table.node( sig_node->get_id() );
+        const TauStatistics& tau_atomic_val  = table.at( row, met_any );
+        double               stand_deviation = tau_atomic_val.deviation();
+        uint64_t             N               = tau_atomic_val.n;
+        double               mean            = tau_atomic_val.mean();
+        double               minValue        = tau_atomic_val.min;
+        double               maxValue        = tau_atomic_val.max;
 
         if ( N != 0 )
         {
-            double phasetime = getPhaseNodeTime( phase_node, in_cube, met_any, processes[ 0 ] );
             /*std::cout << "REGION NAME: " << sig_node->get_callee()->get_name() << endl;
             std::cout << "Exec_time: " << mean * N << endl;
             std::cout << "Exec_time of Phase: " << phasetime << endl;*/
-            double dyn_avg_phase = ( mean ) * N / getPhaseNodeTime( phase_node, in_cube, met_any, processes[ 0 ] ) * 100; // weight
+            double dyn_avg_phase = ( mean ) * N / phasetime * 100; // weight
             double dev_perc_reg  = 0.0;
 
             if ( mean != 0.0 )
             {
                 dev_perc_reg = ( stand_deviation / mean ) * 100 ;  // coefficient of variation OR degree of spreadness
             }
-            double dev_perc_phase = ( stand_deviation / getPhaseNodeAvgValue( phase_node, in_cube, met_any, processes[ 0 ] ) ) * 100;
+            double dev_perc_phase = ( stand_deviation / phase_average ) * 100;
 
-            DynamismMetric dyn_ti = DynamismMetric( met_any->get_uniq_name(), minValue, maxValue, ( mean ) * N, dev_perc_reg, dev_perc_phase, dyn_avg_phase );
+            DynamismMetric dyn_ti = DynamismMetric( "time", minValue, maxValue, ( mean ) * N, dev_perc_reg, dev_perc_phase, dyn_avg_phase );
             vector< DynamismMetric > dyn_metrics;
             dyn_metrics.push_back( dyn_ti );
-            double avg_compute_intensity = getProcessingIntensity( sig_node, in_cube );
+            double avg_compute_intensity = getProcessingIntensity( table, row );
 
             if( avg_compute_intensity != -1 )
             {
-                double avg_phase_compute_intensity = getPhaseNodeAvgProcIntnsty( phase_node, in_cube, processes[ 0 ] );
                 double variation_compute_intensity = ( avg_compute_intensity / avg_phase_compute_intensity ) * 100;
                 std::string str                    = "Transfer Intensity";
                 DynamismMetric dyn_t_i             = DynamismMetric( str, 0.0, 0.0, 0.0, 0.0, 0.0, variation_compute_intensity );
@@ -198,32 +197,24 @@ ComputeInterPhaseTP( Cnode* phase_node,
                      Cube*  in_cube,
                      double threshold )
 {
-    Metric* met_t                       = in_cube->get_met( "time" );
     const vector< Process* >& processes = in_cube->get_procv();
 
-    Value* complex_value = in_cube->get_sev_adv( met_t,
-                                                 CUBE_CALCULATE_INCLUSIVE,
-                                                 phase_node,
-                                                 CUBE_CALCULATE_EXCLUSIVE,
-                                                 processes[ 0 ],
-                                                 CUBE_CALCULATE_INCLUSIVE );
+    MetricTable table( { "time" } );
+    extractTauMetrics( in_cube, vector< Cnode* >( 1, phase_node ), processes[ 0 ], table );
 
-    if( complex_value->myDataType() != CUBE_DATA_TYPE_TAU_ATOMIC )
+    size_t met_time = table.metric( "time" );
+    if( !table.has( met_time ) )
     {
         std::cout << "Please instrument the application with CUBE_TUPLE profiling format( Inter-phase ) " << endl;
         return NULL;
     }
 
-    /* Casting from Value to TauAtomicValue */
-    TauAtomicValue* tau_atomic_tuple = ( TauAtomicValue* )complex_value;
-    vector< string > tau_atomic_val  = ValueParser( tau_atomic_tuple->getString() );
-    double standard_deviation        = stod( tau_atomic_val.at( 4 ) );
-    double mean                      = stod( tau_atomic_val.at( 3 ) );
-    double minValue                  = tau_atomic_tuple->getMinValue().getDouble();
-    double maxValue                  = tau_atomic_tuple->getMaxValue().getDouble();
-    uint64_t N                       = stod( tau_atomic_val.at( 0 ) );
-    if( std::isnan( standard_deviation ) )
-        standard_deviation = 0.0;
+    const TauStatistics& tau_atomic_val = table.at( table.node( phase_node->get_id() ), met_time );
+    double standard_deviation           = tau_atomic_val.deviation();
+    double mean                         = tau_atomic_val.mean();
+    double minValue                     = tau_atomic_val.min;
+    double maxValue                     = tau_atomic_val.max;
+    uint64_t N                          = tau_atomic_val.n;
 
     double variation_percentage = ( ( maxValue - minValue ) / mean ) * 100;
     double dev_percentage       = ( standard_deviation / mean ) * 100;
@@ -253,60 +244,33 @@ ComputeInterPhaseTP( Cnode* phase_node,
 
 /**
  * @brief Get the avaergae value of phase node
- * @param pnode
- * @param input
- * @param met_any
- * @param proc
+ * @param table metrics extracted by extractTauMetrics()
+ * @param phase_row
+ * @param met_any column of the metric
  * @return
  */
 double
-getPhaseNodeAvgValue( Cnode*   pnode,
-                      Cube *   input,
-                      Metric*  met_any,
-                      Process* proc )
+getPhaseNodeAvgValue( const MetricTable& table,
+                      size_t             phase_row,
+                      size_t             met_any )
 {
-    Value* complex_value = input->get_sev_adv( met_any,
-                                               CUBE_CALCULATE_INCLUSIVE,
-                                               pnode,
-                                               CUBE_CALCULATE_EXCLUSIVE,
-                                               proc,
-                                               CUBE_CALCULATE_INCLUSIVE );
-
-    /* Casting from Value to TauAtomicValue */
-    TauAtomicValue* tau_atomic_tuple = ( TauAtomicValue* )complex_value;
-    vector< string > tau_atomic_val  = ValueParser( tau_atomic_tuple->getString() );
-    double average                   = stod( tau_atomic_val.at( 3 ) );
-
-    return average;
+    return table.at( phase_row, met_any ).mean();
 }
 
 /**
  * @brief Get the absolute value of phase node
- * @param pnode
- * @param input
- * @param met_any
- * @param proc
+ * @param table metrics extracted by extractTauMetrics()
+ * @param phase_row
+ * @param met_any column of the time metric
  * @return
  */
 double
-getPhaseNodeTime( Cnode*   pnode,
-                  Cube*    input,
-                  Metric*  met_any,
-                  Process* proc )
+getPhaseNodeTime( const MetricTable& table,
+                  size_t             phase_row,
+                  size_t             met_any )
 {
+    const TauStatistics& tau_atomic_val = table.at( phase_row, met_any );
+    uint64_t N                          = tau_atomic_val.n;
 
-    Value* complex_value = input->get_sev_adv( met_any,
-                                               CUBE_CALCULATE_INCLUSIVE,
-                                               pnode,
-                                               CUBE_CALCULATE_EXCLUSIVE,
-                                               proc,
-                                               CUBE_CALCULATE_INCLUSIVE );
-
-    /* Casting from Value to TauAtomicValue */
-    TauAtomicValue* tau_atomic_tuple = ( TauAtomicValue* )complex_value;
-    vector< string > tau_atomic_val  = ValueParser( tau_atomic_tuple->getString() );
-    double average                   = stod( tau_atomic_val.at( 3 ) );
-    uint64_t N                       = stod( tau_atomic_val.at( 0 ) );
-
-    return average * N;
+    return tau_atomic_val.mean() * N;
 }
@@ -23,6 +23,7 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <inttypes.h>
 
 #include <UTILS_Error.h>
 #define SCOREP_DEBUG_MODULE_NAME TUNING
@@ -31,6 +32,7 @@
 // #include <SCOREP_Config.h>
 
 #include "scorep_tuning_table.h"
+#include "scorep_tuning_location.h"
 #include "scorep_tuning_registered_functions.h"
 #include "scorep_tuning_service_management.h"
 
@@ -46,6 +48,9 @@ static size_t plugin_id;
 extern SCOREP_TuningRegionType* scorep_tuning_region_table;
 extern SCOREP_TuningActionType* scorep_tuning_action_table;
 
+/* Skip tuning actions and restores that would not change the value; SCOREP_TUNING_SUPPRESS_REDUNDANT=0 disables it */
+static int suppress_redundant_actions = 1;
+
 static int
 initialize( void )
 {
@@ -55,6 +60,9 @@ initialize( void )
 
     scorep_tuning_initialize_action_table();
 
+    const char* suppress = getenv( "SCOREP_TUNING_SUPPRESS_REDUNDANT" );
+    suppress_redundant_actions = suppress == NULL || strcmp( suppress, "0" ) != 0;
+
     UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Initializing tuning substrate\n" );
     int ret = tuning_subsystem_init();
 
@@ -72,10 +80,15 @@ initialize( void )
 static void
 finalize( void )
 {
-    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Finalizing tuning component of ScoreP\n" );
+    uint64_t applied, suppressed;
+    scorep_tuning_location_counters( &applied, &suppressed );
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Finalizing tuning component of ScoreP: %" PRIu64 " tuning actions applied, %" PRIu64 " suppressed\n",
+                        applied, suppressed );
 
     tuning_subsystem_finalize();
 
+    scorep_tuning_finalize_locations();
+
     scorep_tuning_finalize_region_table();
 
     scorep_tuning_finalize_action_table();
@@ -85,156 +98,142 @@ finalize( void )
 }
 
 
+/* Sets tuning action k to value and returns the value it had */
+static int
+apply_tuning_action( uint16_t k,
+                     int      value )
+{
+    int old = 0;
+
+    if ( scorep_tuning_action_table[ k ].kind == SCOREP_TUNING_VARIABLE )
+    {
+        old                                                        = *( scorep_tuning_action_table[ k ].enterRegionVariablePtr );
+        *( scorep_tuning_action_table[ k ].enterRegionVariablePtr ) = value;
+    }
+    else if ( scorep_tuning_action_table[ k ].languageType == SCOREP_LANGUAGE_C )
+    {
+        scorep_tuning_action_table[ k ].enterRegionFunctionPtr( value, &old );
+    }
+    else
+    {
+        int* old_ptr;
+        union
+        {
+            int  value;
+            int* value_ptr;
+        } union_value;
+
+        union
+        {
+            int*  value_ptr;
+            int** value_ptrptr;
+        } union_old;
+
+        union_value.value_ptr  = &value;
+        union_old.value_ptrptr = &old_ptr;
+        scorep_tuning_action_table[ k ].enterRegionFunctionPtr( union_value.value, union_old.value_ptr );
+        old = *old_ptr;
+    }
+    return old;
+}
+
+/* Whether tuning action k has a variable or a function to apply it with */
+static int
+is_applicable( uint16_t k )
+{
+    switch ( scorep_tuning_action_table[ k ].kind )
+    {
+        case SCOREP_TUNING_VARIABLE:
+            return scorep_tuning_action_table[ k ].enterRegionVariablePtr != NULL;
+        case SCOREP_TUNING_FUNCTION:
+            if ( scorep_tuning_action_table[ k ].languageType != SCOREP_LANGUAGE_C
+                 && scorep_tuning_action_table[ k ].languageType != SCOREP_LANGUAGE_FORTRAN )
+            {
+                UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Undefined language for function tuning action\n" );
+                return 0;
+            }
+            return scorep_tuning_action_table[ k ].enterRegionFunctionPtr != NULL;
+        default:
+            return 0;
+    }
+}
+
+/* Whether tuning action k has value on the location: variables are read, functions tracked */
+static int
+has_value( const SCOREP_TuningLocationType* state,
+           uint16_t                         k,
+           int                              value )
+{
+    if ( !suppress_redundant_actions )
+    {
+        return 0;
+    }
+    if ( scorep_tuning_action_table[ k ].kind == SCOREP_TUNING_VARIABLE )
+    {
+        return *( scorep_tuning_action_table[ k ].enterRegionVariablePtr ) == ( unsigned int )value;
+    }
+    return state->currentValueKnown[ k ] && state->currentValue[ k ] == value;
+}
+
+
 void
 enter_region( struct SCOREP_Location* location,
               uint64_t                timestamp,
               SCOREP_RegionHandle     regionHandle,
               uint64_t*               metricValues )
 {
-//    fprintf( stderr, "enter_region: Applying tuning action enter for region %s (%s/%d) of type %d (%d) file %s begin line %d and end line %d\n",
-//             callbacks->SCOREP_RegionHandle_GetName( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetCanonicalName( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetId( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetType( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetParadigmType( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetFileName( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetBeginLine( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetEndLine( regionHandle ) );
-
     UTILS_BUG_ON( callbacks == 0, "SCORE-P internal callbacks not set." );
-    const char* regionName = callbacks->SCOREP_RegionHandle_GetName( regionHandle );
-    uint32_t    regionId   = callbacks->SCOREP_RegionHandle_GetId( regionHandle );
+    uint32_t regionId = callbacks->SCOREP_RegionHandle_GetId( regionHandle );
 
-    uint16_t i; //uint16_t regionIndex;
+    uint16_t i;
 
-    if ( scorep_tuning_region_table_find_region( &i, regionId ) == SCOREP_TUNING_FOUND )
+    if ( scorep_tuning_region_table_find_region( &i, regionId ) != SCOREP_TUNING_FOUND )
     {
-        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Region %s found on location %u\n", regionName, i );
-        //scorep_tuning_print_region_table( );
-        //scorep_tuning_print_action_table();
-        for ( uint16_t j = 0; j < scorep_tuning_region_table[ i ].next_free_tuning_action_entry; j++ )
+        return;
+    }
+
+    /* the name is only needed for the debug output */
+    const char* regionName = scorep_debug_active() ? callbacks->SCOREP_RegionHandle_GetName( regionHandle ) : "";
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Region %s found on location %u\n", regionName, i );
+
+    for ( uint16_t j = 0; j < scorep_tuning_region_table[ i ].next_free_tuning_action_entry; j++ )
+    {
+        uint16_t k     = scorep_tuning_region_table[ i ].tuningActions[ j ].tuningActionListIndex; // Index of the tuning action in the table
+        int      value = scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue;
+        if ( !is_applicable( k ) )
+        {
+            continue;
+        }
+
+        SCOREP_TuningLocationType* state   = scorep_tuning_location_get( location, k );
+        int                        restore = scorep_tuning_action_table[ k ].restoreValueFlag;
+
+        if ( has_value( state, k, value ) )
         {
-            uint16_t k = scorep_tuning_region_table[ i ].tuningActions[ j ].tuningActionListIndex; // Index of the tuning action in the table
-            if ( scorep_tuning_action_table[ k ].kind == SCOREP_TUNING_VARIABLE )
+            state->suppressed++;
+            if ( restore )
             {
-                if ( scorep_tuning_action_table[ k ].enterRegionVariablePtr )
-                {
-                    if ( scorep_tuning_action_table[ k ].restoreValueFlag )
-                    {
-                        if ( scorep_tuning_action_table[ k ].restoreValueStack )
-                        {
-                            push2Stack( scorep_tuning_action_table[ k ].restoreValueStack, *( scorep_tuning_action_table[ k ].enterRegionVariablePtr ) );
-                        }
-                        else
-                        {
-                            UTILS_WARNING( "enter_region: Restore value stack is NULL\n" );
-                        }
-                    }
-/* Apply the tuning action */
-//                    printf("enter_region: This is the place where I set the variable with value = %d!\n", scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue);
-                    *( scorep_tuning_action_table[ k ].enterRegionVariablePtr ) = scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue;
-                    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Variable %p set to %d for tuning action %d in region %s(%d)\n",
-                                        scorep_tuning_action_table[ k ].enterRegionVariablePtr,
-                                        *( scorep_tuning_action_table[ k ].enterRegionVariablePtr ),
-                                        j, regionName, regionId );
-                }
-//                if ( scorep_tuning_action_table[ k ].exitRegionVariablePtr )
-//                {
-///* Apply the tuning action */
-//                    printf("enter_region: This is the place where I set the variable with value = %d!\n", scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue);
-//                    *( scorep_tuning_action_table[ k ].exitRegionVariablePtr ) = scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue;
-//                    printf("Variable %p set to %d\n", scorep_tuning_action_table[ k ].enterRegionVariablePtr,
-//                           *( scorep_tuning_action_table[ k ].enterRegionVariablePtr ));
-//                }
+                push2Stack( state->restoreStack[ k ], 0 );
             }
-            else if ( scorep_tuning_action_table[ k ].kind == SCOREP_TUNING_FUNCTION )
-            {
-                if ( scorep_tuning_action_table[ k ].enterRegionFunctionPtr )
-                {
-                    if ( scorep_tuning_action_table[ k ].languageType == SCOREP_LANGUAGE_C )
-                    {
-                        int old;
-/* Apply the tuning action */
-                        scorep_tuning_action_table[ k ].enterRegionFunctionPtr( scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue, &old );
-                        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, " Function %p(%d) for tuning action %d in region %s(%d)\n",
-                                            scorep_tuning_action_table[ k ].enterRegionFunctionPtr,
-                                            scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue,
-                                            j, regionName, regionId );
-
-// TODO: Fetch the old value from the function
-                        if ( scorep_tuning_action_table[ k ].restoreValueFlag )
-                        {
-                            if ( scorep_tuning_action_table[ k ].restoreValueStack )
-                            {
-//TODO: Store the old value on the stack
-                                push2Stack( scorep_tuning_action_table[ k ].restoreValueStack, old );
-                            }
-                            else
-                            {
-                                UTILS_WARNING( "enter_region: Restore value stack is NULL\n" );
-                            }
-                        }
-                    }
-                    else if ( scorep_tuning_action_table[ k ].languageType == SCOREP_LANGUAGE_FORTRAN )
-                    {
-                        int* old;
-                        union
-                        {
-                            int  value;
-                            int* value_ptr;
-                        } union_value;
-
-                        union
-                        {
-                            int*  value_ptr;
-                            int** value_ptrptr;
-                        } union_old;
-
-                        union_value.value_ptr  = &scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue;
-                        union_old.value_ptrptr = &old;
+            UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Tuning action %d in region %s(%d) already has value %d\n",
+                                j, regionName, regionId, value );
+            continue;
+        }
+
 /* Apply the tuning action */
-                        scorep_tuning_action_table[ k ].enterRegionFunctionPtr( union_value.value, union_old.value_ptr );
-                        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Function %p(%d) for tuning action %d in region %s(%d)\n",
-                                            scorep_tuning_action_table[ k ].enterRegionFunctionPtr,
-                                            scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue,
-                                            j, regionName, regionId );
-
-// TODO: Fetch the old value from the function
-                        if ( scorep_tuning_action_table[ k ].restoreValueFlag )
-                        {
-                            if ( scorep_tuning_action_table[ k ].restoreValueStack )
-                            {
-//TODO: Store the old value on the stack
-                                push2Stack( scorep_tuning_action_table[ k ].restoreValueStack, *old );
-                            }
-                            else
-                            {
-                                UTILS_WARNING( "enter_region: Restore value stack is NULL\n" );
-                            }
-                        }
-                    }
-                    else
-                    {
-                        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Undefined language for function tuning action\n" );
-                    }
-                }
-//TODO: Check what to do with this
-//                if ( scorep_tuning_action_table[ k ].exitRegionFunctionPtr )
-//                {
-///* Apply the tuning action */
-//                    printf("enter_region: This is the place where I call the function with the variable set to = %d!\n", scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-//                    scorep_tuning_action_table[ k ].exitRegionFunctionPtr( scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-//                    printf("Function %p(%d)\n", scorep_tuning_action_table[ k ].exitRegionFunctionPtr,
-//                           scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-//                }
-            }
+        int old = apply_tuning_action( k, value );
+        state->applied++;
+        state->currentValue[ k ]      = value;
+        state->currentValueKnown[ k ] = 1;
+        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Tuning action %d in region %s(%d) set to %d, was %d\n",
+                            j, regionName, regionId, value, old );
+
+        if ( restore )
+        {
+            push2Stack( state->restoreStack[ k ], old );
+            push2Stack( state->restoreStack[ k ], 1 );
         }
     }
-    else
-    {
-//        UTILS_WARNING( "enter_region: region %s with Id %u not found! Tuning action will not be applied!\n", regionName, regionId );
-//        SCOREP_Tuning_PrintActionTable();
-    }
 }
 
 
@@ -244,148 +243,53 @@ exit_region( struct SCOREP_Location* location,
              SCOREP_RegionHandle     regionHandle,
              uint64_t*               metricValues )
 {
-//    fprintf( stderr, "exit_region: Applying tuning action exit for region %s (%s/%d) of type %d (%d) file %s begin line %d and end line %d\n",
-//             callbacks->SCOREP_RegionHandle_GetName( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetCanonicalName( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetId( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetType( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetParadigmType( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetFileName( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetBeginLine( regionHandle ),
-//             callbacks->SCOREP_RegionHandle_GetEndLine( regionHandle ) );
-
     UTILS_BUG_ON( callbacks == 0, "SCORE-P internal callbacks not set." );
-    const char* regionName = callbacks->SCOREP_RegionHandle_GetName( regionHandle );
-    uint32_t    regionId   = callbacks->SCOREP_RegionHandle_GetId( regionHandle );
+    uint32_t regionId = callbacks->SCOREP_RegionHandle_GetId( regionHandle );
 
     uint16_t i;
 
-    if ( scorep_tuning_region_table_find_region( &i, regionId ) == SCOREP_TUNING_FOUND )
+    if ( scorep_tuning_region_table_find_region( &i, regionId ) != SCOREP_TUNING_FOUND )
+    {
+        return;
+    }
+
+    const char* regionName = scorep_debug_active() ? callbacks->SCOREP_RegionHandle_GetName( regionHandle ) : "";
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Region %s found on location %u\n", regionName, i );
+
+    for ( uint16_t j = 0; j < scorep_tuning_region_table[ i ].next_free_tuning_action_entry; j++ )
     {
-        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Region %s found on location %u\n", regionName, i );
-        for ( uint16_t j = 0; j < scorep_tuning_region_table[ i ].next_free_tuning_action_entry; j++ )
+        uint16_t k = scorep_tuning_region_table[ i ].tuningActions[ j ].tuningActionListIndex; // Index of the tuning action in the table
+        if ( !scorep_tuning_action_table[ k ].restoreValueFlag || !is_applicable( k ) )
         {
-            uint16_t k = scorep_tuning_region_table[ i ].tuningActions[ j ].tuningActionListIndex; // Index of the tuning action in the table
+            continue;
+        }
 
-            if ( scorep_tuning_action_table[ k ].kind == SCOREP_TUNING_VARIABLE )
-            {
-                if ( scorep_tuning_action_table[ k ].enterRegionVariablePtr )
-                {
-                    if ( scorep_tuning_action_table[ k ].restoreValueFlag )
-                    {
-                        if ( scorep_tuning_action_table[ k ].restoreValueStack )
-                        {
-                            *( scorep_tuning_action_table[ k ].enterRegionVariablePtr ) = popFromStack( scorep_tuning_action_table[ k ].restoreValueStack );
-                            UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Variable %p(%d) restored from stack for tuning action %d in region %s(%d)!\n",
-                                                scorep_tuning_action_table[ k ].enterRegionVariablePtr,
-                                                *( scorep_tuning_action_table[ k ].enterRegionVariablePtr ),
-                                                j, regionName, regionId );
-                        }
-                        else
-                        {
-                            UTILS_WARNING( "exit_region: Restore value stack is NULL\n" );
-                        }
-                    }
-                }
-//TODO: Check what to do with this
-//                if ( scorep_tuning_action_table[ k ].exitRegionVariablePtr )
-//                {
-//                    /* Apply the tuning action */
-//                    scorep_tuning_action_table[ k ].exitRegionVariablePtr( scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-//                    printf("Variable %p set to %d\n", scorep_tuning_action_table[ k ].exitRegionVariablePtr,
-//                           *( scorep_tuning_action_table[ k ].enterRegionVariablePtr ));
-//                }
-            }
-            else if ( scorep_tuning_action_table[ k ].kind == SCOREP_TUNING_FUNCTION )
-            {
-                if ( scorep_tuning_action_table[ k ].enterRegionFunctionPtr )
-                {
-                    if ( scorep_tuning_action_table[ k ].languageType == SCOREP_LANGUAGE_C )
-                    {
-                        int old;
-// Store the old value
-                        if ( scorep_tuning_action_table[ k ].restoreValueFlag )
-                        {
-                            if ( scorep_tuning_action_table[ k ].restoreValueStack )
-                            {
-//TODO: Pop the old value from the stack
-//TODO: Call the function with the value from the stack
-                                unsigned int value = popFromStack( scorep_tuning_action_table[ k ].restoreValueStack );
-                                scorep_tuning_action_table[ k ].enterRegionFunctionPtr( value, &old );
-                                UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Function %p(%d) restored from stack for tuning action %d in region %s(%d)!\n",
-                                                    scorep_tuning_action_table[ k ].enterRegionFunctionPtr,
-                                                    value,
-                                                    j, regionName, regionId );
-                            }
-                            else
-                            {
-                                UTILS_WARNING( "exit_region: Restore value stack is NULL\n" );
-                            }
-                        }
-/* Apply the tuning action */
-//                    scorep_tuning_action_table[ k ].enterRegionFunctionPtr( scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-//                    printf("Function %p(%d)\n", scorep_tuning_action_table[ k ].enterRegionFunctionPtr,
-//                           scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-                    }
-                    else if ( scorep_tuning_action_table[ k ].languageType == SCOREP_LANGUAGE_FORTRAN )
-                    {
-                        int* old;
-                        // Store the old value
-                        if ( scorep_tuning_action_table[ k ].restoreValueFlag )
-                        {
-                            if ( scorep_tuning_action_table[ k ].restoreValueStack )
-                            {
-                                int value = popFromStack( scorep_tuning_action_table[ k ].restoreValueStack );
-
-                                union
-                                {
-                                    int  value;
-                                    int* value_ptr;
-                                } union_value;
-
-                                union
-                                {
-                                    int*  value_ptr;
-                                    int** value_ptrptr;
-                                } union_old;
-
-                                union_value.value_ptr  = &value;
-                                union_old.value_ptrptr = &old;
-                                //TODO: Pop the old value from the stack
-                                //TODO: Call the function with the value from the stack
-                                scorep_tuning_action_table[ k ].enterRegionFunctionPtr( union_value.value, union_old.value_ptr );
-                                UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Function %p(%d) restored from stack for tuning action %d in region %s(%d)!\n",
-                                                    scorep_tuning_action_table[ k ].enterRegionFunctionPtr,
-                                                    value,
-                                                    j, regionName, regionId );
-                            }
-                            else
-                            {
-                                UTILS_WARNING( "exit_region: Restore value stack is NULL\n" );
-                            }
-                        }
-/* Apply the tuning action */
-//                    scorep_tuning_action_table[ k ].enterRegionFunctionPtr( scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-//                    printf("Function %p(%d)\n", scorep_tuning_action_table[ k ].enterRegionFunctionPtr,
-//                           scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-                    }
-                }
-//TODO: Check what to do with this
-//                if ( scorep_tuning_action_table[ k ].exitRegionFunctionPtr )
-//                {
-///* Apply the tuning action */
-//                    printf("exit_region: This is the place where I call the function with the variable set to = %d!\n", scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-//                    scorep_tuning_action_table[ k ].exitRegionFunctionPtr( scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-//                    printf("Function %p(%d)\n", scorep_tuning_action_table[ k ].exitRegionFunctionPtr,
-//                           scorep_tuning_region_table[ i ].tuningActions[ j ].tuningParameterValue );
-//                }
-            }
+        SCOREP_TuningLocationType* state = scorep_tuning_location_get( location, k );
+        if ( state->restoreStack[ k ]->size == 0 )
+        {
+            /* the action was added to the region after the region was entered */
+            continue;
         }
-    }
-    else
-    {
-//        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "exit_region: region %s with Id %u not found! Tuning action will not be applied!\n", regionName, regionId );
-//        SCOREP_Tuning_PrintActionTable();
+        if ( popFromStack( state->restoreStack[ k ] ) == 0 )
+        {
+            /* the enter changed nothing, so neither does the restore */
+            state->suppressed++;
+            continue;
+        }
+
+        int value = popFromStack( state->restoreStack[ k ] );
+        if ( has_value( state, k, value ) )
+        {
+            state->suppressed++;
+            continue;
+        }
+
+        apply_tuning_action( k, value );
+        state->applied++;
+        state->currentValue[ k ]      = value;
+        state->currentValueKnown[ k ] = 1;
+        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TUNING, "Tuning action %d in region %s(%d) restored to %d\n",
+                            j, regionName, regionId, value );
     }
 }
 
@@ -437,6 +341,7 @@ create_location( const struct SCOREP_Location* location,
 static void
 delete_location( const struct SCOREP_Location* location )
 {
+    scorep_tuning_location_delete( location );
 }
 
 //static void
@@ -43,6 +43,12 @@ scorep_debug_init( void )
     }
 }
 
+int
+scorep_debug_active( void )
+{
+    return scorep_tuning_debug;
+}
+
 void
 UTILS_Debug_Printf( uint64_t    bitMask,
                     const char* file,
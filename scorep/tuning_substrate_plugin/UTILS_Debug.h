@@ -63,4 +63,10 @@ UTILS_Debug_Printf( uint64_t    bitMask,
 void
 scorep_debug_init( void );
 
+/**
+ * Whether SCOREP_TUNING_SUBSTRATE_DEBUG is set, for debug output that is expensive to prepare.
+ */
+int
+scorep_debug_active( void );
+
 #endif /* UTILS_DEBUG_H */
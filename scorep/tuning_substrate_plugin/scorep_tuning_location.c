@@ -0,0 +1,166 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2015-2017,
+ * Technische Universitaet Muenchen, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ *
+ */
+
+// #include <config.h>
+
+#include "scorep_tuning_location.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+static SCOREP_TuningLocationType* scorep_tuning_locations = NULL;
+static pthread_mutex_t            scorep_tuning_locations_lock = PTHREAD_MUTEX_INITIALIZER;
+static volatile unsigned int      scorep_tuning_locations_generation = 0;
+static uint64_t                   deleted_applied                    = 0;
+static uint64_t                   deleted_suppressed                 = 0;
+
+/* Locations are bound to threads, so the last one used by a thread is nearly always the next one */
+static __thread SCOREP_TuningLocationType* scorep_tuning_last_location = NULL;
+static __thread unsigned int               scorep_tuning_last_generation = 0;
+
+static void
+reserve( SCOREP_TuningLocationType* state,
+         uint16_t                   action )
+{
+    /* wider than the action, an action of 32768 or more needs 65536 entries */
+    uint32_t size = state->numberOfActions ? state->numberOfActions : 4;
+    while ( size <= action )
+    {
+        size <<= 1;
+    }
+
+    state->currentValue      = ( int* )realloc( state->currentValue, size * sizeof( int ) );
+    state->currentValueKnown = ( uint8_t* )realloc( state->currentValueKnown, size * sizeof( uint8_t ) );
+    state->restoreStack      = ( SCOREP_StackType** )realloc( state->restoreStack, size * sizeof( SCOREP_StackType* ) );
+    assert( state->currentValue && state->currentValueKnown && state->restoreStack );
+
+    for ( uint32_t i = state->numberOfActions; i < size; i++ )
+    {
+        state->currentValue[ i ]      = 0;
+        state->currentValueKnown[ i ] = 0;
+        state->restoreStack[ i ]      = initStack();
+    }
+    state->numberOfActions = size;
+}
+
+SCOREP_TuningLocationType*
+scorep_tuning_location_get( const struct SCOREP_Location* location,
+                            uint16_t                      action )
+{
+    SCOREP_TuningLocationType* state = NULL;
+
+    /* the last location may have been freed by another thread unless the generation is unchanged */
+    if ( scorep_tuning_last_generation == scorep_tuning_locations_generation
+         && scorep_tuning_last_location != NULL
+         && scorep_tuning_last_location->location == location )
+    {
+        state = scorep_tuning_last_location;
+    }
+    else
+    {
+        pthread_mutex_lock( &scorep_tuning_locations_lock );
+        for ( state = scorep_tuning_locations; state != NULL && state->location != location; state = state->next )
+        {
+        }
+        if ( state == NULL )
+        {
+            state = ( SCOREP_TuningLocationType* )calloc( 1, sizeof( SCOREP_TuningLocationType ) );
+            assert( state );
+            state->location         = location;
+            state->next             = scorep_tuning_locations;
+            scorep_tuning_locations = state;
+        }
+        scorep_tuning_last_generation = scorep_tuning_locations_generation;
+        pthread_mutex_unlock( &scorep_tuning_locations_lock );
+        scorep_tuning_last_location = state;
+    }
+
+    if ( action >= state->numberOfActions )
+    {
+        reserve( state, action );
+    }
+    return state;
+}
+
+static void
+free_location( SCOREP_TuningLocationType* state )
+{
+    for ( uint32_t i = 0; i < state->numberOfActions; i++ )
+    {
+        finalizeStack( state->restoreStack[ i ] );
+    }
+    free( state->currentValue );
+    free( state->currentValueKnown );
+    free( state->restoreStack );
+    free( state );
+}
+
+void
+scorep_tuning_location_delete( const struct SCOREP_Location* location )
+{
+    pthread_mutex_lock( &scorep_tuning_locations_lock );
+    for ( SCOREP_TuningLocationType** link = &scorep_tuning_locations; *link != NULL; link = &( *link )->next )
+    {
+        if ( ( *link )->location == location )
+        {
+            SCOREP_TuningLocationType* state = *link;
+            *link = state->next;
+            /* keeps the counters of the location for the summary */
+            deleted_applied    += state->applied;
+            deleted_suppressed += state->suppressed;
+            free_location( state );
+            scorep_tuning_locations_generation++;
+            break;
+        }
+    }
+    pthread_mutex_unlock( &scorep_tuning_locations_lock );
+}
+
+void
+scorep_tuning_location_counters( uint64_t* applied,
+                                 uint64_t* suppressed )
+{
+    pthread_mutex_lock( &scorep_tuning_locations_lock );
+    *applied    = deleted_applied;
+    *suppressed = deleted_suppressed;
+    for ( SCOREP_TuningLocationType* state = scorep_tuning_locations; state != NULL; state = state->next )
+    {
+        *applied    += state->applied;
+        *suppressed += state->suppressed;
+    }
+    pthread_mutex_unlock( &scorep_tuning_locations_lock );
+}
+
+void
+scorep_tuning_finalize_locations( void )
+{
+    pthread_mutex_lock( &scorep_tuning_locations_lock );
+    while ( scorep_tuning_locations != NULL )
+    {
+        SCOREP_TuningLocationType* state = scorep_tuning_locations;
+        scorep_tuning_locations = state->next;
+        free_location( state );
+    }
+    deleted_applied    = 0;
+    deleted_suppressed = 0;
+    /* invalidates the last location of every thread */
+    scorep_tuning_locations_generation++;
+    pthread_mutex_unlock( &scorep_tuning_locations_lock );
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2015-2017,
+ * Technische Universitaet Muenchen, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+#ifndef SCOREP_TUNING_LOCATION_H
+#define SCOREP_TUNING_LOCATION_H
+
+/**
+ * @file scorep_tuning_location.h
+ *
+ * Per location state of the tuning actions: the value each action has on the location and the
+ * values to restore at region exit. It lets the substrate skip applications and restores that
+ * would not change the value, e.g. nested significant regions requesting the same frequency.
+ */
+
+#include "scorep_tuning_stack.h"
+
+#include <stdint.h>
+
+struct SCOREP_Location;
+
+typedef struct SCOREP_TuningLocationStruct
+{
+    const struct SCOREP_Location*        location;
+    uint32_t                             numberOfActions;   /**< Actions the arrays below have room for */
+    int*                                 currentValue;      /**< Value applied last, by tuning action */
+    uint8_t*                             currentValueKnown; /**< Whether the action was applied on the location */
+    SCOREP_StackType**                   restoreStack;      /**< Restore values and whether the enter was applied, by tuning action */
+    uint64_t                             applied;           /**< Setter calls made */
+    uint64_t                             suppressed;        /**< Setter calls skipped because they would change nothing */
+    struct SCOREP_TuningLocationStruct*  next;
+} SCOREP_TuningLocationType;
+
+/**
+ * State of a location, created on its first event, with room for action index @a action.
+ */
+SCOREP_TuningLocationType*
+scorep_tuning_location_get( const struct SCOREP_Location* location,
+                            uint16_t                      action );
+
+/**
+ * Releases the state of a deleted location.
+ */
+void
+scorep_tuning_location_delete( const struct SCOREP_Location* location );
+
+/**
+ * Sum of the applied and suppressed tuning actions and restores of all locations, deleted ones included.
+ */
+void
+scorep_tuning_location_counters( uint64_t* applied,
+                                 uint64_t* suppressed );
+
+void
+scorep_tuning_finalize_locations( void );
+
+#endif /* SCOREP_TUNING_LOCATION_H */
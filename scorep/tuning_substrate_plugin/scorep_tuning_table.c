@@ -92,8 +92,6 @@ scorep_tuning_finalize_action_table( void )
 {
     for ( uint16_t i = 0; i < scorep_tuning_action_table_next_free_entry; i++ )
     {
-        free( scorep_tuning_action_table[ i ].restoreValueStack );
-//        finalizeStack ( scorep_tuning_action_table[ i ].restoreValueStack );
         free( scorep_tuning_action_table[ i ].name );
     }
 
@@ -127,20 +125,11 @@ scorep_tuning_action_table_fill_entry( char*                   name,
     scorep_tuning_action_table[ i ].languageType                   = languageType;
     scorep_tuning_action_table[ i ].restoreValueFlag               = restore;
 
-    if ( !restore )
-    {
-        scorep_tuning_action_table[ i ].restoreValueStack = NULL;
-    }
-    else if ( !scorep_tuning_action_table[ i ].restoreValueStack )
-    {
-        scorep_tuning_action_table[ i ].restoreValueStack = initStack();
-    }
-
 //    printf( "scorep_tuning_action_table_fill_entry: Adding tuning action into the table to the place %u, with following information: kind %d, enterRegionVar %p, "
 //            "exitRegionVar %p, enterRegionFunc %p, exitRegionFunc %p, validationEndRegionFunction %p, "
-//            "restoreValueFlag %d, restoreValueStack %p\n",
+//            "restoreValueFlag %d\n",
 //            i, kind, enterRegionVar, exitRegionVar, enterRegionFunc, exitRegionFunc,
-//            validationEndRegionFunction, restore, scorep_tuning_action_table[ i ].restoreValueStack );
+//            validationEndRegionFunction, restore );
 }
 
 uint16_t
@@ -218,7 +207,6 @@ scorep_tuning_action_table_find_action( char* name )
             scorep_tuning_action_table[ i ].exitRegionVariablePtr          = NULL;
             scorep_tuning_action_table[ i ].kind                           = 0;
             scorep_tuning_action_table[ i ].restoreValueFlag               = 0;
-            scorep_tuning_action_table[ i ].restoreValueStack              = NULL;
             scorep_tuning_action_table[ i ].validationEndRegionFunctionPtr = NULL;
         }
     }
@@ -362,13 +350,6 @@ scorep_tuning_print_action_table( void )
         printf( "  Kind: %d\n", scorep_tuning_action_table[ i ].kind );
         printf( "  Name: %s\n", scorep_tuning_action_table[ i ].name );
         printf( "  Restore flag: %d\n", scorep_tuning_action_table[ i ].restoreValueFlag );
-        if ( scorep_tuning_action_table[ i ].restoreValueFlag != 0 )
-        {
-            printf( "    Stack address: %p\n", ( void* )scorep_tuning_action_table[ i ].restoreValueStack );
-            printf( "    Stack size = %u\n", ( int )scorep_tuning_action_table[ i ].restoreValueStack->size );
-            printf( "    Stack max size = %u\n", ( int )scorep_tuning_action_table[ i ].restoreValueStack->maxSize );
-            printf( "    Stack top value= %d\n", *( scorep_tuning_action_table[ i ].restoreValueStack->value ) );
-        }
         printf( "  Enter region variable address: %p\n", ( void* )scorep_tuning_action_table[ i ].enterRegionVariablePtr );
         printf( "  Exit region variable address: %p\n", ( void* )scorep_tuning_action_table[ i ].exitRegionVariablePtr );
         printf( "  Enter region function address: %p\n", ( void* )scorep_tuning_action_table[ i ].enterRegionFunctionPtr );
@@ -44,7 +44,6 @@ typedef struct SCOREP_TuningActionStruct
 //TODO: Not implemented, should we implement it or remove?
     void ( * validationEndRegionFunctionPtr )( int ); /**< Function called to validate numerical stability at exit region event */
     int               restoreValueFlag;               /**< Restore the previous value at region exit event */
-    SCOREP_StackType* restoreValueStack;              /**< Stack used to keep the previous values of the tuning parameter */
     SCOREP_Language   languageType;                   /**< Language of the function tuning parameter */
 } SCOREP_TuningActionType;
 
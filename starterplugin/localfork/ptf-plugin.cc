@@ -0,0 +1,89 @@
+#include <frontend.h>
+#include <unistd.h>
+
+// Starts the application on the machine of the frontend. The instances of an ensemble run side by
+// side there, each pinned to its own share of the cores so that they do not compete for them.
+
+static const char* tuning_plugins_sep          = ",";
+static const char* openmp_tuning_plugin        = "OpenMPTP";
+static const char* job_startup_cmd             = "mpiexec -n";
+
+static std::string start_cmd( const std::string& appname,
+                              const char*        user_specified_environment,
+                              const std::string& app_run_string,
+                              int                share,
+                              int                shares )
+{
+    RegistryService* regsrv = fe->get_registry();
+
+    std::stringstream appstart_env_vars;
+    std::stringstream appstart_cmd_stream;
+
+    // add the necessary Score-P environment variables
+    appstart_env_vars <<  "export SCOREP_ONLINEACCESS_ENABLE=true; export SCOREP_ENABLE_TRACING=false; export SCOREP_ONLINEACCESS_REG_PORT="
+                      <<  regsrv->get_regport()
+                      <<  "; export SCOREP_ONLINEACCESS_REG_HOST="  <<  regsrv->get_reghost()
+                      <<  "; export SCOREP_ONLINEACCESS_APPL_NAME="  <<  appname
+                      <<  "; export SCOREP_TUNING_PLUGINS_SEP="  <<  tuning_plugins_sep
+                      <<  "; export SCOREP_TUNING_PLUGINS="  <<  openmp_tuning_plugin
+                      <<  "; export SCOREP_TIMER=\"clock_gettime\"";
+
+    // set up the environment as requested by the user
+    appstart_env_vars  <<  "; "  <<  user_specified_environment;
+
+    // set up the environment as requested by the command line options
+    appstart_env_vars  <<  "export OMP_NUM_THREADS="  <<  fe->get_ompnumthreads()  <<  "; ";
+
+    // an instance sharing the machine gets a contiguous range of the cores, the MPI library must not
+    // bind the processes itself
+    long cores = sysconf( _SC_NPROCESSORS_ONLN );
+    long first = share * cores / shares;
+    long last  = ( share + 1 ) * cores / shares - 1;
+    if( shares > 1 && last >= first ) {
+        appstart_env_vars   <<  "export OMPI_MCA_hwloc_base_binding_policy=none; ";
+        appstart_cmd_stream <<  appstart_env_vars.rdbuf()  <<  " taskset -c "  <<  first  <<  "-"  <<  last  <<  " ";
+    }
+    else {
+        appstart_cmd_stream <<  appstart_env_vars.rdbuf()  <<  " ";
+    }
+
+    // build and return the final command
+    appstart_cmd_stream  <<  job_startup_cmd  <<  " "  <<  fe->get_mpinumprocs()  <<  " "  <<  app_run_string;
+
+    return appstart_cmd_stream.str();
+}
+
+extern "C" {
+
+std::string StarterPlugin_appStartCmd(char* user_specified_environment)
+{
+    return start_cmd( fe->get_appname(), user_specified_environment, opts.app_run_string, 0, 1 );
+}
+
+// Optional. Starts the instance of the ensemble slot the starter is launching.
+std::string StarterPlugin_instanceAppStartCmd(char* user_specified_environment)
+{
+    const EnsembleSlot* slot = starter->launching();
+    return start_cmd( slot->appname, user_specified_environment, slot->command, slot->share, slot->shares );
+}
+
+// Optional. All slots of an ensemble share this machine.
+std::string StarterPlugin_allocationHosts(char*)
+{
+    char hostname[ 100 ];
+    gethostname( hostname, 100 );
+    return hostname;
+}
+
+// Optional. The agents run in the working directory of the frontend, in place of the shell.
+std::string StarterPlugin_agentStartPrefix(char*)
+{
+    std::stringstream pre_command;
+    const char*       cwd = getenv( "PWD" );
+
+    pre_command <<  "cd "  <<  ( cwd ? cwd : "." )  <<  "; exec ";
+
+    return pre_command.str();
+}
+
+}
@@ -0,0 +1,224 @@
+#define BOOST_TEST_MODULE ContextKey
+
+#include <boost/test/included/unit_test.hpp>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "global.h"
+#include "DataProvider.h"
+#include "PerformanceDataBase.h"
+#include "rts.h"
+
+// defined by the main program of the agent
+PerformanceDataBase* pdb;
+Application*         appl;
+bool                 rts_support = false;
+
+namespace legacy {
+/// The string key of the performance data base before it was keyed by DataEntryKey, see PerformanceDataBase::ct_2_string()
+std::string ct_2_string( Context* ct,
+                         Metric   m ) {
+    std::stringstream key;
+    std::stringstream reg_name_build;
+    std::string       reg_name;
+
+    int line_number = ct->getRfl();
+    reg_name = ct->getRegion()->get_name();
+
+    if( m == PSC_IMPLICIT_BARRIER_TIME ) {
+        line_number = ct->getRegion()->get_ident().end_position;
+        reg_name_build << "!$omp implicit barrier @" << ct->getRegion()->get_ident().file_name
+                       << ":" << line_number;
+        reg_name = reg_name_build.str();
+    }
+
+    if( ct->isRtsBased() ) {
+        key << ":" << ct->getFileId() << ":" << line_number << ":" << reg_name << ":"
+            << ct->getRank() << ":" << ct->getThread() << ":" << EventList[ m ].EventName << ":" << ct->getRtsID();
+    }
+    else {
+        key << ":" << ct->getFileId() << ":" << line_number << ":" << reg_name << ":"
+            << ct->getRank() << ":" << ct->getThread() << ":" << EventList[ m ].EventName;
+    }
+    return key.str();
+}
+}
+
+/*
+ * Regions of the application: a subroutine and a loop, an OpenMP parallel region and a loop in it
+ * that end on the same line and so share their implicit barrier, a copy of the subroutine as sent
+ * by the frontend, two equal regions the registry does not know and two call-tree nodes of the
+ * subroutine. Contexts of every location, 2 ranks and 2 threads.
+ */
+struct Regions {
+    static const int ranks   = 2;
+    static const int threads = 2;
+
+    Region*               solve;
+    Region*               loop;
+    Region*               parallel;
+    Region*               parallelLoop;
+    Region*               copy;
+    Region*               helper;
+    Region*               helperTwin;
+    SCOREP_OA_CallTreeDef definition;
+    Rts*                  node;
+    Rts*                  nodeTwin;
+    std::vector<Context*> contexts;
+
+    Regions() {
+        if( !EventList ) {
+            initEventlist( "" );
+        }
+        appl         = &Application::instance();
+        solve        = appl->addSCOREPRegion( 10, "solver.c", "solve", SUB_REGION, 10, 80 );
+        loop         = appl->addSCOREPRegion( 20, "solver.c", "loop", LOOP_REGION, 20, 30 );
+        parallel     = appl->addSCOREPRegion( 40, "solver.c", "!$omp parallel @solver.c:40", PARALLEL_REGION, 40, 60 );
+        parallelLoop = appl->addSCOREPRegion( 45, "solver.c", "!$omp for @solver.c:45", DO_REGION, 45, 60 );
+        copy         = new Region( *solve );
+        helper       = new Region( SUB_REGION, solve->get_ident().file_id, 90, 90, 95, "solver.c", "helper" );
+        helperTwin   = new Region( SUB_REGION, solve->get_ident().file_id, 90, 90, 95, "solver.c", "helper" );
+
+        memset( &definition, 0, sizeof( definition ) );
+        strcpy( definition.name, "solve" );
+        node     = new Rts( &definition, solve );
+        nodeTwin = new Rts( &definition, solve );
+
+        Region* regions[] = { solve, loop, parallel, parallelLoop, copy, helper, helperTwin };
+        for( int rank = 0; rank < ranks; rank++ ) {
+            for( int thread = 0; thread < threads; thread++ ) {
+                for( size_t r = 0; r < sizeof( regions ) / sizeof( regions[ 0 ] ); r++ ) {
+                    contexts.push_back( new Context( regions[ r ], rank, thread ) );
+                }
+                contexts.push_back( new Context( node, rank, thread ) );
+                contexts.push_back( new Context( nodeTwin, rank, thread ) );
+            }
+        }
+    }
+
+    ~Regions() {
+        for( size_t i = 0; i < contexts.size(); i++ ) {
+            delete contexts[ i ];
+        }
+        delete node;
+        delete nodeTwin;
+        delete copy;
+        delete helper;
+        delete helperTwin;
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( context, Regions )
+
+BOOST_AUTO_TEST_CASE( equality_follows_location_rank_and_thread ) {
+    BOOST_CHECK( Context( solve, 1, 1 ) == Context( solve, 1, 1 ) );
+    BOOST_CHECK( Context( solve, 1, 1 ) != Context( solve, 0, 1 ) );
+    BOOST_CHECK( Context( solve, 1, 1 ) != Context( solve, 1, 0 ) );
+    BOOST_CHECK( Context( solve, 1, 1 ) != Context( loop, 1, 1 ) );
+    BOOST_CHECK( Context( node, 1, 1 ) == Context( node, 1, 1 ) );
+    BOOST_CHECK( Context( node, 1, 1 ) != Context( nodeTwin, 1, 1 ) );
+    // a call-tree node is not its region
+    BOOST_CHECK( Context( node, 1, 1 ) != Context( solve, 1, 1 ) );
+
+    for( size_t i = 0; i < contexts.size(); i++ ) {
+        Context* copied = contexts[ i ]->copy();
+        BOOST_CHECK( *copied == *contexts[ i ] );
+        BOOST_CHECK_EQUAL( copied->hash(), contexts[ i ]->hash() );
+        BOOST_CHECK_EQUAL( std::hash<Context>()( *copied ), std::hash<Context>()( *contexts[ i ] ) );
+        delete copied;
+
+        for( size_t j = 0; j < contexts.size(); j++ ) {
+            BOOST_CHECK_EQUAL( *contexts[ i ] == *contexts[ j ], i == j );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( order_is_strict_weak_and_by_rank_thread_and_line ) {
+    for( size_t i = 0; i < contexts.size(); i++ ) {
+        const Context& a = *contexts[ i ];
+        BOOST_CHECK( !( a < a ) );
+        for( size_t j = 0; j < contexts.size(); j++ ) {
+            const Context& b = *contexts[ j ];
+            BOOST_CHECK( !( a < b && b < a ) );
+            BOOST_CHECK_EQUAL( !( a < b ) && !( b < a ), a == b );
+            for( size_t k = 0; k < contexts.size(); k++ ) {
+                if( a < b && b < *contexts[ k ] ) {
+                    BOOST_CHECK( a < *contexts[ k ] );
+                }
+            }
+        }
+    }
+
+    std::vector<Context*> sorted( contexts.rbegin(), contexts.rend() );
+    std::sort( sorted.begin(), sorted.end(), []( const Context* a, const Context* b ) {
+        return *a < *b;
+    } );
+    for( size_t i = 1; i < sorted.size(); i++ ) {
+        Context* a = sorted[ i - 1 ];
+        Context* b = sorted[ i ];
+        BOOST_CHECK_LE( a->getRank(), b->getRank() );
+        if( a->getRank() == b->getRank() ) {
+            BOOST_CHECK_LE( a->getThread(), b->getThread() );
+            if( a->getThread() == b->getThread() ) {
+                BOOST_CHECK_LE( a->getRfl(), b->getRfl() );
+            }
+        }
+    }
+
+    std::set<Context> unique;
+    for( size_t i = 0; i < contexts.size(); i++ ) {
+        unique.insert( *contexts[ i ] );
+        Context* copied = contexts[ i ]->copy();
+        unique.insert( *copied );
+        delete copied;
+    }
+    BOOST_CHECK_EQUAL( unique.size(), contexts.size() );
+}
+
+BOOST_AUTO_TEST_CASE( data_entries_match_string_keys ) {
+    const Metric metrics[] = { PSC_EXECUTION_TIME, PSC_IMPLICIT_BARRIER_TIME, PSC_NODE_ENERGY };
+    const size_t count     = sizeof( metrics ) / sizeof( metrics[ 0 ] );
+    pdb = new PerformanceDataBase( new DataProvider( appl, "phase", NULL ) );
+
+    // every context stores its own value, the last one stored under a string key is the one to find
+    std::map<std::string, INT64> expected;
+    INT64                        value = 1;
+    for( size_t i = 0; i < contexts.size(); i++ ) {
+        for( size_t m = 0; m < count; m++, value++ ) {
+            pdb->store( contexts[ i ], metrics[ m ], value );
+            expected[ legacy::ct_2_string( contexts[ i ], metrics[ m ] ) ] = value;
+        }
+    }
+    // the copy shares the entries of the subroutine, the parallel region and its loop their barrier
+    BOOST_CHECK_LT( expected.size(), contexts.size() * count );
+
+    for( size_t i = 0; i < contexts.size(); i++ ) {
+        for( size_t m = 0; m < count; m++ ) {
+            INT64 result = 0;
+            BOOST_CHECK_EQUAL( pdb->getLastIterationValue( contexts[ i ], metrics[ m ], result ), PDB_SCOREP_SUCCESS );
+            BOOST_CHECK_EQUAL( result, expected[ legacy::ct_2_string( contexts[ i ], metrics[ m ] ) ] );
+            BOOST_CHECK_EQUAL( pdb->get( contexts[ i ], metrics[ m ] ), result );
+        }
+    }
+
+    INT64   result = 0;
+    Context unmeasured( loop, ranks, 0 );
+    BOOST_CHECK_EQUAL( pdb->getLastIterationValue( &unmeasured, PSC_EXECUTION_TIME, result ), PDB_SCOREP_NOT_FOUND );
+    BOOST_CHECK_EQUAL( pdb->getLastIterationValue( contexts[ 0 ], PSC_MPI_LATE_SEND, result ), PDB_SCOREP_NOT_FOUND );
+
+    Context solveContext( solve, 1, 1 ), copyContext( copy, 1, 1 ), parallelContext( parallel ), parallelLoopContext( parallelLoop );
+    BOOST_CHECK_EQUAL( pdb->get( &copyContext, PSC_EXECUTION_TIME ), pdb->get( &solveContext, PSC_EXECUTION_TIME ) );
+    BOOST_CHECK_EQUAL( pdb->get( &parallelContext, PSC_IMPLICIT_BARRIER_TIME ), pdb->get( &parallelLoopContext, PSC_IMPLICIT_BARRIER_TIME ) );
+    BOOST_CHECK_NE( pdb->get( &parallelContext, PSC_EXECUTION_TIME ), pdb->get( &parallelLoopContext, PSC_EXECUTION_TIME ) );
+
+    delete pdb;
+    pdb = NULL;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,277 @@
+/* Heap allocations and time of storing the profile of an experiment, before and after contexts became values.
+ *
+ * Stores the measurements of the given number of regions, processes and threads the way
+ * DataProvider::storeProfile() does, two data base entries and two global metric notifications per
+ * region, process and thread, then notifies and clears the notifications as after every experiment.
+ * Before, every data base access formatted a string key into an ordered map and every notification
+ * copied its context to the heap under another formatted key. After, the data base is keyed by
+ * DataEntryKey with the handle of the region in the registry, and the notifications keep the
+ * context by value in a vector that is sorted and deduplicated when they are sent. Both keep one
+ * map node per entry and iteration. The contexts are stand-ins of the same size, test_context_key
+ * checks Context and the keys of the data base themselves.
+ *
+ * Usage: context_key_bench [regions] [processes] [threads] [experiments]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DataEntryKey.h"
+#include "RegionRegistry.h"
+
+static size_t allocations;
+
+void* operator new( size_t size ) {
+    allocations++;
+    void* p = malloc( size ? size : 1 );
+    if( !p ) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete( void* p ) noexcept {
+    free( p );
+}
+
+void operator delete( void* p, size_t ) noexcept {
+    free( p );
+}
+
+typedef long long INT64;
+
+// the members of Context
+struct ContextValue {
+    Region* reg;
+    Rts*    rts;
+    int     rank;
+    int     thread;
+    int     aa_rts_id;
+    bool    rtsBased;
+
+    bool operator==( const ContextValue& other ) const {
+        return rtsBased == other.rtsBased && rank == other.rank && thread == other.thread
+               && ( rtsBased ? rts == other.rts : reg == other.reg );
+    }
+
+    bool operator<( const ContextValue& other ) const {
+        if( rank != other.rank ) {
+            return rank < other.rank;
+        }
+        if( thread != other.thread ) {
+            return thread < other.thread;
+        }
+        if( rtsBased != other.rtsBased ) {
+            return rtsBased < other.rtsBased;
+        }
+        return rtsBased ? std::less<Rts*>()( rts, other.rts ) : std::less<Region*>()( reg, other.reg );
+    }
+};
+
+struct RegionInfo {
+    std::string name;
+    int         file_id;
+    int         rfl;
+};
+
+static const Metric      metrics[]      = { PSC_EXECUTION_TIME, PSC_INSTANCES };
+static const char* const metric_names[] = { "PSC_EXECUTION_TIME", "PSC_INSTANCES" };
+
+// the registry never dereferences regions, distinct addresses stand in for them
+static std::vector<char>       objects;
+static std::vector<RegionInfo> infos;
+
+static Region* region( int i ) {
+    return reinterpret_cast<Region*>( &objects[ i ] );
+}
+
+static int region_index( Region* reg ) {
+    return reinterpret_cast<char*>( reg ) - &objects[ 0 ];
+}
+
+/// The data base and notification list before
+struct Before {
+    struct Notification {
+        ContextValue* ct;
+        Metric        m_id;
+    };
+
+    std::map<std::string, std::map<int, INT64> > data;
+    std::map<std::string, Notification>          notify;
+
+    std::string key( const ContextValue& ct,
+                     int                 m ) {
+        const RegionInfo& info = infos[ region_index( ct.reg ) ];
+        std::stringstream key;
+        key << ":" << info.file_id << ":" << info.rfl << ":" << info.name << ":"
+            << ct.rank << ":" << ct.thread << ":" << metric_names[ m ];
+        return key.str();
+    }
+
+    void store( const ContextValue& ct,
+                int                 m,
+                int                 iteration,
+                INT64               value ) {
+        std::string k = key( ct, m );
+        if( data.find( k ) == data.end() ) {
+            std::map<int, INT64> new_map;
+            data[ k ] = new_map;
+        }
+        data[ k ][ iteration ] = value;
+    }
+
+    void add_notification( const ContextValue& ct,
+                           int                 m ) {
+        const RegionInfo& info = infos[ region_index( ct.reg ) ];
+        Notification      mn;
+        mn.ct   = new ContextValue( ct );
+        mn.m_id = metrics[ m ];
+        std::stringstream key;
+        key << metric_names[ m ] << info.name << info.file_id << info.rfl << ct.rank << ct.thread;
+        notify[ key.str() ] = mn;
+    }
+
+    size_t notify_all() {
+        size_t sum = 0;
+        for( std::map<std::string, Notification>::iterator it = notify.begin(); it != notify.end(); ++it ) {
+            sum += it->second.ct->rank;
+            delete it->second.ct;
+        }
+        notify.clear();
+        return sum;
+    }
+};
+
+/// The data base and notification list after
+struct After {
+    struct Notification {
+        ContextValue ct;
+        Metric       m_id;
+
+        bool operator==( const Notification& other ) const {
+            return m_id == other.m_id && ct == other.ct;
+        }
+
+        bool operator<( const Notification& other ) const {
+            return m_id != other.m_id ? m_id < other.m_id : ct < other.ct;
+        }
+    };
+
+    RegionRegistry&                                                           registry;
+    std::unordered_map<DataEntryKey, std::map<int, INT64>, DataEntryKeyHash> data;
+    std::vector<Notification>                                                 notify;
+
+    After( RegionRegistry& registry_p ) : registry( registry_p ) {
+    }
+
+    DataEntryKey key( const ContextValue& ct,
+                      int                 m ) {
+        const RegionInfo& info = infos[ region_index( ct.reg ) ];
+        DataEntryKey      key;
+        key.region  = registry.findRegion( ct.reg );
+        key.name    = RegionRegistry::NO_HANDLE;
+        key.file_id = info.file_id;
+        key.line    = info.rfl;
+        key.rank    = ct.rank;
+        key.thread  = ct.thread;
+        key.rts_id  = -1;
+        key.metric  = metrics[ m ];
+        return key;
+    }
+
+    void store( const ContextValue& ct,
+                int                 m,
+                int                 iteration,
+                INT64               value ) {
+        data[ key( ct, m ) ][ iteration ] = value;
+    }
+
+    void add_notification( const ContextValue& ct,
+                           int                 m ) {
+        Notification mn = { ct, metrics[ m ] };
+        notify.push_back( mn );
+    }
+
+    size_t notify_all() {
+        std::sort( notify.begin(), notify.end() );
+        notify.erase( std::unique( notify.begin(), notify.end() ), notify.end() );
+        size_t sum = 0;
+        for( size_t i = 0; i < notify.size(); i++ ) {
+            sum += notify[ i ].ct.rank;
+        }
+        notify.clear();
+        return sum;
+    }
+};
+
+static volatile size_t sink;
+
+template<typename DataBase>
+static void run( const char* label,
+                 DataBase&   db,
+                 int         regions,
+                 int         processes,
+                 int         threads,
+                 int         experiments ) {
+    for( int e = 0; e < experiments; e++ ) {
+        size_t                                before = allocations;
+        std::chrono::steady_clock::time_point start  = std::chrono::steady_clock::now();
+        for( int r = 0; r < regions; r++ ) {
+            for( int p = 0; p < processes; p++ ) {
+                for( int t = 0; t < threads; t++ ) {
+                    ContextValue ct = { region( r ), NULL, p, t, 0, false };
+                    db.store( ct, 0, e, r + p + t );
+                    db.store( ct, 1, e, 1 );
+                    db.add_notification( ct, 0 );
+                    db.add_notification( ct, 1 );
+                }
+            }
+        }
+        sink = db.notify_all();
+        double ms = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+        printf( "%-8s %10d %14zu %14.2f %10.1f\n", label, e, allocations - before,
+                ( double )( allocations - before ) / ( ( double )regions * processes * threads ), ms );
+    }
+}
+
+int main( int argc, char** argv ) {
+    int regions     = argc > 1 ? atoi( argv[ 1 ] ) : 2000;
+    int processes   = argc > 2 ? atoi( argv[ 2 ] ) : 8;
+    int threads     = argc > 3 ? atoi( argv[ 3 ] ) : 4;
+    int experiments = argc > 4 ? atoi( argv[ 4 ] ) : 3;
+
+    RegionRegistry registry;
+    objects.resize( regions );
+    infos.resize( regions );
+    for( int i = 0; i < regions; i++ ) {
+        infos[ i ].name    = "kernel_" + std::to_string( i );
+        infos[ i ].file_id = 1 + i % 50;
+        infos[ i ].rfl     = 10 + i;
+        registry.addRegion( region( i ), "file*" + infos[ i ].name + "*" + std::to_string( infos[ i ].rfl ) );
+    }
+
+    printf( "%d regions, %d processes, %d threads: two entries and two notifications per context\n",
+            regions, processes, threads );
+    printf( "%-8s %10s %14s %14s %10s\n", "", "experiment", "allocations", "per context", "ms" );
+
+    Before before;
+    run( "before", before, regions, processes, threads, experiments );
+    After after( registry );
+    run( "after", after, regions, processes, threads, experiments );
+
+    if( before.data.size() != after.data.size() ) {
+        fprintf( stderr, "%zu entries before, %zu after\n", before.data.size(), after.data.size() );
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,214 @@
+#define BOOST_TEST_MODULE FakeScorepOA
+#include <boost/test/included/unit_test.hpp>
+
+#include "FakeScorepOA.h"
+#include "sockets.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <fstream>
+
+static FakeOAConfig small_config() {
+    FakeOAConfig config;
+    config.processes = 2;
+    config.threads   = 2;
+    config.regions   = 9;
+    config.phaseTime = 2000;
+    return config;
+}
+
+
+static std::string read_line( int sock ) {
+    char line[ 2000 ];
+    int  length;
+    while( ( length = socket_read_line( sock, line, sizeof( line ) ) ) == 0 ) {
+    }
+    return length < 0 ? "" : line;
+}
+
+
+// reads one buffer the way DataProvider::blockingBufferReceive does
+template< typename T >
+static std::vector< T > read_buffer( int         sock,
+                                     const char* header ) {
+    BOOST_REQUIRE_EQUAL( read_line( sock ), header );
+    int count = 0;
+    BOOST_REQUIRE_EQUAL( socket_blockread( sock, ( char* )&count, sizeof( count ) ), ( int )sizeof( count ) );
+    std::vector< T > buffer( count );
+    BOOST_REQUIRE_EQUAL( socket_blockread( sock, ( char* )buffer.data(), count * sizeof( T ) ), ( int )( count * sizeof( T ) ) );
+    return buffer;
+}
+
+
+BOOST_AUTO_TEST_CASE( requested_metric_parsing ) {
+    BOOST_CHECK_EQUAL( fake_oa_requested_metric( "REQUEST[0] GLOBAL execution_time;" ), "execution_time" );
+    BOOST_CHECK_EQUAL( fake_oa_requested_metric( "REQUEST[0] GLOBAL METRIC PAPI \"PAPI_TOT_CYC\";" ), "PAPI_TOT_CYC" );
+    BOOST_CHECK_EQUAL( fake_oa_requested_metric( "REQUEST[0] GLOBAL METRIC PLUGIN \"hdeem_sync_plugin\" \"hdeem/BLADE/E\";" ),
+                       "hdeem/BLADE/E" );
+    BOOST_CHECK_EQUAL( fake_oa_requested_metric( "request[0] global MPI;" ), "late_send" );
+    BOOST_CHECK_EQUAL( fake_oa_requested_metric( "request[0] local (1, PARALLEL_REGION, 10) = 1;" ), "" );
+}
+
+
+BOOST_AUTO_TEST_CASE( protocol_session ) {
+    FakeOAConfig config = small_config();
+    FakeScorepOA producer( config );
+    BOOST_REQUIRE( producer.listen( 42000 + getpid() % 10000 ) );
+
+    pid_t child = fork();
+    BOOST_REQUIRE( child >= 0 );
+    if( child == 0 ) {
+        // only rank 1 is connected, the session ends when it terminates
+        time_t start = time( NULL );
+        while( producer.stats().finished == 0 && time( NULL ) - start < 60 ) {
+            producer.serve( 100 );
+        }
+        _exit( producer.stats().summaries == 1 ? 0 : 1 );
+    }
+
+    char host[] = "localhost";
+    int  sock   = socket_client_connect_retry( host, producer.port( 1 ), 100 );
+    BOOST_REQUIRE( sock >= 0 );
+
+    socket_write_line( sock, "getmpirank;\n" );
+    BOOST_CHECK_EQUAL( read_line( sock ), "MPIRANK" );
+    int rank = -1;
+    BOOST_REQUIRE_EQUAL( socket_blockread( sock, ( char* )&rank, sizeof( rank ) ), ( int )sizeof( rank ) );
+    BOOST_CHECK_EQUAL( rank, 1 );
+
+    socket_write_line( sock, "setnumiterations 2;\n" );
+    socket_write_line( sock, "beginrequests;\n" );
+    BOOST_CHECK_EQUAL( read_line( sock ), "OK" );
+    socket_write_line( sock, "REQUEST[0] GLOBAL execution_time;\n" );
+    BOOST_CHECK_EQUAL( read_line( sock ), "OK" );
+    socket_write_line( sock, "REQUEST[0] GLOBAL METRIC PAPI \"PAPI_TOT_CYC\";\n" );
+    BOOST_CHECK_EQUAL( read_line( sock ), "OK" );
+    socket_write_line( sock, "endrequests;\n" );
+    BOOST_CHECK_EQUAL( read_line( sock ), "OK" );
+
+    socket_write_line( sock, "runtoend (0,0);\n" );
+    BOOST_CHECK_EQUAL( read_line( sock ), "SUSPENDED" );
+
+    socket_write_line( sock, "getsummarydata;\n" );
+    std::vector< SCOREP_OA_CallPathRegionDef >      regions  = read_buffer< SCOREP_OA_CallPathRegionDef >( sock, "MERGED_REGION_DEFINITIONS" );
+    std::vector< SCOREP_OA_FlatProfileMeasurement > flat     = read_buffer< SCOREP_OA_FlatProfileMeasurement >( sock, "FLAT_PROFILE" );
+    std::vector< SCOREP_OA_CallPathCounterDef >     counters = read_buffer< SCOREP_OA_CallPathCounterDef >( sock, "METRIC_DEFINITIONS" );
+    std::vector< SCOREP_OA_CallTreeDef >            calltree = read_buffer< SCOREP_OA_CallTreeDef >( sock, "CALLTREE_DEFINITIONS" );
+    std::vector< SCOREP_OA_RtsMeasurement >         rts      = read_buffer< SCOREP_OA_RtsMeasurement >( sock, "RTS_MEASUREMENTS" );
+
+    BOOST_CHECK_EQUAL( regions.size(), 9u );
+    BOOST_CHECK_EQUAL( regions[ 0 ].name, config.phase );
+    BOOST_CHECK_EQUAL( regions[ 0 ].adapter_type, ( uint32_t )SCOREP_ADAPTER_USER );
+    BOOST_REQUIRE_EQUAL( counters.size(), 2u );
+    BOOST_CHECK_EQUAL( counters[ 0 ].name, std::string( "execution_time" ) );
+    BOOST_CHECK_EQUAL( counters[ 1 ].name, std::string( "PAPI_TOT_CYC" ) );
+    BOOST_CHECK_EQUAL( flat.size(), 2u * 9u * 2u );
+    BOOST_CHECK_EQUAL( calltree.size(), 9u );
+    BOOST_CHECK_EQUAL( rts.size(), flat.size() );
+    for( size_t i = 0; i < flat.size(); i++ ) {
+        BOOST_CHECK_EQUAL( flat[ i ].rank, 1u );
+        BOOST_CHECK( flat[ i ].region_id < regions.size() );
+        BOOST_CHECK( flat[ i ].metric_id < counters.size() );
+        if( flat[ i ].region_id == 0 && flat[ i ].metric_id == 0 ) {
+            // two iterations of the phase on rank 1, which runs 5% slower
+            BOOST_CHECK_EQUAL( flat[ i ].int_val, 2u * 2000u * 1000u * 105u / 100u );
+            BOOST_CHECK_EQUAL( flat[ i ].samples, 2u );
+        }
+    }
+
+    socket_write_line( sock, "terminate;\n" );
+    close( sock );
+
+    int status;
+    BOOST_REQUIRE_EQUAL( waitpid( child, &status, 0 ), child );
+    BOOST_CHECK( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( metric_limit_and_determinism ) {
+    FakeOAConfig config = small_config();
+    config.metrics = 1;
+    FakeScorepOA producer( config );
+
+    std::vector< std::string > requested;
+    requested.push_back( "PAPI_TOT_CYC" );
+    requested.push_back( "execution_time" );
+
+    FakeOASummary first  = producer.summary( 0, requested );
+    FakeOASummary second = producer.summary( 0, requested );
+    BOOST_REQUIRE_EQUAL( first.counters.size(), 1u );
+    BOOST_CHECK_EQUAL( first.counters[ 0 ].name, std::string( "PAPI_TOT_CYC" ) );
+    BOOST_REQUIRE_EQUAL( first.flat.size(), second.flat.size() );
+    for( size_t i = 0; i < first.flat.size(); i++ ) {
+        BOOST_CHECK_EQUAL( first.flat[ i ].int_val, second.flat[ i ].int_val );
+    }
+
+    // nothing requested still answers with time, Score-P never sends an empty buffer
+    FakeOASummary none = producer.summary( 0, std::vector< std::string >() );
+    BOOST_REQUIRE_EQUAL( none.counters.size(), 1u );
+    BOOST_CHECK_EQUAL( none.counters[ 0 ].name, std::string( "execution_time" ) );
+}
+
+
+template< typename T >
+static void record( std::ofstream&          out,
+                    const char*             header,
+                    const std::vector< T >& buffer ) {
+    int count = buffer.size();
+    out << header << "\n";
+    out.write( ( const char* )&count, sizeof( count ) );
+    out.write( ( const char* )buffer.data(), count * sizeof( T ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( replay_filters_and_rebinds_ranks ) {
+    FakeOAConfig config = small_config();
+    FakeScorepOA synthetic( config );
+
+    std::vector< std::string > both;
+    both.push_back( "execution_time" );
+    both.push_back( "PAPI_TOT_CYC" );
+    FakeOASummary recorded = synthetic.summary( 0, both );
+
+    char prefix[] = "/tmp/psc_fake_oa_XXXXXX";
+    int  fd       = mkstemp( prefix );
+    BOOST_REQUIRE( fd >= 0 );
+    close( fd );
+    std::string file = std::string( prefix ) + ".0";
+    {
+        std::ofstream out( file.c_str(), std::ios::binary );
+        record( out, "MERGED_REGION_DEFINITIONS", recorded.regions );
+        record( out, "FLAT_PROFILE", recorded.flat );
+        record( out, "METRIC_DEFINITIONS", recorded.counters );
+        record( out, "CALLTREE_DEFINITIONS", recorded.calltree );
+        record( out, "RTS_MEASUREMENTS", recorded.rts );
+    }
+
+    config.replay    = prefix;
+    config.processes = 4;
+    FakeScorepOA replay( config );
+    BOOST_REQUIRE( replay.loadReplay() );
+
+    std::vector< std::string > cycles( 1, "PAPI_TOT_CYC" );
+    FakeOASummary              summary = replay.summary( 3, cycles );
+    BOOST_REQUIRE_EQUAL( summary.counters.size(), 1u );
+    BOOST_CHECK_EQUAL( summary.counters[ 0 ].name, std::string( "PAPI_TOT_CYC" ) );
+    BOOST_CHECK_EQUAL( summary.regions.size(), recorded.regions.size() );
+    BOOST_REQUIRE_EQUAL( summary.flat.size(), recorded.flat.size() / 2 );
+    size_t next = 0;
+    for( size_t i = 0; i < recorded.flat.size(); i++ ) {
+        if( recorded.flat[ i ].metric_id == 1 ) {
+            BOOST_CHECK_EQUAL( summary.flat[ next ].rank, 3u );
+            BOOST_CHECK_EQUAL( summary.flat[ next ].metric_id, 0u );
+            BOOST_CHECK_EQUAL( summary.flat[ next ].int_val, recorded.flat[ i ].int_val );
+            next++;
+        }
+    }
+
+    unlink( file.c_str() );
+    unlink( prefix );
+}
@@ -0,0 +1,163 @@
+#define BOOST_TEST_MODULE PropertyBatch
+
+#include <boost/test/included/unit_test.hpp>
+#include <stdlib.h>
+#include <vector>
+
+#include "FakePerformanceDataBase.h"
+#include "PropertyBatch.h"
+#include "ExecTimeImportance.h"
+
+// defined by the main program of the agent
+PerformanceDataBase* pdb;
+Application*         appl;
+bool                 rts_support = false;
+
+/*
+ * A phase and regions of 4 ranks with 2 threads each, executed for 0 to 3 percent of the phase. Some
+ * regions report no, zero or negative times, the phase of rank 3 reports none, and the node energy
+ * of every fifth region is negative, so that each term of the condition decides some properties.
+ */
+struct Measurements {
+    static const int ranks   = 4;
+    static const int threads = 2;
+    static const int regions = 10;
+
+    Region                 phase;
+    std::vector<Region>    region;
+    std::vector<Context*>  contexts;
+    std::vector<Context*>  phaseContexts;
+
+    Measurements() : region( regions ) {
+        fake_pdb::reset();
+        pdb = new PerformanceDataBase( NULL );
+        for( int rank = 0; rank < ranks; rank++ ) {
+            Context* phaseContext = new Context( &phase, rank, 0 );
+            phaseContexts.push_back( phaseContext );
+            if( rank != 3 ) {
+                pdb->store( phaseContext, PSC_EXECUTION_TIME, 1000 + 100 * rank );
+            }
+            for( int thread = 0; thread < threads; thread++ ) {
+                for( int r = 0; r < regions; r++ ) {
+                    Context* ct = new Context( &region[ r ], rank, thread );
+                    contexts.push_back( ct );
+                    int i = contexts.size();
+                    if( i % 7 != 0 ) {
+                        pdb->store( ct, PSC_EXECUTION_TIME, i % 11 == 0 ? -5 : ( i * 13 ) % 37 );
+                    }
+                    pdb->store( ct, PSC_NODE_ENERGY, r % 5 == 0 ? -1 : 100 + i );
+                    pdb->store( ct, PSC_CPU0_ENERGY, 40 + i );
+                    pdb->store( ct, PSC_CPU1_ENERGY, 50 + i );
+                }
+            }
+        }
+    }
+
+    ~Measurements() {
+        for( size_t i = 0; i < contexts.size(); i++ ) {
+            delete contexts[ i ];
+        }
+        for( size_t i = 0; i < phaseContexts.size(); i++ ) {
+            delete phaseContexts[ i ];
+        }
+        delete pdb;
+        unsetenv( "PSC_BATCH_EVALUATION" );
+        rts_support = false;
+    }
+
+    /// The candidates of an importance step, with the threshold of the Importance strategy; properties own their contexts
+    Prop_List candidates() {
+        Prop_List list;
+        for( size_t i = 0; i < contexts.size(); i++ ) {
+            list.push_back( new ExecTimeImportanceProp( contexts[ i ]->copy(), phaseContexts[ contexts[ i ]->getRank() ]->copy(), 1.0 ) );
+        }
+        return list;
+    }
+
+    /// Compares the results of the evaluator with evaluate(), condition() and severity() of each property, deletes the batch
+    void check( const Prop_List& batched,
+                const Prop_List& found ) {
+        Prop_List reference = candidates();
+        Prop_List expected;
+        for( Prop_List::iterator it = reference.begin(); it != reference.end(); it++ ) {
+            ( *it )->evaluate();
+            if( ( *it )->condition() ) {
+                expected.push_back( *it );
+            }
+        }
+
+        Prop_List::const_iterator b = batched.begin();
+        for( Prop_List::iterator it = reference.begin(); it != reference.end(); it++, b++ ) {
+            BOOST_CHECK_EQUAL( ( *b )->condition(), ( *it )->condition() );
+            BOOST_CHECK_EQUAL( ( *b )->severity(), ( *it )->severity() );
+            if( rts_support ) {
+                BOOST_CHECK_EQUAL( ( *b )->info(), ( *it )->info() );
+            }
+        }
+
+        BOOST_REQUIRE_EQUAL( found.size(), expected.size() );
+        Prop_List::const_iterator e = expected.begin();
+        for( Prop_List::const_iterator f = found.begin(); f != found.end(); f++, e++ ) {
+            BOOST_CHECK( *( *f )->get_context() == *( *e )->get_context() );
+        }
+        BOOST_CHECK( !expected.empty() && expected.size() < reference.size() );
+
+        for( Prop_List::iterator it = reference.begin(); it != reference.end(); it++ ) {
+            delete *it;
+        }
+        for( Prop_List::const_iterator it = batched.begin(); it != batched.end(); it++ ) {
+            delete *it;
+        }
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( property_batch, Measurements )
+
+BOOST_AUTO_TEST_CASE( batches_match_single_evaluation ) {
+    Prop_List              list = candidates(), found;
+    PropertyBatchEvaluator evaluator( pdb );
+    evaluator.evaluate( list, found );
+
+    BOOST_CHECK_EQUAL( evaluator.batched(), list.size() );
+    // the phase of each rank is looked up once, not once per region
+    BOOST_CHECK_EQUAL( evaluator.lookups(), contexts.size() + ranks );
+    BOOST_CHECK_EQUAL( fake_pdb::lookups(), contexts.size() + ranks );
+    check( list, found );
+}
+
+BOOST_AUTO_TEST_CASE( batches_match_single_evaluation_with_energy ) {
+    rts_support = true;
+    Prop_List              list = candidates(), found;
+    PropertyBatchEvaluator evaluator( pdb );
+    evaluator.evaluate( list, found );
+
+    BOOST_CHECK_EQUAL( evaluator.batched(), list.size() );
+    BOOST_CHECK_EQUAL( evaluator.lookups(), 4 * contexts.size() + ranks );
+    check( list, found );
+}
+
+BOOST_AUTO_TEST_CASE( verify_finds_no_difference ) {
+    setenv( "PSC_BATCH_EVALUATION", "verify", 1 );
+    Prop_List              list = candidates(), found;
+    PropertyBatchEvaluator evaluator( pdb );
+    evaluator.evaluate( list, found );
+
+    BOOST_CHECK_EQUAL( evaluator.batched(), list.size() );
+    BOOST_CHECK_EQUAL( evaluator.mismatches(), 0u );
+    check( list, found );
+}
+
+BOOST_AUTO_TEST_CASE( off_evaluates_one_by_one ) {
+    setenv( "PSC_BATCH_EVALUATION", "off", 1 );
+    Prop_List              list = candidates(), found;
+    PropertyBatchEvaluator evaluator( pdb );
+    evaluator.evaluate( list, found );
+
+    BOOST_CHECK_EQUAL( evaluator.batched(), 0u );
+    BOOST_CHECK_EQUAL( evaluator.lookups(), 0u );
+    BOOST_CHECK_EQUAL( fake_pdb::lookups(), 2 * contexts.size() );
+    check( list, found );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,146 @@
+#define BOOST_TEST_MODULE RegionRegistry
+
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+
+#include "RegionRegistry.h"
+
+// the registry never dereferences regions and call-tree nodes, distinct addresses stand in for them
+static std::vector<char> objects( 64 );
+
+static Region* region( int i ) {
+    return reinterpret_cast<Region*>( &objects[ i ] );
+}
+
+static Rts* rts( int i ) {
+    return reinterpret_cast<Rts*>( &objects[ 32 + i ] );
+}
+
+
+BOOST_AUTO_TEST_CASE( strings_are_dense ) {
+    RegionRegistry registry;
+    BOOST_CHECK_EQUAL( registry.findString( "main.c" ), RegionRegistry::NO_HANDLE );
+
+    RegionRegistry::Handle file = registry.internString( "main.c" );
+    RegionRegistry::Handle name = registry.internString( "solve" );
+    BOOST_CHECK_EQUAL( file, 1u );
+    BOOST_CHECK_EQUAL( name, 2u );
+    BOOST_CHECK_EQUAL( registry.internString( "main.c" ), file );
+    BOOST_CHECK_EQUAL( registry.findString( "solve" ), name );
+    BOOST_CHECK_EQUAL( registry.stringOf( name ), "solve" );
+    BOOST_CHECK_EQUAL( registry.stringOf( RegionRegistry::NO_HANDLE ), "" );
+    BOOST_CHECK_EQUAL( registry.stringOf( 1000 ), "" );
+}
+
+
+BOOST_AUTO_TEST_CASE( regions_by_id_and_descriptor ) {
+    RegionRegistry         registry;
+    RegionRegistry::Handle file = registry.internString( "main.c" );
+    RegionRegistry::Handle name = registry.internString( "solve" );
+
+    RegionRegistry::Handle solve = registry.addRegion( region( 0 ), "main.c*solve*12", name, file, 12 );
+    RegionRegistry::Handle loop  = registry.addRegion( region( 1 ), "main.c*loop*20" );
+    BOOST_CHECK_EQUAL( solve, 1u );
+    BOOST_CHECK_EQUAL( loop, 2u );
+    BOOST_CHECK_EQUAL( registry.regions(), 2u );
+
+    BOOST_CHECK_EQUAL( registry.findRegion( "main.c*solve*12" ), solve );
+    BOOST_CHECK_EQUAL( registry.findRegion( name, file, 12 ), solve );
+    BOOST_CHECK_EQUAL( registry.findRegion( name, file, 13 ), RegionRegistry::NO_HANDLE );
+    BOOST_CHECK_EQUAL( registry.findRegion( region( 1 ) ), loop );
+    BOOST_CHECK_EQUAL( registry.findRegion( "main.c*loop*21" ), RegionRegistry::NO_HANDLE );
+    BOOST_CHECK_EQUAL( registry.region( solve ), region( 0 ) );
+    BOOST_CHECK_EQUAL( registry.regionId( loop ), "main.c*loop*20" );
+    BOOST_CHECK( registry.region( RegionRegistry::NO_HANDLE ) == NULL );
+    BOOST_CHECK( registry.region( 3 ) == NULL );
+
+    // a second region under a known ID or descriptor is not registered
+    BOOST_CHECK_EQUAL( registry.addRegion( region( 2 ), "main.c*loop*20" ), loop );
+    BOOST_CHECK_EQUAL( registry.addRegion( region( 3 ), "other", name, file, 12 ), solve );
+    BOOST_CHECK_EQUAL( registry.findRegion( region( 2 ) ), RegionRegistry::NO_HANDLE );
+    BOOST_CHECK_EQUAL( registry.regions(), 2u );
+}
+
+
+BOOST_AUTO_TEST_CASE( regions_by_id_order_and_first_line ) {
+    RegionRegistry         registry;
+    RegionRegistry::Handle file  = registry.internString( "main.c" );
+    RegionRegistry::Handle other = registry.internString( "other.c" );
+
+    // registered out of order; the loop and the parallel region start on the same line
+    RegionRegistry::Handle parallel = registry.addRegion( region( 0 ), "main.c*parallel*20", registry.internString( "parallel" ), file, 20 );
+    RegionRegistry::Handle solve    = registry.addRegion( region( 1 ), "main.c*solve*12", registry.internString( "solve" ), file, 12 );
+    RegionRegistry::Handle loop     = registry.addRegion( region( 2 ), "main.c*loop*20", RegionRegistry::NO_HANDLE, file, 20 );
+    RegionRegistry::Handle helper   = registry.addRegion( region( 3 ), "helper" );
+    registry.addRegion( region( 4 ), "main.c*loop*20", RegionRegistry::NO_HANDLE, other, 20 );
+
+    std::vector<RegionRegistry::Handle> order;
+    std::vector<std::string>            ids;
+    for( RegionRegistry::RegionOrder::const_iterator it = registry.regionsById().begin(); it != registry.regionsById().end(); ++it ) {
+        order.push_back( it->second );
+        ids.push_back( *it->first );
+    }
+    std::vector<RegionRegistry::Handle> expected = { helper, loop, parallel, solve };
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), expected.begin(), expected.end() );
+    for( size_t i = 0; i < order.size(); i++ ) {
+        BOOST_CHECK_EQUAL( ids[ i ], registry.regionId( order[ i ] ) );
+    }
+
+    // of the regions starting on a line, the one with the lowest region ID
+    BOOST_CHECK_EQUAL( registry.findRegionAt( file, 20 ), loop );
+    BOOST_CHECK_EQUAL( registry.findRegionAt( file, 12 ), solve );
+    BOOST_CHECK_EQUAL( registry.findRegionAt( file, 13 ), RegionRegistry::NO_HANDLE );
+    // a region known under its ID is not indexed again under another file
+    BOOST_CHECK_EQUAL( registry.findRegionAt( other, 20 ), RegionRegistry::NO_HANDLE );
+    BOOST_CHECK_EQUAL( registry.findRegionAt( RegionRegistry::NO_HANDLE, 0 ), RegionRegistry::NO_HANDLE );
+}
+
+
+BOOST_AUTO_TEST_CASE( handles_survive_reinitialization ) {
+    RegionRegistry                      registry;
+    std::vector<RegionRegistry::Handle> handles;
+    for( int i = 0; i < 8; i++ ) {
+        std::string            id   = "file*region" + std::to_string( i ) + "*1";
+        RegionRegistry::Handle name = registry.internString( "region" + std::to_string( i ) );
+        handles.push_back( registry.addRegion( region( i ), id, name, registry.internString( "file" ), 1 ) );
+    }
+    RegionRegistry::Handle path = registry.bindCallpath( "/main/region3", rts( 0 ) );
+
+    // the processes announce their regions again, in another order, and the call-tree is rebuilt
+    for( int i = 7; i >= 0; i-- ) {
+        std::string            id   = "file*region" + std::to_string( i ) + "*1";
+        RegionRegistry::Handle name = registry.internString( "region" + std::to_string( i ) );
+        BOOST_CHECK_EQUAL( registry.addRegion( region( 8 + i ), id, name, registry.internString( "file" ), 1 ), handles[ i ] );
+        BOOST_CHECK_EQUAL( registry.region( handles[ i ] ), region( i ) );
+    }
+    BOOST_CHECK_EQUAL( registry.bindCallpath( "/main/region3", rts( 1 ) ), path );
+    BOOST_CHECK_EQUAL( registry.rts( path ), rts( 1 ) );
+    BOOST_CHECK_EQUAL( registry.callpathOf( rts( 0 ) ), RegionRegistry::NO_HANDLE );
+    BOOST_CHECK_EQUAL( registry.regions(), 8u );
+}
+
+
+BOOST_AUTO_TEST_CASE( callpaths ) {
+    RegionRegistry registry;
+    BOOST_CHECK_EQUAL( registry.findCallpath( "/main" ), RegionRegistry::NO_HANDLE );
+
+    RegionRegistry::Handle main  = registry.bindCallpath( "/main", rts( 0 ) );
+    RegionRegistry::Handle solve = registry.internCallpath( "/main/solve" );
+    BOOST_CHECK_EQUAL( registry.callpaths(), 2u );
+    BOOST_CHECK_EQUAL( registry.findCallpath( "/main/solve" ), solve );
+    BOOST_CHECK_EQUAL( registry.callpath( main ), "/main" );
+    BOOST_CHECK_EQUAL( registry.rts( main ), rts( 0 ) );
+    BOOST_CHECK( registry.rts( solve ) == NULL );
+    BOOST_CHECK_EQUAL( registry.callpathOf( rts( 0 ) ), main );
+
+    // the text of a call-path is interned with the other strings
+    BOOST_CHECK_NE( registry.findString( "/main" ), RegionRegistry::NO_HANDLE );
+    BOOST_CHECK_EQUAL( registry.internCallpath( "/main" ), main );
+
+    // a node whose call-path changes, as in clustering, moves to the new one
+    RegionRegistry::Handle cluster = registry.bindCallpath( "/main/Cluster=1", rts( 0 ) );
+    BOOST_CHECK( registry.rts( main ) == NULL );
+    BOOST_CHECK_EQUAL( registry.rts( cluster ), rts( 0 ) );
+    BOOST_CHECK_EQUAL( registry.callpathOf( rts( 0 ) ), cluster );
+}
@@ -0,0 +1,171 @@
+/* Lookup cost of the region registry against the ordered maps it replaces.
+ *
+ * Registers the given number of Score-P regions and one call-path per region, then looks every
+ * one of them up in random order: by region ID, by Score-P descriptor, by region key, from the
+ * region back to its ID and between call-paths and call-tree nodes. The maps are keyed the way
+ * Application kept them before the registry (region ID, hashed region key, call-tree node).
+ *
+ * Usage: region_registry_bench [regions] [rounds]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "RegionRegistry.h"
+
+struct Descr {
+    std::string file;
+    std::string name;
+    int         rfl;
+    std::string id;
+    std::string callpath;
+};
+
+static volatile uintptr_t sink;
+
+// the registry never dereferences regions and call-tree nodes, distinct addresses stand in for them
+static std::vector<char> objects;
+
+static Region* region( int i ) {
+    return reinterpret_cast<Region*>( &objects[ 2 * i ] );
+}
+
+static Rts* rts( int i ) {
+    return reinterpret_cast<Rts*>( &objects[ 2 * i + 1 ] );
+}
+
+template<typename Lookup>
+static double ns_per_lookup( const std::vector<int>& order,
+                             int                     rounds,
+                             Lookup                  lookup ) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    uintptr_t                             sum   = 0;
+    for( int r = 0; r < rounds; r++ ) {
+        for( size_t i = 0; i < order.size(); i++ ) {
+            sum += lookup( order[ i ] );
+        }
+    }
+    sink = sum;
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ( ( double )order.size() * rounds );
+}
+
+int main( int argc, char** argv ) {
+    int regions = argc > 1 ? atoi( argv[ 1 ] ) : 100000;
+    int rounds  = argc > 2 ? atoi( argv[ 2 ] ) : 5;
+
+    std::vector<Descr> descr( regions );
+    for( int i = 0; i < regions; i++ ) {
+        descr[ i ].file     = "src/module" + std::to_string( i % 500 ) + ".f90";
+        descr[ i ].name     = "kernel_" + std::to_string( i );
+        descr[ i ].rfl      = 10 + i % 2000;
+        descr[ i ].id       = descr[ i ].file + "*" + descr[ i ].name + "*" + std::to_string( descr[ i ].rfl );
+        descr[ i ].callpath = "/main/solver/" + descr[ i ].name;
+    }
+    objects.resize( 2 * regions );
+
+    std::vector<int> order( regions );
+    for( int i = 0; i < regions; i++ ) {
+        order[ i ] = i;
+    }
+    std::shuffle( order.begin(), order.end(), std::mt19937( 1 ) );
+
+    // the maps of Application before the registry
+    std::map<std::string, Region*> code_regions;
+    std::map<std::string, int>     ids_by_string;
+    std::map<uint64_t, Region*>    region_by_regionKey;
+    std::map<Rts*, std::string>    rtscallpath_mapping;
+    std::vector<uint64_t>          keys( regions );
+    int                            last_string_id = 1;
+    for( int i = 0; i < regions; i++ ) {
+        const Descr& d = descr[ i ];
+        if( !ids_by_string.count( d.file ) ) {
+            ids_by_string[ d.file ] = last_string_id += 2;
+        }
+        ids_by_string[ d.name ] = last_string_id += 2;
+        keys[ i ]               = ( uint64_t )ids_by_string[ d.file ] * 10000000 + ( uint64_t )ids_by_string[ d.name ] * 10000 + d.rfl;
+        code_regions[ d.id ]             = region( i );
+        region_by_regionKey[ keys[ i ] ] = region( i );
+        rtscallpath_mapping[ rts( i ) ]  = d.callpath;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    RegionRegistry                        registry;
+    std::vector<RegionRegistry::Handle>   handles( regions );
+    for( int i = 0; i < regions; i++ ) {
+        const Descr&           d    = descr[ i ];
+        RegionRegistry::Handle file = registry.internString( d.file );
+        RegionRegistry::Handle name = registry.internString( d.name );
+        handles[ i ] = registry.addRegion( region( i ), d.id, name, file, d.rfl );
+        registry.bindCallpath( d.callpath, rts( i ) );
+    }
+    double registration = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+
+    printf( "%d regions, %d rounds of lookups in random order, registration %.1f ms\n", regions, rounds, registration );
+    printf( "%-28s %12s %12s\n", "lookup [ns]", "std::map", "registry" );
+
+    printf( "%-28s %12.1f %12.1f\n", "region by ID",
+            ns_per_lookup( order, rounds, [ & ]( int i ) {
+                return ( uintptr_t )code_regions.find( descr[ i ].id )->second;
+            } ),
+            ns_per_lookup( order, rounds, [ & ]( int i ) {
+                return ( uintptr_t )registry.region( registry.findRegion( descr[ i ].id ) );
+            } ) );
+
+    printf( "%-28s %12.1f %12.1f\n", "region by descriptor",
+            ns_per_lookup( order, rounds, [ & ]( int i ) {
+                const Descr& d   = descr[ i ];
+                uint64_t     key = ( uint64_t )ids_by_string.find( d.file )->second * 10000000
+                                   + ( uint64_t )ids_by_string.find( d.name )->second * 10000 + d.rfl;
+                return ( uintptr_t )region_by_regionKey.find( key )->second;
+            } ),
+            ns_per_lookup( order, rounds, [ & ]( int i ) {
+                const Descr& d = descr[ i ];
+                return ( uintptr_t )registry.region( registry.findRegion( registry.findString( d.name ),
+                                                                          registry.findString( d.file ), d.rfl ) );
+            } ) );
+
+    printf( "%-28s %12.1f %12.1f\n", "region by key",
+            ns_per_lookup( order, rounds, [ & ]( int i ) {
+                return ( uintptr_t )region_by_regionKey.find( keys[ i ] )->second;
+            } ),
+            ns_per_lookup( order, rounds, [ & ]( int i ) {
+                return ( uintptr_t )registry.region( handles[ i ] );
+            } ) );
+
+    // the map has no reverse direction, the registry goes from the object to its interned ID
+    printf( "%-28s %12s %12.1f\n", "region ID of a region", "-",
+            ns_per_lookup( order, rounds, [ & ]( int i ) {
+                return ( uintptr_t )registry.regionId( registry.findRegion( region( i ) ) ).size();
+            } ) );
+
+    printf( "%-28s %12.1f %12.1f\n", "call-path of a node",
+            ns_per_lookup( order, rounds, [ & ]( int i ) {
+                return ( uintptr_t )rtscallpath_mapping.find( rts( i ) )->second.size();
+            } ),
+            ns_per_lookup( order, rounds, [ & ]( int i ) {
+                return ( uintptr_t )registry.callpath( registry.callpathOf( rts( i ) ) ).size();
+            } ) );
+
+    // without the registry this is a walk of the call-tree, or of the whole map
+    printf( "%-28s %12s %12.1f\n", "node of a call-path", "-",
+            ns_per_lookup( order, rounds, [ & ]( int i ) {
+                return ( uintptr_t )registry.rts( registry.findCallpath( descr[ i ].callpath ) );
+            } ) );
+
+    for( int i = 0; i < regions; i++ ) {
+        if( registry.region( registry.findRegion( descr[ i ].id ) ) != region( i )
+            || registry.rts( registry.findCallpath( descr[ i ].callpath ) ) != rts( i ) ) {
+            fprintf( stderr, "lookup of region %d failed\n", i );
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,38 @@
+/**
+   @file    FakeDataProvider.cc
+   @ingroup AnalysisAgent
+   @brief   Data provider without processes, for tests of the performance database
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "DataProvider.h"
+
+/*
+ * Defines the members of DataProvider the performance database uses, in place of
+ * aagent/src/DataProvider.cc: the provider controls no processes and stays in iteration 0.
+ */
+
+DataProvider::DataProvider( Application*     appl,
+                            std::string      phase_name_,
+                            RegistryService* registry ) :
+    registry_( registry ), appl_( appl ), phase_name( phase_name_ ) {
+    current_iteration = 0;
+}
+
+int DataProvider::getCurrentIterationNumber() {
+    return current_iteration;
+}
+
+void DataProvider::addMeasurementRequest( Context* ct,
+                                          Metric   m ) {
+}
@@ -0,0 +1,72 @@
+/**
+   @file    FakePerformanceDataBase.cc
+   @ingroup AnalysisAgent
+   @brief   In-memory stand-in for the performance database of the analysis agent
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "FakePerformanceDataBase.h"
+
+#include <map>
+#include <tuple>
+
+namespace {
+typedef std::tuple<const void*, int, int, Metric> FakeKey;
+
+std::map<FakeKey, INT64> values;
+size_t                   lookupCount = 0;
+
+FakeKey key_of( Context* ct,
+                Metric   m ) {
+    const void* location = ct->isRtsBased() ? ( const void* )ct->getRts() : ( const void* )ct->getRegion();
+    return FakeKey( location, ct->getRank(), ct->getThread(), m );
+}
+}
+
+size_t fake_pdb::lookups() {
+    return lookupCount;
+}
+
+void fake_pdb::reset() {
+    values.clear();
+    lookupCount = 0;
+}
+
+PerformanceDataBase::PerformanceDataBase( DataProvider* provider ) : provider( provider ) {
+}
+
+PerformanceDataBase::~PerformanceDataBase() {
+}
+
+void PerformanceDataBase::store( Context* ct,
+                                 Metric   m,
+                                 INT64    value ) {
+    values[ key_of( ct, m ) ] = value;
+}
+
+INT64 PerformanceDataBase::get( Context* ct,
+                                Metric   m ) {
+    lookupCount++;
+    std::map<FakeKey, INT64>::const_iterator it = values.find( key_of( ct, m ) );
+    return it == values.end() ? 0 : it->second;
+}
+
+INT64 PerformanceDataBase::try_get( Context* ct,
+                                    Metric   m ) {
+    return get( ct, m );
+}
+
+int PerformanceDataBase::request( Context* ct,
+                                  Metric   m ) {
+    return 0;
+}
@@ -0,0 +1,38 @@
+/**
+   @file    FakePerformanceDataBase.h
+   @ingroup AnalysisAgent
+   @brief   In-memory stand-in for the performance database of the analysis agent
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef FAKE_PERFORMANCE_DATA_BASE_H_
+#define FAKE_PERFORMANCE_DATA_BASE_H_
+
+#include "global.h"
+
+#include <stddef.h>
+
+/**
+ * FakePerformanceDataBase.cc defines the members of PerformanceDataBase used by properties, in
+ * place of aagent/src/PerformanceDataBase.cc: store() keeps one value per region or call-tree node,
+ * rank, thread and metric, get() returns it, or 0 for values never stored, without a data provider.
+ */
+namespace fake_pdb {
+/// Calls of get() and try_get() since the last reset()
+size_t lookups();
+
+/// Forgets the stored values and the lookups
+void reset();
+}
+
+#endif /* FAKE_PERFORMANCE_DATA_BASE_H_ */
@@ -0,0 +1,563 @@
+/**
+   @file    FakeScorepOA.cc
+   @ingroup AnalysisAgent
+   @brief   Fake Score-P online-access endpoint for replaying profiles to the analysis agent
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "FakeScorepOA.h"
+#include "psc_errmsg.h"
+#include "sockets.h"
+#include "timing.h"
+
+#include <errno.h>
+#include <math.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+static const char* mpi_functions[] = { "MPI_Send", "MPI_Recv", "MPI_Allreduce", "MPI_Wait", "MPI_Bcast", "MPI_Barrier" };
+
+
+// splitmix64, so every value only depends on the seed and its coordinates
+static uint64_t mix( uint64_t value ) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value  = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    value  = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebULL;
+    return value ^ ( value >> 31 );
+}
+
+
+static double uniform( unsigned seed,
+                       int      rank,
+                       int      thread,
+                       int      region,
+                       int      metric ) {
+    uint64_t key = mix( seed );
+    key = mix( key ^ ( uint64_t )rank );
+    key = mix( key ^ ( uint64_t )thread );
+    key = mix( key ^ ( uint64_t )region );
+    key = mix( key ^ ( uint64_t )metric );
+    return ( key >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
+
+
+std::string fake_oa_requested_metric( const std::string& line ) {
+    // REQUEST[0] GLOBAL METRIC PAPI "PAPI_TOT_CYC";  REQUEST[0] GLOBAL METRIC PLUGIN "p" "name";
+    size_t close = line.rfind( '"' );
+    if( close != std::string::npos && close > 0 ) {
+        size_t open = line.rfind( '"', close - 1 );
+        if( open != std::string::npos ) {
+            return line.substr( open + 1, close - open - 1 );
+        }
+    }
+
+    // REQUEST[0] GLOBAL execution_time;  request[0] global MPI;
+    std::istringstream tokens( line );
+    std::string        token;
+    while( tokens >> token ) {
+        if( strcasecmp( token.c_str(), "global" ) == 0 && tokens >> token ) {
+            token.erase( std::remove( token.begin(), token.end(), ';' ), token.end() );
+            // Score-P answers MPI requests with its late-send metric
+            return token == "MPI" ? "late_send" : token;
+        }
+    }
+    return "";
+}
+
+
+FakeScorepOA::FakeScorepOA( const FakeOAConfig& config ) : config_( config ) {
+    config_.processes = std::max( config_.processes, 1 );
+    config_.threads   = std::max( config_.threads, 1 );
+    config_.regions   = std::max( config_.regions, 1 );
+    for( int r = 0; r < config_.processes; r++ ) {
+        Rank rank;
+        rank.rank       = r;
+        rank.listener   = -1;
+        rank.sock       = -1;
+        rank.port       = -1;
+        rank.iterations = 1;
+        rank.terminated = false;
+        rank.suspendAt  = 0;
+        rank.simulated  = 0;
+        rank.served     = 0;
+        ranks_.push_back( rank );
+    }
+}
+
+
+FakeScorepOA::~FakeScorepOA() {
+    for( size_t r = 0; r < ranks_.size(); r++ ) {
+        if( ranks_[ r ].sock >= 0 ) {
+            close( ranks_[ r ].sock );
+        }
+        if( ranks_[ r ].listener >= 0 ) {
+            close( ranks_[ r ].listener );
+        }
+    }
+}
+
+
+bool FakeScorepOA::listen( int basePort ) {
+    int next = basePort;
+    for( size_t r = 0; r < ranks_.size(); r++ ) {
+        int port = next;
+        int sock = socket_server_startup_retry( &port, 1000, 1 );
+        if( sock < 0 ) {
+            psc_errmsg( "Cannot open a port for rank %d from %d on\n", ( int )r, next );
+            return false;
+        }
+        ranks_[ r ].listener = sock;
+        ranks_[ r ].port     = port;
+        next                 = port + 1;
+    }
+    return true;
+}
+
+
+int FakeScorepOA::port( int rank ) const {
+    return rank >= 0 && rank < ( int )ranks_.size() ? ranks_[ rank ].port : -1;
+}
+
+
+bool FakeScorepOA::loadReplay() {
+    recorded_.clear();
+    for( int r = 0;; r++ ) {
+        std::stringstream file;
+        file << config_.replay << "." << r;
+        std::ifstream in( file.str().c_str(), std::ios::binary );
+        if( !in ) {
+            break;
+        }
+
+        std::vector< FakeOASummary > summaries;
+        FakeOASummary                current;
+        std::string                  header;
+        while( std::getline( in, header ) ) {
+            int count = 0;
+            in.read( ( char* )&count, sizeof( count ) );
+            if( !in || count < 0 ) {
+                psc_errmsg( "Truncated record %s in %s\n", header.c_str(), file.str().c_str() );
+                return false;
+            }
+            bool known = true;
+            if( header == "MERGED_REGION_DEFINITIONS" ) {
+                current.regions.resize( count );
+                in.read( ( char* )current.regions.data(), count * sizeof( SCOREP_OA_CallPathRegionDef ) );
+            }
+            else if( header == "FLAT_PROFILE" ) {
+                current.flat.resize( count );
+                in.read( ( char* )current.flat.data(), count * sizeof( SCOREP_OA_FlatProfileMeasurement ) );
+            }
+            else if( header == "METRIC_DEFINITIONS" ) {
+                current.counters.resize( count );
+                in.read( ( char* )current.counters.data(), count * sizeof( SCOREP_OA_CallPathCounterDef ) );
+            }
+            else if( header == "CALLTREE_DEFINITIONS" ) {
+                current.calltree.resize( count );
+                in.read( ( char* )current.calltree.data(), count * sizeof( SCOREP_OA_CallTreeDef ) );
+            }
+            else if( header == "RTS_MEASUREMENTS" ) {
+                current.rts.resize( count );
+                in.read( ( char* )current.rts.data(), count * sizeof( SCOREP_OA_RtsMeasurement ) );
+                // the last buffer of a summary
+                summaries.push_back( current );
+                current = FakeOASummary();
+            }
+            else {
+                known = false;
+            }
+            if( !known || !in ) {
+                psc_errmsg( "Unreadable record %s in %s\n", header.c_str(), file.str().c_str() );
+                return false;
+            }
+        }
+        if( summaries.empty() ) {
+            break;
+        }
+        recorded_.push_back( summaries );
+    }
+
+    if( recorded_.empty() ) {
+        psc_errmsg( "No recorded summaries found at %s.0\n", config_.replay.c_str() );
+        return false;
+    }
+    psc_dbgmsg( 1, "Replaying %d recorded rank(s) for %d simulated rank(s)\n", ( int )recorded_.size(),
+                ( int )ranks_.size() );
+    return true;
+}
+
+
+FakeOASummary FakeScorepOA::synthesize( int                               rank,
+                                        int                               iterations,
+                                        const std::vector< std::string >& metrics ) const {
+    FakeOASummary summary;
+
+    for( int r = 0; r < config_.regions; r++ ) {
+        SCOREP_OA_CallPathRegionDef region;
+        memset( &region, 0, sizeof( region ) );
+        region.region_id = r + 1;
+        region.rfl       = 10 * ( r + 1 );
+        region.rel       = region.rfl + 5;
+        strncpy( region.file, "synthetic.c", MAX_FILE_NAME_LENGTH - 1 );
+        if( r == 0 ) {
+            strncpy( region.name, config_.phase.c_str(), MAX_REGION_NAME_LENGTH - 1 );
+            region.adapter_type = SCOREP_ADAPTER_USER;
+        }
+        else {
+            switch( r % 4 ) {
+            case 0:
+                strncpy( region.name, mpi_functions[ ( r / 4 ) % 6 ], MAX_REGION_NAME_LENGTH - 1 );
+                region.adapter_type = SCOREP_ADAPTER_MPI;
+                break;
+            case 2:
+                snprintf( region.name, MAX_REGION_NAME_LENGTH, "!$omp parallel @synthetic.c:%d", region.rfl );
+                region.adapter_type = SCOREP_ADAPTER_POMP;
+                break;
+            default:
+                snprintf( region.name, MAX_REGION_NAME_LENGTH, "function_%d", r );
+                region.adapter_type = SCOREP_ADAPTER_COMPILER;
+                break;
+            }
+        }
+        summary.regions.push_back( region );
+
+        SCOREP_OA_CallTreeDef node;
+        memset( &node, 0, sizeof( node ) );
+        node.region_id        = region.region_id;
+        node.scorep_id        = r + 1;
+        node.parent_scorep_id = r == 0 ? 0 : 1;
+        strncpy( node.name, region.name, MAX_REGION_NAME_LENGTH - 1 );
+        summary.calltree.push_back( node );
+    }
+
+    for( size_t m = 0; m < metrics.size(); m++ ) {
+        SCOREP_OA_CallPathCounterDef counter;
+        memset( &counter, 0, sizeof( counter ) );
+        strncpy( counter.name, metrics[ m ].c_str(), MAX_COUNTER_NAME_LENGTH - 1 );
+        strncpy( counter.unit, metrics[ m ] == "execution_time" ? "ns" : "#", MAX_COUNTER_UNIT_LENGTH - 1 );
+        summary.counters.push_back( counter );
+    }
+
+    // the phase takes the configured time with some imbalance between the ranks, the other regions
+    // split about half of it; counters scale with the time of their region
+    double phase = 1000.0 * config_.phaseTime * iterations * ( 1.0 + 0.05 * ( rank % 4 ) );
+    for( int t = 0; t < config_.threads; t++ ) {
+        for( int r = 0; r < config_.regions; r++ ) {
+            double   share   = r == 0 ? 1.0 : ( 0.5 + uniform( config_.seed, rank, t, r, -1 ) ) / config_.regions;
+            uint64_t samples = r == 0 ? iterations : iterations * ( 1 + ( mix( config_.seed + r ) % 16 ) );
+            for( size_t m = 0; m < metrics.size(); m++ ) {
+                double scale = metrics[ m ] == "execution_time" ? 1.0 : 0.5 + 2 * uniform( config_.seed, rank, t, r, m );
+
+                SCOREP_OA_FlatProfileMeasurement measurement;
+                memset( &measurement, 0, sizeof( measurement ) );
+                measurement.measurement_id = summary.flat.size();
+                measurement.rank           = rank;
+                measurement.thread         = t;
+                measurement.region_id      = r;
+                measurement.samples        = samples;
+                measurement.metric_id      = m;
+                measurement.int_val        = ( uint64_t )( phase * share * scale );
+                summary.flat.push_back( measurement );
+
+                SCOREP_OA_RtsMeasurement rts;
+                memset( &rts, 0, sizeof( rts ) );
+                rts.rank      = rank;
+                rts.thread    = t;
+                rts.count     = samples;
+                rts.metric_id = m;
+                rts.int_val   = measurement.int_val;
+                rts.scorep_id = r + 1;
+                summary.rts.push_back( rts );
+            }
+        }
+    }
+    return summary;
+}
+
+
+FakeOASummary FakeScorepOA::replayed( int                               rank,
+                                      long                              served,
+                                      const std::vector< std::string >& metrics ) const {
+    const std::vector< FakeOASummary >& summaries = recorded_[ rank % recorded_.size() ];
+    const FakeOASummary&                recorded  = summaries[ served % summaries.size() ];
+    FakeOASummary                       summary;
+    summary.regions  = recorded.regions;
+    summary.calltree = recorded.calltree;
+
+    // keep the requested counters; a recording without any of them is replayed as it is
+    std::map< uint32_t, uint32_t > kept;
+    for( size_t c = 0; c < recorded.counters.size(); c++ ) {
+        if( std::find( metrics.begin(), metrics.end(), recorded.counters[ c ].name ) != metrics.end() ) {
+            kept[ c ] = summary.counters.size();
+            summary.counters.push_back( recorded.counters[ c ] );
+        }
+    }
+    if( kept.empty() ) {
+        summary.counters = recorded.counters;
+        for( size_t c = 0; c < recorded.counters.size(); c++ ) {
+            kept[ c ] = c;
+        }
+    }
+
+    for( size_t i = 0; i < recorded.flat.size(); i++ ) {
+        std::map< uint32_t, uint32_t >::const_iterator counter = kept.find( recorded.flat[ i ].metric_id );
+        if( counter != kept.end() ) {
+            SCOREP_OA_FlatProfileMeasurement measurement = recorded.flat[ i ];
+            measurement.rank      = rank;
+            measurement.metric_id = counter->second;
+            summary.flat.push_back( measurement );
+        }
+    }
+    for( size_t i = 0; i < recorded.rts.size(); i++ ) {
+        std::map< uint32_t, uint32_t >::const_iterator counter = kept.find( recorded.rts[ i ].metric_id );
+        if( counter != kept.end() ) {
+            SCOREP_OA_RtsMeasurement rts = recorded.rts[ i ];
+            rts.rank      = rank;
+            rts.metric_id = counter->second;
+            summary.rts.push_back( rts );
+        }
+    }
+    return summary;
+}
+
+
+FakeOASummary FakeScorepOA::summary( int                               rank,
+                                     const std::vector< std::string >& requested ) {
+    std::vector< std::string > metrics = requested;
+    if( config_.metrics > 0 && ( int )metrics.size() > config_.metrics ) {
+        // like a limited number of hardware counters; the agent asks again for the rest
+        metrics.resize( config_.metrics );
+    }
+
+    const Rank& state = ranks_[ rank ];
+    if( !recorded_.empty() ) {
+        return replayed( rank, state.served, metrics );
+    }
+    if( metrics.empty() ) {
+        // Score-P never sends empty buffers, time is always measured
+        metrics.push_back( "execution_time" );
+    }
+    return synthesize( rank, state.iterations, metrics );
+}
+
+
+void FakeScorepOA::reply( Rank&       rank,
+                          const void* data,
+                          size_t      size ) {
+    const char* ptr = ( const char* )data;
+    while( size > 0 ) {
+        ssize_t written = write( rank.sock, ptr, size );
+        if( written < 0 && errno == EINTR ) {
+            continue;
+        }
+        if( written <= 0 ) {
+            psc_errmsg( "Rank %d: lost the connection to the agent\n", rank.rank );
+            return;
+        }
+        ptr          += written;
+        size         -= written;
+        stats_.bytes += written;
+    }
+}
+
+
+void FakeScorepOA::replyLine( Rank&              rank,
+                              const std::string& line ) {
+    std::string terminated = line + "\n";
+    reply( rank, terminated.c_str(), terminated.size() );
+}
+
+
+template< typename T >
+void FakeScorepOA::replyBuffer( Rank&                   rank,
+                                const char*             header,
+                                const std::vector< T >& buffer ) {
+    int count = buffer.size();
+    replyLine( rank, header );
+    reply( rank, &count, sizeof( count ) );
+    reply( rank, buffer.data(), count * sizeof( T ) );
+}
+
+
+void FakeScorepOA::handle( Rank&              rank,
+                           const std::string& line ) {
+    std::string command;
+    for( size_t c = 0; c < line.size() && ( isalpha( line[ c ] ) || line[ c ] == '_' ); c++ ) {
+        command += tolower( line[ c ] );
+    }
+    stats_.commands++;
+    psc_dbgmsg( 7, "Rank %d received <%s>\n", rank.rank, line.c_str() );
+
+    if( command == "getmpirank" ) {
+        replyLine( rank, "MPIRANK" );
+        reply( rank, &rank.rank, sizeof( rank.rank ) );
+    }
+    else if( command == "setnumiterations" ) {
+        rank.iterations = std::max( atoi( line.c_str() + command.size() ), 1 );
+    }
+    else if( command == "beginrequests" ) {
+        rank.requested.clear();
+        replyLine( rank, "OK" );
+    }
+    else if( command == "request" ) {
+        std::string metric = fake_oa_requested_metric( line );
+        if( !metric.empty() && std::find( rank.requested.begin(), rank.requested.end(), metric ) == rank.requested.end() ) {
+            rank.requested.push_back( metric );
+        }
+        replyLine( rank, "OK" );
+    }
+    else if( command == "endrequests" || command == "tuningaction" || command == "rtstuningrequests" ) {
+        replyLine( rank, "OK" );
+    }
+    else if( command == "runtostart" ) {
+        rank.suspendAt = psc_wall_time();
+    }
+    else if( command == "runtoend" ) {
+        double phase = 1e-6 * config_.phaseTime * rank.iterations;
+        rank.suspendAt  = psc_wall_time() + phase;
+        rank.simulated += phase;
+        stats_.simulated = std::max( stats_.simulated, rank.simulated );
+        if( rank.rank == 0 ) {
+            stats_.experiments++;
+        }
+    }
+    else if( command == "getsummarydata" ) {
+        FakeOASummary data = summary( rank.rank, rank.requested );
+        replyBuffer( rank, "MERGED_REGION_DEFINITIONS", data.regions );
+        replyBuffer( rank, "FLAT_PROFILE", data.flat );
+        replyBuffer( rank, "METRIC_DEFINITIONS", data.counters );
+        replyBuffer( rank, "CALLTREE_DEFINITIONS", data.calltree );
+        replyBuffer( rank, "RTS_MEASUREMENTS", data.rts );
+        rank.served++;
+        stats_.summaries++;
+        stats_.measurements += data.flat.size();
+    }
+    else if( command == "terminate" ) {
+        close( rank.sock );
+        rank.sock       = -1;
+        rank.terminated = true;
+        stats_.finished = psc_wall_time();
+    }
+    else {
+        psc_errmsg( "Rank %d: ignoring unknown command <%s>\n", rank.rank, line.c_str() );
+    }
+}
+
+
+bool FakeScorepOA::serve( int timeout ) {
+    std::vector< struct pollfd > fds;
+    std::vector< size_t >        owners;
+    double                       now  = psc_wall_time();
+    bool                         open = false;
+
+    for( size_t r = 0; r < ranks_.size(); r++ ) {
+        Rank& rank = ranks_[ r ];
+        if( rank.terminated ) {
+            continue;
+        }
+        open = true;
+        struct pollfd fd;
+        fd.fd     = rank.sock >= 0 ? rank.sock : rank.listener;
+        fd.events = POLLIN;
+        fds.push_back( fd );
+        owners.push_back( r );
+        if( rank.suspendAt > 0 ) {
+            // round up, waking early would only spin until the deadline
+            timeout = std::min( timeout, std::max( 0, ( int )ceil( 1000 * ( rank.suspendAt - now ) ) ) );
+        }
+    }
+    if( !open ) {
+        return false;
+    }
+
+    if( poll( fds.data(), fds.size(), timeout ) < 0 && errno != EINTR ) {
+        psc_errmsg( "poll() failed: %s\n", strerror( errno ) );
+        return false;
+    }
+
+    for( size_t i = 0; i < fds.size(); i++ ) {
+        Rank& rank = ranks_[ owners[ i ] ];
+        if( !( fds[ i ].revents & ( POLLIN | POLLHUP | POLLERR ) ) ) {
+            continue;
+        }
+
+        if( rank.sock < 0 ) {
+            rank.sock = socket_server_accept_client( rank.listener );
+            if( rank.sock >= 0 && stats_.connected == 0 ) {
+                stats_.connected = psc_wall_time();
+            }
+            psc_dbgmsg( 3, "Rank %d: agent connected on port %d\n", rank.rank, rank.port );
+            continue;
+        }
+
+        char    buffer[ 4096 ];
+        ssize_t length = read( rank.sock, buffer, sizeof( buffer ) );
+        if( length <= 0 ) {
+            if( length < 0 && errno == EINTR ) {
+                continue;
+            }
+            psc_errmsg( "Rank %d: agent closed the connection\n", rank.rank );
+            close( rank.sock );
+            rank.sock       = -1;
+            rank.terminated = true;
+            stats_.finished = psc_wall_time();
+            continue;
+        }
+        rank.input.append( buffer, length );
+
+        size_t end;
+        while( !rank.terminated && ( end = rank.input.find( '\n' ) ) != std::string::npos ) {
+            std::string line = rank.input.substr( 0, end );
+            rank.input.erase( 0, end + 1 );
+            if( !line.empty() && line[ line.size() - 1 ] == '\r' ) {
+                line.erase( line.size() - 1 );
+            }
+            if( !line.empty() ) {
+                handle( rank, line );
+            }
+        }
+    }
+
+    now = psc_wall_time();
+    for( size_t r = 0; r < ranks_.size(); r++ ) {
+        Rank& rank = ranks_[ r ];
+        if( rank.suspendAt > 0 && rank.suspendAt <= now && rank.sock >= 0 ) {
+            rank.suspendAt = 0;
+            replyLine( rank, "SUSPENDED" );
+        }
+    }
+    return true;
+}
+
+
+void FakeScorepOA::report( std::ostream& out ) const {
+    double wall     = stats_.finished > stats_.connected ? stats_.finished - stats_.connected : 0;
+    double analysis = std::max( wall - stats_.simulated, 1e-9 );
+    out << "Ranks: " << ranks_.size() << "  Threads: " << config_.threads << "  Regions: " << config_.regions
+        << "  Source: " << ( recorded_.empty() ? "synthetic" : config_.replay ) << "\n";
+    out << "Experiments: " << stats_.experiments << "  Commands: " << stats_.commands
+        << "  Summaries: " << stats_.summaries << "\n";
+    out << "Measurements sent: " << stats_.measurements << "  Bytes sent: " << stats_.bytes << "\n";
+    out << "Wall time: " << wall << " s  Simulated phases: " << stats_.simulated
+        << " s  Agent time: " << wall - stats_.simulated << " s\n";
+    out << "Throughput: " << stats_.measurements / analysis << " measurements/s  "
+        << stats_.bytes / analysis / 1048576.0 << " MiB/s\n";
+}
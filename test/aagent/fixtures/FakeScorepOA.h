@@ -0,0 +1,162 @@
+/**
+   @file    FakeScorepOA.h
+   @ingroup AnalysisAgent
+   @brief   Fake Score-P online-access endpoint for replaying profiles to the analysis agent
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef FAKE_SCOREP_OA_H_
+#define FAKE_SCOREP_OA_H_
+
+#include "SCOREP_OA_ReturnTypes.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Shape of the simulated application
+ */
+struct FakeOAConfig {
+    int         processes;  ///< Simulated MPI ranks, one listening socket each
+    int         threads;    ///< Threads measured per rank
+    int         regions;    ///< Region definitions including the phase region
+    int         metrics;    ///< Requested metrics answered per experiment, 0 for all
+    int         phaseTime;  ///< Simulated duration of one phase execution in microseconds
+    unsigned    seed;       ///< Seed of the synthetic values
+    std::string phase;      ///< Name of the phase region, as passed to the agent with --phase
+    std::string replay;     ///< Prefix of recorded summaries, empty for synthetic profiles
+
+    FakeOAConfig() : processes( 1 ), threads( 1 ), regions( 16 ), metrics( 0 ), phaseTime( 1000 ),
+        seed( 1 ), phase( "OA_phase" ) {
+    }
+};
+
+/**
+ * @brief The five buffers Score-P sends for one getsummarydata request
+ */
+struct FakeOASummary {
+    std::vector< SCOREP_OA_CallPathRegionDef >      regions;
+    std::vector< SCOREP_OA_FlatProfileMeasurement > flat;
+    std::vector< SCOREP_OA_CallPathCounterDef >     counters;
+    std::vector< SCOREP_OA_CallTreeDef >            calltree;
+    std::vector< SCOREP_OA_RtsMeasurement >         rts;
+};
+
+/**
+ * @brief Counters of the served traffic
+ */
+struct FakeOAStats {
+    long   commands;     ///< Lines received from the agent
+    long   experiments;  ///< Phase executions requested with runtoend
+    long   summaries;    ///< Answered getsummarydata requests
+    long   measurements; ///< Flat profile entries sent
+    long   bytes;        ///< Bytes sent
+    double simulated;    ///< Wall time of the simulated phases on the slowest rank
+    double connected;    ///< Wall time of the first connection
+    double finished;     ///< Wall time the last rank terminated
+
+    FakeOAStats() : commands( 0 ), experiments( 0 ), summaries( 0 ), measurements( 0 ), bytes( 0 ),
+        simulated( 0 ), connected( 0 ), finished( 0 ) {
+    }
+};
+
+/**
+ * @class FakeScorepOA
+ * @ingroup AnalysisAgent
+ *
+ * @brief Speaks the monitor side of the online-access protocol for a set of simulated ranks
+ *
+ * Every rank listens on its own port like an instrumented process does, so the agent connects
+ * through DataProvider::init exactly as to a real application. Requests are acknowledged with OK,
+ * runtostart and runtoend suspend the rank again after the simulated phase time and getsummarydata
+ * answers with the region definitions, flat profile, counter definitions, call tree and RTS
+ * measurements. The profile either comes from recorded summaries (DataProvider writes them when
+ * PSC_OA_RECORD names a file prefix) or is synthesized from the configured shape; in both cases only
+ * the metrics the agent requested are sent, as Score-P does.
+ */
+class FakeScorepOA {
+public:
+    FakeScorepOA( const FakeOAConfig& config );
+
+    ~FakeScorepOA();
+
+    /// Open the listening sockets at the first free ports from basePort on; false on failure
+    bool listen( int basePort );
+
+    /// Load the recorded summaries of config.replay; false if none could be read
+    bool loadReplay();
+
+    int port( int rank ) const;
+
+    /// Serve the ranks for at most timeout milliseconds; false once every connected rank terminated
+    bool serve( int timeout );
+
+    /// Summary a rank answers with for the given requested metrics
+    FakeOASummary summary( int                               rank,
+                           const std::vector< std::string >& metrics );
+
+    const FakeOAStats& stats() const {
+        return stats_;
+    }
+
+    void report( std::ostream& out ) const;
+
+private:
+    struct Rank {
+        int                        rank;
+        int                        listener;
+        int                        sock;
+        int                        port;
+        int                        iterations;
+        bool                       terminated;
+        double                     suspendAt; ///< Time to send SUSPENDED, 0 if not running
+        double                     simulated;
+        long                       served;
+        std::string                input;
+        std::vector< std::string > requested;
+    };
+
+    void handle( Rank&              rank,
+                 const std::string& line );
+
+    void reply( Rank&       rank,
+                const void* data,
+                size_t      size );
+
+    void replyLine( Rank&              rank,
+                    const std::string& line );
+
+    template< typename T >
+    void replyBuffer( Rank&                   rank,
+                      const char*             header,
+                      const std::vector< T >& buffer );
+
+    FakeOASummary synthesize( int                               rank,
+                              int                               iterations,
+                              const std::vector< std::string >& metrics ) const;
+
+    FakeOASummary replayed( int                               rank,
+                            long                              served,
+                            const std::vector< std::string >& metrics ) const;
+
+    FakeOAConfig                                  config_;
+    std::vector< Rank >                           ranks_;
+    std::vector< std::vector< FakeOASummary > >   recorded_; ///< Summaries by recorded rank
+    FakeOAStats                                   stats_;
+};
+
+/// Metric name a monitor request line asks for, empty if the line carries no metric
+std::string fake_oa_requested_metric( const std::string& line );
+
+#endif /* FAKE_SCOREP_OA_H_ */
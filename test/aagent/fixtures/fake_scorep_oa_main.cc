@@ -0,0 +1,193 @@
+/**
+   @file    fake_scorep_oa_main.cc
+   @ingroup AnalysisAgent
+   @brief   Fake Score-P online-access application for driving the analysis agent offline
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "FakeScorepOA.h"
+#include "psc_errmsg.h"
+#include "registry.h"
+#include "timing.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <iostream>
+#include <vector>
+
+static void usage( const char* app ) {
+    FakeOAConfig config;
+    fprintf( stderr, "Usage: %s --registry=host:port <options>\n", app );
+    fprintf( stderr, "  (the registry and the application name default to SCOREP_ONLINEACCESS_REG_HOST,\n" );
+    fprintf( stderr, "   SCOREP_ONLINEACCESS_REG_PORT and SCOREP_ONLINEACCESS_APPL_NAME, as set by the starters)\n" );
+    fprintf( stderr, "  [--app=name]             (Application name registered, default=appl)\n" );
+    fprintf( stderr, "  [--procs=n]              (Simulated MPI ranks, default=%d)\n", config.processes );
+    fprintf( stderr, "  [--threads=n]            (Threads per rank, default=%d)\n", config.threads );
+    fprintf( stderr, "  [--regions=n]            (Regions including the phase, default=%d)\n", config.regions );
+    fprintf( stderr, "  [--metrics=n]            (Requested metrics answered per experiment, default=all)\n" );
+    fprintf( stderr, "  [--phase=name]           (Phase region name, default=%s)\n", config.phase.c_str() );
+    fprintf( stderr, "  [--phase-time=us]        (Simulated phase duration, default=%d)\n", config.phaseTime );
+    fprintf( stderr, "  [--seed=n]               (Seed of the synthetic values, default=%u)\n", config.seed );
+    fprintf( stderr, "  [--replay=prefix]        (Replay the summaries recorded with PSC_OA_RECORD=prefix)\n" );
+    fprintf( stderr, "  [--port=n]               (First port to listen on, default=50000)\n" );
+    fprintf( stderr, "  [--timeout=s]            (Give up after s seconds without traffic, default=600)\n" );
+}
+
+
+int main( int   argc,
+          char* argv[] ) {
+    static const struct option long_opts[] =
+    {
+        { "help",       no_argument,       0, 'a' },
+        { "registry",   required_argument, 0, 'b' },
+        { "app",        required_argument, 0, 'c' },
+        { "procs",      required_argument, 0, 'd' },
+        { "threads",    required_argument, 0, 'e' },
+        { "regions",    required_argument, 0, 'f' },
+        { "metrics",    required_argument, 0, 'g' },
+        { "phase",      required_argument, 0, 'h' },
+        { "phase-time", required_argument, 0, 'i' },
+        { "seed",       required_argument, 0, 'j' },
+        { "replay",     required_argument, 0, 'k' },
+        { "port",       required_argument, 0, 'l' },
+        { "timeout",    required_argument, 0, 'm' },
+        { 0,            0,                 0, 0   }
+    };
+
+    FakeOAConfig config;
+    std::string  registryAddress;
+    std::string  app     = "appl";
+    int          port    = 50000;
+    int          timeout = 600;
+
+    // started by a starter plugin in place of an instrumented application
+    const char* regHostEnv = getenv( "SCOREP_ONLINEACCESS_REG_HOST" );
+    const char* regPortEnv = getenv( "SCOREP_ONLINEACCESS_REG_PORT" );
+    const char* appEnv     = getenv( "SCOREP_ONLINEACCESS_APPL_NAME" );
+    if( regHostEnv && regPortEnv ) {
+        registryAddress = std::string( regHostEnv ) + ":" + regPortEnv;
+    }
+    if( appEnv && *appEnv ) {
+        app = appEnv;
+    }
+
+    int result;
+    while( ( result = getopt_long( argc, argv, "", long_opts, NULL ) ) != -1 ) {
+        switch( result ) {
+        case 'b':
+            registryAddress = optarg;
+            break;
+        case 'c':
+            app = optarg;
+            break;
+        case 'd':
+            config.processes = atoi( optarg );
+            break;
+        case 'e':
+            config.threads = atoi( optarg );
+            break;
+        case 'f':
+            config.regions = atoi( optarg );
+            break;
+        case 'g':
+            config.metrics = atoi( optarg );
+            break;
+        case 'h':
+            config.phase = optarg;
+            break;
+        case 'i':
+            config.phaseTime = atoi( optarg );
+            break;
+        case 'j':
+            config.seed = strtoul( optarg, NULL, 10 );
+            break;
+        case 'k':
+            config.replay = optarg;
+            break;
+        case 'l':
+            port = atoi( optarg );
+            break;
+        case 'm':
+            timeout = atoi( optarg );
+            break;
+        default:
+            usage( argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    size_t colon = registryAddress.rfind( ':' );
+    if( colon == std::string::npos || atoi( registryAddress.c_str() + colon + 1 ) <= 0 ||
+        config.processes <= 0 || config.regions <= 0 || timeout <= 0 ) {
+        usage( argv[ 0 ] );
+        return 1;
+    }
+    psc_set_progname( "fake_scorep_oa" );
+
+    FakeScorepOA producer( config );
+    if( !config.replay.empty() && !producer.loadReplay() ) {
+        return 1;
+    }
+    if( !producer.listen( port ) ) {
+        return 1;
+    }
+
+    std::string regHost = registryAddress.substr( 0, colon );
+    registry*   reg     = open_registry( regHost.c_str(), atoi( registryAddress.c_str() + colon + 1 ) );
+    if( !reg ) {
+        psc_errmsg( "Cannot connect to the registry at %s\n", registryAddress.c_str() );
+        return 1;
+    }
+
+    // register like the Score-P monitor does: the agent reads the rank from pid - 1
+    char hostname[ 256 ];
+    gethostname( hostname, sizeof( hostname ) );
+    std::vector< int > entries;
+    for( int r = 0; r < config.processes; r++ ) {
+        int entry = registry_create_entry( reg, app.c_str(), "fake", "fake", hostname, producer.port( r ),
+                                           r + 1, "MRIMONITOR", "none" );
+        if( entry <= 0 ) {
+            psc_errmsg( "Cannot register rank %d\n", r );
+            close_registry( reg );
+            return 1;
+        }
+        entries.push_back( entry );
+    }
+    std::cout << "Fake Score-P OA: " << config.processes << " rank(s) of " << app << " listening from port "
+              << producer.port( 0 ) << std::endl;
+
+    long   last   = producer.stats().commands;
+    double active = psc_wall_time();
+    while( producer.serve( 100 ) ) {
+        if( producer.stats().commands != last ) {
+            last   = producer.stats().commands;
+            active = psc_wall_time();
+        }
+        else if( psc_wall_time() - active > timeout ) {
+            psc_errmsg( "No request from the agent for %d s, giving up\n", timeout );
+            break;
+        }
+    }
+
+    // the agent deletes the entries of the ranks it terminated, the others are ours to remove
+    for( size_t e = 0; e < entries.size(); e++ ) {
+        registry_delete_entry( reg, entries[ e ] );
+    }
+    close_registry( reg );
+
+    producer.report( std::cout );
+    return 0;
+}
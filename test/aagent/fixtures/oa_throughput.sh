@@ -0,0 +1,70 @@
+#!/bin/sh
+#
+# End-to-end throughput benchmark of the analysis agent against the fake Score-P
+# online-access endpoint; everything runs on the local host.
+#
+# Usage: oa_throughput.sh <directory with psc_regsrv, psc_analysisagent and psc_fake_scorep_oa>
+#
+# The shape of the simulated application is taken from the environment:
+#   OA_PROCS (64), OA_THREADS (1), OA_REGIONS (64), OA_METRICS (0 = all requested),
+#   OA_PHASE_TIME in microseconds (1000), OA_STRATEGY (Importance), OA_REPLAY (recording prefix),
+#   OA_PORT (first port to use, 41000)
+
+bindir=${1:-.}
+procs=${OA_PROCS:-64}
+threads=${OA_THREADS:-1}
+regions=${OA_REGIONS:-64}
+metrics=${OA_METRICS:-0}
+phase_time=${OA_PHASE_TIME:-1000}
+strategy=${OA_STRATEGY:-Importance}
+port=${OA_PORT:-41000}
+reg_port=$port
+app=oa_bench_$$
+work=$(mktemp -d "${TMPDIR:-/tmp}/oa_throughput.XXXXXX") || exit 1
+
+cleanup() {
+    [ -n "$fake_pid" ] && kill "$fake_pid" 2>/dev/null
+    [ -n "$reg_pid" ] && kill "$reg_pid" 2>/dev/null
+    rm -rf "$work"
+}
+trap cleanup EXIT INT TERM
+
+"$bindir/psc_regsrv" "$reg_port" > "$work/registry.log" 2>&1 &
+reg_pid=$!
+sleep 1
+
+replay=
+[ -n "$OA_REPLAY" ] && replay="--replay=$OA_REPLAY"
+"$bindir/psc_fake_scorep_oa" --registry="localhost:$reg_port" --app="$app" --procs="$procs" \
+    --threads="$threads" --regions="$regions" --metrics="$metrics" --phase-time="$phase_time" \
+    --port=$((port + 1)) --timeout=120 $replay > "$work/fake.log" 2>&1 &
+fake_pid=$!
+
+# wait until every rank is registered
+tries=0
+until grep -q "listening" "$work/fake.log"; do
+    tries=$((tries + 1))
+    if [ $tries -gt 100 ] || ! kill -0 "$fake_pid" 2>/dev/null; then
+        echo "The fake Score-P endpoint did not start:" >&2
+        cat "$work/fake.log" >&2
+        exit 1
+    fi
+    sleep 0.1
+done
+
+start=$(date +%s.%N)
+"$bindir/psc_analysisagent" --registry="localhost:$reg_port" --appname="$app" --phase=OA_phase \
+    --strategy="$strategy" --mpinumprocs="$procs" --ompnumthreads="$threads" \
+    --propfile="$work/properties.psc" --port=$((port + procs + 1000)) > "$work/agent.log" 2>&1
+status=$?
+end=$(date +%s.%N)
+
+wait "$fake_pid"
+fake_pid=
+
+echo "Analysis agent ($strategy) finished with status $status in $(awk "BEGIN { print $end - $start }") s"
+cat "$work/fake.log"
+if [ $status -ne 0 ]; then
+    tail -n 20 "$work/agent.log" >&2
+fi
+exit $status
@@ -0,0 +1,199 @@
+#define BOOST_TEST_MODULE ConfigFileTemplate
+#include <boost/test/included/unit_test.hpp>
+
+#include "ConfigFileTemplate.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <sstream>
+
+typedef std::map< std::string, std::string > Values;
+
+static Values one( const std::string& name,
+                   const std::string& value ) {
+    Values values;
+    values[ name ] = value;
+    return values;
+}
+
+
+BOOST_AUTO_TEST_CASE( placeholders_like_sed ) {
+    ConfigFileTemplate config;
+    config.setText( "nx = P1\nny = P1\nsolver = P2 # P2 here too\n", ConfigFileTemplate::KEY_VALUE );
+    BOOST_REQUIRE( config.addParameter( "P1" ) );
+    BOOST_REQUIRE( config.addParameter( "P2" ) );
+    BOOST_CHECK( !config.addParameter( "P3" ) );
+
+    Values values;
+    values[ "P1" ] = "64";
+    values[ "P2" ] = "a/b & c\\1 $x";
+    BOOST_CHECK_EQUAL( config.render( values ),
+                       "nx = 64\nny = 64\nsolver = a/b & c\\1 $x # a/b & c\\1 $x here too\n" );
+    BOOST_CHECK_EQUAL( config.render( Values() ), "nx = P1\nny = P1\nsolver = P2 # P2 here too\n" );
+}
+
+
+BOOST_AUTO_TEST_CASE( placeholder_prefixes ) {
+    // the shorter name must not eat into the longer one, whatever the order of the parameters
+    std::string text = "a=P1 b=P10 c=P1";
+    for( int order = 0; order < 2; order++ ) {
+        ConfigFileTemplate config;
+        config.setText( text, ConfigFileTemplate::KEY_VALUE );
+        BOOST_REQUIRE( config.addParameter( order ? "P10" : "P1" ) );
+        BOOST_REQUIRE( config.addParameter( order ? "P1" : "P10" ) );
+        Values values;
+        values[ "P1" ]  = "x";
+        values[ "P10" ] = "y";
+        BOOST_CHECK_EQUAL( config.render( values ), "a=x b=y c=x" );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( key_value_lines ) {
+    ConfigFileTemplate config;
+    config.setText( "# threads = 1\n"
+                    "threads = 4   # per rank\n"
+                    "  tol:1e-6\n"
+                    "path = \"/tmp/in put\"  ; quoted\n"
+                    "name = 'it''s'\n"
+                    "url = http://host/a#b\n"
+                    "empty =\r\n",
+                    ConfigFileTemplate::KEY_VALUE );
+    BOOST_REQUIRE( config.addParameter( "threads" ) );
+    BOOST_REQUIRE( config.addParameter( "tol" ) );
+    BOOST_REQUIRE( config.addParameter( "path" ) );
+    BOOST_REQUIRE( config.addParameter( "url" ) );
+    BOOST_REQUIRE( config.addParameter( "empty" ) );
+    BOOST_CHECK_EQUAL( config.currentValue( "threads" ), "4" );
+    BOOST_CHECK_EQUAL( config.currentValue( "path" ), "/tmp/in put" );
+    BOOST_CHECK_EQUAL( config.currentValue( "url" ), "http://host/a#b" );
+    BOOST_CHECK_EQUAL( config.currentValue( "empty" ), "" );
+
+    Values values;
+    values[ "threads" ] = "16";
+    values[ "tol" ]     = "= 1e-9 #";
+    values[ "path" ]    = "say \"hi\" \\o/";
+    values[ "url" ]     = "";
+    values[ "empty" ]   = "x y";
+    BOOST_CHECK_EQUAL( config.render( values ),
+                       "# threads = 1\n"
+                       "threads = 16   # per rank\n"
+                       "  tol:= 1e-9 #\n"
+                       "path = \"say \\\"hi\\\" \\\\o/\"  ; quoted\n"
+                       "name = 'it''s'\n"
+                       "url = \n"
+                       "empty =x y\r\n" );
+}
+
+
+BOOST_AUTO_TEST_CASE( ini_sections ) {
+    ConfigFileTemplate config;
+    config.setText( "[solver]\nsize = 10\n[ io ]\nsize = 20\nformat=hdf5\n", ConfigFileTemplate::KEY_VALUE );
+    BOOST_REQUIRE( config.addParameter( "io.size" ) );
+    BOOST_REQUIRE( config.addParameter( "format" ) );
+    BOOST_CHECK( !config.addParameter( "solver.format" ) );
+
+    Values values;
+    values[ "io.size" ] = "[30]";
+    values[ "format" ]  = "a;b";
+    BOOST_CHECK_EQUAL( config.render( values ), "[solver]\nsize = 10\n[ io ]\nsize = [30]\nformat=a;b\n" );
+
+    // an unqualified key is set in every section
+    ConfigFileTemplate all;
+    all.setText( "[solver]\nsize = 10\n[ io ]\nsize = 20\n", ConfigFileTemplate::KEY_VALUE );
+    BOOST_REQUIRE( all.addParameter( "size" ) );
+    BOOST_CHECK_EQUAL( all.render( one( "size", "1" ) ), "[solver]\nsize = 1\n[ io ]\nsize = 1\n" );
+}
+
+
+BOOST_AUTO_TEST_CASE( xml_elements_and_attributes ) {
+    std::string text = "<?xml version=\"1.0\"?>\n"
+                       "<!-- <threads>0</threads> -->\n"
+                       "<config>\n"
+                       "  <solver kind=\"cg\" tol='1e-6'>\n"
+                       "    <threads> 4 </threads>\n"
+                       "    <note><![CDATA[a<b]]></note>\n"
+                       "  </solver>\n"
+                       "  <io><threads>2</threads><flag/></io>\n"
+                       "</config>\n";
+    ConfigFileTemplate config;
+    config.setText( text, ConfigFileTemplate::XML );
+    BOOST_REQUIRE( config.addParameter( "solver/threads" ) );
+    BOOST_REQUIRE( config.addParameter( "solver@kind" ) );
+    BOOST_REQUIRE( config.addParameter( "solver@tol" ) );
+    BOOST_REQUIRE( config.addParameter( "note" ) );
+    BOOST_CHECK( !config.addParameter( "config@kind" ) );
+    BOOST_CHECK_EQUAL( config.currentValue( "solver/threads" ), "4" );
+    BOOST_CHECK_EQUAL( config.currentValue( "solver@tol" ), "1e-6" );
+
+    Values values;
+    values[ "solver/threads" ] = "8";
+    values[ "solver@kind" ]    = "a\"b'<&>";
+    values[ "note" ]           = "x < y";
+    BOOST_CHECK_EQUAL( config.render( values ),
+                       "<?xml version=\"1.0\"?>\n"
+                       "<!-- <threads>0</threads> -->\n"
+                       "<config>\n"
+                       "  <solver kind=\"a&quot;b&apos;&lt;&amp;&gt;\" tol='1e-6'>\n"
+                       "    <threads> 8 </threads>\n"
+                       "    <note>x &lt; y</note>\n"
+                       "  </solver>\n"
+                       "  <io><threads>2</threads><flag/></io>\n"
+                       "</config>\n" );
+
+    ConfigFileTemplate both;
+    both.setText( text, ConfigFileTemplate::XML );
+    BOOST_REQUIRE( both.addParameter( "threads" ) );
+    BOOST_CHECK_EQUAL( both.render( one( "threads", "1" ) ).find( "<io><threads>1</threads>" ) != std::string::npos, true );
+    BOOST_CHECK_EQUAL( both.render( one( "threads", "1" ) ).find( "<threads>0</threads>" ) != std::string::npos, true );
+}
+
+
+BOOST_AUTO_TEST_CASE( overlapping_parameters_are_rejected ) {
+    ConfigFileTemplate config;
+    config.setText( "n = P1\n", ConfigFileTemplate::KEY_VALUE );
+    BOOST_REQUIRE( config.addParameter( "n" ) );
+    BOOST_CHECK( !config.addParameter( "P1" ) );
+    BOOST_CHECK( !config.getError().empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( render_replaces_the_file ) {
+    char dir[] = "/tmp/psc_acp_XXXXXX";
+    BOOST_REQUIRE( mkdtemp( dir ) != NULL );
+    std::string templatePath = std::string( dir ) + "/input.xml";
+    std::string inputPath    = std::string( dir ) + "/input.cfg";
+    {
+        std::ofstream out( templatePath.c_str() );
+        out << "<run><steps>P_STEPS</steps></run>\n";
+        std::ofstream old( inputPath.c_str() );
+        old << "previous contents that are much longer than the rendered file\n";
+    }
+    chmod( inputPath.c_str(), 0640 );
+
+    ConfigFileTemplate config;
+    BOOST_REQUIRE( config.load( templatePath ) );
+    BOOST_CHECK_EQUAL( config.getFormat(), ConfigFileTemplate::XML );
+    BOOST_REQUIRE( config.addParameter( "P_STEPS" ) );
+    BOOST_REQUIRE( config.renderTo( inputPath, one( "P_STEPS", "12" ) ) );
+
+    std::ifstream     in( inputPath.c_str() );
+    std::stringstream contents;
+    contents << in.rdbuf();
+    BOOST_CHECK_EQUAL( contents.str(), "<run><steps>12</steps></run>\n" );
+    struct stat info;
+    BOOST_REQUIRE_EQUAL( stat( inputPath.c_str(), &info ), 0 );
+    BOOST_CHECK_EQUAL( info.st_mode & 0777, 0640u );
+
+    BOOST_CHECK( !config.renderTo( std::string( dir ) + "/missing/input.cfg", Values() ) );
+    BOOST_CHECK( !config.getError().empty() );
+
+    ConfigFileTemplate missing;
+    BOOST_CHECK( !missing.load( std::string( dir ) + "/none.template" ) );
+
+    unlink( templatePath.c_str() );
+    unlink( inputPath.c_str() );
+    BOOST_CHECK_EQUAL( rmdir( dir ), 0 );
+}
@@ -0,0 +1,102 @@
+#define BOOST_TEST_MODULE BayesianOptimizer
+
+#include <boost/test/included/unit_test.hpp>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "BayesianOptimizer.h"
+#include "SyntheticObjectives.h"
+
+using namespace std;
+
+/* Runs the optimizer to its end, returns the number of batches */
+static size_t run( BayesianOptimizer& optimizer,
+                   double ( *objective )( const vector<int>& ) ) {
+    size_t batches = 0;
+    while( !optimizer.finished() ) {
+        vector<BayesianOptimizer::Point> batch = optimizer.propose();
+        BOOST_REQUIRE( !batch.empty() );
+        for( const auto& point : batch ) {
+            optimizer.observe( point, objective( optimizer.values( point ) ) );
+        }
+        batches++;
+    }
+    return batches;
+}
+
+
+BOOST_AUTO_TEST_CASE( batches_are_new_points ) {
+    BayesianOptimizer optimizer( syntheticSpace(), 1 );
+    optimizer.setBatchSize( 5 );
+    optimizer.setMaxEvaluations( 40 );
+
+    set<BayesianOptimizer::Point> proposed;
+    while( !optimizer.finished() ) {
+        vector<BayesianOptimizer::Point> batch = optimizer.propose();
+        BOOST_REQUIRE( !batch.empty() );
+        BOOST_CHECK_LE( batch.size(), 5u );
+        for( const auto& point : batch ) {
+            BOOST_CHECK( proposed.insert( point ).second );
+        }
+        for( const auto& point : proposed ) {
+            optimizer.observe( point, energyObjective( optimizer.values( point ) ) );
+        }
+    }
+    BOOST_CHECK_EQUAL( optimizer.evaluations(), 40u );
+    BOOST_CHECK_EQUAL( proposed.size(), 40u );
+}
+
+
+BOOST_AUTO_TEST_CASE( converges_on_synthetic_objectives ) {
+    vector<BayesianDimension> space = syntheticSpace();
+    for( const auto& objective : syntheticObjectives() ) {
+        double optimum = 1e300;
+        for( int a : space[ 0 ].values ) {
+            for( int b : space[ 1 ].values ) {
+                for( int c : space[ 2 ].values ) {
+                    for( int d : space[ 3 ].values ) {
+                        optimum = min( optimum, objective.value( { a, b, c, d } ) );
+                    }
+                }
+            }
+        }
+
+        // a random search needs hundreds of the 24192 scenarios on average
+        BayesianOptimizer optimizer( space, 7 );
+        optimizer.setBatchSize( 4 );
+        optimizer.setMaxEvaluations( 120 );
+        run( optimizer, objective.value );
+        BOOST_TEST_MESSAGE( objective.name << ": " << optimizer.bestValue() << " against " << optimum );
+        BOOST_CHECK_LE( optimizer.bestValue(), optimum * 1.02 );
+        BOOST_CHECK_EQUAL( optimizer.bestValue(), objective.value( optimizer.values( optimizer.best() ) ) );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( small_spaces_are_exhausted ) {
+    vector<BayesianDimension> space( 2 );
+    space[ 0 ].values      = { 1, 2, 4 };
+    space[ 1 ].values      = { 10, 20 };
+    space[ 1 ].categorical = true;
+
+    BayesianOptimizer optimizer( space );
+    optimizer.setMaxEvaluations( 100 );
+    run( optimizer, []( const vector<int>& v ) { return ( double )( v[ 0 ] * v[ 1 ] ); } );
+    BOOST_CHECK_EQUAL( optimizer.evaluations(), 6u );
+    BOOST_CHECK( optimizer.values( optimizer.best() ) == vector<int>( { 1, 10 } ) );
+    BOOST_CHECK( optimizer.propose().empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( reproducible ) {
+    BayesianOptimizer first( syntheticSpace(), 3 ), second( syntheticSpace(), 3 );
+    first.setMaxEvaluations( 24 );
+    second.setMaxEvaluations( 24 );
+    run( first, valleyObjective );
+    run( second, valleyObjective );
+    BOOST_CHECK( first.best() == second.best() );
+
+    BOOST_CHECK_THROW( BayesianOptimizer( vector<BayesianDimension>( 1 ) ), invalid_argument );
+    BOOST_CHECK_THROW( BayesianOptimizer( syntheticSpace() ).best(), logic_error );
+}
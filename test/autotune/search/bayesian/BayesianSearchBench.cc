@@ -0,0 +1,115 @@
+/* Offline benchmark of the Bayesian search against exhaustive and random search.
+ *
+ * Every search minimizes the synthetic objectives one experiment after the other. The benchmark
+ * reports the number of experiments until a scenario within 2% of the optimum was measured: for
+ * the exhaustive search in the order it enumerates the space, for the random search and the
+ * Bayesian search as the median and worst case over several seeds. An experiment of the Bayesian
+ * search runs a whole batch of scenarios, so it is reported both in scenarios and in experiments.
+ *
+ * Usage: bayesian_search_bench [seeds] [batch size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "BayesianOptimizer.h"
+#include "SyntheticObjectives.h"
+
+static const double tolerance = 1.02;
+
+/* all points in the order of the exhaustive search, the last parameter changing fastest */
+static std::vector<BayesianOptimizer::Point> enumerate( const std::vector<BayesianDimension>& space ) {
+    std::vector<BayesianOptimizer::Point> points;
+    BayesianOptimizer::Point              point( space.size(), 0 );
+    for( ;; ) {
+        points.push_back( point );
+        size_t d = space.size();
+        while( d > 0 && ++point[ d - 1 ] == space[ d - 1 ].values.size() ) {
+            point[ --d ] = 0;
+        }
+        if( d == 0 ) {
+            return points;
+        }
+    }
+}
+
+static std::vector<int> values( const std::vector<BayesianDimension>& space,
+                                const BayesianOptimizer::Point&       point ) {
+    std::vector<int> result;
+    for( size_t d = 0; d < space.size(); d++ ) {
+        result.push_back( space[ d ].values[ point[ d ] ] );
+    }
+    return result;
+}
+
+static size_t median( std::vector<size_t> v ) {
+    std::sort( v.begin(), v.end() );
+    return v[ v.size() / 2 ];
+}
+
+int main( int   argc,
+          char* argv[] ) {
+    int seeds     = argc > 1 ? atoi( argv[ 1 ] ) : 10;
+    int batchSize = argc > 2 ? atoi( argv[ 2 ] ) : 4;
+
+    std::vector<BayesianDimension>        space  = syntheticSpace();
+    std::vector<BayesianOptimizer::Point> points = enumerate( space );
+    printf( "%zu scenarios, batches of %d, %d seeds\n\n", points.size(), batchSize, seeds );
+    printf( "%-12s %12s %16s %22s %16s\n", "objective", "exhaustive", "random (worst)", "bayesian (worst)", "experiments" );
+
+    int failures = 0;
+    for( const auto& objective : syntheticObjectives() ) {
+        double optimum = 1e300;
+        for( const auto& point : points ) {
+            optimum = std::min( optimum, objective.value( values( space, point ) ) );
+        }
+        double target = optimum * tolerance;
+
+        size_t exhaustive = 0;
+        while( objective.value( values( space, points[ exhaustive ] ) ) > target ) {
+            exhaustive++;
+        }
+        exhaustive++;
+
+        std::vector<size_t> random, bayesian, experiments;
+        for( int seed = 0; seed < seeds; seed++ ) {
+            std::vector<BayesianOptimizer::Point> order = points;
+            std::shuffle( order.begin(), order.end(), std::mt19937( seed ) );
+            size_t n = 0;
+            while( objective.value( values( space, order[ n ] ) ) > target ) {
+                n++;
+            }
+            random.push_back( n + 1 );
+
+            BayesianOptimizer optimizer( space, seed );
+            optimizer.setBatchSize( batchSize );
+            optimizer.setMaxEvaluations( 400 );
+            size_t rounds = 0, found = 0;
+            while( !found && !optimizer.finished() ) {
+                rounds++;
+                for( const auto& point : optimizer.propose() ) {
+                    double value = objective.value( values( space, point ) );
+                    optimizer.observe( point, value );
+                    if( !found && value <= target ) {
+                        found = optimizer.evaluations();
+                    }
+                }
+            }
+            failures += !found;
+            bayesian.push_back( found ? found : optimizer.evaluations() );
+            experiments.push_back( rounds );
+        }
+
+        printf( "%-12s %12zu %8zu (%5zu) %14zu (%5zu) %16zu\n", objective.name.c_str(), exhaustive,
+                median( random ), *std::max_element( random.begin(), random.end() ),
+                median( bayesian ), *std::max_element( bayesian.begin(), bayesian.end() ), median( experiments ) );
+    }
+
+    if( failures ) {
+        printf( "\n%d Bayesian searches did not come within 2%% of the optimum\n", failures );
+    }
+    return failures != 0;
+}
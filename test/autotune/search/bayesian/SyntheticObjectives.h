@@ -0,0 +1,70 @@
+/* Synthetic objectives over a tuning space of core frequency, uncore frequency, thread count
+ * and a categorical scheduling policy, for the offline evaluation of search algorithms.
+ */
+
+#ifndef SYNTHETICOBJECTIVES_H_
+#define SYNTHETICOBJECTIVES_H_
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "BayesianOptimizer.h"
+
+static std::vector<BayesianDimension> syntheticSpace() {
+    std::vector<BayesianDimension> space( 4 );
+    for( int f = 1200; f <= 2500; f += 100 ) {
+        space[ 0 ].values.push_back( f );
+    }
+    for( int f = 1300; f <= 3000; f += 100 ) {
+        space[ 1 ].values.push_back( f );
+    }
+    for( int t = 1; t <= 24; t++ ) {
+        space[ 2 ].values.push_back( t );
+    }
+    space[ 3 ].values      = { 0, 1, 2, 3 };
+    space[ 3 ].categorical = true;
+    return space;
+}
+
+struct SyntheticObjective {
+    std::string name;
+    double ( *value )( const std::vector<int>& );
+};
+
+/* The energy of a partly memory bound kernel: compute scales with core frequency and threads,
+ * memory traffic with the uncore frequency and saturates, power grows with both frequencies */
+static double energyObjective( const std::vector<int>& v ) {
+    static const double policyOverhead[] = { 1.0, 0.92, 1.08, 0.97 };
+    double              core = v[ 0 ] / 1000.0, uncore = v[ 1 ] / 1000.0, threads = v[ 2 ];
+    double              compute = 40.0 / ( core * std::pow( threads, 0.85 ) );
+    double              memory  = 6.0 / std::min( uncore * 1.5, 0.35 * threads + 0.5 );
+    double              sync    = 0.04 * threads * policyOverhead[ v[ 3 ] ];
+    double              time    = ( compute + memory + sync ) * ( v[ 3 ] == 2 && threads < 8 ? 0.9 : 1.0 );
+    double              power   = 60.0 + threads * ( 2.0 + 1.6 * core * core ) + 12.0 * uncore * uncore;
+    return power * time;
+}
+
+/* A curved valley with its minimum away from the centre, depending on the policy */
+static double valleyObjective( const std::vector<int>& v ) {
+    static const double shift[] = { 0.0, 0.15, -0.1, 0.3 };
+    double              x = ( v[ 0 ] - 1200 ) / 1300.0, y = ( v[ 1 ] - 1300 ) / 1700.0, z = ( v[ 2 ] - 1 ) / 23.0;
+    double              a = x - 0.7, b = y - a * a - 0.2 - shift[ v[ 3 ] ] * 0.5;
+    return 10.0 + 20.0 * b * b + a * a + 4.0 * ( z - 0.6 ) * ( z - 0.6 ) + shift[ v[ 3 ] ];
+}
+
+/* Several basins of similar depth around a trend */
+static double multimodalObjective( const std::vector<int>& v ) {
+    double x = ( v[ 0 ] - 1200 ) / 1300.0, y = ( v[ 1 ] - 1300 ) / 1700.0, z = ( v[ 2 ] - 1 ) / 23.0;
+    double r = ( x - 0.3 ) * ( x - 0.3 ) + ( y - 0.6 ) * ( y - 0.6 ) + ( z - 0.5 ) * ( z - 0.5 );
+    return 20.0 + 8.0 * r - 1.5 * std::cos( 6.0 * x ) * std::cos( 5.0 * y ) + 0.4 * ( v[ 3 ] == 1 ) + 0.2 * v[ 3 ] * z;
+}
+
+static const std::vector<SyntheticObjective>& syntheticObjectives() {
+    static const std::vector<SyntheticObjective> objectives = {
+        { "energy", energyObjective }, { "valley", valleyObjective }, { "multimodal", multimodalObjective }
+    };
+    return objectives;
+}
+
+#endif /* SYNTHETICOBJECTIVES_H_ */
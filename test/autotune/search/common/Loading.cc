@@ -51,4 +51,8 @@ BOOST_AUTO_TEST_CASE( loading_dvfs ) {
     LOAD_PLUGIN( "gde3" );
 }
 
+BOOST_AUTO_TEST_CASE( loading_bayesian ) {
+    LOAD_PLUGIN( "bayesian" );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,748 @@
+#define BOOST_TEST_MODULE ObjectiveQuantities
+
+#include "GlobalFixture.h"
+#include "FrontendFixture.h"
+#include "search_common.h"
+#include "PropertyID.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <sstream>
+
+using namespace std;
+
+// the objective functions as they were before the quantities were extracted in one pass, except that
+// lookups compare with the end of the copy they searched instead of the end of another temporary copy
+namespace legacy {
+static double Energy(std::list<MetaProperty>& properties) {
+    double energy = 0;
+
+    for( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS) {
+            energy += property.getSeverity();
+        }
+        if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType addInfo = property.getExtraInfo();
+            addInfoType::iterator iter = addInfo.find("NodeEnergy");
+            if (iter != addInfo.end()) {
+                energy += std::stod(iter->second);
+            } else {
+                psc_errmsg("NodeEnergy not found\n");
+            }
+        }
+    }
+
+    return energy;
+}
+
+static double NormalizedEnergy(std::list<MetaProperty>& properties) {
+    double energy =0, totInstr = 0.0;
+
+    for( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
+            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType::iterator iter;
+            addInfoType addInfo = property.getExtraInfo();
+            iter = addInfo.find("TotalInstr");
+            if (iter != addInfo.end()) {
+                 totInstr = std::stod(iter->second);
+            }
+            else {
+                psc_errmsg("TotalInstr not found\n");
+            }
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                addInfoType::iterator iter = addInfo.find("NodeEnergy");
+                if (iter != addInfo.end()) {
+                    energy += std::stod(iter->second)/totInstr;
+                } else {
+                    psc_errmsg("NodeEnergy not found\n");
+                }
+            }
+            else {
+                energy += property.getSeverity()/totInstr;
+            }
+        }
+    }
+
+    return energy;
+}
+
+static double CPUEnergy(std::list<MetaProperty>& properties) {
+    double energy = 0.0;
+
+    for( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
+            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType addInfo = property.getExtraInfo();
+            addInfoType::iterator it = addInfo.find("CPUEnergy");
+            if (it != addInfo.end()) {
+                std::string cpuString = it->second;
+                INT64 cpuEnergy = std::stod(cpuString);
+                energy += cpuEnergy;
+            } else {
+                psc_errmsg("CPUEnergy not found\n");
+            }
+        }
+    }
+
+    return energy;
+}
+
+static double NormalizedCPUEnergy(std::list<MetaProperty>& properties) {
+    double energy =0, totInstr = 0.0;
+
+    for( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
+            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType::iterator it;
+            addInfoType addInfo = property.getExtraInfo();
+            it = addInfo.find("TotalInstr");
+            if (it != addInfo.end()) {
+                totInstr = std::stod(it->second);
+            }
+            else {
+                psc_errmsg("TotalInstr not found\n");
+            }
+            it = addInfo.find("CPUEnergy");
+            if (it != addInfo.end()) {
+                energy += std::stod(it->second)/totInstr;
+            } else {
+                psc_errmsg("CPUEnergy not found\n");
+            }
+
+        }
+    }
+    return energy;
+}
+
+static double EDP(std::list<MetaProperty>& properties) {
+    double energy = 0;
+    double time = -1.0;
+
+    for( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
+            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType::iterator it;
+            addInfoType addInfo = property.getExtraInfo();
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                addInfoType::iterator iter = addInfo.find("NodeEnergy");
+                if (iter != addInfo.end()) {
+                    energy += std::stod(iter->second);
+                } else {
+                    psc_errmsg("NodeEnergy not found\n");
+                }
+            }
+            else {
+                energy += property.getSeverity();
+            }
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                it = addInfo.find("cycles");
+            } else {
+                it = addInfo.find("ExecTime");
+            }
+
+            if (it != addInfo.end()) {
+                double time1(0.0);
+                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                    time1 = std::stod(it->second)/NANOSEC_PER_SEC_DOUBLE;
+                } else {
+                    time1 = std::stod(it->second);
+                }
+                if (time < time1) {
+                    time = time1;
+                }
+            } else {
+                psc_errmsg("ExecTime not found\n");
+            }
+        }
+    }
+
+    return energy * time;
+}
+
+static double NormalizedEDP(std::list<MetaProperty>& properties) {
+    double energy = 0;
+    double time = -1.0;
+    double totInstr = 0.0;
+
+    for( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
+            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType::iterator it;
+            addInfoType addInfo = property.getExtraInfo();
+            it = addInfo.find("TotalInstr");
+            if (it != addInfo.end()) {
+                totInstr = std::stod(it->second);
+            }
+            else {
+                psc_errmsg("TotalInstr not found\n");
+            }
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                it = addInfo.find("cycles");
+            } else {
+                it = addInfo.find("ExecTime");
+            }
+
+            if (it != addInfo.end()) {
+                double time1(0.0);
+                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                    time1 = std::stod(it->second)/totInstr/NANOSEC_PER_SEC_DOUBLE;
+                } else {
+                    time1 = std::stod(it->second)/totInstr;
+                }
+                if (time < time1) {
+                    time = time1;
+                }
+            } else {
+                psc_errmsg("ExecTime not found\n");
+            }
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                addInfoType::iterator iter = addInfo.find("NodeEnergy");
+                if (iter != addInfo.end()) {
+                    energy += std::stod(iter->second)/totInstr;
+                } else {
+                    psc_errmsg("NodeEnergy not found\n");
+                }
+            }
+            else {
+                energy += property.getSeverity()/totInstr;
+            }
+        }
+    }
+
+    return energy * time;
+}
+
+static double ED2P(std::list<MetaProperty>& properties) {
+    double energy = 0;
+    double time = -1.0;
+
+    for ( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
+            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType::iterator it;
+            addInfoType addInfo = property.getExtraInfo();
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                addInfoType::iterator iter = addInfo.find("NodeEnergy");
+                if (iter != addInfo.end()) {
+                    energy += std::stod(iter->second);
+                } else {
+                    psc_errmsg("NodeEnergy not found\n");
+                }
+            }
+            else {
+                energy += property.getSeverity();
+            }
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                it = addInfo.find("cycles");
+            } else {
+                it = addInfo.find("ExecTime");
+            }
+
+            if (it != addInfo.end()) {
+                double time1(0.0);
+                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                    time1 = std::stod(it->second)/NANOSEC_PER_SEC_DOUBLE;
+                } else {
+                    time1 = std::stod(it->second);
+                }
+                if (time < time1) {
+                    time = time1;
+                }
+            } else {
+                psc_errmsg("ExecTime not found\n");
+            }
+        }
+    }
+
+    return energy * time * time;
+}
+
+static double NormalizedED2P(std::list<MetaProperty>& properties) {
+    double energy = 0;
+    double time = -1.0;
+    double totInstr = 0.0;
+
+    for ( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
+            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType::iterator it;
+            addInfoType addInfo = property.getExtraInfo();
+            it = addInfo.find("TotalInstr");
+            if (it != addInfo.end()) {
+                totInstr = std::stod(it->second);
+            }  else {
+                psc_errmsg("TotalInstr not found\n");
+            }
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                it = addInfo.find("cycles");
+            } else {
+                it = addInfo.find("ExecTime");
+            }
+
+            if (it != addInfo.end()) {
+                double time1(0.0);
+                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                    time1 = std::stod(it->second)/totInstr/NANOSEC_PER_SEC_DOUBLE;
+                } else {
+                    time1 = std::stod(it->second)/totInstr;
+                }
+                if (time < time1) {
+                    time = time1;
+                }
+            } else {
+                psc_errmsg("ExecTime not found\n");
+            }
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                addInfoType::iterator iter = addInfo.find("NodeEnergy");
+                if (iter != addInfo.end()) {
+                    energy += std::stod(iter->second)/totInstr;
+                } else {
+                    psc_errmsg("NodeEnergy not found\n");
+                }
+            } else {
+                energy += property.getSeverity()/totInstr;
+            }
+        }
+    }
+
+    return energy * time * time;
+}
+
+static double Time(std::list<MetaProperty>& properties) {
+    double time = 0;
+
+    for ( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
+            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType::iterator it;
+            addInfoType addInfo = property.getExtraInfo();
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                it = addInfo.find("cycles");
+            }
+            else {
+                it = addInfo.find("ExecTime");
+            }
+            if (it != addInfo.end()) {
+                std::string timeString = it->second;
+                if (time < std::stod(timeString)) {
+                    if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                        time = std::stod(timeString) / NANOSEC_PER_SEC_DOUBLE;
+                    }
+                    else
+                        time = std::stod(timeString);
+                }
+            } else {
+                psc_errmsg("ExecTime not found\n");
+            }
+        }
+    }
+
+    return time;
+}
+
+static double NormalizedTime(std::list<MetaProperty>& properties) {
+    double time = 0.0;
+    double totInstr = 0.0;
+
+    for ( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS   ||
+            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType::iterator it;
+            addInfoType addInfo = property.getExtraInfo();
+            it = addInfo.find("TotalInstr");
+            if (it != addInfo.end()) {
+                totInstr = std::stod(it->second);
+            }
+            else {
+                psc_errmsg("TotalInstr not found\n");
+            }
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                it = addInfo.find("cycles");
+            }
+            else {
+                it = addInfo.find("ExecTime");
+            }
+            if (it != addInfo.end() && totInstr != 0.0) {
+                double time1(0.0);
+                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                    time1 = std::stod(it->second)/totInstr/ NANOSEC_PER_SEC_DOUBLE;
+                }
+                else {
+                    time1 = std::stod(it->second)/totInstr;
+                }
+                if (time < time1) {
+                    time = time1;
+                }
+            } else {
+                psc_errmsg("ExecTime not found\n");
+            }
+        }
+
+    }
+
+    return time;
+}
+
+static double TCO(std::list<MetaProperty>& properties, double costJoule, double costCoreHour) {
+    double time = 0;
+    double energy = 0;
+
+    for ( auto property : properties ) {
+       if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+           std::stoi(property.getId()) == INTERPHASE_PROPS ||
+           std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType::iterator it;
+            addInfoType addInfo = property.getExtraInfo();
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                addInfoType::iterator iter = addInfo.find("NodeEnergy");
+                if (iter != addInfo.end()) {
+                    energy += std::stod(iter->second);
+                } else {
+                    psc_errmsg("NodeEnergy not found\n");
+                }
+            }
+            else {
+                energy += property.getSeverity();
+            }
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                it = addInfo.find("cycles");
+            } else {
+                it = addInfo.find("ExecTime");
+            }
+
+            if (it != addInfo.end()) {
+                double time1(0.0);
+                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                    time1 = std::stod(it->second)/NANOSEC_PER_SEC_DOUBLE;
+                } else {
+                    time1 = std::stod(it->second);
+                }
+                if (time < time1) {
+                    time = time1;
+                }
+            } else {
+                psc_errmsg("ExecTime not found\n");
+            }
+        }
+    }
+
+    return time*fe->get_ompnumthreads()*fe->get_mpinumprocs()*costCoreHour/3600+energy*costJoule;
+}
+
+static double NormalizedTCO(std::list<MetaProperty>& properties, double costJoule, double costCoreHour) {
+    double time = 0;
+    double energy = 0;
+    double totInstr = 0.0;
+
+    for ( auto property : properties ) {
+        if (std::stoi(property.getId()) == ENERGY_CONSUMPTION ||
+            std::stoi(property.getId()) == INTERPHASE_PROPS ||
+            std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+            addInfoType::iterator it;
+            addInfoType addInfo = property.getExtraInfo();
+            it = addInfo.find("TotalInstr");
+            if (it != addInfo.end()) {
+                totInstr = std::stod(it->second);
+            }  else {
+                psc_errmsg("TotalInstr not found\n");
+            }
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                it = addInfo.find("cycles");
+            } else {
+                it = addInfo.find("ExecTime");
+            }
+
+            if (it != addInfo.end()) {
+                double time1(0.0);
+                if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                    time1 = std::stod(it->second)/totInstr/NANOSEC_PER_SEC_DOUBLE;
+                } else {
+                    time1 = std::stod(it->second)/totInstr;
+                }
+                if (time < time1) {
+                    time = time1;
+                }
+            } else {
+                psc_errmsg("ExecTime not found\n");
+            }
+
+            if (std::stoi(property.getId()) == EXECTIMEIMPORTANCE) {
+                addInfoType::iterator iter = addInfo.find("NodeEnergy");
+                if (iter != addInfo.end()) {
+                    energy += std::stod(iter->second)/totInstr;
+                } else {
+                    psc_errmsg("NodeEnergy not found\n");
+                }
+            } else {
+                energy += property.getSeverity()/totInstr;
+            }
+        }
+    }
+
+    return (time*fe->get_ompnumthreads()*fe->get_mpinumprocs()*costCoreHour/3600+energy*costJoule);
+}
+
+static double PTF_min(std::list<MetaProperty>& properties) {
+    double minimum = 0.0;
+
+    try {
+        minimum = properties.front().getSeverity();
+
+        for( auto property : properties ) {
+            double current = property.getSeverity();
+            if( minimum > current ) {
+                minimum = current;
+            }
+        }
+    }
+    catch( const std::out_of_range& oor ) {
+        psc_errmsg("ptf_min: no properties\n" );
+    }
+
+    return minimum;
+}
+
+static double PTF_max(std::list<MetaProperty>& properties) {
+    double maximum = 0.0;
+
+   try {
+       maximum = properties.front().getSeverity();
+
+       for( auto property : properties ) {
+           double current = property.getSeverity();
+           if( maximum < current ) {
+               maximum = current;
+           }
+       }
+   }
+   catch( const std::out_of_range& oor ) {
+       psc_errmsg("ptf_max: no properties\n" );
+   }
+
+    return maximum;
+}
+}
+
+
+static MetaProperty make_property( int    id,
+                                   double severity,
+                                   int    scenario ) {
+    MetaProperty property;
+    property.setId( std::to_string( id ) );
+    property.setSeverity( severity );
+    property.addExtraInfo( "ScenarioID", std::to_string( scenario ) );
+    return property;
+}
+
+
+static string random_value( double scale ) {
+    std::ostringstream value;
+    value.precision( 17 );
+    value << scale * ( 1 + rand() % 1000 ) / 7.0;
+    return value.str();
+}
+
+
+// random mix of the properties the objectives read, with some of the extra information missing
+static list<MetaProperty> random_properties( int      scenario,
+                                             unsigned seed ) {
+    srand( seed );
+    const int          ids[] = { ENERGY_CONSUMPTION, INTERPHASE_PROPS, EXECTIMEIMPORTANCE, USERREGIONEXECTIME };
+    list<MetaProperty> properties;
+    int                count = 1 + rand() % 12;
+    for( int i = 0; i < count; i++ ) {
+        int          id       = ids[ rand() % 4 ];
+        MetaProperty property = make_property( id, ( rand() % 10000 ) / 3.0, scenario );
+        if( i == 0 || rand() % 5 ) {
+            property.addExtraInfo( "TotalInstr", random_value( 1e6 ) );
+        }
+        if( rand() % 6 ) {
+            property.addExtraInfo( "CPUEnergy", random_value( 10.0 ) );
+        }
+        if( id == EXECTIMEIMPORTANCE ) {
+            if( rand() % 6 ) {
+                property.addExtraInfo( "NodeEnergy", random_value( 20.0 ) );
+            }
+            if( rand() % 6 ) {
+                property.addExtraInfo( "cycles", random_value( 1e7 ) );
+            }
+        }
+        else if( rand() % 6 ) {
+            property.addExtraInfo( "ExecTime", random_value( 0.01 ) );
+        }
+        properties.push_back( property );
+    }
+    return properties;
+}
+
+
+static bool same( double a,
+                  double b ) {
+    return a == b || ( isnan( a ) && isnan( b ) );
+}
+
+
+struct ObjectiveFixture : FrontendFixture {
+    vector< ObjectiveFunction* > objectives;
+
+    ObjectiveFixture() {
+        objectives.push_back( new EnergyObjective( "J" ) );
+        objectives.push_back( new NormalizedEnergyObjective( "J/instr" ) );
+        objectives.push_back( new CPUEnergyObjective( "J" ) );
+        objectives.push_back( new NormalizedCPUEnergyObjective( "J/instr" ) );
+        objectives.push_back( new EDPObjective( "J*s" ) );
+        objectives.push_back( new NormalizedEDPObjective( "J*s/instr" ) );
+        objectives.push_back( new ED2PObjective( "J*s2" ) );
+        objectives.push_back( new NormalizedED2PObjective( "J*s2/instr" ) );
+        objectives.push_back( new TimeObjective( "s" ) );
+        objectives.push_back( new NormalizedTimeObjective( "s/instr" ) );
+        objectives.push_back( new TCOObjective( "EUR" ) );
+        objectives.push_back( new NormalizedTCOObjective( "EUR/instr" ) );
+        objectives.push_back( new PTF_minObjective( "" ) );
+        objectives.push_back( new PTF_maxObjective( "" ) );
+    }
+
+    ~ObjectiveFixture() {
+        for( auto objective : objectives ) {
+            delete objective;
+        }
+    }
+
+    /// Values of the objectives above as the legacy implementations compute them
+    vector< double > legacyValues( list<MetaProperty> properties ) {
+        vector< double > values;
+        values.push_back( legacy::Energy( properties ) );
+        values.push_back( legacy::NormalizedEnergy( properties ) );
+        values.push_back( legacy::CPUEnergy( properties ) );
+        values.push_back( legacy::NormalizedCPUEnergy( properties ) );
+        values.push_back( legacy::EDP( properties ) );
+        values.push_back( legacy::NormalizedEDP( properties ) );
+        values.push_back( legacy::ED2P( properties ) );
+        values.push_back( legacy::NormalizedED2P( properties ) );
+        values.push_back( legacy::Time( properties ) );
+        values.push_back( legacy::NormalizedTime( properties ) );
+        // without a configuration file both costs default to 1
+        values.push_back( legacy::TCO( properties, 1.0, 1.0 ) );
+        values.push_back( legacy::NormalizedTCO( properties, 1.0, 1.0 ) );
+        values.push_back( legacy::PTF_min( properties ) );
+        values.push_back( legacy::PTF_max( properties ) );
+        return values;
+    }
+};
+
+
+BOOST_GLOBAL_FIXTURE( GlobalFixture );
+
+BOOST_FIXTURE_TEST_SUITE( objective_evaluation, ObjectiveFixture )
+
+BOOST_AUTO_TEST_CASE( identical_to_legacy_objectives ) {
+    for( unsigned seed = 0; seed < 200; seed++ ) {
+        list<MetaProperty> properties = random_properties( 1, seed );
+        vector< double >   expected   = legacyValues( properties );
+
+        ScenarioResultsPool srp;
+        for( auto& property : properties ) {
+            srp.push( property, 0 );
+        }
+        vector< double > batch = evaluate_objectives( 1, &srp, objectives );
+
+        BOOST_REQUIRE_EQUAL( batch.size(), objectives.size() );
+        for( size_t i = 0; i < objectives.size(); i++ ) {
+            double fromList = objectives[ i ]->objective( properties );
+            double fromPool = objectives[ i ]->objective( 1, &srp );
+            BOOST_CHECK_MESSAGE( same( fromList, expected[ i ] ), objectives[ i ]->getName() << " seed " << seed << ": "
+                                 << fromList << " != " << expected[ i ] );
+            BOOST_CHECK_MESSAGE( same( fromPool, expected[ i ] ), objectives[ i ]->getName() << " seed " << seed );
+            BOOST_CHECK_MESSAGE( same( batch[ i ], expected[ i ] ), objectives[ i ]->getName() << " seed " << seed );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( memoised_until_new_results ) {
+    ScenarioResultsPool srp;
+    list<MetaProperty>  properties = random_properties( 3, 42 );
+    for( auto& property : properties ) {
+        srp.push( property, 0 );
+    }
+
+    ObjectiveQuantities quantities;
+    BOOST_CHECK( !srp.getObjectiveQuantities( 3, quantities ) );
+    double before = objectives[ 0 ]->objective( 3, &srp );
+    BOOST_REQUIRE( srp.getObjectiveQuantities( 3, quantities ) );
+    BOOST_CHECK_EQUAL( quantities.properties, ( int )properties.size() );
+    BOOST_CHECK_EQUAL( quantities.energy, before );
+
+    // a new result of the scenario invalidates its quantities, other scenarios keep theirs
+    srp.push( make_property( 7, 1.0, 4 ), 0 );
+    BOOST_CHECK( srp.getObjectiveQuantities( 3, quantities ) );
+
+    MetaProperty late = make_property( ENERGY_CONSUMPTION, 1000.0, 3 );
+    late.addExtraInfo( "TotalInstr", "100" );
+    late.addExtraInfo( "ExecTime", "12.5" );
+    srp.push( late, 1 );
+    properties.push_back( late );
+    BOOST_CHECK( !srp.getObjectiveQuantities( 3, quantities ) );
+    BOOST_CHECK_EQUAL( objectives[ 0 ]->objective( 3, &srp ), before + 1000.0 );
+    BOOST_CHECK_EQUAL( objectives[ 8 ]->objective( 3, &srp ), legacy::Time( properties ) );
+
+    srp.clear();
+    BOOST_CHECK( !srp.getObjectiveQuantities( 3, quantities ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( extraction_of_known_values ) {
+    list<MetaProperty> properties;
+    MetaProperty       energy = make_property( ENERGY_CONSUMPTION, 50.0, 0 );
+    energy.addExtraInfo( "TotalInstr", "10" );
+    energy.addExtraInfo( "CPUEnergy", "30.75" );
+    energy.addExtraInfo( "ExecTime", "2" );
+    properties.push_back( energy );
+    MetaProperty importance = make_property( EXECTIMEIMPORTANCE, 0.5, 0 );
+    importance.addExtraInfo( "TotalInstr", "20" );
+    importance.addExtraInfo( "CPUEnergy", "10" );
+    importance.addExtraInfo( "NodeEnergy", "40" );
+    importance.addExtraInfo( "cycles", "3000000000" );
+    properties.push_back( importance );
+    properties.push_back( make_property( USERREGIONEXECTIME, 9.0, 0 ) );
+
+    ObjectiveQuantities quantities = extract_objective_quantities( properties );
+    BOOST_CHECK_EQUAL( quantities.properties, 3 );
+    BOOST_CHECK_EQUAL( quantities.minSeverity, 0.5 );
+    BOOST_CHECK_EQUAL( quantities.maxSeverity, 50.0 );
+    BOOST_CHECK_EQUAL( quantities.energy, 90.0 );
+    BOOST_CHECK_EQUAL( quantities.cpuEnergy, 40.0 );
+    BOOST_CHECK_EQUAL( quantities.maxTime, 3.0 );
+    BOOST_CHECK_EQUAL( quantities.normalizedEnergy, 50.0 / 10 + 40.0 / 20 );
+    BOOST_CHECK_EQUAL( quantities.normalizedMaxTime, 2.0 / 10 );
+    BOOST_CHECK_EQUAL( quantities.missingExecTime, 0 );
+
+    list<MetaProperty>  empty;
+    ObjectiveQuantities none = extract_objective_quantities( empty );
+    BOOST_CHECK_EQUAL( none.properties, 0 );
+    BOOST_CHECK_EQUAL( none.maxTime, -1.0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
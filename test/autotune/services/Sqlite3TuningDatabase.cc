@@ -0,0 +1,197 @@
+#define BOOST_TEST_MODULE Sqlite3TuningDatabase
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Sqlite3TuningDatabase.h"
+
+using namespace std;
+
+/* A fresh database file per test case, removed with its write-ahead log at the end */
+struct DatabaseFile {
+    string name;
+
+    DatabaseFile() {
+        char path[] = "/tmp/tuning_db_XXXXXX";
+        int  fd     = mkstemp( path );
+        close( fd );
+        unlink( path );
+        name = path;
+    }
+
+    ~DatabaseFile() {
+        unlink( name.c_str() );
+        unlink( ( name + "-wal" ).c_str() );
+        unlink( ( name + "-shm" ).c_str() );
+    }
+
+    string query( const string& sql ) const {
+        sqlite3*      db;
+        sqlite3_stmt* statement;
+        string        result;
+        sqlite3_open( name.c_str(), &db );
+        if( sqlite3_prepare_v2( db, sql.c_str(), -1, &statement, NULL ) == SQLITE_OK ) {
+            if( sqlite3_step( statement ) == SQLITE_ROW ) {
+                result = reinterpret_cast< const char* >( sqlite3_column_text( statement, 0 ) );
+            }
+            sqlite3_finalize( statement );
+        }
+        sqlite3_close( db );
+        return result;
+    }
+
+    long count( const string& sql ) const {
+        return atol( query( sql ).c_str() );
+    }
+};
+
+/* What one tuning job saves: a signature and "cases" tuning cases of its program */
+static int writeJob( const string& file,
+                     const string& run,
+                     int           job,
+                     size_t        cases ) {
+    try {
+        Sqlite3TuningDatabase db( file );
+        db.setRunId( run );
+
+        ostringstream program;
+        program << "program" << job;
+        ProgramID id( program.str() );
+
+        map<string, INT64> counters;
+        counters[ "PAPI_TOT_INS" ] = 1000 * job;
+        db.saveSignature( id, ProgramSignature( counters ) );
+
+        for( size_t i = 0; i < cases; i++ ) {
+            TuningConfiguration configuration;
+            configuration.add( TuningValue( CFS, "unroll", 0, i ) );
+            configuration.add( TuningValue( CFS, "tile", 0, job ) );
+            db.saveTuningCase( id, TuningCase( configuration, 1.0 + i ) );
+        }
+        db.commit();
+        return 0;
+    }
+    catch( std::exception& e ) {
+        fprintf( stderr, "job %d: %s\n", job, e.what() );
+        return 1;
+    }
+}
+
+/* Runs the jobs in forked processes at the same time; returns how many failed */
+static int runConcurrently( const string&           file,
+                            const vector< string >& runs,
+                            const vector< int >&    jobs,
+                            const vector< size_t >& cases ) {
+    vector< pid_t > children;
+    for( size_t i = 0; i < jobs.size(); i++ ) {
+        pid_t pid = fork();
+        if( pid == 0 ) {
+            _exit( writeJob( file, runs[ i ], jobs[ i ], cases[ i ] ) );
+        }
+        children.push_back( pid );
+    }
+
+    int failed = 0;
+    for( const auto& pid : children ) {
+        int status;
+        if( waitpid( pid, &status, 0 ) != pid || !WIFEXITED( status ) || WEXITSTATUS( status ) != 0 ) {
+            failed++;
+        }
+    }
+    return failed;
+}
+
+
+BOOST_AUTO_TEST_CASE( concurrent_writers_commit_everything ) {
+    DatabaseFile     file;
+    const int        writers = 24;
+    const size_t     cases   = 1000;
+    vector< string > runs;
+    vector< int >    jobs;
+    vector< size_t > counts;
+    for( int job = 0; job < writers; job++ ) {
+        runs.push_back( "run" + to_string( job ) );
+        jobs.push_back( job );
+        counts.push_back( cases );
+    }
+
+    BOOST_REQUIRE_EQUAL( runConcurrently( file.name, runs, jobs, counts ), 0 );
+
+    BOOST_CHECK_EQUAL( file.count( "SELECT COUNT(*) FROM benchmarks;" ), writers );
+    BOOST_CHECK_EQUAL( file.count( "SELECT COUNT(*) FROM counters;" ), writers );
+    BOOST_CHECK_EQUAL( file.count( "SELECT COUNT(*) FROM measurements;" ), writers * ( long )cases );
+    BOOST_CHECK_EQUAL( file.count( "SELECT COUNT(*) FROM configurations;" ), 2 * writers * ( long )cases );
+    BOOST_CHECK_EQUAL( file.query( "PRAGMA journal_mode;" ), "delete" );
+
+    Sqlite3TuningDatabase                db( file.name );
+    boost::scoped_ptr< Iterator< int > > programs( db.queryPrograms() );
+    int                                  found = 0;
+    while( programs->hasNext() ) {
+        boost::scoped_ptr< Iterator< TuningCase > > it( db.queryCases( programs->next() ) );
+        size_t                                      n        = 0;
+        double                                      previous = 0.0;
+        while( it->hasNext() ) {
+            TuningCase tc = it->next();
+            BOOST_CHECK( tc.second >= previous );
+            previous = tc.second;
+            n++;
+        }
+        BOOST_CHECK_EQUAL( n, cases );
+        found++;
+    }
+    BOOST_CHECK_EQUAL( found, writers );
+}
+
+
+BOOST_AUTO_TEST_CASE( crashed_run_is_committed_once ) {
+    DatabaseFile file;
+
+    // the first attempt of the run commits its signature and the first 512 cases, then dies
+    BOOST_REQUIRE_EQUAL( runConcurrently( file.name, { "rerun" }, { 7 }, { 512 } ), 0 );
+    BOOST_CHECK_EQUAL( file.count( "SELECT COUNT(*) FROM measurements;" ), 512 );
+
+    // it is restarted twice at the same time, next to unrelated jobs
+    BOOST_REQUIRE_EQUAL( runConcurrently( file.name, { "rerun", "rerun", "other1", "other2" }, { 7, 7, 8, 9 },
+                                          { 1000, 1000, 300, 300 } ), 0 );
+
+    BOOST_CHECK_EQUAL( file.count( "SELECT COUNT(*) FROM measurements m JOIN benchmarks b ON m.bid = b.id "
+                                   "WHERE b.text = 'program7';" ), 1000 );
+    BOOST_CHECK_EQUAL( file.count( "SELECT COUNT(DISTINCT m.time) FROM measurements m JOIN benchmarks b ON m.bid = b.id "
+                                   "WHERE b.text = 'program7';" ), 1000 );
+    BOOST_CHECK_EQUAL( file.count( "SELECT COUNT(*) FROM counters c JOIN benchmarks b ON c.id = b.id "
+                                   "WHERE b.text = 'program7';" ), 1 );
+    BOOST_CHECK_EQUAL( file.count( "SELECT COUNT(*) FROM measurements;" ), 1600 );
+    BOOST_CHECK_EQUAL( file.count( "SELECT COUNT(*) FROM runs WHERE run = 'rerun';" ), 5 );
+}
+
+
+BOOST_AUTO_TEST_CASE( run_identifier_from_environment ) {
+    DatabaseFile file;
+    setenv( "PSC_TUNING_RUN_ID", "job-42", 1 );
+    Sqlite3TuningDatabase named( file.name );
+    BOOST_CHECK_EQUAL( named.getRunId(), "job-42" );
+
+    unsetenv( "PSC_TUNING_RUN_ID" );
+    Sqlite3TuningDatabase unique( file.name );
+    BOOST_CHECK( !unique.getRunId().empty() );
+    BOOST_CHECK( unique.getRunId() != "job-42" );
+}
+
+
+BOOST_AUTO_TEST_CASE( write_ahead_logging_on_request ) {
+    DatabaseFile file;
+    setenv( "PSC_TUNING_DB_WAL", "1", 1 );
+    {
+        Sqlite3TuningDatabase db( file.name );
+    }
+    unsetenv( "PSC_TUNING_DB_WAL" );
+    BOOST_CHECK_EQUAL( file.query( "PRAGMA journal_mode;" ), "wal" );
+}
@@ -0,0 +1,274 @@
+#define BOOST_TEST_MODULE TuningResultCache
+
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "TuningResultCache.h"
+#include "TuningParameter.h"
+#include "ExhaustiveSearch.h"
+#include "ScenarioPoolSet.h"
+#include "SearchSpace.h"
+#include "VariantSpace.h"
+#include "MetaProperty.h"
+
+using namespace std;
+
+/* A fresh cache file per test case, removed at the end */
+struct CacheFile {
+    string name;
+
+    CacheFile() {
+        char path[] = "/tmp/tuning_cache_XXXXXX";
+        int  fd     = mkstemp( path );
+        close( fd );
+        unlink( path );
+        name = path;
+    }
+
+    ~CacheFile() {
+        unlink( name.c_str() );
+        unlink( ( name + ".lock" ).c_str() );
+    }
+};
+
+/* Energy of a phase with a minimum at 1800 MHz core and 2100 MHz uncore frequency */
+static double energy( int core,
+                      int uncore ) {
+    double c = ( core - 1800 ) / 100.0, u = ( uncore - 2100 ) / 100.0;
+    return 1000.0 + 4.0 * c * c + 2.0 * u * u + 0.5 * c * u;
+}
+
+static vector< TuningParameter* > frequencies() {
+    TuningParameter* core = new TuningParameter();
+    core->setId( 0 );
+    core->setName( "CORE_FREQ" );
+    core->setRange( 1200, 2500, 100 );
+
+    TuningParameter* uncore = new TuningParameter();
+    uncore->setId( 1 );
+    uncore->setName( "UNCORE_FREQ" );
+    uncore->setRange( 1300, 3000, 100 );
+
+    return { core, uncore };
+}
+
+struct Run {
+    int    experiments;
+    int    core, uncore;
+    double best;
+};
+
+/* One tuning run of the phase with exhaustive search. Every scenario it creates is an experiment:
+   its energy becomes the severity of the property the search evaluates and is recorded in the cache */
+static Run tune( TuningResultCache&                cache,
+                 const vector< TuningParameter* >& parameters ) {
+    ScenarioPoolSet  pools;
+    VariantSpace     variantSpace;
+    SearchSpace      searchSpace;
+    Region           phase;
+    ExhaustiveSearch search;
+
+    for( auto tp : parameters ) {
+        variantSpace.addTuningParameter( tp );
+    }
+    searchSpace.setVariantSpace( &variantSpace );
+    searchSpace.addRegion( &phase );
+    search.initialize( NULL, &pools );
+    search.addSearchSpace( &searchSpace );
+    search.createScenarios();
+
+    Run run = { 0, 0, 0, numeric_limits< double >::max() };
+    while( !pools.csp->empty() ) {
+        Scenario*                   scenario = pools.csp->pop();
+        map< TuningParameter*, int > values  = scenario->getTuningSpecifications()->front()->getVariant()->getValue();
+        int                         core     = values[ parameters[ 0 ] ];
+        int                         uncore   = values[ parameters[ 1 ] ];
+
+        MetaProperty property;
+        property.setId( "0" );
+        property.setSeverity( energy( core, uncore ) );
+        property.addExtraInfo( "ScenarioID", to_string( scenario->getID() ) );
+        pools.srp->push( property, 0 );
+        pools.fsp->push( scenario );
+
+        cache.record( "main/phase", "size=1024", { { "CORE_FREQ", core }, { "UNCORE_FREQ", uncore } }, energy( core, uncore ) );
+        run.experiments++;
+    }
+
+    BOOST_REQUIRE( search.searchFinished() );
+    int                          optimum = search.getOptimum();
+    map< TuningParameter*, int > values  = pools.fsp->getScenarioByScenarioID( optimum )->getTuningSpecifications()->front()->getVariant()->getValue();
+    run.core   = values[ parameters[ 0 ] ];
+    run.uncore = values[ parameters[ 1 ] ];
+    run.best   = search.getSearchPath()[ optimum ];
+    return run;
+}
+
+
+BOOST_AUTO_TEST_CASE( second_run_converges_in_fewer_experiments ) {
+    CacheFile file;
+
+    vector< TuningParameter* > cold = frequencies();
+    TuningResultCache          first( file.name );
+    BOOST_CHECK( !first.load() );
+    BOOST_CHECK( !first.warmStart( "main/phase", "size=1024", cold ) );
+    Run coldRun = tune( first, cold );
+    BOOST_REQUIRE( first.save() );
+
+    vector< TuningParameter* > warm = frequencies();
+    TuningResultCache          second( file.name );
+    BOOST_REQUIRE( second.load() );
+    BOOST_REQUIRE( second.warmStart( "main/phase", "size=1024", warm ) );
+    Run warmRun = tune( second, warm );
+
+    BOOST_CHECK_EQUAL( coldRun.experiments, 14 * 18 );
+    BOOST_CHECK_EQUAL( warmRun.core, 1800 );
+    BOOST_CHECK_EQUAL( warmRun.uncore, 2100 );
+    BOOST_CHECK_EQUAL( warmRun.best, coldRun.best );
+    BOOST_CHECK( warmRun.experiments * 10 <= coldRun.experiments );
+
+    // the best values are explored first, the range encloses the candidates
+    BOOST_REQUIRE( warm[ 0 ]->getRestriction() != NULL );
+    BOOST_CHECK_EQUAL( warm[ 0 ]->getRestriction()->getElements().front(), 1800 );
+    BOOST_CHECK_EQUAL( warm[ 1 ]->getRestriction()->getElements().front(), 2100 );
+    BOOST_CHECK( warm[ 0 ]->getRangeFrom() <= 1800 && warm[ 0 ]->getRangeTo() >= 1800 );
+
+    // a later warm start refills the restriction the parameter already has
+    Restriction* restriction = warm[ 0 ]->getRestriction();
+    BOOST_REQUIRE( second.warmStart( "main/phase", "size=1024", warm, 0 ) );
+    BOOST_CHECK( warm[ 0 ]->getRestriction() == restriction );
+    BOOST_CHECK( restriction->getElements() == second.candidates( "main/phase", "size=1024", "CORE_FREQ", 1200, 2500, 100, 0 ) );
+
+    for( auto tp : cold ) {
+        delete tp;
+    }
+    for( auto tp : warm ) {
+        delete tp;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( keeps_best_and_near_best ) {
+    TuningResultCache cache( "unused", 0.1, 3 );
+    cache.record( "a", "", { { "X", 1 } }, 10.0 );
+    cache.record( "a", "", { { "X", 2 } }, 20.0 );
+    cache.record( "a", "", { { "X", 3 } }, 10.5 );
+    cache.record( "a", "", { { "X", 4 } }, 10.9 );
+    cache.record( "a", "", { { "X", 5 } }, 10.2 );
+
+    const vector< CachedConfiguration >* list = cache.lookup( "a", "" );
+    BOOST_REQUIRE( list != NULL );
+    BOOST_REQUIRE_EQUAL( list->size(), 3u );
+    BOOST_CHECK_EQUAL( ( *list )[ 0 ].values.at( "X" ), 1 );
+    BOOST_CHECK_EQUAL( ( *list )[ 1 ].values.at( "X" ), 5 );
+    BOOST_CHECK_EQUAL( ( *list )[ 2 ].values.at( "X" ), 3 );
+
+    // a configuration measured again replaces its objective, here making another the best
+    cache.record( "a", "", { { "X", 1 } }, 30.0 );
+    BOOST_CHECK_EQUAL( cache.lookup( "a", "" )->front().values.at( "X" ), 5 );
+
+    BOOST_CHECK( cache.lookup( "a", "other input" ) == NULL );
+    BOOST_CHECK( cache.lookup( "b", "" ) == NULL );
+}
+
+
+BOOST_AUTO_TEST_CASE( candidates_stay_on_the_range ) {
+    TuningResultCache cache( "unused" );
+    cache.record( "a", "", { { "X", 1200 } }, 1.0 );
+    cache.record( "a", "", { { "X", 1250 } }, 1.0 );
+
+    vector< int > values = cache.candidates( "a", "", "X", 1200, 2000, 100, 2 );
+    BOOST_CHECK( values == vector< int >( { 1200, 1300, 1400 } ) );
+    BOOST_CHECK( cache.candidates( "a", "", "X", 1500, 2000, 100, 2 ).empty() );
+    BOOST_CHECK( cache.candidates( "a", "", "Y", 1200, 2000, 100, 2 ).empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( file_round_trip ) {
+    CacheFile         file;
+    TuningResultCache cache( file.name );
+    cache.record( "main/phase/solve", "size=1;threads=4", { { "CORE_FREQ", 2000 }, { "UNCORE.FREQ", 1500 } }, -3.25 );
+    cache.record( "main/phase/solve", "size=2;threads=4", { { "CORE_FREQ", 2200 } }, 7.5 );
+    BOOST_REQUIRE( cache.save() );
+
+    TuningResultCache loaded( file.name );
+    BOOST_REQUIRE( loaded.load() );
+    BOOST_CHECK_EQUAL( loaded.size(), 2u );
+    const vector< CachedConfiguration >* list = loaded.lookup( "main/phase/solve", "size=1;threads=4" );
+    BOOST_REQUIRE( list != NULL && list->size() == 1 );
+    BOOST_CHECK_EQUAL( list->front().objective, -3.25 );
+    BOOST_CHECK_EQUAL( list->front().values.at( "UNCORE.FREQ" ), 1500 );
+    BOOST_CHECK_EQUAL( list->front().values.at( "CORE_FREQ" ), 2000 );
+}
+
+
+BOOST_AUTO_TEST_CASE( concurrent_runs_keep_each_others_results ) {
+    CacheFile file;
+
+    // both runs load before either saves, the second to save must not drop what the first saved
+    TuningResultCache first( file.name ), second( file.name );
+    first.load();
+    second.load();
+    first.record( "main/phase/solve", "size=1", { { "CORE_FREQ", 2000 } }, 10.0 );
+    first.record( "main/phase/init", "size=1", { { "CORE_FREQ", 1200 } }, 1.0 );
+    second.record( "main/phase/solve", "size=1", { { "CORE_FREQ", 2000 } }, 10.25 );
+    second.record( "main/phase/solve", "size=1", { { "CORE_FREQ", 2200 } }, 10.5 );
+    second.record( "main/phase/solve", "size=2", { { "CORE_FREQ", 2400 } }, 3.0 );
+    BOOST_REQUIRE( first.save() );
+    BOOST_REQUIRE( second.save() );
+
+    TuningResultCache loaded( file.name );
+    BOOST_REQUIRE( loaded.load() );
+    BOOST_CHECK_EQUAL( loaded.size(), 3u );
+    BOOST_CHECK( loaded.lookup( "main/phase/init", "size=1" ) != NULL );
+    BOOST_CHECK( loaded.lookup( "main/phase/solve", "size=2" ) != NULL );
+    // a configuration both measured keeps the objective of the run that saved last
+    const vector< CachedConfiguration >* list = loaded.lookup( "main/phase/solve", "size=1" );
+    BOOST_REQUIRE( list != NULL && list->size() == 2 );
+    BOOST_CHECK_EQUAL( list->front().values.at( "CORE_FREQ" ), 2000 );
+    BOOST_CHECK_EQUAL( list->front().objective, 10.25 );
+    BOOST_CHECK_EQUAL( list->back().values.at( "CORE_FREQ" ), 2200 );
+
+    // processes saving at the same time
+    const int runs = 8, rounds = 5;
+    for( int run = 0; run < runs; run++ ) {
+        if( fork() == 0 ) {
+            for( int round = 0; round < rounds; round++ ) {
+                TuningResultCache cache( file.name );
+                cache.load();
+                cache.record( "main/phase/run" + to_string( run ), to_string( round ), { { "CORE_FREQ", 1000 + round } }, 1.0 );
+                if( !cache.save() ) {
+                    _exit( 1 );
+                }
+            }
+            _exit( 0 );
+        }
+    }
+    for( int run = 0; run < runs; run++ ) {
+        int status = -1;
+        wait( &status );
+        BOOST_CHECK( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 );
+    }
+    BOOST_REQUIRE( loaded.load() );
+    BOOST_CHECK_EQUAL( loaded.size(), 3u + runs * rounds );
+}
+
+
+BOOST_AUTO_TEST_CASE( keys_and_files ) {
+    BOOST_CHECK_EQUAL( TuningResultCache::inputKey( { { "threads", "4" }, { "size", "1024" } } ), "size=1024;threads=4" );
+    BOOST_CHECK_EQUAL( TuningResultCache::inputKey( {} ), "" );
+
+    unsetenv( "PSC_TUNING_CACHE_DIR" );
+    BOOST_CHECK_EQUAL( TuningResultCache::fileFor( "bt-mz" ), "bt-mz.tuning_cache.json" );
+    setenv( "PSC_TUNING_CACHE_DIR", "/scratch/cache", 1 );
+    BOOST_CHECK_EQUAL( TuningResultCache::fileFor( "bin/bt-mz" ), "/scratch/cache/bin_bt-mz.tuning_cache.json" );
+    unsetenv( "PSC_TUNING_CACHE_DIR" );
+}
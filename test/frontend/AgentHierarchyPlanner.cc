@@ -0,0 +1,134 @@
+#define BOOST_TEST_MODULE AgentHierarchyPlanner
+
+#include <boost/test/included/unit_test.hpp>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#include "AgentHierarchyPlanner.h"
+
+static std::string node( int n ) {
+    std::stringstream name;
+    name << "node" << n;
+    return name.str();
+}
+
+BOOST_AUTO_TEST_CASE( balanced_cluster ) {
+    BOOST_CHECK_EQUAL( AgentHierarchyPlanner::balancedCluster( 130, 128 ), 65 );
+    BOOST_CHECK_EQUAL( AgentHierarchyPlanner::balancedCluster( 128, 128 ), 128 );
+    BOOST_CHECK_EQUAL( AgentHierarchyPlanner::balancedCluster( 10, 4 ), 4 );
+    BOOST_CHECK_EQUAL( AgentHierarchyPlanner::balancedCluster( 9, 4 ), 3 );
+    BOOST_CHECK_EQUAL( AgentHierarchyPlanner::balancedCluster( 3, 8 ), 3 );
+}
+
+BOOST_AUTO_TEST_CASE( predicted_critical_path ) {
+    AgentCostModel model;
+    model.aaStartup  = 1;
+    model.aaPerUnit  = 0.5;
+    model.hlStartup  = 2;
+    model.hlPerChild = 0.25;
+    model.hlPerUnit  = 0.125;
+    model.reduction  = 0.5;
+
+    // node0: 4 processes, node1: 2 processes with a heavy one
+    AgentHierarchyPlanner planner( model );
+    for( int p = 0; p < 4; p++ ) {
+        planner.addProcess( "node0" );
+    }
+    planner.addProcess( "node1", 1 );
+    planner.addProcess( "node1", 7 );
+
+    AgentHierarchyPlan plan = planner.predict( 2, 2 );
+    BOOST_REQUIRE_EQUAL( plan.levels.size(), 3 );
+    // agents never span nodes: 2 + 1 analysis agents with volumes 2, 2, 8
+    BOOST_CHECK_EQUAL( plan.levels[ 0 ].agents, 3 );
+    BOOST_CHECK_EQUAL( plan.levels[ 0 ].maxChildren, 2 );
+    BOOST_CHECK_CLOSE( plan.levels[ 0 ].finish, 1 + 0.5 * 8, 1e-9 );
+    // { aa0, aa1 } -> 2 + 2 * 0.25 + 4 * 0.125 after 2.0 ; { aa2 } -> 2 + 0.25 + 8 * 0.125 after 5.0
+    BOOST_CHECK_EQUAL( plan.levels[ 1 ].agents, 2 );
+    BOOST_CHECK_CLOSE( plan.levels[ 1 ].finish, 5 + 2 + 0.25 + 1, 1e-9 );
+    BOOST_CHECK_CLOSE( plan.levels[ 1 ].volume, 6, 1e-9 );
+    // root receives 2 + 4 units
+    BOOST_CHECK_CLOSE( plan.levels[ 2 ].finish, 8.25 + 2 + 0.5 + 6 * 0.125, 1e-9 );
+    BOOST_CHECK_CLOSE( plan.latency, 11.5 + 0.25 + 3 * 0.125, 1e-9 );
+    BOOST_CHECK_EQUAL( plan.agents(), 6 );
+
+    // a single analysis agent needs no high-level agent
+    AgentHierarchyPlanner single( model );
+    single.addProcess( "node0", 2 );
+    AgentHierarchyPlan flat = single.predict( 128, 4 );
+    BOOST_CHECK_EQUAL( flat.levels.size(), 1 );
+    BOOST_CHECK_CLOSE( flat.latency, 2 + 0.25 + 2 * 0.125, 1e-9 );
+}
+
+BOOST_AUTO_TEST_CASE( plan_matches_exhaustive_search ) {
+    unsigned int seed = 7;
+    for( int geometry = 0; geometry < 40; geometry++ ) {
+        AgentCostModel model;
+        model.aaStartup  = 0.01 * ( 1 + rand_r( &seed ) % 10 );
+        model.aaPerUnit  = 0.001 * ( 1 + rand_r( &seed ) % 10 );
+        model.hlStartup  = 0.01 * ( rand_r( &seed ) % 10 );
+        model.hlPerChild = 0.001 * ( 1 + rand_r( &seed ) % 20 );
+        model.hlPerUnit  = 0.0001 * ( rand_r( &seed ) % 10 );
+        model.reduction  = 0.1 * ( 1 + rand_r( &seed ) % 10 );
+
+        AgentHierarchyPlanner planner( model );
+        int                   nodes   = 1 + rand_r( &seed ) % 12;
+        size_t                densest = 0;
+        for( int n = 0; n < nodes; n++ ) {
+            size_t ppn = 1 + rand_r( &seed ) % 70;
+            densest = std::max( densest, ppn );
+            for( size_t p = 0; p < ppn; p++ ) {
+                planner.addProcess( node( n ), 0.5 + rand_r( &seed ) % 4 );
+            }
+        }
+
+        AgentHierarchyPlan best = planner.plan();
+        double             brute = -1;
+        for( size_t cluster = 1; cluster <= densest + 2; cluster++ ) {
+            size_t leaves = planner.predict( cluster, 2 ).levels[ 0 ].agents;
+            for( size_t fanout = 2; fanout <= std::max< size_t >( leaves, 2 ); fanout++ ) {
+                double latency = planner.predict( cluster, fanout ).latency;
+                brute = brute < 0 || latency < brute ? latency : brute;
+            }
+        }
+        BOOST_REQUIRE_CLOSE( best.latency, brute, 1e-9 );
+        BOOST_CHECK_CLOSE( planner.predict( best.clusterSize, best.fanout ).latency, best.latency, 1e-9 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( nodes_keep_the_order_they_were_seen_in ) {
+    // node10 sorts before node9 by name, which would put the heavy node9 under a parent of its own
+    const char* named[]   = { "node9", "node10", "node11", "node9" };
+    const char* ordered[] = { "a", "b", "c", "a" };
+    double      volume[]  = { 50, 1, 1, 50 };
+
+    AgentHierarchyPlanner byName, byOrder;
+    for( int p = 0; p < 4; p++ ) {
+        byName.addProcess( named[ p ], volume[ p ] );
+        byOrder.addProcess( ordered[ p ], volume[ p ] );
+    }
+
+    for( size_t cluster = 1; cluster <= 2; cluster++ ) {
+        BOOST_CHECK_CLOSE( byName.predict( cluster, 2 ).latency, byOrder.predict( cluster, 2 ).latency, 1e-9 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( explicit_limits_are_kept ) {
+    AgentHierarchyPlanner planner;
+    for( int n = 0; n < 16; n++ ) {
+        for( int p = 0; p < 48; p++ ) {
+            planner.addProcess( node( n ) );
+        }
+    }
+
+    AgentHierarchyPlan plan = planner.plan( 128, 4 );
+    BOOST_CHECK_EQUAL( plan.clusterSize, 128 );
+    BOOST_CHECK_EQUAL( plan.fanout, 4 );
+    BOOST_CHECK_EQUAL( plan.levels[ 0 ].agents, 16 );
+    BOOST_CHECK_EQUAL( plan.levels.size(), 3 );
+
+    AgentHierarchyPlan fan = planner.plan( 0, 2 );
+    BOOST_CHECK_EQUAL( fan.fanout, 2 );
+    BOOST_CHECK( fan.latency >= planner.plan().latency );
+}
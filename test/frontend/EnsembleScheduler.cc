@@ -0,0 +1,150 @@
+#define BOOST_TEST_MODULE EnsembleScheduler
+
+#include <boost/test/included/unit_test.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "EnsembleScheduler.h"
+
+static std::vector<std::string> hosts( int count ) {
+    std::vector<std::string> names;
+    for( int i = 0; i < count; i++ ) {
+        names.push_back( "node" + std::to_string( i ) );
+    }
+    return names;
+}
+
+
+BOOST_AUTO_TEST_CASE( slots_are_named_after_the_application ) {
+    EnsembleScheduler ensemble( 3, "bt", 0 );
+    BOOST_CHECK_EQUAL( ensemble.size(), 3 );
+    BOOST_CHECK_EQUAL( ensemble.slot( 0 ).appname, "bt.slot0" );
+    BOOST_CHECK_EQUAL( ensemble.slot( 2 ).tag, "fe[0]:2" );
+    BOOST_CHECK_EQUAL( ensemble.slotOfAgent( "fe[0]:1" ), 1 );
+    BOOST_CHECK_EQUAL( ensemble.slotOfAgent( "fe[1]:1" ), -1 );
+
+    // without an ensemble the application keeps its name
+    BOOST_CHECK_EQUAL( EnsembleScheduler( 1, "bt", 0 ).slot( 0 ).appname, "bt" );
+    BOOST_CHECK_THROW( EnsembleScheduler( 0, "bt", 0 ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE( partition_into_balanced_shares ) {
+    EnsembleScheduler ensemble( 3, "bt", 0 );
+    ensemble.partition( hosts( 8 ) );
+
+    size_t total = 0;
+    for( int k = 0; k < 3; k++ ) {
+        const EnsembleSlot& slot = ensemble.slot( k );
+        BOOST_CHECK( slot.hosts.size() == 2 || slot.hosts.size() == 3 );
+        BOOST_CHECK_EQUAL( slot.shares, 1 );
+        total += slot.hosts.size();
+    }
+    BOOST_CHECK_EQUAL( total, 8u );
+    BOOST_CHECK_EQUAL( ensemble.slot( 0 ).hosts.front(), "node0" );
+    BOOST_CHECK_EQUAL( ensemble.slot( 2 ).hosts.back(), "node7" );
+}
+
+
+BOOST_AUTO_TEST_CASE( slots_share_hosts_when_there_are_fewer ) {
+    EnsembleScheduler ensemble( 5, "bt", 0 );
+    ensemble.partition( hosts( 2 ) );
+
+    // node0 runs slots 0 to 2, node1 runs slots 3 and 4
+    int expected_host[]   = { 0, 0, 0, 1, 1 };
+    int expected_share[]  = { 0, 1, 2, 0, 1 };
+    int expected_shares[] = { 3, 3, 3, 2, 2 };
+    for( int k = 0; k < 5; k++ ) {
+        const EnsembleSlot& slot = ensemble.slot( k );
+        BOOST_REQUIRE_EQUAL( slot.hosts.size(), 1u );
+        BOOST_CHECK_EQUAL( slot.hosts[ 0 ], "node" + std::to_string( expected_host[ k ] ) );
+        BOOST_CHECK_EQUAL( slot.share, expected_share[ k ] );
+        BOOST_CHECK_EQUAL( slot.shares, expected_shares[ k ] );
+    }
+
+    // a single machine runs every slot
+    ensemble.partition( hosts( 1 ) );
+    BOOST_CHECK_EQUAL( ensemble.slot( 4 ).hosts[ 0 ], "node0" );
+    BOOST_CHECK_EQUAL( ensemble.slot( 4 ).share, 4 );
+    BOOST_CHECK_EQUAL( ensemble.slot( 4 ).shares, 5 );
+}
+
+
+BOOST_AUTO_TEST_CASE( experiments_fill_the_idle_slots ) {
+    EnsembleScheduler ensemble( 2, "bt", 0 );
+    ensemble.started( 0, "OMP_NUM_THREADS=4", "./bt" );
+    ensemble.started( 1, "OMP_NUM_THREADS=4", "./bt" );
+    BOOST_CHECK_EQUAL( ensemble.idleSlot(), 0 );
+    BOOST_CHECK( ensemble.roundEmpty() );
+
+    // the same configuration runs in the instance as it is
+    ensemble.assign( 0, std::vector<int>{ 1, 2 }, "OMP_NUM_THREADS=4", "./bt", false );
+    BOOST_CHECK_EQUAL( ensemble.idleSlot(), 1 );
+    BOOST_CHECK( !ensemble.needsRestart() );
+
+    // another environment restarts the instance
+    ensemble.assign( 1, std::vector<int>{ 3 }, "OMP_NUM_THREADS=8", "./bt", false );
+    BOOST_CHECK_EQUAL( ensemble.idleSlot(), -1 );
+    BOOST_CHECK( !ensemble.slot( 0 ).restart );
+    BOOST_CHECK( ensemble.slot( 1 ).restart );
+    BOOST_CHECK( ensemble.needsRestart() );
+    BOOST_CHECK_THROW( ensemble.assign( 1, std::vector<int>{ 4 }, "", "./bt", false ), std::logic_error );
+
+    BOOST_CHECK_EQUAL( ensemble.slotOfScenario( 2 ), 0 );
+    BOOST_CHECK_EQUAL( ensemble.slotOfScenario( 3 ), 1 );
+    BOOST_CHECK_EQUAL( ensemble.slotOfScenario( 4 ), -1 );
+
+    // the next round keeps the configuration of the restarted instance
+    ensemble.finishRound();
+    BOOST_CHECK( ensemble.roundEmpty() );
+    BOOST_CHECK_EQUAL( ensemble.idleSlot(), 0 );
+    ensemble.assign( 1, std::vector<int>{ 5 }, "OMP_NUM_THREADS=8", "./bt", false );
+    BOOST_CHECK( !ensemble.needsRestart() );
+    ensemble.finishRound();
+
+    // a restart requested by the plugin restarts even without a change
+    ensemble.assign( 0, std::vector<int>{ 6 }, "OMP_NUM_THREADS=4", "./bt", true );
+    BOOST_CHECK( ensemble.needsRestart() );
+}
+
+
+BOOST_AUTO_TEST_CASE( leftover_scenarios_go_to_the_least_loaded_slot ) {
+    EnsembleScheduler ensemble( 3, "bt", 0 );
+
+    // before any experiment is assigned, everything runs on the first slot
+    ensemble.distribute( std::vector<int>{ 1 } );
+    BOOST_CHECK_EQUAL( ensemble.slotOfScenario( 1 ), 0 );
+    ensemble.finishRound();
+
+    ensemble.assign( 0, std::vector<int>{ 1, 2, 3 }, "", "./bt", false );
+    ensemble.assign( 1, std::vector<int>{ 4 }, "", "./bt", false );
+    ensemble.distribute( std::vector<int>{ 1, 5, 6, 7 } );
+
+    // scenario 1 stays, the idle slot 2 gets nothing
+    BOOST_CHECK_EQUAL( ensemble.slotOfScenario( 1 ), 0 );
+    BOOST_CHECK_EQUAL( ensemble.slot( 0 ).scenarios.size(), 4u );
+    BOOST_CHECK_EQUAL( ensemble.slot( 1 ).scenarios.size(), 3u );
+    BOOST_CHECK( ensemble.slot( 2 ).scenarios.empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( results_merge_by_scenario ) {
+    EnsembleScheduler ensemble( 2, "bt", 0 );
+    ensemble.assign( 0, std::vector<int>{ 1, 2 }, "", "./bt", false );
+    ensemble.assign( 1, std::vector<int>{ 3 }, "", "./bt", false );
+    BOOST_CHECK( !ensemble.complete() );
+
+    // every region reports a property per scenario
+    BOOST_CHECK( ensemble.merge( 3 ) );
+    BOOST_CHECK( ensemble.merge( 1 ) );
+    BOOST_CHECK( ensemble.merge( 1 ) );
+    BOOST_CHECK( !ensemble.complete() );
+    BOOST_CHECK( ensemble.merge( 2 ) );
+    BOOST_CHECK( ensemble.complete() );
+
+    // results of scenarios of no slot are stale
+    BOOST_CHECK( !ensemble.merge( 4 ) );
+    ensemble.finishRound();
+    BOOST_CHECK( !ensemble.merge( 1 ) );
+}
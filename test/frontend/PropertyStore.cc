@@ -0,0 +1,127 @@
+#define BOOST_TEST_MODULE PropertyStore
+
+#include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "PropertyStore.h"
+
+static MetaProperty property( int    n,
+                              double severity,
+                              bool   internal = false ) {
+    MetaProperty prop;
+    std::stringstream name;
+    name << "Property " << n;
+    prop.setName( name.str() );
+    prop.setId( "1" );
+    prop.setFileName( "synthetic.c" );
+    prop.setStartPosition( n );
+    prop.setSeverity( severity );
+    prop.setProcess( n % 4 );
+    prop.setInternal( internal );
+    return prop;
+}
+
+static std::string read_file( const std::string& file ) {
+    std::ifstream     in( file.c_str() );
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+BOOST_AUTO_TEST_CASE( keeps_the_most_severe ) {
+    PropertyStore store;
+    store.setReportLimit( 10 );
+
+    std::vector<std::pair<double, std::string> > all;
+    srand( 3 );
+    for( int i = 0; i < 1000; i++ ) {
+        // few distinct severities, so that ties are frequent
+        MetaProperty prop = property( i, rand() % 50, i % 7 == 0 );
+        store.add( prop );
+        if( !prop.isInternal() ) {
+            all.push_back( std::make_pair( prop.getSeverity(), prop.getName() ) );
+        }
+    }
+    BOOST_CHECK_EQUAL( store.received(), 1000u );
+    BOOST_CHECK_EQUAL( store.internal(), 143u );
+
+    // the report the frontend printed before: stable sort of everything by severity
+    std::stable_sort( all.begin(), all.end(), []( const std::pair<double, std::string>& a,
+                                                  const std::pair<double, std::string>& b ) {
+        return a.first > b.first;
+    } );
+    std::vector<MetaProperty> top = store.top();
+    BOOST_REQUIRE_EQUAL( top.size(), 10u );
+    for( size_t i = 0; i < top.size(); i++ ) {
+        BOOST_CHECK_EQUAL( top[ i ].getName(), all[ i ].second );
+        BOOST_CHECK_EQUAL( top[ i ].getSeverity(), all[ i ].first );
+    }
+
+    store.setReportLimit( 3 );
+    top = store.top();
+    BOOST_REQUIRE_EQUAL( top.size(), 3u );
+    BOOST_CHECK_EQUAL( top[ 2 ].getName(), all[ 2 ].second );
+}
+
+BOOST_AUTO_TEST_CASE( no_report ) {
+    PropertyStore store;
+    store.setReportLimit( 0 );
+    MetaProperty prop = property( 1, 10.0 );
+    store.add( prop );
+    BOOST_CHECK( store.top().empty() );
+    BOOST_CHECK_EQUAL( store.received(), 1u );
+}
+
+BOOST_AUTO_TEST_CASE( streams_visible_properties ) {
+    char file[] = "/tmp/psc_property_store_XXXXXX";
+    int  fd     = mkstemp( file );
+    BOOST_REQUIRE( fd >= 0 );
+    close( fd );
+
+    PropertyStore store;
+    store.setReportLimit( 2 );
+    BOOST_REQUIRE( store.spillTo( file, "<Experiment>\n" ) );
+    BOOST_CHECK( store.spilling() );
+
+    std::string expected = "<Experiment>\n";
+    for( int i = 0; i < 20; i++ ) {
+        MetaProperty prop = property( i, i, i % 5 == 0 );
+        if( !prop.isInternal() ) {
+            expected += prop.toXML();
+        }
+        store.add( prop );
+    }
+    expected += "</Experiment>\n";
+    BOOST_CHECK_EQUAL( store.spilled(), 16u );
+    BOOST_REQUIRE( store.finish( "</Experiment>\n" ) );
+    BOOST_CHECK( !store.spilling() );
+    BOOST_CHECK_EQUAL( read_file( file ), expected );
+
+    // only the two most severe are kept for the report
+    std::vector<MetaProperty> top = store.top();
+    BOOST_REQUIRE_EQUAL( top.size(), 2u );
+    BOOST_CHECK_EQUAL( top[ 0 ].getSeverity(), 19.0 );
+    BOOST_CHECK_EQUAL( top[ 1 ].getSeverity(), 18.0 );
+
+    unlink( file );
+}
+
+BOOST_AUTO_TEST_CASE( internal_flag_serialization ) {
+    MetaProperty prop = property( 7, 1.0, true );
+    prop.setPurpose( 99 );
+    prop.setConfiguration( "1x1" );
+    MetaProperty received = MetaProperty::fromXMLDeserialize( prop.toXMLSerialize() );
+    BOOST_CHECK( received.isInternal() );
+
+    prop.setInternal( false );
+    std::string xml = prop.toXMLSerialize();
+    BOOST_CHECK( xml.find( "<internal>" ) == std::string::npos );
+    BOOST_CHECK( !MetaProperty::fromXMLDeserialize( xml ).isInternal() );
+}
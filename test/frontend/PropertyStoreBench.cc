@@ -0,0 +1,127 @@
+/* Benchmark of the frontend property handling: full property list against the bounded store.
+ *
+ * The list variant does what the frontend did before the property store: keep every property,
+ * sort them all for the report and write them out at the end. Each variant runs in its own
+ * process so that the peak resident sizes can be compared.
+ *
+ * Usage: property_store_bench [properties] [report limit]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "PropertyStore.h"
+
+static MetaProperty synthetic_property( long n ) {
+    MetaProperty prop;
+    std::stringstream name;
+    name << "Synthetic property " << n % 37;
+    prop.setName( name.str() );
+    prop.setId( "42" );
+    prop.setFileName( "synthetic.f90" );
+    prop.setFileId( n % 97 );
+    prop.setStartPosition( 10 + n % 1000 );
+    prop.setConfiguration( "1024x1" );
+    prop.setSeverity( ( n * 2654435761u ) % 100000 / 1000.0 );
+    prop.setConfidence( 1.0 );
+    prop.setProcess( n % 1024 );
+    prop.setPurpose( 99 );
+    prop.addExecObj( n % 1024, 0 );
+    prop.addExtraInfo( "ExecTime", "0.001" );
+    // the execution time properties of a scalability run
+    prop.setInternal( n % 10 == 0 );
+    return prop;
+}
+
+static bool more_severe( MetaProperty p1,
+                         MetaProperty p2 ) {
+    return p1.getSeverity() > p2.getSeverity();
+}
+
+static void run_list( long        count,
+                      size_t      limit,
+                      const char* file ) {
+    std::vector<MetaProperty> properties;
+    for( long n = 0; n < count; n++ ) {
+        properties.push_back( synthetic_property( n ) );
+    }
+    std::sort( properties.begin(), properties.end(), more_severe );
+    size_t reported = 0;
+    for( size_t i = 0; i < properties.size() && reported < limit; i++ ) {
+        if( !properties[ i ].isInternal() ) {
+            reported++;
+        }
+    }
+    std::ofstream out( file );
+    out << "<Experiment>\n";
+    for( size_t i = 0; i < properties.size(); i++ ) {
+        if( !properties[ i ].isInternal() ) {
+            out << properties[ i ].toXML();
+        }
+    }
+    out << "</Experiment>\n";
+}
+
+static void run_store( long        count,
+                       size_t      limit,
+                       const char* file ) {
+    PropertyStore store;
+    store.setReportLimit( limit );
+    store.spillTo( file, "<Experiment>\n" );
+    for( long n = 0; n < count; n++ ) {
+        MetaProperty prop = synthetic_property( n );
+        store.add( prop );
+    }
+    std::vector<MetaProperty> top = store.top();
+    store.finish( "</Experiment>\n" );
+}
+
+static void measure( const char* label,
+                     void ( *variant )( long, size_t, const char* ),
+                     long        count,
+                     size_t      limit ) {
+    char file[] = "/tmp/psc_property_bench_XXXXXX";
+    int  fd     = mkstemp( file );
+    if( fd < 0 ) {
+        perror( "mkstemp" );
+        exit( 1 );
+    }
+    close( fd );
+
+    struct timeval start, end;
+    gettimeofday( &start, NULL );
+    pid_t child = fork();
+    if( child == 0 ) {
+        variant( count, limit, file );
+        _exit( 0 );
+    }
+    int           status;
+    struct rusage usage;
+    wait4( child, &status, 0, &usage );
+    gettimeofday( &end, NULL );
+
+    std::ifstream in( file, std::ios::binary | std::ios::ate );
+    printf( "%-6s %ld properties: %8.3f s, peak RSS %8ld KiB, output %ld bytes\n", label, count,
+            ( end.tv_sec - start.tv_sec ) + ( end.tv_usec - start.tv_usec ) / 1e6, usage.ru_maxrss,
+            ( long )in.tellg() );
+    unlink( file );
+}
+
+int main( int   argc,
+          char* argv[] ) {
+    long   count = argc > 1 ? atol( argv[ 1 ] ) : 1000000;
+    size_t limit = argc > 2 ? atol( argv[ 2 ] ) : 50;
+
+    measure( "list", run_list, count, limit );
+    measure( "store", run_store, count, limit );
+    return 0;
+}
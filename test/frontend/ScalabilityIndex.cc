@@ -0,0 +1,175 @@
+#define BOOST_TEST_MODULE ScalabilityIndex
+
+#include <boost/test/included/unit_test.hpp>
+#include <cstdlib>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ScalabilityIndex.h"
+
+// the fields of PropertyInfo the scalability analysis matches on
+struct Prop {
+    std::string name;
+    std::string ID;
+    std::string region;
+    double      process;
+    double      RFL;
+    int         fileid;
+    int         maxThreads;
+    long double execTime;
+};
+
+static ScalabilityKey key( const Prop& p ) {
+    return ScalabilityKey( p.name, p.process, p.RFL, p.fileid );
+}
+
+// a recorded property set: runs with 1, 2, 4 and 8 threads, properties missing in some runs and
+// duplicates that differ only in ID or region
+static std::vector<Prop> recorded_properties() {
+    const char* names[]   = { "LoadImbalance", "ImbalanceInParallelLoop", "exectime:::::", "CriticalSection" };
+    const char* regions[] = { "PARALLEL_REGION", "DO_REGION", "USER_REGION" };
+    std::vector<Prop> props;
+    srand( 7 );
+    for( int threads = 1; threads <= 8; threads *= 2 ) {
+        for( int i = 0; i < 400; i++ ) {
+            if( rand() % 5 == 0 ) {
+                continue;
+            }
+            Prop p;
+            p.name       = names[ i % 4 ];
+            p.region     = regions[ ( i / 4 ) % 3 ];
+            p.process    = i % 3;
+            p.RFL        = 10 + ( i / 12 ) % 20;
+            p.fileid     = 1 + ( i / 240 );
+            p.maxThreads = threads;
+            p.execTime   = 1000.0 * ( 1 + rand() % 100 ) / threads;
+            std::stringstream id;
+            id << ( rand() % 3 );
+            p.ID = id.str();
+            props.push_back( p );
+        }
+    }
+    return props;
+}
+
+BOOST_AUTO_TEST_CASE( first_match_from_position ) {
+    std::vector<Prop> props = recorded_properties();
+    ScalabilityIndex  index;
+    for( size_t i = 0; i < props.size(); i++ ) {
+        BOOST_REQUIRE_EQUAL( index.add( key( props[ i ] ), props[ i ].maxThreads ), i );
+    }
+    BOOST_CHECK_EQUAL( index.size(), props.size() );
+
+    // the nested scan of PeriscopeFrontend::find_existing_properties
+    for( size_t i = 0; i < props.size(); i += 3 ) {
+        for( int threads = 1; threads <= 8; threads *= 2 ) {
+            size_t expected = ScalabilityIndex::npos;
+            for( size_t j = i; j < props.size(); j++ ) {
+                if( props[ j ].name == props[ i ].name && props[ j ].process == props[ i ].process &&
+                    props[ j ].RFL == props[ i ].RFL && props[ j ].fileid == props[ i ].fileid &&
+                    props[ j ].maxThreads == threads ) {
+                    expected = j;
+                    break;
+                }
+            }
+            BOOST_CHECK_EQUAL( index.find( key( props[ i ] ), threads, i ), expected );
+        }
+    }
+
+    Prop missing = props[ 0 ];
+    missing.RFL = -1;
+    BOOST_CHECK_EQUAL( index.find( key( missing ), 2 ), ScalabilityIndex::npos );
+    BOOST_CHECK( index.positions( key( missing ) ).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( matches_with_id_and_region ) {
+    std::vector<Prop> props = recorded_properties();
+    ScalabilityIndex  index;
+    for( size_t i = 0; i < props.size(); i++ ) {
+        index.add( key( props[ i ] ), props[ i ].maxThreads );
+    }
+
+    for( size_t i = 0; i < props.size(); i++ ) {
+        // the scan of PeriscopeFrontend::find_sequential_time: any thread count, same region and ID
+        long double expected = 0.0;
+        for( size_t j = 0; j < props.size(); j++ ) {
+            if( props[ j ].region == props[ i ].region && props[ j ].process == props[ i ].process &&
+                props[ j ].RFL == props[ i ].RFL && props[ j ].fileid == props[ i ].fileid &&
+                props[ j ].ID == props[ i ].ID && props[ j ].name == props[ i ].name ) {
+                expected = props[ j ].execTime;
+                break;
+            }
+        }
+        long double                found     = 0.0;
+        const std::vector<size_t>& positions = index.positions( key( props[ i ] ) );
+        for( size_t p = 0; p < positions.size(); p++ ) {
+            if( props[ positions[ p ] ].region == props[ i ].region && props[ positions[ p ] ].ID == props[ i ].ID ) {
+                found = props[ positions[ p ] ].execTime;
+                break;
+            }
+        }
+        BOOST_CHECK_EQUAL( found, expected );
+
+        // the scan of PeriscopeFrontend::do_speedup_analysis: one thread count, same ID
+        for( int threads = 2; threads <= 8; threads *= 2 ) {
+            size_t expected_position = ScalabilityIndex::npos;
+            for( size_t j = 0; j < props.size(); j++ ) {
+                if( props[ j ].process == props[ i ].process && props[ j ].fileid == props[ i ].fileid &&
+                    props[ j ].RFL == props[ i ].RFL && props[ j ].maxThreads == threads &&
+                    props[ j ].name == props[ i ].name && props[ j ].ID == props[ i ].ID ) {
+                    expected_position = j;
+                    break;
+                }
+            }
+            size_t                     found_position = ScalabilityIndex::npos;
+            const std::vector<size_t>& series         = index.positions( key( props[ i ] ), threads );
+            for( size_t p = 0; p < series.size(); p++ ) {
+                if( props[ series[ p ] ].ID == props[ i ].ID ) {
+                    found_position = series[ p ];
+                    break;
+                }
+            }
+            BOOST_CHECK_EQUAL( found_position, expected_position );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( negative_zero_hashes_like_zero ) {
+    ScalabilityIndex index;
+    index.add( ScalabilityKey( "p", 0.0, 0.0, 1 ), 2 );
+    BOOST_CHECK_EQUAL( index.find( ScalabilityKey( "p", -0.0, -0.0, 1 ), 2 ), 0u );
+}
+
+BOOST_AUTO_TEST_CASE( speedup_point ) {
+    const long double seq_times[]  = { 1000.0, 3.0e9, 7.0, 123456.789 };
+    const long double exec_times[] = { 250.0, 1.7e9, 2.0, 400000.0, 333.3333 };
+    for( int s = 0; s < 4; s++ ) {
+        for( int e = 0; e < 5; e++ ) {
+            for( int threads = 2; threads <= 16; threads *= 2 ) {
+                // the computation PeriscopeFrontend::do_speedup_analysis did inline
+                double speedup_prop    = ( long double )seq_times[ s ] / ( double )exec_times[ e ];
+                int    rounded_speedup = speedup_prop;
+                double decimal_val     = ( double )speedup_prop - rounded_speedup;
+                if( decimal_val > 0.5 ) {
+                    rounded_speedup++;
+                }
+                long double deviation = 0.0;
+                if( exec_times[ e ] - ( seq_times[ s ] / threads ) > 0 ) {
+                    deviation = exec_times[ e ] - ( seq_times[ s ] / threads );
+                }
+
+                ScalabilityPoint point = scalability_point( seq_times[ s ], exec_times[ e ], threads );
+                BOOST_CHECK_EQUAL( point.threads, threads );
+                BOOST_CHECK_EQUAL( point.speedup, speedup_prop );
+                BOOST_CHECK_EQUAL( point.roundedSpeedup, rounded_speedup );
+                BOOST_CHECK_EQUAL( point.deviation, deviation );
+                BOOST_CHECK_EQUAL( point.efficiency, speedup_prop / threads );
+            }
+        }
+    }
+    // halves round down
+    BOOST_CHECK_EQUAL( scalability_point( 5.0, 2.0, 2 ).roundedSpeedup, 2 );
+    BOOST_CHECK_EQUAL( scalability_point( 5.2, 2.0, 2 ).roundedSpeedup, 3 );
+}
@@ -0,0 +1,190 @@
+#define BOOST_TEST_MODULE ScenarioRace
+
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ScenarioRace.h"
+
+// measurement noise of one phase iteration around the true objective of a scenario
+struct Noise {
+    std::string                                       name;
+    std::function<double( std::mt19937&, double )> sample;
+};
+
+static std::vector<Noise> noise_models( double cv ) {
+    std::vector<Noise> models;
+    models.push_back( { "normal", [ cv ]( std::mt19937& g, double mean ) {
+                            return std::normal_distribution<double>( mean, cv * mean )( g );
+                        } } );
+    models.push_back( { "lognormal", [ cv ]( std::mt19937& g, double mean ) {
+                            double sigma = std::sqrt( std::log( 1.0 + cv * cv ) );
+                            return mean * std::lognormal_distribution<double>( -sigma * sigma / 2.0, sigma )( g );
+                        } } );
+    models.push_back( { "uniform", [ cv ]( std::mt19937& g, double mean ) {
+                            double width = cv * mean * std::sqrt( 3.0 );
+                            return std::uniform_real_distribution<double>( mean - width, mean + width )( g );
+                        } } );
+    // mostly quiet with occasional interference from other jobs on the node
+    models.push_back( { "outliers", [ cv ]( std::mt19937& g, double mean ) {
+                            double value = std::normal_distribution<double>( mean, cv * mean / 2.0 )( g );
+                            return std::uniform_real_distribution<double>( 0.0, 1.0 )( g ) < 0.05 ? value * ( 1.0 + 6.0 * cv ) : value;
+                        } } );
+    return models;
+}
+
+// true objectives of the scenarios of an experiment, the first one is the best
+static const std::vector<double> objectives = { 100.0, 101.0, 104.0, 108.0, 115.0, 130.0, 160.0, 200.0 };
+
+struct Outcome {
+    double chosen;  // true objective of the chosen scenario
+    int    samples; // phase iterations spent on all scenarios
+};
+
+static Outcome simulate_race( const ScenarioRaceOptions& options,
+                              const Noise&               noise,
+                              std::mt19937&              g ) {
+    ScenarioRace race( options );
+    for( size_t s = 0; s < objectives.size(); s++ ) {
+        race.enter( s );
+    }
+    while( !race.finished() ) {
+        for( int s : race.scenarios_to_run() ) {
+            race.add_sample( s, noise.sample( g, objectives[ s ] ) );
+        }
+    }
+    return { objectives[ race.leader() ], race.samples() };
+}
+
+// the current practice: every scenario for a fixed number of iterations, the lowest mean wins
+static Outcome simulate_fixed( int           iterations,
+                               const Noise&  noise,
+                               std::mt19937& g ) {
+    size_t best      = 0;
+    double best_mean = 0.0;
+    for( size_t s = 0; s < objectives.size(); s++ ) {
+        double sum = 0.0;
+        for( int i = 0; i < iterations; i++ ) {
+            sum += noise.sample( g, objectives[ s ] );
+        }
+        if( s == 0 || sum / iterations < best_mean ) {
+            best      = s;
+            best_mean = sum / iterations;
+        }
+    }
+    return { objectives[ best ], iterations * ( int )objectives.size() };
+}
+
+
+BOOST_AUTO_TEST_CASE( t_quantiles ) {
+    BOOST_CHECK_CLOSE( student_t_quantile( 0.975, 1 ), 12.7062, 0.01 );
+    BOOST_CHECK_CLOSE( student_t_quantile( 0.975, 4 ), 2.7764, 0.01 );
+    BOOST_CHECK_CLOSE( student_t_quantile( 0.95, 10 ), 1.8125, 0.01 );
+    BOOST_CHECK_CLOSE( student_t_quantile( 0.975, 30 ), 2.0423, 0.01 );
+    BOOST_CHECK_CLOSE( student_t_quantile( 0.025, 4 ), -2.7764, 0.01 );
+    BOOST_CHECK_THROW( student_t_quantile( 1.0, 4 ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE( statistics ) {
+    ScenarioRace race;
+    race.enter( 7 );
+    BOOST_CHECK_EQUAL( race.leader(), -1 );
+    race.add_sample( 7, 10.0 );
+    BOOST_CHECK( std::isinf( race.statistics( 7 ).halfWidth ) );
+    race.add_sample( 7, 12.0 );
+    race.add_sample( 7, 14.0 );
+
+    ScenarioStatistics s = race.statistics( 7 );
+    BOOST_CHECK_EQUAL( s.samples, 3 );
+    BOOST_CHECK_CLOSE( s.mean, 12.0, 1e-9 );
+    BOOST_CHECK_CLOSE( s.deviation, 2.0, 1e-9 );
+    BOOST_CHECK_CLOSE( s.halfWidth, 4.3027 * 2.0 / std::sqrt( 3.0 ), 0.01 );
+    BOOST_CHECK_EQUAL( race.median_sample( 7 ), 1 );
+
+    BOOST_CHECK_THROW( race.add_sample( 8, 1.0 ), std::out_of_range );
+    ScenarioRaceOptions invalid;
+    invalid.confidence = 1.0;
+    BOOST_CHECK_THROW( ScenarioRace race( invalid ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE( noise_free_races_stop_early ) {
+    ScenarioRaceOptions options;
+    ScenarioRace        race( options );
+    for( size_t s = 0; s < objectives.size(); s++ ) {
+        race.enter( s );
+    }
+    int iterations = 0;
+    while( !race.finished() ) {
+        for( int s : race.scenarios_to_run() ) {
+            race.add_sample( s, objectives[ s ] );
+        }
+        iterations++;
+    }
+    BOOST_CHECK_EQUAL( iterations, options.minIterations );
+    BOOST_CHECK_EQUAL( race.leader(), 0 );
+    for( size_t s = 1; s < objectives.size(); s++ ) {
+        BOOST_CHECK( race.eliminated( s ) );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( dominated_scenarios_are_dropped ) {
+    // the clearly inferior scenarios only get the minimum number of iterations
+    std::mt19937        g( 1 );
+    ScenarioRaceOptions options;
+    ScenarioRace        race( options );
+    for( size_t s = 0; s < objectives.size(); s++ ) {
+        race.enter( s );
+    }
+    while( !race.finished() ) {
+        for( int s : race.scenarios_to_run() ) {
+            race.add_sample( s, noise_models( 0.02 )[ 0 ].sample( g, objectives[ s ] ) );
+        }
+    }
+    for( size_t s = 5; s < objectives.size(); s++ ) {
+        BOOST_CHECK( race.eliminated( s ) );
+        BOOST_CHECK_EQUAL( race.statistics( s ).samples, options.minIterations );
+    }
+    BOOST_CHECK( !race.eliminated( race.leader() ) );
+    BOOST_CHECK_GT( race.statistics( race.leader() ).samples, options.minIterations );
+}
+
+
+BOOST_AUTO_TEST_CASE( racing_on_noisy_nodes ) {
+    const int           trials = 300;
+    ScenarioRaceOptions options;
+    options.maxIterations = 20;
+
+    for( double cv : { 0.02, 0.05 } ) {
+        for( const Noise& noise : noise_models( cv ) ) {
+            std::mt19937 g( 42 );
+            int          race_good = 0, short_good = 0, long_good = 0;
+            double       race_samples = 0.0, long_samples = 0.0;
+            for( int t = 0; t < trials; t++ ) {
+                Outcome raced = simulate_race( options, noise, g );
+                Outcome brief = simulate_fixed( options.minIterations, noise, g );
+                Outcome full  = simulate_fixed( options.maxIterations, noise, g );
+                race_good    += raced.chosen <= objectives[ 0 ] * 1.02;
+                short_good   += brief.chosen <= objectives[ 0 ] * 1.02;
+                long_good    += full.chosen <= objectives[ 0 ] * 1.02;
+                race_samples += raced.samples;
+                long_samples += full.samples;
+            }
+            BOOST_TEST_MESSAGE( noise.name << " noise, cv " << cv << ": within 2% of the optimum in "
+                                           << race_good << " races, " << short_good << " short and " << long_good
+                                           << " long fixed runs; " << race_samples / trials << " against "
+                                           << long_samples / trials << " iterations" );
+
+            // as reliable as long fixed runs at a fraction of their iterations, more reliable than short ones
+            BOOST_CHECK_GE( race_good, trials * 95 / 100 );
+            BOOST_CHECK_GE( race_good, short_good );
+            BOOST_CHECK_LE( race_samples, 0.6 * long_samples );
+        }
+    }
+}
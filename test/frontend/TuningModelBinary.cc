@@ -0,0 +1,161 @@
+#define BOOST_TEST_MODULE TuningModelBinary
+
+#include <boost/test/included/unit_test.hpp>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "binary_model.h"
+#include "serialization.h"
+
+using namespace std;
+
+/* A model of two phases regions, one with two RTSs below the same call site, and two scenarios */
+static tmg::model_document synthetic_document() {
+    tmg::model_document document;
+
+    document.clusters.push_back( { 0, { 1, 3, 7 }, { { "iterations", 10.0, 20.5 } } } );
+    document.clusters.push_back( { -1, {}, {} } );
+
+    document.iids.push_back( { 11, { { "string", "input", "small" }, { "uint", "Thread", "24" } } } );
+    document.iids.push_back( { 12, { { "int", "offset", "-3" } } } );
+
+    document.regions.push_back( { 102, "solver.c", 42, "solve" } );
+    document.regions.push_back( { 101, "main.c", 7, "phase" } );
+
+    vector< tmg::document_callpath_element > path = {
+        { "main.c", 7, "phase", { { "uint", "iteration", "1" } } },
+        { "solver.c", 40, "loop", {} }
+    };
+    tmg::document_rts rts = { 102, 202, 0.125, 11, path };
+    document.rtss.push_back( rts );
+    rts.callpath.push_back( { "solver.c", 41, "inner", { { "uint", "Thread", "24" } } } );
+    rts.scenario = 201;
+    rts.exectime = 1.0 / 3.0;
+    rts.iid      = 12;
+    document.rtss.push_back( rts );
+    document.rtss.push_back( { 101, 201, 2.5, 11, {} } );
+
+    document.scenarios.push_back( { 202, { { "CORE_FREQ", 1200, 100, 2500, 2000 }, { "UNCORE_FREQ", 1300, 100, 3000, 1500 } } } );
+    document.scenarios.push_back( { 201, { { "CORE_FREQ", 1200, 100, 2500, 2400 } } } );
+    return document;
+}
+
+static bool rejected( const string& bytes ) {
+    try {
+        tmg::binary_model model( bytes.data(), bytes.size() );
+    } catch( const tmg::exception& ) {
+        return true;
+    }
+    return false;
+}
+
+
+BOOST_AUTO_TEST_CASE( binary_round_trip ) {
+    tmg::model_document document = synthetic_document();
+    string              bytes    = tmg::encode_binary( document );
+
+    tmg::binary_model model( bytes.data(), bytes.size() );
+    BOOST_CHECK( model.document() == document );
+    BOOST_CHECK( tmg::encode_binary( model.document() ) == bytes );
+
+    tmg::model_document empty;
+    string              emptyBytes = tmg::encode_binary( empty );
+    BOOST_CHECK( tmg::binary_model( emptyBytes.data(), emptyBytes.size() ).document() == empty );
+}
+
+
+BOOST_AUTO_TEST_CASE( json_round_trip ) {
+    tmg::model_document document = synthetic_document();
+    string              json     = tmg::serialize( document );
+
+    istringstream jsonStream( json );
+    BOOST_CHECK( !tmg::is_binary_model( jsonStream ) );
+    tmg::model_document fromJson = tmg::deserialize_document( jsonStream );
+    BOOST_CHECK( fromJson == document );
+
+    istringstream binaryStream( tmg::encode_binary( fromJson ) );
+    BOOST_CHECK( tmg::is_binary_model( binaryStream ) );
+    BOOST_CHECK_EQUAL( tmg::serialize( tmg::deserialize_document( binaryStream ) ), json );
+}
+
+
+BOOST_AUTO_TEST_CASE( queries_in_place ) {
+    string            bytes = tmg::encode_binary( synthetic_document() );
+    tmg::binary_model model( bytes.data(), bytes.size() );
+
+    BOOST_REQUIRE( model.find_region( 101 ) != NULL );
+    BOOST_CHECK_EQUAL( model.string( model.find_region( 101 )->name ), "phase" );
+    BOOST_CHECK( model.find_region( 103 ) == NULL );
+
+    vector< const tmg::binary::rts* > rtss = model.rtss_of_region( 102 );
+    BOOST_REQUIRE_EQUAL( rtss.size(), 2u );
+    BOOST_CHECK( model.rtss_of_region( 100 ).empty() );
+
+    vector< const tmg::binary::callpath_element* > path = model.callpath( *rtss[ 1 ] );
+    BOOST_REQUIRE_EQUAL( path.size(), 3u );
+    BOOST_CHECK_EQUAL( model.string( path[ 0 ]->name ), "phase" );
+    BOOST_CHECK_EQUAL( model.string( path[ 2 ]->name ), "inner" );
+    // both RTSs share the nodes of the first two elements
+    BOOST_CHECK( model.callpath( *rtss[ 0 ] )[ 1 ] == path[ 1 ] );
+
+    const tmg::binary::scenario* scenario = model.find_scenario( rtss[ 0 ]->scenario );
+    BOOST_REQUIRE( scenario != NULL );
+    vector< pair< const char*, int > > configuration = model.configuration( *scenario );
+    BOOST_REQUIRE_EQUAL( configuration.size(), 2u );
+    BOOST_CHECK_EQUAL( configuration[ 0 ].first, "CORE_FREQ" );
+    BOOST_CHECK_EQUAL( configuration[ 0 ].second, 2000 );
+    BOOST_CHECK( model.find_scenario( 203 ) == NULL );
+}
+
+
+BOOST_AUTO_TEST_CASE( mapped_file ) {
+    char path[] = "/tmp/tuning_model_XXXXXX";
+    int  fd     = mkstemp( path );
+    BOOST_REQUIRE( fd >= 0 );
+    close( fd );
+
+    string bytes = tmg::encode_binary( synthetic_document() );
+    ofstream( path, ios::binary ) << bytes;
+
+    unique_ptr< tmg::binary_model > model = tmg::binary_model::open( path );
+    BOOST_CHECK( model->document() == synthetic_document() );
+    BOOST_CHECK_EQUAL( tmg::make_scenarios( model->document(), tmg::random_selector ).size(), 2u );
+
+    ifstream stream( path, ios::binary );
+    BOOST_CHECK( tmg::deserialize_document( stream ) == synthetic_document() );
+    unlink( path );
+
+    BOOST_CHECK_THROW( tmg::binary_model::open( path ), tmg::exception );
+}
+
+
+BOOST_AUTO_TEST_CASE( rejects_invalid_models ) {
+    string bytes = tmg::encode_binary( synthetic_document() );
+    BOOST_CHECK( !rejected( bytes ) );
+
+    // every flipped byte is caught by a checksum or the header checks
+    for( size_t n = 0; n < bytes.size(); n += 7 ) {
+        string corrupt = bytes;
+        corrupt[ n ] ^= 0x10;
+        BOOST_CHECK_MESSAGE( rejected( corrupt ), "byte " << n );
+    }
+
+    BOOST_CHECK( rejected( bytes.substr( 0, bytes.size() - 8 ) ) );
+    BOOST_CHECK( rejected( bytes.substr( 0, 16 ) ) );
+    BOOST_CHECK( rejected( "" ) );
+
+    string newer = bytes;
+    newer[ offsetof( tmg::binary::header, version ) ] = tmg::binary::version + 1;
+    BOOST_CHECK( rejected( newer ) );
+
+    // a reference to an unknown scenario is found even with valid checksums
+    tmg::model_document dangling = synthetic_document();
+    dangling.rtss[ 0 ].scenario = 999;
+    BOOST_CHECK( rejected( tmg::encode_binary( dangling ) ) );
+}
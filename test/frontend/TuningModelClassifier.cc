@@ -0,0 +1,155 @@
+#define BOOST_TEST_MODULE TuningModelClassifier
+
+#include <boost/test/included/unit_test.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "binary_model.h"
+#include "classifier.h"
+
+using namespace std;
+
+static const vector< unsigned > threads = { 1, 2, 4, 8, 16, 32 };
+static const vector< unsigned > sizes   = { 100, 200, 300, 400, 500, 600, 700, 800, 900, 1000, 1100, 1200 };
+static const vector< string >   inputs  = { "small", "large", "sparse" };
+
+/* The best scenarios of the two regions of the synthetic application */
+static uint64_t solver_oracle( unsigned t, unsigned size, const string& input ) {
+    if( input == "sparse" ) {
+        return 4;
+    }
+    if( t <= 4 ) {
+        return size <= 600 ? 1 : 2;
+    }
+    return size <= 900 ? 3 : 2;
+}
+
+static uint64_t io_oracle( unsigned t, unsigned, const string& ) {
+    return t >= 8 ? 5 : 6;
+}
+
+static vector< tmg::document_identifier > identifiers( unsigned t, unsigned size, const string& input ) {
+    return { { "uint", "Thread", to_string( t ) }, { "string", "Process", "64" },
+             { "string", "size", to_string( size ) }, { "string", "input", input } };
+}
+
+/* Calls f for every point of the identifier grid, with whether it is in the training half */
+static void grid( function< void( unsigned, unsigned, const string&, bool ) > f ) {
+    for( size_t t = 0; t < threads.size(); t++ ) {
+        for( size_t s = 0; s < sizes.size(); s++ ) {
+            for( size_t i = 0; i < inputs.size(); i++ ) {
+                f( threads[ t ], sizes[ s ], inputs[ i ], ( t + s + i ) % 2 == 0 );
+            }
+        }
+    }
+}
+
+/* The RTSs of both regions for the training half of the grid, each with the oracle's scenario */
+static tmg::model_document training_document() {
+    tmg::model_document document;
+    document.regions.push_back( { 10, "solver.c", 42, "solve" } );
+    document.regions.push_back( { 20, "io.c", 7, "write" } );
+    for( uint64_t s = 1; s <= 6; s++ ) {
+        document.scenarios.push_back( { s, { { "CORE_FREQ", 1200, 100, 2500, ( int )( 1200 + 100 * s ) } } } );
+    }
+
+    uint64_t iid = 100;
+    grid( [ & ]( unsigned t, unsigned size, const string& input, bool training ) {
+        if( !training ) {
+            return;
+        }
+        document.iids.push_back( { iid, identifiers( t, size, input ) } );
+        document.rtss.push_back( { 10, solver_oracle( t, size, input ), 1.0, iid, {} } );
+        document.rtss.push_back( { 20, io_oracle( t, size, input ), 1.0, iid, {} } );
+        iid++;
+    } );
+    return document;
+}
+
+static size_t depth( const tmg::document_classifier& classifier, uint32_t node = 0 ) {
+    const auto& n = classifier.nodes[ node ];
+    if( n.feature.empty() ) {
+        return 0;
+    }
+    return 1 + max( depth( classifier, n.pass ), depth( classifier, n.fail ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( accuracy_on_unseen_inputs ) {
+    tmg::model_document document = training_document();
+    document.classifiers = tmg::train_classifiers( document );
+    BOOST_REQUIRE_EQUAL( document.classifiers.size(), 2u );
+    BOOST_CHECK( tmg::train_classifiers( document ) == document.classifiers );
+
+    tmg::input_classifier classifier( document.classifiers );
+    size_t seen = 0, seen_correct = 0, unseen = 0, unseen_correct = 0;
+    grid( [ & ]( unsigned t, unsigned size, const string& input, bool training ) {
+        auto ids     = identifiers( t, size, input );
+        bool correct = classifier.classify( 10, ids ) == solver_oracle( t, size, input )
+                       && classifier.classify( 20, ids ) == io_oracle( t, size, input );
+        ( training ? seen : unseen )++;
+        ( training ? seen_correct : unseen_correct ) += correct;
+    } );
+
+    // matching identical input identifiers, the scenarios cover none of the unseen inputs
+    BOOST_TEST_MESSAGE( "accuracy on unseen inputs: " << unseen_correct << "/" << unseen );
+    BOOST_CHECK_EQUAL( seen_correct, seen );
+    BOOST_CHECK_GE( unseen_correct, unseen * 9 / 10 );
+
+    for( const auto& c : document.classifiers ) {
+        BOOST_CHECK_LE( depth( c ), tmg::classifier_max_depth );
+    }
+    BOOST_CHECK_EQUAL( classifier.classify( 30, identifiers( 1, 100, "small" ) ), 0u );
+}
+
+
+BOOST_AUTO_TEST_CASE( partial_identifiers ) {
+    tmg::model_document document = training_document();
+    tmg::input_classifier classifier( tmg::train_classifiers( document ) );
+
+    // unknown categories fail their tests, the scenario of a region without inputs is the most frequent one
+    BOOST_CHECK_EQUAL( classifier.classify( 10, identifiers( 2, 300, "dense" ) ), 1u );
+    BOOST_CHECK_EQUAL( classifier.classify( 20, {} ), 5u );
+    BOOST_CHECK_EQUAL( classifier.classify( 20, { { "uint", "Thread", "64" } } ), 5u );
+    BOOST_CHECK_EQUAL( classifier.classify( 20, { { "uint", "Thread", "3" } } ), 6u );
+}
+
+
+BOOST_AUTO_TEST_CASE( limited_depth ) {
+    tmg::model_document document = training_document();
+    auto                stumps   = tmg::train_classifiers( document, 1 );
+    for( const auto& c : stumps ) {
+        BOOST_CHECK_LE( depth( c ), 1u );
+    }
+    // a single test separates the I/O region
+    BOOST_CHECK_EQUAL( tmg::classify( stumps[ 1 ], identifiers( 32, 100, "small" ) ), 5u );
+    BOOST_CHECK_EQUAL( tmg::classify( stumps[ 1 ], identifiers( 1, 100, "small" ) ), 6u );
+}
+
+
+BOOST_AUTO_TEST_CASE( binary_model_classification ) {
+    tmg::model_document document = training_document();
+    document.classifiers = tmg::train_classifiers( document );
+
+    string            bytes = tmg::encode_binary( document );
+    tmg::binary_model model( bytes.data(), bytes.size() );
+    BOOST_CHECK( model.document() == document );
+    BOOST_CHECK( model.find_classifier( 30 ) == NULL );
+
+    const tmg::binary::classifier* solver = model.find_classifier( 10 );
+    const tmg::binary::classifier* io     = model.find_classifier( 20 );
+    BOOST_REQUIRE( solver != NULL && io != NULL );
+    grid( [ & ]( unsigned t, unsigned size, const string& input, bool ) {
+        auto ids = identifiers( t, size, input );
+        BOOST_CHECK_EQUAL( model.classify( *solver, ids ), tmg::classify( document.classifiers[ 0 ], ids ) );
+        BOOST_CHECK_EQUAL( model.classify( *io, ids ), tmg::classify( document.classifiers[ 1 ], ids ) );
+    } );
+
+    // a decision may only lead to a later one, so every classification terminates
+    tmg::model_document cyclic = document;
+    cyclic.classifiers[ 0 ].nodes[ 1 ].pass = 0;
+    cyclic.classifiers[ 0 ].nodes[ 1 ].feature = "Thread";
+    string cyclicBytes = tmg::encode_binary( cyclic );
+    BOOST_CHECK_THROW( tmg::binary_model( cyclicBytes.data(), cyclicBytes.size() ), tmg::exception );
+}
@@ -0,0 +1,122 @@
+/* Benchmark of loading a tuning model: JSON against the binary format.
+ *
+ * A synthetic model with many RTSs is written in both formats. The JSON model is loaded the way
+ * the tuning model consumers did so far, into the scenarios. The binary model is loaded into the
+ * scenarios as well, and opened and queried in place, which is what a runtime needs at start.
+ *
+ * Usage: tuning_model_load_bench [RTSs] [repetitions]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "binary_model.h"
+#include "serialization.h"
+
+static tmg::model_document synthetic_model( long rtss ) {
+    const long          regions = 200, scenarios = 16, depth = 6;
+    tmg::model_document document;
+
+    for( long s = 0; s < scenarios; s++ ) {
+        document.scenarios.push_back( { ( uint64_t )( 1000000 + s ), {
+            { "CORE_FREQ", 1200, 100, 2500, ( int )( 1200 + 100 * ( s % 14 ) ) },
+            { "UNCORE_FREQ", 1300, 100, 3000, ( int )( 1300 + 100 * ( s % 18 ) ) },
+            { "NUM_THREADS", 1, 1, 24, ( int )( 1 + s % 24 ) } } } );
+    }
+    for( long r = 0; r < regions; r++ ) {
+        std::stringstream name;
+        name << "solver_kernel_" << r;
+        document.regions.push_back( { ( uint64_t )( 2000000 + r ), "/home/user/application/src/solver/kernels.f90",
+                                      ( size_t )( 100 + 10 * r ), name.str() } );
+    }
+    document.iids.push_back( { 3000000, { { "uint", "Thread", "24" }, { "uint", "Process", "64" },
+                                          { "string", "input", "production_case.nml" } } } );
+
+    for( long n = 0; n < rtss; n++ ) {
+        tmg::document_rts rts;
+        rts.region   = 2000000 + n % regions;
+        rts.scenario = 1000000 + ( n * 7 ) % scenarios;
+        rts.exectime = 0.001 * ( n % 977 );
+        rts.iid      = 3000000;
+        rts.callpath.push_back( { "/home/user/application/src/main.f90", 12, "main", {} } );
+        rts.callpath.push_back( { "/home/user/application/src/main.f90", 40, "time_loop",
+                                  { { "uint", "iteration", std::to_string( n % 50 ) } } } );
+        for( long d = 2; d < depth; d++ ) {
+            std::stringstream name;
+            name << "solver_kernel_" << ( n + d ) % regions;
+            rts.callpath.push_back( { "/home/user/application/src/solver/kernels.f90", ( size_t )( 100 + 10 * ( ( n + d ) % regions ) ),
+                                      name.str(), {} } );
+        }
+        document.rtss.push_back( rts );
+    }
+    return document;
+}
+
+static double seconds() {
+    struct timeval now;
+    gettimeofday( &now, NULL );
+    return now.tv_sec + now.tv_usec / 1e6;
+}
+
+static std::string write_temporary( const std::string& content ) {
+    char file[] = "/tmp/psc_tuning_model_bench_XXXXXX";
+    int  fd     = mkstemp( file );
+    if( fd < 0 ) {
+        perror( "mkstemp" );
+        exit( 1 );
+    }
+    close( fd );
+    std::ofstream( file, std::ios::binary ) << content;
+    return file;
+}
+
+int main( int   argc,
+          char* argv[] ) {
+    long rtss        = argc > 1 ? atol( argv[ 1 ] ) : 20000;
+    int  repetitions = argc > 2 ? atoi( argv[ 2 ] ) : 5;
+
+    tmg::model_document document = synthetic_model( rtss );
+    std::string         json     = tmg::serialize( document );
+    std::string         binary   = tmg::encode_binary( document );
+    std::string         jsonFile = write_temporary( json ), binaryFile = write_temporary( binary );
+    printf( "%ld RTSs: JSON %zu bytes, binary %zu bytes\n", rtss, json.size(), binary.size() );
+
+    double start = seconds();
+    size_t found = 0;
+    for( int n = 0; n < repetitions; n++ ) {
+        std::ifstream is( jsonFile.c_str() );
+        found += tmg::make_scenarios( tmg::deserialize_document( is ), tmg::random_selector ).size();
+    }
+    double json_load = ( seconds() - start ) / repetitions;
+
+    start = seconds();
+    for( int n = 0; n < repetitions; n++ ) {
+        auto model = tmg::binary_model::open( binaryFile );
+        found += tmg::make_scenarios( model->document(), tmg::random_selector ).size();
+    }
+    double binary_load = ( seconds() - start ) / repetitions;
+
+    start = seconds();
+    for( int n = 0; n < repetitions; n++ ) {
+        auto model = tmg::binary_model::open( binaryFile );
+        for( size_t r = 0; r < model->nregions(); r++ ) {
+            for( const auto rts : model->rtss_of_region( model->region( r ).id ) ) {
+                found += model->configuration( *model->find_scenario( rts->scenario ) ).size();
+            }
+        }
+    }
+    double binary_query = ( seconds() - start ) / repetitions;
+
+    printf( "JSON into scenarios:       %9.3f ms\n", json_load * 1e3 );
+    printf( "binary into scenarios:     %9.3f ms\n", binary_load * 1e3 );
+    printf( "binary mapped and queried: %9.3f ms\n", binary_query * 1e3 );
+
+    unlink( jsonFile.c_str() );
+    unlink( binaryFile.c_str() );
+    return found == 0;
+}
@@ -0,0 +1,188 @@
+#define BOOST_TEST_MODULE TuningModelMerge
+
+#include <boost/test/included/unit_test.hpp>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "binary_model.h"
+#include "clustering/clusterer.h"
+#include "clustering/distance.h"
+#include "clustering/vector.h"
+#include "merge.h"
+#include "serialization.h"
+
+using namespace std;
+
+/* One run of a campaign: the RTSs of three regions below two call sites with the thread count as input identifier */
+static tmg::model_document run( unsigned threads, int shift = 0 ) {
+    tmg::model_document document;
+    document.iids.push_back( { 7, { { "uint", "Thread", to_string( threads ) } } } );
+    document.regions.push_back( { 1, "solver.c", 10, "solve" } );
+    document.regions.push_back( { 2, "solver.c", 50, "smooth" } );
+    document.regions.push_back( { 3, "io.c", 5, "write" } );
+
+    for( int s = 0; s < 3; s++ ) {
+        document.scenarios.push_back( { ( uint64_t )( 100 + s ), {
+            { "CORE_FREQ", 1200, 100, 3000, 1200 + 500 * s + ( int )threads * 100 },
+            { "UNCORE_FREQ", 1300, 100, 3000, 3000 - 700 * s + shift } } } );
+    }
+
+    for( uint64_t region = 1; region <= 3; region++ ) {
+        for( unsigned site = 0; site < 2; site++ ) {
+            vector< tmg::document_callpath_element > path = { { "main.c", 3, "main", {} },
+                                                              { "main.c", 20 + site, "step", { { "uint", "iteration", "1" } } } };
+            document.rtss.push_back( { region, 100 + ( region + site ) % 3, 0.5 * region + site, 7, path } );
+        }
+    }
+    return document;
+}
+
+/* A run of a single RTS, so every RTS of a campaign has its own configuration */
+static tmg::model_document single( unsigned threads, int core, int uncore ) {
+    tmg::model_document document;
+    document.iids.push_back( { 1, { { "uint", "Thread", to_string( threads ) } } } );
+    document.regions.push_back( { 2, "solver.c", 10, "solve" } );
+    document.scenarios.push_back( { 3, { { "CORE_FREQ", 1200, 100, 3000, core }, { "UNCORE_FREQ", 1300, 100, 3000, uncore } } } );
+    document.rtss.push_back( { 2, 3, 1.0, 1, {} } );
+    return document;
+}
+
+static vector< tmg::model_document > campaign() {
+    return { run( 1 ), run( 2 ), run( 4 ), run( 8 ), run( 2 ) };
+}
+
+typedef set< pair< set< string >, map< string, int > > > canonical_scenarios;
+
+/* The RTSs and configuration of every scenario, independent of pointers and hash order */
+static canonical_scenarios canonical( const tmg::scenario_set& scenarios ) {
+    canonical_scenarios result;
+    for( const auto& scnr : scenarios ) {
+        set< string > rtss;
+        for( const auto& rts : scnr->rtss() ) {
+            rtss.insert( rts->debug_string() + " " + rts->iid()->ids().debug_string() );
+        }
+        map< string, int > configuration;
+        for( const auto& tv : scnr->configuration() ) {
+            configuration[ tv.parameter()->name() ] = tv.value();
+        }
+        result.insert( { rtss, configuration } );
+    }
+    return result;
+}
+
+static tmg::model_merger merged( const vector< tmg::model_document >& documents ) {
+    tmg::model_merger merger;
+    for( const auto& document : documents ) {
+        merger.add( document );
+    }
+    return merger;
+}
+
+
+BOOST_AUTO_TEST_CASE( deduplication ) {
+    tmg::model_merger merger = merged( campaign() );
+    // five runs with four distinct thread counts of six RTSs each
+    BOOST_CHECK_EQUAL( merger.nrtss(), 24u );
+    BOOST_CHECK( merger.conflicts().empty() );
+
+    tmg::model_document document = merger.document();
+    BOOST_CHECK_EQUAL( document.regions.size(), 3u );
+    BOOST_CHECK_EQUAL( document.iids.size(), 4u );
+    BOOST_CHECK_EQUAL( document.rtss.size(), 24u );
+    BOOST_CHECK_EQUAL( tmg::make_scenarios( document, tmg::random_selector ).size(), document.scenarios.size() );
+
+    tmg::model_document dangling = run( 1 );
+    dangling.rtss[ 0 ].scenario = 999;
+    BOOST_CHECK_THROW( merger.add( dangling ), tmg::exception );
+}
+
+
+BOOST_AUTO_TEST_CASE( order_independence ) {
+    vector< tmg::model_document > documents = campaign();
+    documents.push_back( run( 4, -100 ) );
+    tmg::model_merger forward = merged( documents );
+
+    vector< tmg::model_document > reversed( documents.rbegin(), documents.rend() );
+    tmg::model_merger backward = merged( reversed );
+    BOOST_CHECK( forward.document() == backward.document() );
+    BOOST_CHECK( forward.conflicts() == backward.conflicts() );
+
+    tmg::model_merger first  = merged( { documents[ 3 ], documents[ 5 ], documents[ 0 ] } );
+    tmg::model_merger second = merged( { documents[ 4 ], documents[ 2 ], documents[ 1 ] } );
+    second.add( first );
+    BOOST_CHECK( forward.document() == second.document() );
+    BOOST_CHECK( forward.conflicts() == second.conflicts() );
+
+    vector< string > paths;
+    for( const auto& document : reversed ) {
+        char path[] = "/tmp/tuning_model_merge_XXXXXX";
+        int  fd     = mkstemp( path );
+        BOOST_REQUIRE( fd >= 0 );
+        close( fd );
+        ofstream( path, ios::binary ) << tmg::encode_binary( document );
+        paths.push_back( path );
+    }
+    for( size_t nthreads = 1; nthreads <= 4; nthreads++ ) {
+        tmg::model_merger files = tmg::merge_files( paths, nthreads );
+        BOOST_CHECK( forward.document() == files.document() );
+        BOOST_CHECK( forward.conflicts() == files.conflicts() );
+    }
+
+    paths.push_back( "/nonexistent/tuning_model.json" );
+    BOOST_CHECK_THROW( tmg::merge_files( paths, 2 ), tmg::exception );
+    for( size_t n = 0; n + 1 < paths.size(); n++ ) {
+        unlink( paths[ n ].c_str() );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( conflicts ) {
+    // a repeated run that found other configurations, faster for the first scenario
+    tmg::model_document repeated = run( 4, -100 );
+    for( auto& rts : repeated.rtss ) {
+        rts.exectime -= rts.scenario == 100 ? 0.25 : -0.25;
+    }
+    tmg::model_merger merger = merged( { run( 4 ), repeated } );
+    BOOST_CHECK_EQUAL( merger.nrtss(), 6u );
+
+    vector< tmg::merge_conflict > conflicts = merger.conflicts();
+    BOOST_REQUIRE_EQUAL( conflicts.size(), 6u );
+    size_t kept_repeated = 0;
+    for( const auto& conflict : conflicts ) {
+        BOOST_REQUIRE_EQUAL( conflict.configurations.size(), 2u );
+        kept_repeated += conflict.configurations.front()[ 1 ].value == 2900;
+    }
+    // the two RTSs of the first scenario keep the configuration of the repeated run
+    BOOST_CHECK_EQUAL( kept_repeated, 2u );
+
+    tmg::model_document document = merger.document();
+    BOOST_CHECK_EQUAL( document.scenarios.size(), 3u );
+}
+
+
+BOOST_AUTO_TEST_CASE( equals_pairwise_merge ) {
+    using namespace tmg::cluster;
+
+    auto check = []( const vector< tmg::model_document >& documents, const clusterer& c ) {
+        vector< tmg::scenario_set > scnrvector;
+        for( const auto& document : documents ) {
+            scnrvector.push_back( tmg::make_scenarios( document, tmg::random_selector ) );
+        }
+        tmg::scenario_set pairwise = tmg::merge( scnrvector, tmg::average_selector, c );
+        tmg::scenario_set streamed = merged( documents ).merge( tmg::average_selector, c );
+        BOOST_CHECK( canonical( streamed ) == canonical( pairwise ) );
+        return streamed.size();
+    };
+
+    BOOST_CHECK_EQUAL( check( campaign(), equality_clusterer() ), 12u );
+
+    // the hierarchical clusterer needs distinct configurations without ties in their distances
+    vector< tmg::model_document > distinct = { single( 1, 1200, 1300 ), single( 2, 1300, 1300 ), single( 4, 1800, 1300 ),
+                                               single( 8, 2500, 3000 ), single( 4, 1800, 1300 ) };
+    BOOST_CHECK( check( distinct, hierarchical_clusterer( euclidean_distance, centroid ) ) > 0u );
+}
@@ -0,0 +1,168 @@
+/**
+   @file    EnsembleToyPlugin.cc
+   @ingroup Frontend
+   @brief   Toy tuning plugin for the end-to-end check of ensembles
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "AutotunePlugin.h"
+#include "application.h"
+
+/**
+ * @brief Four scenarios of a made-up parameter of the phase, one scenario per experiment
+ *
+ * With one scenario per experiment, every slot of an ensemble gets an experiment of its own. The
+ * advice lists the results the frontend merged for every scenario, which ensemble_localfork.sh
+ * checks: each scenario has exactly one result, whichever instance evaluated it.
+ */
+class EnsembleToyPlugin : public IPlugin {
+public:
+    void initialize( DriverContext*   context,
+                     ScenarioPoolSet* pool_set ) {
+        psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ), "EnsembleToyPlugin: call to initialize()\n" );
+        this->context  = context;
+        this->pool_set = pool_set;
+
+        if( context->applUninstrumented() ) {
+            psc_errmsg( "EnsembleToyPlugin: ensembles require an instrumented application\n" );
+            throw 0;
+        }
+
+        int    major, minor;
+        string name, description;
+        context->loadSearchAlgorithm( "exhaustive", &major, &minor, &name, &description );
+        searchAlgorithm = context->getSearchAlgorithmInstance( "exhaustive" );
+        if( searchAlgorithm == NULL ) {
+            throw PTF_PLUGIN_ERROR( NULL_REFERENCE );
+        }
+        print_loaded_search( major, minor, name, description );
+        searchAlgorithm->initialize( context, pool_set );
+
+        Restriction* restriction = new Restriction();
+        restriction->setRegion( appl->get_phase_region() );
+        restriction->setRegionDefined( true );
+        parameter = new TuningParameter();
+        parameter->setId( 0 );
+        parameter->setName( "TOY" );
+        parameter->setPluginType( UNKOWN_PLUGIN );
+        parameter->setRuntimeActionType( TUNING_ACTION_FUNCTION_POINTER );
+        parameter->setRange( 1, 4, 1 );
+        parameter->setRestriction( restriction );
+    }
+
+    void startTuningStep( void ) {
+        variantSpace.addTuningParameter( parameter );
+        searchSpace.setVariantSpace( &variantSpace );
+        searchSpace.addRegion( appl->get_phase_region() );
+        searchAlgorithm->addSearchSpace( &searchSpace );
+    }
+
+    bool analysisRequired( StrategyRequest** strategy ) {
+        return false;
+    }
+
+    void createScenarios( void ) {
+        searchAlgorithm->createScenarios();
+    }
+
+    void prepareScenarios( void ) {
+        while( !pool_set->csp->empty() ) {
+            pool_set->psp->push( pool_set->csp->pop() );
+        }
+    }
+
+    void defineExperiment( int               numprocs,
+                           bool&             analysisRequired,
+                           StrategyRequest** strategy ) {
+        Scenario* scenario = pool_set->psp->pop();
+        scenario->getTuningSpecifications()->front()->setSingleRank( 0 );
+        scenario->setSingleTunedRegionWithPropertyRank( appl->get_phase_region(), EXECTIME, 0 );
+        pool_set->esp->push( scenario );
+        psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( AutotunePlugins ), "EnsembleToyPlugin: experiment of scenario %d\n", scenario->getID() );
+        analysisRequired = false;
+    }
+
+    bool restartRequired( std::string& env,
+                          int&         numprocs,
+                          std::string& command,
+                          bool&        is_instrumented ) {
+        return false;
+    }
+
+    bool searchFinished( void ) {
+        return searchAlgorithm->searchFinished();
+    }
+
+    void finishTuningStep( void ) {
+    }
+
+    bool tuningFinished( void ) {
+        return true;
+    }
+
+    Advice* getAdvice( void ) {
+        cout << "All Results:\n";
+        cout << "Scenario  |  Severity\n";
+        for( int scenario_id = 0; scenario_id < pool_set->fsp->size(); scenario_id++ ) {
+            list<MetaProperty> properties = pool_set->srp->getScenarioResultsByID( scenario_id );
+            printf( "%-10d|", scenario_id );
+            for( list<MetaProperty>::iterator it = properties.begin(); it != properties.end(); ++it ) {
+                printf( "\t%f", it->getSeverity() );
+            }
+            printf( "\n" );
+        }
+        cout << "----------|-------------" << endl;
+        return new Advice( getName(), ( *pool_set->fsp->getScenarios() )[ searchAlgorithm->getOptimum() ],
+                           searchAlgorithm->getSearchPath(), "Time", pool_set->fsp->getScenarios() );
+    }
+
+    void finalize( void ) {
+        terminate();
+    }
+
+    void terminate( void ) {
+        if( searchAlgorithm ) {
+            searchAlgorithm->finalize();
+            delete searchAlgorithm;
+            searchAlgorithm = NULL;
+        }
+        context->unloadSearchAlgorithms();
+    }
+
+private:
+    ISearchAlgorithm* searchAlgorithm;
+    TuningParameter*  parameter;
+    VariantSpace      variantSpace;
+    SearchSpace       searchSpace;
+};
+
+
+IPlugin* getPluginInstance( void ) {
+    return new EnsembleToyPlugin();
+}
+
+int getVersionMajor( void ) {
+    return 1;
+}
+
+int getVersionMinor( void ) {
+    return 0;
+}
+
+string getName( void ) {
+    return "Ensemble toy plugin";
+}
+
+string getShortSummary( void ) {
+    return "Scenarios of a made-up parameter for the end-to-end check of ensembles.";
+}
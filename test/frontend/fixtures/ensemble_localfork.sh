@@ -0,0 +1,88 @@
+#!/bin/sh
+#
+# End-to-end check of ensembles with the localfork starter: the frontend runs two instances of the
+# fake Score-P online-access endpoint side by side, each under its own agent subtree, and tunes
+# them with the ensembletoy plugin. Everything runs on the local host.
+#
+# Usage: ensemble_localfork.sh <bin directory of the installation> [<directory with psc_fake_scorep_oa>]
+#
+# Requires a build configured with --with-starter=localfork and installed, so that the frontend
+# finds the agents and the ensembletoy plugin. ENSEMBLE_PORT (42000) is the first port to use.
+#
+# Checks that
+#   - the ensemble has 2 slots and each started an instance registered under its own name,
+#   - the experiments of a round were assigned to both slots,
+#   - every scenario of the plugin has exactly one result in the merged pool.
+
+bindir=${1:-.}
+fakedir=${2:-$bindir}
+port=${ENSEMBLE_PORT:-42000}
+reg_port=$port
+work=$(mktemp -d "${TMPDIR:-/tmp}/ensemble_localfork.XXXXXX") || exit 1
+
+cleanup() {
+    [ -n "$reg_pid" ] && kill "$reg_pid" 2>/dev/null
+    rm -rf "$work"
+}
+trap cleanup EXIT INT TERM
+
+fail() {
+    echo "ensemble_localfork: $1" >&2
+    tail -n 40 "$work/frontend.log" >&2
+    exit 1
+}
+
+# localfork starts "mpiexec -n <procs> <apprun>"; the fake simulates its ranks in one process
+mkdir "$work/bin"
+cat > "$work/bin/mpiexec" <<'EOF'
+#!/bin/sh
+shift 2
+exec "$@"
+EOF
+chmod +x "$work/bin/mpiexec"
+PATH="$work/bin:$PATH"
+export PATH
+
+cat > "$work/ensemble.xml" <<'EOF'
+<?xml version="1.0" encoding="UTF-8"?>
+<Configuration>
+    <periscope>
+        <ensemble>
+            <slots>2</slots>
+        </ensemble>
+    </periscope>
+</Configuration>
+EOF
+
+"$bindir/psc_regsrv" "$reg_port" > "$work/registry.log" 2>&1 &
+reg_pid=$!
+sleep 1
+
+cd "$work" || exit 1
+"$bindir/psc_frontend" --registry="localhost:$reg_port" --force-localhost \
+    --apprun="$fakedir/psc_fake_scorep_oa --procs=2 --regions=8 --phase-time=2000 --port=$((port + 1)) --timeout=120" \
+    --mpinumprocs=2 --tune=ensembletoy --phase=OA_phase --config-file="$work/ensemble.xml" \
+    --selective-info=FrontendStateMachines --port=$((port + 500)) --timeout=120 > "$work/frontend.log" 2>&1
+status=$?
+[ $status -eq 0 ] || fail "the frontend finished with status $status"
+
+for slot in 0 1; do
+    grep -q "Ensemble slot $slot:" "$work/frontend.log" || fail "slot $slot was not configured"
+    grep -q "assigned to slot $slot" "$work/frontend.log" || fail "no experiment was assigned to slot $slot"
+done
+
+instances=$(sed -n 's/^Fake Score-P OA: .* rank(s) of \([^ ]*\) listening.*/\1/p' "$work/frontend.log" | sort -u | wc -l)
+[ "$instances" -eq 2 ] || fail "$instances application instances registered, expected 2"
+
+! grep -q "Not all scenarios of the ensemble round returned results" "$work/frontend.log" ||
+    fail "a round of the ensemble is missing results"
+
+# the advice of the plugin: one row per scenario, one severity per merged result
+results=$(sed -n '/^All Results:/,/^----------|/p' "$work/frontend.log" | grep '^[0-9]')
+scenarios=$(echo "$results" | wc -l)
+[ "$scenarios" -eq 4 ] || fail "$scenarios scenarios in the advice, expected 4"
+echo "$results" | awk -F '\t' 'NF != 2 { bad = 1 } END { exit bad }' ||
+    fail "a scenario has no result or more than one"
+
+echo "Ensemble of 2 instances evaluated $scenarios scenarios, each result merged once"
+exit 0
@@ -0,0 +1,265 @@
+#define BOOST_TEST_MODULE QualExprBytecode
+
+#include <boost/test/included/unit_test.hpp>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "qualexpr-evaluator/QualExprEvaluator.h"
+
+using namespace quality_expressions_core;
+
+/* Semantic accepting every event; only its name matters here. */
+class TestSemantic : public quality_expressions_ns::QualExprSemantic {
+public:
+    TestSemantic( const std::string& name ) : m_name( name ) {
+    }
+
+    virtual bool matchSemantic( unsigned int sem ) const {
+        return true;
+    }
+
+    virtual const char* name( void ) const {
+        return m_name.c_str();
+    }
+
+    virtual QualExprSemantic* build( void ) const {
+        return new TestSemantic( m_name );
+    }
+
+private:
+    std::string m_name;
+};
+
+/* Semantic of the counters delivered under one semantic ID. */
+class CounterSemantic : public quality_expressions_ns::QualExprSemantic {
+public:
+    CounterSemantic( const std::string& name, unsigned int id ) : m_name( name ), m_id( id ) {
+    }
+
+    virtual bool matchSemantic( unsigned int sem ) const {
+        return sem == m_id;
+    }
+
+    virtual const char* name( void ) const {
+        return m_name.c_str();
+    }
+
+    virtual QualExprSemantic* build( void ) const {
+        return new CounterSemantic( m_name, m_id );
+    }
+
+private:
+    std::string  m_name;
+    unsigned int m_id;
+};
+
+/* Counter value as the profiler delivers it. */
+class CounterEvent : public QualExprEvent {
+public:
+    CounterEvent( unsigned int semanticId, long long value ) : QualExprEvent( D_COUNTER, semanticId ) {
+        m_value = value;
+    }
+};
+
+/* Aggregator whose value is set directly by the test. */
+class TestAggregator : public QualExprAggregatorEvalBasic<long64_t>{
+public:
+    TestAggregator( size_t id ) : QualExprAggregatorEvalBasic<long64_t>( id ) {
+    }
+
+    void set( long64_t value ) {
+        m_value = value;
+    }
+
+    virtual void processEvent( const QualExprEvent& event ) {
+    }
+
+    virtual long64_t evaluate( void ) const {
+        return m_value;
+    }
+
+    virtual const char* name( void ) const {
+        return "!test";
+    }
+
+    virtual const char* description( void ) const {
+        return "Test value";
+    }
+
+    virtual QualExprAggregator* build( size_t id ) const {
+        return new TestAggregator( id );
+    }
+};
+
+struct BytecodeFixture {
+    std::vector<TestAggregator*>             aggregators;
+    std::vector<QualExprSemanticAggregator*> semAggregators;
+
+    BytecodeFixture() {
+        for( size_t index = 0; index < 6; index++ ) {
+            TestAggregator* aggreg = new TestAggregator( index );
+            aggregators.push_back( aggreg );
+            semAggregators.push_back( new QualExprSemanticAggregator( *new TestSemantic( "test::event" ), *aggreg ) );
+        }
+    }
+
+    ~BytecodeFixture() {
+        for( size_t index = 0; index < semAggregators.size(); index++ ) {
+            delete semAggregators[ index ];
+        }
+    }
+
+    QualExprComputeNodeOf<long64_t>* immediate( long64_t value ) {
+        return new QualExprComputeNodeImmediate<long64_t>( value );
+    }
+
+    QualExprComputeNodeOf<long64_t>* measure( size_t index ) {
+        return new QualExprComputeNodeAggreg<long64_t>( *semAggregators[ index ] );
+    }
+
+    template <template <typename> class op>
+    QualExprComputeNodeOf<long64_t>* bin( QualExprComputeNodeOf<long64_t>* lhs, QualExprComputeNodeOf<long64_t>* rhs ) {
+        return new QualExprComputeNodeBinOp<long64_t, op<long64_t> >( *lhs, *rhs );
+    }
+
+    /* Random expression; the same seed always builds the same tree, which is used to create common subexpressions. */
+    QualExprComputeNodeOf<long64_t>* random( unsigned int& seed, int depth ) {
+        int choice = rand_r( &seed ) % 16;
+        if( depth == 0 || choice < 4 ) {
+            if( choice % 2 ) {
+                return immediate( ( long64_t )( rand_r( &seed ) % 21 ) - 10 );
+            }
+            return measure( rand_r( &seed ) % semAggregators.size() );
+        }
+        if( choice == 4 ) {
+            unsigned int                     copy = seed;
+            QualExprComputeNodeOf<long64_t>* lhs  = random( copy, depth - 1 );
+            QualExprComputeNodeOf<long64_t>* rhs  = random( seed, depth - 1 );
+            return bin<add>( lhs, rhs );
+        }
+        QualExprComputeNodeOf<long64_t>* lhs = random( seed, depth - 1 );
+        QualExprComputeNodeOf<long64_t>* rhs = random( seed, depth - 1 );
+        switch( choice % 9 ) {
+        case 0:
+            return bin<list>( lhs, rhs );
+        case 1:
+            return bin<lt>( lhs, rhs );
+        case 2:
+            return bin<gt>( lhs, rhs );
+        case 3:
+            return bin<le>( lhs, rhs );
+        case 4:
+            return bin<ge>( lhs, rhs );
+        case 5:
+            return bin<add>( lhs, rhs );
+        case 6:
+            return bin<sub>( lhs, rhs );
+        case 7:
+            return bin<mul>( lhs, rhs );
+        default:
+            return bin<divi>( lhs, rhs );
+        }
+    }
+
+    QualExprBytecode<long64_t>* compile( QualExprComputeNodeOf<long64_t>* node ) {
+        QualExprBytecodeCompiler<long64_t> compiler;
+        return compiler.build( node->compile( compiler ) );
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE( qualexpr_bytecode, BytecodeFixture )
+
+BOOST_AUTO_TEST_CASE( constant_folding ) {
+    QualExprComputeNodeOf<long64_t>* node    = bin<mul>( bin<add>( immediate( 2 ), immediate( 3 ) ), bin<divi>( immediate( 8 ), immediate( 0 ) ) );
+    QualExprBytecode<long64_t>*      program = compile( node );
+
+    BOOST_CHECK_EQUAL( program->instructionCount(), 0 );
+    BOOST_CHECK_EQUAL( program->eval(), node->eval() );
+    delete program;
+    delete node;
+}
+
+BOOST_AUTO_TEST_CASE( common_subexpressions ) {
+    // m0*m1 + m1*m0 ; m2  ->  load, load, mul, add
+    QualExprComputeNodeOf<long64_t>* node = bin<list>( bin<add>( bin<mul>( measure( 0 ), measure( 1 ) ),
+                                                                 bin<mul>( measure( 1 ), measure( 0 ) ) ),
+                                                       measure( 2 ) );
+    QualExprBytecode<long64_t>* program = compile( node );
+
+    BOOST_CHECK_EQUAL( program->instructionCount(), 4 );
+    aggregators[ 0 ]->set( 7 );
+    aggregators[ 1 ]->set( -3 );
+    BOOST_CHECK_EQUAL( program->eval(), -42 );
+    BOOST_CHECK_EQUAL( program->eval(), node->eval() );
+    delete program;
+    delete node;
+}
+
+BOOST_AUTO_TEST_CASE( random_corpus_matches_tree ) {
+    size_t instructions = 0;
+
+    for( unsigned int expr = 0; expr < 2000; expr++ ) {
+        unsigned int                     seed    = expr;
+        QualExprComputeNodeOf<long64_t>* node    = random( seed, 1 + expr % 7 );
+        QualExprBytecode<long64_t>*      program = compile( node );
+
+        for( unsigned int run = 0; run < 8; run++ ) {
+            for( size_t index = 0; index < aggregators.size(); index++ ) {
+                aggregators[ index ]->set( ( long64_t )( rand_r( &seed ) % 2001 ) - 1000 );
+            }
+            BOOST_REQUIRE_EQUAL( program->eval(), node->eval() );
+        }
+
+        instructions += program->instructionCount();
+        delete program;
+        delete node;
+    }
+    BOOST_TEST_MESSAGE( "corpus compiled to " << instructions << " instructions" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_CASE( evaluator_runs_pushed_expressions ) {
+    QualExprEvaluator                                      evaluator;
+    quality_expressions_ns::QualExprSemanticNamespaceLeaf* counters = new quality_expressions_ns::QualExprSemanticNamespaceLeaf( "test" );
+    counters->registerNewSemantic( new CounterSemantic( "test::a", 1 ) );
+    counters->registerNewSemantic( new CounterSemantic( "test::b", 2 ) );
+    counters->registerNewSemantic( new CounterSemantic( "test::c", 3 ) );
+    evaluator.registerSemanticNamespace( *counters );
+
+    const char* expressions[] = {
+        "test::a + test::b * 3",
+        "(test::a - test::c) / 2 ; test::b",
+        "test::a:! <= test::b",
+        "2 * (7 + 1) - test::c"
+    };
+    for( QualityExpressionID_T id = 0; id < 4; id++ ) {
+        BOOST_REQUIRE_EQUAL( evaluator.pushMeasure( QualityExpressionEntry( id, expressions[ id ] ) ), 1u );
+    }
+    // an ID registered before keeps its expression
+    BOOST_CHECK_EQUAL( evaluator.pushMeasure( QualityExpressionEntry( 0, "test::c" ) ), 0u );
+    evaluator.consolidate();
+
+    long64_t values[][ 3 ] = { { 5, -2, 9 }, { 40, 7, -8 }, { 0, 0, 0 } };
+    for( int run = 0; run < 3; run++ ) {
+        long64_t a = values[ run ][ 0 ], b = values[ run ][ 1 ], c = values[ run ][ 2 ];
+        evaluator.evaluateEvent( CounterEvent( 1, a ) );
+        evaluator.evaluateEvent( CounterEvent( 2, b ) );
+        evaluator.evaluateEvent( CounterEvent( 3, c ) );
+
+        long64_t expected[] = { a + b * 3, ( a - c ) / 2, a <= b, 16 - c };
+        for( QualityExpressionID_T id = 0; id < 4; id++ ) {
+            BOOST_CHECK_EQUAL( evaluator.getLongCounter( id ), expected[ id ] );
+            BOOST_CHECK_EQUAL( evaluator.getLongCounter( id ), evaluator.evalLongCounterTree( id ) );
+        }
+    }
+    BOOST_CHECK_THROW( evaluator.getLongCounter( 4 ), QualExprEvaluator::Exception );
+
+    // registered again after the measures are cleared, the entries run their new expressions
+    evaluator.clearMeasures();
+    BOOST_REQUIRE_EQUAL( evaluator.pushMeasure( QualityExpressionEntry( 0, "test::c - test::a" ) ), 1u );
+    evaluator.evaluateEvent( CounterEvent( 1, 4 ) );
+    evaluator.evaluateEvent( CounterEvent( 3, 10 ) );
+    BOOST_CHECK_EQUAL( evaluator.getLongCounter( 0 ), 6 );
+}
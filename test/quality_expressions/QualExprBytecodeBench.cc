@@ -0,0 +1,123 @@
+/* Micro-benchmark of quality expression evaluation: compute node tree against compiled bytecode.
+ *
+ * Usage: qualexpr_bytecode_bench [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string>
+#include <vector>
+
+#include "qualexpr-evaluator/QualExprEvaluator.h"
+
+using namespace quality_expressions_core;
+
+class BenchSemantic : public quality_expressions_ns::QualExprSemantic {
+public:
+    virtual bool matchSemantic( unsigned int sem ) const {
+        return true;
+    }
+
+    virtual const char* name( void ) const {
+        return "bench::event";
+    }
+
+    virtual QualExprSemantic* build( void ) const {
+        return new BenchSemantic();
+    }
+};
+
+class BenchAggregator : public QualExprAggregatorEvalBasic<long64_t>{
+public:
+    BenchAggregator( size_t id, long64_t value ) : QualExprAggregatorEvalBasic<long64_t>( id ) {
+        m_value = value;
+    }
+
+    virtual void processEvent( const QualExprEvent& event ) {
+    }
+
+    virtual long64_t evaluate( void ) const {
+        return m_value;
+    }
+
+    virtual const char* name( void ) const {
+        return "!bench";
+    }
+
+    virtual const char* description( void ) const {
+        return "Benchmark value";
+    }
+
+    virtual QualExprAggregator* build( size_t id ) const {
+        return new BenchAggregator( id, 0 );
+    }
+};
+
+static std::vector<QualExprSemanticAggregator*> measures;
+
+static QualExprComputeNodeOf<long64_t>* m( size_t index ) {
+    return new QualExprComputeNodeAggreg<long64_t>( *measures[ index ] );
+}
+
+static QualExprComputeNodeOf<long64_t>* c( long64_t value ) {
+    return new QualExprComputeNodeImmediate<long64_t>( value );
+}
+
+template <template <typename> class op>
+static QualExprComputeNodeOf<long64_t>* bin( QualExprComputeNodeOf<long64_t>* lhs, QualExprComputeNodeOf<long64_t>* rhs ) {
+    return new QualExprComputeNodeBinOp<long64_t, op<long64_t> >( *lhs, *rhs );
+}
+
+static double now( void ) {
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void bench( const char* name, QualExprComputeNodeOf<long64_t>* node, long iterations ) {
+    QualExprBytecodeCompiler<long64_t> compiler;
+    QualExprBytecode<long64_t>*        program = compiler.build( node->compile( compiler ) );
+    volatile long64_t                  sink    = 0;
+
+    double start = now();
+    for( long i = 0; i < iterations; i++ ) {
+        sink += node->eval();
+    }
+    double tree = ( now() - start ) / iterations;
+
+    start = now();
+    for( long i = 0; i < iterations; i++ ) {
+        sink += program->eval();
+    }
+    double code = ( now() - start ) / iterations;
+
+    printf( "%-12s tree %8.2f ns/eval  bytecode %8.2f ns/eval  (%zu instructions)  speedup %.2fx\n",
+            name, tree, code, program->instructionCount(), tree / code );
+    delete program;
+    delete node;
+}
+
+int main( int argc, char** argv ) {
+    long iterations = argc > 1 ? atol( argv[ 1 ] ) : 10000000;
+
+    for( size_t index = 0; index < 4; index++ ) {
+        measures.push_back( new QualExprSemanticAggregator( *new BenchSemantic(), *new BenchAggregator( index, 1000 + 37 * index ) ) );
+    }
+
+    // time:~ ; a single aggregator
+    bench( "single", m( 0 ), iterations );
+    // (time:+ - time:-) * 100 / time:~
+    bench( "ratio", bin<divi>( bin<mul>( bin<sub>( m( 0 ), m( 1 ) ), c( 100 ) ), m( 2 ) ), iterations );
+    // Shared subexpressions and constants folded away.
+    bench( "shared",
+           bin<list>( bin<add>( bin<mul>( bin<add>( m( 0 ), m( 1 ) ), bin<mul>( c( 4 ), c( 25 ) ) ),
+                                bin<divi>( bin<add>( m( 1 ), m( 0 ) ), bin<add>( m( 2 ), m( 3 ) ) ) ),
+                      bin<lt>( m( 2 ), m( 3 ) ) ),
+           iterations );
+
+    for( size_t index = 0; index < measures.size(); index++ ) {
+        delete measures[ index ];
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+#define BOOST_TEST_MODULE MetricExtraction
+
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+
+#include "MetricExtraction.h"
+
+using namespace std;
+
+/*
+ * Cube of a phase profiled in the tau-tuple format, held in memory: main calls the phase, which
+ * calls solve, on one process. "visits" is a plain metric and PAPI_L3_TCM is missing.
+ */
+struct PhaseCube {
+    Cube    cube;
+    Metric* visits;
+    Metric* time;
+    Cnode*  main;
+    Cnode*  phase;
+    Cnode*  solve;
+    Thread* thread;
+
+    PhaseCube() {
+        visits = cube.def_met( "Visits", "visits", "UINT64", "occ", "", "", "Number of visits", NULL );
+        time   = cube.def_met( "Time", "time", "TAU_ATOMIC", "sec", "", "", "Time of the instances", NULL );
+
+        Region* main_region  = cube.def_region( "main", "main", "user", "function", 1, 100, "", "", "app.c" );
+        Region* phase_region = cube.def_region( "phase", "phase", "user", "function", 10, 40, "", "", "app.c" );
+        Region* solve_region = cube.def_region( "solve", "solve", "user", "function", 50, 90, "", "", "app.c" );
+        main  = cube.def_cnode( main_region, "app.c", 1, NULL );
+        phase = cube.def_cnode( phase_region, "app.c", 20, main );
+        solve = cube.def_cnode( solve_region, "app.c", 30, phase );
+
+        Machine* machine = cube.def_mach( "machine", "" );
+        Node*    node    = cube.def_node( "node", machine );
+        Process* process = cube.def_proc( "rank 0", 0, node );
+        thread = cube.def_thrd( "thread 0", 0, process );
+        cube.initialize();
+
+        // 4 phase instances of 1, 1, 2 and 2 s, solve twice per instance
+        TauAtomicValue phase_tuple( 4, 1.0, 2.0, 6.0, 10.0 );
+        TauAtomicValue solve_tuple( 8, 0.25, 0.75, 4.0, 2.5 );
+        cube.set_sev( time, phase, thread, &phase_tuple );
+        cube.set_sev( time, solve, thread, &solve_tuple );
+        cube.set_sev( visits, phase, thread, 4.0 );
+        cube.set_sev( visits, solve, thread, 8.0 );
+    }
+};
+
+
+BOOST_FIXTURE_TEST_CASE( tuples_land_in_the_column_of_their_metric, PhaseCube ) {
+    // "time" is not the first column, the tools look it up by name
+    MetricTable table( { "visits", "PAPI_L3_TCM", "time" } );
+    vector< Cnode* > nodes = { solve, phase };
+    extractTauMetrics( &cube, nodes, cube.get_procv()[ 0 ], table );
+
+    size_t met_time = table.metric( "time" );
+    BOOST_REQUIRE_EQUAL( met_time, 2u );
+    BOOST_CHECK( table.has( met_time ) );
+    BOOST_CHECK( !table.has( table.metric( "visits" ) ) );
+    BOOST_CHECK( !table.has( table.metric( "PAPI_L3_TCM" ) ) );
+
+    // rows follow the nodes, not their order in the cube
+    BOOST_REQUIRE_EQUAL( table.nodes(), 2u );
+    BOOST_CHECK_EQUAL( table.node( solve->get_id() ), 0u );
+    BOOST_CHECK_EQUAL( table.node( main->get_id() ), MetricTable::npos );
+
+    const TauStatistics& phase_time = table.at( table.node( phase->get_id() ), met_time );
+    BOOST_CHECK_EQUAL( phase_time.n, 4 );
+    BOOST_CHECK_EQUAL( phase_time.min, 1.0 );
+    BOOST_CHECK_EQUAL( phase_time.max, 2.0 );
+    BOOST_CHECK_CLOSE( phase_time.mean(), 1.5, 1e-9 );
+    BOOST_CHECK_CLOSE( phase_time.deviation(), 0.5, 1e-9 );
+
+    // exclusive in the call node: the phase does not include solve
+    const TauStatistics& solve_time = table.at( table.node( solve->get_id() ), met_time );
+    BOOST_CHECK_EQUAL( solve_time.n, 8 );
+    BOOST_CHECK_EQUAL( solve_time.sum, 4.0 );
+    BOOST_CHECK_EQUAL( solve_time.sumSquares, 2.5 );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( cube_without_tuples, PhaseCube ) {
+    MetricTable table( { "visits" } );
+    extractTauMetrics( &cube, vector< Cnode* >( 1, phase ), cube.get_procv()[ 0 ], table );
+    BOOST_CHECK( !table.has( table.metric( "visits" ) ) );
+    BOOST_CHECK_EQUAL( table.at( 0, 0 ).n, 0 );
+}
@@ -0,0 +1,163 @@
+#define BOOST_TEST_MODULE MetricTable
+
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "MetricTable.h"
+
+using namespace std;
+
+/* Tuple of random samples, accumulated the way Score-P fills a TauAtomicValue. */
+static TauStatistics
+samples( size_t count, double scale, unsigned int& seed )
+{
+    TauStatistics tuple;
+    for( size_t i = 0; i < count; i++ ) {
+        double value = scale * ( 1 + rand_r( &seed ) % 1000 ) / 7.0;
+        tuple.min         = i == 0 ? value : min( tuple.min, value );
+        tuple.max         = i == 0 ? value : max( tuple.max, value );
+        tuple.sum        += value;
+        tuple.sumSquares += value * value;
+        tuple.n++;
+    }
+    return tuple;
+}
+
+/* TauAtomicValue::getString(): "(N,min,max):mean,deviation" with the default stream precision. */
+static string
+tupleString( const TauStatistics& tuple )
+{
+    double       average = tuple.sum / tuple.n;
+    stringstream text;
+    text << "(" << tuple.n << "," << tuple.min << "," << tuple.max << "):" << average << ","
+         << sqrt( tuple.sumSquares / tuple.n - average * average );
+    return text.str();
+}
+
+/* The per-call path the tool used before: ValueParser from common_src/helper.cc and stod. */
+static vector< string >
+legacyValueParser( string value )
+{
+    string delimiter[ 5 ] = { "(", ",", ",", "):", "," };
+    vector< string > values;
+    size_t pos = 0, prev_pos = 0, i = 0;
+    string token;
+    while( i != 5 ) {
+        pos   = value.find( delimiter[ i ] );
+        token = value.substr( prev_pos, pos );
+        if( !token.empty() ) {
+            values.push_back( token );
+        }
+        value.erase( prev_pos, pos + delimiter[ i ].length() );
+        i++;
+    }
+    if( !value.empty() ) {
+        values.push_back( value );
+    }
+    return values;
+}
+
+static double
+legacyIntensity( const TauStatistics& ins, const TauStatistics& tcm )
+{
+    vector< string > tau_val_ins = legacyValueParser( tupleString( ins ) );
+    vector< string > tau_val_tcm = legacyValueParser( tupleString( tcm ) );
+    double avg_ins = stod( tau_val_ins.at( 3 ) );
+    double avg_tcm = stod( tau_val_tcm.at( 3 ) );
+    if( stod( tau_val_tcm.at( 0 ) ) == 0 ) {
+        avg_tcm = 1.0;
+    }
+    return avg_ins / avg_tcm;
+}
+
+static double
+legacyTime( const TauStatistics& tuple )
+{
+    vector< string > tau_atomic_val = legacyValueParser( tupleString( tuple ) );
+    uint64_t         N              = stod( tau_atomic_val.at( 0 ) );
+    return stod( tau_atomic_val.at( 3 ) ) * N;
+}
+
+static double
+legacyDeviation( const TauStatistics& tuple )
+{
+    vector< string > tau_atomic_val = legacyValueParser( tupleString( tuple ) );
+    double           deviation      = stod( tau_atomic_val.at( 4 ) );
+    return std::isnan( deviation ) ? 0.0 : deviation;
+}
+
+/* getString() prints six significant digits */
+static const double tolerance = 1e-3;
+
+
+BOOST_AUTO_TEST_CASE( rows_and_columns ) {
+    MetricTable table( { "time", "PAPI_TOT_INS", "PAPI_L3_TCM" } );
+    BOOST_CHECK_EQUAL( table.metrics(), 3u );
+    BOOST_CHECK_EQUAL( table.metric( "PAPI_L3_TCM" ), 2u );
+    BOOST_CHECK_EQUAL( table.metric( "visits" ), MetricTable::npos );
+    BOOST_CHECK( !table.has( 0 ) );
+    BOOST_CHECK( !table.has( MetricTable::npos ) );
+    table.setAvailable( 0 );
+    BOOST_CHECK( table.has( 0 ) );
+
+    BOOST_CHECK_EQUAL( table.addNode( 42 ), 0u );
+    BOOST_CHECK_EQUAL( table.addNode( 7 ), 1u );
+    BOOST_CHECK_EQUAL( table.addNode( 42 ), 0u );
+    BOOST_CHECK_EQUAL( table.nodes(), 2u );
+    BOOST_CHECK_EQUAL( table.node( 7 ), 1u );
+    BOOST_CHECK_EQUAL( table.node( 8 ), MetricTable::npos );
+
+    table.at( 1, 2 ).n = 3;
+    table.addNode( 99 );
+    BOOST_CHECK_EQUAL( table.at( 1, 2 ).n, 3 );
+    BOOST_CHECK_EQUAL( table.at( 2, 2 ).n, 0 );
+    BOOST_CHECK_EQUAL( table.at( 0, 2 ).n, 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( typed_values_match_the_parsed_tuples ) {
+    unsigned int seed = 17;
+    for( int run = 0; run < 200; run++ ) {
+        size_t        count  = 1 + rand_r( &seed ) % 50;
+        TauStatistics time   = samples( count, 0.001, seed );
+        TauStatistics ins    = samples( count, 1e6, seed );
+        TauStatistics tcm    = samples( count, 1e3, seed );
+        vector< string > legacy = legacyValueParser( tupleString( time ) );
+
+        BOOST_CHECK_EQUAL( ( uint64_t )time.n, ( uint64_t )stod( legacy.at( 0 ) ) );
+        BOOST_CHECK_CLOSE( time.mean(), stod( legacy.at( 3 ) ), tolerance );
+        BOOST_CHECK_CLOSE( time.mean() * ( uint64_t )time.n, legacyTime( time ), tolerance );
+        BOOST_CHECK_CLOSE( transferIntensity( ins, tcm ), legacyIntensity( ins, tcm ), tolerance );
+        if( count > 1 && time.max > time.min ) {
+            BOOST_CHECK_CLOSE( time.deviation(), legacyDeviation( time ), tolerance );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( degenerate_tuples ) {
+    unsigned int  seed = 3;
+    TauStatistics ins  = samples( 10, 1e6, seed );
+    TauStatistics none;
+
+    // a node without cache miss samples counts one miss per sample, as before
+    BOOST_CHECK_CLOSE( transferIntensity( ins, none ), legacyIntensity( ins, none ), tolerance );
+
+    // the tool treated the "-nan" deviation of an empty tuple as 0
+    BOOST_CHECK_EQUAL( none.deviation(), 0.0 );
+    BOOST_CHECK_EQUAL( legacyDeviation( none ), 0.0 );
+    BOOST_CHECK_EQUAL( none.mean(), 0.0 );
+
+    // constant samples have no deviation, even where rounding makes the variance negative
+    TauStatistics constant;
+    for( int i = 0; i < 3; i++ ) {
+        constant.sum        += 0.1;
+        constant.sumSquares += 0.01;
+        constant.n++;
+    }
+    BOOST_CHECK_EQUAL( constant.deviation(), 0.0 );
+}
@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE OverheadModel
+
+#include <boost/test/included/unit_test.hpp>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "OverheadModel.h"
+
+using namespace std;
+
+/* Profile of a run: 10 s of work plus 1 us per event, i.e. 2 us per visit. */
+static size_t
+addRun( OverheadModel& model, const vector< pair< string, double > >& visits )
+{
+    double runtime = 10.0;
+    for( const auto& region : visits ) {
+        runtime += 2e-6 * region.second;
+    }
+    size_t run = model.addRun( runtime );
+    for( const auto& region : visits ) {
+        model.addVisits( run, region.first, region.second );
+    }
+    return run;
+}
+
+static const vector< pair< string, double > > profile = {
+    { "main", 1 }, { "phase", 100 }, { "kernel", 100000 }, { "small_a", 200000 }, { "small_b", 50000 },
+    { "small_c", 2000 }, { "MPI_Send", 300000 }
+};
+
+
+BOOST_AUTO_TEST_CASE( calibration_from_successive_runs ) {
+    OverheadModel model;
+    addRun( model, profile );
+    BOOST_CHECK( !model.calibrate() );
+    BOOST_CHECK_EQUAL( model.eventOverhead(), OverheadModel::defaultEventOverhead );
+
+    // the next iteration filtered small_a: it keeps the cost it had
+    vector< pair< string, double > > filtered;
+    for( const auto& region : profile ) {
+        if( region.first != "small_a" ) {
+            filtered.push_back( region );
+        }
+    }
+    addRun( model, filtered );
+    BOOST_REQUIRE( model.calibrate() );
+    BOOST_CHECK_CLOSE( model.eventOverhead(), 1e-6, 1e-6 );
+    BOOST_CHECK_CLOSE( model.baseRuntime(), 10.0, 1e-6 );
+    BOOST_CHECK_CLOSE( model.cost( "small_a" ), 0.4, 1e-6 );
+    BOOST_CHECK_EQUAL( model.cost( "unknown" ), 0.0 );
+    BOOST_CHECK_EQUAL( model.regions().size(), profile.size() );
+}
+
+
+BOOST_AUTO_TEST_CASE( minimal_exclusion_meets_the_budget ) {
+    OverheadModel model;
+    addRun( model, profile );
+    model.setEventOverhead( 1e-6 );
+    model.protect( "main" );
+    model.protect( "phase" );
+    model.protect( "kernel" );
+    model.protect( "MPI_Send" );
+
+    // unfiltered: 652101 visits cost 1.304 s of 10 s
+    BOOST_CHECK_CLOSE( model.overhead( set< string >() ), 0.1304202, 1e-4 );
+
+    // protected regions alone cost 0.8002 s; the largest unprotected region is enough for 12 %
+    vector< string > excluded = model.plan( 0.12 );
+    BOOST_CHECK( excluded == vector< string >( { "small_a" } ) );
+    BOOST_CHECK( model.overhead( set< string >( excluded.begin(), excluded.end() ) ) <= 0.12 );
+
+    excluded = model.plan( 0.085 );
+    BOOST_CHECK( excluded == vector< string >( { "small_a", "small_b" } ) );
+
+    // a budget below the cost of the protected regions excludes every unprotected region
+    excluded = model.plan( 0.0 );
+    BOOST_CHECK( excluded == vector< string >( { "small_a", "small_b", "small_c" } ) );
+    BOOST_CHECK_CLOSE( model.overhead( set< string >( excluded.begin(), excluded.end() ) ), 0.0800202, 1e-4 );
+
+    // the budget is already met
+    BOOST_CHECK( model.plan( 0.15 ).empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( call_paths_add_up_within_a_run ) {
+    OverheadModel model;
+    model.setEventOverhead( 1e-6 );
+    size_t first = model.addRun( 1.0 );
+    model.addVisits( first, "leaf", 100 );
+    model.addVisits( first, "leaf", 300 );
+    size_t second = model.addRun( 1.0 );
+    model.addVisits( second, "leaf", 250 );
+    model.addVisits( 7, "leaf", 1e9 );
+    BOOST_CHECK_CLOSE( model.cost( "leaf" ), 8e-4, 1e-6 );
+}
+
+
+BOOST_AUTO_TEST_CASE( filter_patterns ) {
+    BOOST_CHECK_EQUAL( scorepFilterPattern( "void foo(int, double)" ), "void*foo(int,*double)" );
+    BOOST_CHECK_EQUAL( scorepFilterPattern( "_ZN3fooEv" ), "_ZN3fooEv" );
+    BOOST_CHECK_EQUAL( intelFilterPattern( "operator[]*" ), "operator\\[\\]\\*" );
+}
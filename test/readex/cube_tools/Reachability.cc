@@ -0,0 +1,186 @@
+#define BOOST_TEST_MODULE Reachability
+
+#include <boost/test/included/unit_test.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Reachability.h"
+
+using namespace std;
+
+/* Call tree as produced by the cube call-path hierarchy: parents precede their children. */
+struct CallTree {
+    vector< size_t >           parent;
+    vector< string >           region;
+    vector< vector< size_t > > children;
+
+    CallTree( size_t nodes, size_t regions, unsigned int seed ) : parent( nodes ), region( nodes ), children( nodes ) {
+        for( size_t n = 0; n < nodes; n++ ) {
+            parent[ n ] = n == 0 ? 0 : rand_r( &seed ) % n;
+            region[ n ] = "region_" + to_string( rand_r( &seed ) % regions );
+            if( n > 0 ) {
+                children[ parent[ n ] ].push_back( n );
+            }
+        }
+    }
+
+    /* Pre-order subtree of a node, the node itself excluded. */
+    vector< size_t > subtree( size_t node ) const {
+        vector< size_t > nodes;
+        vector< size_t > stack( children[ node ].rbegin(), children[ node ].rend() );
+        while( !stack.empty() ) {
+            size_t n = stack.back();
+            stack.pop_back();
+            nodes.push_back( n );
+            stack.insert( stack.end(), children[ n ].rbegin(), children[ n ].rend() );
+        }
+        return nodes;
+    }
+};
+
+/* Candidate mapping and its direct edges, built the way generateAdjacencyMatrix() walks the tree. */
+struct Candidates {
+    map< size_t, string >              mapping;
+    vector< pair< size_t, size_t > >   edges;
+
+    Candidates( const CallTree& tree, size_t count, unsigned int seed ) {
+        map< string, size_t > index;
+        vector< size_t >      whole = tree.subtree( 0 );
+        whole.insert( whole.begin(), 0 );
+        for( size_t n : whole ) {
+            if( index.size() < count && !index.count( tree.region[ n ] ) && rand_r( &seed ) % 3 ) {
+                index[ tree.region[ n ] ] = mapping.size();
+                mapping[ mapping.size() ] = tree.region[ n ];
+            }
+        }
+        vector< bool > done( mapping.size(), false );
+        for( size_t n : whole ) {
+            map< string, size_t >::const_iterator from = index.find( tree.region[ n ] );
+            if( from == index.end() || done[ from->second ] ) {
+                continue;
+            }
+            done[ from->second ] = true;
+            for( size_t s : tree.subtree( n ) ) {
+                map< string, size_t >::const_iterator to = index.find( tree.region[ s ] );
+                if( to != index.end() ) {
+                    edges.push_back( make_pair( from->second, to->second ) );
+                }
+            }
+        }
+    }
+};
+
+/* The former dense matrix closed with Floyd-Warshall. */
+struct LegacyMatrix {
+    size_t                    size;
+    vector< vector< size_t > > a_m;
+
+    LegacyMatrix( const Candidates& c ) : size( c.mapping.size() ), a_m( size, vector< size_t >( size, 0 ) ) {
+        for( const auto& e : c.edges ) {
+            a_m[ e.first ][ e.second ] = 1;
+        }
+        for( size_t k = 0; k < size; k++ )
+            for( size_t i = 0; i < size; i++ )
+                for( size_t j = 0; j < size; j++ )
+                    a_m[ i ][ j ] = a_m[ i ][ j ] || ( a_m[ i ][ k ] && a_m[ k ][ j ] );
+    }
+
+    vector< string > cyclicRegions( const map< size_t, string >& names ) const {
+        vector< string > can_r_names;
+        for( size_t i = 0; i < size; i++ ) {
+            for( size_t j = 0; j < size; j++ ) {
+                if( i != j && a_m[ i ][ j ] && a_m[ j ][ i ] ) {
+                    const string& name_i = names.at( i );
+                    const string& name_j = names.at( j );
+                    if( find( can_r_names.begin(), can_r_names.end(), name_i ) == can_r_names.end() )
+                        can_r_names.push_back( name_i );
+                    if( find( can_r_names.begin(), can_r_names.end(), name_j ) == can_r_names.end() )
+                        can_r_names.push_back( name_j );
+                }
+            }
+        }
+        return can_r_names;
+    }
+};
+
+static Reachability* build( const Candidates& c ) {
+    Reachability* r = new Reachability( c.mapping );
+    for( const auto& e : c.edges ) {
+        r->addEdge( e.first, e.second );
+    }
+    r->close();
+    return r;
+}
+
+BOOST_AUTO_TEST_CASE( hashed_index ) {
+    map< size_t, string > mapping = { { 0, "main" }, { 1, "solve" }, { 2, "io" } };
+    Reachability          r( mapping );
+
+    BOOST_CHECK_EQUAL( r.index( "solve" ), 1 );
+    BOOST_CHECK_EQUAL( r.index( "unknown" ), Reachability::npos );
+    BOOST_CHECK_EQUAL( r.name( 2 ), "io" );
+    BOOST_CHECK( !r.hasSuccessor( 0 ) );
+    BOOST_CHECK( !r.reaches( 0, Reachability::npos ) );
+}
+
+BOOST_AUTO_TEST_CASE( matches_floyd_warshall_on_generated_call_trees ) {
+    for( unsigned int seed = 0; seed < 300; seed++ ) {
+        CallTree      tree( 20 + seed, 4 + seed % 40, seed );
+        Candidates    candidates( tree, 2 + seed % 60, seed );
+        LegacyMatrix  legacy( candidates );
+        Reachability* r = build( candidates );
+
+        BOOST_REQUIRE_EQUAL( r->size(), legacy.size );
+        for( size_t i = 0; i < legacy.size; i++ ) {
+            bool visited = false;
+            for( size_t j = 0; j < legacy.size; j++ ) {
+                BOOST_REQUIRE_EQUAL( r->reaches( i, j ), legacy.a_m[ i ][ j ] == 1 );
+                visited = visited || legacy.a_m[ i ][ j ] == 1;
+            }
+            // leaf test of getSignificantRegions()
+            BOOST_REQUIRE_EQUAL( r->hasSuccessor( i ), visited );
+        }
+        // strongly connected candidates of getCandidateRegions(), in the same order
+        vector< string > expected = legacy.cyclicRegions( candidates.mapping );
+        vector< string > cyclic   = r->cyclicRegions();
+        BOOST_REQUIRE_EQUAL_COLLECTIONS( cyclic.begin(), cyclic.end(), expected.begin(), expected.end() );
+        // no larger than one bitset row per region
+        BOOST_REQUIRE_LE( r->closureBytes(), r->size() * ( ( r->size() + 63 ) / 64 ) * 8 );
+        delete r;
+    }
+}
+
+BOOST_AUTO_TEST_CASE( scales_to_large_call_trees ) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    CallTree                         tree( 100000, 20000, 42 );
+    Candidates                       candidates( tree, 20000, 42 );
+    Reachability*                    r = build( candidates );
+    double                           seconds = chrono::duration< double >( chrono::steady_clock::now() - start ).count();
+
+    BOOST_CHECK( r->size() > 5000 );
+    BOOST_CHECK( r->reaches( 0, r->index( tree.region[ tree.children[ 0 ].front() ] ) ) );
+    BOOST_TEST_MESSAGE( r->size() << " regions, " << candidates.edges.size() << " edges closed in " << seconds << " s" );
+    BOOST_CHECK_LT( seconds, 10.0 );
+    delete r;
+}
+
+BOOST_AUTO_TEST_CASE( closure_of_large_call_trees_stays_sparse ) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    CallTree                         tree( 200000, 10000000, 7 );
+    Candidates                       candidates( tree, 100000, 7 );
+    Reachability*                    r = build( candidates );
+    double                           seconds = chrono::duration< double >( chrono::steady_clock::now() - start ).count();
+
+    BOOST_REQUIRE_EQUAL( r->size(), 100000u );
+    size_t node = tree.children[ 0 ].front();
+    BOOST_CHECK( r->reaches( 0, r->index( tree.region[ tree.children[ node ].empty() ? node : tree.children[ node ].front() ] ) ) );
+    BOOST_TEST_MESSAGE( r->size() << " regions, " << candidates.edges.size() << " edges closed in " << seconds << " s into "
+                        << r->closureBytes() << " bytes" );
+    BOOST_CHECK_LT( seconds, 10.0 );
+    // bitset rows would take 1.25 GB
+    BOOST_CHECK_LT( r->closureBytes(), ( size_t )64 << 20 );
+    delete r;
+}
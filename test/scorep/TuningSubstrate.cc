@@ -0,0 +1,202 @@
+#define BOOST_TEST_MODULE TuningSubstrate
+
+#include <boost/test/included/unit_test.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include <scorep/SCOREP_SubstratePlugins.h>
+
+#include "scorep_tuning_table.h"
+#include "scorep_tuning_location.h"
+
+SCOREP_SubstratePluginInfo SCOREP_SubstratePlugin_tuning_get_info( void );
+}
+
+using namespace std;
+
+typedef void ( * EnterExit )( struct SCOREP_Location*, uint64_t, SCOREP_RegionHandle, uint64_t* );
+typedef void ( * AddTuningAction )( uint32_t, uint8_t, char*, int );
+
+/* The frequency knob: a C function setter that records every call */
+static int           frequency = 1000;
+static vector< int > frequencyCalls;
+
+static void set_frequency( int  value,
+                           int* old ) {
+    *old      = frequency;
+    frequency = value;
+    frequencyCalls.push_back( value );
+}
+
+static unsigned int threads;
+
+static uint32_t region_id( SCOREP_RegionHandle handle ) {
+    return handle;
+}
+
+static const char* region_name( SCOREP_RegionHandle handle ) {
+    return "region";
+}
+
+enum { OUTER = 1, INNER = 2, FAST = 3, UNTUNED = 4 };
+
+/* The substrate with outer and inner regions requesting 2000, a fast region 1500 and inner 4 threads */
+struct Substrate {
+    SCOREP_SubstratePluginInfo      info;
+    SCOREP_SubstratePluginCallbacks callbacks;
+    SCOREP_Substrates_Callback*     functions;
+    EnterExit                       enter, exit;
+
+    Substrate( const char* suppress = NULL ) {
+        if( suppress ) {
+            setenv( "SCOREP_TUNING_SUPPRESS_REDUNDANT", suppress, 1 );
+        } else {
+            unsetenv( "SCOREP_TUNING_SUPPRESS_REDUNDANT" );
+        }
+        frequency = 1000;
+        threads   = 4;
+        frequencyCalls.clear();
+
+        info = SCOREP_SubstratePlugin_tuning_get_info();
+        memset( &callbacks, 0, sizeof( callbacks ) );
+        callbacks.SCOREP_RegionHandle_GetId   = region_id;
+        callbacks.SCOREP_RegionHandle_GetName = region_name;
+        info.set_callbacks( &callbacks, sizeof( callbacks ) );
+        info.init();
+        info.get_event_functions( 0, &functions );
+        enter = ( EnterExit )functions[ SCOREP_EVENT_ENTER_REGION ];
+        exit  = ( EnterExit )functions[ SCOREP_EVENT_EXIT_REGION ];
+
+        char frequencyName[] = "<frequency>";
+        char threadsName[]   = "<threads>";
+        scorep_tuning_map_tuning_parameter_to_function( frequencyName, set_frequency, 1, SCOREP_LANGUAGE_C );
+        scorep_tuning_map_tuning_parameter_to_variable( threadsName, &threads, 1 );
+
+        AddTuningAction add = ( AddTuningAction )functions[ SCOREP_EVENT_ADD_TUNING_ACTION ];
+        char frequencyAction[] = "frequency";
+        char threadsAction[]   = "threads";
+        add( OUTER, SCOREP_TUNING_FUNCTION, frequencyAction, 2000 );
+        add( INNER, SCOREP_TUNING_FUNCTION, frequencyAction, 2000 );
+        add( INNER, SCOREP_TUNING_VARIABLE, threadsAction, 4 );
+        add( FAST, SCOREP_TUNING_FUNCTION, frequencyAction, 1500 );
+    }
+
+    ~Substrate() {
+        info.finalize();
+        free( functions );
+    }
+
+    void counters( uint64_t& applied,
+                   uint64_t& suppressed ) {
+        scorep_tuning_location_counters( &applied, &suppressed );
+    }
+};
+
+static struct SCOREP_Location* location( int i ) {
+    static char locations[ 4 ];
+    return ( struct SCOREP_Location* )&locations[ i ];
+}
+
+
+BOOST_AUTO_TEST_CASE( nested_regions_with_the_same_value ) {
+    Substrate substrate;
+    uint64_t  applied, suppressed;
+
+    for( int iteration = 0; iteration < 100; iteration++ ) {
+        substrate.enter( location( 0 ), 0, OUTER, NULL );
+        substrate.enter( location( 0 ), 0, INNER, NULL );
+        BOOST_CHECK_EQUAL( frequency, 2000 );
+        substrate.enter( location( 0 ), 0, UNTUNED, NULL );
+        substrate.exit( location( 0 ), 0, UNTUNED, NULL );
+        substrate.exit( location( 0 ), 0, INNER, NULL );
+        BOOST_CHECK_EQUAL( frequency, 2000 );
+        substrate.exit( location( 0 ), 0, OUTER, NULL );
+        BOOST_CHECK_EQUAL( frequency, 1000 );
+    }
+
+    // the outer region sets and restores the frequency, the inner region changes nothing
+    BOOST_CHECK_EQUAL( frequencyCalls.size(), 200u );
+    BOOST_CHECK_EQUAL( threads, 4u );
+    substrate.counters( applied, suppressed );
+    BOOST_CHECK_EQUAL( applied, 200u );
+    BOOST_CHECK_EQUAL( suppressed, 400u );
+}
+
+
+BOOST_AUTO_TEST_CASE( restores_values_of_differing_regions ) {
+    Substrate substrate;
+    uint64_t  applied, suppressed;
+
+    substrate.enter( location( 0 ), 0, OUTER, NULL );
+    substrate.enter( location( 0 ), 0, FAST, NULL );
+    BOOST_CHECK_EQUAL( frequency, 1500 );
+    substrate.enter( location( 0 ), 0, INNER, NULL );
+    BOOST_CHECK_EQUAL( frequency, 2000 );
+    substrate.exit( location( 0 ), 0, INNER, NULL );
+    BOOST_CHECK_EQUAL( frequency, 1500 );
+    substrate.exit( location( 0 ), 0, FAST, NULL );
+    BOOST_CHECK_EQUAL( frequency, 2000 );
+    substrate.exit( location( 0 ), 0, OUTER, NULL );
+    BOOST_CHECK_EQUAL( frequency, 1000 );
+
+    BOOST_CHECK( frequencyCalls == vector< int >( { 2000, 1500, 2000, 1500, 2000, 1000 } ) );
+    substrate.counters( applied, suppressed );
+    BOOST_CHECK_EQUAL( applied, 6u );
+    BOOST_CHECK_EQUAL( suppressed, 2u );
+}
+
+
+BOOST_AUTO_TEST_CASE( locations_are_tracked_separately ) {
+    Substrate substrate;
+    uint64_t  applied, suppressed;
+
+    substrate.enter( location( 0 ), 0, OUTER, NULL );
+    substrate.enter( location( 1 ), 0, OUTER, NULL );
+    substrate.enter( location( 1 ), 0, INNER, NULL );
+    substrate.enter( location( 0 ), 0, INNER, NULL );
+    substrate.exit( location( 0 ), 0, INNER, NULL );
+    substrate.exit( location( 1 ), 0, INNER, NULL );
+    substrate.exit( location( 1 ), 0, OUTER, NULL );
+    substrate.exit( location( 0 ), 0, OUTER, NULL );
+
+    // the second location does not know the value set by the first, so it applies its own; its
+    // restore value is the one it found, 2000, which it already has
+    BOOST_CHECK( frequencyCalls == vector< int >( { 2000, 2000, 1000 } ) );
+    substrate.counters( applied, suppressed );
+    BOOST_CHECK_EQUAL( applied, 3u );
+    BOOST_CHECK_EQUAL( suppressed, 9u );
+
+    // a deleted location keeps its counters
+    substrate.info.delete_location( location( 1 ) );
+    substrate.counters( applied, suppressed );
+    BOOST_CHECK_EQUAL( applied, 3u );
+    BOOST_CHECK_EQUAL( suppressed, 9u );
+}
+
+
+BOOST_AUTO_TEST_CASE( exit_without_enter ) {
+    Substrate substrate;
+
+    substrate.exit( location( 0 ), 0, OUTER, NULL );
+    BOOST_CHECK( frequencyCalls.empty() );
+    BOOST_CHECK_EQUAL( frequency, 1000 );
+}
+
+
+BOOST_AUTO_TEST_CASE( suppression_disabled ) {
+    Substrate substrate( "0" );
+    uint64_t  applied, suppressed;
+
+    substrate.enter( location( 0 ), 0, OUTER, NULL );
+    substrate.enter( location( 0 ), 0, INNER, NULL );
+    substrate.exit( location( 0 ), 0, INNER, NULL );
+    substrate.exit( location( 0 ), 0, OUTER, NULL );
+
+    BOOST_CHECK( frequencyCalls == vector< int >( { 2000, 2000, 2000, 1000 } ) );
+    BOOST_CHECK_EQUAL( frequency, 1000 );
+    substrate.counters( applied, suppressed );
+    BOOST_CHECK_EQUAL( applied, 6u );
+    BOOST_CHECK_EQUAL( suppressed, 0u );
+}
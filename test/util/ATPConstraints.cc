@@ -0,0 +1,193 @@
+#define BOOST_TEST_MODULE ATPConstraints
+
+#include <boost/test/included/unit_test.hpp>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ATPConstraints.h"
+
+typedef std::vector< int32_t >                         Configuration;
+typedef std::function< bool ( const Configuration& ) > Predicate;
+
+/* Every configuration of the cartesian product that satisfies all predicates, in lexicographic order */
+static std::vector< Configuration > bruteForce( const ATPConstraintSpace&       space,
+                                                const std::vector< Predicate >& predicates ) {
+    std::vector< Configuration > valid;
+    Configuration                current( space.parameters() );
+    std::vector< size_t >        position( space.parameters(), 0 );
+    for( size_t i = 0; i < space.parameters(); i++ ) {
+        if( space.values( i ).empty() ) {
+            return valid;
+        }
+    }
+    for(;; ) {
+        for( size_t i = 0; i < space.parameters(); i++ ) {
+            current[ i ] = space.values( i )[ position[ i ] ];
+        }
+        bool holds = true;
+        for( const auto& predicate : predicates ) {
+            holds = holds && predicate( current );
+        }
+        if( holds ) {
+            valid.push_back( current );
+        }
+        size_t i = space.parameters();
+        while( i > 0 && ++position[ i - 1 ] == space.values( i - 1 ).size() ) {
+            position[ --i ] = 0;
+        }
+        if( i == 0 ) {
+            return valid;
+        }
+    }
+}
+
+static std::vector< Configuration > enumerateAll( const ATPConstraintSpace& space ) {
+    std::vector< Configuration >   valid;
+    ATPConstraintSpace::Enumerator walk = space.enumerate();
+    Configuration                  values;
+    while( walk.next( values ) ) {
+        valid.push_back( values );
+    }
+    return valid;
+}
+
+static std::vector< int32_t > range( int32_t min,
+                                     int32_t max,
+                                     int32_t step ) {
+    std::vector< int32_t > values;
+    for( int32_t value = min; value <= max; value += step ) {
+        values.push_back( value );
+    }
+    return values;
+}
+
+static bool holds( const std::string&   text,
+                   const Configuration& values = Configuration() ) {
+    std::vector< std::string > names = { "a", "b", "c" };
+    ATPConstraint              constraint;
+    std::string                error;
+    BOOST_REQUIRE_MESSAGE( ATPConstraint::compile( text, names, constraint, error ), text + ": " + error );
+    return constraint.holds( values );
+}
+
+
+BOOST_AUTO_TEST_CASE( expressions_follow_c ) {
+    BOOST_CHECK( holds( "1 + 2 * 3 == 7" ) );
+    BOOST_CHECK( holds( "(1 + 2) * 3 == 9" ) );
+    BOOST_CHECK( holds( "7 / 2 == 3 && 7 % 2 == 1 && -7 / 2 == -3" ) );
+    BOOST_CHECK( holds( "0 || 1 && 0" ) == false );
+    BOOST_CHECK( holds( "!0 && !!5 && 1 != 2 && 2 <= 2 && 3 >= 2 && 1 < 2 && 2 > 1" ) );
+    BOOST_CHECK( holds( "1 < 2 == 1" ) );
+    BOOST_CHECK( holds( "a * b <= c", { 3, 4, 12 } ) );
+    BOOST_CHECK( !holds( "a * b <= c", { 3, 4, 11 } ) );
+    BOOST_CHECK( holds( "c % a == 0", { 4, 0, 16 } ) );
+
+    // a division by zero fails the constraint instead of the evaluation
+    BOOST_CHECK( !holds( "c / a >= 0", { 0, 1, 2 } ) );
+    BOOST_CHECK( !holds( "c % b == 0 || 1", { 1, 0, 2 } ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( syntax_errors_are_reported ) {
+    std::vector< std::string > names = { "threads", "block" };
+    ATPConstraint              constraint;
+    std::string                error;
+    BOOST_CHECK( !ATPConstraint::compile( "threads <", names, constraint, error ) );
+    BOOST_CHECK( !error.empty() );
+    BOOST_CHECK( !ATPConstraint::compile( "(threads + 1", names, constraint, error ) );
+    BOOST_CHECK( error.find( "')'" ) != std::string::npos );
+    BOOST_CHECK( !ATPConstraint::compile( "cores > 2", names, constraint, error ) );
+    BOOST_CHECK( error.find( "cores" ) != std::string::npos );
+    BOOST_CHECK( !ATPConstraint::compile( "threads = 2", names, constraint, error ) );
+
+    BOOST_REQUIRE( ATPConstraint::compile( "block >= threads", names, constraint, error ) );
+    BOOST_CHECK_EQUAL( constraint.last(), 1 );
+    BOOST_REQUIRE( ATPConstraint::compile( "2 > 1", names, constraint, error ) );
+    BOOST_CHECK_EQUAL( constraint.last(), -1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( enumeration_matches_brute_force ) {
+    ATPConstraintSpace space;
+    space.addParameter( "threads", range( 1, 16, 1 ) );
+    space.addParameter( "block", range( 16, 256, 16 ) );
+    space.addParameter( "unroll", { 1, 2, 4, 8 } );
+    space.addParameter( "tile", range( 8, 64, 8 ) );
+
+    std::string error;
+    BOOST_REQUIRE( space.addConstraint( "threads % 2 == 0 || threads == 1", error ) );
+    BOOST_REQUIRE( space.addConstraint( "block % threads == 0", error ) );
+    BOOST_REQUIRE( space.addConstraint( "unroll * threads <= 32", error ) );
+    BOOST_REQUIRE( space.addConstraint( "tile <= block && (block / tile) % unroll == 0", error ) );
+    BOOST_REQUIRE( space.addConstraint( "1", error ) );
+
+    std::vector< Predicate > predicates = {
+        []( const Configuration& v ) { return v[ 0 ] % 2 == 0 || v[ 0 ] == 1; },
+        []( const Configuration& v ) { return v[ 1 ] % v[ 0 ] == 0; },
+        []( const Configuration& v ) { return v[ 2 ] * v[ 0 ] <= 32; },
+        []( const Configuration& v ) { return v[ 3 ] <= v[ 1 ] && ( v[ 1 ] / v[ 3 ] ) % v[ 2 ] == 0; }
+    };
+
+    std::vector< Configuration > expected = bruteForce( space, predicates );
+    BOOST_REQUIRE( !expected.empty() );
+    BOOST_CHECK( enumerateAll( space ) == expected );
+    BOOST_CHECK_EQUAL( space.count(), expected.size() );
+    for( const auto& configuration : expected ) {
+        BOOST_CHECK( space.isValid( configuration ) );
+    }
+    BOOST_CHECK_EQUAL( space.index( "unroll" ), 2 );
+    BOOST_CHECK_EQUAL( space.index( "cores" ), -1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( degenerate_spaces ) {
+    std::string error;
+
+    ATPConstraintSpace unconstrained;
+    unconstrained.addParameter( "a", { 1, 2, 3 } );
+    unconstrained.addParameter( "b", { 4, 5 } );
+    BOOST_CHECK_EQUAL( unconstrained.count(), 6u );
+
+    ATPConstraintSpace impossible;
+    impossible.addParameter( "a", { 1, 2, 3 } );
+    BOOST_REQUIRE( impossible.addConstraint( "a > 3", error ) );
+    BOOST_CHECK_EQUAL( impossible.count(), 0u );
+    std::mt19937  random( 1 );
+    Configuration values;
+    BOOST_CHECK( !impossible.sample( random, values ) );
+
+    ATPConstraintSpace constantFalse;
+    constantFalse.addParameter( "a", { 1, 2, 3 } );
+    BOOST_REQUIRE( constantFalse.addConstraint( "1 > 2", error ) );
+    BOOST_CHECK_EQUAL( constantFalse.count(), 0u );
+    BOOST_CHECK( !constantFalse.sample( random, values ) );
+
+    ATPConstraintSpace empty;
+    BOOST_CHECK_EQUAL( empty.count(), 1u );
+}
+
+
+BOOST_AUTO_TEST_CASE( samples_are_valid_and_cover_the_space ) {
+    ATPConstraintSpace space;
+    space.addParameter( "a", range( 0, 9, 1 ) );
+    space.addParameter( "b", range( 0, 9, 1 ) );
+    space.addParameter( "c", range( 0, 9, 1 ) );
+    std::string error;
+    BOOST_REQUIRE( space.addConstraint( "a < b && b < c", error ) );
+    BOOST_REQUIRE( space.addConstraint( "a + b + c == 12", error ) );
+
+    std::vector< Configuration > all = enumerateAll( space );
+    BOOST_REQUIRE_EQUAL( all.size(), 10u );
+
+    std::mt19937              random( 42 );
+    std::set< Configuration > seen;
+    for( int i = 0; i < 2000; i++ ) {
+        Configuration values;
+        BOOST_REQUIRE( space.sample( random, values ) );
+        BOOST_CHECK( space.isValid( values ) );
+        seen.insert( values );
+    }
+    BOOST_CHECK_EQUAL( seen.size(), all.size() );
+}
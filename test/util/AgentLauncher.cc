@@ -0,0 +1,181 @@
+#define BOOST_TEST_MODULE AgentLauncher
+
+#include <boost/test/included/unit_test.hpp>
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "AgentLauncher.h"
+
+/* Local-only launches: every agent is a shell replaced by a sleeping process, no ssh involved. */
+static AgentLaunch agent( const std::string& tag, const std::string& parent, const std::string& command = "exec sleep 30" ) {
+    AgentLaunch launch;
+    launch.tag     = tag;
+    launch.parent  = parent;
+    launch.host    = "localhost";
+    launch.command = command;
+    return launch;
+}
+
+static std::string temporary( const char* name ) {
+    std::stringstream file;
+    file << "/tmp/" << name << "." << getpid();
+    return file.str();
+}
+
+static void stop( AgentLauncher& launcher, const std::vector< std::string >& tags ) {
+    for( size_t i = 0; i < tags.size(); i++ ) {
+        const AgentLaunch* launch = launcher.find( tags[ i ] );
+        if( launch && launch->pid > 0 ) {
+            kill( launch->pid, SIGKILL );
+        }
+        while( launcher.alive( tags[ i ] ) ) {
+            usleep( 1000 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( window_bounds_launches_in_flight ) {
+    AgentLauncher              launcher( 2, 60.0 );
+    std::vector< std::string > tags;
+    for( int i = 0; i < 5; i++ ) {
+        std::stringstream tag;
+        tag << "fe[0]:0:" << i;
+        tags.push_back( tag.str() );
+        BOOST_REQUIRE( launcher.add( agent( tag.str(), "fe[0]:0" ) ) );
+    }
+    BOOST_CHECK( !launcher.add( agent( tags[ 0 ], "fe[0]:0" ) ) );
+
+    BOOST_CHECK_EQUAL( launcher.dispatch(), 2 );
+    BOOST_CHECK_EQUAL( launcher.inFlight(), 2 );
+    BOOST_CHECK_EQUAL( launcher.queued(), 3 );
+
+    // every report frees one slot
+    BOOST_CHECK( launcher.ready( tags[ 0 ] ) );
+    BOOST_CHECK_EQUAL( launcher.queued(), 2 );
+    BOOST_CHECK( launcher.ready( tags[ 1 ] ) );
+    BOOST_CHECK( launcher.ready( tags[ 2 ] ) );
+    BOOST_CHECK( launcher.ready( tags[ 3 ] ) );
+    BOOST_CHECK( launcher.ready( tags[ 4 ] ) );
+    BOOST_CHECK_EQUAL( launcher.queued(), 0 );
+    BOOST_CHECK_EQUAL( launcher.inFlight(), 0 );
+    BOOST_CHECK( !launcher.ready( "unknown" ) );
+
+    for( size_t i = 0; i < tags.size(); i++ ) {
+        const AgentLaunch* launch = launcher.find( tags[ i ] );
+        BOOST_REQUIRE( launch != NULL );
+        BOOST_CHECK_EQUAL( launch->starts, 1 );
+        BOOST_CHECK( launch->ready >= launch->launched );
+        BOOST_CHECK( launcher.alive( tags[ i ] ) );
+    }
+    stop( launcher, tags );
+}
+
+BOOST_AUTO_TEST_CASE( stale_launches_release_the_window ) {
+    AgentLauncher launcher( 1, 0.05 );
+    launcher.add( agent( "a", "fe" ) );
+    launcher.add( agent( "b", "fe" ) );
+
+    BOOST_CHECK_EQUAL( launcher.dispatch(), 1 );
+    BOOST_CHECK_EQUAL( launcher.dispatch(), 0 );
+    usleep( 100000 );
+    // "a" never reported, the next launch goes ahead anyway
+    BOOST_CHECK_EQUAL( launcher.dispatch(), 1 );
+    BOOST_CHECK_EQUAL( launcher.queued(), 0 );
+
+    std::vector< std::string > tags = { "a", "b" };
+    stop( launcher, tags );
+}
+
+BOOST_AUTO_TEST_CASE( warm_restart_relaunches_only_exited_agents ) {
+    AgentLauncher launcher;
+    launcher.add( agent( "alive", "fe" ) );
+    launcher.add( agent( "crashes", "fe" ) );
+    launcher.dispatch();
+    pid_t kept = launcher.find( "alive" )->pid;
+
+    kill( launcher.find( "crashes" )->pid, SIGKILL );
+    usleep( 50000 );
+
+    std::vector< std::string > relaunched = launcher.relaunchDead();
+    BOOST_REQUIRE_EQUAL( relaunched.size(), 1 );
+    BOOST_CHECK_EQUAL( relaunched[ 0 ], "crashes" );
+    BOOST_CHECK_EQUAL( launcher.find( "alive" )->pid, kept );
+    BOOST_CHECK_EQUAL( launcher.find( "alive" )->starts, 1 );
+    BOOST_CHECK_EQUAL( launcher.find( "crashes" )->starts, 2 );
+    BOOST_CHECK( launcher.alive( "crashes" ) );
+    BOOST_CHECK( launcher.relaunchDead().empty() );
+
+    std::vector< std::string > tags = { "alive", "crashes" };
+    stop( launcher, tags );
+}
+
+BOOST_AUTO_TEST_CASE( agents_reaped_elsewhere_are_dead ) {
+    AgentLauncher launcher;
+    launcher.add( agent( "reaped", "fe" ) );
+    launcher.dispatch();
+    pid_t pid = launcher.find( "reaped" )->pid;
+
+    int status;
+    kill( pid, SIGKILL );
+    BOOST_REQUIRE_EQUAL( waitpid( pid, &status, 0 ), pid );
+
+    BOOST_CHECK( !launcher.alive( "reaped" ) );
+    BOOST_CHECK_EQUAL( launcher.find( "reaped" )->pid, -1 );
+    std::vector< std::string > relaunched = launcher.relaunchDead();
+    BOOST_REQUIRE_EQUAL( relaunched.size(), 1 );
+    BOOST_CHECK( launcher.alive( "reaped" ) );
+
+    std::vector< std::string > tags = { "reaped" };
+    stop( launcher, tags );
+}
+
+BOOST_AUTO_TEST_CASE( plan_fans_out_along_the_tree ) {
+    std::string                plan_file = temporary( "psc_launch_plan" );
+    std::string                log       = temporary( "psc_launch_log" );
+    std::vector< AgentLaunch > plan;
+
+    // fe -> hl -> { aa0, aa1, aa2 }; the high-level agent launches its children from the same plan
+    plan.push_back( agent( "hl", "fe", "exec true" ) );
+    for( int i = 0; i < 3; i++ ) {
+        std::stringstream tag;
+        tag << "aa" << i;
+        plan.push_back( agent( tag.str(), "hl", "echo " + tag.str() + " >> " + log ) );
+    }
+    plan[ 1 ].workdir = "/tmp";
+    BOOST_REQUIRE( AgentLauncher::writePlan( plan_file, plan ) );
+
+    AgentLauncher frontend;
+    BOOST_CHECK_EQUAL( frontend.readPlan( plan_file, "fe" ), 1 );
+    BOOST_CHECK( frontend.find( "aa0" ) == NULL );
+
+    AgentLauncher hl;
+    BOOST_CHECK_EQUAL( hl.readPlan( plan_file, "hl" ), 3 );
+    BOOST_CHECK_EQUAL( hl.find( "aa0" )->workdir, "/tmp" );
+    BOOST_CHECK_EQUAL( hl.find( "aa2" )->command, plan[ 3 ].command );
+    BOOST_CHECK_EQUAL( hl.dispatch(), 3 );
+    for( int i = 0; i < 3; i++ ) {
+        std::stringstream tag;
+        tag << "aa" << i;
+        while( hl.alive( tag.str() ) ) {
+            usleep( 1000 );
+        }
+    }
+
+    std::ifstream in( log.c_str() );
+    std::string   line;
+    int           lines = 0;
+    while( std::getline( in, line ) ) {
+        lines++;
+    }
+    BOOST_CHECK_EQUAL( lines, 3 );
+    BOOST_CHECK_EQUAL( hl.readPlan( "/nonexistent/plan", "hl" ), -1 );
+
+    unlink( plan_file.c_str() );
+    unlink( log.c_str() );
+}
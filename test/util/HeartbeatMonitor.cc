@@ -0,0 +1,383 @@
+#define BOOST_TEST_MODULE HeartbeatMonitor
+
+#include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "HeartbeatMonitor.h"
+
+/* An in-process agent tree on one host: a frontend, high-level agents and analysis agents. Messages
+   go through encode() and decode() like the heartbeat messages do, time is simulated. */
+struct SimulatedAgent {
+    std::string      tag;
+    int              parent;
+    int              processes;
+    bool             alive;
+    HeartbeatMonitor monitor;
+    int              received;
+
+    SimulatedAgent() : parent( -1 ), processes( 0 ), alive( true ), monitor( 10.0 ), received( 0 ) {
+    }
+};
+
+struct SimulatedTree {
+    std::vector< SimulatedAgent > agents;
+
+    // frontend "fe", highLevel agents "hl<i>" with leaves analysis agents "aa<i>.<j>" each
+    SimulatedTree( int highLevel,
+                   int leaves,
+                   int processes ) {
+        agents.push_back( make( "fe", -1, 0 ) );
+        for( int i = 0; i < highLevel; i++ ) {
+            std::stringstream hl;
+            hl << "hl" << i;
+            int parent = agents.size();
+            agents.push_back( make( hl.str(), 0, 0 ) );
+            agents[ 0 ].monitor.expect( hl.str(), 0 );
+            for( int j = 0; j < leaves; j++ ) {
+                std::stringstream aa;
+                aa << "aa" << i << "." << j;
+                agents.push_back( make( aa.str(), parent, processes ) );
+                agents[ parent ].monitor.expect( aa.str(), 0 );
+            }
+        }
+    }
+
+    static SimulatedAgent make( const std::string& tag,
+                                int                parent,
+                                int                processes ) {
+        SimulatedAgent agent;
+        agent.tag       = tag;
+        agent.parent    = parent;
+        agent.processes = processes;
+        agent.monitor.setOwnProcesses( processes );
+        return agent;
+    }
+
+    int find( const std::string& tag ) const {
+        for( size_t i = 0; i < agents.size(); i++ ) {
+            if( agents[ i ].tag == tag ) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void send( SimulatedAgent& agent,
+               double          now ) {
+        SimulatedAgent& parent = agents[ agent.parent ];
+        SubtreeHeartbeat decoded;
+        BOOST_REQUIRE( SubtreeHeartbeat::decode( agent.monitor.flush( now ).encode(), decoded ) );
+        parent.monitor.beat( agent.tag, decoded, now );
+        parent.received++;
+    }
+
+    // every live agent sends its summary once, the deepest first like a timer tick of each agent
+    void tick( double now ) {
+        for( size_t i = agents.size(); i-- > 1; ) {
+            if( agents[ i ].alive && agents[ i ].monitor.children() == 0 ) {
+                send( agents[ i ], now );
+            }
+        }
+        for( size_t i = agents.size(); i-- > 1; ) {
+            if( agents[ i ].alive && agents[ i ].monitor.children() > 0 ) {
+                send( agents[ i ], now );
+            }
+        }
+    }
+
+    HeartbeatMonitor& frontend() {
+        return agents[ 0 ].monitor;
+    }
+};
+
+
+BOOST_AUTO_TEST_CASE( summary_encoding ) {
+    SubtreeHeartbeat subtree;
+    subtree.agents    = 7;
+    subtree.processes = 112;
+    subtree.expected  = 9;
+    subtree.missing.push_back( "fe[0]:0:1" );
+    subtree.missing.push_back( "fe[0]:2" );
+
+    SubtreeHeartbeat decoded;
+    BOOST_REQUIRE( SubtreeHeartbeat::decode( subtree.encode(), decoded ) );
+    BOOST_CHECK( decoded == subtree );
+
+    BOOST_REQUIRE( SubtreeHeartbeat::decode( SubtreeHeartbeat().encode(), decoded ) );
+    BOOST_CHECK( decoded == SubtreeHeartbeat() );
+    BOOST_CHECK( decoded.missing.empty() );
+
+    BOOST_CHECK( !SubtreeHeartbeat::decode( "", decoded ) );
+    BOOST_CHECK( !SubtreeHeartbeat::decode( "3 x 4", decoded ) );
+    BOOST_CHECK( !SubtreeHeartbeat::decode( "5 0 4", decoded ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( startup_is_aggregated_per_subtree ) {
+    SimulatedTree tree( 4, 8, 16 );
+
+    // the analysis agents come up one after another; the high-level agents batch them
+    double now = 0;
+    for( size_t i = 1; i < tree.agents.size(); i++ ) {
+        tree.agents[ i ].alive = false;
+    }
+    for( size_t i = 1; i < tree.agents.size(); i++ ) {
+        tree.agents[ i ].alive = true;
+        if( i % 9 == 0 || i + 1 == tree.agents.size() ) {
+            now += 1;
+            tree.tick( now );
+        }
+    }
+    BOOST_CHECK( tree.frontend().complete() );
+
+    SubtreeHeartbeat total = tree.frontend().summary( now );
+    BOOST_CHECK_EQUAL( total.agents, 37 );
+    BOOST_CHECK_EQUAL( total.expected, 37 );
+    BOOST_CHECK_EQUAL( total.processes, 4 * 8 * 16 );
+    BOOST_CHECK( total.missing.empty() );
+
+    // one message per high-level agent and tick instead of one per agent of the tree
+    BOOST_CHECK( tree.agents[ 0 ].received <= 4 * ( int )now );
+    for( size_t i = 1; i < tree.agents.size(); i++ ) {
+        if( tree.agents[ i ].monitor.children() > 0 ) {
+            BOOST_CHECK_EQUAL( tree.agents[ i ].monitor.summary( now ).agents, 9 );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( dead_analysis_agent_is_reported_by_its_parent ) {
+    SimulatedTree tree( 2, 3, 4 );
+    double        now = 0;
+    for( ; now < 5; now++ ) {
+        tree.tick( now );
+    }
+    BOOST_CHECK( tree.frontend().pending( now ) );
+    BOOST_CHECK( tree.frontend().flush( now ).missing.empty() );
+    BOOST_CHECK( !tree.frontend().pending( now ) );
+
+    tree.agents[ tree.find( "aa1.2" ) ].alive = false;
+    for( ; now < 16; now++ ) {
+        tree.tick( now );
+        BOOST_CHECK( tree.frontend().overdue( now ).empty() );
+    }
+
+    int parent = tree.find( "hl1" );
+    BOOST_CHECK( tree.agents[ parent ].monitor.expire( now ) == std::vector< std::string >( 1, "aa1.2" ) );
+    BOOST_CHECK( tree.agents[ parent ].monitor.expire( now ).empty() );
+
+    SubtreeHeartbeat total = tree.frontend().summary( now );
+    BOOST_CHECK_EQUAL( total.agents, 8 );
+    BOOST_CHECK_EQUAL( total.expected, 9 );
+    BOOST_CHECK_EQUAL( total.processes, 5 * 4 );
+    BOOST_CHECK( total.missing == std::vector< std::string >( 1, "aa1.2" ) );
+    BOOST_CHECK( tree.frontend().pending( now ) );
+
+    // it comes back, for instance after a relaunch
+    tree.agents[ tree.find( "aa1.2" ) ].alive = true;
+    tree.tick( now );
+    BOOST_CHECK( tree.frontend().summary( now ).missing.empty() );
+    BOOST_CHECK_EQUAL( tree.frontend().summary( now ).agents, 9 );
+}
+
+
+BOOST_AUTO_TEST_CASE( dead_subtree_is_reported_as_a_whole ) {
+    SimulatedTree tree( 3, 4, 2 );
+    double        now = 0;
+    for( ; now < 3; now++ ) {
+        tree.tick( now );
+    }
+
+    // the high-level agent dies, its children can no longer reach the frontend
+    tree.agents[ tree.find( "hl0" ) ].alive = false;
+    for( ; now < 20; now++ ) {
+        tree.tick( now );
+    }
+
+    BOOST_CHECK( tree.frontend().overdue( now ) == std::vector< std::string >( 1, "hl0" ) );
+    BOOST_CHECK( tree.frontend().expire( now ) == std::vector< std::string >( 1, "hl0" ) );
+    const SubtreeHeartbeat* failed = tree.frontend().latest( "hl0" );
+    BOOST_REQUIRE( failed );
+    BOOST_CHECK_EQUAL( failed->agents, 5 );
+    BOOST_CHECK_EQUAL( failed->processes, 8 );
+
+    SubtreeHeartbeat total = tree.frontend().summary( now );
+    BOOST_CHECK_EQUAL( total.agents, 11 );
+    BOOST_CHECK_EQUAL( total.expected, 16 );
+    BOOST_CHECK_EQUAL( total.processes, 16 );
+    BOOST_CHECK( total.missing == std::vector< std::string >( 1, "hl0" ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( silent_child_misses_the_startup_deadline ) {
+    HeartbeatMonitor monitor( 5.0 );
+    BOOST_CHECK( monitor.expect( "a", 0 ) );
+    BOOST_CHECK( monitor.expect( "b", 0 ) );
+    BOOST_CHECK( !monitor.expect( "a", 1 ) );
+
+    monitor.beat( "a", 3, 1 );
+    BOOST_CHECK( !monitor.complete() );
+    BOOST_CHECK( monitor.summary( 4 ).missing.empty() );
+    BOOST_CHECK_EQUAL( monitor.summary( 4 ).agents, 2 );
+    BOOST_CHECK_EQUAL( monitor.summary( 4 ).expected, 3 );
+    BOOST_CHECK( monitor.overdue( 5.5 ) == std::vector< std::string >( 1, "b" ) );
+
+    // processes reported after the first heartbeat add up
+    monitor.addProcesses( "a", 2, 5 );
+    BOOST_CHECK_EQUAL( monitor.summary( 5 ).processes, 5 );
+    monitor.addProcesses( "c", 1, 5 );
+    BOOST_CHECK_EQUAL( monitor.summary( 5 ).processes, 6 );
+    BOOST_CHECK_EQUAL( monitor.children(), 3u );
+
+    // a dismissed child is no longer waited for
+    BOOST_CHECK( monitor.forget( "b" ) );
+    BOOST_CHECK( !monitor.forget( "b" ) );
+    BOOST_CHECK( monitor.complete() );
+    BOOST_CHECK( monitor.overdue( 5.5 ).empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( restart_waits_for_every_child_again ) {
+    HeartbeatMonitor monitor( 5.0 );
+    monitor.expect( "a", 0 );
+    monitor.expect( "b", 0 );
+    monitor.beat( "a", 1, 1 );
+    monitor.beat( "b", 1, 1 );
+    BOOST_CHECK( monitor.complete() );
+
+    monitor.restart( 20 );
+    BOOST_CHECK( !monitor.complete() );
+    BOOST_CHECK( monitor.overdue( 24 ).empty() );
+    BOOST_CHECK_EQUAL( monitor.summary( 24 ).agents, 1 );
+    BOOST_CHECK_EQUAL( monitor.summary( 24 ).expected, 3 );
+    monitor.beat( "a", 1, 23 );
+    BOOST_CHECK( monitor.expire( 26 ) == std::vector< std::string >( 1, "b" ) );
+    BOOST_CHECK( monitor.expire( 27 ).empty() );
+    monitor.beat( "b", 1, 28 );
+    BOOST_CHECK( monitor.complete() );
+    BOOST_CHECK( monitor.expire( 28 ).empty() );
+    BOOST_CHECK_EQUAL( monitor.expire( 40 ).size(), 2u );
+
+    // without a deadline nothing is ever overdue
+    monitor.setDeadline( 0 );
+    BOOST_CHECK( monitor.overdue( 1000 ).empty() );
+    BOOST_CHECK_EQUAL( monitor.summary( 1000 ).agents, 3 );
+}
+
+
+/* The heartbeats of the startup of a frontend, a high-level agent and two analysis agents in the
+   order the agents send them, handled the way the heartbeat handlers of the frontend and of the
+   high-level agent record them. The frontend starts the search once the processes of the summary
+   reach the number of application processes, like PeriscopeFrontend::update_started_processes(). */
+struct StartupReplay {
+    HeartbeatMonitor frontend;
+    HeartbeatMonitor highLevel;
+    int              processes;
+    int              starts;
+    double           now;
+
+    StartupReplay( int processes ) : processes( processes ), starts( 0 ), now( 0 ) {
+        frontend.expect( "hl", 0 );
+        highLevel.expect( "aa0", 0 );
+        highLevel.expect( "aa1", 0 );
+    }
+
+    // ACCL_HLAgent_Handler::on_heartbeat
+    void toHighLevel( const std::string& tag,
+                      bool               forwarded,
+                      int                procs ) {
+        if( forwarded ) {
+            highLevel.addProcesses( tag, procs, now );
+        }
+        else {
+            highLevel.beat( tag, procs, now );
+        }
+    }
+
+    // ACCL_Frontend_Handler::on_heartbeat of the own heartbeat of the high-level agent
+    void ownToFrontend() {
+        frontend.beat( "hl", 0, now );
+        started();
+    }
+
+    // liveness tick of the high-level agent without a deadline: only changed summaries are sent
+    void tick() {
+        now += 1;
+        if( highLevel.pending( now ) ) {
+            SubtreeHeartbeat decoded;
+            BOOST_REQUIRE( SubtreeHeartbeat::decode( highLevel.flush( now ).encode(), decoded ) );
+            frontend.beat( "hl", decoded, now );
+            started();
+        }
+    }
+
+    void started() {
+        if( frontend.summary( now ).processes == processes ) {
+            starts++;
+        }
+    }
+
+    int frontendProcesses() {
+        return frontend.summary( now ).processes;
+    }
+};
+
+
+BOOST_AUTO_TEST_CASE( startup_own_heartbeat_after_the_summary ) {
+    // the high-level agent sends its own heartbeat once both children are up, after its first tick
+    StartupReplay replay( 8 );
+    replay.tick();
+    replay.toHighLevel( "aa0", false, 4 );
+    replay.toHighLevel( "aa1", false, 4 );
+    replay.tick();
+    BOOST_CHECK_EQUAL( replay.frontendProcesses(), 8 );
+    replay.ownToFrontend();
+    BOOST_CHECK( replay.frontend.complete() );
+    BOOST_CHECK_EQUAL( replay.frontendProcesses(), 8 );
+    BOOST_CHECK_EQUAL( replay.frontend.summary( replay.now ).agents, 4 );
+
+    // nothing changes, nothing is sent, the frontend keeps the count
+    replay.tick();
+    replay.tick();
+    BOOST_CHECK_EQUAL( replay.frontendProcesses(), 8 );
+
+    // restart: the frontend waits again, the own heartbeat alone keeps the known subtree
+    replay.frontend.restart( replay.now );
+    replay.highLevel.restart( replay.now );
+    replay.toHighLevel( "aa0", false, 4 );
+    replay.toHighLevel( "aa1", false, 4 );
+    replay.ownToFrontend();
+    BOOST_CHECK( replay.frontend.complete() );
+    BOOST_CHECK_EQUAL( replay.frontendProcesses(), 8 );
+}
+
+
+BOOST_AUTO_TEST_CASE( startup_with_processes_attached_later ) {
+    // _BGP_PORT_HEARTBEAT_V1: the own heartbeat of the high-level agent comes first, the analysis
+    // agents report the processes they attach to later as forwarded heartbeats
+    StartupReplay replay( 8 );
+    replay.ownToFrontend();
+    replay.tick();
+    BOOST_CHECK_EQUAL( replay.frontendProcesses(), 0 );
+
+    replay.toHighLevel( "aa0", false, 1 );
+    replay.toHighLevel( "aa1", false, 0 );
+    replay.tick();
+    BOOST_CHECK_EQUAL( replay.frontendProcesses(), 1 );
+    replay.toHighLevel( "aa0", true, 3 );
+    replay.toHighLevel( "aa1", true, 2 );
+    replay.tick();
+    BOOST_CHECK_EQUAL( replay.frontendProcesses(), 6 );
+    BOOST_CHECK_EQUAL( replay.starts, 0 );
+    replay.toHighLevel( "aa1", true, 2 );
+    replay.tick();
+    BOOST_CHECK_EQUAL( replay.frontendProcesses(), 8 );
+    BOOST_CHECK_EQUAL( replay.starts, 1 );
+
+    replay.tick();
+    BOOST_CHECK_EQUAL( replay.starts, 1 );
+    BOOST_CHECK( replay.frontend.complete() );
+}
@@ -0,0 +1,164 @@
+/**
+   @file    ATPConstraints.h
+   @ingroup ATP Service
+   @brief   Constraint engine for application tuning parameter domains
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef ATP_CONSTRAINTS_H_INCLUDED
+#define ATP_CONSTRAINTS_H_INCLUDED
+
+#include <stdint.h>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One constraint of an ATP domain, compiled to postfix code
+ *
+ * The expressions use the C operators on integers: || && ! == != < <= > >= + - * / %, unary
+ * minus and parentheses. Identifiers are the parameter names of the domain. A constraint holds
+ * where its value is not 0; a division by zero makes it fail.
+ */
+class ATPConstraint {
+public:
+    ATPConstraint() : last_( -1 ) {
+    }
+
+    /// Compile an expression over the given parameter names; false with a message on a syntax error
+    static bool compile( const std::string&                text,
+                         const std::vector< std::string >& parameters,
+                         ATPConstraint&                    constraint,
+                         std::string&                      error );
+
+    /// Evaluate with the values of the parameters, in the order of the names given to compile()
+    bool holds( const std::vector< int32_t >& values ) const;
+
+    /// Highest parameter index the expression reads, -1 for a constant expression
+    int last() const {
+        return last_;
+    }
+
+    const std::string& text() const {
+        return text_;
+    }
+
+private:
+    enum Opcode {
+        CONSTANT, PARAMETER, NEGATE, NOT, MULTIPLY, DIVIDE, MODULO, ADD, SUBTRACT,
+        LESS, LESS_EQUAL, GREATER, GREATER_EQUAL, EQUAL, NOT_EQUAL, AND, OR
+    };
+
+    struct Instruction {
+        Opcode  opcode;
+        int64_t operand; ///< Value of CONSTANT, index of PARAMETER
+    };
+
+    friend class ATPConstraintParser;
+
+    std::string                text_;
+    std::vector< Instruction > code_;
+    int                        last_;
+};
+
+/**
+ * @class ATPConstraintSpace
+ * @ingroup ATP Service
+ *
+ * @brief Valid configurations of an ATP domain, enumerated lazily from the constraint expressions
+ *
+ * The domain is the product of the value lists of its parameters, restricted by the constraints.
+ * Enumeration and sampling assign the parameters in order and check every constraint as soon as
+ * the last parameter it reads is assigned, so invalid subtrees of the product are never expanded
+ * and no combination is stored.
+ */
+class ATPConstraintSpace {
+public:
+    /// Add a parameter with the values it can take; must precede the constraints reading it
+    void addParameter( const std::string&            name,
+                       const std::vector< int32_t >& values );
+
+    /// Compile and add a constraint; false with a message if it does not compile
+    bool addConstraint( const std::string& expression,
+                        std::string&       error );
+
+    size_t parameters() const {
+        return names_.size();
+    }
+
+    const std::string& name( size_t parameter ) const {
+        return names_[ parameter ];
+    }
+
+    /// Index of a parameter, -1 if the domain has none of that name
+    int index( const std::string& name ) const;
+
+    const std::vector< int32_t >& values( size_t parameter ) const {
+        return values_[ parameter ];
+    }
+
+    size_t constraints() const {
+        return constraints_.size();
+    }
+
+    /// Whether a full assignment satisfies every constraint
+    bool isValid( const std::vector< int32_t >& values ) const;
+
+    /**
+     * @brief Depth-first walk over the valid configurations in lexicographic order of the value lists
+     */
+    class Enumerator {
+    public:
+        /// Next valid configuration; false once all were returned
+        bool next( std::vector< int32_t >& values );
+
+    private:
+        friend class ATPConstraintSpace;
+
+        explicit Enumerator( const ATPConstraintSpace& space );
+
+        const ATPConstraintSpace* space_;
+        std::vector< size_t >     position_; ///< Index into the value list of each parameter
+        std::vector< int32_t >    current_;  ///< Values of the parameters assigned so far
+        size_t                    depth_;    ///< Parameter being assigned, past the end when done
+        bool                      started_;
+    };
+
+    Enumerator enumerate() const {
+        return Enumerator( *this );
+    }
+
+    /// Number of valid configurations, by enumeration
+    size_t count() const;
+
+    /**
+     * Draw a valid configuration by a randomized depth-first walk: every valid configuration can be
+     * drawn, with equal probability if the constraints prune the subtrees evenly. False if the
+     * domain has no valid configuration.
+     */
+    bool sample( std::mt19937&           random,
+                 std::vector< int32_t >& values ) const;
+
+private:
+    /// Whether the constraints that become decidable with parameter "depth" hold
+    bool admits( size_t                        depth,
+                 const std::vector< int32_t >& values ) const;
+
+    std::vector< std::string >            names_;
+    std::vector< std::vector< int32_t > > values_;
+    std::vector< ATPConstraint >          constraints_;
+    std::vector< std::vector< size_t > >  checks_;      ///< Constraints to check by the last parameter they read
+    std::vector< size_t >                 constant_;    ///< Constraints reading no parameter
+};
+
+#endif /* ATP_CONSTRAINTS_H_INCLUDED */
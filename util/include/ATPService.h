@@ -15,6 +15,7 @@
   See the COPYING file in the base directory of the package for details.
  */
 
+#include <memory>
 #include <unordered_set>
 #include <unordered_map>
 #include <sys/types.h>
@@ -26,6 +27,7 @@
 
 #include "regxx.h"
 #include "timing.h"
+#include "ATPConstraints.h"
 #include "TuningParameter.h"
 #include "Variant.h"
 
@@ -61,6 +63,10 @@ public:
     //std::unordered_set< std::unique_ptr <Variant>> getValidConfigurations (std::string&);
     std::unordered_map <int, std::vector<int32_t>>  getValidConfigurations (const char*);
 
+    /* get the constraint expressions of a domain to enumerate its valid configurations locally;
+       NULL unless ATP_CONSTRAINT_EXPRESSIONS is set and the server sends a space that compiles */
+    const ATPConstraintSpace* getConstraintSpace (const char*);
+
     /* get nearbyvalid configurations */
     std::unordered_set< std::unique_ptr <Variant>> getNearbyValidConfigurations (std::string&);
 
@@ -120,6 +126,8 @@ private:
     std::unordered_set <std::string> domains_;
     std::unordered_map <int,std::string> tp_index_name_mapping_;
     std::unordered_map<std::string, std::vector<std::string>> domain_paramNames_mapping_;
+    std::unordered_map<std::string, std::vector<int32_t>> param_values_; //values of each parameter from getATPSpecs, ranges expanded
+    std::unordered_map<std::string, std::unique_ptr<ATPConstraintSpace>> constraint_spaces_; //by domain, received once; NULL if unusable
     //std::unordered_map <std::string, std::vector< TuningParameter* > > domain_tp_mapping_;
     //std::unordered_map <int, std::vector<int32_t>> valid_combination_; //<0, <1(tp1),2(tp2)>>, <1,<2,4>>,<2,<1,4>> >
     //std::unordered_map<std::string,std::vector<std::int32_t >> valid_atp_mapping_; //<p1, <1,2,4>>, <p2,<2,4>>....
@@ -0,0 +1,112 @@
+/**
+   @file    AgentLauncher.h
+   @ingroup Communication
+   @brief   Bounded-parallel launcher for the agent hierarchy
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef AGENT_LAUNCHER_H_INCLUDED
+#define AGENT_LAUNCHER_H_INCLUDED
+
+#include <sys/types.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Launch description of one agent
+ *
+ * A launch plan is the list of these records for the whole hierarchy. Every agent launches the
+ * records whose parent is its own tag, so the frontend only starts the top-level agent and each
+ * high-level agent starts its own children.
+ */
+struct AgentLaunch {
+    std::string tag;      ///< Tag of the agent
+    std::string parent;   ///< Tag of the agent that launches it
+    std::string host;     ///< Host the agent runs on
+    std::string workdir;  ///< Working directory of the launch, empty to inherit the launcher's
+    std::string command;  ///< Shell command that starts the agent
+    pid_t       pid;      ///< Process started for the agent, -1 while queued
+    double      launched; ///< Wall time of the last launch
+    double      ready;    ///< Wall time the agent reported after the last launch, 0 while pending
+    int         starts;   ///< Number of launches
+
+    AgentLaunch() : pid( -1 ), launched( 0 ), ready( 0 ), starts( 0 ) {
+    }
+};
+
+/**
+ * @class AgentLauncher
+ * @ingroup Communication
+ *
+ * @brief Starts agents through fork and /bin/sh with a bounded number of launches in flight
+ *
+ * A launch is in flight from the fork until the agent reports through ready(). Launches that do not
+ * report within the stale interval stop counting against the window, so a lost heartbeat delays the
+ * remaining launches by at most that interval. The launcher keeps the processes it started to
+ * check them across application restarts: live agents are re-attached by the caller, dead ones are
+ * launched again with their original command.
+ */
+class AgentLauncher {
+public:
+    AgentLauncher( size_t window = 16,
+                   double stale = 10.0 );
+
+    /// Queue an agent; returns false if the tag is already known
+    bool add( const AgentLaunch& launch );
+
+    /// Start queued agents while the window has room; returns the number started
+    size_t dispatch();
+
+    /// Record that the agent reported and continue dispatching; false for unknown tags
+    bool ready( const std::string& tag );
+
+    /// Whether the process started for the agent is still running
+    bool alive( const std::string& tag );
+
+    /// Queue every started agent whose process exited and dispatch them; returns their tags
+    std::vector< std::string > relaunchDead();
+
+    /// Number of queued launches not yet started
+    size_t queued() const {
+        return queue_.size();
+    }
+
+    /// Number of started launches the window still waits for
+    size_t inFlight() const;
+
+    const AgentLaunch* find( const std::string& tag ) const;
+
+    /// Print the launch latencies of the agents that reported
+    void report() const;
+
+    /// Write the plan, one agent per line: parent, tag, host, workdir and command separated by tabs
+    static bool writePlan( const std::string&                file,
+                           const std::vector< AgentLaunch >& plan );
+
+    /// Queue the agents of a plan file launched by the given parent; returns their number, -1 on error
+    int readPlan( const std::string& file,
+                  const std::string& parent );
+
+private:
+    bool spawn( AgentLaunch& launch );
+
+    std::vector< AgentLaunch >      launches_;
+    std::map< std::string, size_t > byTag_;
+    std::deque< size_t >            queue_;
+    size_t                          window_;
+    double                          stale_;
+};
+
+#endif /* AGENT_LAUNCHER_H_INCLUDED */
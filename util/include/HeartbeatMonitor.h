@@ -0,0 +1,168 @@
+/**
+   @file    HeartbeatMonitor.h
+   @ingroup Communication
+   @brief   Aggregated heartbeats and liveness of an agent's subtree
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#ifndef HEARTBEAT_MONITOR_H_INCLUDED
+#define HEARTBEAT_MONITOR_H_INCLUDED
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Summary of the agents below and including the sender of a heartbeat
+ *
+ * Every agent sends one of these to its parent instead of forwarding the heartbeats of its
+ * children, so a parent handles one message per child and interval whatever the size of the
+ * subtree behind it.
+ */
+struct SubtreeHeartbeat {
+    int                        agents;    ///< Agents of the subtree that are alive, including its root
+    int                        processes; ///< Application processes the alive agents are attached to
+    int                        expected;  ///< Agents of the subtree, alive or not
+    std::vector< std::string > missing;   ///< Roots of the subtrees whose heartbeat is overdue
+
+    SubtreeHeartbeat() : agents( 1 ), processes( 0 ), expected( 1 ) {
+    }
+
+    bool operator==( const SubtreeHeartbeat& other ) const;
+
+    bool operator!=( const SubtreeHeartbeat& other ) const {
+        return !( *this == other );
+    }
+
+    /// Text of the heartbeat message: "agents processes expected tag,tag,..."
+    std::string encode() const;
+
+    /// Parse the text of a heartbeat message; false if it is malformed
+    static bool decode( const std::string& text,
+                        SubtreeHeartbeat&  subtree );
+};
+
+/**
+ * @class HeartbeatMonitor
+ * @ingroup Communication
+ *
+ * @brief Keeps the latest heartbeat of each child agent and the deadlines of their next ones
+ *
+ * A child is overdue when it did not report for longer than the deadline, counted from the time it
+ * was expected, from the last restart or from its last heartbeat. Overdue children are reported as
+ * missing together with the subtree they stand for; children that did not report yet but are still
+ * within the deadline are neither alive nor missing. A deadline of 0 disables the liveness checks.
+ * Times are seconds of psc_wall_time() or of any other clock the caller uses consistently.
+ */
+class HeartbeatMonitor {
+public:
+    HeartbeatMonitor( double deadline = 0.0 );
+
+    void setDeadline( double seconds ) {
+        deadline_ = seconds;
+    }
+
+    double getDeadline() const {
+        return deadline_;
+    }
+
+    /// Period of the heartbeats to a parent using the same deadline: a quarter of it, at least a second
+    double interval() const {
+        return deadline_ / 4 > 1.0 ? deadline_ / 4 : 1.0;
+    }
+
+    /// Processes the agent itself is attached to, counted in its own summary
+    void setOwnProcesses( int processes ) {
+        ownProcesses_ = processes;
+    }
+
+    /// Wait for a child; its deadline starts now. Returns false if the child is already known
+    bool expect( const std::string& tag,
+                 double             now );
+
+    /// Stop waiting for a child, for instance after it dismissed itself
+    bool forget( const std::string& tag );
+
+    /// Record the summary a child sent about its subtree; unknown children are added
+    void beat( const std::string&      tag,
+               const SubtreeHeartbeat& subtree,
+               double                  now );
+
+    /**
+     * Record the heartbeat of a child that reports only itself and its processes. A child that
+     * already sent the summary of a subtree keeps it: its own heartbeat only says it is alive.
+     */
+    void beat( const std::string& tag,
+               int                processes,
+               double             now );
+
+    /// Record processes a child attached to since its last heartbeat
+    void addProcesses( const std::string& tag,
+                       int                processes,
+                       double             now );
+
+    /// Every child has to report again, for instance after an application restart
+    void restart( double now );
+
+    /// Whether every known child reported since it was expected or since the last restart
+    bool complete() const;
+
+    /// Number of known children
+    size_t children() const {
+        return children_.size();
+    }
+
+    /// Children whose heartbeat is overdue
+    std::vector< std::string > overdue( double now ) const;
+
+    /// Children that became overdue since the last call, each is returned once until it reports again
+    std::vector< std::string > expire( double now );
+
+    /// Latest summary of a child, NULL if it did not report yet
+    const SubtreeHeartbeat* latest( const std::string& tag ) const;
+
+    /// Summary of the subtree of this agent
+    SubtreeHeartbeat summary( double now ) const;
+
+    /// Whether the summary differs from the one last returned by flush()
+    bool pending( double now ) const;
+
+    /// Summary to send upstream; it becomes the reference of pending()
+    SubtreeHeartbeat flush( double now );
+
+private:
+    struct Child {
+        SubtreeHeartbeat subtree;  ///< Latest summary the child sent
+        double           since;    ///< Time it was expected, or of the last restart
+        double           last;     ///< Time of its latest heartbeat, negative before the first one
+        bool             reported; ///< Whether it reported since it was expected or the last restart
+        bool             expired;  ///< Whether expire() returned it since its latest heartbeat
+
+        Child() : since( 0 ), last( -1 ), reported( false ), expired( false ) {
+        }
+    };
+
+    bool isOverdue( const Child& child,
+                    double       now ) const;
+
+    Child& child( const std::string& tag,
+                  double             now );
+
+    std::map< std::string, Child > children_;
+    SubtreeHeartbeat               flushed_;
+    bool                           flushedOnce_;
+    double                         deadline_;
+    int                            ownProcesses_;
+};
+
+#endif /* HEARTBEAT_MONITOR_H_INCLUDED */
@@ -52,6 +52,7 @@ private:
     std::vector<ExecObjType> execObjs;
     bool							  rtsBased;
     std::string				  callpath;
+    bool                     internal;
 
 public:
     MetaProperty();
@@ -158,5 +159,14 @@ public:
     void setCallpath(std::string callpath);
 
     std::string getCallpath();
+
+    /// Internal properties feed frontend analyses and are never reported to the user
+    bool isInternal() const {
+        return internal;
+    }
+
+    void setInternal( bool val ) {
+        internal = val;
+    }
 };
 #endif /* METAPROPERTY_H_ */
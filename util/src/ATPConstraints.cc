@@ -0,0 +1,538 @@
+/**
+   @file    ATPConstraints.cc
+   @ingroup ATP Service
+   @brief   Constraint engine for application tuning parameter domains
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "ATPConstraints.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Recursive descent over the C precedence levels, emitting postfix code. Each parse method
+ * returns false after recording the first error.
+ */
+class ATPConstraintParser {
+public:
+    ATPConstraintParser( const std::string&                text,
+                         const std::vector< std::string >& parameters,
+                         ATPConstraint&                    constraint ) :
+        text_( text ), parameters_( parameters ), constraint_( constraint ), pos_( 0 ) {
+    }
+
+    bool parse( std::string& error ) {
+        if( !orExpression() ) {
+            error = error_;
+            return false;
+        }
+        skip();
+        if( pos_ != text_.size() ) {
+            error = "unexpected '" + text_.substr( pos_, 1 ) + "' at position " + std::to_string( pos_ );
+            return false;
+        }
+        return true;
+    }
+
+private:
+    typedef ATPConstraint::Opcode Opcode;
+
+    void skip() {
+        while( pos_ < text_.size() && isspace( ( unsigned char )text_[ pos_ ] ) ) {
+            pos_++;
+        }
+    }
+
+    bool accept( const char* token ) {
+        skip();
+        size_t length = strlen( token );
+        if( text_.compare( pos_, length, token ) != 0 ) {
+            return false;
+        }
+        // "<" must not match the start of "<=", "!" not the start of "!="
+        if( length == 1 && pos_ + 1 < text_.size() && text_[ pos_ + 1 ] == '=' &&
+            ( token[ 0 ] == '<' || token[ 0 ] == '>' || token[ 0 ] == '!' ) ) {
+            return false;
+        }
+        pos_ += length;
+        return true;
+    }
+
+    void emit( Opcode  opcode,
+               int64_t operand = 0 ) {
+        ATPConstraint::Instruction instruction = { opcode, operand };
+        constraint_.code_.push_back( instruction );
+    }
+
+    bool fail( const std::string& message ) {
+        if( error_.empty() ) {
+            error_ = message + " at position " + std::to_string( pos_ );
+        }
+        return false;
+    }
+
+    bool orExpression() {
+        if( !andExpression() ) {
+            return false;
+        }
+        while( accept( "||" ) ) {
+            if( !andExpression() ) {
+                return false;
+            }
+            emit( ATPConstraint::OR );
+        }
+        return true;
+    }
+
+    bool andExpression() {
+        if( !equality() ) {
+            return false;
+        }
+        while( accept( "&&" ) ) {
+            if( !equality() ) {
+                return false;
+            }
+            emit( ATPConstraint::AND );
+        }
+        return true;
+    }
+
+    bool equality() {
+        if( !relation() ) {
+            return false;
+        }
+        for(;; ) {
+            Opcode opcode;
+            if( accept( "==" ) ) {
+                opcode = ATPConstraint::EQUAL;
+            }
+            else if( accept( "!=" ) ) {
+                opcode = ATPConstraint::NOT_EQUAL;
+            }
+            else {
+                return true;
+            }
+            if( !relation() ) {
+                return false;
+            }
+            emit( opcode );
+        }
+    }
+
+    bool relation() {
+        if( !sum() ) {
+            return false;
+        }
+        for(;; ) {
+            Opcode opcode;
+            if( accept( "<=" ) ) {
+                opcode = ATPConstraint::LESS_EQUAL;
+            }
+            else if( accept( ">=" ) ) {
+                opcode = ATPConstraint::GREATER_EQUAL;
+            }
+            else if( accept( "<" ) ) {
+                opcode = ATPConstraint::LESS;
+            }
+            else if( accept( ">" ) ) {
+                opcode = ATPConstraint::GREATER;
+            }
+            else {
+                return true;
+            }
+            if( !sum() ) {
+                return false;
+            }
+            emit( opcode );
+        }
+    }
+
+    bool sum() {
+        if( !product() ) {
+            return false;
+        }
+        for(;; ) {
+            Opcode opcode;
+            if( accept( "+" ) ) {
+                opcode = ATPConstraint::ADD;
+            }
+            else if( accept( "-" ) ) {
+                opcode = ATPConstraint::SUBTRACT;
+            }
+            else {
+                return true;
+            }
+            if( !product() ) {
+                return false;
+            }
+            emit( opcode );
+        }
+    }
+
+    bool product() {
+        if( !unary() ) {
+            return false;
+        }
+        for(;; ) {
+            Opcode opcode;
+            if( accept( "*" ) ) {
+                opcode = ATPConstraint::MULTIPLY;
+            }
+            else if( accept( "/" ) ) {
+                opcode = ATPConstraint::DIVIDE;
+            }
+            else if( accept( "%" ) ) {
+                opcode = ATPConstraint::MODULO;
+            }
+            else {
+                return true;
+            }
+            if( !unary() ) {
+                return false;
+            }
+            emit( opcode );
+        }
+    }
+
+    bool unary() {
+        if( accept( "-" ) ) {
+            if( !unary() ) {
+                return false;
+            }
+            emit( ATPConstraint::NEGATE );
+            return true;
+        }
+        if( accept( "!" ) ) {
+            if( !unary() ) {
+                return false;
+            }
+            emit( ATPConstraint::NOT );
+            return true;
+        }
+        if( accept( "+" ) ) {
+            return unary();
+        }
+        return primary();
+    }
+
+    bool primary() {
+        skip();
+        if( accept( "(" ) ) {
+            if( !orExpression() ) {
+                return false;
+            }
+            return accept( ")" ) || fail( "missing ')'" );
+        }
+        if( pos_ < text_.size() && isdigit( ( unsigned char )text_[ pos_ ] ) ) {
+            char*     end;
+            long long value = strtoll( text_.c_str() + pos_, &end, 10 );
+            pos_ = end - text_.c_str();
+            emit( ATPConstraint::CONSTANT, value );
+            return true;
+        }
+        if( pos_ < text_.size() && ( isalpha( ( unsigned char )text_[ pos_ ] ) || text_[ pos_ ] == '_' ) ) {
+            size_t start = pos_;
+            while( pos_ < text_.size() && ( isalnum( ( unsigned char )text_[ pos_ ] ) || text_[ pos_ ] == '_' ) ) {
+                pos_++;
+            }
+            std::string                                name  = text_.substr( start, pos_ - start );
+            std::vector< std::string >::const_iterator found = std::find( parameters_.begin(), parameters_.end(), name );
+            if( found == parameters_.end() ) {
+                pos_ = start;
+                return fail( "unknown parameter '" + name + "'" );
+            }
+            int index = found - parameters_.begin();
+            constraint_.last_ = std::max( constraint_.last_, index );
+            emit( ATPConstraint::PARAMETER, index );
+            return true;
+        }
+        return fail( pos_ < text_.size() ? "unexpected '" + text_.substr( pos_, 1 ) + "'" : "unexpected end" );
+    }
+
+    const std::string&                text_;
+    const std::vector< std::string >& parameters_;
+    ATPConstraint&                    constraint_;
+    size_t                            pos_;
+    std::string                       error_;
+};
+
+
+bool ATPConstraint::compile( const std::string&                text,
+                             const std::vector< std::string >& parameters,
+                             ATPConstraint&                    constraint,
+                             std::string&                      error ) {
+    ATPConstraint       result;
+    ATPConstraintParser parser( text, parameters, result );
+    result.text_ = text;
+    if( !parser.parse( error ) ) {
+        return false;
+    }
+    constraint = result;
+    return true;
+}
+
+
+bool ATPConstraint::holds( const std::vector< int32_t >& values ) const {
+    int64_t stack[ 64 ];
+    size_t  top = 0;
+    for( const auto& instruction : code_ ) {
+        if( top >= 64 ) {
+            // deeper than any description needs; reject rather than overflow
+            return false;
+        }
+        switch( instruction.opcode ) {
+        case CONSTANT:
+            stack[ top++ ] = instruction.operand;
+            continue;
+        case PARAMETER:
+            stack[ top++ ] = values[ instruction.operand ];
+            continue;
+        case NEGATE:
+            stack[ top - 1 ] = -stack[ top - 1 ];
+            continue;
+        case NOT:
+            stack[ top - 1 ] = !stack[ top - 1 ];
+            continue;
+        default:
+            break;
+        }
+
+        int64_t right = stack[ --top ];
+        int64_t left  = stack[ top - 1 ];
+        int64_t result;
+        switch( instruction.opcode ) {
+        case MULTIPLY:
+            result = left * right;
+            break;
+        case DIVIDE:
+        case MODULO:
+            if( right == 0 ) {
+                return false;
+            }
+            result = instruction.opcode == DIVIDE ? left / right : left % right;
+            break;
+        case ADD:
+            result = left + right;
+            break;
+        case SUBTRACT:
+            result = left - right;
+            break;
+        case LESS:
+            result = left < right;
+            break;
+        case LESS_EQUAL:
+            result = left <= right;
+            break;
+        case GREATER:
+            result = left > right;
+            break;
+        case GREATER_EQUAL:
+            result = left >= right;
+            break;
+        case EQUAL:
+            result = left == right;
+            break;
+        case NOT_EQUAL:
+            result = left != right;
+            break;
+        case AND:
+            result = left && right;
+            break;
+        default:
+            result = left || right;
+            break;
+        }
+        stack[ top - 1 ] = result;
+    }
+    return top == 1 && stack[ 0 ] != 0;
+}
+
+
+void ATPConstraintSpace::addParameter( const std::string&            name,
+                                       const std::vector< int32_t >& values ) {
+    names_.push_back( name );
+    values_.push_back( values );
+    checks_.push_back( std::vector< size_t >() );
+}
+
+
+bool ATPConstraintSpace::addConstraint( const std::string& expression,
+                                        std::string&       error ) {
+    ATPConstraint constraint;
+    if( !ATPConstraint::compile( expression, names_, constraint, error ) ) {
+        return false;
+    }
+    if( constraint.last() < 0 ) {
+        constant_.push_back( constraints_.size() );
+    }
+    else {
+        checks_[ constraint.last() ].push_back( constraints_.size() );
+    }
+    constraints_.push_back( constraint );
+    return true;
+}
+
+
+int ATPConstraintSpace::index( const std::string& name ) const {
+    std::vector< std::string >::const_iterator found = std::find( names_.begin(), names_.end(), name );
+    return found == names_.end() ? -1 : found - names_.begin();
+}
+
+
+bool ATPConstraintSpace::admits( size_t                        depth,
+                                 const std::vector< int32_t >& values ) const {
+    for( const auto& constraint : checks_[ depth ] ) {
+        if( !constraints_[ constraint ].holds( values ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool ATPConstraintSpace::isValid( const std::vector< int32_t >& values ) const {
+    if( values.size() != names_.size() ) {
+        return false;
+    }
+    for( const auto& constraint : constraints_ ) {
+        if( !constraint.holds( values ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+ATPConstraintSpace::Enumerator::Enumerator( const ATPConstraintSpace& space ) :
+    space_( &space ), position_( space.parameters(), 0 ), current_( space.parameters(), 0 ), depth_( 0 ), started_( false ) {
+}
+
+
+bool ATPConstraintSpace::Enumerator::next( std::vector< int32_t >& values ) {
+    const size_t n = space_->parameters();
+    if( !started_ ) {
+        started_ = true;
+        for( const auto& constraint : space_->constant_ ) {
+            if( !space_->constraints_[ constraint ].holds( current_ ) ) {
+                depth_ = n + 1;
+            }
+        }
+        if( depth_ > n ) {
+            return false;
+        }
+        if( n == 0 ) {
+            depth_ = n + 1;
+            values.clear();
+            return true;
+        }
+        position_[ 0 ] = 0;
+    }
+    else if( depth_ > n ) {
+        return false;
+    }
+    else {
+        // resume after the configuration returned last
+        depth_ = n - 1;
+        position_[ depth_ ]++;
+    }
+
+    // depth_ is the parameter being assigned, position_[ depth_ ] its next candidate value
+    for(;; ) {
+        if( position_[ depth_ ] >= space_->values_[ depth_ ].size() ) {
+            if( depth_ == 0 ) {
+                depth_ = n + 1;
+                return false;
+            }
+            depth_--;
+            position_[ depth_ ]++;
+            continue;
+        }
+        current_[ depth_ ] = space_->values_[ depth_ ][ position_[ depth_ ] ];
+        if( !space_->admits( depth_, current_ ) ) {
+            position_[ depth_ ]++;
+            continue;
+        }
+        if( depth_ + 1 == n ) {
+            values = current_;
+            return true;
+        }
+        depth_++;
+        position_[ depth_ ] = 0;
+    }
+}
+
+
+size_t ATPConstraintSpace::count() const {
+    Enumerator             walk = enumerate();
+    std::vector< int32_t > values;
+    size_t                 valid = 0;
+    while( walk.next( values ) ) {
+        valid++;
+    }
+    return valid;
+}
+
+
+bool ATPConstraintSpace::sample( std::mt19937&           random,
+                                 std::vector< int32_t >& values ) const {
+    const size_t                         n = names_.size();
+    std::vector< int32_t >               current( n, 0 );
+    std::vector< std::vector< size_t > > order( n );
+    std::vector< size_t >                position( n, 0 );
+    for( const auto& constraint : constant_ ) {
+        if( !constraints_[ constraint ].holds( current ) ) {
+            return false;
+        }
+    }
+    if( n == 0 ) {
+        values.clear();
+        return true;
+    }
+
+    size_t depth = 0;
+    order[ 0 ].resize( values_[ 0 ].size() );
+    for( size_t i = 0; i < order[ 0 ].size(); i++ ) {
+        order[ 0 ][ i ] = i;
+    }
+    std::shuffle( order[ 0 ].begin(), order[ 0 ].end(), random );
+
+    for(;; ) {
+        if( position[ depth ] >= order[ depth ].size() ) {
+            if( depth == 0 ) {
+                return false;
+            }
+            depth--;
+            position[ depth ]++;
+            continue;
+        }
+        current[ depth ] = values_[ depth ][ order[ depth ][ position[ depth ] ] ];
+        if( !admits( depth, current ) ) {
+            position[ depth ]++;
+            continue;
+        }
+        if( depth + 1 == n ) {
+            values = current;
+            return true;
+        }
+        depth++;
+        position[ depth ] = 0;
+        order[ depth ].resize( values_[ depth ].size() );
+        for( size_t i = 0; i < order[ depth ].size(); i++ ) {
+            order[ depth ][ i ] = i;
+        }
+        std::shuffle( order[ depth ].begin(), order[ depth ].end(), random );
+    }
+}
@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <vector>
 #include <algorithm>
+#include <cstring>
 
 
 //atpService* atp_srvc;
@@ -204,8 +205,16 @@ std::unordered_map< std::string, std::vector< TuningParameter* > > atpService::g
         }
 
         //set range type details min, max, step
+        std::vector< int32_t >& values = param_values_[ param_names[ i ] ];
+        values.clear();
         if ( param_details[ idx + 0 ] == 1 ) {
             a_tp->setRange( param_details[ idx + 3 + 0 ], param_details[ idx + 3 + 1 ], param_details[ idx + 3 + 2 ] );
+            for ( int32_t value = param_details[ idx + 3 + 0 ]; value <= param_details[ idx + 3 + 1 ] && param_details[ idx + 3 + 2 ] > 0; value += param_details[ idx + 3 + 2 ] ) {
+                values.push_back( value );
+            }
+        }
+        else {
+            values.assign( &param_details[ idx + 3 ], &param_details[ idx + 3 + num_values ] );
         }
 
         idx = idx + 3 + num_values;
@@ -302,6 +311,67 @@ std::unordered_map< int, std::vector< int32_t > > atpService::getValidConfigurat
     }*/
     return valid_combination;
 }
+const ATPConstraintSpace* atpService::getConstraintSpace( const char* dname ) {
+    const char* enabled = getenv( "ATP_CONSTRAINT_EXPRESSIONS" );
+    if ( enabled == NULL || strcmp( enabled, "0" ) == 0 ) {
+        return NULL;
+    }
+
+    std::unordered_map< std::string, std::unique_ptr< ATPConstraintSpace > >::const_iterator cached = constraint_spaces_.find( dname );
+    if ( cached != constraint_spaces_.end() ) {
+        return cached->second.get();
+    }
+
+    std::stringstream ss;
+    ss << "getconstraints," << dname << ";\n";
+    std::string req_message( ss.str() );
+
+    socket_write_line( sock_, req_message.c_str() );
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ApplTuningParameter ), "Sending line to ATPServer: <%s> via socket# %d\n", req_message.c_str(), sock_ );
+
+    /* Read status and number of constraints, then one expression per line */
+    int     length;
+    int32_t info[ 2 ];
+    if ( ( length = socket_blockread( sock_, ( char* )( info ), ( sizeof( int32_t ) * 2 ) ) ) != ( sizeof( int32_t ) * 2 ) ) {
+        psc_errmsg( "wrong number of bytes read: %d!=%d\n", length, ( sizeof( int32_t ) * 2 ) );
+        abort();
+    }
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ApplTuningParameter ), "Received from ATP Server [%d] status [%d] constraints\n", info[ 0 ], info[ 1 ] );
+
+    std::unique_ptr< ATPConstraintSpace > space( new ATPConstraintSpace );
+    bool                                  usable = info[ 0 ] != 0;
+    for ( const auto& name : getParamNamesbyDomain( dname ) ) {
+        // the values come with getATPSpecs(); without them the space would be empty
+        if ( param_values_[ name ].empty() ) {
+            usable = false;
+        }
+        space->addParameter( name, param_values_[ name ] );
+    }
+
+    char* buf = ( char* )malloc( 4096 );
+    for ( int32_t i = 0; i < info[ 1 ]; i++ ) {
+        if ( socket_read_line( sock_, buf, 4096 ) <= 0 ) {
+            psc_errmsg( "Error reading constraint %d of domain %s from ATP Server\n", i, dname );
+            abort();
+        }
+        std::string error;
+        if ( usable && !space->addConstraint( buf, error ) ) {
+            psc_errmsg( "Constraint <%s> of domain %s does not compile: %s\n", buf, dname, error.c_str() );
+            usable = false;
+        }
+    }
+    free( buf );
+
+    // an unusable domain is cached as well, so it is not requested from the server again
+    if ( !usable || space->parameters() == 0 ) {
+        constraint_spaces_[ dname ].reset();
+        return NULL;
+    }
+    psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ApplTuningParameter ), "Domain %s: %d parameters, %d constraints evaluated locally\n",
+                dname, ( int )space->parameters(), ( int )space->constraints() );
+    return ( constraint_spaces_[ dname ] = std::move( space ) ).get();
+}
+
 std::string atpService::getDomainByParamName( std::string param_name ) {
     for ( const auto& local_it : domain_paramNames_mapping_ ) {
         //psc_dbgmsg( PSC_SELECTIVE_DEBUG_LEVEL( ApplTuningParameter ), "---DOMAIN NAME-------: %s\n", (local_it->first).c_str() );
@@ -0,0 +1,240 @@
+/**
+   @file    AgentLauncher.cc
+   @ingroup Communication
+   @brief   Bounded-parallel launcher for the agent hierarchy
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "AgentLauncher.h"
+#include "psc_errmsg.h"
+#include "timing.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <fstream>
+#include <sstream>
+
+AgentLauncher::AgentLauncher( size_t window,
+                              double stale ) : window_( window > 0 ? window : 1 ), stale_( stale ) {
+}
+
+
+bool AgentLauncher::add( const AgentLaunch& launch ) {
+    if( byTag_.count( launch.tag ) ) {
+        return false;
+    }
+    byTag_[ launch.tag ] = launches_.size();
+    launches_.push_back( launch );
+    launches_.back().pid      = -1;
+    launches_.back().launched = 0;
+    launches_.back().ready    = 0;
+    launches_.back().starts   = 0;
+    queue_.push_back( launches_.size() - 1 );
+    return true;
+}
+
+
+size_t AgentLauncher::inFlight() const {
+    double now    = psc_wall_time();
+    size_t active = 0;
+    for( size_t i = 0; i < launches_.size(); i++ ) {
+        const AgentLaunch& launch = launches_[ i ];
+        if( launch.pid > 0 && launch.ready == 0 && now - launch.launched < stale_ ) {
+            active++;
+        }
+    }
+    return active;
+}
+
+
+bool AgentLauncher::spawn( AgentLaunch& launch ) {
+    launch.launched = psc_wall_time();
+    launch.ready    = 0;
+
+    pid_t pid = fork();
+    if( pid == 0 ) {
+        if( !launch.workdir.empty() && chdir( launch.workdir.c_str() ) != 0 ) {
+            psc_errmsg( "Cannot change to %s for agent %s\n", launch.workdir.c_str(), launch.tag.c_str() );
+            _exit( 127 );
+        }
+        execl( "/bin/sh", "sh", "-c", launch.command.c_str(), ( char* )NULL );
+        _exit( 127 );
+    }
+    else if( pid < 0 ) {
+        psc_errmsg( "Error forking launch of agent %s\n", launch.tag.c_str() );
+        return false;
+    }
+
+    launch.pid = pid;
+    launch.starts++;
+    psc_dbgmsg( 2, "Launched agent %s on %s (pid %d, launch %d)\n", launch.tag.c_str(),
+                launch.host.c_str(), ( int )pid, launch.starts );
+    return true;
+}
+
+
+size_t AgentLauncher::dispatch() {
+    size_t active  = inFlight();
+    size_t started = 0;
+    while( !queue_.empty() && active < window_ ) {
+        AgentLaunch& launch = launches_[ queue_.front() ];
+        queue_.pop_front();
+        if( spawn( launch ) ) {
+            active++;
+            started++;
+        }
+    }
+    if( !queue_.empty() ) {
+        psc_dbgmsg( 3, "%d agent launches queued behind %d in flight\n", ( int )queue_.size(), ( int )active );
+    }
+    return started;
+}
+
+
+bool AgentLauncher::ready( const std::string& tag ) {
+    std::map< std::string, size_t >::const_iterator it = byTag_.find( tag );
+    if( it == byTag_.end() ) {
+        return false;
+    }
+
+    AgentLaunch& launch = launches_[ it->second ];
+    if( launch.starts > 0 && launch.ready == 0 ) {
+        launch.ready = psc_wall_time();
+        psc_dbgmsg( 2, "Agent %s reported %.3f s after launch\n", tag.c_str(), launch.ready - launch.launched );
+        dispatch();
+        if( queue_.empty() && inFlight() == 0 ) {
+            report();
+        }
+    }
+    return true;
+}
+
+
+bool AgentLauncher::alive( const std::string& tag ) {
+    std::map< std::string, size_t >::const_iterator it = byTag_.find( tag );
+    if( it == byTag_.end() || launches_[ it->second ].pid <= 0 ) {
+        return false;
+    }
+
+    AgentLaunch& launch = launches_[ it->second ];
+    int          status;
+    pid_t        result = waitpid( launch.pid, &status, WNOHANG );
+    if( result == 0 ) {
+        return true;
+    }
+    // ECHILD: the launcher forked the process, so it stopped being a child only when it was reaped
+    // elsewhere; its PID may already belong to another process and is not probed
+    psc_dbgmsg( 2, "Agent %s (pid %d) is no longer running\n", tag.c_str(), ( int )launch.pid );
+    launch.pid = -1;
+    return false;
+}
+
+
+std::vector< std::string > AgentLauncher::relaunchDead() {
+    std::vector< std::string > relaunched;
+    std::vector< bool >        waiting( launches_.size(), false );
+    for( size_t i = 0; i < queue_.size(); i++ ) {
+        waiting[ queue_[ i ] ] = true;
+    }
+
+    for( size_t i = 0; i < launches_.size(); i++ ) {
+        if( launches_[ i ].starts > 0 && !waiting[ i ] && !alive( launches_[ i ].tag ) ) {
+            queue_.push_back( i );
+            relaunched.push_back( launches_[ i ].tag );
+        }
+    }
+    if( !relaunched.empty() ) {
+        psc_dbgmsg( 1, "Relaunching %d agent(s) that exited, %d kept alive\n", ( int )relaunched.size(),
+                    ( int )( launches_.size() - relaunched.size() ) );
+        dispatch();
+    }
+    return relaunched;
+}
+
+
+const AgentLaunch* AgentLauncher::find( const std::string& tag ) const {
+    std::map< std::string, size_t >::const_iterator it = byTag_.find( tag );
+    return it == byTag_.end() ? NULL : &launches_[ it->second ];
+}
+
+
+void AgentLauncher::report() const {
+    size_t reported = 0;
+    double min      = 0, max = 0, sum = 0;
+    for( size_t i = 0; i < launches_.size(); i++ ) {
+        const AgentLaunch& launch = launches_[ i ];
+        if( launch.ready == 0 ) {
+            continue;
+        }
+        double latency = launch.ready - launch.launched;
+        min  = reported == 0 || latency < min ? latency : min;
+        max  = reported == 0 || latency > max ? latency : max;
+        sum += latency;
+        reported++;
+    }
+    if( reported > 0 ) {
+        psc_dbgmsg( 1, "%d of %d launched agents reported; latency min %.3f s, avg %.3f s, max %.3f s\n",
+                    ( int )reported, ( int )launches_.size(), min, sum / reported, max );
+    }
+}
+
+
+bool AgentLauncher::writePlan( const std::string&                file,
+                               const std::vector< AgentLaunch >& plan ) {
+    std::string   tmp = file + ".tmp";
+    std::ofstream out( tmp.c_str() );
+    for( size_t i = 0; i < plan.size(); i++ ) {
+        const AgentLaunch& launch = plan[ i ];
+        out << launch.parent << '\t' << launch.tag << '\t' << launch.host << '\t'
+            << launch.workdir << '\t' << launch.command << '\n';
+    }
+    out.close();
+    // agents read the plan as soon as they start, so it has to appear complete
+    if( !out || rename( tmp.c_str(), file.c_str() ) != 0 ) {
+        psc_errmsg( "Cannot write agent launch plan %s\n", file.c_str() );
+        return false;
+    }
+    return true;
+}
+
+
+int AgentLauncher::readPlan( const std::string& file,
+                             const std::string& parent ) {
+    std::ifstream in( file.c_str() );
+    if( !in ) {
+        psc_errmsg( "Cannot read agent launch plan %s\n", file.c_str() );
+        return -1;
+    }
+
+    int         count = 0;
+    std::string line;
+    while( std::getline( in, line ) ) {
+        std::istringstream fields( line );
+        AgentLaunch        launch;
+        std::getline( fields, launch.parent, '\t' );
+        if( launch.parent != parent ) {
+            continue;
+        }
+        std::getline( fields, launch.tag, '\t' );
+        std::getline( fields, launch.host, '\t' );
+        std::getline( fields, launch.workdir, '\t' );
+        std::getline( fields, launch.command );
+        if( add( launch ) ) {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,224 @@
+/**
+   @file    HeartbeatMonitor.cc
+   @ingroup Communication
+   @brief   Aggregated heartbeats and liveness of an agent's subtree
+   @verbatim
+    Revision:       $Revision$
+    Revision date:  $Date$
+    Committed by:   $Author$
+
+    This file is part of the Periscope Tuning Framework.
+    See http://www.lrr.in.tum.de/periscope for details.
+
+    Copyright (c) 2005-2017, Technische Universitaet Muenchen, Germany
+    See the COPYING file in the base directory of the package for details.
+   @endverbatim
+ */
+
+#include "HeartbeatMonitor.h"
+
+#include <sstream>
+
+bool SubtreeHeartbeat::operator==( const SubtreeHeartbeat& other ) const {
+    return agents == other.agents && processes == other.processes &&
+           expected == other.expected && missing == other.missing;
+}
+
+
+std::string SubtreeHeartbeat::encode() const {
+    std::stringstream text;
+    text << agents << " " << processes << " " << expected << " ";
+    for( size_t i = 0; i < missing.size(); i++ ) {
+        text << ( i ? "," : "" ) << missing[ i ];
+    }
+    return text.str();
+}
+
+
+bool SubtreeHeartbeat::decode( const std::string& text,
+                               SubtreeHeartbeat&  subtree ) {
+    std::stringstream input( text );
+    SubtreeHeartbeat  result;
+    if( !( input >> result.agents >> result.processes >> result.expected ) ||
+        result.agents < 0 || result.processes < 0 || result.expected < result.agents ) {
+        return false;
+    }
+
+    std::string tags;
+    input >> tags;
+    std::stringstream list( tags );
+    std::string       tag;
+    while( std::getline( list, tag, ',' ) ) {
+        if( !tag.empty() ) {
+            result.missing.push_back( tag );
+        }
+    }
+    subtree = result;
+    return true;
+}
+
+
+HeartbeatMonitor::HeartbeatMonitor( double deadline ) : flushedOnce_( false ), deadline_( deadline ), ownProcesses_( 0 ) {
+}
+
+
+bool HeartbeatMonitor::expect( const std::string& tag,
+                               double             now ) {
+    if( children_.count( tag ) ) {
+        return false;
+    }
+    children_[ tag ].since = now;
+    return true;
+}
+
+
+bool HeartbeatMonitor::forget( const std::string& tag ) {
+    return children_.erase( tag ) > 0;
+}
+
+
+HeartbeatMonitor::Child& HeartbeatMonitor::child( const std::string& tag,
+                                                  double             now ) {
+    std::map< std::string, Child >::iterator it = children_.find( tag );
+    if( it == children_.end() ) {
+        it               = children_.insert( std::make_pair( tag, Child() ) ).first;
+        it->second.since = now;
+    }
+    return it->second;
+}
+
+
+void HeartbeatMonitor::beat( const std::string&      tag,
+                             const SubtreeHeartbeat& subtree,
+                             double                  now ) {
+    Child& reporter = child( tag, now );
+    reporter.subtree  = subtree;
+    reporter.last     = now;
+    reporter.reported = true;
+    reporter.expired  = false;
+}
+
+
+void HeartbeatMonitor::beat( const std::string& tag,
+                             int                processes,
+                             double             now ) {
+    Child& reporter = child( tag, now );
+    // a high-level agent reports its processes in the summaries of its subtree, the heartbeat it
+    // sends once its children are up may arrive after them
+    if( reporter.last >= 0 && reporter.subtree.expected > 1 ) {
+        reporter.last     = now;
+        reporter.reported = true;
+        reporter.expired  = false;
+        return;
+    }
+    SubtreeHeartbeat own;
+    own.processes = processes;
+    beat( tag, own, now );
+}
+
+
+void HeartbeatMonitor::addProcesses( const std::string& tag,
+                                     int                processes,
+                                     double             now ) {
+    Child& reporter = child( tag, now );
+    if( !reporter.reported ) {
+        beat( tag, processes, now );
+        return;
+    }
+    reporter.subtree.processes += processes;
+    reporter.last               = now;
+    reporter.expired            = false;
+}
+
+
+void HeartbeatMonitor::restart( double now ) {
+    for( std::map< std::string, Child >::iterator it = children_.begin(); it != children_.end(); it++ ) {
+        it->second.since    = now;
+        it->second.reported = false;
+        it->second.expired  = false;
+    }
+}
+
+
+bool HeartbeatMonitor::complete() const {
+    for( std::map< std::string, Child >::const_iterator it = children_.begin(); it != children_.end(); it++ ) {
+        if( !it->second.reported ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool HeartbeatMonitor::isOverdue( const Child& child,
+                                  double       now ) const {
+    if( deadline_ <= 0 ) {
+        return false;
+    }
+    double reference = child.reported ? child.last : child.since;
+    return now - reference > deadline_;
+}
+
+
+std::vector< std::string > HeartbeatMonitor::overdue( double now ) const {
+    std::vector< std::string > tags;
+    for( std::map< std::string, Child >::const_iterator it = children_.begin(); it != children_.end(); it++ ) {
+        if( isOverdue( it->second, now ) ) {
+            tags.push_back( it->first );
+        }
+    }
+    return tags;
+}
+
+
+std::vector< std::string > HeartbeatMonitor::expire( double now ) {
+    std::vector< std::string > tags;
+    for( std::map< std::string, Child >::iterator it = children_.begin(); it != children_.end(); it++ ) {
+        if( !it->second.expired && isOverdue( it->second, now ) ) {
+            it->second.expired = true;
+            tags.push_back( it->first );
+        }
+    }
+    return tags;
+}
+
+
+const SubtreeHeartbeat* HeartbeatMonitor::latest( const std::string& tag ) const {
+    std::map< std::string, Child >::const_iterator it = children_.find( tag );
+    if( it == children_.end() || it->second.last < 0 ) {
+        return NULL;
+    }
+    return &it->second.subtree;
+}
+
+
+SubtreeHeartbeat HeartbeatMonitor::summary( double now ) const {
+    SubtreeHeartbeat result;
+    result.processes = ownProcesses_;
+    for( std::map< std::string, Child >::const_iterator it = children_.begin(); it != children_.end(); it++ ) {
+        const Child& current = it->second;
+        // a child that never reported stands for at least itself
+        result.expected += current.last >= 0 ? current.subtree.expected : 1;
+        if( isOverdue( current, now ) ) {
+            result.missing.push_back( it->first );
+        }
+        else if( current.reported ) {
+            result.agents    += current.subtree.agents;
+            result.processes += current.subtree.processes;
+            result.missing.insert( result.missing.end(), current.subtree.missing.begin(), current.subtree.missing.end() );
+        }
+    }
+    return result;
+}
+
+
+bool HeartbeatMonitor::pending( double now ) const {
+    return !flushedOnce_ || summary( now ) != flushed_;
+}
+
+
+SubtreeHeartbeat HeartbeatMonitor::flush( double now ) {
+    flushed_     = summary( now );
+    flushedOnce_ = true;
+    return flushed_;
+}
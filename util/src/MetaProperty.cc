@@ -27,7 +27,8 @@ MetaProperty::MetaProperty() :
     severity( 0.0 ),
     done( false ),
     purpose( 0 ),
-    rtsBased(false){
+    rtsBased(false),
+    internal( false ){
 }
 
 MetaProperty::~MetaProperty() {
@@ -74,6 +75,7 @@ MetaProperty MetaProperty::fromXMLDeserialize( const std::string& propData ) {
         result.setSeverity( property.get<double>( XML_PSC_PROP_SEVERITY_TAG ) );
         result.setConfidence( property.get<double>( XML_PSC_PROP_CONFIDENCE_TAG ) );
         result.setPurpose( property.get<int>( XML_PSC_PROP_PURPOSE_TAG ) );
+        result.setInternal( property.get<int>( XML_PSC_PROP_INTERNAL_TAG, 0 ) != 0 );
 
         // read the context information
         const ptree& context = property.get_child( XML_PSC_PROP_CONTEXT_TAG );
@@ -146,6 +148,7 @@ MetaProperty MetaProperty::fromXML( const std::string& propData ) {
         result.setSeverity( property.get<double>( XML_PSC_PROP_SEVERITY_TAG ) );
         result.setConfidence( property.get<double>( XML_PSC_PROP_CONFIDENCE_TAG ) );
         result.setPurpose( property.get<int>( XML_PSC_PROP_PURPOSE_TAG ) );
+        result.setInternal( property.get<int>( XML_PSC_PROP_INTERNAL_TAG, 0 ) != 0 );
 
         // read the context information
         const ptree& context = property.get_child( XML_PSC_PROP_CONTEXT_TAG );
@@ -473,6 +476,11 @@ std::string MetaProperty::toXMLSerialize() {
     xmlData << "\t<" << XML_PSC_PROP_PURPOSE_TAG << ">" << this->getPurpose()
             << "</" << XML_PSC_PROP_PURPOSE_TAG << ">" << std::endl;
 
+    // Internal properties only: <internal>1</internal>
+    if( isInternal() ) {
+        xmlData << "\t<" << XML_PSC_PROP_INTERNAL_TAG << ">1</" << XML_PSC_PROP_INTERNAL_TAG << ">" << std::endl;
+    }
+
     // Additional information
     xmlData << "\t<" << XML_PSC_PROP_ADDINFO_TAG << ">" << std::endl;
     for( addInfoType::const_iterator it = addInfo.begin(); it != addInfo.end(); ++it ) {